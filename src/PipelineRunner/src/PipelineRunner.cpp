@@ -118,6 +118,8 @@ int preflightPipelinePath(const fs::path& pipelinePath)
 int executePipeline(Pipeline& pipeline)
 {
   PipelineRunner::PipelineObserver obs(&pipeline);
+  // Intermediate results are never inspected in a batch run so do not keep per-node snapshots
+  pipeline.setSnapshotPolicy(Pipeline::SnapshotPolicy::KeepNone);
   if(!pipeline.execute())
   {
     std::cout << "\n-------------------------" << std::endl;
@@ -3,354 +3,398 @@
 #include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
-#include "complex/Utilities/Math/StatisticsCalculations.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
-#include <unordered_map>
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
 
 using namespace complex;
 
 namespace
 {
+// Each chunk keeps partial statistics for every feature, so the number of chunks is
+// limited to keep the partials small compared to the input array
+constexpr usize k_MinTuplesPerChunkFeature = 16;
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Running statistics of one feature. Integer sums are exact, floating point sums
+ * use Kahan compensation and the variance uses Welford's update so the partial results
+ * of separate chunks can be merged.
+ */
 template <typename T>
-class FindArrayStatisticsByIndexImpl
+struct StatisticsAccumulator
 {
-public:
-  FindArrayStatisticsByIndexImpl(std::unordered_map<int32, std::list<T>>& featureDataMap, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
-                                 std::vector<IDataArray*>& arrays, bool hist, float64 histmin, float64 histmax, bool histfullrange, int32 numBins)
-  : m_FeatureDataMap(featureDataMap)
-  , m_Length(length)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Mean(mean)
-  , m_Median(median)
-  , m_StdDeviation(stdDeviation)
-  , m_Summation(summation)
-  , m_Histogram(hist)
-  , m_HistMin(histmin)
-  , m_HistMax(histmax)
-  , m_HistFullRange(histfullrange)
-  , m_NumBins(numBins)
-  , m_Arrays(arrays)
-  {
-  }
-
-  virtual ~FindArrayStatisticsByIndexImpl() = default;
-
-  void compute(usize start, usize end) const
-  {
-    auto* array0 = dynamic_cast<DataArray<uint64>*>(m_Arrays[0]);
-    if(m_Length && array0 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Length' array to needed type. Check input array selection.");
-    }
-    auto* array1 = dynamic_cast<DataArray<T>*>(m_Arrays[1]);
-    if(m_Min && array1 == nullptr)
+  using SumType = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, int64, uint64>, float64>;
+
+  uint64 count = 0;
+  T min = std::numeric_limits<T>::max();
+  T max = std::numeric_limits<T>::lowest();
+  SumType sum = 0;
+  float64 compensation = 0.0;
+  float64 mean = 0.0;
+  float64 m2 = 0.0;
+
+  void add(T value)
+  {
+    count++;
+    min = std::min(min, value);
+    max = std::max(max, value);
+    addToSum(value);
+    const float64 delta = static_cast<float64>(value) - mean;
+    mean += delta / static_cast<float64>(count);
+    m2 += delta * (static_cast<float64>(value) - mean);
+  }
+
+  void merge(const StatisticsAccumulator& other)
+  {
+    if(other.count == 0)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Min' array to needed type. Check input array selection.");
+      return;
     }
-    auto* array2 = dynamic_cast<DataArray<T>*>(m_Arrays[2]);
-    if(m_Max && array2 == nullptr)
+    if(count == 0)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Max' array to needed type. Check input array selection.");
+      *this = other;
+      return;
     }
-    auto* array3 = dynamic_cast<Float32Array*>(m_Arrays[3]);
-    if(m_Mean && array3 == nullptr)
-    {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Mean' array to needed type. Check input array selection.");
+    const float64 countA = static_cast<float64>(count);
+    const float64 countB = static_cast<float64>(other.count);
+    const float64 delta = other.mean - mean;
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    addToSum(other.sum);
+    if constexpr(std::is_floating_point_v<T>)
+    {
+      addToSum(-other.compensation);
     }
-    auto* array4 = dynamic_cast<Float32Array*>(m_Arrays[4]);
-    if(m_Median && array4 == nullptr)
+    mean += delta * countB / static_cast<float64>(count);
+    m2 += other.m2 + delta * delta * countA * countB / static_cast<float64>(count);
+  }
+
+  SumType total() const
+  {
+    if constexpr(std::is_floating_point_v<T>)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Median' array to needed type. Check input array selection.");
+      return sum - compensation;
     }
-    auto* array5 = dynamic_cast<Float32Array*>(m_Arrays[5]);
-    if(m_StdDeviation && array5 == nullptr)
+    else
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'StdDev' array to needed type. Check input array selection.");
+      return sum;
     }
-    auto* array6 = dynamic_cast<Float32Array*>(m_Arrays[6]);
-    if(m_Summation && array6 == nullptr)
+  }
+
+private:
+  template <typename V>
+  void addToSum(V value)
+  {
+    if constexpr(std::is_floating_point_v<T>)
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
+      const float64 compensated = static_cast<float64>(value) - compensation;
+      const float64 newSum = sum + compensated;
+      compensation = (newSum - sum) - compensated;
+      sum = newSum;
     }
-    auto* array7 = dynamic_cast<Float32Array*>(m_Arrays[7]);
-    if(m_Histogram && array7 == nullptr)
+    else
     {
-      throw std::invalid_argument("FindArrayStatisticsByIndexImpl::compute() could not dynamic_cast 'Histogram' array to needed type. Check input array selection.");
+      sum += static_cast<SumType>(value);
     }
-
-    for(usize i = start; i < end; i++)
-    {
-      if(m_Length)
-      {
-        uint64 val = static_cast<uint64>(m_FeatureDataMap[i].size());
-        array0->initializeTuple(i, val);
-      }
-      if(m_Min)
-      {
-        T val = StaticicsCalculations::findMin(m_FeatureDataMap[i]);
-        array1->initializeTuple(i, val);
-      }
-      if(m_Max)
-      {
-        T val = StaticicsCalculations::findMax(m_FeatureDataMap[i]);
-        array2->initializeTuple(i, val);
-      }
-      if(m_Mean)
-      {
-        float32 val = StaticicsCalculations::findMean(m_FeatureDataMap[i]);
-        array3->initializeTuple(i, val);
-      }
-      if(m_Median)
-      {
-        float32 val = StaticicsCalculations::findMedian(m_FeatureDataMap[i]);
-        array4->initializeTuple(i, val);
-      }
-      if(m_StdDeviation)
-      {
-        float32 val = StaticicsCalculations::findStdDeviation(m_FeatureDataMap[i]);
-        array5->initializeTuple(i, val);
-      }
-      if(m_Summation)
-      {
-        float32 val = StaticicsCalculations::findSummation(m_FeatureDataMap[i]);
-        array6->initializeTuple(i, val);
-      }
-      if(m_Histogram)
-      {
-        auto* arr7DataStore = array7->getDataStore();
-        if(arr7DataStore != nullptr)
-        {
-          std::vector<float32> vals = StaticicsCalculations::findHistogram(m_FeatureDataMap[i], m_HistMin, m_HistMax, m_HistFullRange, m_NumBins);
-          arr7DataStore->setTuple(i, vals);
-        }
-      }
-    }
-  }
-
-  void operator()(const Range& range) const
-  {
-    compute(range.min(), range.max());
   }
-
-private:
-  std::unordered_map<int32, std::list<T>>& m_FeatureDataMap;
-  bool m_Length;
-  bool m_Min;
-  bool m_Max;
-  bool m_Mean;
-  bool m_Median;
-  bool m_StdDeviation;
-  bool m_Summation;
-  bool m_Histogram;
-  float64 m_HistMin;
-  float64 m_HistMax;
-  bool m_HistFullRange;
-  int32 m_NumBins;
-  std::vector<IDataArray*>& m_Arrays;
 };
 
 // -----------------------------------------------------------------------------
+/**
+ * @brief The values of every feature stored contiguously, in the order of the feature ids.
+ */
 template <typename T>
-void findStatisticsByIndexImpl(std::unordered_map<int32, std::list<T>>& featureDataMap, std::vector<IDataArray*>& arrays, const FindArrayStatisticsInputValues* inputValues, int32 numFeatures)
+struct GroupedValues
 {
-  // Allow data-based parallelization
-  ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0, numFeatures);
-  dataAlg.execute(FindArrayStatisticsByIndexImpl<T>(featureDataMap, inputValues->FindLength, inputValues->FindMin, inputValues->FindMax, inputValues->FindMean, inputValues->FindMedian,
-                                                    inputValues->FindStdDeviation, inputValues->FindSummation, arrays, inputValues->FindHistogram, inputValues->MinRange, inputValues->MaxRange,
-                                                    inputValues->UseFullRange, inputValues->NumBins));
-}
+  std::vector<usize> offsets;
+  std::vector<T> values;
+
+  nonstd::span<T> getGroup(usize group)
+  {
+    return {values.data() + offsets[group], offsets[group + 1] - offsets[group]};
+  }
+};
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void findStatisticsImpl(std::vector<T>& data, std::vector<IDataArray*>& arrays, const FindArrayStatisticsInputValues* inputValues)
+float32 findMedianInPlace(nonstd::span<T> values)
 {
-  if(inputValues->FindLength)
+  if(values.empty())
   {
-    auto* array0 = dynamic_cast<DataArray<uint64>*>(arrays[0]);
-    if(array0 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Length' array to needed type. Check input array selection.");
-    }
-    uint64 val = static_cast<uint64>(data.size());
-    array0->initializeTuple(0, val);
+    return 0.0f;
   }
-  if(inputValues->FindMin)
+  const usize half = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + half, values.end());
+  float32 medVal = static_cast<float32>(values[half]);
+  if(values.size() % 2 == 0)
   {
-    auto* array1 = dynamic_cast<DataArray<T>*>(arrays[1]);
-    if(array1 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Min' array to needed type. Check input array selection.");
-    }
-    T val = StaticicsCalculations::findMin(data);
-    array1->initializeTuple(0, val);
+    const T low = *std::max_element(values.begin(), values.begin() + half);
+    medVal = (low + values[half]) * 0.5f;
   }
-  if(inputValues->FindMax)
+  return medVal;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void fillHistogram(nonstd::span<const T> values, float32 min, float32 max, int32 numBins, std::vector<float32>& histogram)
+{
+  std::fill(histogram.begin(), histogram.end(), 0.0f);
+  if(values.empty())
   {
-    auto* array2 = dynamic_cast<DataArray<T>*>(arrays[2]);
-    if(array2 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Max' array to needed type. Check input array selection.");
-    }
-    T val = StaticicsCalculations::findMax(data);
-    array2->initializeTuple(0, val);
+    return;
   }
-  if(inputValues->FindMean)
+
+  const float32 increment = (max - min) / static_cast<float32>(numBins);
+  if(numBins == 1 || std::abs(increment) < 1E-10)
   {
-    auto* array3 = dynamic_cast<Float32Array*>(arrays[3]);
-    if(array3 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Mean' array to needed type. Check input array selection.");
-    }
-    float32 val = StaticicsCalculations::findMean(data);
-    array3->initializeTuple(0, val);
+    // if one bin, just set the first element to total number of points
+    histogram[0] = static_cast<float32>(values.size());
+    return;
   }
-  if(inputValues->FindMedian)
+  for(const T s : values)
   {
-    auto* array4 = dynamic_cast<Float32Array*>(arrays[4]);
-    if(array4 == nullptr)
+    const float32 value = static_cast<float32>(s);
+    const usize bin = static_cast<usize>((value - min) / increment); // find bin for this input array value
+    if(bin < static_cast<usize>(numBins))                           // make certain bin is in range
     {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Median' array to needed type. Check input array selection.");
+      histogram[bin]++;
     }
-    float32 val = StaticicsCalculations::findMedian(data);
-    array4->initializeTuple(0, val);
-  }
-  if(inputValues->FindStdDeviation)
-  {
-    auto* array5 = dynamic_cast<Float32Array*>(arrays[5]);
-    if(array5 == nullptr)
+    else if(value == max)
     {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'StdDev' array to needed type. Check input array selection.");
+      histogram[numBins - 1]++;
     }
-    float32 val = StaticicsCalculations::findStdDeviation(data);
-    array5->initializeTuple(0, val);
   }
-  if(inputValues->FindSummation)
+}
+
+// -----------------------------------------------------------------------------
+template <typename ArrayType>
+ArrayType* castStatisticsArray(bool enabled, IDataArray* array, const std::string& name)
+{
+  auto* castArray = dynamic_cast<ArrayType*>(array);
+  if(enabled && castArray == nullptr)
   {
-    auto* array6 = dynamic_cast<Float32Array*>(arrays[6]);
-    if(array6 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
-    }
-    float32 val = StaticicsCalculations::findSummation(data);
-    array6->initializeTuple(0, val);
-  }
-  if(inputValues->FindHistogram)
-  {
-    auto* array7 = dynamic_cast<Float32Array*>(arrays[7]);
-    if(array7 == nullptr)
-    {
-      throw std::invalid_argument("findStatisticsImpl() could not dynamic_cast 'Histogram' array to needed type. Check input array selection.");
-    }
-    auto* arr7DataStore = array7->getDataStore();
-    if(arr7DataStore != nullptr)
-    {
-      std::vector<float32> vals = StaticicsCalculations::findHistogram(data, inputValues->MinRange, inputValues->MaxRange, inputValues->UseFullRange, inputValues->NumBins);
-      arr7DataStore->setTuple(0, vals);
-    }
+    throw std::invalid_argument(fmt::format("findStatistics() could not dynamic_cast '{}' array to needed type. Check input array selection.", name));
   }
+  return castArray;
 }
 
 // -----------------------------------------------------------------------------
+/**
+ * @brief Computes the statistics of the source array, either for the whole array or
+ * separately for each feature id. The array is streamed once in parallel chunks that
+ * each accumulate partial statistics per feature. The partials are merged in chunk order
+ * so the result does not depend on the thread scheduling. Medians and histograms need
+ * every value, so when either is requested the values are bucketed by feature into one
+ * contiguous buffer with a counting sort and each feature is then processed in place.
+ */
 template <typename T>
-void findStatistics(const DataArray<T>& source, const Int32Array* featureIds, const std::unique_ptr<MaskCompare>& mask, const FindArrayStatisticsInputValues* inputValues,
+void findStatistics(const DataArray<T>& source, const Int32Array* featureIds, const MaskBitset* mask, const FindArrayStatisticsInputValues* inputValues,
                     std::vector<IDataArray*>& arrays, int32 numFeatures)
 {
-  usize numTuples = source.getNumberOfTuples();
-  if(inputValues->ComputeByIndex)
-  {
-    std::unordered_map<int32, std::list<T>> featureValueMap;
+  auto* lengthArray = castStatisticsArray<DataArray<uint64>>(inputValues->FindLength, arrays[0], "Length");
+  auto* minArray = castStatisticsArray<DataArray<T>>(inputValues->FindMin, arrays[1], "Min");
+  auto* maxArray = castStatisticsArray<DataArray<T>>(inputValues->FindMax, arrays[2], "Max");
+  auto* meanArray = castStatisticsArray<Float32Array>(inputValues->FindMean, arrays[3], "Mean");
+  auto* medianArray = castStatisticsArray<Float32Array>(inputValues->FindMedian, arrays[4], "Median");
+  auto* stdDevArray = castStatisticsArray<Float32Array>(inputValues->FindStdDeviation, arrays[5], "StdDev");
+  auto* summationArray = castStatisticsArray<Float32Array>(inputValues->FindSummation, arrays[6], "Summation");
+  auto* histogramArray = castStatisticsArray<Float32Array>(inputValues->FindHistogram, arrays[7], "Histogram");
+
+  const usize numTuples = source.getNumberOfTuples();
+  const usize numGroups = inputValues->ComputeByIndex ? static_cast<usize>(numFeatures) : 1;
+
+  // Visits the tuples of [begin, end) that are selected by the mask. Masked out tuples are
+  // skipped a whole bitset word at a time.
+  auto forEachTuple = [mask](usize begin, usize end, auto&& func) {
+    if(mask != nullptr)
+    {
+      mask->forEachSetBit(begin, end, func);
+      return;
+    }
+    for(usize i = begin; i < end; i++)
+    {
+      func(i);
+    }
+  };
 
-    for(size_t i = 0; i < numTuples; i++)
+  // Returns the feature a tuple contributes to, or a negative value if the tuple is skipped
+  auto findGroup = [&](usize index) -> int64 {
+    if(!inputValues->ComputeByIndex)
     {
-      if(inputValues->UseMask)
-      {
-        if(mask->isTrue(i))
+      return 0;
+    }
+    const int64 featureId = featureIds->at(index);
+    return featureId < static_cast<int64>(numGroups) ? featureId : -1;
+  };
+
+  const usize numThreads = static_cast<usize>(ParallelScheduler::GetCoreBudget());
+  const usize numChunks = std::clamp<usize>(numTuples / (numGroups * k_MinTuplesPerChunkFeature), 1, numThreads);
+  auto chunkBegin = [numTuples, numChunks](usize chunk) { return numTuples * chunk / numChunks; };
+
+  // Accumulate partial statistics for each chunk of tuples
+  std::vector<std::vector<StatisticsAccumulator<T>>> partials(numChunks, std::vector<StatisticsAccumulator<T>>(numGroups));
+  ParallelDataAlgorithm chunkAlg;
+  chunkAlg.setRange(0, numChunks);
+  chunkAlg.execute([&](const Range& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      std::vector<StatisticsAccumulator<T>>& accumulators = partials[chunk];
+      forEachTuple(chunkBegin(chunk), chunkBegin(chunk + 1), [&](usize i) {
+        const int64 group = findGroup(i);
+        if(group >= 0)
         {
-          featureValueMap[featureIds->at(i)].push_back(source[i]);
+          accumulators[static_cast<usize>(group)].add(source[i]);
         }
-      }
-      else
+      });
+    }
+  });
+
+  // Bucket the values of each feature into one contiguous buffer. The partial counts give
+  // every chunk its own write position inside each feature's range.
+  GroupedValues<T> groupedValues;
+  const bool needValues = inputValues->FindMedian || inputValues->FindHistogram;
+  if(needValues)
+  {
+    std::vector<std::vector<usize>> writePositions(numChunks, std::vector<usize>(numGroups));
+    groupedValues.offsets.resize(numGroups + 1, 0);
+    usize offset = 0;
+    for(usize group = 0; group < numGroups; group++)
+    {
+      groupedValues.offsets[group] = offset;
+      for(usize chunk = 0; chunk < numChunks; chunk++)
       {
-        featureValueMap[featureIds->at(i)].push_back(source[i]);
+        writePositions[chunk][group] = offset;
+        offset += partials[chunk][group].count;
       }
     }
+    groupedValues.offsets[numGroups] = offset;
+    groupedValues.values.resize(offset);
 
-    // compute the statistics by feature/ensemble id
-    findStatisticsByIndexImpl<T>(featureValueMap, arrays, inputValues, numFeatures);
+    chunkAlg.execute([&](const Range& range) {
+      for(usize chunk = range.min(); chunk < range.max(); chunk++)
+      {
+        std::vector<usize>& positions = writePositions[chunk];
+        forEachTuple(chunkBegin(chunk), chunkBegin(chunk + 1), [&](usize i) {
+          const int64 group = findGroup(i);
+          if(group >= 0)
+          {
+            groupedValues.values[positions[static_cast<usize>(group)]++] = source[i];
+          }
+        });
+      }
+    });
   }
-  else
-  {
-    std::vector<T> data;
-    data.reserve(numTuples);
-    for(size_t i = 0; i < numTuples; i++)
+
+  // Merge the partials and write the statistics of each feature
+  ParallelDataAlgorithm groupAlg;
+  groupAlg.setRange(0, numGroups);
+  groupAlg.execute([&](const Range& range) {
+    std::vector<float32> histogram(inputValues->FindHistogram ? inputValues->NumBins : 0);
+    for(usize group = range.min(); group < range.max(); group++)
     {
-      if(inputValues->UseMask)
+      StatisticsAccumulator<T> stats = partials[0][group];
+      for(usize chunk = 1; chunk < numChunks; chunk++)
       {
-        if(mask->isTrue(i))
-        {
-          data.push_back(source[i]);
-        }
+        stats.merge(partials[chunk][group]);
+      }
+      const bool empty = (stats.count == 0);
+
+      if(inputValues->FindLength)
+      {
+        lengthArray->initializeTuple(group, stats.count);
+      }
+      if(inputValues->FindMin)
+      {
+        minArray->initializeTuple(group, empty ? static_cast<T>(0) : stats.min);
+      }
+      if(inputValues->FindMax)
+      {
+        maxArray->initializeTuple(group, empty ? static_cast<T>(0) : stats.max);
+      }
+      if(inputValues->FindMean)
+      {
+        meanArray->initializeTuple(group, empty ? 0.0f : static_cast<float32>(stats.total()) / static_cast<float32>(stats.count));
       }
-      else
+      if(inputValues->FindMedian)
       {
-        data.push_back(source[i]);
+        medianArray->initializeTuple(group, findMedianInPlace(groupedValues.getGroup(group)));
+      }
+      if(inputValues->FindStdDeviation)
+      {
+        stdDevArray->initializeTuple(group, empty ? 0.0f : static_cast<float32>(std::sqrt(stats.m2 / static_cast<float64>(stats.count))));
+      }
+      if(inputValues->FindSummation)
+      {
+        summationArray->initializeTuple(group, static_cast<float32>(stats.total()));
+      }
+      if(inputValues->FindHistogram)
+      {
+        float32 histMin = static_cast<float32>(inputValues->MinRange);
+        float32 histMax = static_cast<float32>(inputValues->MaxRange);
+        if(inputValues->UseFullRange)
+        {
+          histMin = static_cast<float32>(stats.min);
+          histMax = static_cast<float32>(stats.max);
+        }
+        nonstd::span<const T> values = groupedValues.getGroup(group);
+        fillHistogram(values, histMin, histMax, inputValues->NumBins, histogram);
+        histogramArray->getDataStoreRef().setTuple(group, nonstd::span<const float32>(histogram.data(), histogram.size()));
       }
     }
-
-    data.shrink_to_fit();
-
-    // compute the statistics for the entire array
-    findStatisticsImpl<T>(data, arrays, inputValues);
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void standardizeDataByIndex(const DataArray<T>& data, bool useMask, const std::unique_ptr<MaskCompare>& mask, const Int32Array* featureIds, const Float32Array& mu, const Float32Array& sig,
-                            Float32Array& standardized)
+void standardizeDataByIndex(const DataArray<T>& data, const MaskBitset* mask, const Int32Array* featureIds, const Float32Array& mu, const Float32Array& sig, Float32Array& standardized)
 {
+  auto standardize = [&](usize i) { standardized[i] = (static_cast<float32>(data[i]) - mu[featureIds->at(i)]) / sig[featureIds->at(i)]; };
+  if(mask != nullptr)
+  {
+    mask->forEachSetBit(standardize);
+    return;
+  }
   size_t numTuples = data.getNumberOfTuples();
   for(size_t i = 0; i < numTuples; i++)
   {
-    if(useMask)
-    {
-      if(mask->isTrue(i))
-      {
-        standardized[i] = (static_cast<float32>(data[i]) - mu[featureIds->at(i)]) / sig[featureIds->at(i)];
-      }
-    }
-    else
-    {
-      standardized[i] = (static_cast<float32>(data[i]) - mu[featureIds->at(i)]) / sig[featureIds->at(i)];
-    }
+    standardize(i);
   }
 }
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void standardizeData(const DataArray<T>& data, bool useMask, const std::unique_ptr<MaskCompare>& mask, const Float32Array& mu, const Float32Array& sig, Float32Array& standardized)
+void standardizeData(const DataArray<T>& data, const MaskBitset* mask, const Float32Array& mu, const Float32Array& sig, Float32Array& standardized)
 {
+  auto standardize = [&](usize i) { standardized[i] = (static_cast<float32>(data[i]) - mu[0]) / sig[0]; };
+  if(mask != nullptr)
+  {
+    mask->forEachSetBit(standardize);
+    return;
+  }
   size_t numTuples = data.getNumberOfTuples();
-
   for(size_t i = 0; i < numTuples; i++)
   {
-    if(useMask)
-    {
-      if(mask->isTrue(i))
-      {
-        standardized[i] = (static_cast<float32>(data[i]) - mu[0]) / sig[0];
-      }
-    }
-    else
-    {
-      standardized[i] = (static_cast<float32>(data[i]) - mu[0]) / sig[0];
-    }
+    standardize(i);
   }
 }
 
+struct FindStatsFunctor
+{
+  template <typename T>
+  Result<> operator()(FindArrayStatistics& filter, const IDataArray& inputArray, std::vector<IDataArray*>& arrays, int32 numFeatures)
+  {
+    return filter.findStats<T>(dynamic_cast<const DataArray<T>&>(inputArray), arrays, numFeatures);
+  }
+};
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -380,12 +424,12 @@ Result<> FindArrayStatistics::findStats(const DataArray<T>& inputArray, std::vec
   {
     featureIds = m_DataStructure.getDataAs<Int32Array>(m_InputValues->FeatureIdsArrayPath);
   }
-  std::unique_ptr<MaskCompare> maskCompare = nullptr;
+  std::optional<MaskBitset> mask;
   if(m_InputValues->UseMask)
   {
     try
     {
-      maskCompare = InstantiateMaskCompare(m_DataStructure, m_InputValues->MaskArrayPath);
+      mask = MaskBitset::Create(m_DataStructure, m_InputValues->MaskArrayPath);
     } catch(const std::out_of_range& exception)
     {
       // This really should NOT be happening as the path was verified during preflight BUT we may be calling this from
@@ -396,7 +440,8 @@ Result<> FindArrayStatistics::findStats(const DataArray<T>& inputArray, std::vec
   }
 
   // this level checks whether computing by index or not and preps the calculations accordingly
-  findStatistics<T>(inputArray, featureIds, maskCompare, m_InputValues, arrays, numFeatures);
+  const MaskBitset* maskPtr = mask.has_value() ? &mask.value() : nullptr;
+  findStatistics<T>(inputArray, featureIds, maskPtr, m_InputValues, arrays, numFeatures);
 
   // compute the standardized data based on whether computing by index or not
   if(m_InputValues->StandardizeData)
@@ -407,11 +452,11 @@ Result<> FindArrayStatistics::findStats(const DataArray<T>& inputArray, std::vec
 
     if(m_InputValues->ComputeByIndex)
     {
-      standardizeDataByIndex<T>(inputArray, m_InputValues->UseMask, maskCompare, featureIds, mean, std, standardized);
+      standardizeDataByIndex<T>(inputArray, maskPtr, featureIds, mean, std, standardized);
     }
     else
     {
-      standardizeData<T>(inputArray, m_InputValues->UseMask, maskCompare, mean, std, standardized);
+      standardizeData<T>(inputArray, maskPtr, mean, std, standardized);
     }
   }
   return {};
@@ -500,44 +545,11 @@ Result<> FindArrayStatistics::operator()()
 
   const auto& inputArray = m_DataStructure.getDataRefAs<IDataArray>(m_InputValues->SelectedArrayPath);
   auto dataType = inputArray.getDataType();
-  switch(dataType)
+  if(!IsDataTypeInList<NumericDataTypes>(dataType))
   {
-  case DataType::int8: {
-    return findStats<int8>(m_DataStructure.getDataRefAs<Int8Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::int16: {
-    return findStats<int16>(m_DataStructure.getDataRefAs<Int16Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::int32: {
-    return findStats<int32>(m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::int64: {
-    return findStats<int64>(m_DataStructure.getDataRefAs<Int64Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::uint8: {
-    return findStats<uint8>(m_DataStructure.getDataRefAs<UInt8Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::uint16: {
-    return findStats<uint16>(m_DataStructure.getDataRefAs<UInt16Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::uint32: {
-    return findStats<uint32>(m_DataStructure.getDataRefAs<UInt32Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::uint64: {
-    return findStats<uint64>(m_DataStructure.getDataRefAs<UInt64Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::float32: {
-    return findStats<float32>(m_DataStructure.getDataRefAs<Float32Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::float64: {
-    return findStats<float64>(m_DataStructure.getDataRefAs<Float64Array>(m_InputValues->SelectedArrayPath), arrays, numFeatures);
-  }
-  case DataType::boolean: {
     return {};
   }
-  }
-
-  return {};
+  return ExecuteDataFunctionFor<NumericDataTypes>(FindStatsFunctor{}, dataType, *this, inputArray, arrays, numFeatures);
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,535 @@
+#include "InterpolatePointCloudToRegularGrid.hpp"
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/DataStructure/Geometry/VertexGeom.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
+#include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+
+using namespace complex;
+
+namespace
+{
+constexpr int64 k_VoxelIndexOutOfBounds = -24502;
+
+/**
+ * @brief Kernel weights and distances for every voxel offset in [-radius, radius]. Offsets are
+ * stored with x varying fastest.
+ */
+struct InterpolationKernel
+{
+  std::array<int64, 3> radius = {0, 0, 0};
+  std::array<int64, 3> extent = {1, 1, 1};
+  std::vector<float32> weights;
+  std::vector<float32> distances;
+
+  usize index(int64 dx, int64 dy, int64 dz) const
+  {
+    return static_cast<usize>(((dz + radius[2]) * extent[1] + (dy + radius[1])) * extent[0] + (dx + radius[0]));
+  }
+};
+
+/**
+ * @brief Converts the kernel size in real space units into voxel radii and precomputes the
+ * uniform or Gaussian weight and the real space distance of every kernel offset.
+ */
+InterpolationKernel CreateKernel(uint64 interpolationTechnique, const std::vector<float32>& kernelSize, const std::vector<float32>& sigmas, const FloatVec3& spacing)
+{
+  InterpolationKernel kernel;
+  for(usize i = 0; i < 3; i++)
+  {
+    kernel.radius[i] = kernelSize[i] < spacing[i] ? 0 : static_cast<int64>(std::ceil((kernelSize[i] / spacing[i]) * 0.5f));
+    kernel.extent[i] = kernel.radius[i] * 2 + 1;
+  }
+
+  const usize totalKernel = kernel.extent[0] * kernel.extent[1] * kernel.extent[2];
+  kernel.weights.resize(totalKernel);
+  kernel.distances.resize(totalKernel);
+
+  const auto& r = kernel.radius;
+  for(int64 z = -r[2]; z <= r[2]; z++)
+  {
+    for(int64 y = -r[1]; y <= r[1]; y++)
+    {
+      for(int64 x = -r[0]; x <= r[0]; x++)
+      {
+        const usize index = kernel.index(x, y, z);
+        if(interpolationTechnique == InterpolatePointCloudToRegularGrid::k_Gaussian)
+        {
+          kernel.weights[index] =
+              static_cast<float32>(std::exp(-((x * x) / (2 * sigmas[0] * sigmas[0]) + (y * y) / (2 * sigmas[1] * sigmas[1]) + (z * z) / (2 * sigmas[2] * sigmas[2]))));
+        }
+        else
+        {
+          kernel.weights[index] = 1.0f;
+        }
+        kernel.distances[index] = static_cast<float32>(std::sqrt((x * x * spacing[0] * spacing[0]) + (y * y * spacing[1] * spacing[1]) + (z * z * spacing[2] * spacing[2])));
+      }
+    }
+  }
+  return kernel;
+}
+
+/**
+ * @brief The points of each voxel in compressed sparse row form. The points of voxel v are
+ * pointIds[offsets[v], offsets[v + 1]) in increasing order.
+ */
+struct PointBins
+{
+  std::vector<usize> offsets;
+  std::vector<usize> pointIds;
+};
+
+/**
+ * @brief Bins the (unmasked) points by the voxel they lie in with a counting sort.
+ */
+Result<PointBins> BinPoints(const AbstractDataStore<usize>& voxelIndices, const AbstractDataStore<bool>* mask, usize numPoints, usize numVoxels)
+{
+  PointBins bins;
+  bins.offsets.assign(numVoxels + 1, 0);
+  for(usize i = 0; i < numPoints; i++)
+  {
+    if(mask != nullptr && !mask->getValue(i))
+    {
+      continue;
+    }
+    const usize index = voxelIndices.getValue(i);
+    if(index >= numVoxels)
+    {
+      return MakeErrorResult<PointBins>(k_VoxelIndexOutOfBounds,
+                                        fmt::format("Index present in the selected Voxel Indices array that falls outside the selected Image Geometry for interpolation.\n Index = {}\n Max Image Index = {}\n",
+                                                    index, numVoxels - 1));
+    }
+    bins.offsets[index + 1]++;
+  }
+  for(usize v = 0; v < numVoxels; v++)
+  {
+    bins.offsets[v + 1] += bins.offsets[v];
+  }
+
+  bins.pointIds.resize(bins.offsets[numVoxels]);
+  std::vector<usize> cursor(bins.offsets.begin(), bins.offsets.end() - 1);
+  for(usize i = 0; i < numPoints; i++)
+  {
+    if(mask != nullptr && !mask->getValue(i))
+    {
+      continue;
+    }
+    bins.pointIds[cursor[voxelIndices.getValue(i)]++] = i;
+  }
+  return {std::move(bins)};
+}
+
+/**
+ * @brief Visits every point whose kernel covers a voxel. A point in voxel s covers voxel v with the
+ * kernel offset v - s, so each voxel only reads the bins within the kernel radius and never writes
+ * to shared state.
+ */
+class SplatGrid
+{
+public:
+  SplatGrid(const SizeVec3& dims, const InterpolationKernel& kernel, const PointBins& bins)
+  : m_Dims(dims)
+  , m_Kernel(kernel)
+  , m_Bins(bins)
+  {
+  }
+
+  usize getNumberOfVoxels() const
+  {
+    return m_Dims[0] * m_Dims[1] * m_Dims[2];
+  }
+
+  /**
+   * @brief Calls func(kernelIndex, pointId) for every contribution to the voxel in a fixed order.
+   * Offsets with a zero weight are skipped.
+   */
+  template <class FuncT>
+  void forEachContribution(usize voxel, FuncT&& func) const
+  {
+    const auto x = static_cast<int64>(voxel % m_Dims[0]);
+    const auto y = static_cast<int64>((voxel / m_Dims[0]) % m_Dims[1]);
+    const auto z = static_cast<int64>(voxel / (m_Dims[0] * m_Dims[1]));
+    const auto& r = m_Kernel.radius;
+    const auto dimX = static_cast<int64>(m_Dims[0]);
+    const auto dimY = static_cast<int64>(m_Dims[1]);
+    const auto dimZ = static_cast<int64>(m_Dims[2]);
+
+    for(int64 dz = -r[2]; dz <= r[2]; dz++)
+    {
+      const int64 sz = z - dz;
+      if(sz < 0 || sz >= dimZ)
+      {
+        continue;
+      }
+      for(int64 dy = -r[1]; dy <= r[1]; dy++)
+      {
+        const int64 sy = y - dy;
+        if(sy < 0 || sy >= dimY)
+        {
+          continue;
+        }
+        for(int64 dx = -r[0]; dx <= r[0]; dx++)
+        {
+          const int64 sx = x - dx;
+          if(sx < 0 || sx >= dimX)
+          {
+            continue;
+          }
+          const usize kernelIndex = m_Kernel.index(dx, dy, dz);
+          if(m_Kernel.weights[kernelIndex] == 0.0f)
+          {
+            continue;
+          }
+          const auto bin = static_cast<usize>((sz * dimY + sy) * dimX + sx);
+          for(usize k = m_Bins.offsets[bin]; k < m_Bins.offsets[bin + 1]; k++)
+          {
+            func(kernelIndex, m_Bins.pointIds[k]);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  SizeVec3 m_Dims;
+  const InterpolationKernel& m_Kernel;
+  const PointBins& m_Bins;
+};
+
+/**
+ * @brief Counts the contributions of every voxel in the range.
+ */
+class CountContributionsImpl
+{
+public:
+  CountContributionsImpl(const SplatGrid& grid, std::vector<usize>& counts)
+  : m_Grid(grid)
+  , m_Counts(counts)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize v = range.min(); v < range.max(); v++)
+    {
+      usize count = 0;
+      m_Grid.forEachContribution(v, [&count](usize, usize) { count++; });
+      m_Counts[v] = count;
+    }
+  }
+
+private:
+  const SplatGrid& m_Grid;
+  std::vector<usize>& m_Counts;
+};
+
+/**
+ * @brief Read-only view over the values of a data store. Stores that are not contiguous are copied
+ * once so that the gather can read them from any thread.
+ */
+template <typename T>
+class ValueSource
+{
+public:
+  explicit ValueSource(const AbstractDataStore<T>& store)
+  {
+    if(store.isContiguous())
+    {
+      m_Values = store.contiguousSpan();
+      return;
+    }
+    const usize size = store.getSize();
+    m_Buffer = std::make_unique<T[]>(size);
+    store.copyIntoBuffer(0, nonstd::span<T>(m_Buffer.get(), size));
+    m_Values = nonstd::span<const T>(m_Buffer.get(), size);
+  }
+
+  T operator[](usize index) const
+  {
+    return m_Values[index];
+  }
+
+private:
+  std::unique_ptr<T[]> m_Buffer;
+  nonstd::span<const T> m_Values;
+};
+
+/**
+ * @brief Fills the neighbor list values and the weighted averages of every voxel in the range.
+ * Each voxel writes its own slice of the list values and its own average.
+ */
+template <typename T>
+class GatherArrayImpl
+{
+public:
+  using ListValuesType = std::conditional_t<std::is_same_v<T, bool>, std::vector<uint8>, std::vector<T>>;
+
+  GatherArrayImpl(const SplatGrid& grid, const std::vector<float32>& weights, const ValueSource<T>& values, const std::vector<usize>* listOffsets, ListValuesType* listValues,
+                  std::vector<float32>* averages)
+  : m_Grid(grid)
+  , m_Weights(weights)
+  , m_Values(values)
+  , m_ListOffsets(listOffsets)
+  , m_ListValues(listValues)
+  , m_Averages(averages)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize v = range.min(); v < range.max(); v++)
+    {
+      usize listIndex = m_ListOffsets != nullptr ? (*m_ListOffsets)[v] : 0;
+      float64 weightedSum = 0.0;
+      float64 weightSum = 0.0;
+      m_Grid.forEachContribution(v, [&](usize kernelIndex, usize pointId) {
+        const float32 weight = m_Weights[kernelIndex];
+        const T value = m_Values[pointId];
+        if constexpr(!std::is_same_v<T, bool>)
+        {
+          if(m_ListValues != nullptr)
+          {
+            (*m_ListValues)[listIndex++] = static_cast<T>(weight * value);
+          }
+        }
+        weightedSum += static_cast<float64>(weight) * static_cast<float64>(value);
+        weightSum += weight;
+      });
+      if(m_Averages != nullptr)
+      {
+        (*m_Averages)[v] = weightSum > 0.0 ? static_cast<float32>(weightedSum / weightSum) : 0.0f;
+      }
+    }
+  }
+
+private:
+  const SplatGrid& m_Grid;
+  const std::vector<float32>& m_Weights;
+  const ValueSource<T>& m_Values;
+  const std::vector<usize>* m_ListOffsets = nullptr;
+  ListValuesType* m_ListValues = nullptr;
+  std::vector<float32>* m_Averages = nullptr;
+};
+
+struct InterpolateArrayFunctor
+{
+  template <typename T>
+  void operator()(const SplatGrid& grid, const std::vector<float32>& weights, const IDataArray& source, INeighborList* neighborList, Float32Array* averagesArray,
+                  const std::vector<usize>& listOffsets)
+  {
+    const ValueSource<T> values(dynamic_cast<const DataArray<T>&>(source).getDataStoreRef());
+    const usize numVoxels = grid.getNumberOfVoxels();
+
+    using ListValuesType = typename GatherArrayImpl<T>::ListValuesType;
+    ListValuesType listValues;
+    ListValuesType* listValuesPtr = nullptr;
+    if constexpr(!std::is_same_v<T, bool>)
+    {
+      if(neighborList != nullptr)
+      {
+        listValues.resize(listOffsets.back());
+        listValuesPtr = &listValues;
+      }
+    }
+    std::vector<float32> averages;
+    if(averagesArray != nullptr)
+    {
+      averages.resize(numVoxels);
+    }
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numVoxels);
+    dataAlg.execute(GatherArrayImpl<T>(grid, weights, values, listValuesPtr != nullptr ? &listOffsets : nullptr, listValuesPtr, averagesArray != nullptr ? &averages : nullptr));
+
+    if constexpr(!std::is_same_v<T, bool>)
+    {
+      if(listValuesPtr != nullptr)
+      {
+        dynamic_cast<NeighborList<T>&>(*neighborList).setCompressedLists(std::vector<usize>(listOffsets), std::move(listValues));
+      }
+    }
+    if(averagesArray != nullptr)
+    {
+      averagesArray->getDataStoreRef().copyFromBuffer(0, nonstd::span<const float32>(averages));
+    }
+  }
+};
+
+/**
+ * @brief Fills the kernel distance of every contribution of the voxels in the range.
+ */
+class GatherKernelDistancesImpl
+{
+public:
+  GatherKernelDistancesImpl(const SplatGrid& grid, const std::vector<float32>& distances, const std::vector<usize>& listOffsets, std::vector<float32>& listValues)
+  : m_Grid(grid)
+  , m_Distances(distances)
+  , m_ListOffsets(listOffsets)
+  , m_ListValues(listValues)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize v = range.min(); v < range.max(); v++)
+    {
+      usize listIndex = m_ListOffsets[v];
+      m_Grid.forEachContribution(v, [&](usize kernelIndex, usize) { m_ListValues[listIndex++] = m_Distances[kernelIndex]; });
+    }
+  }
+
+private:
+  const SplatGrid& m_Grid;
+  const std::vector<float32>& m_Distances;
+  const std::vector<usize>& m_ListOffsets;
+  std::vector<float32>& m_ListValues;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+InterpolatePointCloudToRegularGrid::InterpolatePointCloudToRegularGrid(DataStructure& dataStructure, const IFilter::MessageHandler& mesgHandler, const std::atomic_bool& shouldCancel,
+                                                                       InterpolatePointCloudToRegularGridInputValues* inputValues)
+: m_DataStructure(dataStructure)
+, m_InputValues(inputValues)
+, m_ShouldCancel(shouldCancel)
+, m_MessageHandler(mesgHandler)
+{
+}
+
+// -----------------------------------------------------------------------------
+InterpolatePointCloudToRegularGrid::~InterpolatePointCloudToRegularGrid() noexcept = default;
+
+// -----------------------------------------------------------------------------
+const std::atomic_bool& InterpolatePointCloudToRegularGrid::getCancel()
+{
+  return m_ShouldCancel;
+}
+
+// -----------------------------------------------------------------------------
+Result<> InterpolatePointCloudToRegularGrid::operator()()
+{
+  const auto& vertexGeom = m_DataStructure.getDataRefAs<VertexGeom>(m_InputValues->VertexGeomPath);
+  const auto& image = m_DataStructure.getDataRefAs<ImageGeom>(m_InputValues->ImageGeomPath);
+  const SizeVec3 dims = image.getDimensions();
+  const usize numVoxels = dims[0] * dims[1] * dims[2];
+  const usize numVerts = vertexGeom.getNumberOfVertices();
+
+  const auto& voxelIndices = m_DataStructure.getDataRefAs<USizeArray>(m_InputValues->VoxelIndicesPath).getDataStoreRef();
+  const AbstractDataStore<bool>* mask = nullptr;
+  if(m_InputValues->UseMask)
+  {
+    mask = &m_DataStructure.getDataRefAs<BoolArray>(m_InputValues->MaskPath).getDataStoreRef();
+  }
+
+  const InterpolationKernel kernel = CreateKernel(m_InputValues->InterpolationTechnique, m_InputValues->KernelSize, m_InputValues->GaussianSigmas, image.getSpacing());
+  InterpolationKernel uniformKernel = kernel;
+  std::fill(uniformKernel.weights.begin(), uniformKernel.weights.end(), 1.0f);
+
+  m_MessageHandler(IFilter::Message::Type::Info, "Binning points by voxel");
+  auto binsResult = BinPoints(voxelIndices, mask, numVerts, numVoxels);
+  if(binsResult.invalid())
+  {
+    return ConvertResult(std::move(binsResult));
+  }
+  const PointBins bins = std::move(binsResult.value());
+  if(m_ShouldCancel)
+  {
+    return {};
+  }
+
+  const SplatGrid grid(dims, kernel, bins);
+  const SplatGrid uniformGrid(dims, uniformKernel, bins);
+
+  // Zero weights are skipped, so each kernel needs its own list layout unless no Gaussian
+  // weight underflowed to zero
+  auto computeListOffsets = [numVoxels](const SplatGrid& listGrid) {
+    std::vector<usize> counts(numVoxels);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numVoxels);
+    dataAlg.execute(CountContributionsImpl(listGrid, counts));
+
+    std::vector<usize> offsets(numVoxels + 1, 0);
+    for(usize v = 0; v < numVoxels; v++)
+    {
+      offsets[v + 1] = offsets[v] + counts[v];
+    }
+    return offsets;
+  };
+
+  std::vector<usize> listOffsets;
+  if(m_InputValues->StoreNeighborLists || m_InputValues->StoreKernelDistances)
+  {
+    listOffsets = computeListOffsets(grid);
+  }
+  std::vector<usize> uniformListOffsets;
+  const bool kernelSkipsOffsets = std::find(kernel.weights.begin(), kernel.weights.end(), 0.0f) != kernel.weights.end();
+  if(m_InputValues->StoreNeighborLists && !m_InputValues->CopyArrayPaths.empty())
+  {
+    uniformListOffsets = kernelSkipsOffsets ? computeListOffsets(uniformGrid) : listOffsets;
+  }
+
+  auto interpolateArrays = [&](const std::vector<DataPath>& arrayPaths, const SplatGrid& arrayGrid, const std::vector<float32>& weights, const std::vector<usize>& arrayListOffsets) {
+    for(const auto& arrayPath : arrayPaths)
+    {
+      if(m_ShouldCancel)
+      {
+        return Result<>{};
+      }
+      m_MessageHandler(IFilter::Message::Type::Info, fmt::format("Interpolating '{}'", arrayPath.getTargetName()));
+
+      const auto& source = m_DataStructure.getDataRefAs<IDataArray>(arrayPath);
+      // The array under the source name keeps holding a copy of the source values
+      Result<> copyResult = DeepCopy<IDataArray>(m_DataStructure, arrayPath, m_InputValues->InterpolatedGroupPath.createChildPath(source.getName()));
+      if(copyResult.invalid())
+      {
+        return copyResult;
+      }
+      INeighborList* neighborList = nullptr;
+      if(m_InputValues->StoreNeighborLists && source.getDataType() != DataType::boolean)
+      {
+        neighborList = m_DataStructure.getDataAs<INeighborList>(m_InputValues->InterpolatedGroupPath.createChildPath(source.getName() + std::string(k_NeighborListSuffix)));
+      }
+      Float32Array* averages = nullptr;
+      if(m_InputValues->StoreWeightedAverages)
+      {
+        averages = m_DataStructure.getDataAs<Float32Array>(m_InputValues->InterpolatedGroupPath.createChildPath(source.getName() + std::string(k_WeightedAverageSuffix)));
+      }
+      ExecuteDataFunction(InterpolateArrayFunctor{}, source.getDataType(), arrayGrid, weights, source, neighborList, averages, arrayListOffsets);
+    }
+    return Result<>{};
+  };
+
+  Result<> interpolateResult = interpolateArrays(m_InputValues->InterpolateArrayPaths, grid, kernel.weights, listOffsets);
+  if(interpolateResult.invalid())
+  {
+    return interpolateResult;
+  }
+  // Copied arrays are passed through with a uniform kernel
+  Result<> copyResult = interpolateArrays(m_InputValues->CopyArrayPaths, uniformGrid, uniformKernel.weights, uniformListOffsets);
+  if(copyResult.invalid())
+  {
+    return copyResult;
+  }
+
+  if(m_InputValues->StoreKernelDistances && !m_ShouldCancel)
+  {
+    m_MessageHandler(IFilter::Message::Type::Info, "Storing kernel distances");
+    std::vector<float32> distances(listOffsets.back());
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numVoxels);
+    dataAlg.execute(GatherKernelDistancesImpl(grid, kernel.distances, listOffsets, distances));
+
+    auto& kernelDistances = m_DataStructure.getDataRefAs<Float32NeighborList>(m_InputValues->KernelDistancesGroupPath.createChildPath(k_KernelDistancesName));
+    kernelDistances.setCompressedLists(std::vector<usize>(listOffsets), std::move(distances));
+  }
+
+  return {};
+}
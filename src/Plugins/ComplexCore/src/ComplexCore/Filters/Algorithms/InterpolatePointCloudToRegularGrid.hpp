@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ComplexCore/ComplexCore_export.hpp"
+
+#include "complex/Common/StringLiteral.hpp"
+#include "complex/DataStructure/DataPath.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Filter/IFilter.hpp"
+
+#include <vector>
+
+namespace complex
+{
+
+struct COMPLEXCORE_EXPORT InterpolatePointCloudToRegularGridInputValues
+{
+  DataPath VertexGeomPath;
+  DataPath ImageGeomPath;
+  DataPath VoxelIndicesPath;
+  bool UseMask = false;
+  DataPath MaskPath;
+  uint64 InterpolationTechnique = 0;
+  std::vector<float32> KernelSize;
+  std::vector<float32> GaussianSigmas;
+  std::vector<DataPath> InterpolateArrayPaths;
+  std::vector<DataPath> CopyArrayPaths;
+  DataPath InterpolatedGroupPath;
+  bool StoreNeighborLists = true;
+  bool StoreWeightedAverages = true;
+  bool StoreKernelDistances = false;
+  DataPath KernelDistancesGroupPath;
+};
+
+/**
+ * @class InterpolatePointCloudToRegularGrid
+ * @brief This algorithm interpolates vertex arrays onto the cells of an Image Geometry.
+ * The vertices are binned by the voxel they fall in and every voxel then gathers the
+ * weighted values of the bins within the kernel radius, so voxels can be filled in parallel.
+ */
+class COMPLEXCORE_EXPORT InterpolatePointCloudToRegularGrid
+{
+public:
+  static inline constexpr uint64 k_Uniform = 0;
+  static inline constexpr uint64 k_Gaussian = 1;
+
+  static inline constexpr StringLiteral k_NeighborListSuffix = " Neighbors";
+  static inline constexpr StringLiteral k_WeightedAverageSuffix = " Weighted Average";
+  static inline constexpr StringLiteral k_KernelDistancesName = "Neighbor List";
+
+  InterpolatePointCloudToRegularGrid(DataStructure& dataStructure, const IFilter::MessageHandler& mesgHandler, const std::atomic_bool& shouldCancel,
+                                     InterpolatePointCloudToRegularGridInputValues* inputValues);
+  ~InterpolatePointCloudToRegularGrid() noexcept;
+
+  InterpolatePointCloudToRegularGrid(const InterpolatePointCloudToRegularGrid&) = delete;
+  InterpolatePointCloudToRegularGrid(InterpolatePointCloudToRegularGrid&&) noexcept = delete;
+  InterpolatePointCloudToRegularGrid& operator=(const InterpolatePointCloudToRegularGrid&) = delete;
+  InterpolatePointCloudToRegularGrid& operator=(InterpolatePointCloudToRegularGrid&&) noexcept = delete;
+
+  Result<> operator()();
+
+  const std::atomic_bool& getCancel();
+
+private:
+  DataStructure& m_DataStructure;
+  const InterpolatePointCloudToRegularGridInputValues* m_InputValues = nullptr;
+  const std::atomic_bool& m_ShouldCancel;
+  const IFilter::MessageHandler& m_MessageHandler;
+};
+
+} // namespace complex
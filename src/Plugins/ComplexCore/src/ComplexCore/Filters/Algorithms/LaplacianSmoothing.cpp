@@ -5,9 +5,116 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/Geometry/INodeGeometry2D.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <array>
 
 using namespace complex;
 
+namespace
+{
+/**
+ * @brief Vertex adjacency in compressed sparse row form. The neighbors of vertex i are
+ * neighbors[offsets[i], offsets[i + 1]) and appear in the order of the shared edge list.
+ */
+struct VertexAdjacency
+{
+  std::vector<usize> offsets;
+  std::vector<IGeometry::MeshIndexType> neighbors;
+};
+
+/**
+ * @brief Builds the vertex adjacency from the unique edges with a counting sort.
+ * @param edges The shared edge list
+ * @param numVertices The number of vertices in the geometry
+ * @return VertexAdjacency
+ */
+VertexAdjacency BuildVertexAdjacency(const IGeometry::SharedEdgeList& edges, usize numVertices)
+{
+  const auto& edgeStore = edges.getDataStoreRef();
+  const usize numEdges = edges.getNumberOfTuples();
+
+  VertexAdjacency adjacency;
+  adjacency.offsets.assign(numVertices + 1, 0);
+  for(usize i = 0; i < numEdges * 2; i++)
+  {
+    adjacency.offsets[edgeStore[i] + 1]++;
+  }
+  for(usize i = 0; i < numVertices; i++)
+  {
+    adjacency.offsets[i + 1] += adjacency.offsets[i];
+  }
+
+  adjacency.neighbors.resize(numEdges * 2);
+  std::vector<usize> cursors(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+  for(usize i = 0; i < numEdges; i++)
+  {
+    const IGeometry::MeshIndexType in1 = edgeStore[2 * i];
+    const IGeometry::MeshIndexType in2 = edgeStore[2 * i + 1];
+    adjacency.neighbors[cursors[in1]++] = in2;
+    adjacency.neighbors[cursors[in2]++] = in1;
+  }
+  return adjacency;
+}
+
+/**
+ * @brief Moves every vertex in the range towards the average of its neighbors. Each vertex only
+ * reads the input positions and writes its own output position, so ranges need no synchronization.
+ * Vertices without any edges keep their position.
+ */
+class SmoothVerticesImpl
+{
+public:
+  SmoothVerticesImpl(const VertexAdjacency& adjacency, const std::vector<float32>& lambdas, float32 lambdaScale, const std::vector<float32>& positions, std::vector<float32>& smoothedPositions)
+  : m_Adjacency(adjacency)
+  , m_Lambdas(lambdas)
+  , m_LambdaScale(lambdaScale)
+  , m_Positions(positions)
+  , m_SmoothedPositions(smoothedPositions)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      const usize first = m_Adjacency.offsets[i];
+      const usize last = m_Adjacency.offsets[i + 1];
+      if(first == last)
+      {
+        std::copy_n(m_Positions.begin() + 3 * i, 3, m_SmoothedPositions.begin() + 3 * i);
+        continue;
+      }
+
+      std::array<float64, 3> delta = {0.0, 0.0, 0.0};
+      for(usize k = first; k < last; k++)
+      {
+        const usize neighbor = m_Adjacency.neighbors[k];
+        for(usize j = 0; j < 3; j++)
+        {
+          delta[j] += static_cast<float64>(m_Positions[3 * neighbor + j] - m_Positions[3 * i + j]);
+        }
+      }
+
+      const float32 ll = m_Lambdas[i] * m_LambdaScale;
+      const auto numConnections = static_cast<float64>(last - first);
+      for(usize j = 0; j < 3; j++)
+      {
+        m_SmoothedPositions[3 * i + j] = static_cast<float32>(m_Positions[3 * i + j] + ll * (delta[j] / numConnections));
+      }
+    }
+  }
+
+private:
+  const VertexAdjacency& m_Adjacency;
+  const std::vector<float32>& m_Lambdas;
+  float32 m_LambdaScale = 1.0f;
+  const std::vector<float32>& m_Positions;
+  std::vector<float32>& m_SmoothedPositions;
+};
+} // namespace
+
 LaplacianSmoothing::LaplacianSmoothing(DataStructure& dataStructure, LaplacianSmoothingInputValues* inputValues, const std::atomic_bool& shouldCancel, const IFilter::MessageHandler& mesgHandler)
 : m_DataStructure(dataStructure)
 , m_InputValues(inputValues)
@@ -23,14 +130,10 @@ Result<> LaplacianSmoothing::operator()()
   return edgeBasedSmoothing();
 }
 
-// -----------------------------------------------------------------------------
-//
 // -----------------------------------------------------------------------------
 Result<> LaplacianSmoothing::edgeBasedSmoothing()
 {
   int32_t err = 0;
-  //  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
-  //  IGeometry2D::Pointer surfaceMesh = sm->getGeometryAs<IGeometry2D>();
 
   TriangleGeom& surfaceMesh = m_DataStructure.getDataRefAs<TriangleGeom>(m_InputValues->pTriangleGeometryDataPath);
 
@@ -50,13 +153,20 @@ Result<> LaplacianSmoothing::edgeBasedSmoothing()
     return MakeErrorResult(-560, "Error retrieving the shared edge list");
   }
 
-  IGeometry::SharedEdgeList& uedges = *(surfaceMesh.getEdges());
-  IGeometry::MeshIndexType nedges = uedges.getNumberOfTuples();
+  // The adjacency only depends on the connectivity so it is built once for all iterations
+  const VertexAdjacency adjacency = BuildVertexAdjacency(*(surfaceMesh.getEdges()), nvert);
 
-  std::vector<int32_t> numConnections(nvert, 0);
+  // Every pass reads the current positions and writes the moved positions into the other buffer
+  std::vector<float32> positions(nvert * 3);
+  std::vector<float32> smoothedPositions(nvert * 3);
+  verts.getDataStoreRef().copyIntoBuffer(0, nonstd::span<float32>(positions));
 
-  std::vector<double> deltaArray(nvert * 3);
-  double dlta = 0.0;
+  auto smoothPass = [&](float32 lambdaScale) {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, nvert);
+    dataAlg.execute(SmoothVerticesImpl(adjacency, lambdas, lambdaScale, positions, smoothedPositions));
+    positions.swap(smoothedPositions);
+  };
 
   for(int32_t q = 0; q < m_InputValues->pIterationSteps; q++)
   {
@@ -65,89 +175,23 @@ Result<> LaplacianSmoothing::edgeBasedSmoothing()
       return {};
     }
     m_MessageHandler(IFilter::Message::Type::Info, fmt::format("Iteration {} of {}", q, m_InputValues->pIterationSteps));
-    // Compute the Deltas for each point
-    for(IGeometry::MeshIndexType i = 0; i < nedges; i++)
-    {
-      IGeometry::MeshIndexType in1 = uedges[2 * i];     // row of the first vertex
-      IGeometry::MeshIndexType in2 = uedges[2 * i + 1]; // row the second vertex
-
-      for(IGeometry::MeshIndexType j = 0; j < 3; j++)
-      {
-#if 0
-        Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-        Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-#endif
-        dlta = static_cast<double>(verts[3 * in2 + j] - verts[3 * in1 + j]);
-        deltaArray[3 * in1 + j] += dlta;
-        deltaArray[3 * in2 + j] += -1.0 * dlta;
-      }
-      numConnections[in1] += 1;
-      numConnections[in2] += 1;
-    }
-
-    // Move each point
-    for(IGeometry::MeshIndexType i = 0; i < nvert; i++)
-    {
-      for(IGeometry::MeshIndexType j = 0; j < 3; j++)
-      {
-        IGeometry::MeshIndexType in0 = 3 * i + j;
-        dlta = deltaArray[in0] / numConnections[i];
-
-        float ll = lambdas[i];
-        verts[3 * i + j] += ll * dlta;
-        deltaArray[in0] = 0.0; // reset for next iteration
-      }
-      numConnections[i] = 0; // reset for next iteration
-    }
+    smoothPass(1.0f);
 
     // Now optionally apply a negative lambda based on the mu Factor value.
     // This is from Taubin's paper on smoothing without shrinkage. This effectively
     // runs a low pass filter on the data
     if(m_InputValues->pUseTaubinSmoothing)
     {
-
       if(m_ShouldCancel)
       {
         return {};
       }
-      m_MessageHandler(IFilter::Message::Type::Info, fmt::format("Iteration {} of {}", q, m_InputValues->pIterationSteps));
-      // Compute the Delta's
-      for(IGeometry::MeshIndexType i = 0; i < nedges; i++)
-      {
-        IGeometry::MeshIndexType in1 = uedges[2 * i];     // row of the first vertex
-        IGeometry::MeshIndexType in2 = uedges[2 * i + 1]; // row the second vertex
-
-        for(int32_t j = 0; j < 3; j++)
-        {
-#if 0
-          Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-          Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-#endif
-          dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-          deltaArray[3 * in1 + j] += dlta;
-          deltaArray[3 * in2 + j] += -1.0 * dlta;
-        }
-        numConnections[in1] += 1;
-        numConnections[in2] += 1;
-      }
-
-      // MOve the points
-      for(IGeometry::MeshIndexType i = 0; i < nvert; i++)
-      {
-        for(IGeometry::MeshIndexType j = 0; j < 3; j++)
-        {
-          IGeometry::MeshIndexType in0 = 3 * i + j;
-          dlta = deltaArray[in0] / numConnections[i];
-
-          float ll = lambdas[i] * m_InputValues->pMuFactor;
-          verts[3 * i + j] += ll * dlta;
-          deltaArray[in0] = 0.0; // reset for next iteration
-        }
-        numConnections[i] = 0; // reset for next iteration
-      }
+      smoothPass(m_InputValues->pMuFactor);
     }
   }
 
+  verts.getDataStoreRef().copyFromBuffer(0, nonstd::span<const float32>(positions));
+
   return {};
 }
 
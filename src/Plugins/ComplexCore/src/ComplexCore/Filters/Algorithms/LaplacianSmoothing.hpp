@@ -27,9 +27,10 @@ struct COMPLEXCORE_EXPORT LaplacianSmoothingInputValues
 };
 
 /**
- * @class ConditionalSetValue
- * @brief This filter replaces values in the target array with a user specified value
- * where a bool mask array specifies.
+ * @class LaplacianSmoothing
+ * @brief This algorithm moves the vertices of a triangle geometry towards the average of
+ * their neighbors, optionally followed by a Taubin shrink compensation pass. Each pass is a
+ * parallel gather over a vertex adjacency that is built once from the shared edge list.
  */
 
 class COMPLEXCORE_EXPORT LaplacianSmoothing
@@ -5,12 +5,16 @@
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 #include "TupleTransfer.hpp"
 
+#include <algorithm>
 #include <array>
+#include <limits>
 #include <random>
 #include <unordered_map>
+#include <utility>
 
 using namespace complex;
 
@@ -55,6 +59,222 @@ struct EdgeHasher
 using VertexMap = std::unordered_map<Vertex, IGeometry::MeshIndexType, VertexHasher>;
 using EdgeMap = std::unordered_map<Edge, IGeometry::MeshIndexType, EdgeHasher>;
 
+// -----------------------------------------------------------------------------
+using MeshIndexType = QuickSurfaceMesh::MeshIndexType;
+using CornerTable = std::array<std::array<usize, 3>, 4>;
+using QuadWinding = std::array<std::array<usize, 3>, 2>;
+
+constexpr MeshIndexType k_UnassignedNode = std::numeric_limits<MeshIndexType>::max();
+
+// Corners of each voxel face, relative to the voxel, in the order their nodes are numbered
+constexpr CornerTable k_MinXCorners = {{{0, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 1, 1}}};
+constexpr CornerTable k_MinYCorners = {{{0, 0, 0}, {1, 0, 0}, {0, 0, 1}, {1, 0, 1}}};
+constexpr CornerTable k_MinZCorners = {{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}}};
+constexpr CornerTable k_MaxXCorners = {{{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}}};
+constexpr CornerTable k_MaxYCorners = {{{1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1}}};
+constexpr CornerTable k_MaxZCorners = {{{1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}};
+
+// The two triangles of a face as indices into its corners
+constexpr QuadWinding k_QuadWinding = {{{0, 1, 2}, {1, 3, 2}}};
+constexpr QuadWinding k_ReversedQuadWinding = {{{0, 2, 1}, {1, 2, 3}}};
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief One voxel face of the surface that is split into two triangles.
+ */
+struct SurfaceQuad
+{
+  std::array<usize, 3> voxel = {};
+  const CornerTable* corners = nullptr;
+  bool reverseWinding = false;
+  std::array<int32, 2> labels = {};
+  usize firstCell = 0;
+  usize secondCell = 0;
+};
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Calls quadFunc for every surface face of the voxels in layer k. The faces are
+ * visited in the same order, with the same winding and labels, as the original single
+ * pass over the volume.
+ * @param featureIds
+ * @param dims
+ * @param k
+ * @param quadFunc
+ */
+template <typename QuadFunc>
+void VisitLayerQuads(const ConstDataView<int32>& featureIds, const SizeVec3& dims, usize k, QuadFunc&& quadFunc)
+{
+  const usize xP = dims[0];
+  const usize yP = dims[1];
+  const usize zP = dims[2];
+
+  SurfaceQuad quad;
+  auto boundaryQuad = [&](usize point, int32 featureId, const CornerTable& corners, bool reverseWinding) {
+    quad.corners = &corners;
+    quad.reverseWinding = reverseWinding;
+    quad.labels = {-1, featureId};
+    quad.firstCell = point;
+    quad.secondCell = point;
+    quadFunc(quad);
+  };
+  auto internalQuad = [&](usize point, int32 featureId, usize neighbor, const CornerTable& corners, bool reverseWinding) {
+    const int32 neighborFeatureId = featureIds[neighbor];
+    if(featureId == neighborFeatureId)
+    {
+      return;
+    }
+    // The smaller feature id always comes first in the face labels and the winding flips with it
+    const bool pointIsSmaller = featureId < neighborFeatureId;
+    quad.corners = &corners;
+    quad.reverseWinding = (reverseWinding != pointIsSmaller);
+    quad.labels = pointIsSmaller ? std::array<int32, 2>{featureId, neighborFeatureId} : std::array<int32, 2>{neighborFeatureId, featureId};
+    quad.firstCell = neighbor;
+    quad.secondCell = point;
+    quadFunc(quad);
+  };
+
+  for(usize j = 0; j < yP; j++)
+  {
+    for(usize i = 0; i < xP; i++)
+    {
+      const usize point = (k * xP * yP) + (j * xP) + i;
+      const int32 featureId = featureIds[point];
+      quad.voxel = {i, j, k};
+
+      if(i == 0)
+      {
+        boundaryQuad(point, featureId, k_MinXCorners, true);
+      }
+      if(j == 0)
+      {
+        boundaryQuad(point, featureId, k_MinYCorners, false);
+      }
+      if(k == 0)
+      {
+        boundaryQuad(point, featureId, k_MinZCorners, true);
+      }
+      if(i == (xP - 1))
+      {
+        boundaryQuad(point, featureId, k_MaxXCorners, false);
+      }
+      else
+      {
+        internalQuad(point, featureId, point + 1, k_MaxXCorners, false);
+      }
+      if(j == (yP - 1))
+      {
+        boundaryQuad(point, featureId, k_MaxYCorners, false);
+      }
+      else
+      {
+        internalQuad(point, featureId, point + xP, k_MaxYCorners, true);
+      }
+      if(k == (zP - 1))
+      {
+        boundaryQuad(point, featureId, k_MaxZCorners, true);
+      }
+      else
+      {
+        internalQuad(point, featureId, point + (xP * yP), k_MaxZCorners, false);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Numbers the nodes of one slab in the order they are first reached. Only the
+ * two node planes bounding the current voxel layer are held in memory.
+ */
+class SlabNodeNumbering
+{
+public:
+  using PlaneNodes = std::vector<std::pair<MeshIndexType, MeshIndexType>>;
+
+  SlabNodeNumbering(usize xP, usize yP, usize firstLayer)
+  : m_PlaneWidth(xP + 1)
+  , m_BottomPlane((xP + 1) * (yP + 1), k_UnassignedNode)
+  , m_TopPlane((xP + 1) * (yP + 1), k_UnassignedNode)
+  , m_Layer(firstLayer)
+  {
+  }
+
+  /**
+   * @brief Returns the slab local id of a node on either plane of the current layer.
+   * @param x
+   * @param y
+   * @param z
+   * @param isNewNode Set to true if the node was not reached before
+   * @return MeshIndexType
+   */
+  MeshIndexType nodeId(usize x, usize y, usize z, bool& isNewNode)
+  {
+    std::vector<MeshIndexType>& plane = (z == m_Layer) ? m_BottomPlane : m_TopPlane;
+    MeshIndexType& localNodeId = plane[y * m_PlaneWidth + x];
+    isNewNode = (localNodeId == k_UnassignedNode);
+    if(isNewNode)
+    {
+      localNodeId = m_NodeCount;
+      m_NodeCount++;
+    }
+    return localNodeId;
+  }
+
+  /**
+   * @brief Moves on to the next voxel layer. The top plane becomes the bottom plane.
+   */
+  void nextLayer()
+  {
+    std::swap(m_BottomPlane, m_TopPlane);
+    std::fill(m_TopPlane.begin(), m_TopPlane.end(), k_UnassignedNode);
+    m_Layer++;
+  }
+
+  MeshIndexType nodeCount() const
+  {
+    return m_NodeCount;
+  }
+
+  /**
+   * @brief Returns the (in plane index, local id) pairs of the nodes on the bottom plane sorted by in plane index.
+   * @return PlaneNodes
+   */
+  PlaneNodes bottomPlaneNodes() const
+  {
+    return CollectPlaneNodes(m_BottomPlane);
+  }
+
+  /**
+   * @brief Returns the (in plane index, local id) pairs of the nodes on the top plane sorted by in plane index.
+   * @return PlaneNodes
+   */
+  PlaneNodes topPlaneNodes() const
+  {
+    return CollectPlaneNodes(m_TopPlane);
+  }
+
+private:
+  static PlaneNodes CollectPlaneNodes(const std::vector<MeshIndexType>& plane)
+  {
+    PlaneNodes planeNodes;
+    for(usize index = 0; index < plane.size(); index++)
+    {
+      if(plane[index] != k_UnassignedNode)
+      {
+        planeNodes.emplace_back(index, plane[index]);
+      }
+    }
+    return planeNodes;
+  }
+
+  usize m_PlaneWidth = 0;
+  std::vector<MeshIndexType> m_BottomPlane;
+  std::vector<MeshIndexType> m_TopPlane;
+  usize m_Layer = 0;
+  MeshIndexType m_NodeCount = 0;
+};
+
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -72,22 +292,10 @@ QuickSurfaceMesh::~QuickSurfaceMesh() noexcept = default;
 // -----------------------------------------------------------------------------
 Result<> QuickSurfaceMesh::operator()()
 {
-  // Get the ImageGeometry
-  auto& grid = m_DataStructure.getDataRefAs<IGridGeometry>(m_Inputs->pGridGeomDataPath);
-
   // Get the Created Triangle Geometry
   TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_Inputs->pTriangleGeometryPath);
 
-  SizeVec3 udims = grid.getDimensions();
-
-  size_t xP = udims[0];
-  size_t yP = udims[1];
-  size_t zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  size_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
-  std::vector<MeshIndexType> nodeIds(possibleNumNodes, std::numeric_limits<size_t>::max());
+  std::vector<MeshSlab> slabs;
 
   MeshIndexType nodeCount = 0;
   MeshIndexType triangleCount = 0;
@@ -97,7 +305,11 @@ Result<> QuickSurfaceMesh::operator()()
     correctProblemVoxels();
   }
 
-  determineActiveNodes(nodeIds, nodeCount, triangleCount);
+  determineActiveNodes(slabs, nodeCount, triangleCount);
+  if(m_ShouldCancel)
+  {
+    return {};
+  }
 
   // now create node and triangle arrays knowing the number that will be needed
   std::vector<usize> tupleShape = {triangleCount};
@@ -112,7 +324,7 @@ Result<> QuickSurfaceMesh::operator()()
     Result<> result = complex::ResizeAndReplaceDataArray(m_DataStructure, dataPath, tupleShape, complex::IDataAction::Mode::Execute);
   }
 
-  createNodesAndTriangles(nodeIds, nodeCount, triangleCount);
+  createNodesAndTriangles(slabs, nodeCount, triangleCount);
 
 #if 0
   if(m_Inputs->pGenerateTripleLines)
@@ -466,342 +678,172 @@ void QuickSurfaceMesh::correctProblemVoxels()
 }
 
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount)
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::NodeOwners::insert(int32 featureId)
 {
-  m_MessageHandler(IFilter::Message::Type::Info, "Determining active Nodes");
+  if(featureId == -1)
+  {
+    onBoundary = true;
+  }
+  for(uint8 i = 0; i < count; i++)
+  {
+    if(featureIds[i] == featureId)
+    {
+      return;
+    }
+  }
+  if(count < featureIds.size())
+  {
+    featureIds[count] = featureId;
+    count++;
+  }
+}
 
-  auto* grid = m_DataStructure.getDataAs<IGridGeometry>(m_Inputs->pGridGeomDataPath);
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::NodeOwners::merge(const NodeOwners& other)
+{
+  for(uint8 i = 0; i < other.count; i++)
+  {
+    insert(other.featureIds[i]);
+  }
+  onBoundary = onBoundary || other.onBoundary;
+}
 
-  Int32Array& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
+// -----------------------------------------------------------------------------
+int8 QuickSurfaceMesh::NodeOwners::nodeType() const
+{
+  return static_cast<int8>(onBoundary ? count + 10 : count);
+}
 
-  SizeVec3 udims = grid->getDimensions();
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshSlab>& slabs, MeshIndexType& nodeCount, MeshIndexType& triangleCount)
+{
+  m_MessageHandler(IFilter::Message::Type::Info, "Determining active Nodes");
 
-  MeshIndexType xP = udims[0];
-  MeshIndexType yP = udims[1];
-  MeshIndexType zP = udims[2];
+  // A few slabs per thread keeps the threads busy when the surface is not spread evenly through the volume
+  constexpr usize k_SlabsPerThread = 4;
 
-  std::vector<std::set<int32_t>> ownerLists;
+  auto* grid = m_DataStructure.getDataAs<IGridGeometry>(m_Inputs->pGridGeomDataPath);
 
-  MeshIndexType point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
+  const ConstDataView<int32> featureIds(std::as_const(m_DataStructure).getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath).getDataStoreRef());
 
-  MeshIndexType nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
+  SizeVec3 udims = grid->getDimensions();
+  const usize zP = udims[2];
 
-  // first determining which nodes are actually boundary nodes and
-  // count number of nodes and triangles that will be created
-  for(MeshIndexType k = 0; k < zP; k++)
+  const usize numThreads = static_cast<usize>(ParallelScheduler::GetCoreBudget());
+  const usize numSlabs = std::max<usize>(std::min(zP, numThreads * k_SlabsPerThread), 1);
+  slabs.clear();
+  slabs.resize(numSlabs);
+  for(usize slabIndex = 0; slabIndex < numSlabs; slabIndex++)
   {
-    for(MeshIndexType j = 0; j < yP; j++)
+    slabs[slabIndex].firstLayer = zP * slabIndex / numSlabs;
+    slabs[slabIndex].endLayer = zP * (slabIndex + 1) / numSlabs;
+  }
+
+  // Count the nodes and triangles of each slab independently
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numSlabs);
+  dataAlg.execute([&](const Range& range) {
+    // Each range reads through its own view
+    const ConstDataView<int32> rangeFeatureIds = featureIds;
+    for(usize slabIndex = range.min(); slabIndex < range.max(); slabIndex++)
     {
-      for(MeshIndexType i = 0; i < xP; i++)
+      MeshSlab& slab = slabs[slabIndex];
+      SlabNodeNumbering nodeNumbering(udims[0], udims[1], slab.firstLayer);
+      for(usize k = slab.firstLayer; k < slab.endLayer; k++)
       {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP - 1))
+        if(m_ShouldCancel)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          return;
         }
-        else if(featureIds[point] != featureIds[neigh1])
+        VisitLayerQuads(rangeFeatureIds, udims, k, [&](const SurfaceQuad& quad) {
+          for(const auto& corner : *quad.corners)
+          {
+            bool isNewNode = false;
+            const MeshIndexType localNodeId = nodeNumbering.nodeId(quad.voxel[0] + corner[0], quad.voxel[1] + corner[1], quad.voxel[2] + corner[2], isNewNode);
+            if(isNewNode)
+            {
+              slab.nodeOwners.emplace_back();
+            }
+            slab.nodeOwners[localNodeId].insert(quad.labels[0]);
+            slab.nodeOwners[localNodeId].insert(quad.labels[1]);
+          }
+          slab.triangleCount += 2;
+        });
+        if(k == slab.firstLayer)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          slab.bottomPlaneNodes = nodeNumbering.bottomPlaneNodes();
         }
-        if(j == (yP - 1))
+        if(k + 1 < slab.endLayer)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          nodeNumbering.nextLayer();
         }
-        else if(featureIds[point] != featureIds[neigh2])
+      }
+      slab.topPlaneNodes = nodeNumbering.topPlaneNodes();
+      slab.nodeCount = nodeNumbering.nodeCount();
+    }
+  });
+
+  if(m_ShouldCancel)
+  {
+    return;
+  }
+
+  // Stitch the slabs together. A node on the bottom plane of a slab that the slab below
+  // also reached keeps the id from below, every other node gets the next global id. This
+  // reproduces the numbering of a single scan through the whole volume.
+  nodeCount = 0;
+  triangleCount = 0;
+  for(usize slabIndex = 0; slabIndex < numSlabs; slabIndex++)
+  {
+    MeshSlab& slab = slabs[slabIndex];
+    slab.triangleOffset = triangleCount;
+    triangleCount += slab.triangleCount;
+    slab.nodeOffset = nodeCount;
+    slab.globalNodeIds.assign(slab.nodeCount, k_UnassignedNode);
+
+    if(slabIndex > 0)
+    {
+      MeshSlab& previousSlab = slabs[slabIndex - 1];
+      auto previousIter = previousSlab.topPlaneNodes.cbegin();
+      for(const auto& [planeIndex, localNodeId] : slab.bottomPlaneNodes)
+      {
+        while(previousIter != previousSlab.topPlaneNodes.cend() && previousIter->first < planeIndex)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          ++previousIter;
         }
-        if(k == (zP - 1))
+        if(previousIter != previousSlab.topPlaneNodes.cend() && previousIter->first == planeIndex)
         {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && featureIds[point] != featureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          slab.globalNodeIds[localNodeId] = previousSlab.globalNodeIds[previousIter->second];
+          previousSlab.nodeOwners[previousIter->second].merge(slab.nodeOwners[localNodeId]);
         }
       }
+      previousSlab.topPlaneNodes = {};
+      slab.bottomPlaneNodes = {};
+    }
+
+    for(auto& globalNodeId : slab.globalNodeIds)
+    {
+      if(globalNodeId == k_UnassignedNode)
+      {
+        globalNodeId = nodeCount;
+        nodeCount++;
+      }
     }
   }
 }
 
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount)
+void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshSlab>& slabs, MeshIndexType nodeCount, MeshIndexType triangleCount)
 {
   m_MessageHandler(IFilter::Message::Type::Info, "Creating mesh");
 
-  Int32Array& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
-
-  size_t numFeatures = 0;
-  size_t numTuples = featureIds.getNumberOfTuples();
-  for(size_t i = 0; i < numTuples; i++)
-  {
-    if(static_cast<size_t>(featureIds[i]) > numFeatures)
-    {
-      numFeatures = static_cast<size_t>(featureIds[i]);
-    }
-  }
+  const ConstDataView<int32> featureIds(std::as_const(m_DataStructure).getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath).getDataStoreRef());
 
   auto* grid = m_DataStructure.getDataAs<IGridGeometry>(m_Inputs->pGridGeomDataPath);
 
   SizeVec3 udims = grid->getDimensions();
 
-  MeshIndexType xP = udims[0];
-  MeshIndexType yP = udims[1];
-  MeshIndexType zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0;
-  MeshIndexType neigh1 = 0;
-  MeshIndexType neigh2 = 0;
-  MeshIndexType neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0;
-  MeshIndexType nodeId2 = 0;
-  MeshIndexType nodeId3 = 0;
-  MeshIndexType nodeId4 = 0;
-
   TriangleGeom* triangleGeom = m_DataStructure.getDataAs<TriangleGeom>(m_Inputs->pTriangleGeometryPath);
   LinkedGeometryData& linkedGeometryData = triangleGeom->getLinkedGeometryData();
 
@@ -814,19 +856,17 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
   // Remove and then insert a properly sized Int32Array for the FaceLabels
   m_DataStructure.removeData(m_Inputs->pFaceLabelsDataPath);
   Result<> faceLabelResult = complex::CreateArray<int32_t>(m_DataStructure, {triangleCount}, {2}, m_Inputs->pFaceLabelsDataPath, IDataAction::Mode::Execute);
-  Int32Array& faceLabels = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFaceLabelsDataPath);
+  auto& faceLabels = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFaceLabelsDataPath).getDataStoreRef();
   linkedGeometryData.addFaceData(m_Inputs->pFaceLabelsDataPath);
 
   // Remove and then insert a properly sized int8 for the NodeTypes
   m_DataStructure.removeData(m_Inputs->pNodeTypesDataPath);
   Result<> nodeTypeResult = complex::CreateArray<int8_t>(m_DataStructure, {nodeCount}, {1}, m_Inputs->pNodeTypesDataPath, IDataAction::Mode::Execute);
-  Int32Array& nodeTypes = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFaceLabelsDataPath);
+  auto& nodeTypes = m_DataStructure.getDataRefAs<Int8Array>(m_Inputs->pNodeTypesDataPath).getDataStoreRef();
   linkedGeometryData.addVertexData(m_Inputs->pFaceLabelsDataPath);
 
   IGeometry::SharedVertexList& vertex = *(triangleGeom->getVertices());
-  IGeometry::SharedTriList& triangle = *(triangleGeom->getFaces());
-
-  ownerLists.resize(nodeCount);
+  auto& triangle = triangleGeom->getFaces()->getDataStoreRef();
 
   // Create a vector of TupleTransferFunctions for each of the Triangle Face to Vertex Data Arrays
   std::vector<std::shared_ptr<AbstractTupleTransfer>> tupleTransferFunctions;
@@ -837,522 +877,66 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
     ::AddTupleTransferInstance(m_DataStructure, m_Inputs->pSelectedDataArrayPaths[i], m_Inputs->pCreatedDataArrayPaths[i], tupleTransferFunctions);
   }
 
-  // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  MeshIndexType triangleIndex = 0;
-  for(MeshIndexType k = 0; k < zP; k++)
-  {
-    for(MeshIndexType j = 0; j < yP; j++)
+  // Cycle through each slab again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, slabs.size());
+  dataAlg.execute([&](const Range& range) {
+    // Each range reads through its own view
+    const ConstDataView<int32> rangeFeatureIds = featureIds;
+    for(usize slabIndex = range.min(); slabIndex < range.max(); slabIndex++)
     {
-      for(MeshIndexType i = 0; i < xP; i++)
+      const MeshSlab& slab = slabs[slabIndex];
+      SlabNodeNumbering nodeNumbering(udims[0], udims[1], slab.firstLayer);
+      MeshIndexType triangleIndex = slab.triangleOffset;
+      for(usize k = slab.firstLayer; k < slab.endLayer; k++)
       {
-
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1; // <== What happens if we are at the end of a row?
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(j == 0)
+        if(m_ShouldCancel)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+          return;
         }
-        if(i == (xP - 1)) // Takes care of the end of a Row...
+        VisitLayerQuads(rangeFeatureIds, udims, k, [&](const SurfaceQuad& quad) {
+          std::array<MeshIndexType, 4> nodeIds = {};
+          for(usize n = 0; n < 4; n++)
+          {
+            const std::array<usize, 3>& corner = (*quad.corners)[n];
+            const usize x = quad.voxel[0] + corner[0];
+            const usize y = quad.voxel[1] + corner[1];
+            const usize z = quad.voxel[2] + corner[2];
+            bool isNewNode = false;
+            const MeshIndexType localNodeId = nodeNumbering.nodeId(x, y, z, isNewNode);
+            nodeIds[n] = slab.globalNodeIds[localNodeId];
+            // Nodes shared with the slab below are written by that slab
+            if(isNewNode && nodeIds[n] >= slab.nodeOffset)
+            {
+              getGridCoordinates(grid, x, y, z, vertex, nodeIds[n] * 3);
+              nodeTypes[nodeIds[n]] = slab.nodeOwners[localNodeId].nodeType();
+            }
+          }
+
+          const auto& windings = quad.reverseWinding ? k_ReversedQuadWinding : k_QuadWinding;
+          for(const auto& winding : windings)
+          {
+            triangle[triangleIndex * 3 + 0] = nodeIds[winding[0]];
+            triangle[triangleIndex * 3 + 1] = nodeIds[winding[1]];
+            triangle[triangleIndex * 3 + 2] = nodeIds[winding[2]];
+            faceLabels[triangleIndex * 2] = quad.labels[0];
+            faceLabels[triangleIndex * 2 + 1] = quad.labels[1];
+
+            for(const auto& tupleTransferFunction : tupleTransferFunctions)
+            {
+              tupleTransferFunction->transfer(triangleIndex, quad.firstCell, quad.secondCell, true);
+            }
+
+            triangleIndex++;
+          }
+        });
+        if(k + 1 < slab.endLayer)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh1];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          if(featureIds[point] < featureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh1];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh1, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh1];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh1];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh1, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh1]);
-        }
-        if(j == (yP - 1)) // Takes care of the end of a column
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = featureIds[neigh2];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh2];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh2, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = featureIds[neigh2];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh2];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh2, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh2]);
-        }
-        if(k == (zP - 1)) // Takes care of the end of a Pillar
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh3];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh3];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh3, point, true);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh3];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh3];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_Inputs->pSelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh3, point, true);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh3]);
+          nodeNumbering.nextLayer();
         }
       }
     }
-  }
-
-  Int8Array& m_NodeTypes = m_DataStructure.getDataRefAs<Int8Array>(m_Inputs->pNodeTypesDataPath);
-
-  for(size_t i = 0; i < nodeCount; i++)
-  {
-    m_NodeTypes[i] = static_cast<int8_t>(ownerLists[i].size());
-    if(m_NodeTypes[i] > 4)
-    {
-      m_NodeTypes[i] = 4;
-    }
-    if(ownerLists[i].find(-1) != ownerLists[i].end())
-    {
-      m_NodeTypes[i] += 10;
-    }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -1374,10 +958,10 @@ void QuickSurfaceMesh::generateTripleLines()
   //  DataContainer* sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
   //
   //  AttributeMatrix* featAttrMat = sm->getAttributeMatrix(m_FeatureAttributeMatrixName);
-  Int32Array& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath);
+  const ConstDataView<int32> featureIds(std::as_const(m_DataStructure).getDataRefAs<Int32Array>(m_Inputs->pFeatureIdsArrayPath).getDataStoreRef());
 
   int32_t numFeatures = 0;
-  size_t numTuples = featureIds.getNumberOfTuples();
+  size_t numTuples = featureIds.size();
   for(size_t i = 0; i < numTuples; i++)
   {
     if(featureIds[i] > numFeatures)
@@ -8,7 +8,10 @@
 #include "complex/Filter/IFilter.hpp"
 #include "complex/Parameters/MultiArraySelectionParameter.hpp"
 
+#include <array>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace complex
 {
@@ -42,6 +45,54 @@ public:
 
   using MeshIndexType = IGeometry::MeshIndexType;
 
+  /**
+   * @brief Tracks the distinct features that share a node. Only the first four
+   * are kept because the node type saturates at four owners.
+   */
+  struct NodeOwners
+  {
+    std::array<int32, 4> featureIds = {};
+    uint8 count = 0;
+    bool onBoundary = false;
+
+    /**
+     * @brief Adds a feature to the set of owners. A value of -1 marks the outside of the volume.
+     * @param featureId
+     */
+    void insert(int32 featureId);
+
+    /**
+     * @brief Adds all of the owners of another node to this one.
+     * @param other
+     */
+    void merge(const NodeOwners& other);
+
+    /**
+     * @brief Returns the number of owners capped at four, plus ten for nodes on the volume boundary.
+     * @return int8
+     */
+    int8 nodeType() const;
+  };
+
+  /**
+   * @brief A range of z layers that is meshed independently. Nodes are numbered
+   * locally in the order the serial scan would first reach them; the nodes on the
+   * bottom plane that the slab below also touches are mapped onto that slab's ids.
+   */
+  struct MeshSlab
+  {
+    usize firstLayer = 0;
+    usize endLayer = 0;
+    MeshIndexType nodeCount = 0;
+    MeshIndexType triangleCount = 0;
+    MeshIndexType nodeOffset = 0;
+    MeshIndexType triangleOffset = 0;
+    std::vector<std::pair<MeshIndexType, MeshIndexType>> bottomPlaneNodes;
+    std::vector<std::pair<MeshIndexType, MeshIndexType>> topPlaneNodes;
+    std::vector<NodeOwners> nodeOwners;
+    std::vector<MeshIndexType> globalNodeIds;
+  };
+
   Result<> operator()();
 
   /**
@@ -90,20 +141,22 @@ public:
   void correctProblemVoxels();
 
   /**
-   * @brief
-   * @param m_NodeIds
-   * @param nodeCount
-   * @param triangleCount
+   * @brief Splits the volume into z slabs, counts the nodes and triangles of every
+   * slab in parallel and then stitches the nodes shared between neighboring slabs.
+   * @param slabs Filled with one entry per slab
+   * @param nodeCount Total number of unique nodes
+   * @param triangleCount Total number of triangles
    */
-  void determineActiveNodes(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
+  void determineActiveNodes(std::vector<MeshSlab>& slabs, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
 
   /**
-   * @brief
-   * @param m_NodeIds
+   * @brief Writes the vertices, triangles, face labels, node types and transferred
+   * cell data of every slab in parallel.
+   * @param slabs The slabs computed by determineActiveNodes()
    * @param nodeCount
    * @param triangleCount
    */
-  void createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount);
+  void createNodesAndTriangles(std::vector<MeshSlab>& slabs, MeshIndexType nodeCount, MeshIndexType triangleCount);
 
   /**
    * @brief generateTripleLines
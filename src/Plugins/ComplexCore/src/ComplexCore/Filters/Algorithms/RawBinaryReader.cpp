@@ -37,13 +37,29 @@
 #include "RawBinaryReader.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
 
 #include "complex/Common/Bit.hpp"
 #include "complex/Common/ComplexConstants.hpp"
+#include "complex/Common/Range.hpp"
+#include "complex/Common/ScopeGuard.hpp"
 #include "complex/Common/Types.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/Utilities/ParallelTaskAlgorithm.hpp"
+#include "complex/Utilities/Parsing/Text/MemoryMappedFile.hpp"
 
 namespace fs = std::filesystem;
 using namespace complex;
@@ -59,11 +75,16 @@ namespace
 constexpr int32 k_RbrFileNotOpen = -1000;
 constexpr int32 k_RbrFileTooSmall = -1010;
 constexpr int32 k_RbrFileTooBig = -1020;
+constexpr int32 k_RbrReadError = -1030;
+constexpr int32 k_RbrSeekError = -1040;
+
+// The file is read in blocks of this many bytes. The next block is read while the current one is decoded.
+constexpr usize k_BlockSize = 8 * 1024 * 1024;
 
 // -----------------------------------------------------------------------------
 int32 SanityCheckFileSizeVersusAllocatedSize(usize allocatedBytes, usize fileSize, usize skipHeaderBytes)
 {
-  if(fileSize - skipHeaderBytes < allocatedBytes)
+  if(skipHeaderBytes > fileSize || fileSize - skipHeaderBytes < allocatedBytes)
   {
     return -1;
   }
@@ -76,67 +97,278 @@ int32 SanityCheckFileSizeVersusAllocatedSize(usize allocatedBytes, usize fileSiz
 }
 
 // -----------------------------------------------------------------------------
-template <typename T>
-Result<> ReadBinaryFile(IDataArray& dataArrayPtr, const std::string& filename, uint64 skipHeaderBytes, ChoicesParameter::ValueType endian)
+FILE* OpenSequentialFile(const fs::path& filePath)
 {
-  constexpr usize k_DefaultBlocksize = 1048576;
-
-  DataArray<T>& dataArray = dynamic_cast<DataArray<T>&>(dataArrayPtr);
+#ifdef _WIN32
+  // 'S' asks the runtime to optimize caching for sequential access
+  FILE* file = std::fopen(filePath.string().c_str(), "rbS");
+#else
+  FILE* file = std::fopen(filePath.string().c_str(), "rb");
+#endif
+#if defined(__linux__)
+  if(file != nullptr)
+  {
+    // Lets the kernel read further ahead than it would for random access
+    posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+  }
+#endif
+  return file;
+}
 
-  const usize fileSize = fs::file_size(filename);
-  const usize numBytesToRead = dataArray.getSize() * sizeof(T);
-  int32 err = SanityCheckFileSizeVersusAllocatedSize(numBytesToRead, fileSize, skipHeaderBytes);
+// -----------------------------------------------------------------------------
+template <typename T, typename U>
+U ConvertValue(T value)
+{
+  if constexpr(std::is_floating_point_v<T> && std::is_integral_v<U>)
+  {
+    // Converting an out of range floating point value to an integer is undefined behavior
+    if(std::isnan(value))
+    {
+      return 0;
+    }
+    if(value <= static_cast<T>(std::numeric_limits<U>::lowest()))
+    {
+      return std::numeric_limits<U>::lowest();
+    }
+    if(value >= static_cast<T>(std::numeric_limits<U>::max()))
+    {
+      return std::numeric_limits<U>::max();
+    }
+  }
+  return static_cast<U>(value);
+}
 
-  if(err < 0)
+/**
+ * @brief Decodes count values of type T from the raw bytes of the file, swapping their bytes
+ * if needed, and stores them as type U. The source and destination may be the same memory
+ * when T and U are the same type.
+ */
+template <typename T, typename U>
+void DecodeValues(const std::byte* source, usize count, bool byteSwap, U* destination)
+{
+  if constexpr(std::is_same_v<T, U>)
   {
-    return MakeErrorResult(k_RbrFileTooSmall, "The file size is smaller than the allocated size");
+    if(!byteSwap)
+    {
+      if(static_cast<const void*>(source) != static_cast<const void*>(destination))
+      {
+        std::memcpy(destination, source, count * sizeof(T));
+      }
+      return;
+    }
   }
-  if(err > 0)
+
+  for(usize i = 0; i < count; i++)
   {
-    return MakeWarningVoidResult(k_RbrFileTooBig, "The file size is larger than the allocated size");
+    T value;
+    std::memcpy(&value, source + i * sizeof(T), sizeof(T));
+    if(byteSwap)
+    {
+      value = complex::byteswap(value);
+    }
+    destination[i] = ConvertValue<T, U>(value);
   }
+}
 
-  FILE* f = std::fopen(filename.c_str(), "rb");
-  if(f == nullptr)
+/**
+ * @brief Decodes one block of the file into the array in parallel.
+ * @param source The raw bytes of the block
+ * @param firstValue The index of the first value of the block in the array
+ * @param count The number of values in the block
+ * @param byteSwap
+ * @param store
+ */
+template <typename T, typename U>
+void DecodeBlock(const std::byte* source, usize firstValue, usize count, bool byteSwap, AbstractDataStore<U>& store)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, count);
+  dataAlg.setParallelizationEnabled(store.isContiguous());
+  dataAlg.execute([&](const Range& range) {
+    const std::byte* rangeSource = source + range.min() * sizeof(T);
+    if(store.isContiguous())
+    {
+      DecodeValues<T, U>(rangeSource, range.size(), byteSwap, store.contiguousSpan().data() + firstValue + range.min());
+      return;
+    }
+    std::vector<U> buffer(range.size());
+    DecodeValues<T, U>(rangeSource, range.size(), byteSwap, buffer.data());
+    store.copyFromBuffer(firstValue + range.min(), nonstd::span<const U>(buffer.data(), buffer.size()));
+  });
+}
+
+/**
+ * @brief Reads the file in blocks with two buffers. A task reads the next block while the
+ * current block is byte swapped and converted by the worker threads. Values that do not need
+ * to be converted are read straight into the array and swapped in place.
+ */
+template <typename T, typename U>
+Result<> ReadStreamedFile(const fs::path& filePath, uint64 skipHeaderBytes, bool byteSwap, AbstractDataStore<U>& store, const std::atomic_bool& shouldCancel)
+{
+  FILE* file = OpenSequentialFile(filePath);
+  if(file == nullptr)
   {
     return MakeErrorResult(k_RbrFileNotOpen, "Unable to open the specified file");
   }
+  auto fileGuard = MakeScopeGuard([file]() noexcept { std::fclose(file); });
 
   // Skip some header bytes if the user asked for it.
-  if(skipHeaderBytes > 0)
+  if(skipHeaderBytes > 0 && FSEEK64(file, skipHeaderBytes, SEEK_SET) != 0)
   {
-    FSEEK64(f, skipHeaderBytes, SEEK_SET);
+    return MakeErrorResult(k_RbrSeekError, fmt::format("Unable to skip {} header bytes in the specified file", skipHeaderBytes));
   }
 
-  std::byte* chunkptr = reinterpret_cast<std::byte*>(dataArray.template getIDataStoreAs<DataStore<T>>()->data());
-
-  // Now start reading the data in chunks if needed.
-  usize chunkSize = std::min(numBytesToRead, k_DefaultBlocksize);
+  const usize numValues = store.getSize();
+  const usize valuesPerBlock = k_BlockSize / sizeof(T);
+  const usize numBlocks = (numValues + valuesPerBlock - 1) / valuesPerBlock;
+  const bool readInPlace = std::is_same_v<T, U> && store.isContiguous();
 
-  usize master_counter = 0;
-  while(master_counter < numBytesToRead)
+  std::array<std::vector<std::byte>, 2> buffers;
+  if(!readInPlace)
   {
-    usize bytes_read = std::fread(chunkptr, sizeof(std::byte), chunkSize, f);
-    chunkptr += bytes_read;
-    master_counter += bytes_read;
-
-    usize bytesLeft = numBytesToRead - master_counter;
+    for(auto& buffer : buffers)
+    {
+      buffer.resize(std::min(numValues, valuesPerBlock) * sizeof(T));
+    }
+  }
 
-    if(bytesLeft < chunkSize)
+  auto blockSize = [&](usize block) { return std::min(valuesPerBlock, numValues - block * valuesPerBlock); };
+  auto blockBytes = [&](usize block) -> std::byte* {
+    if(readInPlace)
     {
-      chunkSize = bytesLeft;
+      return reinterpret_cast<std::byte*>(store.contiguousSpan().data() + block * valuesPerBlock);
     }
+    return buffers[block % 2].data();
+  };
+  auto readBlock = [&](usize block) { return std::fread(blockBytes(block), sizeof(T), blockSize(block), file) == blockSize(block); };
+
+  if(numBlocks > 0 && !readBlock(0))
+  {
+    return MakeErrorResult(k_RbrReadError, "Unable to read the first block of the specified file");
   }
 
-  if(endian != static_cast<ChoicesParameter::ValueType>(complex::endian::native))
+  ParallelTaskAlgorithm taskAlg;
+  for(usize block = 0; block < numBlocks; block++)
   {
-    dataArray.byteSwapElements();
+    if(shouldCancel)
+    {
+      return {};
+    }
+    bool nextBlockRead = true;
+    if(block + 1 < numBlocks)
+    {
+      taskAlg.execute([&, block]() { nextBlockRead = readBlock(block + 1); });
+    }
+    DecodeBlock<T, U>(blockBytes(block), block * valuesPerBlock, blockSize(block), byteSwap, store);
+    taskAlg.wait();
+    if(!nextBlockRead)
+    {
+      return MakeErrorResult(k_RbrReadError, fmt::format("Unable to read block {} of {} from the specified file", block + 2, numBlocks));
+    }
   }
 
-  std::fclose(f);
+  return {};
+}
 
+/**
+ * @brief Maps the file and decodes it in parallel. The operating system pages in the parts
+ * of the file that each thread touches.
+ */
+template <typename T, typename U>
+Result<> ReadMappedFile(const fs::path& filePath, uint64 skipHeaderBytes, bool byteSwap, AbstractDataStore<U>& store, const std::atomic_bool& shouldCancel)
+{
+  MemoryMappedFile file(filePath);
+  if(!file.isOpen())
+  {
+    return MakeErrorResult(k_RbrFileNotOpen, "Unable to open the specified file");
+  }
+
+  const auto* source = reinterpret_cast<const std::byte*>(file.view().data()) + skipHeaderBytes;
+  const usize numValues = store.getSize();
+  const usize valuesPerBlock = k_BlockSize / sizeof(T);
+  for(usize firstValue = 0; firstValue < numValues; firstValue += valuesPerBlock)
+  {
+    if(shouldCancel)
+    {
+      return {};
+    }
+    DecodeBlock<T, U>(source + firstValue * sizeof(T), firstValue, std::min(valuesPerBlock, numValues - firstValue), byteSwap, store);
+  }
   return {};
 }
+
+// -----------------------------------------------------------------------------
+template <typename T, typename U>
+Result<> ReadBinaryFile(AbstractDataStore<U>& store, const RawBinaryReaderInputValues& inputValues, const std::atomic_bool& shouldCancel)
+{
+  const fs::path& filePath = inputValues.inputFileValue;
+  const usize fileSize = fs::file_size(filePath);
+  const usize numBytesToRead = store.getSize() * sizeof(T);
+  int32 err = SanityCheckFileSizeVersusAllocatedSize(numBytesToRead, fileSize, inputValues.skipHeaderBytesValue);
+
+  if(err < 0)
+  {
+    return MakeErrorResult(k_RbrFileTooSmall, "The file size is smaller than the allocated size");
+  }
+  Result<> result;
+  if(err > 0)
+  {
+    result = MakeWarningVoidResult(k_RbrFileTooBig, "The file size is larger than the allocated size");
+  }
+
+  const bool byteSwap = inputValues.endianValue != static_cast<ChoicesParameter::ValueType>(complex::endian::native);
+  Result<> readResult = (inputValues.readModeValue == k_MemoryMappedReadMode) ? ReadMappedFile<T, U>(filePath, inputValues.skipHeaderBytesValue, byteSwap, store, shouldCancel)
+                                                                               : ReadStreamedFile<T, U>(filePath, inputValues.skipHeaderBytesValue, byteSwap, store, shouldCancel);
+  if(readResult.invalid())
+  {
+    return readResult;
+  }
+  return result;
+}
+
+/**
+ * @brief Selects the type of the values in the file for the type U of the created array.
+ */
+struct ReadBinaryFileFunctor
+{
+  template <typename U>
+  Result<> operator()(IDataArray& dataArray, const RawBinaryReaderInputValues& inputValues, const std::atomic_bool& shouldCancel)
+  {
+    if constexpr(std::is_same_v<U, bool>)
+    {
+      return MakeErrorResult(complex::k_UnsupportedScalarType, "The chosen scalar type is not supported by this filter.");
+    }
+    else
+    {
+      AbstractDataStore<U>& store = dynamic_cast<DataArray<U>&>(dataArray).getDataStoreRef();
+      switch(inputValues.scalarTypeValue)
+      {
+      case NumericType::int8:
+        return ReadBinaryFile<int8, U>(store, inputValues, shouldCancel);
+      case NumericType::uint8:
+        return ReadBinaryFile<uint8, U>(store, inputValues, shouldCancel);
+      case NumericType::int16:
+        return ReadBinaryFile<int16, U>(store, inputValues, shouldCancel);
+      case NumericType::uint16:
+        return ReadBinaryFile<uint16, U>(store, inputValues, shouldCancel);
+      case NumericType::int32:
+        return ReadBinaryFile<int32, U>(store, inputValues, shouldCancel);
+      case NumericType::uint32:
+        return ReadBinaryFile<uint32, U>(store, inputValues, shouldCancel);
+      case NumericType::int64:
+        return ReadBinaryFile<int64, U>(store, inputValues, shouldCancel);
+      case NumericType::uint64:
+        return ReadBinaryFile<uint64, U>(store, inputValues, shouldCancel);
+      case NumericType::float32:
+        return ReadBinaryFile<float32, U>(store, inputValues, shouldCancel);
+      case NumericType::float64:
+        return ReadBinaryFile<float64, U>(store, inputValues, shouldCancel);
+      default:
+        return MakeErrorResult(complex::k_UnsupportedScalarType, "The chosen scalar type is not supported by this filter.");
+      }
+    }
+  }
+};
 } // namespace
 
 namespace complex
@@ -167,32 +399,7 @@ Result<> RawBinaryReader::execute()
     throw std::runtime_error(fmt::format("Failed to acquire DataArray from path '{}' with the correct number of components.", m_InputValues.createdAttributeArrayPathValue.toString()));
   }
 
-  const std::string inputFile = m_InputValues.inputFileValue.string();
-
-  switch(m_InputValues.scalarTypeValue)
-  {
-  case NumericType::int8:
-    return ReadBinaryFile<int8>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::uint8:
-    return ReadBinaryFile<uint8>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::int16:
-    return ReadBinaryFile<int16>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::uint16:
-    return ReadBinaryFile<uint16>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::int32:
-    return ReadBinaryFile<int32>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::uint32:
-    return ReadBinaryFile<uint32>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::int64:
-    return ReadBinaryFile<int64>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::uint64:
-    return ReadBinaryFile<uint64>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::float32:
-    return ReadBinaryFile<float32>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  case NumericType::float64:
-    return ReadBinaryFile<float64>(binaryIDataArray, inputFile, m_InputValues.skipHeaderBytesValue, m_InputValues.endianValue);
-  default:
-    return MakeErrorResult(complex::k_UnsupportedScalarType, "The chosen scalar type is not supported by this filter.");
-  }
+  // The created array has the output type, which is the type of the file unless a conversion was requested
+  return ExecuteDataFunction(ReadBinaryFileFunctor{}, binaryIDataArray.getDataType(), binaryIDataArray, m_InputValues, m_ShouldCancel);
 }
 } // namespace complex
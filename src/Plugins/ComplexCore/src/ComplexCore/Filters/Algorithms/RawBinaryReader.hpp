@@ -9,6 +9,9 @@ namespace complex
 {
 inline constexpr int32 k_UnsupportedScalarType = -1070;
 
+inline constexpr ChoicesParameter::ValueType k_StreamedReadMode = 0;
+inline constexpr ChoicesParameter::ValueType k_MemoryMappedReadMode = 1;
+
 struct COMPLEXCORE_EXPORT RawBinaryReaderInputValues
 {
   FileSystemPathParameter::ValueType inputFileValue;
@@ -16,6 +19,7 @@ struct COMPLEXCORE_EXPORT RawBinaryReaderInputValues
   uint64 numberOfComponentsValue;
   ChoicesParameter::ValueType endianValue;
   uint64 skipHeaderBytesValue;
+  ChoicesParameter::ValueType readModeValue = k_StreamedReadMode;
   DataPath createdAttributeArrayPathValue;
 };
 
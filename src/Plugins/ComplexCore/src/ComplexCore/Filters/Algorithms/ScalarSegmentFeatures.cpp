@@ -5,17 +5,14 @@
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 
 #include <chrono>
+#include <type_traits>
+#include <utility>
 
 using namespace complex;
 
-#define CX_DEFAULT_CONSTRUCTORS(className)                                                                                                                                                             \
-  className(const className&) = delete;                                                                                                                                                                \
-  className(className&&) noexcept = delete;                                                                                                                                                            \
-  className& operator=(const className&) = delete;                                                                                                                                                     \
-  className& operator=(className&&) noexcept = delete;
-
 namespace
 {
 
@@ -32,39 +29,29 @@ class TSpecificCompareFunctorBool : public SegmentFeatures::CompareFunctor
 {
 public:
   using DataArrayType = BoolArray;
-  CX_DEFAULT_CONSTRUCTORS(TSpecificCompareFunctorBool)
+  // Copies read through their own view of the data
+  TSpecificCompareFunctorBool(const TSpecificCompareFunctorBool&) = default;
+  TSpecificCompareFunctorBool& operator=(const TSpecificCompareFunctorBool&) = delete;
 
-  TSpecificCompareFunctorBool(IDataArray* data, int64 length, bool tolerance, AbstractDataStore<int32>* featureIds)
-  : m_Length(length)
-  , m_FeatureIdsArray(featureIds)
-  , m_Data(dynamic_cast<DataArrayType*>(data))
+  TSpecificCompareFunctorBool(IDataArray* data)
+  : m_Data(dynamic_cast<const DataArrayType&>(*data).getDataStoreRef())
   {
   }
   ~TSpecificCompareFunctorBool() override = default;
 
-  bool operator()(int64 referencePoint, int64 neighborPoint, int32 gnum) override
+  /**
+   * @brief Returns true if both points hold the same value.
+   * @param referencePoint
+   * @param neighborPoint
+   * @return bool
+   */
+  bool isSimilar(int64 referencePoint, int64 neighborPoint) const
   {
-    // Sanity check the indices that are being passed in.
-    if(referencePoint >= m_Length || neighborPoint >= m_Length)
-    {
-      return false;
-    }
-
-    if((*m_Data)[neighborPoint] == (*m_Data)[referencePoint])
-    {
-      m_FeatureIdsArray->setValue(neighborPoint, gnum);
-      return true;
-    }
-    return false;
+    return m_Data[neighborPoint] == m_Data[referencePoint];
   }
 
-protected:
-  TSpecificCompareFunctorBool() = default;
-
 private:
-  int64 m_Length = 0;                                    // Length of the Data Array
-  AbstractDataStore<int32>* m_FeatureIdsArray = nullptr; // The Feature Ids
-  DataArrayType* m_Data = nullptr;                       // The data that is being compared
+  ConstDataView<bool> m_Data; // The data that is being compared
 };
 
 /**
@@ -74,53 +61,56 @@ template <class T>
 class TSpecificCompareFunctor : public SegmentFeatures::CompareFunctor
 {
 public:
-  CX_DEFAULT_CONSTRUCTORS(TSpecificCompareFunctor<T>)
+  // Copies read through their own view of the data
+  TSpecificCompareFunctor(const TSpecificCompareFunctor&) = default;
+  TSpecificCompareFunctor& operator=(const TSpecificCompareFunctor&) = delete;
 
   using DataArrayType = DataArray<T>;
-  TSpecificCompareFunctor(IDataArray* data, int64 length, T tolerance, AbstractDataStore<int32>* featureIds)
-  : m_Length(length)
-  , m_Tolerance(tolerance)
-  , m_FeatureIdsArray(featureIds)
-  , m_Data(dynamic_cast<DataArrayType*>(data))
+  TSpecificCompareFunctor(IDataArray* data, T tolerance)
+  : m_Tolerance(tolerance)
+  , m_Data(dynamic_cast<const DataArrayType&>(*data).getDataStoreRef())
   {
   }
   ~TSpecificCompareFunctor() override = default;
 
-  bool operator()(int64 referencePoint, int64 neighborPoint, int32 gnum) override
+  /**
+   * @brief Returns true if the values of the points differ by no more than the
+   * tolerance.
+   * @param referencePoint
+   * @param neighborPoint
+   * @return bool
+   */
+  bool isSimilar(int64 referencePoint, int64 neighborPoint) const
   {
-    // Sanity check the indices that are being passed in.
-    if(referencePoint >= m_Length || neighborPoint >= m_Length)
+    if(m_Data[referencePoint] >= m_Data[neighborPoint])
     {
-      return false;
+      return (m_Data[referencePoint] - m_Data[neighborPoint]) <= m_Tolerance;
     }
+    return (m_Data[neighborPoint] - m_Data[referencePoint]) <= m_Tolerance;
+  }
+
+private:
+  T m_Tolerance = static_cast<T>(0); // The tolerance of the comparison
+  ConstDataView<T> m_Data;           // The data that is being compared
+};
 
-    if((*m_Data)[referencePoint] >= (*m_Data)[neighborPoint])
+/**
+ * @brief Creates the compare functor for the type of the input array and hands it to labelFunc.
+ */
+struct LabelWithCompareFunctor
+{
+  template <typename T, class LabelFuncT>
+  Result<usize> operator()(LabelFuncT&& labelFunc, IDataArray* data, int tolerance)
+  {
+    if constexpr(std::is_same_v<T, bool>)
     {
-      if(((*m_Data)[referencePoint] - (*m_Data)[neighborPoint]) <= m_Tolerance)
-      {
-        m_FeatureIdsArray->setValue(neighborPoint, gnum);
-        return true;
-      }
+      return labelFunc(TSpecificCompareFunctorBool(data));
     }
     else
     {
-      if(((*m_Data)[neighborPoint] - (*m_Data)[referencePoint]) <= m_Tolerance)
-      {
-        m_FeatureIdsArray->setValue(neighborPoint, gnum);
-        return true;
-      }
+      return labelFunc(TSpecificCompareFunctor<T>(data, static_cast<T>(tolerance)));
     }
-    return false;
   }
-
-protected:
-  TSpecificCompareFunctor() = default;
-
-private:
-  int64 m_Length = 0;                                    // Length of the Data Array
-  T m_Tolerance = static_cast<T>(0);                     // The tolerance of the comparison
-  AbstractDataStore<int32>* m_FeatureIdsArray = nullptr; // The Feature Ids
-  DataArrayType* m_Data = nullptr;                       // The data that is being compared
 };
 } // namespace
 
@@ -133,79 +123,52 @@ ScalarSegmentFeatures::ScalarSegmentFeatures(DataStructure& dataStructure, Scala
 
 ScalarSegmentFeatures::~ScalarSegmentFeatures() noexcept = default;
 
+// -----------------------------------------------------------------------------
+template <class CompareFunctorT>
+Result<usize> ScalarSegmentFeatures::labelFeatures(const IGridGeometry& gridGeom, const CompareFunctorT& compare)
+{
+  auto isValid = [this](int64 point) { return !m_InputValues->pUseGoodVoxels || m_GoodVoxels.isTrue(static_cast<usize>(point)); };
+  // The functor is captured by value so that every range of slabs reads through its own view
+  auto isSimilar = [compare](int64 referencePoint, int64 neighborPoint) { return compare.isSimilar(referencePoint, neighborPoint); };
+  return executeParallel(gridGeom, m_FeatureIdsArray->getDataStoreRef(), isValid, isSimilar);
+}
+
 // -----------------------------------------------------------------------------
 Result<> ScalarSegmentFeatures::operator()()
 {
-  complex::AbstractDataStore<bool>* goodVoxels = nullptr;
   if(m_InputValues->pUseGoodVoxels)
   {
-    m_GoodVoxelsArray = m_DataStructure.getDataAs<GoodVoxelsArrayType>(m_InputValues->pGoodVoxelsPath);
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
+    // The packed copy of the mask is eight times smaller than the array, which keeps more of it cached
+    // while the slabs are labeled
+    m_GoodVoxels = MaskBitset::Create(m_DataStructure.getDataRefAs<GoodVoxelsArrayType>(m_InputValues->pGoodVoxelsPath));
   }
 
   auto* gridGeom = m_DataStructure.getDataAs<IGridGeometry>(m_InputValues->pGridGeomPath);
 
   m_FeatureIdsArray = m_DataStructure.getDataAs<Int32Array>(m_InputValues->pFeatureIdsPath);
-  m_FeatureIdsArray->fill(0); // initialize the output array with zeros
   IDataArray* inputDataArray = m_DataStructure.getDataAs<IDataArray>(m_InputValues->pInputDataPath);
-  size_t inDataPoints = inputDataArray->getNumberOfTuples();
   complex::DataType dataType = inputDataArray->getDataType();
-
-  auto featureIds = m_FeatureIdsArray->getDataStore();
-
-  switch(dataType)
+  if(inputDataArray->getNumberOfComponents() != 1)
   {
-  case complex::DataType::int8: {
-    m_CompareFunctor = std::make_shared<::TSpecificCompareFunctor<int8>>(inputDataArray, inDataPoints, static_cast<int8>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::uint8: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint8>>(inputDataArray, inDataPoints, static_cast<uint8>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::boolean: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctorBool>(inputDataArray, inDataPoints, static_cast<bool>(m_InputValues->pScalarTolerance), featureIds);
-    break;
+    return MakeErrorResult(k_IncorrectInputArray, "Input Array must be a scalar array");
   }
-  case complex::DataType::int16: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int16>>(inputDataArray, inDataPoints, static_cast<int16>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::uint16: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint16>>(inputDataArray, inDataPoints, static_cast<uint16>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::int32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int32>>(inputDataArray, inDataPoints, static_cast<int32>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::uint32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint32>>(inputDataArray, inDataPoints, static_cast<uint32>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::int64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<int64>>(inputDataArray, inDataPoints, static_cast<int64>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::uint64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<uint64>>(inputDataArray, inDataPoints, static_cast<uint64>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::float32: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<float32>>(inputDataArray, inDataPoints, static_cast<float32>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  case complex::DataType::float64: {
-    m_CompareFunctor = std::make_shared<TSpecificCompareFunctor<float64>>(inputDataArray, inDataPoints, static_cast<float64>(m_InputValues->pScalarTolerance), featureIds);
-    break;
-  }
-  default:
-    break;
+
+  auto labelFunc = [this, gridGeom](const auto& compare) { return labelFeatures(*gridGeom, compare); };
+  Result<usize> labelResult = ExecuteDataFunction(LabelWithCompareFunctor{}, dataType, labelFunc, inputDataArray, m_InputValues->pScalarTolerance);
+  if(labelResult.invalid())
+  {
+    return ConvertResult(std::move(labelResult));
   }
-  if(inputDataArray->getNumberOfComponents() != 1)
+  if(m_ShouldCancel)
   {
-    m_CompareFunctor = std::shared_ptr<SegmentFeatures::CompareFunctor>(new SegmentFeatures::CompareFunctor()); // The default CompareFunctor which ALWAYS returns false for the comparison
+    return {};
   }
+  const usize numFeatures = labelResult.value();
+  m_MessageHandler({IFilter::Message::Type::Info, fmt::format("Total Features Found: {}", numFeatures)});
+
+  // Feature 0 is reserved for voxels that do not belong to any feature
+  auto& cellFeaturesAM = m_DataStructure.getDataRefAs<AttributeMatrix>(m_InputValues->pCellFeaturesPath);
+  ResizeAttributeMatrix(cellFeaturesAM, {numFeatures + 1});
 
   // Generate the random voxel indices that will be used for the seed points to start a new grain growth/agglomeration
   auto totalPoints = inputDataArray->getNumberOfTuples();
@@ -215,12 +178,6 @@ Result<> ScalarSegmentFeatures::operator()()
   Int64Distribution distribution;
   initializeVoxelSeedGenerator(distribution, rangeMin, rangeMax);
 
-  //  // Add compare function to arguments
-  //  Arguments newArgs = args;
-  //  newArgs.insert(k_CompareFunctKey, compare.get());
-
-  execute(gridGeom);
-
   IDataArray* activeArray = m_DataStructure.getDataAs<IDataArray>(m_InputValues->pActiveArrayPath);
   auto totalFeatures = activeArray->getNumberOfTuples();
   if(totalFeatures < 2)
@@ -237,69 +194,3 @@ Result<> ScalarSegmentFeatures::operator()()
 
   return {};
 }
-
-// -----------------------------------------------------------------------------
-int64_t ScalarSegmentFeatures::getSeed(int32 gnum, int64 nextSeed) const
-{
-  complex::AbstractDataStore<bool>* goodVoxels = nullptr;
-  if(m_InputValues->pUseGoodVoxels)
-  {
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
-  }
-
-  complex::DataArray<int32>::store_type* featureIds = m_FeatureIdsArray->getDataStore();
-  usize totalPoints = featureIds->getNumberOfTuples();
-
-  int64 seed = -1;
-  // start with the next voxel after the last seed
-  usize randpoint = static_cast<usize>(nextSeed);
-  while(seed == -1 && randpoint < totalPoints)
-  {
-    if(featureIds->getValue(randpoint) == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
-    {
-      if(!m_InputValues->pUseGoodVoxels || goodVoxels->getValue(randpoint))
-      {
-        seed = randpoint;
-      }
-      else
-      {
-        randpoint += 1;
-      }
-    }
-    else
-    {
-      randpoint += 1;
-    }
-  }
-  if(seed >= 0)
-  {
-    UInt8Array& activeArray = m_DataStructure.getDataRefAs<UInt8Array>(m_InputValues->pActiveArrayPath);
-    featureIds->setValue(static_cast<usize>(seed), gnum);
-    std::vector<usize> tDims = {static_cast<usize>(gnum) + 1};
-    auto& cellFeaturesAM = m_DataStructure.getDataRefAs<AttributeMatrix>(m_InputValues->pCellFeaturesPath);
-    ResizeAttributeMatrix(cellFeaturesAM, tDims); // This will resize the active array
-  }
-  return seed;
-}
-
-// -----------------------------------------------------------------------------
-bool ScalarSegmentFeatures::determineGrouping(int64 referencepoint, int64 neighborpoint, int32 gnum) const
-{
-
-  auto featureIds = m_FeatureIdsArray->getDataStore();
-
-  const complex::AbstractDataStore<bool>* goodVoxels = nullptr;
-  if(m_InputValues->pUseGoodVoxels)
-  {
-    goodVoxels = m_GoodVoxelsArray->getDataStore();
-  }
-
-  if(featureIds->getValue(neighborpoint) == 0 && (!m_InputValues->pUseGoodVoxels || goodVoxels->getValue(neighborpoint)))
-  {
-    CompareFunctor* func = m_CompareFunctor.get();
-    return (*func)((usize)(referencepoint), (usize)(neighborpoint), gnum);
-    //     | Functor  ||calling the operator() method of the CompareFunctor Class |
-  }
-
-  return false;
-}
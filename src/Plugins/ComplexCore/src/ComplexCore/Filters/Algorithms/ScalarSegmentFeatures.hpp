@@ -7,8 +7,10 @@
 #include "complex/DataStructure/DataStructure.hpp"
 #include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Filter/IFilter.hpp"
+#include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/SegmentFeatures.hpp"
 
+#include <memory>
 #include <random>
 #include <vector>
 
@@ -49,32 +51,19 @@ public:
 
   Result<> operator()();
 
-protected:
-  /**
-   * @brief
-   * @param data
-   * @param args
-   * @param gnum
-   * @param nextSeed
-   * @return int64
-   */
-  int64_t getSeed(int32 gnum, int64 nextSeed) const override;
-
+private:
   /**
-   * @brief
-   * @param data
-   * @param args
-   * @param referencepoint
-   * @param neighborpoint
-   * @param gnum
-   * @return bool
+   * @brief Labels the features with SegmentFeatures::executeParallel(), grouping
+   * neighboring voxels for which compare.isSimilar() returns true.
+   * @param gridGeom
+   * @param compare
+   * @return Result<usize> The number of features found
    */
-  bool determineGrouping(int64 referencePoint, int64 neighborPoint, int32 gnum) const override;
+  template <class CompareFunctorT>
+  Result<usize> labelFeatures(const IGridGeometry& gridGeom, const CompareFunctorT& compare);
 
-private:
   const ScalarSegmentFeaturesInputValues* m_InputValues = nullptr;
   FeatureIdsArrayType* m_FeatureIdsArray = nullptr;
-  GoodVoxelsArrayType* m_GoodVoxelsArray = nullptr;
-  std::shared_ptr<SegmentFeatures::CompareFunctor> m_CompareFunctor;
+  MaskBitset m_GoodVoxels;
 };
 } // namespace complex
@@ -1,5 +1,6 @@
 #include "StlFileReader.hpp"
 
+#include "ComplexCore/utils/CSVDataParser.hpp"
 #include "ComplexCore/utils/StlUtilities.hpp"
 
 #include "complex/Common/Range.hpp"
@@ -8,90 +9,338 @@
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/Utilities/Parsing/Text/MemoryMappedFile.hpp"
 
-#include <cstdio>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
 #include <utility>
+#include <vector>
 
 using namespace complex;
 
 namespace
 {
+constexpr usize k_BinaryHeaderSize = StlConstants::k_STL_HEADER_LENGTH + sizeof(int32);
+// Normal and three vertices
+constexpr usize k_ValuesPerTriangle = 12;
+// The values of a triangle followed by the attribute byte count
+constexpr usize k_BinaryTriangleSize = k_ValuesPerTriangle * sizeof(float32) + sizeof(uint16);
+// Decoded triangles are copied into the geometry in blocks of this many triangles
+constexpr usize k_TrianglesPerBlock = 8192;
+constexpr usize k_ChunksPerThread = 4;
+// Each thread welds the vertices of this many hash buckets at a time
+constexpr usize k_BucketsPerThread = 16;
+constexpr usize k_MinAsciiChunkSize = 64 * 1024;
+
+using TriangleValues = std::array<float32, k_ValuesPerTriangle>;
+
+usize NumberOfThreads()
+{
+  return static_cast<usize>(ParallelScheduler::GetCoreBudget());
+}
 
 /**
- * @brief The FindUniqueIdsImpl class implements a threaded algorithm that determines the set of
- * unique vertices in the triangle geometry
+ * @brief Collects decoded triangles and copies their normals and vertices into the
+ * geometry one block at a time. Triangles must be added in increasing order; a gap
+ * starts a new block.
  */
-class FindUniqueIdsImpl
+class TriangleBlockWriter
 {
 public:
-  FindUniqueIdsImpl(IGeometry::SharedVertexList& vertex, const std::vector<std::vector<size_t>>& nodesInBin, complex::Int64DataStore& uniqueIds)
-  : m_Vertex(vertex)
-  , m_NodesInBin(nodesInBin)
-  , m_UniqueIds(uniqueIds)
+  TriangleBlockWriter(AbstractDataStore<float32>& vertices, AbstractDataStore<float64>& normals)
+  : m_VertexStore(vertices)
+  , m_NormalStore(normals)
+  , m_Vertices(k_TrianglesPerBlock * 9)
+  , m_Normals(k_TrianglesPerBlock * 3)
   {
   }
 
-  // -----------------------------------------------------------------------------
-  void convert(size_t start, size_t end) const
+  void add(usize triangle, const TriangleValues& values)
   {
-    for(size_t i = start; i < end; i++)
+    if(m_Count == k_TrianglesPerBlock || (m_Count > 0 && triangle != m_FirstTriangle + m_Count))
     {
-      for(size_t j = 0; j < m_NodesInBin[i].size(); j++)
-      {
-        size_t node1 = m_NodesInBin[i][j];
-        if(m_UniqueIds[node1] == static_cast<int64_t>(node1))
-        {
-          for(size_t k = j + 1; k < m_NodesInBin[i].size(); k++)
-          {
-            size_t node2 = m_NodesInBin[i][k];
-            if(m_Vertex[node1 * 3] == m_Vertex[node2 * 3] && m_Vertex[node1 * 3 + 1] == m_Vertex[node2 * 3 + 1] && m_Vertex[node1 * 3 + 2] == m_Vertex[node2 * 3 + 2])
-            {
-              m_UniqueIds[node2] = node1;
-            }
-          }
-        }
-      }
+      flush();
     }
+    if(m_Count == 0)
+    {
+      m_FirstTriangle = triangle;
+    }
+    for(usize i = 0; i < 3; i++)
+    {
+      m_Normals[m_Count * 3 + i] = static_cast<float64>(values[i]);
+    }
+    std::copy(values.begin() + 3, values.end(), m_Vertices.begin() + m_Count * 9);
+    m_Count++;
   }
 
-  // -----------------------------------------------------------------------------
-  void operator()(const Range& range) const
+  void flush()
   {
-    convert(range.min(), range.max());
+    if(m_Count == 0)
+    {
+      return;
+    }
+    m_VertexStore.copyFromBuffer(m_FirstTriangle * 9, nonstd::span<const float32>(m_Vertices.data(), m_Count * 9));
+    m_NormalStore.copyFromBuffer(m_FirstTriangle * 3, nonstd::span<const float64>(m_Normals.data(), m_Count * 3));
+    m_Count = 0;
   }
 
 private:
-  const IGeometry::SharedVertexList& m_Vertex;
-  const std::vector<std::vector<size_t>>& m_NodesInBin;
-  complex::Int64DataStore& m_UniqueIds;
+  AbstractDataStore<float32>& m_VertexStore;
+  AbstractDataStore<float64>& m_NormalStore;
+  std::vector<float32> m_Vertices;
+  std::vector<float64> m_Normals;
+  usize m_FirstTriangle = 0;
+  usize m_Count = 0;
 };
 
-class StlFileSentinel
+/**
+ * @brief Sizes the face list, the three unshared vertices per face and the face data for
+ * the given number of triangles.
+ * @param triangleGeom
+ * @param numTriangles
+ */
+void ResizeTriangleGeometry(TriangleGeom& triangleGeom, usize numTriangles)
+{
+  triangleGeom.resizeFaceList(numTriangles);
+  triangleGeom.resizeVertexList(numTriangles * 3);
+  ResizeAttributeMatrix(*triangleGeom.getFaceAttributeMatrix(), {numTriangles});
+}
+
+void DecodeTriangle(const char* record, TriangleValues& values, uint16& attributeByteCount)
 {
-public:
-  StlFileSentinel(FILE* file)
-  : m_File(file)
+  std::memcpy(values.data(), record, sizeof(TriangleValues));
+  std::memcpy(&attributeByteCount, record + sizeof(TriangleValues), sizeof(uint16));
+}
+
+bool IsSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+/**
+ * @brief Returns the next whitespace delimited token at or after pos and moves pos past it.
+ * The token is empty at the end of the text.
+ */
+std::string_view NextToken(std::string_view text, usize& pos)
+{
+  while(pos < text.size() && IsSpace(text[pos]))
   {
+    pos++;
   }
-  ~StlFileSentinel()
+  const usize start = pos;
+  while(pos < text.size() && !IsSpace(text[pos]))
   {
-    std::ignore = std::fclose(m_File);
+    pos++;
   }
-  StlFileSentinel(const StlFileSentinel&) = delete;            // Copy Constructor Not Implemented
-  StlFileSentinel(StlFileSentinel&&) = delete;                 // Move Constructor Not Implemented
-  StlFileSentinel& operator=(const StlFileSentinel&) = delete; // Copy Assignment Not Implemented
-  StlFileSentinel& operator=(StlFileSentinel&&) = delete;      // Move Assignment Not Implemented
+  return text.substr(start, pos - start);
+}
 
-private:
-  FILE* m_File = nullptr;
-};
+/**
+ * @brief Returns the position of the first 'facet' keyword that starts in [pos, end) or npos.
+ */
+usize FindFacet(std::string_view text, usize pos, usize end)
+{
+  while(true)
+  {
+    std::string_view token = NextToken(text, pos);
+    const usize tokenStart = pos - token.size();
+    if(token.empty() || tokenStart >= end)
+    {
+      return std::string_view::npos;
+    }
+    if(token == "facet")
+    {
+      return tokenStart;
+    }
+  }
+}
+
+/**
+ * @brief Moves a chunk boundary forward to the start of a token so a token belongs to the
+ * chunk it starts in.
+ */
+usize AlignToToken(std::string_view text, usize pos)
+{
+  while(pos > 0 && pos < text.size() && !IsSpace(text[pos - 1]))
+  {
+    pos++;
+  }
+  return pos;
+}
 
-std::array<float, 6> CreateMinMaxCoords()
+bool ParseValues(std::string_view text, usize& pos, float32* values)
 {
-  return {std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-          -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max()};
+  for(usize i = 0; i < 3; i++)
+  {
+    if(CSVParsing::ParseNumber(NextToken(text, pos), values[i]) != CSVParsing::ParseStatus::Success)
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
+/**
+ * @brief Parses 'facet normal nx ny nz outer loop vertex x y z (x3)' starting at the facet
+ * keyword. The 'endloop' and 'endfacet' keywords are skipped by the next FindFacet().
+ * @param text
+ * @param pos The position of the facet keyword. Moved past the last vertex.
+ * @param values
+ * @return bool False if the facet is malformed
+ */
+bool ParseFacet(std::string_view text, usize& pos, TriangleValues& values)
+{
+  NextToken(text, pos);
+  if(NextToken(text, pos) != "normal" || !ParseValues(text, pos, values.data()))
+  {
+    return false;
+  }
+  usize vertex = 0;
+  while(vertex < 3)
+  {
+    std::string_view token = NextToken(text, pos);
+    if(token == "vertex")
+    {
+      if(!ParseValues(text, pos, values.data() + 3 + vertex * 3))
+      {
+        return false;
+      }
+      vertex++;
+    }
+    else if(token != "outer" && token != "loop")
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief The raw bits of a vertex. Adding zero turns -0.0 into 0.0 so that the key is
+ * equal exactly when the coordinates compare equal.
+ */
+struct VertexKey
+{
+  std::array<uint32, 3> bits;
+
+  explicit VertexKey(const float32* vertex)
+  {
+    for(usize i = 0; i < 3; i++)
+    {
+      const float32 value = vertex[i] + 0.0F;
+      std::memcpy(&bits[i], &value, sizeof(float32));
+    }
+  }
+
+  uint64 hash() const
+  {
+    uint64 hash = (static_cast<uint64>(bits[0]) << 32 | bits[1]) * 0x9E3779B97F4A7C15ULL;
+    hash ^= bits[2] + (hash >> 29);
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    return hash ^ (hash >> 32);
+  }
+};
+
+/**
+ * @brief Finds for every vertex the lowest index of a vertex with the same coordinates.
+ * The vertices are partitioned into buckets by the hash of their coordinates and each
+ * bucket is sorted on its own, so the work is spread over all threads and no pair of
+ * vertices is compared more than a sort requires.
+ * @param vertices
+ * @param representatives Receives the lowest index of each vertex's duplicates
+ * @param shouldCancel
+ */
+void FindRepresentativeVertices(nonstd::span<const float32> vertices, std::vector<uint64>& representatives, const std::atomic_bool& shouldCancel)
+{
+  const usize numVertices = vertices.size() / 3;
+  const usize numThreads = NumberOfThreads();
+  const usize numChunks = std::max<usize>(1, std::min(numThreads * k_ChunksPerThread, numVertices));
+  const usize numBuckets = numThreads * k_BucketsPerThread;
+  const usize chunkSize = (numVertices + numChunks - 1) / numChunks;
+  auto bucketOf = [&](usize vertex) { return VertexKey(vertices.data() + vertex * 3).hash() % numBuckets; };
+
+  // Count the vertices of each chunk in each bucket
+  std::vector<usize> offsets(numChunks * numBuckets, 0);
+  ParallelDataAlgorithm countAlg;
+  countAlg.setRange(0, numChunks);
+  countAlg.execute([&](const Range& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      usize* counts = offsets.data() + chunk * numBuckets;
+      for(usize vertex = chunk * chunkSize; vertex < std::min(numVertices, (chunk + 1) * chunkSize); vertex++)
+      {
+        counts[bucketOf(vertex)]++;
+      }
+    }
+  });
+  if(shouldCancel)
+  {
+    return;
+  }
+
+  // Turn the counts into write positions so that each bucket lists its vertices in order
+  std::vector<usize> bucketStarts(numBuckets + 1, 0);
+  usize position = 0;
+  for(usize bucket = 0; bucket < numBuckets; bucket++)
+  {
+    bucketStarts[bucket] = position;
+    for(usize chunk = 0; chunk < numChunks; chunk++)
+    {
+      const usize count = offsets[chunk * numBuckets + bucket];
+      offsets[chunk * numBuckets + bucket] = position;
+      position += count;
+    }
+  }
+  bucketStarts[numBuckets] = position;
+
+  std::vector<uint64> bucketVertices(numVertices);
+  ParallelDataAlgorithm scatterAlg;
+  scatterAlg.setRange(0, numChunks);
+  scatterAlg.execute([&](const Range& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      usize* positions = offsets.data() + chunk * numBuckets;
+      for(usize vertex = chunk * chunkSize; vertex < std::min(numVertices, (chunk + 1) * chunkSize); vertex++)
+      {
+        bucketVertices[positions[bucketOf(vertex)]++] = vertex;
+      }
+    }
+  });
+  if(shouldCancel)
+  {
+    return;
+  }
+
+  ParallelDataAlgorithm weldAlg;
+  weldAlg.setRange(0, numBuckets);
+  weldAlg.execute([&](const Range& range) {
+    for(usize bucket = range.min(); bucket < range.max(); bucket++)
+    {
+      auto first = bucketVertices.begin() + bucketStarts[bucket];
+      auto last = bucketVertices.begin() + bucketStarts[bucket + 1];
+      std::sort(first, last, [&](uint64 lhs, uint64 rhs) {
+        const VertexKey lhsKey(vertices.data() + lhs * 3);
+        const VertexKey rhsKey(vertices.data() + rhs * 3);
+        return lhsKey.bits != rhsKey.bits ? lhsKey.bits < rhsKey.bits : lhs < rhs;
+      });
+      // Equal vertices are now adjacent and the lowest index leads each run
+      for(auto runStart = first; runStart != last;)
+      {
+        const VertexKey runKey(vertices.data() + *runStart * 3);
+        auto runEnd = runStart;
+        while(runEnd != last && VertexKey(vertices.data() + *runEnd * 3).bits == runKey.bits)
+        {
+          representatives[*runEnd] = *runStart;
+          ++runEnd;
+        }
+        runStart = runEnd;
+      }
+    }
+  });
+}
 } // End anonymous namespace
 
 StlFileReader::StlFileReader(DataStructure& data, fs::path stlFilePath, const DataPath& geometryPath, const DataPath& faceGroupPath, const DataPath& faceNormalsDataPath, bool scaleOutput,
@@ -111,21 +360,30 @@ StlFileReader::~StlFileReader() noexcept = default;
 
 Result<> StlFileReader::operator()()
 {
+  const int32 stlFileType = StlUtilities::DetermineStlFileType(m_FilePath);
+  if(stlFileType < 0)
+  {
+    return MakeErrorResult(stlFileType, fmt::format("Error reading the STL file '{}'", m_FilePath.string()));
+  }
 
-  m_MinMaxCoords = ::CreateMinMaxCoords();
-
-  // Open File
-  FILE* f = std::fopen(m_FilePath.string().c_str(), "rb");
-  if(nullptr == f)
+  // The file is mapped instead of read so the triangles can be decoded in parallel
+  MemoryMappedFile file(m_FilePath);
+  if(!file.isOpen())
   {
     return MakeErrorResult(complex::StlConstants::k_ErrorOpeningFile, "Error opening STL file");
   }
-  StlFileSentinel fileSentinel(f); // Will ensure that the file is closed when this method returns
 
-  // Read Header
-  std::array<char, complex::StlConstants::k_STL_HEADER_LENGTH> stlHeader = {0};
-  int32_t triCount = 0;
-  if(std::fread(stlHeader.data(), complex::StlConstants::k_STL_HEADER_LENGTH, 1, f) != 1)
+  Result<> result = (stlFileType == 1) ? readAsciiFile(file.view()) : readBinaryFile(file.view());
+  if(result.invalid() || m_ShouldCancel)
+  {
+    return result;
+  }
+  return eliminate_duplicate_nodes();
+}
+
+Result<> StlFileReader::readBinaryFile(std::string_view contents)
+{
+  if(contents.size() < complex::StlConstants::k_STL_HEADER_LENGTH)
   {
     return MakeErrorResult(complex::StlConstants::k_StlHeaderParseError, "Error reading first 8 bytes of STL header. This can't be good.");
   }
@@ -136,255 +394,288 @@ Result<> StlFileReader::operator()()
   // This NON Zero value does NOT indicate a length but is some sort of color
   // value encoded into the file. Instead of being normal like everyone else and
   // using the STL spec they went off and did their own thing.
-  std::string stlHeaderStr(stlHeader.data(), complex::StlConstants::k_STL_HEADER_LENGTH);
+  std::string_view stlHeader = contents.substr(0, complex::StlConstants::k_STL_HEADER_LENGTH);
+  const bool magicsFile = stlHeader.find("COLOR=") != std::string_view::npos && stlHeader.find("MATERIAL=") != std::string_view::npos;
 
-  bool magicsFile = false;
-  static const std::string k_ColorHeader("COLOR=");
-  static const std::string k_MaterialHeader("MATERIAL=");
-  if(stlHeaderStr.find(k_ColorHeader) != std::string::npos && stlHeaderStr.find(k_MaterialHeader) != std::string::npos)
-  {
-    magicsFile = true;
-  }
   // Read the number of triangles in the file.
-  if(std::fread(&triCount, sizeof(int32_t), 1, f) != 1)
+  int32 triCount = 0;
+  if(contents.size() < k_BinaryHeaderSize)
   {
     return MakeErrorResult(complex::StlConstants::k_TriangleCountParseError, "Error reading number of triangles from file. This is bad.");
   }
+  std::memcpy(&triCount, contents.data() + complex::StlConstants::k_STL_HEADER_LENGTH, sizeof(int32));
+  if(triCount < 0)
+  {
+    return MakeErrorResult(complex::StlConstants::k_TriangleCountParseError, fmt::format("The STL header specifies an invalid number of triangles: {}", triCount));
+  }
+  const usize numTriangles = static_cast<usize>(triCount);
 
   TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_GeometryDataPath);
+  ResizeTriangleGeometry(triangleGeom, numTriangles);
+  AbstractDataStore<float32>& vertexStore = triangleGeom.getVertices()->getDataStoreRef();
+  AbstractDataStore<float64>& normalStore = m_DataStructure.getDataRefAs<Float64Array>(m_FaceNormalsDataPath).getDataStoreRef();
 
-  triangleGeom.resizeFaceList(triCount);
-  triangleGeom.resizeVertexList(triCount * 3);
-
-  using SharedTriList = IGeometry::MeshIndexArrayType;
-  using SharedVertList = IGeometry::SharedVertexList;
-
-  SharedTriList& triangles = *(triangleGeom.getFaces());
-  SharedVertList& nodes = *(triangleGeom.getVertices());
+  // When every record has the standard size the triangles can be decoded independently. A non zero
+  // attribute byte count means the records that follow are shifted, so those files are walked in order.
+  if(contents.size() >= k_BinaryHeaderSize + numTriangles * k_BinaryTriangleSize)
+  {
+    const char* records = contents.data() + k_BinaryHeaderSize;
+    const usize numBlocks = (numTriangles + k_TrianglesPerBlock - 1) / k_TrianglesPerBlock;
+    std::atomic_bool hasAttributeData = false;
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.setParallelizationEnabled(vertexStore.isContiguous() && normalStore.isContiguous());
+    dataAlg.execute([&](const Range& range) {
+      TriangleBlockWriter writer(vertexStore, normalStore);
+      TriangleValues values = {};
+      uint16 attributeByteCount = 0;
+      for(usize block = range.min(); block < range.max(); block++)
+      {
+        if(m_ShouldCancel || hasAttributeData)
+        {
+          return;
+        }
+        const usize blockEnd = std::min(numTriangles, (block + 1) * k_TrianglesPerBlock);
+        for(usize t = block * k_TrianglesPerBlock; t < blockEnd; t++)
+        {
+          DecodeTriangle(records + t * k_BinaryTriangleSize, values, attributeByteCount);
+          if(attributeByteCount > 0 && !magicsFile)
+          {
+            hasAttributeData = true;
+            return;
+          }
+          writer.add(t, values);
+        }
+        writer.flush();
+      }
+    });
 
-  Float64Array& faceNormals = m_DataStructure.getDataRefAs<Float64Array>(m_FaceNormalsDataPath);
+    if(!hasAttributeData)
+    {
+      return {};
+    }
+  }
 
-  // Read the triangles
-  constexpr size_t k_StlElementCount = 12;
-  std::array<float, k_StlElementCount> fileVert = {0.0F};
-  uint16_t attr = 0;
-  std::vector<uint8_t> triangleAttributeBuffer(std::numeric_limits<uint16_t>::max()); // Just allocate a buffer of max UINT16 elements
-  for(int32_t t = 0; t < triCount; ++t)
+  TriangleBlockWriter writer(vertexStore, normalStore);
+  TriangleValues values = {};
+  uint16 attributeByteCount = 0;
+  usize offset = k_BinaryHeaderSize;
+  for(usize t = 0; t < numTriangles; t++)
   {
-    size_t objsRead = std::fread(fileVert.data(), sizeof(float), k_StlElementCount, f); // Read the Triangle
-    if(k_StlElementCount != objsRead)
+    const usize remaining = contents.size() - std::min(offset, contents.size());
+    if(remaining < sizeof(TriangleValues))
     {
-      std::string msg = fmt::format("Error reading Triangle '{}}'. Object Count was {} and should have been {}", t, objsRead, k_StlElementCount);
+      std::string msg = fmt::format("Error reading Triangle '{}'. Object Count was {} and should have been {}", t, remaining / sizeof(float32), k_ValuesPerTriangle);
       return MakeErrorResult(complex::StlConstants::k_TriangleParseError, msg);
     }
-
-    objsRead = std::fread(&attr, sizeof(uint16_t), 1, f); // Read the Triangle Attribute Data length
-    if(objsRead != 1)
+    if(remaining < k_BinaryTriangleSize)
     {
-      std::string msg = fmt::format("Error reading Number of attributes for triangle '{}'. Object Count was {} and should have been 1", t, objsRead);
+      std::string msg = fmt::format("Error reading Number of attributes for triangle '{}'. Object Count was 0 and should have been 1", t);
       return MakeErrorResult(complex::StlConstants::k_AttributeParseError, msg);
     }
-    if(attr > 0 && !magicsFile)
-    {
-      std::ignore = std::fseek(f, static_cast<size_t>(attr), SEEK_CUR); // Skip past the Triangle Attribute data since we don't know how to read it anyways
-    }
-    if(fileVert[3] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[3];
-    }
-    if(fileVert[3] > m_MinMaxCoords[1])
+    DecodeTriangle(contents.data() + offset, values, attributeByteCount);
+    offset += k_BinaryTriangleSize;
+    if(attributeByteCount > 0 && !magicsFile)
     {
-      m_MinMaxCoords[1] = fileVert[3];
+      // Skip past the Triangle Attribute data since we don't know how to read it anyways
+      offset += attributeByteCount;
     }
-    if(fileVert[4] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[4];
-    }
-    if(fileVert[4] > m_MinMaxCoords[3])
-    {
-      m_MinMaxCoords[3] = fileVert[4];
-    }
-    if(fileVert[5] < m_MinMaxCoords[4])
-    {
-      m_MinMaxCoords[4] = fileVert[5];
-    }
-    if(fileVert[5] > m_MinMaxCoords[5])
-    {
-      m_MinMaxCoords[5] = fileVert[5];
-    }
-    if(fileVert[6] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[6];
-    }
-    if(fileVert[6] > m_MinMaxCoords[1])
-    {
-      m_MinMaxCoords[1] = fileVert[6];
-    }
-    if(fileVert[7] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[7];
-    }
-    if(fileVert[7] > m_MinMaxCoords[3])
-    {
-      m_MinMaxCoords[3] = fileVert[7];
-    }
-    if(fileVert[8] < m_MinMaxCoords[4])
-    {
-      m_MinMaxCoords[4] = fileVert[8];
-    }
-    if(fileVert[8] > m_MinMaxCoords[5])
-    {
-      m_MinMaxCoords[5] = fileVert[8];
-    }
-    if(fileVert[9] < m_MinMaxCoords[0])
-    {
-      m_MinMaxCoords[0] = fileVert[9];
-    }
-    if(fileVert[9] > m_MinMaxCoords[1])
-    {
-      m_MinMaxCoords[1] = fileVert[9];
-    }
-    if(fileVert[10] < m_MinMaxCoords[2])
-    {
-      m_MinMaxCoords[2] = fileVert[10];
-    }
-    if(fileVert[10] > m_MinMaxCoords[3])
-    {
-      m_MinMaxCoords[3] = fileVert[10];
-    }
-    if(fileVert[11] < m_MinMaxCoords[4])
-    {
-      m_MinMaxCoords[4] = fileVert[11];
-    }
-    if(fileVert[11] > m_MinMaxCoords[5])
-    {
-      m_MinMaxCoords[5] = fileVert[11];
-    }
-    faceNormals[3 * t + 0] = static_cast<double>(fileVert[0]);
-    faceNormals[3 * t + 1] = static_cast<double>(fileVert[1]);
-    faceNormals[3 * t + 2] = static_cast<double>(fileVert[2]);
-    nodes[3 * (3 * t + 0) + 0] = fileVert[3];
-    nodes[3 * (3 * t + 0) + 1] = fileVert[4];
-    nodes[3 * (3 * t + 0) + 2] = fileVert[5];
-    nodes[3 * (3 * t + 1) + 0] = fileVert[6];
-    nodes[3 * (3 * t + 1) + 1] = fileVert[7];
-    nodes[3 * (3 * t + 1) + 2] = fileVert[8];
-    nodes[3 * (3 * t + 2) + 0] = fileVert[9];
-    nodes[3 * (3 * t + 2) + 1] = fileVert[10];
-    nodes[3 * (3 * t + 2) + 2] = fileVert[11];
-    triangles[t * 3] = 3 * t + 0;
-    triangles[t * 3 + 1] = 3 * t + 1;
-    triangles[t * 3 + 2] = 3 * t + 2;
+    writer.add(t, values);
     if(m_ShouldCancel)
     {
       return {};
     }
   }
-
-  return eliminate_duplicate_nodes();
-  // The fileSentinel will ensure the FILE* is closed.
+  writer.flush();
+  return {};
 }
 
-Result<> StlFileReader::eliminate_duplicate_nodes()
+Result<> StlFileReader::readAsciiFile(std::string_view contents)
 {
-  TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_GeometryDataPath);
-
-  using SharedTriList = IGeometry::MeshIndexArrayType;
-  using SharedVertList = IGeometry::SharedVertexList;
-
-  SharedTriList& triangles = *(triangleGeom.getFaces());
-  SharedVertList& vertices = *(triangleGeom.getVertices());
-
-  IGeometry::MeshIndexType nNodesAll = triangleGeom.getNumberOfVertices();
-  IGeometry::MeshIndexType nTriangles = triangleGeom.getNumberOfFaces();
-  size_t nNodes = 0;
-  if(nNodesAll > 0)
+  // Skip the 'solid name' line and stop at 'endsolid' so neither name is mistaken for a keyword
+  usize bodyStart = contents.find('\n');
+  bodyStart = (bodyStart == std::string_view::npos) ? contents.size() : bodyStart + 1;
+  usize bodyEnd = contents.rfind("endsolid");
+  if(bodyEnd == std::string_view::npos || bodyEnd < bodyStart)
   {
-    nNodes = static_cast<size_t>(nNodesAll);
+    bodyEnd = contents.size();
   }
-  float stepX = (m_MinMaxCoords[1] - m_MinMaxCoords[0]) / 100.0f;
-  float stepY = (m_MinMaxCoords[3] - m_MinMaxCoords[2]) / 100.0f;
-  float stepZ = (m_MinMaxCoords[5] - m_MinMaxCoords[4]) / 100.0f;
+  std::string_view body = contents.substr(bodyStart, bodyEnd - bodyStart);
 
-  std::vector<std::vector<size_t>> nodesInBin(100 * 100 * 100);
-
-  // determine (xyz) bin each node falls in - used to speed up node comparison
-  int32_t bin = 0, xBin = 0, yBin = 0, zBin = 0;
-  for(size_t i = 0; i < nNodes; i++)
+  // Each chunk owns the facets whose keyword starts inside of it
+  const usize numChunks = std::max<usize>(1, std::min(NumberOfThreads() * k_ChunksPerThread, body.size() / k_MinAsciiChunkSize));
+  std::vector<usize> chunkStarts(numChunks + 1, body.size());
+  for(usize chunk = 0; chunk < numChunks; chunk++)
   {
-    xBin = static_cast<int32_t>((vertices[i * 3] - m_MinMaxCoords[0]) / stepX);
-    yBin = static_cast<int32_t>((vertices[i * 3 + 1] - m_MinMaxCoords[2]) / stepY);
-    zBin = static_cast<int32_t>((vertices[i * 3 + 2] - m_MinMaxCoords[4]) / stepZ);
-    if(xBin == 100)
-    {
-      xBin = 99;
-    }
-    if(yBin == 100)
+    chunkStarts[chunk] = AlignToToken(body, body.size() / numChunks * chunk);
+  }
+
+  std::vector<usize> firstFacets(numChunks + 1, 0);
+  ParallelDataAlgorithm countAlg;
+  countAlg.setRange(0, numChunks);
+  countAlg.execute([&](const Range& range) {
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
     {
-      yBin = 99;
+      usize count = 0;
+      for(usize pos = FindFacet(body, chunkStarts[chunk], chunkStarts[chunk + 1]); pos != std::string_view::npos; pos = FindFacet(body, pos + 5, chunkStarts[chunk + 1]))
+      {
+        count++;
+      }
+      firstFacets[chunk + 1] = count;
     }
-    if(zBin == 100)
+  });
+  for(usize chunk = 0; chunk < numChunks; chunk++)
+  {
+    firstFacets[chunk + 1] += firstFacets[chunk];
+  }
+  const usize numTriangles = firstFacets[numChunks];
+
+  TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_GeometryDataPath);
+  ResizeTriangleGeometry(triangleGeom, numTriangles);
+  AbstractDataStore<float32>& vertexStore = triangleGeom.getVertices()->getDataStoreRef();
+  AbstractDataStore<float64>& normalStore = m_DataStructure.getDataRefAs<Float64Array>(m_FaceNormalsDataPath).getDataStoreRef();
+
+  std::vector<usize> invalidFacets(numChunks, std::numeric_limits<usize>::max());
+  ParallelDataAlgorithm parseAlg;
+  parseAlg.setRange(0, numChunks);
+  parseAlg.setParallelizationEnabled(vertexStore.isContiguous() && normalStore.isContiguous());
+  parseAlg.execute([&](const Range& range) {
+    TriangleBlockWriter writer(vertexStore, normalStore);
+    TriangleValues values = {};
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
     {
-      zBin = 99;
+      usize t = firstFacets[chunk];
+      for(usize pos = FindFacet(body, chunkStarts[chunk], chunkStarts[chunk + 1]); pos != std::string_view::npos; pos = FindFacet(body, pos, chunkStarts[chunk + 1]))
+      {
+        if(m_ShouldCancel)
+        {
+          return;
+        }
+        if(!ParseFacet(body, pos, values))
+        {
+          invalidFacets[chunk] = t;
+          break;
+        }
+        writer.add(t, values);
+        t++;
+      }
+      writer.flush();
     }
-    bin = (zBin * 10000) + (yBin * 100) + xBin;
-    nodesInBin[bin].push_back(i);
-  }
+  });
 
-  // Create array to hold unique node numbers
-  Int64DataStore uniqueIds(IDataStore::ShapeType{nNodes}, IDataStore::ShapeType{1}, {});
-  for(IGeometry::MeshIndexType i = 0; i < nNodesAll; i++)
+  const usize invalidFacet = *std::min_element(invalidFacets.begin(), invalidFacets.end());
+  if(invalidFacet != std::numeric_limits<usize>::max())
   {
-    uniqueIds[i] = static_cast<int64_t>(i);
+    return MakeErrorResult(complex::StlConstants::k_TriangleParseError, fmt::format("Error parsing facet '{}' of the ASCII STL file", invalidFacet));
   }
+  return {};
+}
 
-  // Parallel algorithm to find duplicate nodes
-  ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0ULL, static_cast<size_t>(100 * 100 * 100));
-  dataAlg.execute(::FindUniqueIdsImpl(vertices, nodesInBin, uniqueIds));
+Result<> StlFileReader::eliminate_duplicate_nodes()
+{
+  TriangleGeom& triangleGeom = m_DataStructure.getDataRefAs<TriangleGeom>(m_GeometryDataPath);
+  AbstractDataStore<IGeometry::MeshIndexType>& faceStore = triangleGeom.getFaces()->getDataStoreRef();
 
-  // renumber the unique nodes
-  int64_t uniqueCount = 0;
-  for(size_t i = 0; i < nNodes; i++)
+  const usize numVertices = triangleGeom.getNumberOfVertices();
+  const usize numTriangles = triangleGeom.getNumberOfFaces();
+  const usize numChunks = std::max<usize>(1, std::min(NumberOfThreads() * k_ChunksPerThread, numVertices));
+  const usize chunkSize = (numVertices + numChunks - 1) / numChunks;
+
+  const float32 scaleFactor = m_ScaleOutput ? m_ScaleFactor : 1.0F;
+
+  std::vector<float32> uniqueVertices;
   {
-    if(uniqueIds[i] == static_cast<int64_t>(i))
+    // Duplicates are found by random access across the whole vertex list, so a list that
+    // is not held in memory is read into memory first
+    const AbstractDataStore<float32>& vertexStore = std::as_const(*triangleGeom.getVertices()).getDataStoreRef();
+    std::vector<float32> vertexValues;
+    nonstd::span<const float32> vertices;
+    if(vertexStore.isContiguous())
     {
-      uniqueIds[i] = uniqueCount;
-      uniqueCount++;
+      vertices = vertexStore.contiguousSpan();
     }
     else
     {
-      uniqueIds[i] = uniqueIds[uniqueIds[i]];
+      vertexValues.resize(vertexStore.getSize());
+      vertexStore.copyIntoBuffer(0, nonstd::span<float32>(vertexValues.data(), vertexValues.size()));
+      vertices = nonstd::span<const float32>(vertexValues.data(), vertexValues.size());
+    }
+    std::vector<uint64> representatives(numVertices);
+    FindRepresentativeVertices(vertices, representatives, m_ShouldCancel);
+    if(m_ShouldCancel)
+    {
+      return {};
     }
-  }
-
-  float scaleFactor = 1.0F;
-  if(m_ScaleOutput)
-  {
-    scaleFactor = m_ScaleFactor;
-  }
 
-  // Move nodes to unique Id and then resize nodes array and apply optional scaling
-  for(size_t i = 0; i < nNodes; i++)
-  {
-    vertices[uniqueIds[i] * 3] = vertices[i * 3] * m_ScaleFactor;
-    vertices[uniqueIds[i] * 3 + 1] = vertices[i * 3 + 1] * m_ScaleFactor;
-    vertices[uniqueIds[i] * 3 + 2] = vertices[i * 3 + 2] * m_ScaleFactor;
+    // Number the unique vertices in the order they first appear
+    std::vector<usize> chunkFirstIds(numChunks + 1, 0);
+    ParallelDataAlgorithm countAlg;
+    countAlg.setRange(0, numChunks);
+    countAlg.execute([&](const Range& range) {
+      for(usize chunk = range.min(); chunk < range.max(); chunk++)
+      {
+        usize count = 0;
+        for(usize i = chunk * chunkSize; i < std::min(numVertices, (chunk + 1) * chunkSize); i++)
+        {
+          count += (representatives[i] == i) ? 1 : 0;
+        }
+        chunkFirstIds[chunk + 1] = count;
+      }
+    });
+    for(usize chunk = 0; chunk < numChunks; chunk++)
+    {
+      chunkFirstIds[chunk + 1] += chunkFirstIds[chunk];
+    }
+    const usize uniqueCount = chunkFirstIds[numChunks];
+
+    // Move the unique vertices to their new ids and apply the optional scaling
+    std::vector<uint64> uniqueIds(numVertices);
+    uniqueVertices.resize(uniqueCount * 3);
+    ParallelDataAlgorithm moveAlg;
+    moveAlg.setRange(0, numChunks);
+    moveAlg.execute([&](const Range& range) {
+      for(usize chunk = range.min(); chunk < range.max(); chunk++)
+      {
+        usize uniqueId = chunkFirstIds[chunk];
+        for(usize i = chunk * chunkSize; i < std::min(numVertices, (chunk + 1) * chunkSize); i++)
+        {
+          if(representatives[i] != i)
+          {
+            continue;
+          }
+          uniqueIds[i] = uniqueId;
+          for(usize c = 0; c < 3; c++)
+          {
+            uniqueVertices[uniqueId * 3 + c] = vertices[i * 3 + c] * scaleFactor;
+          }
+          uniqueId++;
+        }
+      }
+    });
+
+    // Update the triangle nodes to reflect the unique ids
+    const usize numBlocks = (numTriangles + k_TrianglesPerBlock - 1) / k_TrianglesPerBlock;
+    ParallelDataAlgorithm faceAlg;
+    faceAlg.setRange(0, numBlocks);
+    faceAlg.setParallelizationEnabled(faceStore.isContiguous());
+    faceAlg.execute([&](const Range& range) {
+      std::vector<IGeometry::MeshIndexType> faces(k_TrianglesPerBlock * 3);
+      for(usize block = range.min(); block < range.max(); block++)
+      {
+        const usize start = block * k_TrianglesPerBlock * 3;
+        const usize count = std::min(numTriangles * 3, start + k_TrianglesPerBlock * 3) - start;
+        for(usize i = 0; i < count; i++)
+        {
+          faces[i] = uniqueIds[representatives[start + i]];
+        }
+        faceStore.copyFromBuffer(start, nonstd::span<const IGeometry::MeshIndexType>(faces.data(), count));
+      }
+    });
   }
-  triangleGeom.resizeVertexList(uniqueCount);
 
-  // Update the triangle nodes to reflect the unique ids
-  int64_t node1 = 0, node2 = 0, node3 = 0;
-  for(size_t i = 0; i < static_cast<size_t>(nTriangles); i++)
-  {
-    node1 = triangles[i * 3];
-    node2 = triangles[i * 3 + 1];
-    node3 = triangles[i * 3 + 2];
-
-    triangles[i * 3] = uniqueIds[node1];
-    triangles[i * 3 + 1] = uniqueIds[node2];
-    triangles[i * 3 + 2] = uniqueIds[node3];
-  }
+  triangleGeom.resizeVertexList(uniqueVertices.size() / 3);
+  triangleGeom.getVertices()->getDataStoreRef().copyFromBuffer(0, nonstd::span<const float32>(uniqueVertices.data(), uniqueVertices.size()));
 
   ResizeAttributeMatrix(*triangleGeom.getFaceAttributeMatrix(), {triangleGeom.getNumberOfFaces()});
   ResizeAttributeMatrix(*triangleGeom.getVertexAttributeMatrix(), {triangleGeom.getNumberOfVertices()});
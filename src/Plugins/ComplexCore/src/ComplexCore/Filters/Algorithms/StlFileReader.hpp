@@ -7,17 +7,17 @@
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/IFilter.hpp"
 
-#include <array>
 #include <filesystem>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
 namespace complex
 {
 /**
- * @class ConditionalSetValue
- * @brief This filter replaces values in the target array with a user specified value
- * where a bool mask array specifies.
+ * @class StlFileReader
+ * @brief Reads a binary or ASCII STL file into a Triangle Geometry and welds the
+ * vertices that the triangles share.
  */
 class COMPLEXCORE_EXPORT StlFileReader
 {
@@ -33,21 +33,28 @@ public:
 
   Result<> operator()();
 
-  /**
-   * @brief readFile Reads the .stl file
-   */
-  Result<> readFile();
-
   /**
    * @brief eliminate_duplicate_nodes Removes duplicate nodes to ensure the
-   * created vertex list is shared
+   * created vertex list is shared. The vertices are expected to be stored three per
+   * triangle in face order, which is how the file readers leave them, and the face
+   * list is rebuilt from the welded vertex ids.
    */
   Result<> eliminate_duplicate_nodes();
 
 private:
-  // Holds the min/max coordinates for X, Y, Z laid out at { X_Min, X_Max, Y_Min, Y_Max, Z_Min, Z_Max}
-  std::array<float, 6> m_MinMaxCoords = {std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-                                         -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),  -std::numeric_limits<float>::max()};
+  /**
+   * @brief Decodes the triangles of a binary STL file into the geometry.
+   * @param contents The complete contents of the file
+   * @return Result<>
+   */
+  Result<> readBinaryFile(std::string_view contents);
+
+  /**
+   * @brief Parses the facets of an ASCII STL file into the geometry.
+   * @param contents The complete contents of the file
+   * @return Result<>
+   */
+  Result<> readAsciiFile(std::string_view contents);
 
   DataStructure& m_DataStructure;
   const fs::path m_FilePath;
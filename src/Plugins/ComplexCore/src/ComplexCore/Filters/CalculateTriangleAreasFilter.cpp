@@ -178,6 +178,8 @@ Result<> CalculateTriangleAreasFilter::executeImpl(DataStructure& dataStructure,
   // Parallel algorithm to find duplicate nodes
   ParallelDataAlgorithm dataAlg;
   dataAlg.setRange(0ULL, static_cast<size_t>(triangleGeom.getNumberOfFaces()));
+  // Vertices are gathered by face index, so out-of-core arrays would be read element by element
+  dataAlg.requireArraysInMemory({triangleGeom.getVertices(), triangleGeom.getFaces(), &faceAreas});
   dataAlg.execute(::CalculateAreasImpl(*(triangleGeom.getVertices()), *(triangleGeom.getFaces()), faceAreas));
 
   return {};
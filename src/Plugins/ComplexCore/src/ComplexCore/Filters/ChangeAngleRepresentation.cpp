@@ -7,7 +7,9 @@
 #include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 #include <fmt/format.h>
 
 using namespace complex;
@@ -33,9 +35,27 @@ public:
 
   void convert(size_t start, size_t end) const
   {
-    for(size_t i = start; i < end; i++)
+    AbstractDataStore<float32>& angles = m_Angles.getDataStoreRef();
+    if(angles.isContiguous())
     {
-      m_Angles[i] = m_Angles[i] * m_ConvFactor;
+      for(float32& angle : angles.contiguousSpan().subspan(start, end - start))
+      {
+        angle *= m_ConvFactor;
+      }
+      return;
+    }
+
+    // Other stores are converted a block at a time through their bulk access
+    std::vector<float32> buffer(std::min(k_BlockSize, end - start));
+    for(size_t blockStart = start; blockStart < end; blockStart += k_BlockSize)
+    {
+      nonstd::span<float32> block(buffer.data(), std::min(k_BlockSize, end - blockStart));
+      angles.copyIntoBuffer(blockStart, block);
+      for(float32& angle : block)
+      {
+        angle *= m_ConvFactor;
+      }
+      angles.copyFromBuffer(blockStart, block);
     }
   }
 
@@ -45,6 +65,8 @@ public:
   }
 
 private:
+  static constexpr size_t k_BlockSize = 4096;
+
   Float32Array& m_Angles;
   float m_ConvFactor = 0.0F;
 };
@@ -8,6 +8,7 @@
 #include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/DataObjectNameParameter.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 
 using namespace complex;
 
@@ -39,6 +40,15 @@ void copyData(DataStructure& dataStructure, const DataPath& selectedFeatureArray
     }
   }
 }
+
+struct CopyDataFunctor
+{
+  template <typename T>
+  void operator()(DataStructure& dataStructure, const DataPath& selectedFeatureArrayPath, const DataPath& featureIdsArrayPath, const DataPath& createdArrayPath, const std::atomic_bool& shouldCancel)
+  {
+    copyData<T>(dataStructure, selectedFeatureArrayPath, featureIdsArrayPath, createdArrayPath, shouldCancel);
+  }
+};
 } // namespace
 
 namespace complex
@@ -143,43 +153,11 @@ Result<> CopyFeatureArrayToElementArray::executeImpl(DataStructure& dataStructur
     return results;
   }
 
-  switch(selectedFeatureArray.getDataType())
+  if(!IsDataTypeInList<AllDataTypes>(selectedFeatureArray.getDataType()))
   {
-  case DataType::int8:
-    copyData<int8>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::uint8:
-    copyData<uint8>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::int16:
-    copyData<int16>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::uint16:
-    copyData<uint16>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::int32:
-    copyData<int32>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::uint32:
-    copyData<uint32>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::int64:
-    copyData<int64>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::uint64:
-    copyData<uint64>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::float32:
-    copyData<float>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::float64:
-    copyData<double>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  case DataType::boolean:
-    copyData<bool>(dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
-    return {};
-  default:
     return MakeErrorResult(-14000, fmt::format("The selected array was of unsupported type. The path is {}", pSelectedFeatureArrayPathValue.toString()));
   }
+  ExecuteDataFunction(CopyDataFunctor{}, selectedFeatureArray.getDataType(), dataStructure, pSelectedFeatureArrayPathValue, pFeatureIdsArrayPathValue, createdArrayPath, shouldCancel);
+  return {};
 }
 } // namespace complex
@@ -7,6 +7,7 @@
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/ArraySelectionParameter.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 
 using namespace complex;
 
@@ -64,6 +65,16 @@ Result<> copyCellData(DataStructure& dataStructure, const DataPath& selectedCell
 
   return result;
 }
+
+struct CopyCellDataFunctor
+{
+  template <typename T>
+  Result<> operator()(DataStructure& dataStructure, const DataPath& selectedCellArrayPathValue, const DataPath& featureIdsArrayPathValue, const DataPath& createdArrayNameValue,
+                      const std::atomic_bool& shouldCancel)
+  {
+    return copyCellData<T>(dataStructure, selectedCellArrayPathValue, featureIdsArrayPathValue, createdArrayNameValue, shouldCancel);
+  }
+};
 } // namespace
 
 namespace complex
@@ -164,32 +175,10 @@ Result<> CreateFeatureArrayFromElementArray::executeImpl(DataStructure& dataStru
   IDataStore& createdArrayStore = createdArray.getIDataStoreRefAs<IDataStore>();
   createdArrayStore.reshapeTuples(std::vector<usize>{maxValue + 1});
 
-  switch(selectedCellArray.getDataType())
+  if(!IsDataTypeInList<AllDataTypes>(selectedCellArray.getDataType()))
   {
-  case DataType::int8:
-    return copyCellData<int8>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::uint8:
-    return copyCellData<uint8>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::int16:
-    return copyCellData<int16>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::uint16:
-    return copyCellData<uint16>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::int32:
-    return copyCellData<int32>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::uint32:
-    return copyCellData<uint32>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::int64:
-    return copyCellData<int64>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::uint64:
-    return copyCellData<uint64>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::float32:
-    return copyCellData<float>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::float64:
-    return copyCellData<double>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  case DataType::boolean:
-    return copyCellData<bool>(dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
-  default:
     return MakeErrorResult(-14000, fmt::format("The selected array was of unsupported type. The path is {}", pSelectedCellArrayPathValue.toString()));
   }
+  return ExecuteDataFunction(CopyCellDataFunctor{}, selectedCellArray.getDataType(), dataStructure, pSelectedCellArrayPathValue, pFeatureIdsArrayPathValue, pCreatedArrayNameValue, shouldCancel);
 }
 } // namespace complex
@@ -19,10 +19,9 @@
 #include "complex/Parameters/VectorParameter.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
-#include "complex/Utilities/ParallelDataAlgorithm.hpp"
-#include "complex/Utilities/ParallelTaskAlgorithm.hpp"
 #include "complex/Utilities/SamplingUtils.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
+#include "complex/Utilities/TupleGatherMap.hpp"
 
 using namespace complex;
 
@@ -85,131 +84,6 @@ FloatVec3 GetCurrentVolumeDataContainerResolutions(const DataStructure& dataStru
   return data;
 }
 
-/**
- * @brief
- * @tparam T
- */
-template <typename T>
-class CropImageGeomDataArray
-{
-public:
-  CropImageGeomDataArray(const IDataArray& oldCellArray, IDataArray& newCellArray, const ImageGeom& srcImageGeom, std::array<uint64, 6> bounds, const std::atomic_bool& shouldCancel)
-  : m_OldCellArray(dynamic_cast<const DataArray<T>&>(oldCellArray))
-  , m_NewCellArray(dynamic_cast<DataArray<T>&>(newCellArray))
-  , m_SrcImageGeom(srcImageGeom)
-  , m_Bounds(bounds)
-  , m_ShouldCancel(shouldCancel)
-  {
-  }
-
-  ~CropImageGeomDataArray() = default;
-
-  CropImageGeomDataArray(const CropImageGeomDataArray&) = default;
-  CropImageGeomDataArray(CropImageGeomDataArray&&) noexcept = default;
-  CropImageGeomDataArray& operator=(const CropImageGeomDataArray&) = delete;
-  CropImageGeomDataArray& operator=(CropImageGeomDataArray&&) noexcept = delete;
-
-  void operator()() const
-  {
-    convert();
-  }
-
-protected:
-  void convert() const
-  {
-    size_t numComps = m_OldCellArray.getNumberOfComponents();
-
-    auto& dataStore = m_NewCellArray.getDataStoreRef();
-    std::fill(dataStore.begin(), dataStore.end(), static_cast<T>(-1));
-
-    auto srcDims = m_SrcImageGeom.getDimensions();
-
-    uint64 destTupleIndex = 0;
-    for(uint64 zIndex = m_Bounds[4]; zIndex < m_Bounds[5]; zIndex++)
-    {
-      if(m_ShouldCancel)
-      {
-        return;
-      }
-      for(uint64 yIndex = m_Bounds[2]; yIndex < m_Bounds[3]; yIndex++)
-      {
-        for(uint64 xIndex = m_Bounds[0]; xIndex < m_Bounds[1]; xIndex++)
-        {
-          uint64 srcIndex = (srcDims[0] * srcDims[1] * zIndex) + (srcDims[0] * yIndex) + xIndex;
-          for(size_t compIndex = 0; compIndex < numComps; compIndex++)
-          {
-            m_NewCellArray[destTupleIndex * numComps + compIndex] = m_OldCellArray[srcIndex * numComps + compIndex];
-          }
-          destTupleIndex++;
-        }
-      }
-    }
-  }
-
-private:
-  const DataArray<T>& m_OldCellArray;
-  DataArray<T>& m_NewCellArray;
-  const ImageGeom& m_SrcImageGeom;
-  std::array<uint64, 6> m_Bounds;
-  const std::atomic_bool& m_ShouldCancel;
-};
-
-void ExecuteCropImageGeomDataArray(ParallelTaskAlgorithm& taskRunner, const IDataArray& oldCellArray, IDataArray& newCellArray, const ImageGeom& srcImageGeom, std::array<uint64, 6> bounds,
-                                   const std::atomic_bool& shouldCancel)
-{
-  DataType type = oldCellArray.getDataType();
-  switch(type)
-  {
-  case DataType::boolean: {
-    taskRunner.execute(CropImageGeomDataArray<bool>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::int8: {
-    taskRunner.execute(CropImageGeomDataArray<int8>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::int16: {
-    taskRunner.execute(CropImageGeomDataArray<int16>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::int32: {
-    taskRunner.execute(CropImageGeomDataArray<int32>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::int64: {
-    taskRunner.execute(CropImageGeomDataArray<int64>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::uint8: {
-    taskRunner.execute(CropImageGeomDataArray<uint8>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::uint16: {
-    taskRunner.execute(CropImageGeomDataArray<uint16>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::uint32: {
-    taskRunner.execute(CropImageGeomDataArray<uint32>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::uint64: {
-    taskRunner.execute(CropImageGeomDataArray<uint64>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::float32: {
-    taskRunner.execute(CropImageGeomDataArray<float32>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  case DataType::float64: {
-    taskRunner.execute(CropImageGeomDataArray<float64>(oldCellArray, newCellArray, srcImageGeom, bounds, shouldCancel));
-    break;
-  }
-  default: {
-    throw std::runtime_error("Invalid DataType");
-  }
-  }
-}
-
 } // namespace
 
 //------------------------------------------------------------------------------
@@ -559,28 +433,49 @@ Result<> CropImageGeometry::executeImpl(DataStructure& dataStructure, const Argu
 
   std::array<uint64, 6> bounds = {xMin, xMax + 1, yMin, yMax + 1, zMin, zMax + 1};
 
-  // The actual cropping of the dataStructure arrays is done in parallel where parallel here
-  // refers to the cropping of each DataArray being done on a separate thread.
-  ParallelTaskAlgorithm taskRunner;
-  const auto& srcCellDataAM = srcImageGeom.getCellDataRef();
-  auto& destCellDataAM = destImageGeom.getCellDataRef();
-  for(const auto& [dataId, oldDataObject] : srcCellDataAM)
+  // Every tuple of the cropped geometry is gathered from its tuple in the source geometry. The map
+  // is built once and shared by all of the cell arrays, which are each copied in parallel.
+  std::vector<int64> sourceIndices;
+  sourceIndices.reserve((bounds[1] - bounds[0]) * (bounds[3] - bounds[2]) * (bounds[5] - bounds[4]));
+  for(uint64 zIndex = bounds[4]; zIndex < bounds[5]; zIndex++)
   {
-    if(shouldCancel)
+    for(uint64 yIndex = bounds[2]; yIndex < bounds[3]; yIndex++)
     {
-      return {};
+      for(uint64 xIndex = bounds[0]; xIndex < bounds[1]; xIndex++)
+      {
+        sourceIndices.push_back(static_cast<int64>((udims[0] * udims[1] * zIndex) + (udims[0] * yIndex) + xIndex));
+      }
     }
+  }
+  Result<TupleGatherMap> gatherMapResult = TupleGatherMap::Create(sourceIndices);
+  if(gatherMapResult.invalid())
+  {
+    return ConvertResult(std::move(gatherMapResult));
+  }
+  const TupleGatherMap& gatherMap = gatherMapResult.value();
 
+  const auto& srcCellDataAM = srcImageGeom.getCellDataRef();
+  auto& destCellDataAM = destImageGeom.getCellDataRef();
+  std::vector<const IDataArray*> oldDataArrays;
+  std::vector<IDataArray*> newDataArrays;
+  for(const auto& [dataId, oldDataObject] : srcCellDataAM)
+  {
     const auto& oldDataArray = dynamic_cast<const IDataArray&>(*oldDataObject);
-    std::string srcName = oldDataArray.getName();
-
-    auto& newDataArray = dynamic_cast<IDataArray&>(destCellDataAM.at(srcName));
-
-    messageHandler(fmt::format("Cropping Volume || Copying Data Array {}", srcName));
-    ExecuteCropImageGeomDataArray(taskRunner, oldDataArray, newDataArray, srcImageGeom, bounds, shouldCancel);
+    oldDataArrays.push_back(&oldDataArray);
+    newDataArrays.push_back(&dynamic_cast<IDataArray&>(destCellDataAM.at(oldDataArray.getName())));
+  }
+  if(shouldCancel)
+  {
+    return {};
   }
-  taskRunner.wait(); // This will spill over if the number of DataArrays to process does not divide evenly by the number of threads.
 
+  // All cell arrays are cropped together in one pass over the cropped volume
+  messageHandler(fmt::format("Cropping Volume || Copying {} Data Arrays", oldDataArrays.size()));
+  Result<> gatherResult = gatherMap.apply(oldDataArrays, newDataArrays);
+  if(gatherResult.invalid())
+  {
+    return gatherResult;
+  }
   if(shouldCancel)
   {
     return {};
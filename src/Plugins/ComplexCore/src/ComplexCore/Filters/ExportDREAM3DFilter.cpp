@@ -2,7 +2,9 @@
 
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Parameters/FileSystemPathParameter.hpp"
+#include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Parameters/StringParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Pipeline/PipelineFilter.hpp"
@@ -15,6 +17,26 @@ constexpr complex::int32 k_NoExportPathError = -1;
 constexpr complex::int32 k_NoParentPathError = -2;
 constexpr complex::int32 k_FailedFileWriterError = -14;
 constexpr complex::int32 k_FailedFindPipelineError = -15;
+constexpr complex::int32 k_InvalidCompressionLevelError = -16;
+
+constexpr complex::uint64 k_ContiguousLayout = 0;
+constexpr complex::uint64 k_AutomaticChunkLayout = 1;
+constexpr complex::uint64 k_SliceChunkLayout = 2;
+
+complex::H5::DatasetCreationOptions CreateDatasetOptions(complex::uint64 chunkLayout, complex::int32 compressionLevel, bool useShuffle, bool parallelCompression)
+{
+  complex::H5::DatasetCreationOptions options;
+  options.chunked = chunkLayout != k_ContiguousLayout;
+  if(chunkLayout == k_SliceChunkLayout)
+  {
+    // One slice of the slowest dimension, i.e. one Z slice of an image geometry
+    options.chunkShape = {1};
+  }
+  options.compressionLevel = static_cast<complex::uint32>(compressionLevel);
+  options.shuffle = useShuffle;
+  options.parallelCompression = parallelCompression;
+  return options;
+}
 } // namespace
 
 namespace complex
@@ -47,6 +69,15 @@ Parameters ExportDREAM3DFilter::parameters() const
   params.insert(std::make_unique<FileSystemPathParameter>(k_ExportFilePath, "Export File Path", "The file path the DataStructure should be written to as an HDF5 file.", "",
                                                           FileSystemPathParameter::ExtensionsType{".dream3d"}, FileSystemPathParameter::PathType::OutputFile));
   params.insert(std::make_unique<BoolParameter>(k_WriteXdmf, "Write Xdmf File", "Whether or not to write the data out an xdmf file", true));
+  params.insertSeparator(Parameters::Separator{"Storage Options"});
+  params.insert(std::make_unique<ChoicesParameter>(k_ChunkLayout, "Chunk Layout", "How array datasets are laid out in the file. Compression always uses a chunked layout.", k_ContiguousLayout,
+                                                   ChoicesParameter::Choices{"Contiguous", "Automatic Chunks", "One Slice Per Chunk"}));
+  params.insert(std::make_unique<Int32Parameter>(k_CompressionLevel, "Compression Level", "Deflate compression level from 0 (no compression) to 9 (smallest file)", 0));
+  params.insert(std::make_unique<BoolParameter>(k_UseShuffle, "Use Shuffle Filter", "Whether to shuffle the bytes of each value before compression. This usually improves compression of numeric data.",
+                                                false));
+  params.insert(std::make_unique<BoolParameter>(k_ParallelCompression, "Compress In Parallel",
+                                                "Whether to compress chunks on multiple threads while a single stage writes them to the file. Has no effect without compression or shuffling.",
+                                                true));
   return params;
 }
 
@@ -62,6 +93,11 @@ IFilter::PreflightResult ExportDREAM3DFilter::preflightImpl(const DataStructure&
   {
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_NoExportPathError, "Export file path not provided."}})};
   }
+  auto compressionLevel = args.value<int32>(k_CompressionLevel);
+  if(compressionLevel < 0 || compressionLevel > 9)
+  {
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_InvalidCompressionLevelError, fmt::format("Compression level must be between 0 and 9. Received {}.", compressionLevel)}})};
+  }
   return {};
 }
 
@@ -70,6 +106,10 @@ Result<> ExportDREAM3DFilter::executeImpl(DataStructure& dataStructure, const Ar
 {
   auto exportFilePath = args.value<std::filesystem::path>(k_ExportFilePath);
   auto writeXdmf = args.value<bool>(k_WriteXdmf);
+  auto chunkLayout = args.value<uint64>(k_ChunkLayout);
+  auto compressionLevel = args.value<int32>(k_CompressionLevel);
+  auto useShuffle = args.value<bool>(k_UseShuffle);
+  auto parallelCompression = args.value<bool>(k_ParallelCompression);
 
   auto pipelinePtr = pipelineNode->getPrecedingPipeline();
   if(pipelinePtr == nullptr)
@@ -78,7 +118,15 @@ Result<> ExportDREAM3DFilter::executeImpl(DataStructure& dataStructure, const Ar
   }
   Pipeline pipeline = *pipelinePtr;
 
-  auto results = DREAM3D::WriteFile(exportFilePath, dataStructure, pipeline, writeXdmf);
-  return results;
+  auto results = DREAM3D::WriteFile(exportFilePath, dataStructure, pipeline, writeXdmf, CreateDatasetOptions(chunkLayout, compressionLevel, useShuffle, parallelCompression));
+  if(results.invalid())
+  {
+    return ConvertResult(std::move(results));
+  }
+
+  const DREAM3D::WriteStatistics& statistics = results.value();
+  messageHandler(IFilter::Message{IFilter::Message::Type::Info, fmt::format("Wrote {} bytes to '{}'. Array data: {} bytes stored, {} bytes uncompressed (compression ratio {:.2f})", statistics.fileBytes,
+                                                                             exportFilePath.string(), statistics.storedBytes, statistics.dataBytes, statistics.compressionRatio())});
+  return ConvertResult(std::move(results));
 }
 } // namespace complex
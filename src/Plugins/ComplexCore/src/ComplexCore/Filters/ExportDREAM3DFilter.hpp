@@ -29,6 +29,10 @@ public:
   // Parameter Keys
   static inline constexpr StringLiteral k_ExportFilePath = "export_file_path";
   static inline constexpr StringLiteral k_WriteXdmf = "write_xdmf_file";
+  static inline constexpr StringLiteral k_ChunkLayout = "chunk_layout";
+  static inline constexpr StringLiteral k_CompressionLevel = "compression_level";
+  static inline constexpr StringLiteral k_UseShuffle = "use_shuffle";
+  static inline constexpr StringLiteral k_ParallelCompression = "parallel_compression";
 
   /**
    * @brief Returns the name of the filter class.
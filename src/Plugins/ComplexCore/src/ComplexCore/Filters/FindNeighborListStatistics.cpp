@@ -83,11 +83,15 @@ public:
       throw std::invalid_argument("FindNeighborListStatistics::compute() could not dynamic_cast 'Summation' array to needed type. Check input array selection.");
     }
 
-    NeighborListType& sourceList = dynamic_cast<NeighborListType&>(m_Source);
+    const NeighborListType& sourceList = dynamic_cast<const NeighborListType&>(m_Source);
 
+    // Lists are read through spans so compressed lists are never expanded from
+    // several threads; the buffer is reused across the whole range.
+    std::vector<T> tmpList;
     for(usize i = start; i < end; i++)
     {
-      std::vector<T>& tmpList = sourceList[i];
+      const nonstd::span<const T> list = sourceList.getListSpan(static_cast<int32>(i));
+      tmpList.assign(list.begin(), list.end());
 
       if(m_Length)
       {
@@ -1,6 +1,8 @@
 #include "FindNeighbors.hpp"
 
+#include <algorithm>
 #include <sstream>
+#include <utility>
 
 #include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataArray.hpp"
@@ -15,9 +17,282 @@
 #include "complex/Parameters/DataObjectNameParameter.hpp"
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 namespace complex
 {
+namespace
+{
+// Smallest number of cells worth giving their own chunk
+constexpr usize k_MinCellsPerChunk = 4096;
+
+/**
+ * @brief The faces one chunk of cells shares with other features. Each key packs a
+ * (feature, neighbor) pair, the keys are sorted and counts holds the number of faces
+ * of every key.
+ */
+struct FaceRuns
+{
+  std::vector<uint64> keys;
+  std::vector<int32> counts;
+};
+
+inline uint64 MakeFaceKey(int32 feature, int32 neighbor)
+{
+  return (static_cast<uint64>(static_cast<uint32>(feature)) << 32) | static_cast<uint32>(neighbor);
+}
+
+inline int32 FaceKeyFeature(uint64 key)
+{
+  return static_cast<int32>(key >> 32);
+}
+
+inline int32 FaceKeyNeighbor(uint64 key)
+{
+  return static_cast<int32>(key & 0xFFFFFFFFull);
+}
+
+/**
+ * @brief Flags every feature that owns a cell on the outer surface of the geometry. For a
+ * single slice only the cells on the edges of the slice count. Only the surface rows and
+ * the first and last cell of every other row are visited.
+ */
+void markSurfaceFeatures(const ConstDataView<int32>& featureIds, const SizeVec3& dims, AbstractDataStore<bool>& surfaceFeatures)
+{
+  const bool singleSlice = dims[2] == 1;
+  auto markCell = [&](usize cell) {
+    const int32 feature = featureIds[cell];
+    if(feature > 0)
+    {
+      surfaceFeatures.setValue(feature, true);
+    }
+  };
+  for(usize plane = 0; plane < dims[2]; plane++)
+  {
+    const bool surfacePlane = !singleSlice && (plane == 0 || plane == dims[2] - 1);
+    for(usize row = 0; row < dims[1]; row++)
+    {
+      const usize rowStart = (plane * dims[1] + row) * dims[0];
+      if(surfacePlane || row == 0 || row == dims[1] - 1)
+      {
+        for(usize column = 0; column < dims[0]; column++)
+        {
+          markCell(rowStart + column);
+        }
+        continue;
+      }
+      markCell(rowStart);
+      markCell(rowStart + dims[0] - 1);
+    }
+  }
+}
+
+/**
+ * @brief Finds the faces that the cells of each chunk share with cells of another feature and
+ * stores them as sorted runs, so no state is shared between the chunks. Optionally writes the
+ * number of such faces of every cell into the boundary cells array.
+ */
+class FindFaceRunsImpl
+{
+public:
+  FindFaceRunsImpl(const ConstDataView<int32>& featureIds, const SizeVec3& dims, AbstractDataStore<int8>* boundaryCells, usize numChunks, std::vector<FaceRuns>& chunkRuns,
+                   const std::atomic_bool& shouldCancel)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_BoundaryCells(boundaryCells)
+  , m_NumChunks(numChunks)
+  , m_ChunkRuns(chunkRuns)
+  , m_ShouldCancel(shouldCancel)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    // Each range reads through its own view
+    const ConstDataView<int32> featureIds = m_FeatureIds;
+    for(usize chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      findRuns(featureIds, chunk);
+    }
+  }
+
+private:
+  void findRuns(const ConstDataView<int32>& featureIds, usize chunk) const
+  {
+    const usize sliceSize = m_Dims[0] * m_Dims[1];
+    const usize numCells = sliceSize * m_Dims[2];
+    const usize begin = numCells * chunk / m_NumChunks;
+    const usize end = numCells * (chunk + 1) / m_NumChunks;
+    const nonstd::span<int8> boundaryValues = m_BoundaryCells != nullptr ? m_BoundaryCells->contiguousSpan() : nonstd::span<int8>();
+
+    std::vector<uint64> faces;
+    usize column = begin % m_Dims[0];
+    usize row = (begin / m_Dims[0]) % m_Dims[1];
+    usize plane = begin / sliceSize;
+    for(usize cell = begin; cell < end; cell++)
+    {
+      if(cell % k_MinCellsPerChunk == 0 && m_ShouldCancel)
+      {
+        return;
+      }
+      const int32 feature = featureIds[cell];
+      int8 numBoundaryFaces = 0;
+      if(feature > 0)
+      {
+        auto addFace = [&](usize neighborCell) {
+          const int32 neighbor = featureIds[neighborCell];
+          if(neighbor != feature && neighbor > 0)
+          {
+            faces.push_back(MakeFaceKey(feature, neighbor));
+            numBoundaryFaces++;
+          }
+        };
+        if(plane != 0)
+        {
+          addFace(cell - sliceSize);
+        }
+        if(row != 0)
+        {
+          addFace(cell - m_Dims[0]);
+        }
+        if(column != 0)
+        {
+          addFace(cell - 1);
+        }
+        if(column != m_Dims[0] - 1)
+        {
+          addFace(cell + 1);
+        }
+        if(row != m_Dims[1] - 1)
+        {
+          addFace(cell + m_Dims[0]);
+        }
+        if(plane != m_Dims[2] - 1)
+        {
+          addFace(cell + sliceSize);
+        }
+      }
+      if(!boundaryValues.empty())
+      {
+        boundaryValues[cell] = numBoundaryFaces;
+      }
+      else if(m_BoundaryCells != nullptr)
+      {
+        m_BoundaryCells->setValue(cell, numBoundaryFaces);
+      }
+
+      if(++column == m_Dims[0])
+      {
+        column = 0;
+        if(++row == m_Dims[1])
+        {
+          row = 0;
+          plane++;
+        }
+      }
+    }
+
+    std::sort(faces.begin(), faces.end());
+    FaceRuns& runs = m_ChunkRuns[chunk];
+    for(usize i = 0; i < faces.size();)
+    {
+      usize runEnd = i + 1;
+      while(runEnd < faces.size() && faces[runEnd] == faces[i])
+      {
+        runEnd++;
+      }
+      runs.keys.push_back(faces[i]);
+      runs.counts.push_back(static_cast<int32>(runEnd - i));
+      i = runEnd;
+    }
+  }
+
+  const ConstDataView<int32>& m_FeatureIds;
+  SizeVec3 m_Dims;
+  AbstractDataStore<int8>* m_BoundaryCells = nullptr;
+  usize m_NumChunks = 1;
+  std::vector<FaceRuns>& m_ChunkRuns;
+  const std::atomic_bool& m_ShouldCancel;
+};
+
+/**
+ * @brief Merges the face runs of all chunks for a range of features. Without output buffers
+ * it stores the number of distinct neighbors of feature i in listOffsets[i + 1]. Otherwise
+ * it writes the neighbors in increasing order together with their shared surface area,
+ * starting at listOffsets[i].
+ */
+class MergeFaceRunsImpl
+{
+public:
+  MergeFaceRunsImpl(const std::vector<FaceRuns>& chunkRuns, const FloatVec3& spacing, std::vector<usize>& listOffsets, int32* neighborValues, float32* surfaceAreaValues)
+  : m_ChunkRuns(chunkRuns)
+  , m_Spacing(spacing)
+  , m_ListOffsets(listOffsets)
+  , m_NeighborValues(neighborValues)
+  , m_SurfaceAreaValues(surfaceAreaValues)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    // Position of the first run of the current feature in every chunk
+    std::vector<usize> cursors(m_ChunkRuns.size());
+    for(usize chunk = 0; chunk < m_ChunkRuns.size(); chunk++)
+    {
+      const std::vector<uint64>& keys = m_ChunkRuns[chunk].keys;
+      cursors[chunk] = std::lower_bound(keys.begin(), keys.end(), MakeFaceKey(static_cast<int32>(range.min()), 0)) - keys.begin();
+    }
+
+    std::vector<std::pair<int32, int32>> neighborCounts;
+    for(usize feature = range.min(); feature < range.max(); feature++)
+    {
+      neighborCounts.clear();
+      for(usize chunk = 0; chunk < m_ChunkRuns.size(); chunk++)
+      {
+        const FaceRuns& runs = m_ChunkRuns[chunk];
+        usize& cursor = cursors[chunk];
+        for(; cursor < runs.keys.size() && FaceKeyFeature(runs.keys[cursor]) == static_cast<int32>(feature); cursor++)
+        {
+          neighborCounts.emplace_back(FaceKeyNeighbor(runs.keys[cursor]), runs.counts[cursor]);
+        }
+      }
+
+      // Runs of the same neighbor found by different chunks are combined
+      std::sort(neighborCounts.begin(), neighborCounts.end());
+      usize numNeighbors = 0;
+      for(usize i = 0; i < neighborCounts.size(); i++)
+      {
+        if(numNeighbors != 0 && neighborCounts[numNeighbors - 1].first == neighborCounts[i].first)
+        {
+          neighborCounts[numNeighbors - 1].second += neighborCounts[i].second;
+          continue;
+        }
+        neighborCounts[numNeighbors++] = neighborCounts[i];
+      }
+
+      if(m_NeighborValues == nullptr)
+      {
+        m_ListOffsets[feature + 1] = numNeighbors;
+        continue;
+      }
+      const usize offset = m_ListOffsets[feature];
+      for(usize i = 0; i < numNeighbors; i++)
+      {
+        m_NeighborValues[offset + i] = neighborCounts[i].first;
+        m_SurfaceAreaValues[offset + i] = static_cast<float32>(neighborCounts[i].second) * m_Spacing[0] * m_Spacing[1];
+      }
+    }
+  }
+
+private:
+  const std::vector<FaceRuns>& m_ChunkRuns;
+  FloatVec3 m_Spacing;
+  std::vector<usize>& m_ListOffsets;
+  int32* m_NeighborValues = nullptr;
+  float32* m_SurfaceAreaValues = nullptr;
+};
+} // namespace
+
 std::string FindNeighbors::name() const
 {
   return FilterTraits<FindNeighbors>::name;
@@ -176,228 +451,84 @@ Result<> FindNeighbors::executeImpl(DataStructure& data, const Arguments& args,
   auto* boundaryCellsArray = data.getDataAs<Int8Array>(boundaryCellsPath);
   auto* surfaceFeaturesArray = data.getDataAs<BoolArray>(surfaceFeaturesPath);
 
-  auto& featureIds = featureIdsArray.getDataStoreRef();
+  const ConstDataView<int32> featureIds(std::as_const(featureIdsArray).getDataStoreRef());
   auto& numNeighbors = numNeighborsArray.getDataStoreRef();
 
   usize totalPoints = featureIdsArray.getNumberOfTuples();
   usize totalFeatures = numNeighborsArray.getNumberOfTuples();
 
   /* Ensure that we will be able to work with the user selected featureId Array */
-  const auto [minFeatureId, maxFeatureId] = std::minmax_element(featureIdsArray.begin(), featureIdsArray.end());
-  if(static_cast<usize>(*maxFeatureId) >= totalFeatures)
+  // Negative feature ids mark unassigned cells and never index the feature arrays
+  int32 maxFeatureId = 0;
+  for(usize i = 0; i < featureIds.size(); i++)
+  {
+    maxFeatureId = std::max(maxFeatureId, featureIds[i]);
+  }
+  if(static_cast<usize>(maxFeatureId) >= totalFeatures)
   {
     std::stringstream out;
-    out << "Data Array " << featureIdsArray.getName() << " has a maximum value of " << *maxFeatureId << " which is greater than the "
+    out << "Data Array " << featureIdsArray.getName() << " has a maximum value of " << maxFeatureId << " which is greater than the "
         << " number of features from array " << numNeighborsArray.getName() << " which has " << totalFeatures << ". Did you select the "
         << " incorrect array for the 'FeatureIds' array?";
     return MakeErrorResult(-24500, out.str());
   }
 
   auto& imageGeom = data.getDataRefAs<ImageGeom>(imageGeomPath);
-  SizeVec3 udims = imageGeom.getDimensions();
-  const auto imageGeomNumX = imageGeom.getNumXCells();
-  const auto imageGeomNumY = imageGeom.getNumYCells();
-  const auto imageGeomNumZ = imageGeom.getNumZCells();
-
-  std::array<int64, 3> dims = {
-      static_cast<int64>(udims[0]),
-      static_cast<int64>(udims[1]),
-      static_cast<int64>(udims[2]),
-  };
-
-  std::array<int64, 6> neighPoints = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
-
-  int64 column = 0;
-  int64 row = 0;
-  int64 plane = 0;
-  int32 feature = 0;
-  int32 nnum = 0;
-  uint8 onsurf = 0;
-  bool good = false;
-  int64 neighbor = 0;
-
-  std::vector<std::vector<int32>> neighborlist(totalFeatures);
-  std::vector<std::vector<float>> neighborsurfacearealist(totalFeatures);
-
-  int32 nListSize = 100;
+  const SizeVec3 dims = imageGeom.getDimensions();
+  const FloatVec3 spacing = imageGeom.getSpacing();
 
-  float progInt = 0.0F;
-  auto start = std::chrono::steady_clock::now();
-  // Initialize the neighbor lists
-  for(usize i = 1; i < totalFeatures; i++)
+  if(storeSurfaceFeatures)
   {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(i) / static_cast<float>(totalFeatures) * 100.0f;
-      std::string message = fmt::format("Initializing Neighbor Lists || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32_t>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
-
-    if(shouldCancel)
+    auto& surfaceFeatures = surfaceFeaturesArray->getDataStoreRef();
+    for(usize i = 1; i < totalFeatures; i++)
     {
-      return {};
-    }
-
-    numNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
-    if(storeSurfaceFeatures)
-    {
-      auto& surfaceFeatures = surfaceFeaturesArray->getDataStoreRef();
-      surfaceFeatures[i] = 0;
+      surfaceFeatures[i] = false;
     }
+    markSurfaceFeatures(featureIds, dims, surfaceFeatures);
   }
 
-  progInt = 0.0F;
-  start = std::chrono::steady_clock::now();
-  // Loop over all points to generate the neighbor lists
-  for(usize j = 0; j < totalPoints; j++)
+  const usize numThreads = static_cast<usize>(ParallelScheduler::GetCoreBudget());
+  const usize numChunks = std::clamp<usize>(totalPoints / k_MinCellsPerChunk, 1, numThreads);
+
+  // Every chunk of cells collects the faces it shares with other features as sorted
+  // (feature, neighbor) runs together with the number of faces in each run
+  messageHandler({IFilter::Message::Type::Info, "Determining Neighbor Lists"});
+  AbstractDataStore<int8>* boundaryCells = storeBoundaryCells ? &boundaryCellsArray->getDataStoreRef() : nullptr;
+  std::vector<FaceRuns> chunkRuns(numChunks);
+  ParallelDataAlgorithm chunkAlg;
+  chunkAlg.setRange(0, numChunks);
+  // Stores that are not held in memory are only written from the calling thread
+  chunkAlg.setParallelizationEnabled(boundaryCells == nullptr || boundaryCells->isContiguous());
+  chunkAlg.execute(FindFaceRunsImpl(featureIds, dims, boundaryCells, numChunks, chunkRuns, shouldCancel));
+  if(shouldCancel)
   {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(j) / static_cast<float>(totalPoints) * 100.0f;
-      std::string message = fmt::format("Determining Neighbor Lists || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32_t>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
-
-    if(shouldCancel)
-    {
-      return {};
-    }
-
-    onsurf = 0;
-    feature = featureIds[j];
-    if(feature > 0 && feature < neighborlist.size())
-    {
-      column = static_cast<int64>(j % imageGeomNumX);
-      row = static_cast<int64>((j / imageGeomNumX) % imageGeomNumY);
-      plane = static_cast<int64>(j / (imageGeomNumX * imageGeomNumY));
-      if(storeSurfaceFeatures)
-      {
-        auto& surfaceFeatures = surfaceFeaturesArray->getDataStoreRef();
-
-        if((column == 0 || column == static_cast<int64>((imageGeomNumX - 1)) || row == 0 || row == static_cast<int64>((imageGeomNumY)-1) || plane == 0 ||
-            plane == static_cast<int64>((imageGeomNumZ - 1))) &&
-           imageGeomNumZ != 1)
-        {
-          surfaceFeatures[feature] = 1;
-        }
-        if((column == 0 || column == static_cast<int64>((imageGeomNumX - 1)) || row == 0 || row == static_cast<int64>((imageGeomNumY - 1))) && imageGeomNumZ == 1)
-        {
-          surfaceFeatures[feature] = 1;
-        }
-      }
-      for(size_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64>(j + neighPoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (imageGeomNumZ - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (imageGeomNumY - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (imageGeomNumX - 1))
-        {
-          good = false;
-        }
-        if(good && featureIds[neighbor] != feature && featureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = numNeighbors[feature];
-          neighborlist[feature].push_back(featureIds[neighbor]);
-          nnum++;
-          numNeighbors[feature] = nnum;
-        }
-      }
-    }
-    if(storeBoundaryCells)
-    {
-      auto& boundaryCells = boundaryCellsArray->getDataStoreRef();
-      boundaryCells[j] = static_cast<int32>(onsurf);
-    }
+    return {};
   }
 
-  FloatVec3 spacing = imageGeom.getSpacing();
-
-  progInt = 0;
-  start = std::chrono::steady_clock::now();
-  // We do this to create new set of NeighborList objects
+  // Merge the runs of all chunks per feature. The first pass only counts the distinct
+  // neighbors so both lists can be written straight into their compressed layout.
+  messageHandler({IFilter::Message::Type::Info, "Calculating Surface Areas"});
+  std::vector<usize> listOffsets(totalFeatures + 1, 0);
+  ParallelDataAlgorithm featureAlg;
+  featureAlg.setRange(1, totalFeatures);
+  featureAlg.execute(MergeFaceRunsImpl(chunkRuns, spacing, listOffsets, nullptr, nullptr));
+  if(shouldCancel)
+  {
+    return {};
+  }
   for(usize i = 1; i < totalFeatures; i++)
   {
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      progInt = static_cast<float>(i) / static_cast<float>(totalFeatures) * 100.0f;
-      std::string message = fmt::format("Calculating Surface Areas || {:2.0f}% Complete", progInt);
-      messageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, static_cast<int32>(progInt)});
-      start = std::chrono::steady_clock::now();
-    }
-    if(shouldCancel)
-    {
-      return {};
-    }
-
-    std::map<int32, int32> neighToCount;
-    auto numneighs = static_cast<int32>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32 j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    std::map<int32, int32>::iterator neighborIter = neighToCount.find(0);
-    neighToCount.erase(neighborIter);
-    neighborIter = neighToCount.find(-1);
-    if(neighborIter != neighToCount.end())
-    {
-      neighToCount.erase(neighborIter);
-    }
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for(const auto [neigh, number] : neighToCount)
-    {
-      float area = static_cast<float>(number) * spacing[0] * spacing[1];
-
-      // Push the neighbor feature id back onto the list, so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
-    }
-    numNeighbors[i] = static_cast<int32>(neighborlist[i].size());
+    numNeighbors[i] = static_cast<int32>(listOffsets[i + 1]);
+    listOffsets[i + 1] += listOffsets[i];
+  }
 
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<int32>::SharedVectorType sharedNeiLst(new std::vector<int32>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
-    neighborList.setList(static_cast<int32>(i), sharedNeiLst);
+  std::vector<int32> neighborValues(listOffsets[totalFeatures]);
+  std::vector<float32> surfaceAreaValues(listOffsets[totalFeatures]);
+  featureAlg.execute(MergeFaceRunsImpl(chunkRuns, spacing, listOffsets, neighborValues.data(), surfaceAreaValues.data()));
 
-    NeighborList<float32>::SharedVectorType sharedSAL(new std::vector<float32>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
-    sharedSurfaceAreaList.setList(static_cast<int32>(i), sharedSAL);
-  }
+  // Feature 0 keeps an empty list
+  neighborList.setCompressedLists(std::vector<usize>(listOffsets), std::move(neighborValues));
+  sharedSurfaceAreaList.setCompressedLists(std::move(listOffsets), std::move(surfaceAreaValues));
 
   return {};
 }
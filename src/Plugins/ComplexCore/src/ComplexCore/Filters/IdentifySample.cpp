@@ -5,6 +5,7 @@
 #include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
+#include "complex/Utilities/DataArrayUtilities.hpp"
 
 namespace complex
 {
@@ -12,20 +13,16 @@ namespace
 {
 constexpr int64 k_MISSING_GEOM_ERR = -650;
 
-template <typename T>
-void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath& goodVoxelsArrayPath, bool fillHoles)
+/**
+ * @brief MaskT is the TypedMaskCompare<bool> or TypedMaskCompare<uint8> created by ExecuteMaskFunction(),
+ * so the flood fills below test and set the mask without a virtual call per voxel.
+ */
+template <class MaskT>
+void _execute(MaskT& goodVoxels, const ImageGeom& imageGeom, bool fillHoles)
 {
-  using ArrayType = DataArray<T>;
+  int64 totalPoints = static_cast<int64>(goodVoxels.size());
 
-  auto* imageGeom = data.getDataAs<ImageGeom>(imageGeomPath);
-
-  std::vector<usize> cDims = {1};
-  auto* goodVoxelsPtr = data.getDataAs<ArrayType>(goodVoxelsArrayPath);
-  auto& goodVoxels = goodVoxelsPtr->getDataStoreRef();
-
-  int64 totalPoints = static_cast<int64>(goodVoxelsPtr->getNumberOfTuples());
-
-  SizeVec3 udims = imageGeom->getDimensions();
+  SizeVec3 udims = imageGeom.getDimensions();
 
   int64 dims[3] = {
       static_cast<int64>(udims[0]),
@@ -71,7 +68,7 @@ void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath
       }
     }
 
-    if(!checked[i] && goodVoxels.getValue(i))
+    if(!checked[i] && goodVoxels.isTrue(i))
     {
       currentvlist.push_back(i);
       count = 0;
@@ -109,7 +106,7 @@ void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath
           {
             good = 0;
           }
-          if(good == 1 && !checked[neighbor] && goodVoxels.getValue(neighbor))
+          if(good == 1 && !checked[neighbor] && goodVoxels.isTrue(neighbor))
           {
             currentvlist.push_back(neighbor);
             checked[neighbor] = true;
@@ -131,7 +128,7 @@ void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath
   }
   for(int64 i = 0; i < totalPoints; i++)
   {
-    if(!sample[i] && goodVoxels.getValue(i))
+    if(!sample[i] && goodVoxels.isTrue(i))
     {
       goodVoxels.setValue(i, false);
     }
@@ -159,7 +156,7 @@ void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath
         }
       }
 
-      if(!checked[i] && !goodVoxels.getValue(i))
+      if(!checked[i] && !goodVoxels.isTrue(i))
       {
         currentvlist.push_back(i);
         count = 0;
@@ -202,7 +199,7 @@ void _execute(DataStructure& data, const DataPath& imageGeomPath, const DataPath
             {
               good = 0;
             }
-            if(good == 1 && !checked[neighbor] && !goodVoxels.getValue(neighbor))
+            if(good == 1 && !checked[neighbor] && !goodVoxels.isTrue(neighbor))
             {
               currentvlist.push_back(neighbor);
               checked[neighbor] = true;
@@ -327,15 +324,14 @@ Result<> IdentifySample::executeImpl(DataStructure& data, const Arguments& args,
   auto* inputData = data.getDataAs<IDataArray>(goodVoxelsArrayPath);
   auto arrayType = getArrayType(inputData);
 
-  if(arrayType == 1)
-  {
-    _execute<bool>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles);
-  }
-  if(arrayType == 2)
+  if(arrayType < 0)
   {
-    _execute<uint8>(data, imageGeomPath, goodVoxelsArrayPath, fillHoles);
+    return MakeErrorResult(-12001, "The input data must be of type BOOL or UINT8");
   }
 
+  const auto& imageGeom = data.getDataRefAs<ImageGeom>(imageGeomPath);
+  ExecuteMaskFunction([&](auto& goodVoxels) { _execute(goodVoxels, imageGeom, fillHoles); }, *inputData);
+
   return {};
 }
 } // namespace complex
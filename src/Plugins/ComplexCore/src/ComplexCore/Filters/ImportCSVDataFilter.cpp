@@ -1,7 +1,5 @@
 #include "ImportCSVDataFilter.hpp"
 
-#include <fstream>
-
 #include "complex/Common/TypeTraits.hpp"
 #include "complex/Common/Types.hpp"
 #include "complex/Common/TypesUtility.hpp"
@@ -16,10 +14,18 @@
 #include "complex/Parameters/DataGroupSelectionParameter.hpp"
 #include "complex/Parameters/DynamicTableParameter.hpp"
 #include "complex/Parameters/ImportCSVDataParameter.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/Utilities/Parsing/Text/MemoryMappedFile.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
 #include "ComplexCore/utils/CSVDataParser.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <string_view>
+
 using namespace complex;
 
 using ParsersVector = std::vector<std::unique_ptr<AbstractDataParser>>;
@@ -214,12 +220,52 @@ Result<ParsersVector> createParsers(const DataTypeVector& dataTypes, const DataP
 }
 
 // -----------------------------------------------------------------------------
-Result<> parseLine(std::fstream& inStream, const ParsersVector& dataParsers, const CharVector& delimiters, bool consecutiveDelimiters, usize lineNumber, usize beginIndex)
+std::string_view trimmedView(std::string_view str)
 {
-  std::string line;
-  std::getline(inStream, line);
+  const usize back = str.find_last_not_of(StringUtilities::k_Whitespaces.view());
+  if(back == std::string_view::npos)
+  {
+    return {};
+  }
+  const usize front = str.find_first_not_of(StringUtilities::k_Whitespaces.view());
+  return str.substr(front, back - front + 1);
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Splits the line into tokens with the same rules as StringUtilities::split, but
+ * the tokens view the line instead of being copied. Empty tokens are always dropped and
+ * tokens that only contain whitespace are dropped when consecutive delimiters are merged.
+ */
+void splitLine(std::string_view line, std::string_view delimiters, bool consecutiveDelimiters, std::vector<std::string_view>& tokens)
+{
+  tokens.clear();
+  usize start = 0;
+  while(true)
+  {
+    const usize pos = line.find_first_of(delimiters, start);
+    const usize end = (pos == std::string_view::npos) ? line.size() : pos;
+    if(end != start)
+    {
+      std::string_view token = trimmedView(line.substr(start, end - start));
+      if(!token.empty() || !consecutiveDelimiters)
+      {
+        tokens.push_back(token);
+      }
+    }
+    if(pos == std::string_view::npos)
+    {
+      break;
+    }
+    start = pos + 1;
+  }
+}
 
-  StringVector tokens = StringUtilities::split(line, delimiters, consecutiveDelimiters);
+// -----------------------------------------------------------------------------
+Result<> parseLine(std::string_view line, const ParsersVector& dataParsers, std::string_view delimiters, bool consecutiveDelimiters, usize lineNumber, usize beginIndex,
+                   std::vector<std::string_view>& tokens)
+{
+  splitLine(line, delimiters, consecutiveDelimiters, tokens);
 
   if(dataParsers.size() != tokens.size())
   {
@@ -263,13 +309,157 @@ void notifyProgress(const IFilter::MessageHandler& messageHandler, usize lineNum
 }
 
 // -----------------------------------------------------------------------------
-void skipNumberOfLines(std::fstream& inStream, usize numberOfLines)
+/**
+ * @brief Returns the offset of the first character after the given number of lines.
+ */
+usize skipNumberOfLines(std::string_view contents, usize numberOfLines)
 {
-  for(usize i = 1; i < numberOfLines; i++)
+  usize offset = 0;
+  for(usize i = 1; i < numberOfLines && offset < contents.size(); i++)
   {
-    std::string line;
-    std::getline(inStream, line);
+    const usize pos = contents.find('\n', offset);
+    offset = (pos == std::string_view::npos) ? contents.size() : pos + 1;
   }
+  return offset;
+}
+
+/**
+ * @brief A byte range of the data section. It owns the lines that start right after a
+ * newline inside the range, plus the first line of the file for the first chunk.
+ */
+struct LineChunk
+{
+  usize begin = 0;
+  usize end = 0;
+  usize newlineCount = 0;
+  usize errorLine = std::numeric_limits<usize>::max();
+  Result<> error;
+};
+
+// The data section is split into chunks that are counted and parsed in parallel. Large
+// files use chunks of at most k_MaxChunkSize bytes so that progress is reported regularly.
+constexpr usize k_ChunksPerThread = 4;
+constexpr usize k_MinChunkSize = 64 * 1024;
+constexpr usize k_MaxChunkSize = 64 * 1024 * 1024;
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Parses numTuples lines of the data section into the arrays. The line boundaries
+ * are found by counting the newlines of every chunk in parallel, which gives each chunk the
+ * index of its first line. The chunks are then parsed in parallel straight from the mapped
+ * file. If several lines are invalid, the error of the first one is returned.
+ */
+Result<> importLines(std::string_view data, usize numTuples, const ParsersVector& dataParsers, const CharVector& delimiters, bool consecutiveDelimiters, usize beginIndex,
+                     const IFilter::MessageHandler& messageHandler, const std::atomic_bool& shouldCancel)
+{
+  const std::string_view delimiterView(delimiters.data(), delimiters.size());
+
+  const usize numThreads = static_cast<usize>(ParallelScheduler::GetCoreBudget());
+  const usize numChunks = std::max({usize{1}, data.size() / k_MaxChunkSize, std::min(numThreads * k_ChunksPerThread, data.size() / k_MinChunkSize)});
+  std::vector<LineChunk> chunks(numChunks);
+  for(usize i = 0; i < numChunks; i++)
+  {
+    chunks[i].begin = data.size() * i / numChunks;
+    chunks[i].end = data.size() * (i + 1) / numChunks;
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.execute([&](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      chunks[i].newlineCount = static_cast<usize>(std::count(data.begin() + chunks[i].begin, data.begin() + chunks[i].end, '\n'));
+    }
+  });
+
+  std::vector<usize> firstLines(numChunks, 0);
+  usize totalNewlines = 0;
+  for(usize i = 0; i < numChunks; i++)
+  {
+    firstLines[i] = totalNewlines + 1;
+    totalNewlines += chunks[i].newlineCount;
+  }
+  firstLines[0] = 0;
+
+  // Parsing through the parsers may only run in parallel when each one writes to its own memory
+  bool parallelParsing = true;
+  for(const auto& dataParser : dataParsers)
+  {
+    parallelParsing = parallelParsing && (dataParser == nullptr || dataParser->isContiguous());
+  }
+
+  std::mutex progressMutex;
+  usize linesParsed = 0;
+  float32 threshold = 0.0f;
+
+  dataAlg.setParallelizationEnabled(parallelParsing);
+  dataAlg.execute([&](const Range& range) {
+    std::vector<std::string_view> tokens;
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      LineChunk& chunk = chunks[i];
+      usize lineIndex = firstLines[i];
+      usize position = 0;
+      if(i > 0)
+      {
+        const usize newline = data.find('\n', chunk.begin);
+        if(newline >= chunk.end)
+        {
+          continue;
+        }
+        position = newline + 1;
+      }
+
+      const usize chunkFirstLine = lineIndex;
+      while(lineIndex < numTuples)
+      {
+        if(shouldCancel)
+        {
+          return;
+        }
+        const usize newline = data.find('\n', position);
+        const usize lineEnd = (newline == std::string_view::npos) ? data.size() : newline;
+        Result<> result = parseLine(data.substr(position, lineEnd - position), dataParsers, delimiterView, consecutiveDelimiters, beginIndex + lineIndex, beginIndex, tokens);
+        if(result.invalid())
+        {
+          chunk.errorLine = lineIndex;
+          chunk.error = std::move(result);
+          break;
+        }
+        lineIndex++;
+        if(newline == std::string_view::npos || newline >= chunk.end)
+        {
+          break;
+        }
+        position = newline + 1;
+      }
+
+      std::lock_guard<std::mutex> lock(progressMutex);
+      linesParsed += lineIndex - chunkFirstLine;
+      notifyProgress(messageHandler, linesParsed, numTuples, threshold);
+    }
+  });
+
+  if(shouldCancel)
+  {
+    return {};
+  }
+
+  auto firstError = std::min_element(chunks.begin(), chunks.end(), [](const LineChunk& lhs, const LineChunk& rhs) { return lhs.errorLine < rhs.errorLine; });
+  if(firstError->error.invalid())
+  {
+    return std::move(firstError->error);
+  }
+
+  // Lines past the end of the file are parsed as empty lines, like reading past the end of a stream
+  const usize availableLines = totalNewlines + 1;
+  if(availableLines < numTuples)
+  {
+    std::vector<std::string_view> tokens;
+    return parseLine({}, dataParsers, delimiterView, consecutiveDelimiters, beginIndex + availableLines, beginIndex, tokens);
+  }
+
+  return {};
 }
 } // namespace
 
@@ -461,33 +651,27 @@ Result<> ImportCSVDataFilter::executeImpl(DataStructure& dataStructure, const Ar
 
   ParsersVector dataParsers = std::move(parsersResult.value());
 
-  std::fstream in(inputFilePath.c_str(), std::ios_base::in);
-  if(!in.is_open())
+  MemoryMappedFile inputFile(inputFilePath);
+  if(!inputFile.isOpen())
   {
     return MakeErrorResult(to_underlying(IssueCodes::FILE_NOT_OPEN), fmt::format("Could not open file for reading: {}", inputFilePath));
   }
 
   // Skip to the first data line
-  skipNumberOfLines(in, beginIndex);
+  const std::string_view contents = inputFile.view();
+  const std::string_view data = contents.substr(skipNumberOfLines(contents, beginIndex));
 
-  float32 threshold = 0.0f;
+  const auto startTime = std::chrono::steady_clock::now();
   usize numTuples = numLines - beginIndex + 1;
-  for(usize lineNum = beginIndex; lineNum <= numLines; lineNum++)
+  Result<> importResult = importLines(data, numTuples, dataParsers, delimiters, consecutiveDelimiters, beginIndex, messageHandler, shouldCancel);
+  if(importResult.invalid() || shouldCancel)
   {
-    if(shouldCancel)
-    {
-      return {};
-    }
-
-    Result<> parsingResult = parseLine(in, dataParsers, delimiters, consecutiveDelimiters, lineNum, beginIndex);
-    if(parsingResult.invalid())
-    {
-      return std::move(parsingResult);
-    }
-
-    notifyProgress(messageHandler, lineNum, numTuples, threshold);
+    return importResult;
   }
 
+  const float64 seconds = std::chrono::duration<float64>(std::chrono::steady_clock::now() - startTime).count();
+  messageHandler({IFilter::Message::Type::Info, fmt::format("Imported {} rows in {:.2f} seconds ({:.0f} rows/sec)", numTuples, seconds, static_cast<float64>(numTuples) / std::max(seconds, 1.0e-9))});
+
   return {};
 }
 } // namespace complex
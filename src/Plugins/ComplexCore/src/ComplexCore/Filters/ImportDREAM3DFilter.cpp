@@ -5,8 +5,10 @@
 #include "complex/Common/StringLiteral.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Filter/Actions/ImportH5ObjectPathsAction.hpp"
+#include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/Dream3dImportParameter.hpp"
 #include "complex/Parameters/StringParameter.hpp"
+#include "complex/Parameters/VectorParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
@@ -17,6 +19,7 @@ constexpr complex::StringLiteral k_ImportedPipeline = "Imported Pipeline";
 constexpr complex::int32 k_NoImportPathError = -1;
 constexpr complex::int32 k_FailedOpenFileReaderError = -25;
 constexpr complex::int32 k_NoSelectedPaths = -26;
+constexpr complex::int32 k_InvalidVoxelBounds = -27;
 } // namespace
 
 namespace complex
@@ -47,6 +50,18 @@ Parameters ImportDREAM3DFilter::parameters() const
 
   params.insertSeparator(Parameters::Separator{"Input Parameters"});
   params.insert(std::make_unique<Dream3dImportParameter>(k_ImportFileData, "Import File Path", "The HDF5 file path the DataStructure should be imported from.", Dream3dImportParameter::ImportData()));
+  params.insert(std::make_unique<BoolParameter>(k_LoadOnDemand, "Load Arrays On Demand",
+                                                "Whether array values are read from the file the first time they are used instead of during the import. Arrays that are never used are never read.",
+                                                true));
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(
+      k_CropImageGeometries, "Crop Image Geometries",
+      "Whether every imported image geometry is cropped to the voxel bounds below. Only the cropped block of each cell array is read from the file.", false));
+  params.insert(std::make_unique<VectorUInt64Parameter>(k_MinVoxel, "Min Voxel", "Lower bound of the sub-volume to import", std::vector<uint64>{0, 0, 0},
+                                                        std::vector<std::string>{"X (Column)", "Y (Row)", "Z (Plane)"}));
+  params.insert(std::make_unique<VectorUInt64Parameter>(k_MaxVoxel, "Max Voxel [Inclusive]", "Upper bound of the sub-volume to import", std::vector<uint64>{0, 0, 0},
+                                                        std::vector<std::string>{"X (Column)", "Y (Row)", "Z (Plane)"}));
+  params.linkParameters(k_CropImageGeometries, k_MinVoxel, true);
+  params.linkParameters(k_CropImageGeometries, k_MaxVoxel, true);
   return params;
 }
 
@@ -58,6 +73,7 @@ IFilter::UniquePointer ImportDREAM3DFilter::clone() const
 IFilter::PreflightResult ImportDREAM3DFilter::preflightImpl(const DataStructure& dataStructure, const Arguments& args, const MessageHandler& messageHandler, const std::atomic_bool& shouldCancel) const
 {
   auto importData = args.value<Dream3dImportParameter::ImportData>(k_ImportFileData);
+  auto loadOnDemand = args.value<bool>(k_LoadOnDemand);
   if(importData.FilePath.empty())
   {
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_NoImportPathError, "Import file path not provided."}})};
@@ -75,8 +91,20 @@ IFilter::PreflightResult ImportDREAM3DFilter::preflightImpl(const DataStructure&
     importData.DataPaths = std::nullopt;
   }
 
+  std::optional<DREAM3D::VoxelBounds> cropBounds;
+  if(args.value<bool>(k_CropImageGeometries))
+  {
+    auto minVoxel = args.value<std::vector<uint64>>(k_MinVoxel);
+    auto maxVoxel = args.value<std::vector<uint64>>(k_MaxVoxel);
+    if(minVoxel.size() != 3 || maxVoxel.size() != 3)
+    {
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_InvalidVoxelBounds, "The min and max voxels must each have an X, Y and Z value."}})};
+    }
+    cropBounds = DREAM3D::VoxelBounds{SizeVec3(minVoxel[0], minVoxel[1], minVoxel[2]), SizeVec3(maxVoxel[0], maxVoxel[1], maxVoxel[2])};
+  }
+
   OutputActions actions;
-  auto action = std::make_unique<ImportH5ObjectPathsAction>(importData.FilePath, importData.DataPaths);
+  auto action = std::make_unique<ImportH5ObjectPathsAction>(importData.FilePath, importData.DataPaths, loadOnDemand, cropBounds);
   actions.actions.push_back(std::move(action));
   return {std::move(actions)};
 }
@@ -28,6 +28,10 @@ public:
 
   // Parameter Keys
   static inline constexpr StringLiteral k_ImportFileData = "Import_File_Data";
+  static inline constexpr StringLiteral k_LoadOnDemand = "load_on_demand";
+  static inline constexpr StringLiteral k_CropImageGeometries = "crop_image_geometries";
+  static inline constexpr StringLiteral k_MinVoxel = "min_voxel";
+  static inline constexpr StringLiteral k_MaxVoxel = "max_voxel";
 
   /**
    * @brief Returns the name of the filter class.
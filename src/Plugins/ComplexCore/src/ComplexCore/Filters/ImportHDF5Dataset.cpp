@@ -11,6 +11,8 @@
 
 #include <nonstd/span.hpp>
 
+#include <numeric>
+
 using namespace complex;
 namespace fs = std::filesystem;
 
@@ -41,13 +43,84 @@ std::vector<size_t> createDimensionVector(const std::string& cDimsStr)
   return cDims;
 }
 
+// -----------------------------------------------------------------------------
+Result<> validateHyperslab(const ImportHDF5DatasetParameter::DatasetImportInfo& importInfo, const std::vector<hsize_t>& dims)
+{
+  const usize rank = dims.size();
+  const auto& offset = importInfo.hyperslabOffset;
+  const auto& count = importInfo.hyperslabCount;
+  const auto& stride = importInfo.hyperslabStride;
+  if(count.size() != rank || (!offset.empty() && offset.size() != rank) || (!stride.empty() && stride.size() != rank))
+  {
+    return MakeErrorResult(-20016, fmt::format("The hyperslab for dataset with path '{}' must have one offset, count and stride value for each of the dataset's {} dimension(s).",
+                                               importInfo.dataSetPath, rank));
+  }
+  for(usize i = 0; i < rank; i++)
+  {
+    const usize start = offset.empty() ? 0 : offset[i];
+    const usize step = stride.empty() ? 1 : stride[i];
+    if(count[i] == 0 || step == 0)
+    {
+      return MakeErrorResult(-20017, fmt::format("The hyperslab for dataset with path '{}' has a zero count or stride in dimension {}.", importInfo.dataSetPath, i));
+    }
+    if(start + (count[i] - 1) * step >= dims[i])
+    {
+      return MakeErrorResult(-20018, fmt::format("The hyperslab for dataset with path '{}' extends past the end of dimension {} (size {}).", importInfo.dataSetPath, i, dims[i]));
+    }
+  }
+  return {};
+}
+
 template <typename T>
-Result<> fillDataArray(DataStructure& dataStructure, const DataPath& dataArrayPath, const H5::DatasetReader& datasetReader)
+Result<> fillDataArray(DataStructure& dataStructure, const DataPath& dataArrayPath, const H5::DatasetReader& datasetReader, const ImportHDF5DatasetParameter::DatasetImportInfo& importInfo)
 {
   auto& dataArray = dataStructure.getDataRefAs<DataArray<T>>(dataArrayPath);
   auto& absDataStore = dataArray.getDataStoreRef();
-  auto& dataStore = dynamic_cast<DataStore<T>&>(absDataStore);
-  if(!datasetReader.readIntoSpan<T>(dataStore.createSpan()))
+
+  const std::vector<hsize_t> dims = datasetReader.getDimensions();
+  std::vector<hsize_t> offset(dims.size(), 0);
+  std::vector<hsize_t> count = dims;
+  std::vector<hsize_t> stride;
+  if(importInfo.hasHyperslab())
+  {
+    count.assign(importInfo.hyperslabCount.cbegin(), importInfo.hyperslabCount.cend());
+    if(!importInfo.hyperslabOffset.empty())
+    {
+      offset.assign(importInfo.hyperslabOffset.cbegin(), importInfo.hyperslabOffset.cend());
+    }
+    stride.assign(importInfo.hyperslabStride.cbegin(), importInfo.hyperslabStride.cend());
+  }
+
+  bool success = true;
+  if(auto* dataStore = dynamic_cast<DataStore<T>*>(&absDataStore); dataStore != nullptr)
+  {
+    success = importInfo.hasHyperslab() ? datasetReader.readIntoSpanHyperslab<T>(dataStore->createSpan(), offset, count, stride) : datasetReader.readIntoSpan<T>(dataStore->createSpan());
+  }
+  else if(!count.empty())
+  {
+    // Stores without a contiguous buffer (e.g. out-of-core) are filled one slab of the slowest dimension at a time
+    std::vector<hsize_t> slabOffset = offset;
+    std::vector<hsize_t> slabCount = count;
+    slabCount[0] = 1;
+    const usize slabSize = std::accumulate(slabCount.cbegin(), slabCount.cend(), static_cast<usize>(1), std::multiplies<>());
+    const hsize_t slabStep = stride.empty() ? 1 : stride[0];
+    auto buffer = std::make_unique<T[]>(slabSize);
+    for(hsize_t slab = 0; slab < count[0] && success; slab++)
+    {
+      slabOffset[0] = offset[0] + slab * slabStep;
+      success = datasetReader.readIntoSpanHyperslab<T>(nonstd::span<T>(buffer.get(), slabSize), slabOffset, slabCount, stride);
+      if(success)
+      {
+        absDataStore.copyFromBuffer(slab * slabSize, nonstd::span<const T>(buffer.get(), slabSize));
+      }
+    }
+  }
+  else
+  {
+    success = false;
+  }
+
+  if(!success)
   {
     return {MakeErrorResult(-21002, fmt::format("Error reading dataset '{}' with '{}' total elements into data store for data array '{}' with '{}' total elements ('{}' tuples and '{}' components)",
                                                 dataArrayPath.getTargetName(), datasetReader.getNumElements(), dataArrayPath.toString(), dataArray.getSize(), dataArray.getNumberOfTuples(),
@@ -177,6 +250,17 @@ IFilter::PreflightResult ImportHDF5Dataset::preflightImpl(const DataStructure& d
       return {nonstd::make_unexpected(std::vector<Error>{Error{-20008, fmt::format("Error reading dimensions from dataset with path '{}'", datasetPath)}})};
     }
 
+    if(datasetImportInfo.hasHyperslab())
+    {
+      Result<> hyperslabResult = validateHyperslab(datasetImportInfo, dims);
+      if(hyperslabResult.invalid())
+      {
+        return {nonstd::make_unexpected(std::move(hyperslabResult.errors()))};
+      }
+      // Only the hyperslab is imported so it defines the element count
+      dims.assign(datasetImportInfo.hyperslabCount.cbegin(), datasetImportInfo.hyperslabCount.cend());
+    }
+
     std::string cDimsStr = datasetImportInfo.componentDimensions;
     if(cDimsStr.empty())
     {
@@ -226,7 +310,7 @@ IFilter::PreflightResult ImportHDF5Dataset::preflightImpl(const DataStructure& d
 
     size_t hdf5TotalElements = 1;
     stream << "    No. of Dimension(s): " << StringUtilities::number(dims.size()) << "\n";
-    stream << "    Dimension Size(s): ";
+    stream << (datasetImportInfo.hasHyperslab() ? "    Hyperslab Size(s): " : "    Dimension Size(s): ");
     for(int i = 0; i < dims.size(); i++)
     {
       stream << StringUtilities::number(dims[i]);
@@ -343,43 +427,43 @@ Result<> ImportHDF5Dataset::executeImpl(DataStructure& dataStructure, const Argu
     switch(type)
     {
     case H5::Type::float32: {
-      fillArrayResults = fillDataArray<float32>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<float32>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::float64: {
-      fillArrayResults = fillDataArray<float64>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<float64>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::int8: {
-      fillArrayResults = fillDataArray<int8>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<int8>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::int16: {
-      fillArrayResults = fillDataArray<int16>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<int16>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::int32: {
-      fillArrayResults = fillDataArray<int32>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<int32>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::int64: {
-      fillArrayResults = fillDataArray<int64>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<int64>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::uint8: {
-      fillArrayResults = fillDataArray<uint8>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<uint8>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::uint16: {
-      fillArrayResults = fillDataArray<uint16>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<uint16>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::uint32: {
-      fillArrayResults = fillDataArray<uint32>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<uint32>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     case H5::Type::uint64: {
-      fillArrayResults = fillDataArray<uint64>(dataStructure, dataArrayPath, datasetReader);
+      fillArrayResults = fillDataArray<uint64>(dataStructure, dataArrayPath, datasetReader, datasetImportInfo);
       break;
     }
     default: {
@@ -1,6 +1,6 @@
 #include "InterpolatePointCloudToRegularGridFilter.hpp"
 
-#include <cmath>
+#include "ComplexCore/Filters/Algorithms/InterpolatePointCloudToRegularGrid.hpp"
 
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
@@ -27,161 +27,6 @@ namespace
 {
 constexpr int64 k_MissingVertexGeom = -24500;
 constexpr int64 k_MissingImageGeom = -24501;
-
-template <typename T>
-void mapPointCloudDataByKernel(IDataArray* source, INeighborList* dynamic, std::vector<float>& kernelVals, int64 kernel[3], usize dims[3], usize curX, usize curY, usize curZ, usize vertIdx)
-{
-  auto* inputDataArray = dynamic_cast<DataArray<T>*>(source);
-  auto& inputData = inputDataArray->getDataStoreRef();
-  auto* interpolatedDataPtr = dynamic_cast<NeighborList<T>*>(dynamic);
-
-  usize index = 0;
-  int64 startKernel[3] = {0, 0, 0};
-  int64 endKernel[3] = {0, 0, 0};
-  usize counter = 0;
-
-  kernel[0] > int64(curX) ? startKernel[0] = 0 : startKernel[0] = curX - kernel[0];
-  kernel[1] > int64(curY) ? startKernel[1] = 0 : startKernel[1] = curY - kernel[1];
-  kernel[2] > int64(curZ) ? startKernel[2] = 0 : startKernel[2] = curZ - kernel[2];
-
-  int64(curX) + kernel[0] >= int64(dims[0]) ? endKernel[0] = dims[0] - 1 : endKernel[0] = curX + kernel[0];
-  int64(curY) + kernel[1] >= int64(dims[1]) ? endKernel[1] = dims[1] - 1 : endKernel[1] = curY + kernel[1];
-  endKernel[2] = int64(curZ);
-
-  for(int64 z = startKernel[2]; z <= endKernel[2]; z++)
-  {
-    for(int64 y = startKernel[1]; y <= endKernel[1]; y++)
-    {
-      for(int64 x = startKernel[0]; x <= endKernel[0]; x++)
-      {
-        if(kernelVals[counter] == 0.0f)
-        {
-          continue;
-        }
-        index = (z * dims[1] * dims[0]) + (y * dims[0]) + x;
-        interpolatedDataPtr->addEntry(index, kernelVals[counter] * inputData[vertIdx]);
-        counter++;
-      }
-    }
-  }
-}
-
-void mapPointCloudDataByKernel(IDataArray* source, INeighborList* dynamic, std::vector<float>& kernelVals, int64 kernel[3], usize dims[3], usize curX, usize curY, usize curZ, usize vertIdx)
-{
-  // Because we are using INeighborList we CANNOT accept Boolean template parameters.
-  // We silently skip over the boolean types. Not really sure if this is a problem.
-
-  switch(source->getDataType())
-  {
-  case DataType::int8:
-    mapPointCloudDataByKernel<int8>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::int16:
-    mapPointCloudDataByKernel<int16>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::int32:
-    mapPointCloudDataByKernel<int32>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::int64:
-    mapPointCloudDataByKernel<int64>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::uint8:
-    mapPointCloudDataByKernel<uint8>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::uint16:
-    mapPointCloudDataByKernel<uint16>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::uint32:
-    mapPointCloudDataByKernel<uint32>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::uint64:
-    mapPointCloudDataByKernel<uint64>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::float32:
-    mapPointCloudDataByKernel<float32>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::float64:
-    mapPointCloudDataByKernel<float64>(source, dynamic, kernelVals, kernel, dims, curX, curY, curZ, vertIdx);
-    break;
-  case DataType::boolean:
-    break;
-  }
-}
-
-void determineKernel(uint64 interpolationTechnique, const FloatVec3& sigmas, std::vector<float32>& kernel, int64 kernelNumVoxels[3])
-{
-  usize counter = 0;
-
-  for(int64 z = -kernelNumVoxels[2]; z <= kernelNumVoxels[2]; z++)
-  {
-    for(int64 y = -kernelNumVoxels[1]; y <= kernelNumVoxels[1]; y++)
-    {
-      for(int64 x = -kernelNumVoxels[0]; x <= kernelNumVoxels[0]; x++)
-      {
-        if(interpolationTechnique == 0)
-        {
-          kernel[counter] = 1.0f;
-        }
-        else if(interpolationTechnique == 1)
-        {
-          kernel[counter] = static_cast<float32>(std::exp(-((x * x) / (2 * sigmas[0] * sigmas[0]) + (y * y) / (2 * sigmas[1] * sigmas[1]) + (z * z) / (2 * sigmas[2] * sigmas[2]))));
-        }
-        counter++;
-      }
-    }
-  }
-}
-
-void determineKernelDistances(std::vector<float32>& kernelValDistances, int64 kernelNumVoxels[3], FloatVec3 res)
-{
-  usize counter = 0;
-
-  for(int64 z = -kernelNumVoxels[2]; z <= kernelNumVoxels[2]; z++)
-  {
-    for(int64 y = -kernelNumVoxels[1]; y <= kernelNumVoxels[1]; y++)
-    {
-      for(int64 x = -kernelNumVoxels[0]; x <= kernelNumVoxels[0]; x++)
-      {
-        kernelValDistances[counter] = (x * x * res[0] * res[0]) + (y * y * res[1] * res[1]) + (z * z * res[2] * res[2]);
-        kernelValDistances[counter] = static_cast<float32>(std::sqrt(kernelValDistances[counter]));
-        counter++;
-      }
-    }
-  }
-}
-
-void mapKernelDistances(NeighborList<float32>* kernelDistances, std::vector<float32>& kernelValDistances, int64 kernel[3], usize dims[3], usize curX, usize curY, usize curZ)
-{
-  usize index = 0;
-  int64 startKernel[3] = {0, 0, 0};
-  int64 endKernel[3] = {0, 0, 0};
-  usize counter = 0;
-
-  kernel[0] > int64(curX) ? startKernel[0] = 0 : startKernel[0] = curX - kernel[0];
-  kernel[1] > int64(curY) ? startKernel[1] = 0 : startKernel[1] = curY - kernel[1];
-  kernel[2] > int64(curZ) ? startKernel[2] = 0 : startKernel[2] = curZ - kernel[2];
-
-  int64(curX) + kernel[0] >= int64(dims[0]) ? endKernel[0] = dims[0] - 1 : endKernel[0] = curX + kernel[0];
-  int64(curY) + kernel[1] >= int64(dims[1]) ? endKernel[1] = dims[1] - 1 : endKernel[1] = curY + kernel[1];
-  endKernel[2] = int64(curZ);
-
-  for(int64 z = startKernel[2]; z <= endKernel[2]; z++)
-  {
-    for(int64 y = startKernel[1]; y <= endKernel[1]; y++)
-    {
-      for(int64 x = startKernel[0]; x <= endKernel[0]; x++)
-      {
-        if(kernel[counter] == 0.0f)
-        {
-          continue;
-        }
-        index = (z * dims[1] * dims[0]) + (y * dims[0]) + x;
-        kernelDistances->addEntry(index, kernelValDistances[counter]);
-        counter++;
-      }
-    }
-  }
-}
 } // namespace
 
 std::string InterpolatePointCloudToRegularGridFilter::name() const
@@ -211,6 +56,9 @@ Parameters InterpolatePointCloudToRegularGridFilter::parameters() const
   params.insertSeparator(Parameters::Separator{"Input Parameters"});
   params.insertLinkableParameter(std::make_unique<BoolParameter>(k_UseMask_Key, "Use Mask", "Specifies whether or not to use a mask array", true));
   params.insert(std::make_unique<BoolParameter>(k_StoreKernelDistances_Key, "Store Kernel Distances", "Specifies whether or not to store kernel distances", true));
+  params.insert(std::make_unique<BoolParameter>(k_StoreNeighborLists_Key, "Store Neighbor Lists", "Specifies whether or not to store the list of weighted values of each voxel", true));
+  params.insert(std::make_unique<BoolParameter>(k_StoreWeightedAverages_Key, "Store Weighted Averages", "Specifies whether or not to store the weighted average of each voxel as a float array",
+                                                false));
   params.insert(std::make_unique<ChoicesParameter>(k_InterpolationTechnique_Key, "Interpolation Technique", "Selected Interpolation Technique", 0, std::vector<std::string>{"Uniform", "Gaussian"}));
   params.insert(std::make_unique<VectorFloat32Parameter>(k_KernelSize_Key, "Kernel Size", "Specifies the kernel size", std::vector<float32>{0, 0, 0}, std::vector<std::string>{"x", "y", "z"}));
   params.insert(
@@ -256,6 +104,8 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
 
   auto useMask = args.value<bool>(k_UseMask_Key);
   auto storeKernelDistances = args.value<bool>(k_StoreKernelDistances_Key);
+  auto storeNeighborLists = args.value<bool>(k_StoreNeighborLists_Key);
+  auto storeWeightedAverages = args.value<bool>(k_StoreWeightedAverages_Key);
 
   auto maskArrayPath = args.value<DataPath>(k_Mask_Key);
 
@@ -263,7 +113,6 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
   auto kernelSize = args.value<std::vector<float32>>(k_KernelSize_Key);
   auto sigmas = args.value<std::vector<float32>>(k_GaussianSigmas_Key);
 
-  std::vector<const IDataArray*> dataArrays;
   OutputActions actions;
 
   auto vertexGeom = data.getDataAs<VertexGeom>(vertexGeomPath);
@@ -280,9 +129,7 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_MissingImageGeom, ss}})};
   }
 
-  dataArrays.push_back(vertexGeom->getVertices());
-
-  if(interpolationTechnique < 0 || interpolationTechnique > 1)
+  if(interpolationTechnique > InterpolatePointCloudToRegularGrid::k_Gaussian)
   {
     std::string ss = fmt::format("Interpolation Technique must be 0 [Uniform] or 1 [Gaussian] ");
     return {nonstd::make_unexpected(std::vector<Error>{Error{-11000, ss}})};
@@ -291,7 +138,7 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
   if(kernelSize[0] < 0 || kernelSize[1] < 0 || kernelSize[2] < 0)
   {
     std::string ss = fmt::format("All kernel dimensions must be positive.\n "
-                                 "Current kernel dimensions:\n x = %1\n y = %2\n z = %3\n",
+                                 "Current kernel dimensions:\n x = {}\n y = {}\n z = {}\n",
                                  kernelSize[0], kernelSize[1], kernelSize[2]);
     return {nonstd::make_unexpected(std::vector<Error>{Error{-11000, ss}})};
   }
@@ -299,11 +146,23 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
   if(sigmas[0] <= 0 || sigmas[1] <= 0 || sigmas[2] <= 0)
   {
     std::string ss = fmt::format("All sigmas must be positive.\n "
-                                 "Current sigmas:\n x = %1\n y = %2\n z = %3\n",
+                                 "Current sigmas:\n x = {}\n y = {}\n z = {}\n",
                                  sigmas[0], sigmas[1], sigmas[2]);
     return {nonstd::make_unexpected(std::vector<Error>{Error{-11000, ss}})};
   }
 
+  if(data.getDataAs<USizeArray>(voxelIndicesPath) == nullptr)
+  {
+    std::string ss = fmt::format("Voxel Indices array cannot be found at '{}'", voxelIndicesPath.toString());
+    return {nonstd::make_unexpected(std::vector<Error>{Error{-11003, ss}})};
+  }
+
+  if(useMask && data.getDataAs<BoolArray>(maskArrayPath) == nullptr)
+  {
+    std::string ss = fmt::format("Mask array cannot be found at '{}'", maskArrayPath.toString());
+    return {nonstd::make_unexpected(std::vector<Error>{Error{-11004, ss}})};
+  }
+
   // Create Output Groups
   {
     auto createGroupAction = std::make_unique<CreateDataGroupAction>(interpolatedGroupPath);
@@ -314,252 +173,83 @@ IFilter::PreflightResult InterpolatePointCloudToRegularGridFilter::preflightImpl
     actions.actions.push_back(std::move(createGroupAction));
   }
 
-  // Get the list of all attribute matrices in the input data container and add them to the regular grid data container
-  // auto m = data.getDataAs<DataGroup>(dataGroupPath);
-  // auto interpolatedDC = data.getDataAs<DataGroup>(interpolatedDataPath);
-  // m_AttrMatList = m->getAttributeMatrixNames();
-  // SizeVec3 dims = image->getDimensions();
-  // std::vector<usize> tDims = {dims[0], dims[1], dims[2]};
-  // std::list<std::string> tempDataArrayList;
-  // DataPath tempPath;
-  // std::string tempAttrMatName;
-
-  // All vertex data in the original point cloud will be interpolated to the regular grid's cells
-  // Feature/Ensemble attribute matrices will remain unchanged and are deep copied to the new data container below
-  // Create the attribute matrix where all the interpolated data will be stored
-
-  // Loop through all the attribute matrices in the original data container
-  // If we are in a vertex attribute matrix, create data arrays for all in the new interpolated data attribute matrix
-  // Else, we are in a feature/ensemble attribute matrix, and just deep copy it into the new data container
-
-  const usize cDims = 1;
+  // Every interpolated or copied vertex array is copied into the interpolated group and gets a list of
+  // weighted values per voxel and/or the weighted average per voxel. Boolean values cannot be stored
+  // in a NeighborList.
+  SizeVec3 dims = image->getDimensions();
+  const std::vector<usize> imageTupleDims = {dims[2], dims[1], dims[0]};
+  const usize numVoxels = dims[0] * dims[1] * dims[2];
+  const std::vector<usize> cDims = {1};
 
-  for(const auto& interpolatePath : interpolatedDataPaths)
+  std::vector<DataPath> sourcePaths = interpolatedDataPaths;
+  sourcePaths.insert(sourcePaths.end(), copyDataPaths.begin(), copyDataPaths.end());
+  for(const auto& sourcePath : sourcePaths)
   {
-    auto targetArray = data.getDataAs<IDataArray>(interpolatePath);
-    auto targetPath = interpolatedGroupPath.createChildPath(targetArray->getName());
-    auto copyAction = std::make_unique<CopyArrayInstanceAction>(interpolatePath, targetPath);
-    actions.actions.push_back(std::move(copyAction));
-
-    dataArrays.push_back(targetArray);
-    auto tmpDims = targetArray->getNumberOfComponents();
-    if(tmpDims != 1)
+    auto targetArray = data.getDataAs<IDataArray>(sourcePath);
+    if(targetArray == nullptr)
     {
-      std::string ss = fmt::format("Attribute Arrays selected for copying must be scalar arrays");
-      return {nonstd::make_unexpected(std::vector<Error>{Error{-11002, ss}})};
+      std::string ss = fmt::format("Attribute Array cannot be found at '{}'", sourcePath.toString());
+      return {nonstd::make_unexpected(std::vector<Error>{Error{-11001, ss}})};
     }
-    auto dataType = targetArray->getDataType();
-    if(dataType != DataType::boolean)
+    if(targetArray->getNumberOfComponents() != 1)
     {
-      auto neighborPath = interpolatedGroupPath.createChildPath(targetArray->getName() + " Neighbors");
-      auto neighborAction = std::make_unique<CreateNeighborListAction>(dataType, targetArray->getNumberOfTuples(), neighborPath);
-      actions.actions.push_back(std::move(neighborAction));
+      std::string ss = fmt::format("Attribute Arrays selected for interpolating or copying must be scalar arrays");
+      return {nonstd::make_unexpected(std::vector<Error>{Error{-11002, ss}})};
     }
-  }
 
-  for(const auto& copyPath : copyDataPaths)
-  {
-    auto targetArray = data.getDataAs<IDataArray>(copyPath);
-    auto targetPath = interpolatedGroupPath.createChildPath(targetArray->getName());
-    auto copyAction = std::make_unique<CopyArrayInstanceAction>(copyPath, targetPath);
-    actions.actions.push_back(std::move(copyAction));
-
-    dataArrays.push_back(targetArray);
-    auto tmpDims = targetArray->getNumberOfComponents();
-    if(tmpDims != 1)
+    // The source values are kept under their own name in the interpolated group
     {
-      std::string ss = fmt::format("Attribute Arrays selected for copying must be scalar arrays");
-      return {nonstd::make_unexpected(std::vector<Error>{Error{-11002, ss}})};
+      auto copyAction = std::make_unique<CopyArrayInstanceAction>(sourcePath, interpolatedGroupPath.createChildPath(targetArray->getName()));
+      actions.actions.push_back(std::move(copyAction));
     }
-    auto dataType = targetArray->getDataType();
-    if(dataType != DataType::boolean)
+
+    if(storeWeightedAverages)
     {
-      auto neighborPath = interpolatedGroupPath.createChildPath(targetArray->getName() + " Neighbors");
-      auto neighborAction = std::make_unique<CreateNeighborListAction>(dataType, targetArray->getNumberOfTuples(), neighborPath);
-      actions.actions.push_back(std::move(neighborAction));
+      auto averagePath = interpolatedGroupPath.createChildPath(targetArray->getName() + std::string(InterpolatePointCloudToRegularGrid::k_WeightedAverageSuffix));
+      auto averageAction = std::make_unique<CreateArrayAction>(DataType::float32, imageTupleDims, cDims, averagePath);
+      actions.actions.push_back(std::move(averageAction));
     }
-  }
-
-  auto voxelIndicesPtr = data.getDataAs<USizeArray>(voxelIndicesPath);
-  if(nullptr != voxelIndicesPtr)
-  {
-    // voxelIndices = voxelIndicesPtr->getDataStore();
-    /* Now assign the raw pointer to data from the DataArray<T> object */
-    dataArrays.push_back(voxelIndicesPtr);
-  }
 
-  if(useMask)
-  {
-    auto maskPtr = data.getDataAs<BoolArray>(maskArrayPath);
-    if(nullptr != maskPtr)
+    auto dataType = targetArray->getDataType();
+    if(storeNeighborLists && dataType != DataType::boolean)
     {
-      // mask = maskPtr->getDataStore();
-      /* Now assign the raw pointer to data from the DataArray<T> object */
-      dataArrays.push_back(maskPtr);
+      auto neighborPath = interpolatedGroupPath.createChildPath(targetArray->getName() + std::string(InterpolatePointCloudToRegularGrid::k_NeighborListSuffix));
+      auto neighborAction = std::make_unique<CreateNeighborListAction>(dataType, numVoxels, neighborPath);
+      actions.actions.push_back(std::move(neighborAction));
     }
   }
 
   if(storeKernelDistances)
   {
-    auto kernelDistancesDataPath = kernelDistancesGroupPath.createChildPath("Neighbor List");
-    auto action = std::make_unique<CreateNeighborListAction>(DataType::float32, 0, kernelDistancesDataPath);
+    auto kernelDistancesDataPath = kernelDistancesGroupPath.createChildPath(InterpolatePointCloudToRegularGrid::k_KernelDistancesName);
+    auto action = std::make_unique<CreateNeighborListAction>(DataType::float32, numVoxels, kernelDistancesDataPath);
     actions.actions.push_back(std::move(action));
   }
 
-  // data.validateNumberOfTuples(dataArrays);
-
   return {std::move(actions)};
 }
 
 Result<> InterpolatePointCloudToRegularGridFilter::executeImpl(DataStructure& data, const Arguments& args, const PipelineFilter* pipelineNode, const MessageHandler& messageHandler,
                                                                const std::atomic_bool& shouldCancel) const
 {
-  auto vertexGeomPath = args.value<DataPath>(k_VertexGeom_Key);
-  auto imageGeomPath = args.value<DataPath>(k_ImageGeom_Key);
-  auto interpolatedDataPath = args.value<DataPath>(k_InterpolatedGroup_Key);
-  auto kernelDistancesDataPath = args.value<DataPath>(k_KernelDistancesGroup_Key);
-
-  auto interpolatedDataPaths = args.value<std::vector<DataPath>>(k_InterpolateArrays_Key);
-  auto copyDataPaths = args.value<std::vector<DataPath>>(k_CopyArrays_Key);
-
-  auto useMask = args.value<bool>(k_UseMask_Key);
-  auto storeKernelDistances = args.value<bool>(k_StoreKernelDistances_Key);
-  auto maskPath = args.value<DataPath>(k_Mask_Key);
-  auto voxelIndicesPath = args.value<DataPath>(k_VoxelIndices_Key);
-
-  auto interpolationTechnique = args.value<uint64>(k_InterpolationTechnique_Key);
-  auto kernelSize = args.value<std::vector<float32>>(k_KernelSize_Key);
-  auto sigmas = args.value<std::vector<float32>>(k_GaussianSigmas_Key);
-
-  auto interpolatedTechnique = args.value<uint64>(k_InterpolationTechnique_Key);
-
-  //
-  auto vertices = data.getDataAs<VertexGeom>(vertexGeomPath);
-  auto image = data.getDataAs<ImageGeom>(imageGeomPath);
-  SizeVec3 dims = image->getDimensions();
-  FloatVec3 res = image->getSpacing();
-  int64 kernelNumVoxels[3] = {0, 0, 0};
-
-  auto numVerts = vertices->getNumberOfVertices();
-  usize index = 0;
-  usize x = 0;
-  usize y = 0;
-  usize z = 0;
-
-  std::vector<float32> kernel;
-
-  auto maskArray = data.getDataAs<BoolArray>(maskPath);
-  auto mask = maskArray->getDataStore();
-
-  auto voxelIndicesArray = data.getDataAs<DataArray<usize>>(voxelIndicesPath);
-  auto voxelIndices = voxelIndicesArray->getDataStore();
-
-  usize maxImageIndex = ((dims[2] - 1) * dims[0] * dims[1]) + ((dims[1] - 1) * dims[0]) + (dims[0] - 1);
-
-  kernelNumVoxels[0] = int64(std::ceil((kernelSize[0] / res[0]) * 0.5f));
-  kernelNumVoxels[1] = int64(std::ceil((kernelSize[1] / res[1]) * 0.5f));
-  kernelNumVoxels[2] = int64(std::ceil((kernelSize[2] / res[2]) * 0.5f));
-
-  if(kernelSize[0] < res[0])
-  {
-    kernelNumVoxels[0] = 0;
-  }
-  if(kernelSize[1] < res[1])
-  {
-    kernelNumVoxels[1] = 0;
-  }
-  if(kernelSize[2] < res[2])
-  {
-    kernelNumVoxels[2] = 0;
-  }
-
-  int64 tmpKernelSize[3] = {1, 1, 1};
-  int64 totalKernel = 0;
-
-  for(usize i = 0; i < 3; i++)
-  {
-    tmpKernelSize[i] *= (kernelNumVoxels[i] * 2) + 1;
-  }
-
-  totalKernel = tmpKernelSize[0] * tmpKernelSize[1] * tmpKernelSize[2];
-
-  kernel.resize(totalKernel);
-  std::fill(kernel.begin(), kernel.end(), 0.0f);
-  determineKernel(interpolatedTechnique, sigmas, kernel, kernelNumVoxels);
-
-  std::vector<float> uniformKernel(totalKernel, 1.0f);
-
-  std::vector<float32> kernelValDistances;
-  if(storeKernelDistances)
-  {
-    kernelValDistances.resize(totalKernel);
-    std::fill(kernelValDistances.begin(), kernelValDistances.end(), 0.0f);
-    determineKernelDistances(kernelValDistances, kernelNumVoxels, res);
-  }
-
-  usize progIncrement = numVerts / 100;
-  usize prog = 1;
-  usize progressInt = 0;
-
-  for(usize i = 0; i < numVerts; i++)
-  {
-    if(useMask)
-    {
-      if(!mask->getValue(i))
-      {
-        continue;
-      }
-    }
-    index = voxelIndices->getValue(i);
-    if(index > maxImageIndex)
-    {
-      std::string ss = fmt::format("Index present in the selected Voxel Indices array that falls outside the selected Image Geometry for interpolation.\n Index = %1\n Max Image Index = %2\n", index,
-                                   maxImageIndex);
-      return {nonstd::make_unexpected(std::vector<Error>{Error{-1, ss}})};
-    }
-    x = index % dims[0];
-    y = (index / dims[0]) % dims[1];
-    z = index / (dims[0] * dims[1]);
-
-    if(!interpolatedDataPaths.empty())
-    {
-      for(const auto& interpolatedDataPathItem : interpolatedDataPaths)
-      {
-        auto parentPath = interpolatedDataPathItem.getParent();
-        auto dynamicArrayPath = parentPath.createChildPath(interpolatedDataPathItem.getTargetName() + "Neighbors");
-        auto* dynamicArrayToInterpolate = data.getDataAs<INeighborList>(dynamicArrayPath);
-        auto* interpolatedArray = data.getDataAs<IDataArray>(interpolatedDataPathItem);
-        mapPointCloudDataByKernel(interpolatedArray, dynamicArrayToInterpolate, kernel, kernelNumVoxels, dims.data(), x, y, z, i);
-      }
-    }
-
-    if(copyDataPaths.size() > 0)
-    {
-      for(const auto& copyDataPath : copyDataPaths)
-      {
-        auto dynamicArrayPath = interpolatedDataPath.createChildPath(copyDataPath.getTargetName() + " Neighbors");
-        auto* dynamicArrayToCopy = data.getDataAs<INeighborList>(dynamicArrayPath);
-        auto* copyArray = data.getDataAs<IDataArray>(copyDataPath);
-        mapPointCloudDataByKernel(copyArray, dynamicArrayToCopy, uniformKernel, kernelNumVoxels, dims.data(), x, y, z, i);
-      }
-    }
-
-    if(storeKernelDistances)
-    {
-      auto kernelDistancesNeighborsPath = kernelDistancesDataPath.createChildPath("Neighbor List");
-      auto kernelDistances = data.getDataAs<Float32NeighborList>(kernelDistancesNeighborsPath);
-      mapKernelDistances(kernelDistances, kernelValDistances, kernelNumVoxels, dims.data(), x, y, z);
-    }
-
-    if(i > prog)
-    {
-      progressInt = static_cast<int64>((static_cast<float>(i) / numVerts) * 100.0f);
-      std::string ss = fmt::format("Interpolating Point Cloud || {}% Completed", progressInt);
-      // notifyStatusMessage(ss);
-      prog = prog + progIncrement;
-    }
-  }
-
-  return {};
+  InterpolatePointCloudToRegularGridInputValues inputValues;
+
+  inputValues.VertexGeomPath = args.value<DataPath>(k_VertexGeom_Key);
+  inputValues.ImageGeomPath = args.value<DataPath>(k_ImageGeom_Key);
+  inputValues.VoxelIndicesPath = args.value<DataPath>(k_VoxelIndices_Key);
+  inputValues.UseMask = args.value<bool>(k_UseMask_Key);
+  inputValues.MaskPath = args.value<DataPath>(k_Mask_Key);
+  inputValues.InterpolationTechnique = args.value<uint64>(k_InterpolationTechnique_Key);
+  inputValues.KernelSize = args.value<std::vector<float32>>(k_KernelSize_Key);
+  inputValues.GaussianSigmas = args.value<std::vector<float32>>(k_GaussianSigmas_Key);
+  inputValues.InterpolateArrayPaths = args.value<std::vector<DataPath>>(k_InterpolateArrays_Key);
+  inputValues.CopyArrayPaths = args.value<std::vector<DataPath>>(k_CopyArrays_Key);
+  inputValues.InterpolatedGroupPath = args.value<DataPath>(k_InterpolatedGroup_Key);
+  inputValues.StoreNeighborLists = args.value<bool>(k_StoreNeighborLists_Key);
+  inputValues.StoreWeightedAverages = args.value<bool>(k_StoreWeightedAverages_Key);
+  inputValues.StoreKernelDistances = args.value<bool>(k_StoreKernelDistances_Key);
+  inputValues.KernelDistancesGroupPath = args.value<DataPath>(k_KernelDistancesGroup_Key);
+
+  return InterpolatePointCloudToRegularGrid(data, messageHandler, shouldCancel, &inputValues)();
 }
 } // namespace complex
@@ -10,7 +10,8 @@ namespace complex
 {
 /**
  * @class InterpolatePointCloudToRegularGridFilter
- * @brief
+ * @brief This filter interpolates the scalar arrays of a Vertex Geometry onto the cells of an
+ * Image Geometry, storing per voxel lists of the weighted values and/or their weighted averages.
  */
 class COMPLEXCORE_EXPORT InterpolatePointCloudToRegularGridFilter : public IFilter
 {
@@ -38,6 +39,8 @@ public:
   static inline constexpr StringLiteral k_CopyArrays_Key = "copy_arrays";
   static inline constexpr StringLiteral k_InterpolatedGroup_Key = "interpolated_group";
   static inline constexpr StringLiteral k_KernelDistancesGroup_Key = "kernel_distances_group";
+  static inline constexpr StringLiteral k_StoreNeighborLists_Key = "store_neighbor_lists";
+  static inline constexpr StringLiteral k_StoreWeightedAverages_Key = "store_weighted_averages";
 
   /**
    * @brief Returns the filter's name.
@@ -3,17 +3,26 @@
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
 
+#include "complex/Common/Constants.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
+#include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/DataPathSelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 #include "ComplexCore/utils/nanoflann.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+
 namespace complex
 {
 namespace
@@ -23,37 +32,30 @@ constexpr int32 k_MissingTargetVertex = -4501;
 constexpr int32 k_BadNumIterations = -4502;
 constexpr int32 k_MissingVertices = -4503;
 
-template <typename Derived>
-struct VertexGeomAdaptor
-{
-  const Derived& obj;
-  Float32Array* verts;
-  size_t m_NumComponents = 0;
-  size_t m_NumTuples = 0;
+constexpr int32 k_BadSampleFraction = -4504;
+constexpr int32 k_BadNormalsArray = -4505;
+constexpr int32 k_TooFewSamples = -4506;
 
-  VertexGeomAdaptor(const Derived& obj_)
-  : obj(obj_)
-  {
-    // These values never change for the life time of this object so cache them now.
-    verts = derived()->getVertices();
-    m_NumComponents = verts->getNumberOfComponents();
-    m_NumTuples = verts->getNumberOfTuples();
-  }
+constexpr usize k_NumPolarBins = 8;
+constexpr usize k_NumAzimuthBins = 16;
 
-  inline const Derived& derived() const
-  {
-    return obj;
-  }
+/**
+ * @brief Exposes an interleaved xyz point buffer to nanoflann. The points are read straight
+ * from memory so the queries of several threads can share one kd-tree.
+ */
+struct PointCloudAdaptor
+{
+  const float32* m_Points = nullptr;
+  usize m_NumPoints = 0;
 
   inline usize kdtree_get_point_count() const
   {
-    return m_NumTuples;
+    return m_NumPoints;
   }
 
   inline float kdtree_get_pt(const usize idx, const usize dim) const
   {
-    auto offset = idx * m_NumComponents;
-    return (*verts)[offset + dim];
+    return m_Points[idx * 3 + dim];
   }
 
   template <class BBOX>
@@ -62,6 +64,133 @@ struct VertexGeomAdaptor
     return false;
   }
 };
+
+using KDtree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Adaptor<float32, PointCloudAdaptor>, PointCloudAdaptor, 3>;
+
+/**
+ * @brief Returns a contiguous copy of the vertices unless the store already holds them contiguously.
+ */
+nonstd::span<const float32> GetContiguousPoints(const Float32Array& vertices, std::vector<float32>& copy)
+{
+  const auto& store = vertices.getDataStoreRef();
+  if(store.isContiguous())
+  {
+    return store.contiguousSpan();
+  }
+  copy.resize(store.getSize());
+  store.copyIntoBuffer(0, nonstd::span<float32>(copy));
+  return copy;
+}
+
+/**
+ * @brief Picks numSamples points so that the normals of the samples are spread as evenly as
+ * possible over the directions present in the moving geometry. The normals are binned by
+ * polar and azimuthal angle and the bins are drawn from in turn, each in random order.
+ */
+std::vector<usize> NormalSpaceSample(const AbstractDataStore<float32>& normals, usize numSamples, std::mt19937_64& generator)
+{
+  const usize numPoints = normals.getNumberOfTuples();
+  std::vector<std::vector<usize>> bins(k_NumPolarBins * k_NumAzimuthBins);
+  for(usize i = 0; i < numPoints; i++)
+  {
+    const float64 nx = normals[3 * i];
+    const float64 ny = normals[3 * i + 1];
+    const float64 nz = normals[3 * i + 2];
+    const float64 length = std::sqrt(nx * nx + ny * ny + nz * nz);
+    usize bin = 0;
+    if(length > 0.0)
+    {
+      const float64 polar = std::acos(std::clamp(nz / length, -1.0, 1.0)) / Constants::k_PiD;
+      const float64 azimuth = (std::atan2(ny, nx) + Constants::k_PiD) / (2.0 * Constants::k_PiD);
+      const usize polarBin = std::min(static_cast<usize>(polar * k_NumPolarBins), k_NumPolarBins - 1);
+      const usize azimuthBin = std::min(static_cast<usize>(azimuth * k_NumAzimuthBins), k_NumAzimuthBins - 1);
+      bin = polarBin * k_NumAzimuthBins + azimuthBin;
+    }
+    bins[bin].push_back(i);
+  }
+  for(auto& bin : bins)
+  {
+    std::shuffle(bin.begin(), bin.end(), generator);
+  }
+
+  std::vector<usize> samples;
+  samples.reserve(numSamples);
+  for(usize round = 0; samples.size() < numSamples; round++)
+  {
+    for(const auto& bin : bins)
+    {
+      if(round < bin.size() && samples.size() < numSamples)
+      {
+        samples.push_back(bin[round]);
+      }
+    }
+  }
+  // Keep the samples in memory order
+  std::sort(samples.begin(), samples.end());
+  return samples;
+}
+
+/**
+ * @brief Finds the closest target point of every moving point in the range. The closest
+ * point is written to the correspondence buffer and the squared distance to it is stored
+ * so the RMS error can be computed after the parallel pass.
+ */
+class FindCorrespondencesImpl
+{
+public:
+  FindCorrespondencesImpl(const KDtree& index, nonstd::span<const float32> targetPoints, const std::vector<float32>& movingPoints, std::vector<float32>& correspondences,
+                          std::vector<float32>& squaredDistances)
+  : m_Index(index)
+  , m_TargetPoints(targetPoints)
+  , m_MovingPoints(movingPoints)
+  , m_Correspondences(correspondences)
+  , m_SquaredDistances(squaredDistances)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize j = range.min(); j < range.max(); j++)
+    {
+      usize id = 0;
+      float32 dist = 0.0f;
+      nanoflann::KNNResultSet<float32> results(1);
+      results.init(&id, &dist);
+      m_Index.findNeighbors(results, m_MovingPoints.data() + (3 * j), nanoflann::SearchParams());
+      std::copy_n(m_TargetPoints.begin() + 3 * id, 3, m_Correspondences.begin() + 3 * j);
+      m_SquaredDistances[j] = dist;
+    }
+  }
+
+private:
+  const KDtree& m_Index;
+  nonstd::span<const float32> m_TargetPoints;
+  const std::vector<float32>& m_MovingPoints;
+  std::vector<float32>& m_Correspondences;
+  std::vector<float32>& m_SquaredDistances;
+};
+
+/**
+ * @brief Applies a 4x4 transform to every xyz point in the range of an interleaved buffer.
+ */
+template <class PointsT>
+void TransformPoints(PointsT& points, usize numPoints, const Eigen::Matrix4f& transform, bool parallel)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numPoints);
+  dataAlg.setParallelizationEnabled(parallel);
+  dataAlg.execute([&](const Range& range) {
+    for(usize j = range.min(); j < range.max(); j++)
+    {
+      const Eigen::Vector4f position(points[3 * j + 0], points[3 * j + 1], points[3 * j + 2], 1);
+      const Eigen::Vector4f transformedPosition = transform * position;
+      for(usize k = 0; k < 3; k++)
+      {
+        points[3 * j + k] = transformedPosition[k];
+      }
+    }
+  });
+}
 } // namespace
 
 std::string IterativeClosestPointFilter::name() const
@@ -90,14 +219,25 @@ Parameters IterativeClosestPointFilter::parameters() const
 
   params.insertSeparator(Parameters::Separator{"Input Parameters"});
   params.insert(std::make_unique<UInt64Parameter>(k_NumIterations_Key, "Number of Iterations", "Number of components", 1));
+  params.insert(std::make_unique<Float32Parameter>(k_RmsTolerance_Key, "RMS Change Tolerance",
+                                                   "Stop iterating once the RMS correspondence distance changes by less than this value between iterations (0 runs every iteration)", 0.0f));
   params.insert(std::make_unique<BoolParameter>(k_ApplyTransformation_Key, "Apply Transformation to Moving Geometry", "Number of components", false));
+  params.insertLinkableParameter(std::make_unique<ChoicesParameter>(k_SamplingMode_Key, "Moving Point Sampling", "Which moving points are matched against the target in every iteration",
+                                                                    k_AllPointsSampling, ChoicesParameter::Choices{"All Points", "Random", "Normal Space"}));
+  params.insert(std::make_unique<Float32Parameter>(k_SampleFraction_Key, "Sample Fraction", "Fraction of the moving points that are sampled (0 to 1]", 0.1f));
 
   params.insertSeparator(Parameters::Separator{"Required Data Objects"});
   params.insert(std::make_unique<DataPathSelectionParameter>(k_MovingVertexPath_Key, "Moving Vertex Geometry", "Numeric Type of data to create", DataPath()));
   params.insert(std::make_unique<DataPathSelectionParameter>(k_TargetVertexPath_Key, "Target Vertex Geometry", "Number of components", DataPath()));
+  params.insert(std::make_unique<ArraySelectionParameter>(k_MovingNormalsPath_Key, "Moving Vertex Normals", "Normal of every moving vertex, used to spread the samples over the normal directions",
+                                                          DataPath{}, ArraySelectionParameter::AllowedTypes{DataType::float32}, ArraySelectionParameter::AllowedComponentShapes{{3}}));
 
   params.insertSeparator(Parameters::Separator{"Created Data Objects"});
   params.insert(std::make_unique<ArrayCreationParameter>(k_TransformArrayPath_Key, "Output Transform Array", "Number of tuples", DataPath()));
+
+  params.linkParameters(k_SamplingMode_Key, k_SampleFraction_Key, std::make_any<ChoicesParameter::ValueType>(k_RandomSampling));
+  params.linkParameters(k_SamplingMode_Key, k_SampleFraction_Key, std::make_any<ChoicesParameter::ValueType>(k_NormalSpaceSampling));
+  params.linkParameters(k_SamplingMode_Key, k_MovingNormalsPath_Key, std::make_any<ChoicesParameter::ValueType>(k_NormalSpaceSampling));
   return params;
 }
 
@@ -131,6 +271,28 @@ IFilter::PreflightResult IterativeClosestPointFilter::preflightImpl(const DataSt
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadNumIterations, ss}})};
   }
 
+  auto samplingMode = args.value<ChoicesParameter::ValueType>(k_SamplingMode_Key);
+  if(samplingMode != k_AllPointsSampling)
+  {
+    auto sampleFraction = args.value<float32>(k_SampleFraction_Key);
+    if(!(sampleFraction > 0.0f && sampleFraction <= 1.0f))
+    {
+      auto ss = fmt::format("Sample Fraction must be greater than 0 and at most 1 but is {}", sampleFraction);
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadSampleFraction, ss}})};
+    }
+  }
+  if(samplingMode == k_NormalSpaceSampling)
+  {
+    auto movingNormalsPath = args.value<DataPath>(k_MovingNormalsPath_Key);
+    const auto* normals = data.getDataAs<Float32Array>(movingNormalsPath);
+    const usize numMovingVerts = data.getDataRefAs<VertexGeom>(movingVertexPath).getNumberOfVertices();
+    if(normals == nullptr || normals->getNumberOfTuples() != numMovingVerts)
+    {
+      auto ss = fmt::format("Normal space sampling requires a float32 normals array with one tuple per moving vertex ({}) at path: {}", numMovingVerts, movingNormalsPath.toString());
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadNormalsArray, ss}})};
+    }
+  }
+
   usize numTuples = 1;
   auto action = std::make_unique<CreateArrayAction>(DataType::float32, std::vector<usize>{numTuples}, std::vector<usize>{16}, transformArrayPath);
 
@@ -175,28 +337,64 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
   }
 
   auto* movingPtr = movingVertexGeom->getVertices();
-  Float32Array& targetPtr = *(targetVertexGeom->getVertices());
+  const usize numMovingVerts = movingVertexGeom->getNumberOfVertices();
 
-  auto* movingStore = movingPtr->getDataStore();
-  std::vector<float32> movingVector(movingStore->begin(), movingStore->end());
-  float32* movingCopyPtr = movingVector.data();
-  DataStructure tmp;
+  // Only the sampled moving points take part in the iterations
+  const auto samplingMode = args.value<ChoicesParameter::ValueType>(k_SamplingMode_Key);
+  std::vector<usize> sampleIds;
+  if(samplingMode == k_AllPointsSampling)
+  {
+    sampleIds.resize(numMovingVerts);
+    std::iota(sampleIds.begin(), sampleIds.end(), usize{0});
+  }
+  else
+  {
+    const auto sampleFraction = args.value<float32>(k_SampleFraction_Key);
+    const auto numSamples = std::min(numMovingVerts, static_cast<usize>(std::ceil(static_cast<float64>(sampleFraction) * static_cast<float64>(numMovingVerts))));
+    std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::mt19937_64 generator(seed);
+    if(samplingMode == k_NormalSpaceSampling)
+    {
+      const auto& normals = data.getDataRefAs<Float32Array>(args.value<DataPath>(k_MovingNormalsPath_Key));
+      sampleIds = NormalSpaceSample(normals.getDataStoreRef(), numSamples, generator);
+    }
+    else
+    {
+      std::vector<usize> allIds(numMovingVerts);
+      std::iota(allIds.begin(), allIds.end(), usize{0});
+      sampleIds.reserve(numSamples);
+      std::sample(allIds.begin(), allIds.end(), std::back_inserter(sampleIds), numSamples, generator);
+    }
+  }
+  const usize numSamples = sampleIds.size();
+  if(numSamples < 3)
+  {
+    auto ss = fmt::format("At least 3 moving points are required to estimate a transformation but only {} were sampled", numSamples);
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_TooFewSamples, ss}})};
+  }
 
-  usize numMovingVerts = movingVertexGeom->getNumberOfVertices();
-  std::vector<float32> dynTarget(numMovingVerts * 3, 0.0F);
-  float* dynTargetPtr = dynTarget.data();
+  std::vector<float32> movingPoints(numSamples * 3);
+  for(usize j = 0; j < numSamples; j++)
+  {
+    for(usize k = 0; k < 3; k++)
+    {
+      movingPoints[3 * j + k] = (*movingPtr)[3 * sampleIds[j] + k];
+    }
+  }
+  std::vector<float32> correspondences(numSamples * 3, 0.0F);
+  std::vector<float32> squaredDistances(numSamples, 0.0F);
 
-  using Adaptor = VertexGeomAdaptor<VertexGeom*>;
-  const Adaptor adaptor(targetVertexGeom);
+  std::vector<float32> targetCopy;
+  const nonstd::span<const float32> targetPoints = GetContiguousPoints(*(targetVertexGeom->getVertices()), targetCopy);
+  const PointCloudAdaptor adaptor{targetPoints.data(), targetPoints.size() / 3};
 
   messageHandler("Building kd-tree index...");
 
-  using KDtree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Adaptor<float32, Adaptor>, Adaptor, 3>;
+  // The kd-tree is built once and only queried afterwards, so the queries can run in parallel
   KDtree index(3, adaptor, nanoflann::KDTreeSingleIndexAdaptorParams(30));
   index.buildIndex();
 
-  usize iters = numIterations;
-  const usize nn = 1;
+  const float32 rmsTolerance = args.value<float32>(k_RmsTolerance_Key);
 
   typedef Eigen::Matrix<float, 3, Eigen::Dynamic, Eigen::ColMajor> PointCloud;
   typedef Eigen::Matrix<float, 4, 4, Eigen::ColMajor> UmeyamaTransform;
@@ -204,67 +402,47 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
   UmeyamaTransform globalTransform;
   globalTransform << 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1;
 
-  int64 progIncrement = iters / 100;
-  int64 prog = 1;
-  int64 progressInt = 0;
-  int64 counter = 0;
-
-  for(usize i = 0; i < iters; i++)
+  float64 previousRms = 0.0;
+  for(usize i = 0; i < numIterations; i++)
   {
     if(shouldCancel)
     {
       return {};
     }
+    const auto iterationStart = std::chrono::steady_clock::now();
 
-    for(usize j = 0; j < numMovingVerts; j++)
-    {
-      usize id;
-      float dist;
-      nanoflann::KNNResultSet<float> results(nn);
-      results.init(&id, &dist);
-      index.findNeighbors(results, movingCopyPtr + (3 * j), nanoflann::SearchParams());
-      dynTargetPtr[3 * j + 0] = targetPtr[3 * id + 0];
-      dynTargetPtr[3 * j + 1] = targetPtr[3 * id + 1];
-      dynTargetPtr[3 * j + 2] = targetPtr[3 * id + 2];
-    }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numSamples);
+    dataAlg.execute(FindCorrespondencesImpl(index, targetPoints, movingPoints, correspondences, squaredDistances));
+
+    const float64 rms = std::sqrt(std::accumulate(squaredDistances.begin(), squaredDistances.end(), 0.0) / static_cast<float64>(numSamples));
 
-    Eigen::Map<PointCloud> moving_(movingCopyPtr, 3, numMovingVerts);
-    Eigen::Map<PointCloud> target_(dynTargetPtr, 3, numMovingVerts);
+    Eigen::Map<PointCloud> moving_(movingPoints.data(), 3, numSamples);
+    Eigen::Map<PointCloud> target_(correspondences.data(), 3, numSamples);
 
     UmeyamaTransform transform = Eigen::umeyama(moving_, target_, false);
+    TransformPoints(movingPoints, numSamples, transform, true);
 
-    for(usize j = 0; j < numMovingVerts; j++)
-    {
-      Eigen::Vector4f position(movingCopyPtr[3 * j + 0], movingCopyPtr[3 * j + 1], movingCopyPtr[3 * j + 2], 1);
-      Eigen::Vector4f transformedPosition = transform * position;
-      std::memcpy(movingCopyPtr + (3 * j), transformedPosition.data(), sizeof(float) * 3);
-    }
     // Update the global transform
     globalTransform = transform * globalTransform;
 
-    if(counter > prog)
+    const auto iterationMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - iterationStart).count();
+    messageHandler(IFilter::Message::Type::Info, fmt::format("Iteration {} of {}: RMS error {:.6g} ({} ms)", i + 1, numIterations, rms, iterationMs));
+
+    if(rmsTolerance > 0.0f && i > 0 && std::abs(previousRms - rms) < rmsTolerance)
     {
-      progressInt = static_cast<int64>((static_cast<float>(counter) / iters) * 100.0f);
-      std::string ss = fmt::format("Performing Registration Iterations || {}% Completed", progressInt);
-      messageHandler(ss);
-      prog = prog + progIncrement;
+      messageHandler(IFilter::Message::Type::Info, fmt::format("RMS error changed by less than {} after {} iterations", rmsTolerance, i + 1));
+      break;
     }
-    counter++;
+    previousRms = rms;
   }
 
   auto* transformPtr = data.getDataAs<Float32Array>(transformArrayPath)->getDataStore();
 
   if(applyTransformation)
   {
-    for(usize j = 0; j < numMovingVerts; j++)
-    {
-      Eigen::Vector4f position((*movingPtr)[3 * j + 0], (*movingPtr)[3 * j + 1], (*movingPtr)[3 * j + 2], 1);
-      Eigen::Vector4f transformedPosition = globalTransform * position;
-      for(usize k = 0; k < 3; k++)
-      {
-        (*movingPtr)[3 * j + k] = transformedPosition.data()[k];
-      }
-    }
+    auto& movingStore = movingPtr->getDataStoreRef();
+    TransformPoints(movingStore, numMovingVerts, globalTransform, movingStore.isContiguous());
   }
 
   globalTransform.transposeInPlace();
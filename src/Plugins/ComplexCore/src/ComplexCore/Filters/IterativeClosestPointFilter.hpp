@@ -5,6 +5,7 @@
 #include "complex/Common/StringLiteral.hpp"
 #include "complex/Filter/FilterTraits.hpp"
 #include "complex/Filter/IFilter.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
 
 namespace complex
 {
@@ -26,6 +27,14 @@ public:
   static inline constexpr StringLiteral k_NumIterations_Key = "num_iterations";
   static inline constexpr StringLiteral k_ApplyTransformation_Key = "apply_transformation";
   static inline constexpr StringLiteral k_TransformArrayPath_Key = "transform_array";
+  static inline constexpr StringLiteral k_RmsTolerance_Key = "rms_tolerance";
+  static inline constexpr StringLiteral k_SamplingMode_Key = "sampling_mode";
+  static inline constexpr StringLiteral k_SampleFraction_Key = "sample_fraction";
+  static inline constexpr StringLiteral k_MovingNormalsPath_Key = "moving_normals";
+
+  static inline constexpr ChoicesParameter::ValueType k_AllPointsSampling = 0;
+  static inline constexpr ChoicesParameter::ValueType k_RandomSampling = 1;
+  static inline constexpr ChoicesParameter::ValueType k_NormalSpaceSampling = 2;
 
   /**
    * @brief
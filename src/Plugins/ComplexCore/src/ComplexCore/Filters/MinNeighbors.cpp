@@ -9,6 +9,7 @@
 #include "complex/Parameters/MultiArraySelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
+#include "complex/Utilities/TupleGatherMap.hpp"
 
 namespace complex
 {
@@ -17,7 +18,7 @@ namespace
 constexpr int64 k_TupleCountInvalidError = -250;
 constexpr int64 k_MissingFeaturePhasesError = -251;
 
-void assignBadPoints(DataStructure& data, const Arguments& args, const std::atomic_bool& shouldCancel)
+Result<> assignBadPoints(DataStructure& data, const Arguments& args, const std::atomic_bool& shouldCancel)
 {
   auto imageGeomPath = args.value<DataPath>(MinNeighbors::k_ImageGeom_Key);
   auto featureIdsPath = args.value<DataPath>(MinNeighbors::k_FeatureIds_Key);
@@ -79,7 +80,7 @@ void assignBadPoints(DataStructure& data, const Arguments& args, const std::atom
   {
     if(shouldCancel)
     {
-      return;
+      return {};
     }
     counter = 0;
     badFeatureIdIndexes.clear();
@@ -184,22 +185,30 @@ void assignBadPoints(DataStructure& data, const Arguments& args, const std::atom
       }
     }
 
-    // TODO This can be parallelized much like NeighborOrientationCorrelation
-    // Only iterate over the cell data with a featureId = -1;
+    // Only the cell data with a featureId = -1 takes the values of its chosen neighbor. The neighbors
+    // always belong to a feature, so no cell is both read and written and the arrays can be gathered in parallel.
+    std::vector<int64> sourceIndices(totalPoints, TupleGatherMap::k_KeepTuple);
     for(const auto& featureIdIndex : badFeatureIdIndexes)
     {
       featurename = featureIds[featureIdIndex];
       neighbor = neighbors[featureIdIndex];
       if(featurename < 0 && neighbor >= 0 && featureIds[neighbor] >= 0)
       {
-        for(const auto& cellArrayPath : cellDataArrayPaths)
-        {
-          auto* voxelArray = data.getDataAs<IDataArray>(cellArrayPath);
-          dynamic_cast<IDataArray*>(voxelArray)->copyTuple(neighbor, featureIdIndex);
-        }
+        sourceIndices[featureIdIndex] = neighbor;
       }
     }
+    Result<TupleGatherMap> gatherMapResult = TupleGatherMap::Create(sourceIndices);
+    if(gatherMapResult.invalid())
+    {
+      return ConvertResult(std::move(gatherMapResult));
+    }
+    Result<> gatherResult = gatherMapResult.value().applyInPlace(data, cellDataArrayPaths, shouldCancel);
+    if(gatherResult.invalid())
+    {
+      return gatherResult;
+    }
   }
+  return {};
 }
 
 nonstd::expected<std::vector<bool>, Error> mergeContainedFeatures(DataStructure& data, const Arguments& args, const std::atomic_bool& shouldCancel)
@@ -421,7 +430,11 @@ Result<> MinNeighbors::executeImpl(DataStructure& data, const Arguments& args, c
   }
 
   // Run the algorithm.
-  assignBadPoints(data, args, shouldCancel);
+  Result<> assignBadPointsResult = assignBadPoints(data, args, shouldCancel);
+  if(assignBadPointsResult.invalid())
+  {
+    return assignBadPointsResult;
+  }
 
   auto featureIdsPath = args.value<DataPath>(MinNeighbors::k_FeatureIds_Key);
   auto& featureIdsArray = data.getDataRefAs<Int32Array>(featureIdsPath);
@@ -5,328 +5,336 @@
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/ArrayThresholdsParameter.hpp"
 #include "complex/Utilities/ArrayThreshold.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace complex
 {
 namespace
 {
-constexpr StringLiteral k_ArrayThresholds_Key = "array_thresholds";
-constexpr StringLiteral k_CreatedDataPath_Key = "created_data_path";
-
 constexpr int64 k_PathNotFoundError = -178;
 
-class ThresholdFilterHelper
+// Tuples are thresholded in blocks of this many values. It is a multiple of the mask word size.
+constexpr usize k_BlockSize = 16384;
+
+using MaskWord = uint64;
+constexpr usize k_BitsPerWord = 64;
+constexpr usize k_WordsPerBlock = k_BlockSize / k_BitsPerWord;
+
+/**
+ * @brief The threshold tree resolved against the DataStructure. A node is either a
+ * comparison on one array or a set of child nodes that are combined in order.
+ */
+struct ThresholdNode
 {
-public:
-  ThresholdFilterHelper(complex::ArrayThreshold::ComparisonType compType, complex::ArrayThreshold::ComparisonValue compValue, std::vector<bool>& output)
-  : m_ComparisonOperator(compType)
-  , m_ComparisonValue(compValue)
-  , m_Output(output)
+  const IDataArray* dataArray = nullptr;
+  ArrayThreshold::ComparisonType comparisonType = ArrayThreshold::ComparisonType::GreaterThan;
+  ArrayThreshold::ComparisonValue comparisonValue = 0.0;
+  std::vector<ThresholdNode> children;
+  IArrayThreshold::UnionOperator unionOperator = IArrayThreshold::UnionOperator::And;
+  bool inverted = false;
+};
+
+struct IsContiguousFunctor
+{
+  template <typename T>
+  bool operator()(const IDataArray& dataArray)
   {
+    return dynamic_cast<const DataArray<T>&>(dataArray).getDataStoreRef().isContiguous();
   }
+};
 
-  ~ThresholdFilterHelper() = default;
+/**
+ * @brief Resolves the arrays of every threshold in the tree and checks the comparison operators.
+ * @param dataStructure
+ * @param threshold
+ * @param node
+ * @param allContiguous Set to false if any array cannot be read in place
+ * @return Result<>
+ */
+Result<> CreateThresholdNode(const DataStructure& dataStructure, const IArrayThreshold& threshold, ThresholdNode& node, bool& allContiguous)
+{
+  node.unionOperator = threshold.getUnionOperator();
+  node.inverted = threshold.isInverted();
 
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataLessThan(const DataArray<T>& m_Input)
+  if(const auto* thresholdSet = dynamic_cast<const ArrayThresholdSet*>(&threshold); thresholdSet != nullptr)
   {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
+    for(const std::shared_ptr<IArrayThreshold>& childThreshold : thresholdSet->getArrayThresholds())
     {
-      m_Output[i] = (m_Input[i] < value);
+      if(childThreshold == nullptr)
+      {
+        continue;
+      }
+      ThresholdNode child;
+      Result<> result = CreateThresholdNode(dataStructure, *childThreshold, child, allContiguous);
+      if(result.invalid())
+      {
+        return result;
+      }
+      // Empty sets do not constrain the mask
+      if(child.dataArray != nullptr || !child.children.empty())
+      {
+        node.children.push_back(std::move(child));
+      }
     }
+    return {};
   }
 
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataGreaterThan(const DataArray<T>& m_Input)
+  const auto& comparison = dynamic_cast<const ArrayThreshold&>(threshold);
+  node.comparisonType = comparison.getComparisonType();
+  node.comparisonValue = comparison.getComparisonValue();
+  switch(node.comparisonType)
   {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
-    {
-      m_Output[i] = (m_Input[i] > value);
-    }
+  case ArrayThreshold::ComparisonType::GreaterThan:
+  case ArrayThreshold::ComparisonType::LessThan:
+  case ArrayThreshold::ComparisonType::Operator_Equal:
+  case ArrayThreshold::ComparisonType::Operator_NotEqual:
+    break;
+  default:
+    return MakeErrorResult(-4002, fmt::format("MultiThresholdObjects Comparison Operator not understood: '{}'", static_cast<int>(node.comparisonType)));
   }
 
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataEqualTo(const DataArray<T>& m_Input)
+  node.dataArray = dataStructure.getDataAs<IDataArray>(comparison.getArrayPath());
+  if(node.dataArray == nullptr)
   {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
-    {
-      m_Output[i] = (m_Input[i] == value);
-    }
+    return MakeErrorResult(k_PathNotFoundError, fmt::format("Could not find DataArray at path {}.", comparison.getArrayPath().toString()));
   }
+  allContiguous = allContiguous && ExecuteDataFunction(IsContiguousFunctor{}, node.dataArray->getDataType(), *node.dataArray);
+  return {};
+}
 
-  /**
-   * @brief
-   */
-  template <typename T>
-  void filterDataNotEqualTo(const DataArray<T>& m_Input)
+/**
+ * @brief Sets bit i of the output words to comparison(values[i]). Packing 64 results into
+ * each word keeps the inner loop free of branches so the compiler can vectorize it.
+ * @param values
+ * @param words
+ * @param comparison
+ */
+template <typename T, class ComparisonT>
+void PackComparison(nonstd::span<const T> values, MaskWord* words, ComparisonT comparison)
+{
+  const usize numValues = values.size();
+  const usize numFullWords = numValues / k_BitsPerWord;
+  for(usize wordIndex = 0; wordIndex < numFullWords; wordIndex++)
   {
-    size_t m_NumValues = m_Input.getNumberOfTuples();
-    T value = static_cast<T>(m_ComparisonValue);
-    for(size_t i = 0; i < m_NumValues; ++i)
+    const T* wordValues = values.data() + wordIndex * k_BitsPerWord;
+    MaskWord word = 0;
+    for(usize bit = 0; bit < k_BitsPerWord; bit++)
     {
-      m_Output[i] = (m_Input[i] != value);
+      word |= static_cast<MaskWord>(comparison(wordValues[bit])) << bit;
     }
+    words[wordIndex] = word;
   }
 
-  template <typename Type>
-  void filterData(const DataArray<Type>& input)
+  const usize remaining = numValues - numFullWords * k_BitsPerWord;
+  if(remaining > 0)
   {
-    if(m_ComparisonOperator == ArrayThreshold::ComparisonType::LessThan)
+    const T* wordValues = values.data() + numFullWords * k_BitsPerWord;
+    MaskWord word = 0;
+    for(usize bit = 0; bit < remaining; bit++)
     {
-      filterDataLessThan<Type>(input);
-    }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::GreaterThan)
-    {
-      filterDataGreaterThan<Type>(input);
-    }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::Operator_Equal)
-    {
-      filterDataEqualTo<Type>(input);
-    }
-    else if(m_ComparisonOperator == ArrayThreshold::ComparisonType::Operator_NotEqual)
-    {
-      filterDataNotEqualTo<Type>(input);
-    }
-    else
-    {
-      std::string errorMessage = fmt::format("MultiThresholdObjects Comparison Operator not understood: '{}'", static_cast<int>(m_ComparisonOperator));
-      throw std::runtime_error(errorMessage);
+      word |= static_cast<MaskWord>(comparison(wordValues[bit])) << bit;
     }
+    words[numFullWords] = word;
   }
+}
 
-  /**
-   * @brief execute
-   * @param input
-   * @param output
-   * @return
-   */
-  void execute(DataStructure& dataStructure, DataPath& inputArrayDataPath)
+template <typename T>
+void CompareValues(nonstd::span<const T> values, ArrayThreshold::ComparisonType comparisonType, T value, MaskWord* words)
+{
+  switch(comparisonType)
   {
-    const auto& dataArray = dataStructure.getDataRefAs<IDataArray>(inputArrayDataPath);
-
-    DataType type = dataArray.getDataType();
+  case ArrayThreshold::ComparisonType::LessThan:
+    PackComparison(values, words, [value](T inputValue) { return inputValue < value; });
+    break;
+  case ArrayThreshold::ComparisonType::GreaterThan:
+    PackComparison(values, words, [value](T inputValue) { return inputValue > value; });
+    break;
+  case ArrayThreshold::ComparisonType::Operator_Equal:
+    PackComparison(values, words, [value](T inputValue) { return inputValue == value; });
+    break;
+  case ArrayThreshold::ComparisonType::Operator_NotEqual:
+    PackComparison(values, words, [value](T inputValue) { return inputValue != value; });
+    break;
+  }
+}
 
-    switch(type)
+/**
+ * @brief Compares one block of an array. Contiguous stores are compared in place, others
+ * are copied out first.
+ */
+struct CompareBlockFunctor
+{
+  template <typename T>
+  void operator()(const IDataArray& dataArray, const ThresholdNode& node, usize start, usize count, MaskWord* words)
+  {
+    const AbstractDataStore<T>& store = dynamic_cast<const DataArray<T>&>(dataArray).getDataStoreRef();
+    const T value = static_cast<T>(node.comparisonValue);
+    if(store.isContiguous())
     {
-    case DataType::int8: {
-      filterData<int8>(dynamic_cast<const DataArray<int8>&>(dataArray));
-      break;
-    }
-    case DataType::uint8: {
-      filterData<uint8>(dynamic_cast<const DataArray<uint8>&>(dataArray));
-      break;
-    }
-    case DataType::int16: {
-      filterData<int16>(dynamic_cast<const DataArray<int16>&>(dataArray));
-      break;
-    }
-    case DataType::uint16: {
-      filterData<uint16>(dynamic_cast<const DataArray<uint16>&>(dataArray));
-      break;
-    }
-    case DataType::int32: {
-      filterData<int32>(dynamic_cast<const DataArray<int32>&>(dataArray));
-      break;
-    }
-    case DataType::uint32: {
-      filterData<uint32>(dynamic_cast<const DataArray<uint32>&>(dataArray));
-      break;
-    }
-    case DataType::int64: {
-      filterData<int64>(dynamic_cast<const DataArray<int64>&>(dataArray));
-      break;
-    }
-    case DataType::uint64: {
-      filterData<uint64>(dynamic_cast<const DataArray<uint64>&>(dataArray));
-      break;
-    }
-    case DataType::float32: {
-      filterData<float32>(dynamic_cast<const DataArray<float32>&>(dataArray));
-      break;
-    }
-    case DataType::float64: {
-      filterData<float64>(dynamic_cast<const DataArray<float64>&>(dataArray));
-      break;
-    }
-    case DataType::boolean: {
-      filterData<bool>(dynamic_cast<const DataArray<bool>&>(dataArray));
-      break;
+      CompareValues<T>(store.contiguousSpan().subspan(start, count), node.comparisonType, value, words);
+      return;
     }
-    }
-  }
 
-private:
-  complex::ArrayThreshold::ComparisonType m_ComparisonOperator;
-  complex::ArrayThreshold::ComparisonValue m_ComparisonValue;
-  std::vector<bool>& m_Output;
-
-public:
-  ThresholdFilterHelper(const ThresholdFilterHelper&) = delete;            // Copy Constructor Not Implemented
-  ThresholdFilterHelper(ThresholdFilterHelper&&) = delete;                 // Move Constructor Not Implemented
-  ThresholdFilterHelper& operator=(const ThresholdFilterHelper&) = delete; // Copy Assignment Not Implemented
-  ThresholdFilterHelper& operator=(ThresholdFilterHelper&&) = delete;      // Move Assignment Not Implemented
+    auto buffer = std::make_unique<T[]>(count);
+    store.copyIntoBuffer(start, nonstd::span<T>(buffer.get(), count));
+    CompareValues<T>(nonstd::span<const T>(buffer.get(), count), node.comparisonType, value, words);
+  }
 };
 
 /**
- * @brief InsertThreshold
- * @param numItems
- * @param currentArrayPtr
- * @param unionOperator
- * @param newArrayPtr
- * @param inverse
+ * @brief Evaluates the threshold tree for one block of tuples at a time. Each level of the
+ * tree gets its own scratch words so nested sets never touch the full size mask.
  */
-void InsertThreshold(int64_t numItems, BoolArray& currentArray, complex::IArrayThreshold::UnionOperator unionOperator, std::vector<bool>& newArrayPtr, bool inverse)
+class ThresholdBlockEvaluator
 {
+public:
+  /**
+   * @brief Writes the mask bits of count tuples starting at start into words.
+   * @param node
+   * @param start
+   * @param count
+   * @param words
+   */
+  void evaluate(const ThresholdNode& node, usize start, usize count, MaskWord* words)
+  {
+    evaluate(node, 0, start, count, words);
+  }
 
-  for(int64_t i = 0; i < numItems; i++)
+private:
+  void evaluate(const ThresholdNode& node, usize depth, usize start, usize count, MaskWord* words)
   {
-    // invert the current comparison if necessary
-    if(inverse)
+    const usize numWords = (count + k_BitsPerWord - 1) / k_BitsPerWord;
+    if(node.dataArray != nullptr)
     {
-      newArrayPtr[i] = !newArrayPtr[i];
+      ExecuteDataFunction(CompareBlockFunctor{}, node.dataArray->getDataType(), *node.dataArray, node, start, count, words);
+      return;
     }
 
-    if(complex::IArrayThreshold::UnionOperator::Or == unionOperator)
+    if(m_Scratch.size() <= depth)
     {
-      currentArray[i] = currentArray[i] || newArrayPtr[i];
+      m_Scratch.resize(depth + 1, std::vector<MaskWord>(k_WordsPerBlock));
     }
-    else if(!currentArray[i] || !newArrayPtr[i])
+    for(usize childIndex = 0; childIndex < node.children.size(); childIndex++)
     {
-      currentArray[i] = false;
+      const ThresholdNode& child = node.children[childIndex];
+      // The first child replaces the words, the others are combined with their union operator
+      MaskWord* childWords = (childIndex == 0) ? words : m_Scratch[depth].data();
+      evaluate(child, depth + 1, start, count, childWords);
+      if(child.inverted)
+      {
+        for(usize i = 0; i < numWords; i++)
+        {
+          childWords[i] = ~childWords[i];
+        }
+      }
+      if(childIndex == 0)
+      {
+        continue;
+      }
+      if(child.unionOperator == IArrayThreshold::UnionOperator::Or)
+      {
+        for(usize i = 0; i < numWords; i++)
+        {
+          words[i] |= childWords[i];
+        }
+      }
+      else
+      {
+        for(usize i = 0; i < numWords; i++)
+        {
+          words[i] &= childWords[i];
+        }
+      }
     }
   }
-}
+
+  std::vector<std::vector<MaskWord>> m_Scratch;
+};
 
 /**
- * @brief thresholdValue
- * @param comparisonValue
- * @param dataStructure
- * @param outputResultArrayPath
- * @param err
- * @param replaceInput
- * @param inverse
+ * @brief Unpacks the mask bits of one block into the output array.
+ * @param words
+ * @param start
+ * @param count
+ * @param outputStore
  */
-void ThresholdValue(std::shared_ptr<ArrayThreshold>& comparisonValue, DataStructure& dataStructure, DataPath& outputResultArrayPath, int32_t& err, bool replaceInput, bool inverse)
+void WriteMaskBlock(const MaskWord* words, usize start, usize count, AbstractDataStore<bool>& outputStore)
 {
-  if(nullptr == comparisonValue)
-  {
-    err = -1;
-    return;
-  }
-  // Traditionally we would do a check to ensure we get a valid pointer, I'm forgoing that check because it
-  // was essentially done in the preflight part.
-  BoolArray& outputResultArray = dataStructure.getDataRefAs<BoolArray>(outputResultArrayPath);
-
-  // Get the total number of tuples, create and initialize an array with FALSE to use for these results
-  size_t totalTuples = outputResultArray.getNumberOfTuples();
-  std::vector<bool> tempResultVector(totalTuples, false);
-
-  complex::ArrayThreshold::ComparisonType compOperator = comparisonValue->getComparisonType();
-  complex::ArrayThreshold::ComparisonValue compValue = comparisonValue->getComparisonValue();
-  complex::IArrayThreshold::UnionOperator unionOperator = comparisonValue->getUnionOperator();
-
-  DataPath inputDataArrayPath = comparisonValue->getArrayPath();
-
-  ThresholdFilterHelper filter(compOperator, compValue, tempResultVector);
-
-  filter.execute(dataStructure, inputDataArrayPath);
-
-  if(replaceInput)
-  {
-    if(inverse)
-    {
-      tempResultVector.flip();
-    }
-    // copy the temp uint8 vector to the final uint8 result array
-    for(size_t i = 0; i < totalTuples; i++)
+  auto unpack = [words, count](bool* output) {
+    for(usize i = 0; i < count; i++)
     {
-      outputResultArray[i] = tempResultVector[i];
+      output[i] = ((words[i / k_BitsPerWord] >> (i % k_BitsPerWord)) & 1) != 0;
     }
-  }
-  else
-  {
-    // insert into current threshold
-    InsertThreshold(totalTuples, outputResultArray, unionOperator, tempResultVector, inverse);
-  }
-}
+  };
 
-void ThresholdSet(std::shared_ptr<ArrayThresholdSet>& inputComparisonSet, DataStructure& dataStructure, DataPath& outputResultArrayPath, int32_t& err, bool replaceInput, bool inverse)
-{
-  if(nullptr == inputComparisonSet)
+  if(outputStore.isContiguous())
   {
+    unpack(outputStore.contiguousSpan().data() + start);
     return;
   }
 
-  //  if(inverse)
-  //  {
-  //    inverse = !comparisonSet->getInvertComparison();
-  //  }
-  //  else
-  //  {
-  //    inverse = comparisonSet->getInvertComparison();
-  //  }
-
-  // Traditionally we would do a check to ensure we get a valid pointer, I'm forgoing that check because it
-  // was essentially done in the preflight part.
-  BoolArray& outputResultArray = dataStructure.getDataRefAs<BoolArray>(outputResultArrayPath);
-
-  // Get the total number of tuples, create and initialize an array with FALSE to use for these results
-  size_t totalTuples = outputResultArray.getNumberOfTuples();
-  std::vector<bool> tempResultVector(totalTuples, false);
-
-  bool firstValueFound = false;
+  auto buffer = std::make_unique<bool[]>(count);
+  unpack(buffer.get());
+  outputStore.copyFromBuffer(start, nonstd::span<const bool>(buffer.get(), count));
+}
 
-  ArrayThresholdSet::CollectionType thresholds = inputComparisonSet->getArrayThresholds();
-  for(const std::shared_ptr<IArrayThreshold>& threshold : thresholds)
+/**
+ * @brief Evaluates the whole threshold tree into the output mask. The tuples are processed
+ * in parallel blocks whenever every array involved can be accessed in place.
+ * @param dataStructure
+ * @param thresholds
+ * @param outputResultArrayPath
+ * @param shouldCancel
+ * @return Result<>
+ */
+Result<> ThresholdArrays(DataStructure& dataStructure, const ArrayThresholdSet& thresholds, const DataPath& outputResultArrayPath, const std::atomic_bool& shouldCancel)
+{
+  bool allContiguous = true;
+  ThresholdNode root;
+  Result<> result = CreateThresholdNode(dataStructure, thresholds, root, allContiguous);
+  if(result.invalid() || root.children.empty())
   {
-    if(std::dynamic_pointer_cast<ArrayThresholdSet>(threshold))
-    {
-      std::shared_ptr<ArrayThresholdSet> comparisonSet = std::dynamic_pointer_cast<ArrayThresholdSet>(threshold);
-      ThresholdSet(comparisonSet, dataStructure, outputResultArrayPath, err, !firstValueFound, false);
-      firstValueFound = true;
-    }
-    else if(std::dynamic_pointer_cast<ArrayThreshold>(threshold))
-    {
-      std::shared_ptr<ArrayThreshold> comparisonValue = std::dynamic_pointer_cast<ArrayThreshold>(threshold);
-      ThresholdValue(comparisonValue, dataStructure, outputResultArrayPath, err, !firstValueFound, false);
-      firstValueFound = true;
-    }
+    return result;
   }
 
-  if(replaceInput)
-  {
-    if(inverse)
-    {
-      tempResultVector.flip();
-    }
-    // copy the temp uint8 vector to the final uint8 result array
-    for(size_t i = 0; i < totalTuples; i++)
+  AbstractDataStore<bool>& outputStore = dataStructure.getDataRefAs<BoolArray>(outputResultArrayPath).getDataStoreRef();
+  allContiguous = allContiguous && outputStore.isContiguous();
+  const usize totalTuples = outputStore.getNumberOfTuples();
+  const usize numBlocks = (totalTuples + k_BlockSize - 1) / k_BlockSize;
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.setParallelizationEnabled(allContiguous);
+  dataAlg.execute([&](const Range& range) {
+    ThresholdBlockEvaluator evaluator;
+    std::vector<MaskWord> words(k_WordsPerBlock);
+    for(usize block = range.min(); block < range.max(); block++)
     {
-      outputResultArray[i] = tempResultVector[i];
-    }
-  }
-  else
-  {
-    // insert into current threshold
-    InsertThreshold(totalTuples, outputResultArray, inputComparisonSet->getUnionOperator(), tempResultVector, inverse);
-  }
-}
+      if(shouldCancel)
+      {
+        return;
+      }
+      const usize start = block * k_BlockSize;
+      const usize count = std::min(k_BlockSize, totalTuples - start);
+      evaluator.evaluate(root, start, count, words.data());
+      if(root.inverted)
+      {
+        for(auto& word : words)
+        {
+          word = ~word;
+        }
+      }
+      WriteMaskBlock(words.data(), start, count, outputStore);
+    }
+  });
 
+  return {};
+}
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -454,28 +462,6 @@ Result<> MultiThresholdObjects::executeImpl(DataStructure& dataStructure, const
   auto thresholdsObject = args.value<ArrayThresholdSet>(k_ArrayThresholds_Key);
   auto maskArrayPath = args.value<DataPath>(k_CreatedDataPath_Key);
 
-  bool firstValueFound = false;
-
-  int32_t err = 0;
-  ArrayThresholdSet::CollectionType thresholdSet = thresholdsObject.getArrayThresholds();
-  for(const std::shared_ptr<IArrayThreshold>& threshold : thresholdSet)
-  {
-    if(std::dynamic_pointer_cast<ArrayThresholdSet>(threshold))
-    {
-      std::shared_ptr<ArrayThresholdSet> comparisonSet = std::dynamic_pointer_cast<ArrayThresholdSet>(threshold);
-      ThresholdSet(comparisonSet, dataStructure, maskArrayPath, err, !firstValueFound, thresholdsObject.isInverted());
-      firstValueFound = true;
-    }
-    else if(std::dynamic_pointer_cast<ArrayThreshold>(threshold))
-    {
-      std::shared_ptr<ArrayThreshold> comparisonValue = std::dynamic_pointer_cast<ArrayThreshold>(threshold);
-      ThresholdValue(comparisonValue, dataStructure, maskArrayPath, err, !firstValueFound, thresholdsObject.isInverted());
-      firstValueFound = true;
-    }
-  }
-
-  // thresholdsObject.applyMaskValues(data, maskArrayPath);
-
-  return {};
+  return ThresholdArrays(dataStructure, thresholdsObject, maskArrayPath, shouldCancel);
 }
 } // namespace complex
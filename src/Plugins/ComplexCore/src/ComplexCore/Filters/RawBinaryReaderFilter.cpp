@@ -4,6 +4,7 @@
 #include "complex/DataStructure/DataPath.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
+#include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Parameters/DynamicTableParameter.hpp"
 #include "complex/Parameters/FileSystemPathParameter.hpp"
@@ -67,6 +68,8 @@ Parameters RawBinaryReaderFilter::parameters() const
   params.insert(std::make_unique<FileSystemPathParameter>(k_InputFile_Key, "Input File", "The input binary file path", fs::path(), FileSystemPathParameter::ExtensionsType{},
                                                           FileSystemPathParameter::PathType::InputFile));
   params.insert(std::make_unique<NumericTypeParameter>(k_ScalarType_Key, "Scalar Type", "Data type of the binary data", NumericType::int8));
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(k_ConvertScalarType_Key, "Convert Scalar Type", "Convert the values to the output scalar type while they are read", false));
+  params.insert(std::make_unique<NumericTypeParameter>(k_OutputScalarType_Key, "Output Scalar Type", "Data type of the created array", NumericType::float32));
 
   DynamicTableInfo tableInfo;
   tableInfo.setColsInfo(DynamicTableInfo::DynamicVectorInfo{1, "Value {}"});
@@ -76,9 +79,13 @@ Parameters RawBinaryReaderFilter::parameters() const
   params.insert(std::make_unique<UInt64Parameter>(k_NumberOfComponents_Key, "Number of Components", "The number of values at each tuple", 0));
   params.insert(std::make_unique<ChoicesParameter>(k_Endian_Key, "Endian", "The endianness of the data", 0, ChoicesParameter::Choices{"Little", "Big"}));
   params.insert(std::make_unique<UInt64Parameter>(k_SkipHeaderBytes_Key, "Skip Header Bytes", "Number of bytes to skip before reading data", 0));
+  params.insert(std::make_unique<ChoicesParameter>(k_ReadMode_Key, "Read Mode", "Read the file in double buffered blocks or through a memory mapping", k_StreamedReadMode,
+                                                   ChoicesParameter::Choices{"Streamed", "Memory Mapped"}));
   params.insert(std::make_unique<ArrayCreationParameter>(k_CreatedAttributeArrayPath_Key, "Output Attribute Array", "The complete path to the created Attribute Array",
                                                          DataPath(std::vector<std::string>{"Imported Array"})));
 
+  params.linkParameters(k_ConvertScalarType_Key, k_OutputScalarType_Key, true);
+
   return params;
 }
 
@@ -98,6 +105,8 @@ IFilter::PreflightResult RawBinaryReaderFilter::preflightImpl(const DataStructur
   auto pSkipHeaderBytesValue = filterArgs.value<uint64>(k_SkipHeaderBytes_Key);
   auto pCreatedAttributeArrayPathValue = filterArgs.value<DataPath>(k_CreatedAttributeArrayPath_Key);
   auto pTupleDimsValue = filterArgs.value<DynamicTableParameter::ValueType>(k_TupleDims_Key);
+  auto pConvertScalarTypeValue = filterArgs.value<bool>(k_ConvertScalarType_Key);
+  auto pOutputScalarTypeValue = filterArgs.value<NumericType>(k_OutputScalarType_Key);
 
   if(pNumberOfComponentsValue < 1)
   {
@@ -158,7 +167,8 @@ IFilter::PreflightResult RawBinaryReaderFilter::preflightImpl(const DataStructur
 
   // Create the CreateArray action and add it to the resultOutputActions object
   {
-    auto action = std::make_unique<CreateArrayAction>(ConvertNumericTypeToDataType(pScalarTypeValue), tupleDims, std::vector<usize>{pNumberOfComponentsValue}, pCreatedAttributeArrayPathValue);
+    const NumericType arrayType = pConvertScalarTypeValue ? pOutputScalarTypeValue : pScalarTypeValue;
+    auto action = std::make_unique<CreateArrayAction>(ConvertNumericTypeToDataType(arrayType), tupleDims, std::vector<usize>{pNumberOfComponentsValue}, pCreatedAttributeArrayPathValue);
 
     resultOutputActions.value().actions.push_back(std::move(action));
   }
@@ -178,6 +188,7 @@ Result<> RawBinaryReaderFilter::executeImpl(DataStructure& dataStructure, const
   inputValues.endianValue = filterArgs.value<ChoicesParameter::ValueType>(k_Endian_Key);
   inputValues.skipHeaderBytesValue = filterArgs.value<uint64>(k_SkipHeaderBytes_Key);
   inputValues.createdAttributeArrayPathValue = filterArgs.value<DataPath>(k_CreatedAttributeArrayPath_Key);
+  inputValues.readModeValue = filterArgs.value<ChoicesParameter::ValueType>(k_ReadMode_Key);
 
   // Let the Algorithm instance do the work
   return RawBinaryReader(dataStructure, inputValues, shouldCancel, messageHandler)();
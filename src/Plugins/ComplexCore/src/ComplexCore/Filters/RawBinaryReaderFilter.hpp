@@ -36,6 +36,9 @@ public:
   static inline constexpr StringLiteral k_Endian_Key = "endian";
   static inline constexpr StringLiteral k_SkipHeaderBytes_Key = "skip_header_bytes";
   static inline constexpr StringLiteral k_CreatedAttributeArrayPath_Key = "created_attribute_array_path";
+  static inline constexpr StringLiteral k_ConvertScalarType_Key = "convert_scalar_type";
+  static inline constexpr StringLiteral k_OutputScalarType_Key = "output_scalar_type";
+  static inline constexpr StringLiteral k_ReadMode_Key = "read_mode";
 
   /**
    * @brief Returns the name of the filter.
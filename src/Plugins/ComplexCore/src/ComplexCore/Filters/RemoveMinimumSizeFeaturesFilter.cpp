@@ -11,6 +11,7 @@
 #include "complex/Parameters/DataPathSelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
+#include "complex/Utilities/TupleGatherMap.hpp"
 
 namespace complex
 {
@@ -27,7 +28,7 @@ constexpr int32 k_ParentlessPathError = -5557;
 constexpr int32 k_NeighborListRemoval = -5558;
 constexpr int32 k_FetchChildArrayError = -5559;
 
-void assign_badpoints(DataStructure& dataStructure, const DataPath& featureIdsPath, SizeVec3 dimensions, const NumCellsArrayType& numCellsArrayRef)
+Result<> assign_badpoints(DataStructure& dataStructure, const DataPath& featureIdsPath, SizeVec3 dimensions, const NumCellsArrayType& numCellsArrayRef, const std::atomic_bool& shouldCancel)
 {
   FeatureIdsArrayType* featureIdsPtr = dataStructure.getDataAs<FeatureIdsArrayType>(featureIdsPath);
 
@@ -161,34 +162,35 @@ void assign_badpoints(DataStructure& dataStructure, const DataPath& featureIdsPa
     }
     DataPath attrMatPath = featureIdsPath.getParent();
     BaseGroup* parentGroup = dataStructure.getDataAs<BaseGroup>(attrMatPath);
-    std::vector<std::string> voxelArrayNames;
+    std::vector<DataPath> voxelArrayPaths;
     for(const auto& [id, sharedChild] : *parentGroup)
     {
       if(std::dynamic_pointer_cast<IDataArray>(sharedChild))
       {
-        voxelArrayNames.push_back(sharedChild->getName());
+        voxelArrayPaths.push_back(attrMatPath.createChildPath(sharedChild->getName()));
       }
     }
 
-    // TODO: This loop could be parallelized. Look at NeighborOrientationCorrelation filter
+    // Every bad voxel takes all of its cell values from the chosen neighbor. The neighbors always
+    // belong to a feature, so no voxel is both read and written and the arrays can be gathered in parallel.
+    std::vector<int64> sourceIndices(totalPoints, TupleGatherMap::k_KeepTuple);
     for(size_t j = 0; j < totalPoints; j++)
     {
       featurename = featureIds->getValue(j);
       neighbor = neighbors[j];
-      if(neighbor >= 0)
+      if(neighbor >= 0 && featurename < 0 && featureIds->getValue(neighbor) >= 0)
       {
-        if(featurename < 0 && featureIds->getValue(neighbor) >= 0)
-        {
-          for(auto& voxelArrayName : voxelArrayNames)
-          {
-            auto arrayPath = attrMatPath.createChildPath(voxelArrayName);
-            IDataArray* arr = dataStructure.getDataAs<IDataArray>(arrayPath);
-            arr->copyTuple(neighbor, j);
-          }
-        }
+        sourceIndices[j] = neighbor;
       }
     }
+    Result<TupleGatherMap> gatherMapResult = TupleGatherMap::Create(sourceIndices);
+    if(gatherMapResult.invalid())
+    {
+      return ConvertResult(std::move(gatherMapResult));
+    }
+    return gatherMapResult.value().applyInPlace(dataStructure, voxelArrayPaths, shouldCancel);
   }
+  return {};
 }
 
 // -----------------------------------------------------------------------------
@@ -441,7 +443,11 @@ Result<> RemoveMinimumSizeFeaturesFilter::executeImpl(DataStructure& dataStructu
   }
 
   ImageGeom& imageGeom = dataStructure.getDataRefAs<ImageGeom>(imageGeomPath);
-  assign_badpoints(dataStructure, featureIdsPath, imageGeom.getDimensions(), numCellsArrayRef);
+  Result<> assignBadPointsResult = assign_badpoints(dataStructure, featureIdsPath, imageGeom.getDimensions(), numCellsArrayRef, shouldCancel);
+  if(assignBadPointsResult.invalid())
+  {
+    return assignBadPointsResult;
+  }
 
   DataPath cellFeatureGroupPath = numCellsPath.getParent();
   size_t currentFeatureCount = numCellsStoreRef.getNumberOfTuples();
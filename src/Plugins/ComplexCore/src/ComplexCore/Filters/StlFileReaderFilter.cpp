@@ -121,26 +121,25 @@ IFilter::PreflightResult StlFileReaderFilter::preflightImpl(const DataStructure&
   // Collect all the errors
   std::vector<Error> errors;
 
-  // Validate that the STL File is binary and readable.
+  // Validate that the STL File is readable.
   int32_t stlFileType = StlUtilities::DetermineStlFileType(pStlFilePathValue);
   if(stlFileType < 0)
   {
-    Error result = {StlConstants::k_UnsupportedFileType,
-                    fmt::format("The Input STL File is ASCII which is not currently supported. Please convert it to a binary STL file using another program.", pStlFilePathValue.string())};
-    errors.push_back(result);
-  }
-  if(stlFileType > 0)
-  {
-    Error result = {StlConstants::k_ErrorOpeningFile, fmt::format("Error reading the STL file.", pStlFilePathValue.string())};
+    Error result = {StlConstants::k_ErrorOpeningFile, fmt::format("Error reading the STL file '{}'.", pStlFilePathValue.string())};
     errors.push_back(result);
   }
 
-  // Now get the number of Triangles according to the STL Header
-  int32_t numTriangles = StlUtilities::NumFacesFromHeader(pStlFilePathValue);
-  if(numTriangles < 0)
+  // Now get the number of Triangles according to the STL Header. ASCII files do not have
+  // a triangle count so the geometry is sized when the facets are read.
+  int32_t numTriangles = 0;
+  if(stlFileType == 0)
   {
-    Error result = {StlConstants::k_ErrorOpeningFile, fmt::format("Error reading the STL file.", pStlFilePathValue.string())};
-    errors.push_back(result);
+    numTriangles = StlUtilities::NumFacesFromHeader(pStlFilePathValue);
+    if(numTriangles < 0)
+    {
+      Error result = {StlConstants::k_ErrorOpeningFile, fmt::format("Error reading the STL file '{}'.", pStlFilePathValue.string())};
+      errors.push_back(result);
+    }
   }
 
   if(!errors.empty())
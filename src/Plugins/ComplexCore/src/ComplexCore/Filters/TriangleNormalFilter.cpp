@@ -171,6 +171,8 @@ Result<> TriangleNormalFilter::executeImpl(DataStructure& dataStructure, const A
   // Parallel algorithm to find duplicate nodes
   ParallelDataAlgorithm dataAlg;
   dataAlg.setRange(0ULL, static_cast<size_t>(triangleGeom.getNumberOfFaces()));
+  // Vertices are gathered by face index, so out-of-core arrays would be read element by element
+  dataAlg.requireArraysInMemory({triangleGeom.getVertices(), triangleGeom.getFaces(), &normals});
   dataAlg.execute(::CalculateNormalsImpl(*(triangleGeom.getVertices()), *(triangleGeom.getFaces()), normals));
 
   return {};
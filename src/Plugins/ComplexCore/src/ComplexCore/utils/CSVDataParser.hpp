@@ -29,12 +29,104 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include "complex/Common/Result.hpp"
 #include "complex/Common/Types.hpp"
+#include "complex/Common/TypesUtility.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 
+#include <fmt/core.h>
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if !defined(__cpp_lib_to_chars)
+#include <cerrno>
+#include <cstdlib>
+#endif
+
 using namespace complex;
 
+namespace CSVParsing
+{
+// These match the error codes of complex::ConvertTo<T>
+constexpr int32 k_InvalidArgumentError = -100;
+constexpr int32 k_OverflowError = -101;
+
+enum class ParseStatus
+{
+  Success,
+  InvalidArgument,
+  OutOfRange
+};
+
+/**
+ * @brief Parses a number from the start of the token without allocating. The rules match
+ * the std::stoll/std::stoull/std::stof/std::stod conversions used by complex::ConvertTo:
+ * a leading '+' is accepted, characters after the number are ignored and negative
+ * values are out of range for unsigned types.
+ * @param token
+ * @param value
+ * @return ParseStatus
+ */
+template <typename T>
+ParseStatus ParseNumber(std::string_view token, T& value)
+{
+  const char* first = token.data();
+  const char* last = first + token.size();
+  if(first != last && *first == '+' && (last - first == 1 || (first[1] != '-' && first[1] != '+')))
+  {
+    ++first;
+  }
+
+  if constexpr(std::is_unsigned_v<T>)
+  {
+    if(first != last && *first == '-')
+    {
+      return ParseStatus::OutOfRange;
+    }
+  }
+
+#if !defined(__cpp_lib_to_chars)
+  if constexpr(std::is_floating_point_v<T>)
+  {
+    // Floating point std::from_chars is not available, so parse a null terminated copy
+    const std::string buffer(first, last);
+    char* end = nullptr;
+    errno = 0;
+    if constexpr(std::is_same_v<T, float32>)
+    {
+      value = std::strtof(buffer.c_str(), &end);
+    }
+    else
+    {
+      value = std::strtod(buffer.c_str(), &end);
+    }
+    if(end == buffer.c_str())
+    {
+      return ParseStatus::InvalidArgument;
+    }
+    return errno == ERANGE ? ParseStatus::OutOfRange : ParseStatus::Success;
+  }
+  else
+#endif
+  {
+    const std::from_chars_result result = std::from_chars(first, last, value);
+    if(result.ec == std::errc::invalid_argument)
+    {
+      return ParseStatus::InvalidArgument;
+    }
+    if(result.ec == std::errc::result_out_of_range)
+    {
+      return ParseStatus::OutOfRange;
+    }
+    return ParseStatus::Success;
+  }
+}
+} // namespace CSVParsing
+
 class AbstractDataParser
 {
 public:
@@ -60,7 +152,20 @@ public:
     return m_DataArray;
   }
 
-  virtual Result<> parse(const std::string& token, size_t index) = 0;
+  /**
+   * @brief Returns true if the values are written straight into contiguous memory,
+   * which allows several threads to parse different tuples at the same time.
+   * @return bool
+   */
+  virtual bool isContiguous() const = 0;
+
+  /**
+   * @brief Parses the token and stores the value at the given tuple index.
+   * @param token
+   * @param index
+   * @return Result<>
+   */
+  virtual Result<> parse(std::string_view token, usize index) = 0;
 
 protected:
   AbstractDataParser(IDataArray& array, const std::string& columnName, usize columnIndex)
@@ -85,8 +190,12 @@ class CSVDataParser : public AbstractDataParser
 public:
   CSVDataParser(ArrayType& array, const std::string& name, usize index)
   : AbstractDataParser(array, name, index)
-  , m_Array(array)
+  , m_Store(array.getDataStoreRef())
   {
+    if(m_Store.isContiguous())
+    {
+      m_Values = m_Store.contiguousSpan().data();
+    }
   }
   ~CSVDataParser() override = default;
 
@@ -95,19 +204,38 @@ public:
   CSVDataParser& operator=(const CSVDataParser&) = delete; // Copy Assignment Not Implemented
   CSVDataParser& operator=(CSVDataParser&&) = delete;      // Move Assignment
 
-  Result<> parse(const std::string& token, size_t index) override
+  bool isContiguous() const override
+  {
+    return m_Values != nullptr;
+  }
+
+  Result<> parse(std::string_view token, usize index) override
   {
-    Result<T> parseResult = ConvertTo<T>::convert(token);
-    if(parseResult.valid())
+    T value = {};
+    switch(CSVParsing::ParseNumber(token, value))
     {
-      m_Array[index] = parseResult.value();
+    case CSVParsing::ParseStatus::Success:
+      break;
+    case CSVParsing::ParseStatus::InvalidArgument:
+      return MakeErrorResult(CSVParsing::k_InvalidArgumentError, fmt::format("Error trying to convert '{}' to type '{}'", token, DataTypeToString(GetDataType<T>())));
+    case CSVParsing::ParseStatus::OutOfRange:
+      return MakeErrorResult(CSVParsing::k_OverflowError, fmt::format("Overflow error trying to convert '{}' to type '{}'", token, DataTypeToString(GetDataType<T>())));
     }
 
-    return ConvertResult(std::move(parseResult));
+    if(m_Values != nullptr)
+    {
+      m_Values[index] = value;
+    }
+    else
+    {
+      m_Store.setValue(index, value);
+    }
+    return {};
   }
 
 private:
-  ArrayType& m_Array;
+  AbstractDataStore<T>& m_Store;
+  T* m_Values = nullptr;
 };
 
 using Int8Parser = CSVDataParser<Int8Array, int8>;
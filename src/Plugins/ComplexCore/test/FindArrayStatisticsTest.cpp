@@ -8,14 +8,121 @@ namespace fs = std::filesystem;
 #include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/Parameters/ArrayThresholdsParameter.hpp"
 #include "complex/Parameters/DataGroupSelectionParameter.hpp"
+#include "complex/Utilities/Math/StatisticsCalculations.hpp"
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/FindArrayStatisticsFilter.hpp"
 #include "ComplexCore/Filters/ImportDREAM3DFilter.hpp"
 
+#include <random>
+
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+/**
+ * @brief Runs the filter by index on random values and compares every statistic with
+ * the StatisticsCalculations functions applied to each feature's list of values.
+ */
+template <typename T>
+void CompareWithReferenceStatistics(bool useFullRange)
+{
+  constexpr usize k_NumTuples = 20000;
+  constexpr int32 k_NumFeatures = 37;
+  constexpr int32 k_NumBins = 10;
+
+  DataStructure dataStructure;
+  DataGroup* topLevelGroup = DataGroup::Create(dataStructure, "TestData");
+  const DataPath statsDataPath({"TestData", "Statistics"});
+  auto& values = DataArray<T>::template CreateWithStore<DataStore<T>>(dataStructure, "InputArray", {k_NumTuples}, {1}, topLevelGroup->getId())->getDataStoreRef();
+  auto& mask = BoolArray::CreateWithStore<DataStore<bool>>(dataStructure, "Mask", {k_NumTuples}, {1}, topLevelGroup->getId())->getDataStoreRef();
+  auto& featureIds = Int32Array::CreateWithStore<DataStore<int32>>(dataStructure, "FeatureIds", {k_NumTuples}, {1}, topLevelGroup->getId())->getDataStoreRef();
+
+  std::mt19937 generator(5489u);
+  std::uniform_real_distribution<float64> valueDistribution(-20.0, 120.0);
+  std::uniform_int_distribution<int32> featureDistribution(0, k_NumFeatures - 1);
+  std::bernoulli_distribution maskDistribution(0.8);
+  std::vector<std::vector<T>> featureValues(k_NumFeatures);
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    values[i] = static_cast<T>(valueDistribution(generator));
+    // Feature 5 stays empty and the last tuple guarantees the largest id is present
+    featureIds[i] = (i + 1 == k_NumTuples) ? k_NumFeatures - 1 : featureDistribution(generator);
+    featureIds[i] = (featureIds[i] == 5) ? 6 : featureIds[i];
+    mask[i] = (i + 1 == k_NumTuples) || maskDistribution(generator);
+    if(mask[i])
+    {
+      featureValues[featureIds[i]].push_back(values[i]);
+    }
+  }
+
+  FindArrayStatisticsFilter filter;
+  Arguments args;
+  args.insertOrAssign(FindArrayStatisticsFilter::k_FindHistogram_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_MinRange_Key, std::make_any<float64>(0));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_MaxRange_Key, std::make_any<float64>(100));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_UseFullRange_Key, std::make_any<bool>(useFullRange));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_NumBins_Key, std::make_any<int32>(k_NumBins));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_FindLength_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_FindMin_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_FindMax_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_FindMean_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_FindMedian_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_FindStdDeviation_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_FindSummation_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_UseMask_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_ComputeByIndex_Key, std::make_any<bool>(true));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_StandardizeData_Key, std::make_any<bool>(false));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_SelectedArrayPath_Key, std::make_any<DataPath>(DataPath({"TestData", "InputArray"})));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_CellFeatureIdsArrayPath_Key, std::make_any<DataPath>(DataPath({"TestData", "FeatureIds"})));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(DataPath({"TestData", "Mask"})));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_DestinationAttributeMatrix_Key, std::make_any<DataPath>(statsDataPath));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_HistogramArrayName_Key, std::make_any<std::string>("Histogram"));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_LengthArrayName_Key, std::make_any<std::string>("Length"));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_MinimumArrayName_Key, std::make_any<std::string>("Minimum"));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_MaximumArrayName_Key, std::make_any<std::string>("Maximum"));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_MeanArrayName_Key, std::make_any<std::string>("Mean"));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_MedianArrayName_Key, std::make_any<std::string>("Median"));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_StdDeviationArrayName_Key, std::make_any<std::string>("Standard Deviation"));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_SummationArrayName_Key, std::make_any<std::string>("Summation"));
+  args.insertOrAssign(FindArrayStatisticsFilter::k_StandardizedArrayName_Key, std::make_any<std::string>("Standardization"));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& lengthArray = dataStructure.getDataRefAs<UInt64Array>(statsDataPath.createChildPath("Length"));
+  const auto& minArray = dataStructure.getDataRefAs<DataArray<T>>(statsDataPath.createChildPath("Minimum"));
+  const auto& maxArray = dataStructure.getDataRefAs<DataArray<T>>(statsDataPath.createChildPath("Maximum"));
+  const auto& meanArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Mean"));
+  const auto& medianArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Median"));
+  const auto& stdArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Standard Deviation"));
+  const auto& sumArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Summation"));
+  const auto& histArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath("Histogram"));
+
+  REQUIRE(featureValues[5].empty());
+  for(int32 feature = 0; feature < k_NumFeatures; feature++)
+  {
+    std::vector<T>& expected = featureValues[feature];
+    const float32 sumTolerance = std::abs(static_cast<float32>(StaticicsCalculations::findSummation(expected))) * 1.0E-5f + UnitTest::EPSILON;
+    REQUIRE(lengthArray[feature] == expected.size());
+    REQUIRE(minArray[feature] == StaticicsCalculations::findMin(expected));
+    REQUIRE(maxArray[feature] == StaticicsCalculations::findMax(expected));
+    REQUIRE(std::fabs(meanArray[feature] - StaticicsCalculations::findMean(expected)) < UnitTest::EPSILON);
+    REQUIRE(medianArray[feature] == StaticicsCalculations::findMedian(expected));
+    REQUIRE(std::fabs(stdArray[feature] - StaticicsCalculations::findStdDeviation(expected)) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(sumArray[feature] - static_cast<float32>(StaticicsCalculations::findSummation(expected))) < sumTolerance);
+    const std::vector<float32> expectedHistogram = StaticicsCalculations::findHistogram(expected, 0.0f, 100.0f, useFullRange, k_NumBins);
+    for(int32 bin = 0; bin < k_NumBins; bin++)
+    {
+      REQUIRE(histArray[feature * k_NumBins + bin] == expectedHistogram[bin]);
+    }
+  }
+}
+} // namespace
+
 TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Instantiate Filter", "[ComplexCore][FindArrayStatisticsFilter]")
 {
   // Instantiate the filter, a DataStructure object and an Arguments Object
@@ -460,3 +567,19 @@ TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Test Algorithm By Index", "[C
     REQUIRE(std::fabs(hist3_5 - 1.0f) < UnitTest::EPSILON);
   }
 }
+
+TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Compare With Reference Statistics", "[ComplexCore][FindArrayStatisticsFilter]")
+{
+  SECTION("float32")
+  {
+    CompareWithReferenceStatistics<float32>(false);
+  }
+  SECTION("int16 Full Range")
+  {
+    CompareWithReferenceStatistics<int16>(true);
+  }
+  SECTION("float64 Full Range")
+  {
+    CompareWithReferenceStatistics<float64>(true);
+  }
+}
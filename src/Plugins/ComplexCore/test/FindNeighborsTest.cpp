@@ -2,15 +2,81 @@
 
 #include "ComplexCore/Filters/FindNeighbors.hpp"
 #include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 
+#include <map>
+#include <random>
+
 namespace fs = std::filesystem;
 
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+struct NeighborReference
+{
+  std::vector<int8> boundaryCells;
+  std::vector<bool> surfaceFeatures;
+  std::vector<std::map<int32, int32>> sharedFaces;
+};
+
+/**
+ * @brief Serial cell by cell reference of the neighbor search.
+ */
+NeighborReference FindNeighborsReference(const std::vector<int32>& featureIds, const SizeVec3& dims, usize numFeatures)
+{
+  NeighborReference reference;
+  reference.boundaryCells.resize(featureIds.size(), 0);
+  reference.surfaceFeatures.resize(numFeatures, false);
+  reference.sharedFaces.resize(numFeatures);
+  const int64 dimX = static_cast<int64>(dims[0]);
+  const int64 dimY = static_cast<int64>(dims[1]);
+  const int64 dimZ = static_cast<int64>(dims[2]);
+  for(int64 z = 0; z < dimZ; z++)
+  {
+    for(int64 y = 0; y < dimY; y++)
+    {
+      for(int64 x = 0; x < dimX; x++)
+      {
+        const int32 feature = featureIds[(z * dimY + y) * dimX + x];
+        if(feature <= 0)
+        {
+          continue;
+        }
+        const bool onEdge = x == 0 || x == dimX - 1 || y == 0 || y == dimY - 1;
+        if(onEdge || (dimZ != 1 && (z == 0 || z == dimZ - 1)))
+        {
+          reference.surfaceFeatures[feature] = true;
+        }
+        const std::array<std::array<int64, 3>, 6> offsets = {{{0, 0, -1}, {0, -1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+        for(const auto& offset : offsets)
+        {
+          const int64 nx = x + offset[0];
+          const int64 ny = y + offset[1];
+          const int64 nz = z + offset[2];
+          if(nx < 0 || nx >= dimX || ny < 0 || ny >= dimY || nz < 0 || nz >= dimZ)
+          {
+            continue;
+          }
+          const int32 neighbor = featureIds[(nz * dimY + ny) * dimX + nx];
+          if(neighbor != feature && neighbor > 0)
+          {
+            reference.boundaryCells[(z * dimY + y) * dimX + x]++;
+            reference.sharedFaces[feature][neighbor]++;
+          }
+        }
+      }
+    }
+  }
+  return reference;
+}
+} // namespace
+
 TEST_CASE("ComplexCore::FindNeighbors", "[ComplexCore][FindNeighbors]")
 {
 
@@ -74,3 +140,94 @@ TEST_CASE("ComplexCore::FindNeighbors", "[ComplexCore][FindNeighbors]")
   // Write the DataStructure out to the file system
   UnitTest::WriteTestDataStructure(dataStructure, fs::path(fmt::format("{}/find_neighbors_test.dream3d", unit_test::k_BinaryTestOutputDir)));
 }
+
+TEST_CASE("ComplexCore::FindNeighbors: Compare With Reference", "[ComplexCore][FindNeighbors]")
+{
+  const usize k_NumFeatures = 150;
+  const std::vector<SizeVec3> allDims = {SizeVec3{41, 29, 23}, SizeVec3{67, 53, 1}};
+  for(const SizeVec3& dims : allDims)
+  {
+    DataStructure dataStructure;
+    auto* imageGeom = ImageGeom::Create(dataStructure, k_DataContainer);
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing({0.5f, 0.75f, 1.25f});
+    const std::vector<usize> cellShape = {dims[2], dims[1], dims[0]};
+    auto* cellData = AttributeMatrix::Create(dataStructure, k_CellData, imageGeom->getId());
+    cellData->setShape(cellShape);
+    imageGeom->setCellData(*cellData);
+    auto* featureData = AttributeMatrix::Create(dataStructure, k_CellFeatureData, imageGeom->getId());
+    featureData->setShape({k_NumFeatures});
+
+    // Blocks of random features with scattered unassigned cells
+    auto* featureIdsArray = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, k_FeatureIds, cellShape, {1}, cellData->getId());
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int32> featureDistribution(1, static_cast<int32>(k_NumFeatures) - 1);
+    std::vector<int32> blockFeatures(1000);
+    for(auto& blockFeature : blockFeatures)
+    {
+      blockFeature = featureDistribution(generator);
+    }
+    std::vector<int32> featureIds(featureIdsArray->getNumberOfTuples());
+    for(usize z = 0; z < dims[2]; z++)
+    {
+      for(usize y = 0; y < dims[1]; y++)
+      {
+        for(usize x = 0; x < dims[0]; x++)
+        {
+          const usize cell = (z * dims[1] + y) * dims[0] + x;
+          const usize block = ((z / 4) * 100 + (y / 5) * 10 + (x / 6)) % blockFeatures.size();
+          featureIds[cell] = generator() % 17 == 0 ? 0 : blockFeatures[block];
+          (*featureIdsArray)[cell] = featureIds[cell];
+        }
+      }
+    }
+
+    const DataPath imageGeomPath({k_DataContainer});
+    const DataPath featureDataPath = imageGeomPath.createChildPath(k_CellFeatureData);
+    FindNeighbors filter;
+    Arguments args;
+    args.insertOrAssign(FindNeighbors::k_ImageGeom_Key, std::make_any<DataPath>(imageGeomPath));
+    args.insertOrAssign(FindNeighbors::k_FeatureIds_Key, std::make_any<DataPath>(imageGeomPath.createChildPath(k_CellData).createChildPath(k_FeatureIds)));
+    args.insertOrAssign(FindNeighbors::k_CellFeatures_Key, std::make_any<DataPath>(featureDataPath));
+    args.insertOrAssign(FindNeighbors::k_StoreBoundary_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindNeighbors::k_BoundaryCells_Key, std::make_any<std::string>("BoundaryCells"));
+    args.insertOrAssign(FindNeighbors::k_StoreSurface_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindNeighbors::k_SurfaceFeatures_Key, std::make_any<std::string>("SurfaceFeatures"));
+    args.insertOrAssign(FindNeighbors::k_NumNeighbors_Key, std::make_any<std::string>("NumNeighbors"));
+    args.insertOrAssign(FindNeighbors::k_NeighborList_Key, std::make_any<std::string>("NeighborList"));
+    args.insertOrAssign(FindNeighbors::k_SharedSurfaceArea_Key, std::make_any<std::string>("SharedSurfaceAreaList"));
+
+    auto preflightResult = filter.preflight(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+    const NeighborReference reference = FindNeighborsReference(featureIds, dims, k_NumFeatures);
+    const auto& boundaryCells = dataStructure.getDataRefAs<Int8Array>(imageGeomPath.createChildPath(k_CellData).createChildPath("BoundaryCells"));
+    for(usize cell = 0; cell < featureIds.size(); cell++)
+    {
+      REQUIRE(boundaryCells[cell] == reference.boundaryCells[cell]);
+    }
+    const auto& surfaceFeatures = dataStructure.getDataRefAs<BoolArray>(featureDataPath.createChildPath("SurfaceFeatures"));
+    const auto& numNeighbors = dataStructure.getDataRefAs<Int32Array>(featureDataPath.createChildPath("NumNeighbors"));
+    const auto& neighborList = dataStructure.getDataRefAs<Int32NeighborList>(featureDataPath.createChildPath("NeighborList"));
+    const auto& sharedSurfaceAreaList = dataStructure.getDataRefAs<Float32NeighborList>(featureDataPath.createChildPath("SharedSurfaceAreaList"));
+    for(usize feature = 1; feature < k_NumFeatures; feature++)
+    {
+      const auto& expectedFaces = reference.sharedFaces[feature];
+      REQUIRE(surfaceFeatures[feature] == reference.surfaceFeatures[feature]);
+      REQUIRE(numNeighbors[feature] == static_cast<int32>(expectedFaces.size()));
+      const auto neighbors = neighborList.getListSpan(static_cast<int32>(feature));
+      const auto areas = sharedSurfaceAreaList.getListSpan(static_cast<int32>(feature));
+      REQUIRE(neighbors.size() == expectedFaces.size());
+      REQUIRE(areas.size() == expectedFaces.size());
+      usize index = 0;
+      for(const auto& [neighbor, numFaces] : expectedFaces)
+      {
+        REQUIRE(neighbors[index] == neighbor);
+        REQUIRE(areas[index] == static_cast<float32>(numFaces) * 0.5f * 0.75f);
+        index++;
+      }
+    }
+  }
+}
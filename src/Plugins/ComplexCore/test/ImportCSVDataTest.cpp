@@ -363,3 +363,107 @@ TEST_CASE("ComplexCore::ImportCSVDataFilter (Case 4): Invalid filter execution -
   TestCase_TestPrimitives_Error<float32>(v, k_InvalidArgumentErrorCode);
   TestCase_TestPrimitives_Error<float64>(v, k_InvalidArgumentErrorCode);
 }
+
+// -----------------------------------------------------------------------------
+Arguments createMultiColumnArguments(usize numRows, const std::string& newGroupName, const std::string& dummyGroupName)
+{
+  Arguments args = createArguments("Int32", DataType::int32, {}, newGroupName, dummyGroupName);
+
+  CSVWizardData data = args.value<CSVWizardData>(ImportCSVDataFilter::k_WizardData_Key);
+  data.dataHeaders = {"Int32", "Float64", "Skipped", "UInt16"};
+  data.dataTypes = {DataType::int32, DataType::float64, {}, DataType::uint16};
+  data.numberOfLines = numRows + 1;
+  args.insertOrAssign(ImportCSVDataFilter::k_WizardData_Key, std::make_any<CSVWizardData>(data));
+  args.insertOrAssign(ImportCSVDataFilter::k_TupleDims_Key, std::make_any<DynamicTableParameter::ValueType>(DynamicTableInfo::TableDataType{{static_cast<float64>(numRows)}}));
+  return args;
+}
+
+// -----------------------------------------------------------------------------
+void writeMultiColumnFile(usize numRows, usize invalidRow)
+{
+  std::ofstream file(k_TestInput, std::ios_base::binary);
+  REQUIRE(file.is_open());
+
+  file << "Int32,Float64,Skipped,UInt16\r\n";
+  for(usize i = 0; i < numRows; i++)
+  {
+    // Mix line endings and padding so the tokens have to be trimmed
+    const char* lineEnding = (i % 3 == 0) ? "\r\n" : "\n";
+    if(i == invalidRow)
+    {
+      file << "1, 2.5, x, y" << lineEnding;
+      continue;
+    }
+    file << static_cast<int32>(i) - 5000 << ", " << static_cast<float64>(i % 1000) * 0.25 << " ,skip, " << (i % 65536) << lineEnding;
+  }
+}
+
+TEST_CASE("ComplexCore::ImportCSVDataFilter (Case 5): Valid filter execution - Multiple Columns")
+{
+  fs::create_directories(k_TestInput.parent_path());
+
+  // Large enough to be split into several chunks
+  const usize numRows = 50000;
+  const std::string newGroupName = "New Group";
+  const std::string dummyGroupName = "Dummy Group";
+
+  writeMultiColumnFile(numRows, numRows);
+
+  ImportCSVDataFilter filter;
+  DataStructure dataStructure = createDataStructure(dummyGroupName);
+  Arguments args = createMultiColumnArguments(numRows, newGroupName, dummyGroupName);
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& int32Array = dataStructure.getDataRefAs<Int32Array>(DataPath({newGroupName, "Int32"}));
+  const auto& float64Array = dataStructure.getDataRefAs<Float64Array>(DataPath({newGroupName, "Float64"}));
+  const auto& uint16Array = dataStructure.getDataRefAs<UInt16Array>(DataPath({newGroupName, "UInt16"}));
+  REQUIRE(dataStructure.getData(DataPath({newGroupName, "Skipped"})) == nullptr);
+  for(usize i = 0; i < numRows; i++)
+  {
+    if(int32Array[i] != static_cast<int32>(i) - 5000 || float64Array[i] != static_cast<float64>(i % 1000) * 0.25 || uint16Array[i] != i % 65536)
+    {
+      FAIL(fmt::format("Row {} was not imported correctly", i));
+    }
+  }
+}
+
+TEST_CASE("ComplexCore::ImportCSVDataFilter (Case 6): Invalid filter execution - First Invalid Line")
+{
+  fs::create_directories(k_TestInput.parent_path());
+
+  const usize numRows = 50000;
+  const std::string newGroupName = "New Group";
+  const std::string dummyGroupName = "Dummy Group";
+
+  SECTION("Invalid Value")
+  {
+    writeMultiColumnFile(numRows, 41234);
+
+    ImportCSVDataFilter filter;
+    DataStructure dataStructure = createDataStructure(dummyGroupName);
+    Arguments args = createMultiColumnArguments(numRows, newGroupName, dummyGroupName);
+
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_INVALID(executeResult.result);
+    REQUIRE(executeResult.result.errors().size() == 1);
+    REQUIRE(executeResult.result.errors()[0].code == k_InvalidArgumentErrorCode);
+  }
+  SECTION("Missing Lines")
+  {
+    writeMultiColumnFile(numRows, numRows);
+
+    ImportCSVDataFilter filter;
+    DataStructure dataStructure = createDataStructure(dummyGroupName);
+    Arguments args = createMultiColumnArguments(numRows + 2, newGroupName, dummyGroupName);
+
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_INVALID(executeResult.result);
+    REQUIRE(executeResult.result.errors().size() == 1);
+    // The line after the last line ending is the first missing one
+    REQUIRE(StringUtilities::contains(executeResult.result.errors()[0].message, fmt::format("Line {} has an inconsistent number of columns", numRows + 2)));
+  }
+}
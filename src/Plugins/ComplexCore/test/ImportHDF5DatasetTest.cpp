@@ -668,6 +668,57 @@ void testFilterExecute(ImportHDF5Dataset& filter)
   }
 }
 
+// -----------------------------------------------------------------------------
+void testFilterExecuteHyperslab(ImportHDF5Dataset& filter)
+{
+  // Pointer3DArrayDataset is 10 x 8 x 36
+  const std::vector<usize> fileDims = {10, 8, (COMPDIMPROD * TUPLEDIMPROD) / 10 / 8};
+  const std::vector<usize> offset = {2, 1, 4};
+  const std::vector<usize> count = {3, 4, 5};
+  const std::vector<usize> stride = {2, 1, 3};
+
+  ImportHDF5DatasetParameter::DatasetImportInfo info;
+  info.dataSetPath = "/Pointer/Pointer3DArrayDataset<" + H5::Support::HdfTypeForPrimitiveAsStr<int32>() + ">";
+  info.tupleDimensions = "3, 4, 5";
+  info.componentDimensions = "1";
+  info.hyperslabOffset = offset;
+  info.hyperslabCount = count;
+  info.hyperslabStride = stride;
+
+  DataStructure dataStructure;
+  DataGroup::Create(dataStructure, Constants::k_LevelZero);
+  Arguments args;
+  ImportHDF5DatasetParameter::ValueType val = {DataPath({Constants::k_LevelZero}), m_FilePath, {info}};
+  args.insertOrAssign(ImportHDF5Dataset::k_ImportHDF5File_Key.str(), std::make_any<ImportHDF5DatasetParameter::ValueType>(val));
+
+  auto result = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(result.result);
+
+  const auto& dataArray = dataStructure.getDataRefAs<Int32Array>(DataPath({Constants::k_LevelZero, "Pointer3DArrayDataset<" + H5::Support::HdfTypeForPrimitiveAsStr<int32>() + ">"}));
+  REQUIRE(dataArray.getSize() == count[0] * count[1] * count[2]);
+  usize index = 0;
+  for(usize z = 0; z < count[0]; z++)
+  {
+    for(usize y = 0; y < count[1]; y++)
+    {
+      for(usize x = 0; x < count[2]; x++)
+      {
+        usize fileIndex = ((offset[0] + z * stride[0]) * fileDims[1] + (offset[1] + y * stride[1])) * fileDims[2] + (offset[2] + x * stride[2]);
+        REQUIRE(dataArray[index++] == static_cast<int32>(fileIndex * 5));
+      }
+    }
+  }
+
+  // A hyperslab extending past the end of the dataset is rejected in preflight
+  info.hyperslabOffset = {8, 1, 4};
+  val = {DataPath({Constants::k_LevelZero}), m_FilePath, {info}};
+  args.insertOrAssign(ImportHDF5Dataset::k_ImportHDF5File_Key.str(), std::make_any<ImportHDF5DatasetParameter::ValueType>(val));
+  DataStructure emptyStructure;
+  DataGroup::Create(emptyStructure, Constants::k_LevelZero);
+  auto preflightResult = filter.preflight(emptyStructure, args);
+  REQUIRE(preflightResult.outputActions.invalid());
+}
+
 // -----------------------------------------------------------------------------
 TEST_CASE("ComplexCore::ImportHDF5Dataset Filter")
 {
@@ -677,6 +728,7 @@ TEST_CASE("ComplexCore::ImportHDF5Dataset Filter")
     ImportHDF5Dataset filter;
     testFilterPreflight(filter);
     testFilterExecute(filter);
+    testFilterExecuteHyperslab(filter);
   }
 
   if(fs::exists(m_FilePath))
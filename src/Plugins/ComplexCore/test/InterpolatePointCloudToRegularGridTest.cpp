@@ -6,9 +6,17 @@
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/DataStructure/Geometry/VertexGeom.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <filesystem>
 #include <iostream>
 #include <limits>
+#include <random>
 #include <string>
 
 namespace fs = std::filesystem;
@@ -126,3 +134,234 @@ TEST_CASE("ComplexCore::InterpolatePointCloudToRegularGridFilter: Test Algorithm
   auto executeResult = filter.execute(dataGraph, args);
   COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
 }
+
+TEST_CASE("ComplexCore::InterpolatePointCloudToRegularGridFilter: Compare With Reference", "[ComplexCore][InterpolatePointCloudToRegularGridFilter]")
+{
+  const SizeVec3 dims = {7, 6, 5};
+  const usize numVoxels = dims[0] * dims[1] * dims[2];
+  const usize numPoints = 400;
+  const std::vector<float32> kernelSize = {3.0f, 2.5f, 4.0f};
+  const std::vector<float32> gaussianSigmas = {1.5f, 1.0f, 2.0f};
+  const std::array<int64, 3> radius = {2, 2, 2};
+
+  DataStructure dataStructure;
+  auto* group = DataGroup::Create(dataStructure, "Data");
+  auto* image = ImageGeom::Create(dataStructure, "Image", group->getId());
+  image->setDimensions(dims);
+  image->setSpacing({1.0f, 1.0f, 1.0f});
+  image->setOrigin({0.0f, 0.0f, 0.0f});
+  auto* vertexGeom = VertexGeom::Create(dataStructure, "Vertices", group->getId());
+  auto* vertices = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Coords", {numPoints}, {3}, group->getId());
+  vertexGeom->setVertices(*vertices);
+  auto& voxelIndices = USizeArray::CreateWithStore<DataStore<usize>>(dataStructure, "Voxel Indices", {numPoints}, {1}, group->getId())->getDataStoreRef();
+  auto& mask = BoolArray::CreateWithStore<DataStore<bool>>(dataStructure, "Mask", {numPoints}, {1}, group->getId())->getDataStoreRef();
+  auto& values = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Values", {numPoints}, {1}, group->getId())->getDataStoreRef();
+  auto& phases = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, "Phases", {numPoints}, {1}, group->getId())->getDataStoreRef();
+
+  std::mt19937_64 generator(5489u);
+  std::uniform_int_distribution<usize> voxelDist(0, numVoxels - 1);
+  std::uniform_real_distribution<float32> valueDist(-10.0f, 10.0f);
+  std::uniform_int_distribution<int32> phaseDist(1, 4);
+  for(usize i = 0; i < numPoints; i++)
+  {
+    voxelIndices[i] = voxelDist(generator);
+    mask[i] = (i % 5) != 0;
+    values[i] = valueDist(generator);
+    phases[i] = phaseDist(generator);
+  }
+
+  // Serial scatter of every unmasked point into the voxels covered by its kernel
+  std::vector<std::vector<float32>> refValueLists(numVoxels);
+  std::vector<std::vector<int32>> refPhaseLists(numVoxels);
+  std::vector<std::vector<float32>> refDistanceLists(numVoxels);
+  std::vector<float64> refWeightedSums(numVoxels, 0.0);
+  std::vector<float64> refWeightSums(numVoxels, 0.0);
+  std::vector<float64> refPhaseSums(numVoxels, 0.0);
+  for(usize i = 0; i < numPoints; i++)
+  {
+    if(!mask[i])
+    {
+      continue;
+    }
+    const auto x = static_cast<int64>(voxelIndices[i] % dims[0]);
+    const auto y = static_cast<int64>((voxelIndices[i] / dims[0]) % dims[1]);
+    const auto z = static_cast<int64>(voxelIndices[i] / (dims[0] * dims[1]));
+    for(int64 dz = -radius[2]; dz <= radius[2]; dz++)
+    {
+      for(int64 dy = -radius[1]; dy <= radius[1]; dy++)
+      {
+        for(int64 dx = -radius[0]; dx <= radius[0]; dx++)
+        {
+          if(x + dx < 0 || x + dx >= static_cast<int64>(dims[0]) || y + dy < 0 || y + dy >= static_cast<int64>(dims[1]) || z + dz < 0 || z + dz >= static_cast<int64>(dims[2]))
+          {
+            continue;
+          }
+          const auto voxel = static_cast<usize>(((z + dz) * dims[1] + (y + dy)) * dims[0] + (x + dx));
+          const auto weight = static_cast<float32>(std::exp(-((dx * dx) / (2 * gaussianSigmas[0] * gaussianSigmas[0]) + (dy * dy) / (2 * gaussianSigmas[1] * gaussianSigmas[1]) +
+                                                              (dz * dz) / (2 * gaussianSigmas[2] * gaussianSigmas[2]))));
+          refValueLists[voxel].push_back(weight * values[i]);
+          refPhaseLists[voxel].push_back(phases[i]);
+          refDistanceLists[voxel].push_back(static_cast<float32>(std::sqrt(dx * dx + dy * dy + dz * dz)));
+          refWeightedSums[voxel] += static_cast<float64>(weight) * values[i];
+          refWeightSums[voxel] += weight;
+          refPhaseSums[voxel] += phases[i];
+        }
+      }
+    }
+  }
+
+  const DataPath groupPath({"Data"});
+  const DataPath interpolatedGroupPath({"Interpolated"});
+  const DataPath kernelDistancesGroupPath({"Kernel Distances"});
+
+  InterpolatePointCloudToRegularGridFilter filter;
+  Arguments args;
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_UseMask_Key, std::make_any<bool>(true));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_StoreKernelDistances_Key, std::make_any<bool>(true));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_StoreNeighborLists_Key, std::make_any<bool>(true));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_StoreWeightedAverages_Key, std::make_any<bool>(true));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolationTechnique_Key, std::make_any<uint64>(1));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_KernelSize_Key, std::make_any<std::vector<float32>>(kernelSize));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_GaussianSigmas_Key, std::make_any<std::vector<float32>>(gaussianSigmas));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_VertexGeom_Key, std::make_any<DataPath>(groupPath.createChildPath("Vertices")));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_ImageGeom_Key, std::make_any<DataPath>(groupPath.createChildPath("Image")));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_VoxelIndices_Key, std::make_any<DataPath>(groupPath.createChildPath("Voxel Indices")));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_Mask_Key, std::make_any<DataPath>(groupPath.createChildPath("Mask")));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolateArrays_Key, std::make_any<std::vector<DataPath>>(std::vector<DataPath>{groupPath.createChildPath("Values")}));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_CopyArrays_Key, std::make_any<std::vector<DataPath>>(std::vector<DataPath>{groupPath.createChildPath("Phases")}));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolatedGroup_Key, std::make_any<DataPath>(interpolatedGroupPath));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_KernelDistancesGroup_Key, std::make_any<DataPath>(kernelDistancesGroupPath));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& valueAverages = dataStructure.getDataRefAs<Float32Array>(interpolatedGroupPath.createChildPath("Values Weighted Average"));
+  const auto& phaseAverages = dataStructure.getDataRefAs<Float32Array>(interpolatedGroupPath.createChildPath("Phases Weighted Average"));
+  const auto& copiedValues = dataStructure.getDataRefAs<Float32Array>(interpolatedGroupPath.createChildPath("Values"));
+  const auto& copiedPhases = dataStructure.getDataRefAs<Int32Array>(interpolatedGroupPath.createChildPath("Phases"));
+  REQUIRE(copiedValues.getNumberOfTuples() == numPoints);
+  REQUIRE(copiedPhases.getNumberOfTuples() == numPoints);
+  for(usize i = 0; i < numPoints; i++)
+  {
+    REQUIRE(copiedValues[i] == values[i]);
+    REQUIRE(copiedPhases[i] == phases[i]);
+  }
+  const auto& valueLists = dataStructure.getDataRefAs<Float32NeighborList>(interpolatedGroupPath.createChildPath("Values Neighbors"));
+  const auto& phaseLists = dataStructure.getDataRefAs<Int32NeighborList>(interpolatedGroupPath.createChildPath("Phases Neighbors"));
+  const auto& distanceLists = dataStructure.getDataRefAs<Float32NeighborList>(kernelDistancesGroupPath.createChildPath("Neighbor List"));
+
+  REQUIRE(valueAverages.getNumberOfTuples() == numVoxels);
+  REQUIRE(valueLists.getNumberOfTuples() == numVoxels);
+  REQUIRE(phaseLists.getNumberOfTuples() == numVoxels);
+  REQUIRE(distanceLists.getNumberOfTuples() == numVoxels);
+
+  auto sortedList = [](auto span) {
+    std::vector<std::decay_t<decltype(span[0])>> sorted(span.begin(), span.end());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  };
+
+  for(usize v = 0; v < numVoxels; v++)
+  {
+    const float32 expectedAverage = refWeightSums[v] > 0.0 ? static_cast<float32>(refWeightedSums[v] / refWeightSums[v]) : 0.0f;
+    REQUIRE(std::abs(valueAverages[v] - expectedAverage) < 1.0e-4f);
+    const float32 expectedPhase = refPhaseLists[v].empty() ? 0.0f : static_cast<float32>(refPhaseSums[v] / refPhaseLists[v].size());
+    REQUIRE(std::abs(phaseAverages[v] - expectedPhase) < 1.0e-5f);
+
+    std::sort(refValueLists[v].begin(), refValueLists[v].end());
+    std::sort(refPhaseLists[v].begin(), refPhaseLists[v].end());
+    std::sort(refDistanceLists[v].begin(), refDistanceLists[v].end());
+    REQUIRE(sortedList(valueLists.getListSpan(static_cast<int32>(v))) == refValueLists[v]);
+    REQUIRE(sortedList(phaseLists.getListSpan(static_cast<int32>(v))) == refPhaseLists[v]);
+    REQUIRE(sortedList(distanceLists.getListSpan(static_cast<int32>(v))) == refDistanceLists[v]);
+  }
+}
+
+TEST_CASE("ComplexCore::InterpolatePointCloudToRegularGridFilter: Underflowing Gaussian Weights", "[ComplexCore][InterpolatePointCloudToRegularGridFilter]")
+{
+  // With a tiny sigma every Gaussian weight off the kernel center is 0, while copied arrays still
+  // use the whole uniform kernel, so the two kinds of lists have different lengths
+  const SizeVec3 dims = {6, 5, 4};
+  const usize numVoxels = dims[0] * dims[1] * dims[2];
+  const usize numPoints = 150;
+  const std::array<int64, 3> radius = {2, 2, 2};
+
+  DataStructure dataStructure;
+  auto* group = DataGroup::Create(dataStructure, "Data");
+  auto* image = ImageGeom::Create(dataStructure, "Image", group->getId());
+  image->setDimensions(dims);
+  image->setSpacing({1.0f, 1.0f, 1.0f});
+  image->setOrigin({0.0f, 0.0f, 0.0f});
+  auto* vertexGeom = VertexGeom::Create(dataStructure, "Vertices", group->getId());
+  auto* vertices = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Coords", {numPoints}, {3}, group->getId());
+  vertexGeom->setVertices(*vertices);
+  auto& voxelIndices = USizeArray::CreateWithStore<DataStore<usize>>(dataStructure, "Voxel Indices", {numPoints}, {1}, group->getId())->getDataStoreRef();
+  auto& values = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Values", {numPoints}, {1}, group->getId())->getDataStoreRef();
+  auto& phases = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, "Phases", {numPoints}, {1}, group->getId())->getDataStoreRef();
+  BoolArray::CreateWithStore<DataStore<bool>>(dataStructure, "Mask", {numPoints}, {1}, group->getId());
+
+  std::vector<usize> centerCounts(numVoxels, 0);
+  std::vector<usize> kernelCounts(numVoxels, 0);
+  for(usize i = 0; i < numPoints; i++)
+  {
+    voxelIndices[i] = (i * 37) % numVoxels;
+    values[i] = static_cast<float32>(i);
+    phases[i] = static_cast<int32>(i % 3);
+    centerCounts[voxelIndices[i]]++;
+
+    const auto x = static_cast<int64>(voxelIndices[i] % dims[0]);
+    const auto y = static_cast<int64>((voxelIndices[i] / dims[0]) % dims[1]);
+    const auto z = static_cast<int64>(voxelIndices[i] / (dims[0] * dims[1]));
+    for(int64 vz = std::max<int64>(z - radius[2], 0); vz <= std::min<int64>(z + radius[2], dims[2] - 1); vz++)
+    {
+      for(int64 vy = std::max<int64>(y - radius[1], 0); vy <= std::min<int64>(y + radius[1], dims[1] - 1); vy++)
+      {
+        for(int64 vx = std::max<int64>(x - radius[0], 0); vx <= std::min<int64>(x + radius[0], dims[0] - 1); vx++)
+        {
+          kernelCounts[(vz * dims[1] + vy) * dims[0] + vx]++;
+        }
+      }
+    }
+  }
+
+  const DataPath groupPath({"Data"});
+  const DataPath interpolatedGroupPath({"Interpolated"});
+  const DataPath kernelDistancesGroupPath({"Kernel Distances"});
+
+  InterpolatePointCloudToRegularGridFilter filter;
+  Arguments args;
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_UseMask_Key, std::make_any<bool>(false));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_StoreKernelDistances_Key, std::make_any<bool>(true));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_StoreNeighborLists_Key, std::make_any<bool>(true));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_StoreWeightedAverages_Key, std::make_any<bool>(false));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolationTechnique_Key, std::make_any<uint64>(1));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_KernelSize_Key, std::make_any<std::vector<float32>>(std::vector<float32>{4.0f, 4.0f, 4.0f}));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_GaussianSigmas_Key, std::make_any<std::vector<float32>>(std::vector<float32>{0.05f, 0.05f, 0.05f}));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_VertexGeom_Key, std::make_any<DataPath>(groupPath.createChildPath("Vertices")));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_ImageGeom_Key, std::make_any<DataPath>(groupPath.createChildPath("Image")));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_VoxelIndices_Key, std::make_any<DataPath>(groupPath.createChildPath("Voxel Indices")));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_Mask_Key, std::make_any<DataPath>(groupPath.createChildPath("Mask")));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolateArrays_Key, std::make_any<std::vector<DataPath>>(std::vector<DataPath>{groupPath.createChildPath("Values")}));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_CopyArrays_Key, std::make_any<std::vector<DataPath>>(std::vector<DataPath>{groupPath.createChildPath("Phases")}));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_InterpolatedGroup_Key, std::make_any<DataPath>(interpolatedGroupPath));
+  args.insertOrAssign(InterpolatePointCloudToRegularGridFilter::k_KernelDistancesGroup_Key, std::make_any<DataPath>(kernelDistancesGroupPath));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& valueLists = dataStructure.getDataRefAs<Float32NeighborList>(interpolatedGroupPath.createChildPath("Values Neighbors"));
+  const auto& phaseLists = dataStructure.getDataRefAs<Int32NeighborList>(interpolatedGroupPath.createChildPath("Phases Neighbors"));
+  const auto& distanceLists = dataStructure.getDataRefAs<Float32NeighborList>(kernelDistancesGroupPath.createChildPath("Neighbor List"));
+  for(usize v = 0; v < numVoxels; v++)
+  {
+    REQUIRE(valueLists.getListSpan(static_cast<int32>(v)).size() == centerCounts[v]);
+    REQUIRE(distanceLists.getListSpan(static_cast<int32>(v)).size() == centerCounts[v]);
+    REQUIRE(phaseLists.getListSpan(static_cast<int32>(v)).size() == kernelCounts[v]);
+  }
+}
@@ -8,14 +8,67 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/IterativeClosestPointFilter.hpp"
 
+#include <Eigen/Geometry>
+
+#include <cmath>
 #include <filesystem>
 #include <limits>
+#include <random>
 
 namespace fs = std::filesystem;
 
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+const DataPath k_TargetGeomPath({"Target"});
+const DataPath k_MovingGeomPath({"Moving"});
+const DataPath k_MovingNormalsPath({"Moving Normals"});
+const DataPath k_IcpTransformPath({"Transform"});
+
+/**
+ * @brief Creates a target cloud of random points on a bumpy surface and a moving copy of it
+ * that is rotated and shifted by a small rigid transformation. The moving normals are the
+ * surface normals.
+ */
+DataStructure CreateMisalignedClouds(usize numPoints)
+{
+  DataStructure dataStructure;
+  std::mt19937_64 generator(numPoints);
+  std::uniform_real_distribution<float32> distribution(-1.0f, 1.0f);
+
+  const Eigen::Matrix3f rotation = Eigen::AngleAxisf(0.06f, Eigen::Vector3f(0.3f, -0.5f, 0.8f).normalized()).toRotationMatrix();
+  const Eigen::Vector3f translation(0.02f, -0.015f, 0.01f);
+
+  auto* targetGeom = VertexGeom::Create(dataStructure, k_TargetGeomPath.getTargetName());
+  auto* targetVertices = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Vertices", {numPoints}, {3}, targetGeom->getId());
+  targetGeom->setVertices(*targetVertices);
+  auto* movingGeom = VertexGeom::Create(dataStructure, k_MovingGeomPath.getTargetName());
+  auto* movingVertices = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Vertices", {numPoints}, {3}, movingGeom->getId());
+  movingGeom->setVertices(*movingVertices);
+  auto* normals = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, k_MovingNormalsPath.getTargetName(), {numPoints}, {3});
+
+  for(usize i = 0; i < numPoints; i++)
+  {
+    const float32 x = distribution(generator);
+    const float32 y = distribution(generator);
+    const float32 z = 0.3f * std::sin(3.0f * x) * std::cos(2.0f * y) + 0.2f * x * x;
+    const Eigen::Vector3f point(x, y, z);
+    const Eigen::Vector3f normal = Eigen::Vector3f(-0.9f * std::cos(3.0f * x) * std::cos(2.0f * y) - 0.4f * x, 0.6f * std::sin(3.0f * x) * std::sin(2.0f * y), 1.0f).normalized();
+    const Eigen::Vector3f movedPoint = rotation * point + translation;
+    const Eigen::Vector3f movedNormal = rotation * normal;
+    for(usize k = 0; k < 3; k++)
+    {
+      (*targetVertices)[3 * i + k] = point[k];
+      (*movingVertices)[3 * i + k] = movedPoint[k];
+      (*normals)[3 * i + k] = movedNormal[k];
+    }
+  }
+  return dataStructure;
+}
+} // namespace
+
 TEST_CASE("ComplexCore::IterativeClosestPointFilter: Create Filter", "[DREAM3DReview][IterativeClosestPointFilter]")
 {
   IterativeClosestPointFilter filter;
@@ -73,3 +126,88 @@ TEST_CASE("ComplexCore::IterativeClosestPointFilter: Test Algorithm", "[DREAM3DR
   auto executeResult = filter.execute(dataGraph, args);
   REQUIRE(executeResult.result.valid());
 }
+
+TEST_CASE("ComplexCore::IterativeClosestPointFilter: Recover Transformation", "[ComplexCore][IterativeClosestPointFilter]")
+{
+  const usize numPoints = 20000;
+
+  for(ChoicesParameter::ValueType samplingMode :
+      {IterativeClosestPointFilter::k_AllPointsSampling, IterativeClosestPointFilter::k_RandomSampling, IterativeClosestPointFilter::k_NormalSpaceSampling})
+  {
+    DYNAMIC_SECTION("Sampling Mode: " << samplingMode)
+    {
+      DataStructure dataStructure = CreateMisalignedClouds(numPoints);
+
+      IterativeClosestPointFilter filter;
+      Arguments args;
+      args.insertOrAssign(IterativeClosestPointFilter::k_MovingVertexPath_Key, std::make_any<DataPath>(k_MovingGeomPath));
+      args.insertOrAssign(IterativeClosestPointFilter::k_TargetVertexPath_Key, std::make_any<DataPath>(k_TargetGeomPath));
+      args.insertOrAssign(IterativeClosestPointFilter::k_NumIterations_Key, std::make_any<uint64>(200));
+      args.insertOrAssign(IterativeClosestPointFilter::k_RmsTolerance_Key, std::make_any<float32>(1.0e-7f));
+      args.insertOrAssign(IterativeClosestPointFilter::k_ApplyTransformation_Key, std::make_any<bool>(true));
+      args.insertOrAssign(IterativeClosestPointFilter::k_SamplingMode_Key, std::make_any<ChoicesParameter::ValueType>(samplingMode));
+      args.insertOrAssign(IterativeClosestPointFilter::k_SampleFraction_Key, std::make_any<float32>(0.25f));
+      args.insertOrAssign(IterativeClosestPointFilter::k_MovingNormalsPath_Key, std::make_any<DataPath>(k_MovingNormalsPath));
+      args.insertOrAssign(IterativeClosestPointFilter::k_TransformArrayPath_Key, std::make_any<DataPath>(k_IcpTransformPath));
+
+      auto preflightResult = filter.preflight(dataStructure, args);
+      COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+      usize numIterationMessages = 0;
+      IFilter::MessageHandler messageHandler{[&numIterationMessages](const IFilter::Message& message) {
+        if(message.message.rfind("Iteration ", 0) == 0)
+        {
+          numIterationMessages++;
+        }
+      }};
+      auto executeResult = filter.execute(dataStructure, args, nullptr, messageHandler);
+      COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+      // The tolerance stops the registration long before the iteration limit
+      REQUIRE(numIterationMessages > 1);
+      REQUIRE(numIterationMessages < 200);
+
+      const auto& targetVertices = *dataStructure.getDataRefAs<VertexGeom>(k_TargetGeomPath).getVertices();
+      const auto& movingVertices = *dataStructure.getDataRefAs<VertexGeom>(k_MovingGeomPath).getVertices();
+      float32 maxError = 0.0f;
+      for(usize i = 0; i < targetVertices.getSize(); i++)
+      {
+        maxError = std::max(maxError, std::abs(targetVertices[i] - movingVertices[i]));
+      }
+      REQUIRE(maxError < 1.0e-3f);
+    }
+  }
+}
+
+TEST_CASE("ComplexCore::IterativeClosestPointFilter: Invalid Sampling", "[ComplexCore][IterativeClosestPointFilter]")
+{
+  DataStructure dataStructure = CreateMisalignedClouds(100);
+
+  IterativeClosestPointFilter filter;
+  Arguments args;
+  args.insertOrAssign(IterativeClosestPointFilter::k_MovingVertexPath_Key, std::make_any<DataPath>(k_MovingGeomPath));
+  args.insertOrAssign(IterativeClosestPointFilter::k_TargetVertexPath_Key, std::make_any<DataPath>(k_TargetGeomPath));
+  args.insertOrAssign(IterativeClosestPointFilter::k_TransformArrayPath_Key, std::make_any<DataPath>(k_IcpTransformPath));
+
+  SECTION("Sample Fraction")
+  {
+    args.insertOrAssign(IterativeClosestPointFilter::k_SamplingMode_Key, std::make_any<ChoicesParameter::ValueType>(IterativeClosestPointFilter::k_RandomSampling));
+    args.insertOrAssign(IterativeClosestPointFilter::k_SampleFraction_Key, std::make_any<float32>(1.5f));
+    auto preflightResult = filter.preflight(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_INVALID(preflightResult.outputActions);
+  }
+  SECTION("Missing Normals")
+  {
+    args.insertOrAssign(IterativeClosestPointFilter::k_SamplingMode_Key, std::make_any<ChoicesParameter::ValueType>(IterativeClosestPointFilter::k_NormalSpaceSampling));
+    args.insertOrAssign(IterativeClosestPointFilter::k_MovingNormalsPath_Key, std::make_any<DataPath>(k_TargetGeomPath));
+    auto preflightResult = filter.preflight(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_INVALID(preflightResult.outputActions);
+  }
+  SECTION("Too Few Samples")
+  {
+    args.insertOrAssign(IterativeClosestPointFilter::k_SamplingMode_Key, std::make_any<ChoicesParameter::ValueType>(IterativeClosestPointFilter::k_RandomSampling));
+    args.insertOrAssign(IterativeClosestPointFilter::k_SampleFraction_Key, std::make_any<float32>(0.01f));
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_INVALID(executeResult.result);
+  }
+}
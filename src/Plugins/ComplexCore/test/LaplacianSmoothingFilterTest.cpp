@@ -13,13 +13,112 @@
 #include "ComplexCore/Filters/LaplacianSmoothingFilter.hpp"
 #include "ComplexCore/Filters/StlFileReaderFilter.hpp"
 
+#include <cmath>
 #include <filesystem>
 #include <string>
+#include <vector>
 namespace fs = std::filesystem;
 
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+const DataPath k_GridGeometryPath({"Grid"});
+const DataPath k_GridNodeTypePath = k_GridGeometryPath.createChildPath("Node Type");
+
+/**
+ * @brief Creates a bumpy grid surface of numX x numY vertices with an extra vertex that
+ * is not used by any triangle. The node types cycle through every smoothing category.
+ */
+void CreateGridSurface(DataStructure& dataStructure, usize numX, usize numY)
+{
+  auto* triangleGeom = TriangleGeom::Create(dataStructure, k_GridGeometryPath.getTargetName());
+  const usize numVertices = numX * numY + 1;
+  const usize numTriangles = (numX - 1) * (numY - 1) * 2;
+
+  auto* vertices = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, "Vertices", {numVertices}, {3}, triangleGeom->getId());
+  auto& vertexStore = vertices->getDataStoreRef();
+  for(usize y = 0; y < numY; y++)
+  {
+    for(usize x = 0; x < numX; x++)
+    {
+      const usize index = y * numX + x;
+      vertexStore[3 * index] = static_cast<float32>(x);
+      vertexStore[3 * index + 1] = static_cast<float32>(y);
+      vertexStore[3 * index + 2] = std::sin(0.7f * static_cast<float32>(x)) * std::cos(1.3f * static_cast<float32>(y)) + static_cast<float32>((x * 7 + y * 13) % 5) * 0.1f;
+    }
+  }
+  vertexStore[3 * (numVertices - 1)] = -5.0f;
+  vertexStore[3 * (numVertices - 1) + 1] = -5.0f;
+  vertexStore[3 * (numVertices - 1) + 2] = -5.0f;
+
+  auto* triangles = UInt64Array::CreateWithStore<UInt64DataStore>(dataStructure, "Triangles", {numTriangles}, {3}, triangleGeom->getId());
+  auto& triangleStore = triangles->getDataStoreRef();
+  usize triangle = 0;
+  for(usize y = 0; y < numY - 1; y++)
+  {
+    for(usize x = 0; x < numX - 1; x++)
+    {
+      const uint64 v0 = y * numX + x;
+      const uint64 v1 = v0 + 1;
+      const uint64 v2 = v0 + numX;
+      const uint64 v3 = v2 + 1;
+      for(uint64 vertex : {v0, v1, v3, v0, v3, v2})
+      {
+        triangleStore[triangle++] = vertex;
+      }
+    }
+  }
+
+  triangleGeom->setVertices(*vertices);
+  triangleGeom->setFaceList(*triangles);
+
+  const std::array<int8, 7> nodeTypes = {NodeType::Default,        NodeType::TriplePoint,        NodeType::QuadPoint,       NodeType::SurfaceDefault,
+                                         NodeType::SurfaceTriplePoint, NodeType::SurfaceQuadPoint, NodeType::Unused};
+  auto& nodeTypeStore = Int8Array::CreateWithStore<Int8DataStore>(dataStructure, k_GridNodeTypePath.getTargetName(), {numVertices}, {1}, triangleGeom->getId())->getDataStoreRef();
+  for(usize i = 0; i < numVertices; i++)
+  {
+    nodeTypeStore[i] = nodeTypes[i % nodeTypes.size()];
+  }
+}
+
+/**
+ * @brief The original serial smoothing that scatters the edge deltas into every vertex
+ * before moving the vertices. Vertices without edges are left in place.
+ */
+void ReferenceSmoothingPass(const IGeometry::SharedEdgeList& edges, const std::vector<float32>& lambdas, std::vector<float32>& verts)
+{
+  const usize nvert = verts.size() / 3;
+  std::vector<int32> numConnections(nvert, 0);
+  std::vector<float64> deltaArray(nvert * 3, 0.0);
+  for(usize i = 0; i < edges.getNumberOfTuples(); i++)
+  {
+    const usize in1 = edges[2 * i];
+    const usize in2 = edges[2 * i + 1];
+    for(usize j = 0; j < 3; j++)
+    {
+      const auto dlta = static_cast<float64>(verts[3 * in2 + j] - verts[3 * in1 + j]);
+      deltaArray[3 * in1 + j] += dlta;
+      deltaArray[3 * in2 + j] += -1.0 * dlta;
+    }
+    numConnections[in1] += 1;
+    numConnections[in2] += 1;
+  }
+  for(usize i = 0; i < nvert; i++)
+  {
+    if(numConnections[i] == 0)
+    {
+      continue;
+    }
+    for(usize j = 0; j < 3; j++)
+    {
+      verts[3 * i + j] += lambdas[i] * (deltaArray[3 * i + j] / numConnections[i]);
+    }
+  }
+}
+} // namespace
+
 TEST_CASE("ComplexCore::LaplacianSmoothingFilter", "[SurfaceMeshing][LaplacianSmoothingFilter]")
 {
   std::string triangleGeometryName = "[Triangle Geometry]";
@@ -118,6 +217,100 @@ TEST_CASE("ComplexCore::LaplacianSmoothingFilter", "[SurfaceMeshing][LaplacianSm
   REQUIRE(err >= 0);
 }
 
+TEST_CASE("ComplexCore::LaplacianSmoothingFilter: Compare With Reference", "[SurfaceMeshing][LaplacianSmoothingFilter]")
+{
+  const int32 iterationSteps = 4;
+  const float32 lambda = 0.2f;
+  const float32 muFactor = -1.03f;
+  const std::array<float32, 5> typeLambdas = {0.1f, 0.05f, 0.15f, 0.08f, 0.02f};
+
+  for(bool useTaubin : {false, true})
+  {
+    DYNAMIC_SECTION("Taubin: " << useTaubin)
+    {
+      DataStructure dataStructure;
+      CreateGridSurface(dataStructure, 301, 257);
+      auto& triangleGeom = dataStructure.getDataRefAs<TriangleGeom>(k_GridGeometryPath);
+      REQUIRE(triangleGeom.findEdges() >= 0);
+
+      // Run the reference on a copy of the original vertices
+      const auto& nodeTypes = dataStructure.getDataRefAs<Int8Array>(k_GridNodeTypePath);
+      std::vector<float32> lambdas(nodeTypes.getNumberOfTuples(), 0.0f);
+      for(usize i = 0; i < lambdas.size(); i++)
+      {
+        switch(nodeTypes[i])
+        {
+        case NodeType::Default:
+          lambdas[i] = lambda;
+          break;
+        case NodeType::TriplePoint:
+          lambdas[i] = typeLambdas[0];
+          break;
+        case NodeType::QuadPoint:
+          lambdas[i] = typeLambdas[1];
+          break;
+        case NodeType::SurfaceDefault:
+          lambdas[i] = typeLambdas[2];
+          break;
+        case NodeType::SurfaceTriplePoint:
+          lambdas[i] = typeLambdas[3];
+          break;
+        case NodeType::SurfaceQuadPoint:
+          lambdas[i] = typeLambdas[4];
+          break;
+        default:
+          break;
+        }
+      }
+      std::vector<float32> muLambdas(lambdas.size());
+      for(usize i = 0; i < lambdas.size(); i++)
+      {
+        muLambdas[i] = lambdas[i] * muFactor;
+      }
+      const auto& vertices = *triangleGeom.getVertices();
+      std::vector<float32> expected(vertices.begin(), vertices.end());
+      for(int32 step = 0; step < iterationSteps; step++)
+      {
+        ReferenceSmoothingPass(*triangleGeom.getEdges(), lambdas, expected);
+        if(useTaubin)
+        {
+          ReferenceSmoothingPass(*triangleGeom.getEdges(), muLambdas, expected);
+        }
+      }
+
+      LaplacianSmoothingFilter filter;
+      Arguments args;
+      args.insertOrAssign(LaplacianSmoothingFilter::k_IterationSteps_Key, std::make_any<int32>(iterationSteps));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_Lambda_Key, std::make_any<float32>(lambda));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_UseTaubinSmoothing_Key, std::make_any<bool>(useTaubin));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_MuFactor_Key, std::make_any<float32>(muFactor));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_TripleLineLambda_Key, std::make_any<float32>(typeLambdas[0]));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_QuadPointLambda_Key, std::make_any<float32>(typeLambdas[1]));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_SurfacePointLambda_Key, std::make_any<float32>(typeLambdas[2]));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_SurfaceTripleLineLambda_Key, std::make_any<float32>(typeLambdas[3]));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_SurfaceQuadPointLambda_Key, std::make_any<float32>(typeLambdas[4]));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_SurfaceMeshNodeTypeArrayPath_Key, std::make_any<DataPath>(k_GridNodeTypePath));
+      args.insertOrAssign(LaplacianSmoothingFilter::k_TriangleGeometryDataPath_Key, std::make_any<DataPath>(k_GridGeometryPath));
+
+      auto preflightResult = filter.preflight(dataStructure, args);
+      COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+      auto executeResult = filter.execute(dataStructure, args);
+      COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+      REQUIRE(vertices.getSize() == expected.size());
+      for(usize i = 0; i < expected.size(); i++)
+      {
+        if(std::abs(vertices[i] - expected[i]) > 1.0e-5f)
+        {
+          FAIL(fmt::format("Vertex value {} is {} but {} was expected", i, vertices[i], expected[i]));
+        }
+      }
+      // The vertex that is not part of any triangle does not move
+      REQUIRE(vertices[expected.size() - 1] == -5.0f);
+    }
+  }
+}
+
 // TEST_CASE("SurfaceMeshing::LaplacianSmoothingFilter: Valid filter execution")
 //{
 //
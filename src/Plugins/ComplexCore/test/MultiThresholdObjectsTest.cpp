@@ -0,0 +1,237 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/Parameters/ArrayThresholdsParameter.hpp"
+#include "complex/UnitTest/UnitTestCommon.hpp"
+#include "complex/Utilities/ArrayThreshold.hpp"
+
+#include "ComplexCore/Filters/MultiThresholdObjects.hpp"
+
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace complex;
+
+namespace
+{
+const DataPath k_Int8Path({"Int8"});
+const DataPath k_UInt16Path({"UInt16"});
+const DataPath k_Int32Path({"Int32"});
+const DataPath k_Float32Path({"Float32"});
+const DataPath k_Float64Path({"Float64"});
+const DataPath k_MaskPath({"Mask"});
+
+template <typename T>
+void FillRandom(DataStructure& dataStructure, const DataPath& path, usize numTuples, std::mt19937_64& generator, T minValue, T maxValue)
+{
+  auto* dataArray = UnitTest::CreateTestDataArray<T>(dataStructure, path.getTargetName(), {numTuples}, {1});
+  auto& store = dataArray->getDataStoreRef();
+  if constexpr(std::is_floating_point_v<T>)
+  {
+    std::uniform_real_distribution<T> distribution(minValue, maxValue);
+    for(usize i = 0; i < numTuples; i++)
+    {
+      store[i] = distribution(generator);
+    }
+  }
+  else
+  {
+    std::uniform_int_distribution<int64> distribution(minValue, maxValue);
+    for(usize i = 0; i < numTuples; i++)
+    {
+      store[i] = static_cast<T>(distribution(generator));
+    }
+  }
+}
+
+DataStructure CreateTestData(usize numTuples)
+{
+  std::mt19937_64 generator(numTuples);
+  DataStructure dataStructure;
+  FillRandom<int8>(dataStructure, k_Int8Path, numTuples, generator, -10, 10);
+  FillRandom<uint16>(dataStructure, k_UInt16Path, numTuples, generator, 0, 500);
+  FillRandom<int32>(dataStructure, k_Int32Path, numTuples, generator, -1000, 1000);
+  FillRandom<float32>(dataStructure, k_Float32Path, numTuples, generator, -1.0f, 1.0f);
+  FillRandom<float64>(dataStructure, k_Float64Path, numTuples, generator, 0.0, 100.0);
+  return dataStructure;
+}
+
+std::shared_ptr<ArrayThreshold> CreateThreshold(const DataPath& path, ArrayThreshold::ComparisonType comparisonType, float64 value,
+                                                IArrayThreshold::UnionOperator unionOperator = IArrayThreshold::UnionOperator::And, bool inverted = false)
+{
+  auto threshold = std::make_shared<ArrayThreshold>();
+  threshold->setArrayPath(path);
+  threshold->setComparisonType(comparisonType);
+  threshold->setComparisonValue(value);
+  threshold->setUnionOperator(unionOperator);
+  threshold->setInverted(inverted);
+  return threshold;
+}
+
+std::shared_ptr<ArrayThresholdSet> CreateThresholdSet(const ArrayThresholdSet::CollectionType& thresholds, IArrayThreshold::UnionOperator unionOperator = IArrayThreshold::UnionOperator::And,
+                                                      bool inverted = false)
+{
+  auto thresholdSet = std::make_shared<ArrayThresholdSet>();
+  thresholdSet->setArrayThresholds(thresholds);
+  thresholdSet->setUnionOperator(unionOperator);
+  thresholdSet->setInverted(inverted);
+  return thresholdSet;
+}
+
+template <typename T>
+bool CompareValue(const IDataArray& dataArray, usize index, const ArrayThreshold& threshold)
+{
+  const T value = dynamic_cast<const DataArray<T>&>(dataArray)[index];
+  const T comparisonValue = static_cast<T>(threshold.getComparisonValue());
+  switch(threshold.getComparisonType())
+  {
+  case ArrayThreshold::ComparisonType::GreaterThan:
+    return value > comparisonValue;
+  case ArrayThreshold::ComparisonType::LessThan:
+    return value < comparisonValue;
+  case ArrayThreshold::ComparisonType::Operator_Equal:
+    return value == comparisonValue;
+  case ArrayThreshold::ComparisonType::Operator_NotEqual:
+    return value != comparisonValue;
+  }
+  return false;
+}
+
+/**
+ * @brief Evaluates the threshold tree for a single tuple without any of the block or mask
+ * machinery. Each node is inverted on its own and combined using its union operator.
+ */
+bool EvaluateThreshold(const DataStructure& dataStructure, const IArrayThreshold& threshold, usize index)
+{
+  bool result = false;
+  if(const auto* thresholdSet = dynamic_cast<const ArrayThresholdSet*>(&threshold); thresholdSet != nullptr)
+  {
+    bool first = true;
+    for(const auto& child : thresholdSet->getArrayThresholds())
+    {
+      const bool childResult = EvaluateThreshold(dataStructure, *child, index);
+      if(first)
+      {
+        result = childResult;
+        first = false;
+      }
+      else if(child->getUnionOperator() == IArrayThreshold::UnionOperator::Or)
+      {
+        result = result || childResult;
+      }
+      else
+      {
+        result = result && childResult;
+      }
+    }
+  }
+  else
+  {
+    const auto& arrayThreshold = dynamic_cast<const ArrayThreshold&>(threshold);
+    const auto& dataArray = dataStructure.getDataRefAs<IDataArray>(arrayThreshold.getArrayPath());
+    switch(dataArray.getDataType())
+    {
+    case DataType::int8:
+      result = CompareValue<int8>(dataArray, index, arrayThreshold);
+      break;
+    case DataType::uint16:
+      result = CompareValue<uint16>(dataArray, index, arrayThreshold);
+      break;
+    case DataType::int32:
+      result = CompareValue<int32>(dataArray, index, arrayThreshold);
+      break;
+    case DataType::float32:
+      result = CompareValue<float32>(dataArray, index, arrayThreshold);
+      break;
+    case DataType::float64:
+      result = CompareValue<float64>(dataArray, index, arrayThreshold);
+      break;
+    default:
+      FAIL("Unexpected data type in test data");
+    }
+  }
+  return threshold.isInverted() ? !result : result;
+}
+
+void RunAndCompare(DataStructure& dataStructure, const ArrayThresholdSet& thresholds)
+{
+  MultiThresholdObjects filter;
+  Arguments args;
+  args.insertOrAssign(MultiThresholdObjects::k_ArrayThresholds_Key, std::make_any<ArrayThresholdSet>(thresholds));
+  args.insertOrAssign(MultiThresholdObjects::k_CreatedDataPath_Key, std::make_any<DataPath>(k_MaskPath));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& mask = dataStructure.getDataRefAs<BoolArray>(k_MaskPath);
+  usize numTrue = 0;
+  for(usize i = 0; i < mask.getNumberOfTuples(); i++)
+  {
+    const bool expected = EvaluateThreshold(dataStructure, thresholds, i);
+    if(mask[i] != expected)
+    {
+      FAIL(fmt::format("Mask value at tuple {} is {} but {} was expected", i, mask[i], expected));
+    }
+    numTrue += expected ? 1 : 0;
+  }
+  // Make sure the thresholds are not trivially all true or all false
+  REQUIRE(numTrue > 0);
+  REQUIRE(numTrue < mask.getNumberOfTuples());
+}
+} // namespace
+
+TEST_CASE("ComplexCore::MultiThresholdObjects: Compare With Reference", "[ComplexCore][MultiThresholdObjects]")
+{
+  using ComparisonType = ArrayThreshold::ComparisonType;
+  using UnionOperator = IArrayThreshold::UnionOperator;
+
+  // Sizes that leave partial mask words and partial blocks
+  for(usize numTuples : {usize{1000}, usize{40001}})
+  {
+    DYNAMIC_SECTION("Tuples: " << numTuples)
+    {
+      SECTION("Single Comparisons")
+      {
+        for(ComparisonType comparisonType : {ComparisonType::GreaterThan, ComparisonType::LessThan, ComparisonType::Operator_Equal, ComparisonType::Operator_NotEqual})
+        {
+          DataStructure dataStructure = CreateTestData(numTuples);
+          ArrayThresholdSet thresholds;
+          thresholds.setArrayThresholds({CreateThreshold(k_Int8Path, comparisonType, 3.0)});
+          RunAndCompare(dataStructure, thresholds);
+        }
+      }
+      SECTION("Flat Set")
+      {
+        DataStructure dataStructure = CreateTestData(numTuples);
+        ArrayThresholdSet thresholds;
+        thresholds.setArrayThresholds({CreateThreshold(k_Float32Path, ComparisonType::GreaterThan, -0.5), CreateThreshold(k_UInt16Path, ComparisonType::LessThan, 300.0),
+                                       CreateThreshold(k_Int8Path, ComparisonType::Operator_Equal, 0.0, UnionOperator::Or)});
+        RunAndCompare(dataStructure, thresholds);
+      }
+      SECTION("Nested Sets")
+      {
+        DataStructure dataStructure = CreateTestData(numTuples);
+        auto innerSet = CreateThresholdSet({CreateThreshold(k_Float64Path, ComparisonType::LessThan, 25.0), CreateThreshold(k_Int8Path, ComparisonType::Operator_NotEqual, 1.0, UnionOperator::Or, true)},
+                                           UnionOperator::And, true);
+        auto middleSet = CreateThresholdSet({CreateThreshold(k_Int32Path, ComparisonType::GreaterThan, 0.0), innerSet}, UnionOperator::Or);
+        ArrayThresholdSet thresholds;
+        thresholds.setArrayThresholds({CreateThreshold(k_UInt16Path, ComparisonType::GreaterThan, 100.0), middleSet,
+                                       CreateThresholdSet({CreateThreshold(k_Float32Path, ComparisonType::LessThan, 0.75)}, UnionOperator::And)});
+        RunAndCompare(dataStructure, thresholds);
+      }
+      SECTION("Inverted Set")
+      {
+        DataStructure dataStructure = CreateTestData(numTuples);
+        ArrayThresholdSet thresholds;
+        thresholds.setArrayThresholds(
+            {CreateThresholdSet({CreateThreshold(k_Int32Path, ComparisonType::LessThan, 500.0), CreateThreshold(k_Float64Path, ComparisonType::GreaterThan, 50.0, UnionOperator::Or)}),
+             CreateThreshold(k_Int8Path, ComparisonType::GreaterThan, -5.0)});
+        thresholds.setInverted(true);
+        RunAndCompare(dataStructure, thresholds);
+      }
+    }
+  }
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch.hpp>
 
+#include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
@@ -11,10 +13,199 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/QuickSurfaceMeshFilter.hpp"
 
+#include <array>
+#include <map>
+#include <random>
+#include <set>
+
 using namespace complex;
 using namespace complex::UnitTest;
 using namespace complex::Constants;
 
+namespace
+{
+using FaceKey = std::array<int64, 4>;
+
+/**
+ * @brief Meshes a synthetic volume of blocky features with unit spacing and checks the
+ * triangles, vertices, node types and transferred cell data against the voxel faces
+ * computed directly from the feature ids.
+ */
+void CheckSyntheticSurfaceMesh(const SizeVec3& dims)
+{
+  DataStructure dataStructure;
+  ImageGeom* imageGeom = ImageGeom::Create(dataStructure, k_DataContainer);
+  imageGeom->setDimensions(dims);
+  imageGeom->setSpacing({1.0f, 1.0f, 1.0f});
+  imageGeom->setOrigin({0.0f, 0.0f, 0.0f});
+  auto* cellData = AttributeMatrix::Create(dataStructure, k_CellData, imageGeom->getId());
+  const AttributeMatrix::ShapeType cellShape = {dims[2], dims[1], dims[0]};
+  cellData->setShape(cellShape);
+  imageGeom->setCellData(*cellData);
+  auto* featureIds = UnitTest::CreateTestDataArray<int32>(dataStructure, k_FeatureIds, cellShape, {1}, cellData->getId());
+  auto* cellValues = UnitTest::CreateTestDataArray<float32>(dataStructure, "Values", cellShape, {1}, cellData->getId());
+
+  std::mt19937 generator(5489u);
+  std::uniform_int_distribution<int32> blockFeature(1, 6);
+  std::bernoulli_distribution noise(0.05);
+  std::map<std::array<usize, 3>, int32> blocks;
+  for(usize k = 0; k < dims[2]; k++)
+  {
+    for(usize j = 0; j < dims[1]; j++)
+    {
+      for(usize i = 0; i < dims[0]; i++)
+      {
+        const usize point = (k * dims[1] + j) * dims[0] + i;
+        auto blockIter = blocks.try_emplace({i / 4, j / 3, k / 2}, 0).first;
+        if(blockIter->second == 0)
+        {
+          blockIter->second = blockFeature(generator);
+        }
+        (*featureIds)[point] = noise(generator) ? blockFeature(generator) : blockIter->second;
+        (*cellValues)[point] = static_cast<float32>(point);
+      }
+    }
+  }
+
+  // Expected faces keyed by (axis, minimum corner), with their labels and transferred cell
+  std::map<FaceKey, std::pair<std::array<int32, 2>, usize>> expectedFaces;
+  for(usize k = 0; k < dims[2]; k++)
+  {
+    for(usize j = 0; j < dims[1]; j++)
+    {
+      for(usize i = 0; i < dims[0]; i++)
+      {
+        const std::array<usize, 3> voxel = {i, j, k};
+        const usize point = (k * dims[1] + j) * dims[0] + i;
+        const std::array<usize, 3> strides = {1, dims[0], dims[0] * dims[1]};
+        const int32 featureId = featureIds->at(point);
+        for(usize axis = 0; axis < 3; axis++)
+        {
+          FaceKey lowKey = {static_cast<int64>(axis), static_cast<int64>(i), static_cast<int64>(j), static_cast<int64>(k)};
+          FaceKey highKey = lowKey;
+          highKey[axis + 1]++;
+          if(voxel[axis] == 0)
+          {
+            expectedFaces[lowKey] = {{-1, featureId}, point};
+          }
+          if(voxel[axis] == dims[axis] - 1)
+          {
+            expectedFaces[highKey] = {{-1, featureId}, point};
+          }
+          else
+          {
+            const usize neighbor = point + strides[axis];
+            const int32 neighborId = featureIds->at(neighbor);
+            if(neighborId != featureId)
+            {
+              expectedFaces[highKey] = {{std::min(featureId, neighborId), std::max(featureId, neighborId)}, neighbor};
+            }
+          }
+        }
+      }
+    }
+  }
+
+  Arguments args;
+  QuickSurfaceMeshFilter filter;
+  const DataPath gridGeomDataPath({k_DataContainer});
+  const DataPath cellDataPath = gridGeomDataPath.createChildPath(k_CellData);
+  const DataPath triangleGeometryPath({k_TriangleGeometryName});
+  const DataPath nodeTypeDataPath = triangleGeometryPath.createChildPath(k_VertexDataGroupName).createChildPath(k_NodeTypeArrayName);
+  const DataPath faceGroupDataPath = triangleGeometryPath.createChildPath(k_FaceDataGroupName);
+  const DataPath faceLabelsDataPath = faceGroupDataPath.createChildPath(k_FaceLabels);
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_GenerateTripleLines_Key, std::make_any<bool>(false));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FixProblemVoxels_Key, std::make_any<bool>(false));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_GridGeometryDataPath_Key, std::make_any<DataPath>(gridGeomDataPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_CellFeatureIdsArrayPath_Key, std::make_any<DataPath>(cellDataPath.createChildPath(k_FeatureIds)));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_SelectedDataArrayPaths_Key, std::make_any<MultiArraySelectionParameter::ValueType>(MultiArraySelectionParameter::ValueType{cellDataPath.createChildPath("Values")}));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_TriangleGeometryName_Key, std::make_any<DataPath>(triangleGeometryPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_VertexDataGroupName_Key, std::make_any<std::string>(k_VertexDataGroupName));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_NodeTypesArrayName_Key, std::make_any<DataPath>(nodeTypeDataPath));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FaceDataGroupName_Key, std::make_any<std::string>(k_FaceDataGroupName));
+  args.insertOrAssign(QuickSurfaceMeshFilter::k_FaceLabelsArrayName_Key, std::make_any<DataPath>(faceLabelsDataPath));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  const auto& triangleGeom = dataStructure.getDataRefAs<TriangleGeom>(triangleGeometryPath);
+  const auto& triangles = *triangleGeom.getFaces();
+  const auto& vertices = *triangleGeom.getVertices();
+  const auto& faceLabels = dataStructure.getDataRefAs<Int32Array>(faceLabelsDataPath);
+  const auto& nodeTypes = dataStructure.getDataRefAs<Int8Array>(nodeTypeDataPath);
+  const auto& faceValues = dataStructure.getDataRefAs<Float32Array>(faceGroupDataPath.createChildPath("Values"));
+
+  REQUIRE(triangles.getNumberOfTuples() == 2 * expectedFaces.size());
+  REQUIRE(faceValues.getNumberOfTuples() == triangles.getNumberOfTuples());
+
+  // Every vertex sits on a distinct grid node and its type follows from the faces around it
+  std::map<std::array<int64, 3>, std::set<int32>> expectedOwners;
+  for(const auto& [key, face] : expectedFaces)
+  {
+    const usize axis = static_cast<usize>(key[0]);
+    for(int64 corner = 0; corner < 4; corner++)
+    {
+      std::array<int64, 3> node = {key[1], key[2], key[3]};
+      node[(axis + 1) % 3] += corner & 1;
+      node[(axis + 2) % 3] += (corner >> 1) & 1;
+      expectedOwners[node].insert(face.first.begin(), face.first.end());
+    }
+  }
+  REQUIRE(vertices.getNumberOfTuples() == expectedOwners.size());
+  std::vector<std::array<int64, 3>> vertexNodes(vertices.getNumberOfTuples());
+  std::set<std::array<int64, 3>> uniqueNodes;
+  for(usize v = 0; v < vertexNodes.size(); v++)
+  {
+    vertexNodes[v] = {static_cast<int64>(vertices[v * 3]), static_cast<int64>(vertices[v * 3 + 1]), static_cast<int64>(vertices[v * 3 + 2])};
+    REQUIRE(uniqueNodes.insert(vertexNodes[v]).second);
+    auto ownersIter = expectedOwners.find(vertexNodes[v]);
+    REQUIRE(ownersIter != expectedOwners.end());
+    const std::set<int32>& owners = ownersIter->second;
+    const int8 expectedType = static_cast<int8>(std::min<usize>(owners.size(), 4) + (owners.count(-1) != 0 ? 10 : 0));
+    REQUIRE(nodeTypes[v] == expectedType);
+  }
+
+  // Every expected face is covered by exactly two triangles carrying its labels and cell data
+  std::map<FaceKey, usize> trianglesPerFace;
+  for(usize t = 0; t < triangles.getNumberOfTuples(); t++)
+  {
+    std::array<int64, 3> minNode = vertexNodes[triangles[t * 3]];
+    std::array<int64, 3> maxNode = minNode;
+    for(usize c = 1; c < 3; c++)
+    {
+      const std::array<int64, 3>& node = vertexNodes[triangles[t * 3 + c]];
+      for(usize axis = 0; axis < 3; axis++)
+      {
+        minNode[axis] = std::min(minNode[axis], node[axis]);
+        maxNode[axis] = std::max(maxNode[axis], node[axis]);
+      }
+    }
+    int64 faceAxis = -1;
+    for(usize axis = 0; axis < 3; axis++)
+    {
+      if(minNode[axis] == maxNode[axis])
+      {
+        faceAxis = static_cast<int64>(axis);
+      }
+    }
+    const FaceKey key = {faceAxis, minNode[0], minNode[1], minNode[2]};
+    auto faceIter = expectedFaces.find(key);
+    REQUIRE(faceIter != expectedFaces.end());
+    REQUIRE(faceLabels[t * 2] == faceIter->second.first[0]);
+    REQUIRE(faceLabels[t * 2 + 1] == faceIter->second.first[1]);
+    REQUIRE(faceValues[t] == cellValues->at(faceIter->second.second));
+    trianglesPerFace[key]++;
+  }
+  REQUIRE(trianglesPerFace.size() == expectedFaces.size());
+  for(const auto& [key, count] : trianglesPerFace)
+  {
+    REQUIRE(count == 2);
+  }
+}
+} // namespace
+
 TEST_CASE("ComplexCore::QuickSurfaceMeshFilter", "[ComplexCore][QuickSurfaceMeshFilter]")
 {
   // Read the Small IN100 Data set
@@ -104,3 +295,15 @@ TEST_CASE("ComplexCore::QuickSurfaceMeshFilter", "[ComplexCore][QuickSurfaceMesh
     REQUIRE(err >= 0);
   }
 }
+
+TEST_CASE("ComplexCore::QuickSurfaceMeshFilter: Synthetic Volume", "[ComplexCore][QuickSurfaceMeshFilter]")
+{
+  SECTION("3D")
+  {
+    CheckSyntheticSurfaceMesh({13, 11, 17});
+  }
+  SECTION("Single Slice")
+  {
+    CheckSyntheticSurfaceMesh({16, 9, 1});
+  }
+}
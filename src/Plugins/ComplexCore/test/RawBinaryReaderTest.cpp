@@ -9,6 +9,8 @@
  *  Case4: This tests when skipHeaderBytes is non-zero, and checks to see if the data read is the same as the data written.
  *
  *  Case5: This tests when skipHeaderBytes equals the file size
+ *
+ *  Case6: This tests converting the values to another type while they are read, for both byte orders and read modes.
  */
 
 /** we are going to use a fairly large array size because we want to exercise the
@@ -20,6 +22,9 @@
 
 #include "ComplexCore/Filters/RawBinaryReaderFilter.hpp"
 
+#include "ComplexCore/Filters/Algorithms/RawBinaryReader.hpp"
+
+#include "complex/Common/Bit.hpp"
 #include "complex/Common/ScopeGuard.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
@@ -30,8 +35,10 @@
 #include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Parameters/NumericTypeParameter.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
@@ -312,6 +319,51 @@ void TestCase5_TestPrimitives(NumericType scalarType)
   TestCase5_Execute<T, 3>(scalarType);
 }
 
+// -----------------------------------------------------------------------------
+// Case6: This tests converting the values to another type while they are read, for both byte orders and read modes.
+template <class T, class U>
+void TestCase6_Execute(NumericType scalarType, NumericType outputType, const std::vector<T>& values, const std::vector<U>& expectedValues)
+{
+  for(auto endianValue : {endian::little, endian::big})
+  {
+    std::vector<T> fileValues = values;
+    if(endianValue != endian::native)
+    {
+      std::transform(fileValues.begin(), fileValues.end(), fileValues.begin(), [](T value) { return complex::byteswap(value); });
+    }
+
+    // Create scope guard to remove file after this test goes out of scope
+    auto fileGuard = MakeScopeGuard([]() noexcept { fs::remove(k_TestOutput); });
+    REQUIRE(CreateTestDataFile<T>(fileValues));
+
+    for(ChoicesParameter::ValueType readMode : {k_StreamedReadMode, k_MemoryMappedReadMode})
+    {
+      RawBinaryReaderFilter filter;
+      Arguments args = CreateFilterArguments(scalarType, 1, values.size(), 0);
+      args.insertOrAssign(RawBinaryReaderFilter::k_Endian_Key, std::make_any<ChoicesParameter::ValueType>(static_cast<uint64>(endianValue)));
+      args.insertOrAssign(RawBinaryReaderFilter::k_ConvertScalarType_Key, std::make_any<bool>(true));
+      args.insertOrAssign(RawBinaryReaderFilter::k_OutputScalarType_Key, std::make_any<NumericType>(outputType));
+      args.insertOrAssign(RawBinaryReaderFilter::k_ReadMode_Key, std::make_any<ChoicesParameter::ValueType>(readMode));
+
+      DataStructure ds;
+      auto preflightResult = filter.preflight(ds, args);
+      COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+      auto executeResult = filter.execute(ds, args);
+      COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+      const auto& createdArray = ds.getDataRefAs<DataArray<U>>(k_CreatedArrayPath);
+      REQUIRE(createdArray.getSize() == expectedValues.size());
+      for(usize i = 0; i < expectedValues.size(); ++i)
+      {
+        if(createdArray[i] != expectedValues[i])
+        {
+          FAIL(fmt::format("Value {} is {} but {} was expected (endian {}, read mode {})", i, createdArray[i], expectedValues[i], static_cast<int32>(endianValue), readMode));
+        }
+      }
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 template <class T>
 void TestCase4_TestPrimitives(NumericType scalarType)
@@ -393,3 +445,36 @@ TEST_CASE("ComplexCore::RawBinaryReaderFilter(Case5)", "[ComplexCore][RawBinaryR
   TestCase5_TestPrimitives<float32>(NumericType::float32);
   TestCase5_TestPrimitives<float64>(NumericType::float64);
 }
+
+// Case6: This tests converting the values to another type while they are read, for both byte orders and read modes.
+TEST_CASE("ComplexCore::RawBinaryReaderFilter(Case6)", "[ComplexCore][RawBinaryReaderFilter]")
+{
+  // Create the parent directory path
+  fs::create_directories(k_TestOutput.parent_path());
+
+  SECTION("UInt16 To Float32")
+  {
+    // Several read blocks
+    std::vector<uint16> values(10000000);
+    std::vector<float32> expectedValues(values.size());
+    for(usize i = 0; i < values.size(); ++i)
+    {
+      values[i] = static_cast<uint16>(i * 7);
+      expectedValues[i] = static_cast<float32>(values[i]);
+    }
+    TestCase6_Execute<uint16, float32>(NumericType::uint16, NumericType::float32, values, expectedValues);
+  }
+  SECTION("Int32 Without Conversion")
+  {
+    std::vector<int32> values(5000000);
+    std::iota(values.begin(), values.end(), -2500000);
+    TestCase6_Execute<int32, int32>(NumericType::int32, NumericType::int32, values, values);
+  }
+  SECTION("Float64 To Int16")
+  {
+    // Out of range values are clamped and NaN becomes zero
+    const std::vector<float64> values = {-1.0e6, -3.7, 0.5, 3.7, 40000.0, std::numeric_limits<float64>::quiet_NaN()};
+    const std::vector<int16> expectedValues = {-32768, -3, 0, 3, 32767, 0};
+    TestCase6_Execute<float64, int16>(NumericType::float64, NumericType::int16, values, expectedValues);
+  }
+}
@@ -8,14 +8,135 @@
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/StlFileReaderFilter.hpp"
+#include "ComplexCore/utils/StlUtilities.hpp"
 
+#include <array>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <string>
+#include <vector>
 namespace fs = std::filesystem;
 
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+using Triangle = std::array<float32, 12>;
+
+/**
+ * @brief Triangulates a flat n x n grid of quads. Every other triangle stores its z
+ * values as -0.0 which must still be welded to the 0.0 of its neighbors.
+ */
+std::vector<Triangle> CreateGridTriangles(usize n)
+{
+  std::vector<Triangle> triangles;
+  for(usize y = 0; y < n; y++)
+  {
+    for(usize x = 0; x < n; x++)
+    {
+      const auto x0 = static_cast<float32>(x) * 0.5F;
+      const auto y0 = static_cast<float32>(y) * 0.25F;
+      const float32 x1 = x0 + 0.5F;
+      const float32 y1 = y0 + 0.25F;
+      triangles.push_back({0.0F, 0.0F, 1.0F, x0, y0, 0.0F, x1, y0, 0.0F, x1, y1, 0.0F});
+      triangles.push_back({0.0F, 0.0F, -1.0F, x0, y0, -0.0F, x1, y1, -0.0F, x0, y1, -0.0F});
+    }
+  }
+  return triangles;
+}
+
+/**
+ * @brief Writes a binary STL file. Every attributeInterval-th triangle gets two bytes of
+ * attribute data if the interval is not zero.
+ */
+void WriteBinaryStl(const fs::path& path, const std::vector<Triangle>& triangles, usize attributeInterval)
+{
+  std::ofstream file(path, std::ios::binary);
+  std::array<char, StlConstants::k_STL_HEADER_LENGTH> header = {};
+  std::strncpy(header.data(), "binary grid", header.size());
+  file.write(header.data(), header.size());
+  const auto triCount = static_cast<int32>(triangles.size());
+  file.write(reinterpret_cast<const char*>(&triCount), sizeof(triCount));
+  for(usize t = 0; t < triangles.size(); t++)
+  {
+    file.write(reinterpret_cast<const char*>(triangles[t].data()), sizeof(Triangle));
+    const uint16 attributeByteCount = (attributeInterval > 0 && t % attributeInterval == 0) ? 2 : 0;
+    file.write(reinterpret_cast<const char*>(&attributeByteCount), sizeof(attributeByteCount));
+    if(attributeByteCount > 0)
+    {
+      file.write("\xff\xff", attributeByteCount);
+    }
+  }
+}
+
+void WriteAsciiStl(const fs::path& path, const std::vector<Triangle>& triangles)
+{
+  std::ofstream file(path, std::ios::binary);
+  file << "solid ascii grid\n";
+  for(const Triangle& triangle : triangles)
+  {
+    file << fmt::format("  facet normal {} {} {}\n    outer loop\n", triangle[0], triangle[1], triangle[2]);
+    for(usize v = 0; v < 3; v++)
+    {
+      file << fmt::format("      vertex {:e} {} {}\r\n", triangle[3 + v * 3], triangle[4 + v * 3], triangle[5 + v * 3]);
+    }
+    file << "    endloop\n  endfacet\n";
+  }
+  file << "endsolid ascii grid\n";
+}
+
+Result<> ReadStlFile(DataStructure& dataStructure, const fs::path& path, const DataPath& geometryPath, bool scaleOutput = false, float32 scaleFactor = 1.0F)
+{
+  StlFileReaderFilter filter;
+  Arguments args;
+  args.insertOrAssign(StlFileReaderFilter::k_StlFilePath_Key, std::make_any<FileSystemPathParameter::ValueType>(path));
+  args.insertOrAssign(StlFileReaderFilter::k_GeometryDataPath_Key, std::make_any<DataPath>(geometryPath));
+  args.insertOrAssign(StlFileReaderFilter::k_ScaleOutput, std::make_any<bool>(scaleOutput));
+  args.insertOrAssign(StlFileReaderFilter::k_ScaleFactor, std::make_any<float32>(scaleFactor));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+  return filter.execute(dataStructure, args).result;
+}
+
+/**
+ * @brief Checks that every face references welded vertices with the coordinates of the
+ * input triangle and that the vertices are numbered in the order they first appear.
+ */
+void CheckGeometry(const DataStructure& dataStructure, const DataPath& geometryPath, const std::vector<Triangle>& triangles, usize expectedVertices, float32 scale)
+{
+  const auto& triangleGeom = dataStructure.getDataRefAs<TriangleGeom>(geometryPath);
+  REQUIRE(triangleGeom.getNumberOfFaces() == triangles.size());
+  REQUIRE(triangleGeom.getNumberOfVertices() == expectedVertices);
+
+  const auto& faces = *triangleGeom.getFaces();
+  const auto& vertices = *triangleGeom.getVertices();
+  const auto& normals = dataStructure.getDataRefAs<Float64Array>(geometryPath.createChildPath(INodeGeometry2D::k_FaceDataName).createChildPath("FaceNormals"));
+  REQUIRE(normals.getNumberOfTuples() == triangles.size());
+
+  usize nextVertex = 0;
+  for(usize t = 0; t < triangles.size(); t++)
+  {
+    for(usize i = 0; i < 3; i++)
+    {
+      REQUIRE(normals[t * 3 + i] == static_cast<float64>(triangles[t][i]));
+    }
+    for(usize k = 0; k < 3; k++)
+    {
+      const auto vertex = static_cast<usize>(faces[t * 3 + k]);
+      REQUIRE(vertex <= nextVertex);
+      nextVertex = std::max(nextVertex, vertex + 1);
+      for(usize c = 0; c < 3; c++)
+      {
+        REQUIRE(vertices[vertex * 3 + c] == triangles[t][3 + k * 3 + c] * scale);
+      }
+    }
+  }
+}
+} // namespace
+
 TEST_CASE("ComplexCore::StlFileReaderFilter", "[ComplexCore][StlFileReaderFilter]")
 {
   // Instantiate the filter, a DataStructure object and an Arguments Object
@@ -49,3 +170,64 @@ TEST_CASE("ComplexCore::StlFileReaderFilter", "[ComplexCore][StlFileReaderFilter
   herr_t err = dataGraph.writeHdf5(fileWriter);
   REQUIRE(err >= 0);
 }
+
+TEST_CASE("ComplexCore::StlFileReaderFilter: Binary and ASCII Grid", "[ComplexCore][StlFileReaderFilter]")
+{
+  // Enough triangles for several decode blocks
+  constexpr usize k_GridSize = 100;
+  constexpr usize k_ExpectedVertices = (k_GridSize + 1) * (k_GridSize + 1);
+  const std::vector<Triangle> triangles = CreateGridTriangles(k_GridSize);
+  const DataPath geometryPath({"Grid"});
+
+  SECTION("Binary")
+  {
+    const fs::path filePath = fs::path(unit_test::k_BinaryDir.view()) / "StlFileReaderTest_Binary.stl";
+    WriteBinaryStl(filePath, triangles, 0);
+    DataStructure dataStructure;
+    Result<> result = ReadStlFile(dataStructure, filePath, geometryPath);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+    CheckGeometry(dataStructure, geometryPath, triangles, k_ExpectedVertices, 1.0F);
+  }
+  SECTION("Binary With Attribute Data")
+  {
+    const fs::path filePath = fs::path(unit_test::k_BinaryDir.view()) / "StlFileReaderTest_Attributes.stl";
+    WriteBinaryStl(filePath, triangles, 7);
+    DataStructure dataStructure;
+    Result<> result = ReadStlFile(dataStructure, filePath, geometryPath);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+    CheckGeometry(dataStructure, geometryPath, triangles, k_ExpectedVertices, 1.0F);
+  }
+  SECTION("Truncated Binary")
+  {
+    const fs::path filePath = fs::path(unit_test::k_BinaryDir.view()) / "StlFileReaderTest_Truncated.stl";
+    WriteBinaryStl(filePath, triangles, 0);
+    fs::resize_file(filePath, fs::file_size(filePath) - 20);
+    DataStructure dataStructure;
+    Result<> result = ReadStlFile(dataStructure, filePath, geometryPath);
+    COMPLEX_RESULT_REQUIRE_INVALID(result);
+  }
+  SECTION("ASCII")
+  {
+    const fs::path filePath = fs::path(unit_test::k_BinaryDir.view()) / "StlFileReaderTest_Ascii.stl";
+    WriteAsciiStl(filePath, triangles);
+    DataStructure dataStructure;
+    Result<> result = ReadStlFile(dataStructure, filePath, geometryPath);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+    CheckGeometry(dataStructure, geometryPath, triangles, k_ExpectedVertices, 1.0F);
+  }
+  SECTION("Scaled")
+  {
+    const fs::path filePath = fs::path(unit_test::k_BinaryDir.view()) / "StlFileReaderTest_Binary.stl";
+    WriteBinaryStl(filePath, triangles, 0);
+    DataStructure dataStructure;
+    Result<> result = ReadStlFile(dataStructure, filePath, geometryPath, true, 2.0F);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+    CheckGeometry(dataStructure, geometryPath, triangles, k_ExpectedVertices, 2.0F);
+
+    // The factor is ignored unless scaling is enabled
+    DataStructure unscaledDataStructure;
+    Result<> unscaledResult = ReadStlFile(unscaledDataStructure, filePath, geometryPath, false, 2.0F);
+    COMPLEX_RESULT_REQUIRE_VALID(unscaledResult);
+    CheckGeometry(unscaledDataStructure, geometryPath, triangles, k_ExpectedVertices, 1.0F);
+  }
+}
@@ -5,6 +5,10 @@
 
 #include "complex/Common/Types.hpp"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #ifdef _WIN32
 #define COMPLEX_BYTE_ORDER little
 #elif defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && defined(__ORDER_BIG_ENDIAN__)
@@ -120,4 +124,39 @@ inline constexpr T byteswap(T value) noexcept
     }
   }
 }
+
+/**
+ * @brief Returns the number of consecutive zero bits starting at the least significant bit.
+ * Returns 64 for a value of zero.
+ * @param value
+ * @return int32
+ */
+inline int32 countr_zero(uint64 value) noexcept
+{
+  if(value == 0)
+  {
+    return 64;
+  }
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanForward64(&index, value);
+  return static_cast<int32>(index);
+#else
+  return __builtin_ctzll(value);
+#endif
+}
+
+/**
+ * @brief Returns the number of set bits in the value.
+ * @param value
+ * @return int32
+ */
+inline int32 popcount(uint64 value) noexcept
+{
+#if defined(_MSC_VER)
+  return static_cast<int32>(__popcnt64(value));
+#else
+  return __builtin_popcountll(value);
+#endif
+}
 } // namespace complex
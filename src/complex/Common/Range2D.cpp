@@ -31,25 +31,25 @@ Range2D::RangeType Range2D::getRange() const
 // -----------------------------------------------------------------------------
 size_t Range2D::minRow() const
 {
-  return m_Range[0];
+  return m_Range[2];
 }
 
 // -----------------------------------------------------------------------------
 size_t Range2D::minCol() const
 {
-  return m_Range[1];
+  return m_Range[0];
 }
 
 // -----------------------------------------------------------------------------
 size_t Range2D::maxRow() const
 {
-  return m_Range[2];
+  return m_Range[3];
 }
 
 // -----------------------------------------------------------------------------
 size_t Range2D::maxCol() const
 {
-  return m_Range[3];
+  return m_Range[1];
 }
 
 // -----------------------------------------------------------------------------
@@ -4,11 +4,15 @@
 #include "complex/DataStructure/IDataStore.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
 
+#include <fmt/core.h>
 #include <nonstd/span.hpp>
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <stdexcept>
 
 namespace complex
 {
@@ -438,7 +442,73 @@ public:
    */
   virtual void fill(value_type value)
   {
-    std::fill(begin(), end(), value);
+    const usize totalSize = getSize();
+    const usize blockSize = std::min(totalSize, k_BulkBlockSize);
+    if(blockSize == 0)
+    {
+      return;
+    }
+    auto buffer = std::make_unique<value_type[]>(blockSize);
+    std::fill_n(buffer.get(), blockSize, value);
+    for(usize offset = 0; offset < totalSize; offset += blockSize)
+    {
+      const usize count = std::min(blockSize, totalSize - offset);
+      copyFromBuffer(offset, nonstd::span<const value_type>(buffer.get(), count));
+    }
+  }
+
+  /**
+   * @brief Returns a span over all the values in the store if the store is
+   * contiguous. Otherwise, returns an empty span.
+   * @return nonstd::span<value_type>
+   */
+  virtual nonstd::span<value_type> contiguousSpan()
+  {
+    return {};
+  }
+
+  /**
+   * @brief Returns a span over all the values in the store if the store is
+   * contiguous. Otherwise, returns an empty span.
+   * @return nonstd::span<const value_type>
+   */
+  virtual nonstd::span<const value_type> contiguousSpan() const
+  {
+    return {};
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the buffer.
+   * Subclasses override this to copy without a virtual call per value.
+   *
+   * Throws a std::out_of_range if the range extends past the end of the store.
+   * @param startIndex
+   * @param buffer
+   */
+  virtual void copyIntoBuffer(usize startIndex, nonstd::span<value_type> buffer) const
+  {
+    checkBulkRange(startIndex, buffer.size());
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      buffer[i] = getValue(startIndex + i);
+    }
+  }
+
+  /**
+   * @brief Copies the values in the buffer into the store starting at startIndex.
+   * Subclasses override this to copy without a virtual call per value.
+   *
+   * Throws a std::out_of_range if the range extends past the end of the store.
+   * @param startIndex
+   * @param buffer
+   */
+  virtual void copyFromBuffer(usize startIndex, nonstd::span<const value_type> buffer)
+  {
+    checkBulkRange(startIndex, buffer.size());
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      setValue(startIndex + i, buffer[i]);
+    }
   }
 
   /**
@@ -497,10 +567,29 @@ public:
       return false;
     }
 
-    auto srcBegin = source.begin() + (srcTupleOffset * sourceNumComponents);
-    auto srcEnd = srcBegin + (totalSrcTuples * sourceNumComponents);
-    auto dstBegin = begin() + (destTupleOffset * numComponents);
-    std::copy(srcBegin, srcEnd, dstBegin);
+    const usize srcStart = srcTupleOffset * sourceNumComponents;
+    const usize dstStart = destTupleOffset * numComponents;
+    const usize totalSize = totalSrcTuples * sourceNumComponents;
+    if(source.isContiguous())
+    {
+      copyFromBuffer(dstStart, source.contiguousSpan().subspan(srcStart, totalSize));
+      return true;
+    }
+    if(isContiguous())
+    {
+      source.copyIntoBuffer(srcStart, contiguousSpan().subspan(dstStart, totalSize));
+      return true;
+    }
+
+    const usize blockSize = std::min(totalSize, k_BulkBlockSize);
+    auto buffer = std::make_unique<value_type[]>(blockSize);
+    for(usize offset = 0; offset < totalSize; offset += blockSize)
+    {
+      const usize count = std::min(blockSize, totalSize - offset);
+      nonstd::span<value_type> block(buffer.get(), count);
+      source.copyIntoBuffer(srcStart + offset, block);
+      copyFromBuffer(dstStart + offset, block);
+    }
     return true;
   }
 
@@ -512,7 +601,15 @@ public:
   void fillTuple(index_type i, T value)
   {
     usize numComponents = getNumberOfComponents();
-    std::fill_n(begin() + (i * numComponents), numComponents, value);
+    if(isContiguous())
+    {
+      std::fill_n(contiguousSpan().begin() + (i * numComponents), numComponents, value);
+      return;
+    }
+    for(usize comp = 0; comp < numComponents; comp++)
+    {
+      setValue(i * numComponents + comp, value);
+    }
   }
 
   /**
@@ -561,7 +658,7 @@ public:
 
     index_type numComponents = getNumberOfComponents();
     index_type offset = tupleIndex * numComponents;
-    std::copy(values.begin(), values.end(), begin() + offset);
+    copyFromBuffer(offset, values);
   }
 
   /**
@@ -617,12 +714,175 @@ public:
   }
 
 protected:
+  /**
+   * @brief Number of values copied at a time by the default bulk operations.
+   */
+  static constexpr usize k_BulkBlockSize = 16384;
+
   /**
    * @brief Default constructor
    */
   AbstractDataStore()
   {
   }
+
+  /**
+   * @brief Throws a std::out_of_range if count values starting at startIndex
+   * do not fit inside the store.
+   * @param startIndex
+   * @param count
+   */
+  void checkBulkRange(usize startIndex, usize count) const
+  {
+    const usize totalSize = getSize();
+    if(startIndex > totalSize || count > totalSize - startIndex)
+    {
+      throw std::out_of_range(fmt::format("Range [{}, {}) is outside of the DataStore with {} values", startIndex, startIndex + count, totalSize));
+    }
+  }
+};
+
+/**
+ * @class ConstDataView
+ * @brief The ConstDataView class provides read-only access to the values of
+ * an AbstractDataStore without a virtual call per value. Contiguous stores are
+ * viewed in place. Other stores are read with copyIntoBuffer in chunks of
+ * k_ChunkSize values, and at most k_MaxChunks chunks are kept, so the view
+ * never holds more than a bounded part of the store in memory.
+ *
+ * Cached chunks are not updated when the store changes. Reading a value may
+ * load a chunk, so a view must not be shared between threads. Each thread
+ * should use its own copy, which starts with an empty cache.
+ * @tparam T
+ */
+template <typename T>
+class ConstDataView
+{
+public:
+  using value_type = T;
+
+  /**
+   * @brief Number of values read from the store at a time.
+   */
+  static constexpr usize k_ChunkSize = 16384;
+
+  /**
+   * @brief Maximum number of chunks kept by the view.
+   */
+  static constexpr usize k_MaxChunks = 8;
+
+  /**
+   * @brief Creates a view of all the values in the store.
+   * @param store
+   */
+  explicit ConstDataView(const AbstractDataStore<T>& store)
+  : m_Store(&store)
+  , m_Size(store.getSize())
+  {
+    if(store.isContiguous())
+    {
+      m_Values = store.contiguousSpan();
+    }
+  }
+
+  /**
+   * @brief Creates a view of the same store. Chunks are not shared with the
+   * other view, so the copy can be used on another thread.
+   * @param other
+   */
+  ConstDataView(const ConstDataView& other)
+  : m_Store(other.m_Store)
+  , m_Size(other.m_Size)
+  {
+    if(other.isContiguous())
+    {
+      m_Values = other.m_Values;
+    }
+  }
+
+  ConstDataView(ConstDataView&&) noexcept = default;
+  ConstDataView& operator=(const ConstDataView&) = delete;
+  ConstDataView& operator=(ConstDataView&&) noexcept = default;
+
+  ~ConstDataView() = default;
+
+  /**
+   * @brief Returns the value at the specified index.
+   * @param index
+   * @return value_type
+   */
+  value_type operator[](usize index) const
+  {
+    // Indices before m_Start wrap around and fail the comparison
+    if(index - m_Start < m_Values.size())
+    {
+      return m_Values[index - m_Start];
+    }
+    loadChunk(index);
+    return m_Values[index - m_Start];
+  }
+
+  /**
+   * @brief Returns the number of values in the view.
+   * @return usize
+   */
+  usize size() const
+  {
+    return m_Size;
+  }
+
+  /**
+   * @brief Returns true if the values are viewed in place rather than read in chunks.
+   * @return bool
+   */
+  bool isContiguous() const
+  {
+    return m_Store->isContiguous();
+  }
+
+private:
+  struct Chunk
+  {
+    usize start = 0;
+    usize count = 0;
+    std::unique_ptr<T[]> values;
+  };
+
+  /**
+   * @brief Makes the chunk containing index the current chunk, reading it
+   * from the store in place of the oldest chunk if it is not cached.
+   * @param index
+   */
+  void loadChunk(usize index) const
+  {
+    if(index >= m_Size)
+    {
+      throw std::out_of_range(fmt::format("Index ({}) is greater than or equal to the size of the ConstDataView ({})", index, m_Size));
+    }
+    const usize start = index - index % k_ChunkSize;
+    auto iter = std::find_if(m_Chunks.begin(), m_Chunks.end(), [start](const Chunk& chunk) { return chunk.values != nullptr && chunk.start == start; });
+    if(iter == m_Chunks.end())
+    {
+      iter = m_Chunks.begin() + m_NextChunk;
+      m_NextChunk = (m_NextChunk + 1) % k_MaxChunks;
+      if(iter->values == nullptr)
+      {
+        iter->values = std::make_unique<T[]>(k_ChunkSize);
+      }
+      iter->start = start;
+      iter->count = std::min(k_ChunkSize, m_Size - start);
+      m_Store->copyIntoBuffer(start, nonstd::span<T>(iter->values.get(), iter->count));
+    }
+    m_Start = iter->start;
+    m_Values = nonstd::span<const T>(iter->values.get(), iter->count);
+  }
+
+  const AbstractDataStore<T>* m_Store = nullptr;
+  usize m_Size = 0;
+  mutable nonstd::span<const T> m_Values;
+  mutable usize m_Start = 0;
+  mutable std::array<Chunk, k_MaxChunks> m_Chunks;
+  mutable usize m_NextChunk = 0;
 };
 
 template <typename Iter>
@@ -7,8 +7,12 @@
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/EmptyDataStore.hpp"
 #include "complex/DataStructure/IDataArray.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DataStructureWriter.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupWriter.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace complex
 {
 template <typename T>
@@ -25,6 +29,10 @@ constexpr StringLiteral k_TypeName = "DataArray<T>";
  * retrieve array data within the DataStructure. The DataArray is designed to
  * allow expandability into multiple sources of data, including out-of-core data,
  * through the use of derived DataStore classes.
+ *
+ * Shallow copies of a DataArray (such as those made when copying a DataStructure)
+ * share the DataStore copy-on-write: the first mutable access through any of the
+ * sharing arrays detaches it onto a private deep copy so the others keep their values.
  */
 template <class T>
 class DataArray : public IDataArray
@@ -147,13 +155,16 @@ public:
   /**
    * @brief Creates a copy of the specified tuple getSize, count, and smart
    * pointer to the target DataStore. This copy is not added to the
-   * DataStructure.
+   * DataStructure. The DataStore is shared copy-on-write between both arrays.
    * @param other
    */
   DataArray(const DataArray<T>& other)
   : IDataArray(other)
   , m_DataStore(other.m_DataStore)
+  , m_StoreOwners(other.m_StoreOwners)
+  , m_MaybeShared(true)
   {
+    other.m_MaybeShared = true;
   }
 
   /**
@@ -163,6 +174,8 @@ public:
   DataArray(DataArray<T>&& other)
   : IDataArray(std::move(other))
   , m_DataStore(std::move(other.m_DataStore))
+  , m_StoreOwners(std::move(other.m_StoreOwners))
+  , m_MaybeShared(other.m_MaybeShared.load())
   {
   }
 
@@ -256,6 +269,7 @@ public:
       throw std::runtime_error("DataArray::operator[] requires a valid DataStore");
     }
 
+    detachDataStore();
     return (*m_DataStore.get())[index];
   }
 
@@ -266,6 +280,7 @@ public:
    */
   void initializeTuple(usize tupleIndex, T value)
   {
+    detachDataStore();
     m_DataStore->fillTuple(tupleIndex, value);
   }
 
@@ -275,6 +290,7 @@ public:
    */
   void fill(T value)
   {
+    detachDataStore();
     m_DataStore->fill(value);
   }
 
@@ -291,6 +307,7 @@ public:
     {
       return;
     }
+    detachDataStore();
     const auto numComponents = getNumberOfComponents();
     for(usize i = 0; i < numComponents; i++)
     {
@@ -366,6 +383,7 @@ public:
    */
   store_type* getDataStore()
   {
+    detachDataStore();
     return m_DataStore.get();
   }
 
@@ -375,6 +393,7 @@ public:
    */
   IDataStore* getIDataStore() override
   {
+    detachDataStore();
     return m_DataStore.get();
   }
 
@@ -397,6 +416,7 @@ public:
     {
       throw std::runtime_error("DataArray: Null DataStore");
     }
+    detachDataStore();
     return *m_DataStore;
   }
 
@@ -444,6 +464,18 @@ public:
     {
       m_DataStore = std::make_shared<EmptyDataStore<T>>();
     }
+    m_StoreOwners = std::make_shared<uint8>(0);
+    m_MaybeShared = false;
+  }
+
+  /**
+   * @brief Returns true if the DataStore is currently shared copy-on-write with
+   * another DataArray, i.e. the next mutable access will detach it.
+   * @return bool
+   */
+  bool isDataStoreShared() const
+  {
+    return m_MaybeShared && m_StoreOwners.use_count() > 1;
   }
 
   /**
@@ -544,7 +576,14 @@ public:
    */
   DataArray& operator=(const DataArray& rhs)
   {
+    if(this == &rhs)
+    {
+      return *this;
+    }
     m_DataStore = rhs.m_DataStore;
+    m_StoreOwners = rhs.m_StoreOwners;
+    m_MaybeShared = true;
+    rhs.m_MaybeShared = true;
     return *this;
   }
 
@@ -556,6 +595,8 @@ public:
   DataArray& operator=(DataArray&& rhs) noexcept
   {
     m_DataStore = std::move(rhs.m_DataStore);
+    m_StoreOwners = std::move(rhs.m_StoreOwners);
+    m_MaybeShared = rhs.m_MaybeShared.load();
     return *this;
   }
 
@@ -632,11 +673,13 @@ public:
   H5::ErrorType writeHdf5(H5::DataStructureWriter& dataStructureWriter, H5::GroupWriter& parentGroupWriter, bool importable) const override
   {
     auto datasetWriter = parentGroupWriter.createDatasetWriter(getName());
+    datasetWriter.setCreationOptions(dataStructureWriter.getDatasetCreationOptions());
     auto err = m_DataStore->writeHdf5(datasetWriter);
     if(err < 0)
     {
       return err;
     }
+    dataStructureWriter.recordDatasetSize(datasetWriter);
     return writeH5ObjectAttributes(dataStructureWriter, datasetWriter, importable);
   }
 
@@ -673,7 +716,36 @@ protected:
   }
 
 private:
+  /**
+   * @brief Replaces a DataStore shared copy-on-write with other DataArrays by a
+   * private deep copy before handing out mutable access. Safe to call from
+   * several threads at once; only the first caller performs the copy.
+   */
+  void detachDataStore()
+  {
+    if(!m_MaybeShared.load(std::memory_order_acquire))
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_DetachMutex);
+    if(!m_MaybeShared.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    if(m_StoreOwners.use_count() > 1 && m_DataStore != nullptr)
+    {
+      std::shared_ptr<IDataStore> sharedStore = m_DataStore->deepCopy();
+      m_DataStore = std::dynamic_pointer_cast<store_type>(sharedStore);
+      m_StoreOwners = std::make_shared<uint8>(0);
+    }
+    m_MaybeShared.store(false, std::memory_order_release);
+  }
+
   std::shared_ptr<store_type> m_DataStore = nullptr;
+  // Shared by every DataArray referencing m_DataStore through shallow copies.
+  std::shared_ptr<uint8> m_StoreOwners = std::make_shared<uint8>(0);
+  mutable std::atomic_bool m_MaybeShared{false};
+  std::mutex m_DetachMutex;
 };
 
 // Declare extern templates
@@ -317,6 +317,64 @@ public:
     return {data(), this->getSize()};
   }
 
+  /**
+   * @brief Fills the DataStore with the specified value.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::fill_n(data(), this->getSize(), value);
+  }
+
+  /**
+   * @brief Returns true since the values are held in a single allocation.
+   * @return bool
+   */
+  bool isContiguous() const override
+  {
+    return true;
+  }
+
+  /**
+   * @brief Returns a span over all the values in the DataStore.
+   * @return nonstd::span<value_type>
+   */
+  nonstd::span<value_type> contiguousSpan() override
+  {
+    return createSpan();
+  }
+
+  /**
+   * @brief Returns a span over all the values in the DataStore.
+   * @return nonstd::span<const value_type>
+   */
+  nonstd::span<const value_type> contiguousSpan() const override
+  {
+    return createSpan();
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the buffer.
+   * @param startIndex
+   * @param buffer
+   */
+  void copyIntoBuffer(usize startIndex, nonstd::span<value_type> buffer) const override
+  {
+    this->checkBulkRange(startIndex, buffer.size());
+    std::copy_n(data() + startIndex, buffer.size(), buffer.data());
+  }
+
+  /**
+   * @brief Copies the values in the buffer into the DataStore starting at startIndex.
+   * @param startIndex
+   * @param buffer
+   */
+  void copyFromBuffer(usize startIndex, nonstd::span<const value_type> buffer) override
+  {
+    this->checkBulkRange(startIndex, buffer.size());
+    std::copy_n(buffer.data(), buffer.size(), data() + startIndex);
+  }
+
   /**
    * @brief Writes the data store to HDF5. Returns the HDF5 error code should
    * one be encountered. Otherwise, returns 0.
@@ -741,6 +741,11 @@ void DataStructure::applyAllDataStructure()
 H5::ErrorType DataStructure::writeHdf5(H5::GroupWriter& parentGroupWriter) const
 {
   H5::DataStructureWriter dataStructureWriter;
+  return writeHdf5(parentGroupWriter, dataStructureWriter);
+}
+
+H5::ErrorType DataStructure::writeHdf5(H5::GroupWriter& parentGroupWriter, H5::DataStructureWriter& dataStructureWriter) const
+{
   auto groupWriter = parentGroupWriter.createGroupWriter(Constants::k_DataStructureTag);
   auto idAttribute = groupWriter.createAttribute(Constants::k_NextIdTag);
   H5::ErrorType err = idAttribute.writeValue(m_NextId);
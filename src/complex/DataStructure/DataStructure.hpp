@@ -35,6 +35,7 @@ inline const std::string k_ImportableTag = "Importable";
 namespace H5
 {
 class DataStructureReader;
+class DataStructureWriter;
 class FileReader;
 class FileWriter;
 } // namespace H5
@@ -601,6 +602,17 @@ public:
    */
   H5::ErrorType writeHdf5(H5::GroupWriter& parentGroupWriter) const;
 
+  /**
+   * @brief Writes the DataStructure to the target HDF5 file or group using the
+   * provided DataStructureWriter. Dataset creation options set on the writer
+   * are applied to every written array and the writer accumulates the number
+   * of bytes written.
+   * @param parentGroupWriter HDF5 group writer
+   * @param dataStructureWriter
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5(H5::GroupWriter& parentGroupWriter, H5::DataStructureWriter& dataStructureWriter) const;
+
   /**
    * @brief Creates a DataStructure by reading the specified H5::GroupReader or
    * H5::FileReader. Passes any potential errors back to the caller by reference.
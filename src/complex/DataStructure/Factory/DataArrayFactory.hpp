@@ -4,6 +4,8 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/LazyDataStore.hpp"
+#include "complex/DataStructure/OutOfCoreDataStore.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DataStructureReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupReader.hpp"
@@ -38,7 +40,10 @@ public:
   }
 
   /**
-   * @brief Creates and imports a DataArray based on the provided DatasetReader
+   * @brief Creates and imports a DataArray based on the provided DatasetReader.
+   * When lazy loading, the values are read on first access through a
+   * LazyDataStore. Otherwise, arrays larger than OutOfCoreSettings::SizeThreshold()
+   * are imported into an OutOfCoreDataStore.
    * @param dataStructure
    * @param datasetReader
    * @param dataArrayName
@@ -46,13 +51,29 @@ public:
    * @param err
    * @param parentId
    * @param preflight
+   * @param lazyLoading
    */
   template <typename K>
   void importDataArray(DataStructure& dataStructure, const H5::DatasetReader& datasetReader, const std::string dataArrayName, DataObject::IdType importId, H5::ErrorType& err,
-                       const std::optional<DataObject::IdType>& parentId, bool preflight)
+                       const std::optional<DataObject::IdType>& parentId, bool preflight, bool lazyLoading)
   {
-    std::unique_ptr<AbstractDataStore<K>> dataStore =
-        preflight ? std::unique_ptr<AbstractDataStore<K>>(EmptyDataStore<K>::ReadHdf5(datasetReader)) : std::unique_ptr<AbstractDataStore<K>>(DataStore<K>::ReadHdf5(datasetReader));
+    std::unique_ptr<AbstractDataStore<K>> dataStore;
+    if(preflight)
+    {
+      dataStore = EmptyDataStore<K>::ReadHdf5(datasetReader);
+    }
+    else if(lazyLoading)
+    {
+      dataStore = LazyDataStore<K>::ReadHdf5(datasetReader);
+    }
+    else if(OutOfCoreSettings::ShouldUseOutOfCore(datasetReader.getNumElements() * sizeof(K)))
+    {
+      dataStore = OutOfCoreDataStore<K>::ReadHdf5(datasetReader);
+    }
+    else
+    {
+      dataStore = DataStore<K>::ReadHdf5(datasetReader);
+    }
     DataArray<K>* data = DataArray<K>::Import(dataStructure, dataArrayName, importId, std::move(dataStore), parentId);
     err = (data == nullptr) ? -400 : 0;
   }
@@ -107,41 +128,41 @@ public:
     switch(type)
     {
     case H5::Type::float32:
-      importDataArray<float32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<float32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     case H5::Type::float64:
-      importDataArray<float64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<float64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     case H5::Type::int8:
-      importDataArray<int8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     case H5::Type::int16:
-      importDataArray<int16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     case H5::Type::int32:
-      importDataArray<int32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     case H5::Type::int64:
-      importDataArray<int64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<int64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     case H5::Type::uint8:
       if(isBoolArray)
       {
-        importDataArray<bool>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+        importDataArray<bool>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       }
       else
       {
-        importDataArray<uint8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+        importDataArray<uint8>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       }
       break;
     case H5::Type::uint16:
-      importDataArray<uint16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint16>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     case H5::Type::uint32:
-      importDataArray<uint32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint32>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     case H5::Type::uint64:
-      importDataArray<uint64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight);
+      importDataArray<uint64>(dataStructureReader.getDataStructure(), datasetReader, dataArrayName, importId, err, parentId, preflight, dataStructureReader.isLazyLoading());
       break;
     default:
       err = -777;
@@ -10,6 +10,7 @@
 #include <memory>
 #include <numeric>
 #include <optional>
+#include <utility>
 
 namespace complex
 {
@@ -53,8 +54,8 @@ public:
                                  DataObject::IdType importId, const std::optional<DataObject::IdType>& parentId = {}, bool preflight = false)
   {
     using NeighborListType = NeighborList<K>;
-    auto dataVector = NeighborListType::ReadHdf5Data(parentReader, datasetReader);
-    NeighborListType::Import(dataStructure, dataArrayName, importId, dataVector, parentId);
+    auto lists = NeighborListType::ReadHdf5CompressedData(parentReader, datasetReader);
+    NeighborListType::Import(dataStructure, dataArrayName, importId, std::move(lists), parentId);
   }
 
   /**
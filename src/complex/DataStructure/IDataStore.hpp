@@ -34,6 +34,8 @@ public:
     Unknown = -1,
     InMemory = 0,
     Empty,
+    OutOfCore,
+    Lazy,
   };
 
   virtual ~IDataStore() = default;
@@ -94,6 +96,16 @@ public:
    */
   virtual usize getTypeSize() const = 0;
 
+  /**
+   * @brief Returns true if the values are held in a single contiguous block of
+   * memory.
+   * @return bool
+   */
+  virtual bool isContiguous() const
+  {
+    return false;
+  }
+
   /**
    * @brief Returns a deep copy of the data store and all its data.
    * @return std::unique_ptr<IDataStore>
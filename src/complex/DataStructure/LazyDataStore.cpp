@@ -0,0 +1,37 @@
+#include "LazyDataStore.hpp"
+
+using namespace complex;
+
+std::mutex& complex::GetLazyDataStoreReadMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+LazySourceStamp LazySourceStamp::Read(const std::filesystem::path& filePath)
+{
+  LazySourceStamp stamp;
+  std::error_code errorCode;
+  stamp.lastWriteTime = std::filesystem::last_write_time(filePath, errorCode);
+  if(errorCode)
+  {
+    return {};
+  }
+  stamp.fileSize = std::filesystem::file_size(filePath, errorCode);
+  if(errorCode)
+  {
+    return {};
+  }
+  stamp.exists = true;
+  return stamp;
+}
+
+bool LazySourceStamp::operator==(const LazySourceStamp& rhs) const
+{
+  return exists == rhs.exists && lastWriteTime == rhs.lastWriteTime && fileSize == rhs.fileSize;
+}
+
+bool LazySourceStamp::operator!=(const LazySourceStamp& rhs) const
+{
+  return !(*this == rhs);
+}
@@ -0,0 +1,565 @@
+#pragma once
+
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/OutOfCoreDataStore.hpp"
+#include "complex/DataStructure/OutOfCoreSettings.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetWriter.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
+#include "complex/complex_export.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @brief Returns the process-wide mutex held while any LazyDataStore reads
+ * its values. The HDF5 library is not built thread safe, so loads started by
+ * parallel algorithms on different stores must not overlap.
+ * @return std::mutex&
+ */
+COMPLEX_EXPORT std::mutex& GetLazyDataStoreReadMutex();
+
+/**
+ * @brief Identifies the state of a file on disk by its modification time and
+ * size, so that a LazyDataStore can tell whether its source file was modified
+ * or replaced after the array was imported.
+ */
+struct COMPLEX_EXPORT LazySourceStamp
+{
+  bool exists = false;
+  std::filesystem::file_time_type lastWriteTime = {};
+  std::uintmax_t fileSize = 0;
+
+  /**
+   * @brief Reads the stamp of the file at filePath. A file that cannot be
+   * queried gives a stamp with exists set to false.
+   * @param filePath
+   * @return LazySourceStamp
+   */
+  static LazySourceStamp Read(const std::filesystem::path& filePath);
+
+  bool operator==(const LazySourceStamp& rhs) const;
+  bool operator!=(const LazySourceStamp& rhs) const;
+};
+
+/**
+ * @class LazyDataStore
+ * @brief The LazyDataStore class stands in for an array stored in an HDF5
+ * file. Only the file path, the dataset path and the array shape are kept
+ * until the values are first accessed element by element, at which point the
+ * whole dataset is read into a DataStore, or into an OutOfCoreDataStore when
+ * OutOfCoreSettings::ShouldUseOutOfCore() says so for its size. Arrays that
+ * are never accessed are never read. Until then the store is not contiguous
+ * and copyIntoBuffer() reads only the requested values from the file.
+ *
+ * The file is reopened for every read rather than held open. Its modification
+ * time and size are recorded when the store is created, and reading from a
+ * file that was modified or replaced since then throws a std::runtime_error.
+ * Loading is thread safe: concurrent accesses to one store read it once, and
+ * reads from different stores are serialized through
+ * GetLazyDataStoreReadMutex().
+ * @tparam T
+ */
+template <typename T>
+class LazyDataStore : public AbstractDataStore<T>
+{
+public:
+  using value_type = typename AbstractDataStore<T>::value_type;
+  using reference = typename AbstractDataStore<T>::reference;
+  using const_reference = typename AbstractDataStore<T>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+
+  /**
+   * @brief Constructs a LazyDataStore for the dataset at datasetPath inside
+   * the HDF5 file at filePath. The dataset is not opened until the values
+   * are accessed.
+   * @param tupleShape
+   * @param componentShape
+   * @param filePath
+   * @param datasetPath
+   */
+  LazyDataStore(const ShapeType& tupleShape, const ShapeType& componentShape, std::filesystem::path filePath, std::string datasetPath)
+  : m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_FilePath(std::move(filePath))
+  , m_DatasetPath(std::move(datasetPath))
+  , m_SourceStamp(LazySourceStamp::Read(m_FilePath))
+  {
+  }
+
+  /**
+   * @brief Copy constructor. Copies the loaded values if the other store has
+   * been loaded. Otherwise, the copy reads from the same dataset when needed.
+   * @param other
+   */
+  LazyDataStore(const LazyDataStore& other)
+  : m_ComponentShape(other.m_ComponentShape)
+  , m_TupleShape(other.m_TupleShape)
+  , m_FilePath(other.m_FilePath)
+  , m_DatasetPath(other.m_DatasetPath)
+  , m_SourceStamp(other.m_SourceStamp)
+  {
+    std::lock_guard<std::mutex> lock(other.m_Mutex);
+    if(other.m_Store != nullptr)
+    {
+      m_Store.reset(dynamic_cast<AbstractDataStore<T>*>(other.m_Store->deepCopy().release()));
+      m_Loaded = true;
+    }
+  }
+
+  LazyDataStore(LazyDataStore&& other) = delete;
+  LazyDataStore& operator=(const LazyDataStore& rhs) = delete;
+  LazyDataStore& operator=(LazyDataStore&& rhs) = delete;
+
+  ~LazyDataStore() override = default;
+
+  /**
+   * @brief Returns the number of tuples in the DataStore.
+   * @return usize
+   */
+  usize getNumberOfTuples() const override
+  {
+    return std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>());
+  }
+
+  /**
+   * @brief Returns the number of elements in each Tuple.
+   * @return usize
+   */
+  usize getNumberOfComponents() const override
+  {
+    return std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<usize>(1), std::multiplies<>());
+  }
+
+  /**
+   * @brief Returns the dimensions of the Tuples
+   * @return
+   */
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Components
+   * @return
+   */
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  /**
+   * @brief Returns the store type e.g. in memory, out of core, etc.
+   * @return StoreType
+   */
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::Lazy;
+  }
+
+  /**
+   * @brief Returns the path to the HDF5 file the values are read from.
+   * @return const std::filesystem::path&
+   */
+  const std::filesystem::path& getFilePath() const
+  {
+    return m_FilePath;
+  }
+
+  /**
+   * @brief Returns the path of the dataset inside the HDF5 file.
+   * @return const std::string&
+   */
+  const std::string& getDatasetPath() const
+  {
+    return m_DatasetPath;
+  }
+
+  /**
+   * @brief Returns true if the source file still has the modification time
+   * and size it had when the store was created.
+   * @return bool
+   */
+  bool isSourceFileUnchanged() const
+  {
+    return LazySourceStamp::Read(m_FilePath) == m_SourceStamp;
+  }
+
+  /**
+   * @brief Returns true if the values have been read from the file.
+   * @return bool
+   */
+  bool isLoaded() const
+  {
+    return m_Loaded.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Reads the values from the file if they have not been read yet.
+   * Throws a std::runtime_error if the dataset cannot be read.
+   */
+  void load() const
+  {
+    loadedStore();
+  }
+
+  /**
+   * @brief Resizes the store to the given tuple shape. The values are loaded
+   * first so existing values are kept.
+   * @param tupleShape
+   */
+  void reshapeTuples(const std::vector<usize>& tupleShape) override
+  {
+    loadedStore().reshapeTuples(tupleShape);
+    m_TupleShape = tupleShape;
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return value_type
+   */
+  value_type getValue(usize index) const override
+  {
+    return loadedStore().getValue(index);
+  }
+
+  /**
+   * @brief Sets the value stored at the specified index.
+   * @param index
+   * @param value
+   */
+  void setValue(usize index, value_type value) override
+  {
+    loadedStore().setValue(index, value);
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param  index
+   * @return const_reference
+   */
+  const_reference operator[](usize index) const override
+  {
+    return std::as_const(loadedStore())[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This can be used to edit the value found at the specified index.
+   * @param  index
+   * @return reference
+   */
+  reference operator[](usize index) override
+  {
+    return loadedStore()[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return const_reference
+   */
+  const_reference at(usize index) const override
+  {
+    return loadedStore().at(index);
+  }
+
+  /**
+   * @brief Fills the store with the specified value. Values that have not been
+   * loaded yet are never read since they would be overwritten.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if(m_Store == nullptr)
+    {
+      m_Store = createStore(value);
+      m_Loaded.store(true, std::memory_order_release);
+    }
+    else
+    {
+      m_Store->fill(value);
+    }
+  }
+
+  /**
+   * @brief Returns true once the values have been loaded into a contiguous
+   * store. Unloaded stores report false so that callers read them through
+   * copyIntoBuffer() instead of loading them as a whole.
+   * @return bool
+   */
+  bool isContiguous() const override
+  {
+    return isLoaded() && m_Store->isContiguous();
+  }
+
+  /**
+   * @brief Returns a span over all the values, loading them first. Empty if
+   * the values were loaded out of core.
+   * @return nonstd::span<value_type>
+   */
+  nonstd::span<value_type> contiguousSpan() override
+  {
+    return loadedStore().contiguousSpan();
+  }
+
+  /**
+   * @brief Returns a span over all the values, loading them first. Empty if
+   * the values were loaded out of core.
+   * @return nonstd::span<const value_type>
+   */
+  nonstd::span<const value_type> contiguousSpan() const override
+  {
+    return std::as_const(loadedStore()).contiguousSpan();
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the buffer.
+   * Values that have not been loaded are read from the file as hyperslabs
+   * without loading the rest of the dataset.
+   * @param startIndex
+   * @param buffer
+   */
+  void copyIntoBuffer(usize startIndex, nonstd::span<value_type> buffer) const override
+  {
+    if(isLoaded())
+    {
+      m_Store->copyIntoBuffer(startIndex, buffer);
+      return;
+    }
+    this->checkBulkRange(startIndex, buffer.size());
+    if(buffer.empty())
+    {
+      return;
+    }
+    readSource([this, startIndex, buffer](const H5::DatasetReader& datasetReader) { readRange(datasetReader, startIndex, buffer); });
+  }
+
+  /**
+   * @brief Copies the values in the buffer into the store starting at
+   * startIndex, loading the values first.
+   * @param startIndex
+   * @param buffer
+   */
+  void copyFromBuffer(usize startIndex, nonstd::span<const value_type> buffer) override
+  {
+    loadedStore().copyFromBuffer(startIndex, buffer);
+  }
+
+  /**
+   * @brief Returns a deep copy of the data store. A store that has not been
+   * loaded is copied without reading its values.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    return std::make_unique<LazyDataStore<T>>(*this);
+  }
+
+  /**
+   * @brief Returns a data store with the same shape and default initialized
+   * data, out of core if the current settings call for it.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    return createStore(static_cast<T>(0));
+  }
+
+  /**
+   * @brief Writes the data store to HDF5, loading the values first. Returns
+   * the HDF5 error code should one be encountered. Otherwise, returns 0.
+   * @param datasetWriter
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5(H5::DatasetWriter& datasetWriter) const override
+  {
+    return loadedStore().writeHdf5(datasetWriter);
+  }
+
+  /**
+   * @brief Writes the values to a binary file, loading them first.
+   * @param absoluteFilePath
+   * @return std::pair<int32, std::string>
+   */
+  std::pair<int32, std::string> writeBinaryFile(const std::string& absoluteFilePath) const override
+  {
+    return loadedStore().writeBinaryFile(absoluteFilePath);
+  }
+
+  /**
+   * @brief Creates a LazyDataStore for the dataset the reader points to. Only
+   * the shape attributes are read. The values are read on first access.
+   * @param datasetReader
+   * @return std::unique_ptr<LazyDataStore>
+   */
+  static std::unique_ptr<LazyDataStore> ReadHdf5(const H5::DatasetReader& datasetReader)
+  {
+    auto tupleShape = IDataStore::ReadTupleShape(datasetReader);
+    auto componentShape = IDataStore::ReadComponentShape(datasetReader);
+
+    ssize_t nameSize = H5Fget_name(datasetReader.getId(), nullptr, 0);
+    if(nameSize <= 0)
+    {
+      throw std::runtime_error(fmt::format("Error finding the HDF5 file containing {}/{}", H5::Support::GetObjectPath(datasetReader.getParentId()), datasetReader.getName()));
+    }
+    std::vector<char> fileName(static_cast<usize>(nameSize) + 1, 0);
+    H5Fget_name(datasetReader.getId(), fileName.data(), fileName.size());
+
+    return std::make_unique<LazyDataStore<T>>(tupleShape, componentShape, std::filesystem::path(fileName.data()), H5::Support::GetObjectPath(datasetReader.getId()));
+  }
+
+private:
+  /**
+   * @brief Creates the store the values are held in once loaded, out of core
+   * if the current settings call for it.
+   * @param value Value every element is initialized to
+   * @return std::unique_ptr<AbstractDataStore<T>>
+   */
+  std::unique_ptr<AbstractDataStore<T>> createStore(value_type value) const
+  {
+    if(OutOfCoreSettings::ShouldUseOutOfCore(this->getSize() * sizeof(T)))
+    {
+      return std::make_unique<OutOfCoreDataStore<T>>(m_TupleShape, m_ComponentShape, value);
+    }
+    return std::make_unique<DataStore<T>>(m_TupleShape, m_ComponentShape, value);
+  }
+
+  /**
+   * @brief Opens the dataset and passes it to readFunc while holding
+   * GetLazyDataStoreReadMutex(). Throws a std::runtime_error if the source
+   * file was modified or replaced since the store was created or if the
+   * dataset cannot be opened.
+   * @param readFunc
+   */
+  template <class ReadFuncT>
+  void readSource(ReadFuncT&& readFunc) const
+  {
+    std::lock_guard<std::mutex> readLock(GetLazyDataStoreReadMutex());
+    if(!isSourceFileUnchanged())
+    {
+      throw std::runtime_error(fmt::format("LazyDataStore: '{}' was modified or replaced after dataset '{}' was imported from it", m_FilePath.string(), m_DatasetPath));
+    }
+    H5::FileReader fileReader(m_FilePath);
+    H5::DatasetReader datasetReader(fileReader.getId(), m_DatasetPath);
+    if(!fileReader.isValid() || !datasetReader.isValid())
+    {
+      throw std::runtime_error(fmt::format("LazyDataStore: Unable to open dataset '{}' in '{}'", m_DatasetPath, m_FilePath.string()));
+    }
+    readFunc(datasetReader);
+  }
+
+  /**
+   * @brief Reads buffer.size() values starting at the flat index startIndex.
+   * The range is split into the fewest boxes of whole rows, planes, etc. that
+   * cover it, and each box is read as one hyperslab.
+   * @param datasetReader
+   * @param startIndex
+   * @param buffer
+   */
+  void readRange(const H5::DatasetReader& datasetReader, usize startIndex, nonstd::span<value_type> buffer) const
+  {
+    const std::vector<hsize_t> dims = datasetReader.getDimensions();
+    const usize rank = dims.size();
+    // strides[k] is the number of values covered by one step along dimension k
+    std::vector<usize> strides(rank, 1);
+    for(usize k = rank; k > 1; k--)
+    {
+      strides[k - 2] = strides[k - 1] * static_cast<usize>(dims[k - 1]);
+    }
+    if(rank == 0 || strides[0] * static_cast<usize>(dims[0]) != this->getSize())
+    {
+      throw std::runtime_error(fmt::format("LazyDataStore: Dataset '{}' in '{}' does not hold {} values", m_DatasetPath, m_FilePath.string(), this->getSize()));
+    }
+
+    usize numRead = 0;
+    while(numRead < buffer.size())
+    {
+      const usize position = startIndex + numRead;
+      const usize remaining = buffer.size() - numRead;
+      // The coarsest dimension whose blocks start at position and fit in the remaining values
+      usize level = 0;
+      while(position % strides[level] != 0 || strides[level] > remaining)
+      {
+        level++;
+      }
+      const usize index = (position / strides[level]) % static_cast<usize>(dims[level]);
+      const usize numBlocks = std::min(remaining / strides[level], static_cast<usize>(dims[level]) - index);
+
+      std::vector<hsize_t> start(rank, 0);
+      std::vector<hsize_t> count = dims;
+      for(usize k = 0; k < level; k++)
+      {
+        start[k] = (position / strides[k]) % static_cast<usize>(dims[k]);
+        count[k] = 1;
+      }
+      start[level] = index;
+      count[level] = numBlocks;
+      const usize numValues = numBlocks * strides[level];
+      if(!datasetReader.readIntoSpanHyperslab(buffer.subspan(numRead, numValues), start, count))
+      {
+        throw std::runtime_error(fmt::format("LazyDataStore: Unable to read values [{}, {}) of dataset '{}' in '{}'", position, position + numValues, m_DatasetPath, m_FilePath.string()));
+      }
+      numRead += numValues;
+    }
+  }
+
+  /**
+   * @brief Returns the store holding the values, reading it from the file the
+   * first time it is requested.
+   * @return AbstractDataStore<T>&
+   */
+  AbstractDataStore<T>& loadedStore() const
+  {
+    if(!m_Loaded.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if(m_Store == nullptr)
+      {
+        readSource([this](const H5::DatasetReader& datasetReader) {
+          if(OutOfCoreSettings::ShouldUseOutOfCore(this->getSize() * sizeof(T)))
+          {
+            m_Store = OutOfCoreDataStore<T>::ReadHdf5(datasetReader);
+          }
+          else
+          {
+            m_Store = DataStore<T>::ReadHdf5(datasetReader);
+          }
+        });
+      }
+      m_Loaded.store(true, std::memory_order_release);
+    }
+    return *m_Store;
+  }
+
+  ShapeType m_ComponentShape;
+  ShapeType m_TupleShape;
+  std::filesystem::path m_FilePath;
+  std::string m_DatasetPath;
+  LazySourceStamp m_SourceStamp;
+  mutable std::unique_ptr<AbstractDataStore<T>> m_Store;
+  mutable std::atomic_bool m_Loaded = false;
+  mutable std::mutex m_Mutex;
+};
+} // namespace complex
@@ -3,10 +3,16 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DataStructureWriter.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DatasetReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5GroupWriter.hpp"
 
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <stdexcept>
+
 namespace complex
 {
 template <typename T>
@@ -26,6 +32,33 @@ NeighborList<T>::NeighborList(DataStructure& dataStructure, const std::string& n
 {
 }
 
+template <typename T>
+NeighborList<T>::NeighborList(DataStructure& dataStructure, const std::string& name, CompressedLists&& lists, IdType importId)
+: INeighborList(dataStructure, name, 0, importId)
+, m_IsAllocated(false)
+, m_InitValue(static_cast<T>(0.0))
+{
+  setCompressedLists(std::move(lists.offsets), std::move(lists.values));
+}
+
+template <typename T>
+NeighborList<T>::NeighborList(const NeighborList& other)
+: INeighborList(other)
+, m_Compressed(other.m_Compressed)
+, m_IsAllocated(other.m_IsAllocated)
+, m_InitValue(other.m_InitValue)
+{
+  if(m_Compressed != nullptr)
+  {
+    return;
+  }
+  m_Array.reserve(other.m_Array.size());
+  for(const auto& list : other.m_Array)
+  {
+    m_Array.push_back(list == nullptr ? nullptr : std::make_shared<VectorType>(*list));
+  }
+}
+
 template <typename T>
 NeighborList<T>* NeighborList<T>::Create(DataStructure& ds, const std::string& name, usize numTuples, const std::optional<IdType>& parentId)
 {
@@ -48,6 +81,17 @@ NeighborList<T>* NeighborList<T>::Import(DataStructure& ds, const std::string& n
   return data.get();
 }
 
+template <typename T>
+NeighborList<T>* NeighborList<T>::Import(DataStructure& ds, const std::string& name, IdType importId, CompressedLists&& lists, const std::optional<IdType>& parentId)
+{
+  auto data = std::shared_ptr<NeighborList>(new NeighborList(ds, name, std::move(lists), importId));
+  if(!AttemptToAddObject(ds, data, parentId))
+  {
+    return nullptr;
+  }
+  return data.get();
+}
+
 template <typename T>
 DataObject* NeighborList<T>::shallowCopy()
 {
@@ -65,6 +109,10 @@ std::shared_ptr<DataObject> NeighborList<T>::deepCopy(const DataPath& copyPath)
   // Don't construct with id since it will get created when inserting into data structure
   auto copy = std::shared_ptr<NeighborList<T>>(new NeighborList<T>(dataStruct, copyPath.getTargetName(), getNumberOfTuples()));
   copy->setNumNeighborsArrayName(getNumNeighborsArrayName());
+  if(m_Compressed != nullptr)
+  {
+    copy->setCompressedLists(std::vector<usize>(m_Compressed->offsets), VectorType(m_Compressed->values));
+  }
   copy->m_Array.reserve(m_Array.size());
   for(usize i = 0; i < m_Array.size(); ++i)
   {
@@ -104,7 +152,7 @@ int32 NeighborList<T>::eraseTuples(const std::vector<usize>& idxs)
     return 0;
   }
 
-  usize arraySize = m_Array.size();
+  usize arraySize = static_cast<usize>(getNumberOfLists());
   // Sanity Check the Indices in the vector to make sure we are not trying to remove any indices that are
   // off the end of the array and return an error code.
   for(usize idx : idxs)
@@ -115,6 +163,35 @@ int32 NeighborList<T>::eraseTuples(const std::vector<usize>& idxs)
     }
   }
 
+  if(m_Compressed != nullptr)
+  {
+    // Compact the compressed lists in place. The indices are sorted so every
+    // kept list moves towards the front.
+    CompressedLists& lists = detachCompressedLists();
+    usize idxsIndex = 0;
+    usize numKept = 0;
+    usize valueEnd = 0;
+    for(usize dIdx = 0; dIdx < arraySize; ++dIdx)
+    {
+      if(idxsIndex < idxsSize && dIdx == idxs[idxsIndex])
+      {
+        ++idxsIndex;
+        continue;
+      }
+      const usize listBegin = lists.offsets[dIdx];
+      const usize listEnd = lists.offsets[dIdx + 1];
+      std::copy(lists.values.begin() + listBegin, lists.values.begin() + listEnd, lists.values.begin() + valueEnd);
+      lists.offsets[numKept] = valueEnd;
+      valueEnd += listEnd - listBegin;
+      ++numKept;
+    }
+    lists.offsets[numKept] = valueEnd;
+    lists.offsets.resize(numKept + 1);
+    lists.values.resize(valueEnd);
+    setNumberOfTuples(numKept);
+    return err;
+  }
+
   std::vector<SharedVectorType> replacement(arraySize - idxsSize);
 
   usize idxsIndex = 0;
@@ -143,12 +220,17 @@ int32 NeighborList<T>::eraseTuples(const std::vector<usize>& idxs)
 template <typename T>
 void NeighborList<T>::copyTuple(usize currentPos, usize newPos)
 {
+  convertCompressedLists();
   m_Array[newPos] = m_Array[currentPos];
 }
 
 template <typename T>
 usize NeighborList<T>::getSize() const
 {
+  if(m_Compressed != nullptr)
+  {
+    return m_Compressed->values.size();
+  }
   usize total = 0;
   for(usize dIdx = 0; dIdx < m_Array.size(); ++dIdx)
   {
@@ -172,14 +254,24 @@ template <typename T>
 void NeighborList<T>::initializeWithZeros()
 {
   m_Array.clear();
+  m_Compressed.reset();
   m_IsAllocated = false;
 }
 
 template <typename T>
 int32 NeighborList<T>::resizeTotalElements(usize size)
 {
-  usize old = m_Array.size();
-  m_Array.resize(size);
+  if(m_Compressed != nullptr)
+  {
+    // New lists are empty, removed lists drop their values
+    CompressedLists& lists = detachCompressedLists();
+    lists.offsets.resize(size + 1, lists.offsets.back());
+    lists.values.resize(lists.offsets.back());
+  }
+  else
+  {
+    m_Array.resize(size);
+  }
   setNumberOfTuples(size);
   if(size == 0)
   {
@@ -201,6 +293,7 @@ void NeighborList<T>::resizeTuples(usize numTuples)
 template <typename T>
 void NeighborList<T>::addEntry(int32 grainId, value_type value)
 {
+  convertCompressedLists();
   if(grainId >= static_cast<int32>(m_Array.size()))
   {
     usize old = m_Array.size();
@@ -220,12 +313,14 @@ template <typename T>
 void NeighborList<T>::clearAllLists()
 {
   m_Array.clear();
+  m_Compressed.reset();
   m_IsAllocated = false;
 }
 
 template <typename T>
 void NeighborList<T>::setList(int32 grainId, const SharedVectorType& neighborList)
 {
+  convertCompressedLists();
   if(grainId >= static_cast<int32>(m_Array.size()))
   {
     usize old = m_Array.size();
@@ -243,6 +338,16 @@ void NeighborList<T>::setList(int32 grainId, const SharedVectorType& neighborLis
 template <typename T>
 T NeighborList<T>::getValue(int32 grainId, int32 index, bool& ok) const
 {
+  if(m_Compressed != nullptr)
+  {
+    const nonstd::span<const T> list = getListSpan(grainId);
+    if(index < 0 || static_cast<usize>(index) >= list.size())
+    {
+      ok = false;
+      return static_cast<T>(-1);
+    }
+    return list[index];
+  }
   SharedVectorType vec = m_Array[grainId];
   if(index < 0 || static_cast<usize>(index) >= vec->size())
   {
@@ -255,43 +360,153 @@ T NeighborList<T>::getValue(int32 grainId, int32 index, bool& ok) const
 template <typename T>
 int32 NeighborList<T>::getNumberOfLists() const
 {
+  if(m_Compressed != nullptr)
+  {
+    return static_cast<int32>(m_Compressed->offsets.size() - 1);
+  }
   return static_cast<int32>(m_Array.size());
 }
 
 template <typename T>
 int32 NeighborList<T>::getListSize(int32 grainId) const
 {
+  if(m_Compressed != nullptr)
+  {
+    const std::vector<usize>& offsets = m_Compressed->offsets;
+    return static_cast<int32>(offsets[grainId + 1] - offsets[grainId]);
+  }
   return static_cast<int32>(m_Array[grainId]->size());
 }
 
 template <typename T>
-typename NeighborList<T>::VectorType& NeighborList<T>::getListReference(int32 grainId) const
+typename NeighborList<T>::VectorType& NeighborList<T>::getListReference(int32 grainId)
 {
+  convertCompressedLists();
   return *(m_Array[grainId]);
 }
 
 template <typename T>
-typename NeighborList<T>::SharedVectorType NeighborList<T>::getList(int32 grainId) const
+typename NeighborList<T>::SharedVectorType NeighborList<T>::getList(int32 grainId)
 {
+  convertCompressedLists();
   return m_Array[grainId];
 }
 
+template <typename T>
+nonstd::span<const T> NeighborList<T>::getListSpan(int32 grainId) const
+{
+  if(m_Compressed != nullptr)
+  {
+    const std::vector<usize>& offsets = m_Compressed->offsets;
+    return nonstd::span<const T>(m_Compressed->values.data() + offsets[grainId], offsets[grainId + 1] - offsets[grainId]);
+  }
+  const SharedVectorType& list = m_Array[grainId];
+  if(list == nullptr)
+  {
+    return {};
+  }
+  return nonstd::span<const T>(list->data(), list->size());
+}
+
+template <typename T>
+void NeighborList<T>::setCompressedLists(std::vector<usize>&& offsets, VectorType&& values)
+{
+  if(offsets.empty() || offsets.front() != 0 || offsets.back() != values.size())
+  {
+    throw std::invalid_argument(fmt::format("NeighborList '{}': compressed list offsets must start at 0 and end at the number of values ({})", getName(), values.size()));
+  }
+  if(!std::is_sorted(offsets.cbegin(), offsets.cend()))
+  {
+    throw std::invalid_argument(fmt::format("NeighborList '{}': compressed list offsets must not decrease", getName()));
+  }
+
+  m_Array.clear();
+  const usize numLists = offsets.size() - 1;
+  m_Compressed = std::make_shared<CompressedLists>(CompressedLists{std::move(offsets), std::move(values)});
+  m_IsAllocated = numLists > 0;
+  setNumberOfTuples(numLists);
+}
+
+template <typename T>
+bool NeighborList<T>::isCompressed() const
+{
+  return m_Compressed != nullptr;
+}
+
+template <typename T>
+nonstd::span<const usize> NeighborList<T>::getCompressedOffsets() const
+{
+  if(m_Compressed == nullptr)
+  {
+    return {};
+  }
+  return nonstd::span<const usize>(m_Compressed->offsets.data(), m_Compressed->offsets.size());
+}
+
+template <typename T>
+nonstd::span<const T> NeighborList<T>::getCompressedValues() const
+{
+  if(m_Compressed == nullptr)
+  {
+    return {};
+  }
+  return nonstd::span<const T>(m_Compressed->values.data(), m_Compressed->values.size());
+}
+
+template <typename T>
+void NeighborList<T>::expandLists()
+{
+  convertCompressedLists();
+}
+
+template <typename T>
+void NeighborList<T>::convertCompressedLists()
+{
+  if(m_Compressed == nullptr)
+  {
+    return;
+  }
+  const std::vector<usize>& offsets = m_Compressed->offsets;
+  const VectorType& values = m_Compressed->values;
+  const usize numLists = offsets.size() - 1;
+  std::vector<SharedVectorType> lists(numLists);
+  for(usize i = 0; i < numLists; i++)
+  {
+    lists[i] = std::make_shared<VectorType>(values.begin() + offsets[i], values.begin() + offsets[i + 1]);
+  }
+  m_Array = std::move(lists);
+  // Copies sharing the compressed lists keep them
+  m_Compressed.reset();
+}
+
+template <typename T>
+typename NeighborList<T>::CompressedLists& NeighborList<T>::detachCompressedLists()
+{
+  if(m_Compressed.use_count() > 1)
+  {
+    m_Compressed = std::make_shared<CompressedLists>(*m_Compressed);
+  }
+  return *m_Compressed;
+}
+
 template <typename T>
 typename NeighborList<T>::VectorType NeighborList<T>::copyOfList(int32 grainId) const
 {
-  VectorType copy(*(m_Array[grainId]));
-  return copy;
+  const nonstd::span<const T> list = getListSpan(grainId);
+  return VectorType(list.begin(), list.end());
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType& NeighborList<T>::operator[](int32 grainId)
 {
+  convertCompressedLists();
   return *(m_Array[grainId]);
 }
 
 template <typename T>
 typename NeighborList<T>::VectorType& NeighborList<T>::operator[](usize grainId)
 {
+  convertCompressedLists();
   return *(m_Array[grainId]);
 }
 
@@ -382,15 +597,12 @@ H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureW
   DataStructure tmp;
 
   // Create NumNeighbors DataStore
-  const usize arraySize = m_Array.size();
+  const usize arraySize = static_cast<usize>(getNumberOfLists());
   auto* numNeighborsArray = Int32Array::CreateWithStore<Int32DataStore>(tmp, getNumNeighborsArrayName(), {arraySize}, {1});
   auto& numNeighborsStore = numNeighborsArray->getDataStoreRef();
-  usize totalItems = 0;
   for(usize i = 0; i < arraySize; i++)
   {
-    const auto numNeighbors = m_Array[i]->size();
-    numNeighborsStore[i] = static_cast<int32>(numNeighbors);
-    totalItems += numNeighbors;
+    numNeighborsStore[i] = getListSize(static_cast<int32>(i));
   }
 
   // Write NumNeighbors data
@@ -400,31 +612,42 @@ H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureW
     return error;
   }
 
-  // Create flattened neighbor DataStore
-  DataStore<T> flattenedData(totalItems, static_cast<T>(0));
-  usize offset = 0;
-  for(const auto& segment : m_Array)
+  // The compressed values already are the flattened dataset. Individual lists
+  // have to be gathered into one buffer first.
+  VectorType flattenedData;
+  nonstd::span<const T> flatValues = getCompressedValues();
+  if(m_Compressed == nullptr)
   {
-    usize numElements = segment->size();
-    if(numElements == 0)
-    {
-      continue;
-    }
-    T* start = segment->data();
-    for(usize i = 0; i < numElements; i++)
+    flattenedData.reserve(getSize());
+    for(const auto& segment : m_Array)
     {
-      flattenedData[offset + i] = start[i];
+      flattenedData.insert(flattenedData.end(), segment->cbegin(), segment->cend());
     }
-    offset += numElements;
+    flatValues = nonstd::span<const T>(flattenedData.data(), flattenedData.size());
   }
 
   // Write flattened array to HDF5 as a separate array
   auto datasetWriter = parentGroupWriter.createDatasetWriter(getName());
-  H5::ErrorType err = flattenedData.writeHdf5(datasetWriter);
+  datasetWriter.setCreationOptions(dataStructureWriter.getDatasetCreationOptions());
+  const usize totalItems = flatValues.size();
+  H5::ErrorType err = datasetWriter.writeSpan({static_cast<hsize_t>(totalItems), 1}, flatValues);
+  if(err < 0)
+  {
+    return err;
+  }
+  auto tupleAttribute = datasetWriter.createAttribute(complex::H5::k_TupleShapeTag);
+  err = tupleAttribute.writeVector({1}, std::vector<usize>{totalItems});
   if(err < 0)
   {
     return err;
   }
+  auto componentAttribute = datasetWriter.createAttribute(complex::H5::k_ComponentShapeTag);
+  err = componentAttribute.writeVector({1}, std::vector<usize>{1});
+  if(err < 0)
+  {
+    return err;
+  }
+  dataStructureWriter.recordDatasetSize(datasetWriter);
   auto linkedDatasetAttribute = datasetWriter.createAttribute("Linked NumNeighbors Dataset");
   err = linkedDatasetAttribute.writeString(getNumNeighborsArrayName());
   if(err < 0)
@@ -435,7 +658,7 @@ H5::ErrorType NeighborList<T>::writeHdf5(H5::DataStructureWriter& dataStructureW
 }
 
 template <typename T>
-std::vector<typename NeighborList<T>::SharedVectorType> NeighborList<T>::ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
+typename NeighborList<T>::CompressedLists NeighborList<T>::ReadHdf5CompressedData(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
 {
   auto numNeighborsAttributeName = dataReader.getAttribute("Linked NumNeighbors Dataset");
   auto numNeighborsName = numNeighborsAttributeName.readAsString();
@@ -445,26 +668,35 @@ std::vector<typename NeighborList<T>::SharedVectorType> NeighborList<T>::ReadHdf
   auto numNeighborsPtr = Int32DataStore::ReadHdf5(numNeighborsReader);
   auto& numNeighborsStore = *numNeighborsPtr.get();
 
-  std::vector<T> flatDataStore = dataReader.template readAsVector<T>();
-  if(flatDataStore.empty())
+  CompressedLists lists;
+  const auto numTuples = numNeighborsStore.getNumberOfTuples();
+  lists.offsets.resize(numTuples + 1);
+  lists.offsets[0] = 0;
+  for(usize i = 0; i < numTuples; i++)
+  {
+    lists.offsets[i + 1] = lists.offsets[i] + static_cast<usize>(numNeighborsStore[i]);
+  }
+
+  // Read the flattened dataset straight into the values array
+  lists.values.resize(lists.offsets.back());
+  if(dataReader.getNumElements() != lists.values.size() || (!lists.values.empty() && !dataReader.readIntoSpan(nonstd::span<T>(lists.values.data(), lists.values.size()))))
   {
     throw std::runtime_error(fmt::format("Error reading neighbor list from DataStore from HDF5 at {}/{}", H5::Support::GetObjectPath(dataReader.getParentId()), dataReader.getName()));
   }
 
-  std::vector<SharedVectorType> dataVector;
-  usize offset = 0;
-  const auto numTuples = numNeighborsStore.getNumberOfTuples();
+  return lists;
+}
+
+template <typename T>
+std::vector<typename NeighborList<T>::SharedVectorType> NeighborList<T>::ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader)
+{
+  CompressedLists lists = ReadHdf5CompressedData(parentGroup, dataReader);
+
+  const usize numTuples = lists.offsets.size() - 1;
+  std::vector<SharedVectorType> dataVector(numTuples);
   for(usize i = 0; i < numTuples; i++)
   {
-    const auto numNeighbors = numNeighborsStore[i];
-    auto sharedVector = std::make_shared<std::vector<T>>(numNeighbors);
-    std::vector<T>& vector = *sharedVector.get();
-
-    size_t neighborListStart = offset;
-    size_t neighborListEnd = offset + numNeighbors;
-    sharedVector->assign(flatDataStore.begin() + neighborListStart, flatDataStore.begin() + neighborListEnd);
-    offset += numNeighbors;
-    dataVector.push_back(sharedVector);
+    dataVector[i] = std::make_shared<VectorType>(lists.values.begin() + lists.offsets[i], lists.values.begin() + lists.offsets[i + 1]);
   }
 
   return dataVector;
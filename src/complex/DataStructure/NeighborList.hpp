@@ -3,6 +3,11 @@
 #include "complex/Common/Types.hpp"
 #include "complex/DataStructure/INeighborList.hpp"
 
+#include <nonstd/span.hpp>
+
+#include <memory>
+#include <vector>
+
 namespace complex
 {
 namespace H5
@@ -26,7 +31,22 @@ static inline constexpr StringLiteral k_TypeName = "NeighborList<T>";
 
 /**
  * @class NeighborList
- * @brief
+ * @brief Stores a variable length list of values for each tuple.
+ *
+ * Lists are either held individually (one shared vector per tuple) or in a
+ * compressed sparse row (CSR) layout where a single offsets array indexes into
+ * a single flat values array. The CSR layout is what setCompressedLists()
+ * produces and what is read from HDF5, and it matches the on-disk layout
+ * (NumNeighbors + flattened values) so reading and writing need no per-list
+ * copies. Functions that change lists (setList(), addEntry(), copyTuple())
+ * and the accessors that hand out per-list vectors (getListReference(),
+ * getList(), operator[]) convert the compressed lists to individual vectors
+ * and free the compressed lists, so only one layout ever holds the values.
+ * The const read path is getListSpan() (and getValue(), getListSize(),
+ * copyOfList() built on it), which never converts the lists and can be used
+ * from several threads at once. Copies share the compressed lists
+ * copy-on-write: the first change through any of the sharing NeighborLists
+ * gives it a private copy so the others keep their values.
  * @tparam T
  */
 template <class T>
@@ -39,8 +59,27 @@ public:
   using VectorType = std::vector<T>;
   using SharedVectorType = std::shared_ptr<VectorType>;
 
+  /**
+   * @brief Lists in compressed sparse row form. List i holds
+   * values[offsets[i], offsets[i + 1]) so offsets has one more entry than
+   * there are lists.
+   */
+  struct CompressedLists
+  {
+    std::vector<usize> offsets;
+    VectorType values;
+  };
+
   NeighborList() = default;
 
+  /**
+   * @brief Copies the NeighborList. Compressed lists are shared copy-on-write
+   * and individual vectors are copied, so copies made for DataStructure
+   * snapshots keep their values when the original is modified.
+   * @param other
+   */
+  NeighborList(const NeighborList& other);
+
   /**
    * @brief
    * @param ds
@@ -63,10 +102,24 @@ public:
    */
   static NeighborList* Import(DataStructure& ds, const std::string& name, IdType importId, const std::vector<SharedVectorType>& data, const std::optional<IdType>& parentId = {});
 
+  /**
+   * @brief Creates a NeighborList that takes ownership of the provided
+   * compressed lists.
+   * @param ds
+   * @param name
+   * @param importId
+   * @param lists
+   * @param parentId
+   * @return NeighborList<T>*
+   */
+  static NeighborList* Import(DataStructure& ds, const std::string& name, IdType importId, CompressedLists&& lists, const std::optional<IdType>& parentId = {});
+
   ~NeighborList() override = default;
 
   /**
-   * @brief Returns a shallow copy of the NeighborList without copying data.
+   * @brief Returns a copy of the NeighborList that is not added to a
+   * DataStructure. Compressed lists are shared copy-on-write; individual
+   * vectors are copied since they are mutated in place.
    * THE CALLING CODE MUST DISPOSE OF THE RETURNED OBJECT.
    * @return DataObject*
    */
@@ -181,18 +234,65 @@ public:
   int32 getListSize(int32 grainId) const;
 
   /**
-   * @brief Returns a reference to the target grain ID's data.
+   * @brief Returns a reference to the target grain ID's data. Converts
+   * compressed lists to individual vectors. Use getListSpan() for reading.
    * @param grainId
    * @return VectorType&
    */
-  VectorType& getListReference(int32 grainId) const;
+  VectorType& getListReference(int32 grainId);
 
   /**
-   * @brief getList
+   * @brief Returns the target grain ID's vector. Converts compressed lists to
+   * individual vectors. Use getListSpan() for reading.
    * @param grainId
    * @return SharedVectorType
    */
-  SharedVectorType getList(int32 grainId) const;
+  SharedVectorType getList(int32 grainId);
+
+  /**
+   * @brief Returns a read-only view of the target grain ID's data. Works with
+   * both storage layouts and never converts the compressed lists.
+   * @param grainId
+   * @return nonstd::span<const T>
+   */
+  nonstd::span<const T> getListSpan(int32 grainId) const;
+
+  /**
+   * @brief Replaces all lists with the provided compressed lists without
+   * copying them. The number of tuples becomes offsets.size() - 1. Throws
+   * std::invalid_argument if the offsets do not start at zero, decrease, or do
+   * not end at values.size().
+   * @param offsets
+   * @param values
+   */
+  void setCompressedLists(std::vector<usize>&& offsets, VectorType&& values);
+
+  /**
+   * @brief Returns true if the lists are currently stored in the compressed
+   * sparse row layout.
+   * @return bool
+   */
+  bool isCompressed() const;
+
+  /**
+   * @brief Returns the list offsets of the compressed layout. Empty if the
+   * lists are not compressed.
+   * @return nonstd::span<const usize>
+   */
+  nonstd::span<const usize> getCompressedOffsets() const;
+
+  /**
+   * @brief Returns the flat values of the compressed layout. Empty if the
+   * lists are not compressed.
+   * @return nonstd::span<const T>
+   */
+  nonstd::span<const T> getCompressedValues() const;
+
+  /**
+   * @brief Converts compressed lists to individual vectors. Does nothing if the
+   * lists are not compressed.
+   */
+  void expandLists();
 
   /**
    * @brief Static function to get the typename
@@ -313,6 +413,15 @@ public:
    */
   static std::vector<SharedVectorType> ReadHdf5Data(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader);
 
+  /**
+   * @brief Read the data from HDF5 in the compressed sparse row layout. The
+   * flattened dataset is read directly into the values array.
+   * @param parentGroup
+   * @param dataReader
+   * @return CompressedLists
+   */
+  static CompressedLists ReadHdf5CompressedData(const H5::GroupReader& parentGroup, const H5::DatasetReader& dataReader);
+
 protected:
   /**
    * @brief NeighborList
@@ -324,8 +433,29 @@ protected:
    */
   NeighborList(DataStructure& dataStructure, const std::string& name, const std::vector<SharedVectorType>& dataVector, IdType importId);
 
+  /**
+   * @brief NeighborList
+   */
+  NeighborList(DataStructure& dataStructure, const std::string& name, CompressedLists&& lists, IdType importId);
+
 private:
+  /**
+   * @brief Converts compressed lists to individual vectors and frees the
+   * compressed lists. Does nothing if the lists are not compressed.
+   */
+  void convertCompressedLists();
+
+  /**
+   * @brief Replaces compressed lists shared copy-on-write with other
+   * NeighborLists by a private copy before they are changed in place.
+   * @return CompressedLists&
+   */
+  CompressedLists& detachCompressedLists();
+
+  // Only one layout holds values at a time: m_Array when not compressed,
+  // m_Compressed when compressed. m_Compressed is shared between copies.
   std::vector<SharedVectorType> m_Array;
+  std::shared_ptr<CompressedLists> m_Compressed;
   bool m_IsAllocated;
   value_type m_InitValue;
 };
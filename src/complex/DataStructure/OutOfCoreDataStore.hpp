@@ -0,0 +1,785 @@
+#pragma once
+
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/DataStructure/OutOfCoreSettings.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5AttributeReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetReader.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetWriter.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
+
+#include <fmt/core.h>
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class OutOfCoreDataStore
+ * @brief The OutOfCoreDataStore class stores its data in a scratch file on disk
+ * and pages fixed-size chunks of it in and out of memory through a least
+ * recently used chunk cache. The number of chunks kept in memory is bounded by
+ * the memory budget the store is created with.
+ *
+ * References returned by operator[] point into the cached chunk. Each thread
+ * keeps the k_MinCachedChunks chunks it accessed most recently pinned in the
+ * cache, and pinned chunks are never evicted, so a reference stays valid until
+ * the thread that obtained it has accessed k_MinCachedChunks other chunks,
+ * whatever other threads do in the meantime. The cache may exceed the memory
+ * budget while every cached chunk is pinned. A thread's pins are released
+ * only by its own later accesses, fill() and reshapeTuples(). Element access
+ * is serialized through an internal mutex, so parallel kernels are safe but
+ * contend on it; use copyIntoBuffer and copyFromBuffer, or a ConstDataView,
+ * for bulk access.
+ *
+ * The backing file is deleted when the store is destroyed.
+ * @tparam T
+ */
+template <typename T>
+class OutOfCoreDataStore : public AbstractDataStore<T>
+{
+public:
+  using value_type = typename AbstractDataStore<T>::value_type;
+  using reference = typename AbstractDataStore<T>::reference;
+  using const_reference = typename AbstractDataStore<T>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+
+  /**
+   * @brief Number of most recently accessed chunks each thread keeps pinned,
+   * and the minimum number of chunks kept in the cache regardless of the
+   * memory budget, so that expressions referencing a few elements at once
+   * stay valid.
+   */
+  static constexpr usize k_MinCachedChunks = 4;
+
+  /**
+   * @brief Constructs an OutOfCoreDataStore with the specified tuple and component shapes.
+   * @param tupleShape The dimensions of the tuples
+   * @param componentShape The dimensions of the component at each tuple
+   * @param initValue Value every element is initialized to. Defaults to T{}.
+   * @param chunkSize Target size of each chunk in bytes
+   * @param memoryBudget Maximum number of bytes of chunks kept in memory
+   */
+  OutOfCoreDataStore(const ShapeType& tupleShape, const ShapeType& componentShape, std::optional<T> initValue = {}, usize chunkSize = OutOfCoreSettings::ChunkSize(),
+                     usize memoryBudget = OutOfCoreSettings::MemoryBudget())
+  : m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<usize>(1), std::multiplies<>()))
+  , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>()))
+  , m_ChunkSize(std::max<usize>(1, chunkSize / sizeof(T)))
+  , m_MaxCachedChunks(std::max<usize>(k_MinCachedChunks, memoryBudget / (std::max<usize>(1, chunkSize / sizeof(T)) * sizeof(T))))
+  , m_FillValue(initValue.value_or(T{}))
+  {
+    openBackingFile();
+    m_ChunkOnDisk.resize(getChunkCount(), false);
+  }
+
+  /**
+   * @brief Copy constructor. Copies the other store's data into a new backing file.
+   * @param other
+   */
+  OutOfCoreDataStore(const OutOfCoreDataStore& other)
+  : m_ComponentShape(other.m_ComponentShape)
+  , m_TupleShape(other.m_TupleShape)
+  , m_NumComponents(other.m_NumComponents)
+  , m_NumTuples(other.m_NumTuples)
+  , m_ChunkSize(other.m_ChunkSize)
+  , m_MaxCachedChunks(other.m_MaxCachedChunks)
+  , m_FillValue(other.m_FillValue)
+  {
+    openBackingFile();
+
+    std::lock_guard<std::mutex> lock(other.m_Mutex);
+    const usize chunkCount = other.getChunkCount();
+    m_ChunkOnDisk.resize(chunkCount, false);
+    std::unique_ptr<value_type[]> buffer(new value_type[m_ChunkSize]);
+    for(usize chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+    {
+      auto iter = other.m_Cache.find(chunkIndex);
+      if(iter != other.m_Cache.end())
+      {
+        storeChunk(chunkIndex, iter->second.data.get());
+      }
+      else if(other.m_ChunkOnDisk[chunkIndex])
+      {
+        other.loadChunk(chunkIndex, buffer.get());
+        storeChunk(chunkIndex, buffer.get());
+      }
+    }
+  }
+
+  OutOfCoreDataStore(OutOfCoreDataStore&& other) = delete;
+  OutOfCoreDataStore& operator=(const OutOfCoreDataStore& rhs) = delete;
+  OutOfCoreDataStore& operator=(OutOfCoreDataStore&& rhs) = delete;
+
+  ~OutOfCoreDataStore() override
+  {
+    m_File.close();
+    std::error_code errorCode;
+    std::filesystem::remove(m_FilePath, errorCode);
+  }
+
+  /**
+   * @brief Returns the number of tuples in the DataStore.
+   * @return usize
+   */
+  usize getNumberOfTuples() const override
+  {
+    return m_NumTuples;
+  }
+
+  /**
+   * @brief Returns the number of elements in each Tuple.
+   * @return usize
+   */
+  usize getNumberOfComponents() const override
+  {
+    return m_NumComponents;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Tuples
+   * @return
+   */
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Components
+   * @return
+   */
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  /**
+   * @brief Returns the store type e.g. in memory, out of core, etc.
+   * @return StoreType
+   */
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::OutOfCore;
+  }
+
+  /**
+   * @brief Returns the number of elements in each chunk.
+   * @return usize
+   */
+  usize getChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+  /**
+   * @brief Returns the maximum number of chunks kept in memory.
+   * @return usize
+   */
+  usize getMaxCachedChunks() const
+  {
+    return m_MaxCachedChunks;
+  }
+
+  /**
+   * @brief Returns the number of chunks currently kept in memory.
+   * @return usize
+   */
+  usize getCachedChunkCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Cache.size();
+  }
+
+  /**
+   * @brief Returns the path to the backing file.
+   * @return const std::filesystem::path&
+   */
+  const std::filesystem::path& getBackingFilePath() const
+  {
+    return m_FilePath;
+  }
+
+  /**
+   * @brief Resizes the store to the given tuple shape. Values beyond the new
+   * size are discarded. New values are not initialized.
+   * @param tupleShape
+   */
+  void reshapeTuples(const std::vector<usize>& tupleShape) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_TupleShape = tupleShape;
+    m_NumTuples = std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>());
+
+    // Reshaping invalidates references, so every pin is released
+    m_ThreadPins.clear();
+    const usize chunkCount = getChunkCount();
+    for(auto iter = m_Cache.begin(); iter != m_Cache.end();)
+    {
+      if(iter->first >= chunkCount)
+      {
+        m_Lru.erase(iter->second.lruPosition);
+        iter = m_Cache.erase(iter);
+      }
+      else
+      {
+        iter->second.pinCount = 0;
+        ++iter;
+      }
+    }
+    m_ChunkOnDisk.resize(chunkCount, false);
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return value_type
+   */
+  value_type getValue(usize index) const override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return getChunk(index / m_ChunkSize, false)[index % m_ChunkSize];
+  }
+
+  /**
+   * @brief Sets the value stored at the specified index.
+   * @param index
+   * @param value
+   */
+  void setValue(usize index, value_type value) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    getChunk(index / m_ChunkSize, true)[index % m_ChunkSize] = value;
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param  index
+   * @return const_reference
+   */
+  const_reference operator[](usize index) const override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return getChunk(index / m_ChunkSize, false)[index % m_ChunkSize];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This can be used to edit the value found at the specified index. The
+   * containing chunk is marked as modified.
+   * @param  index
+   * @return reference
+   */
+  reference operator[](usize index) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return getChunk(index / m_ChunkSize, true)[index % m_ChunkSize];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return const_reference
+   */
+  const_reference at(usize index) const override
+  {
+    if(index >= this->getSize())
+    {
+      throw std::runtime_error(fmt::format("OutOfCoreDataStore: Index ({}) is greater than or equal to the size ({})", index, this->getSize()));
+    }
+    return (*this)[index];
+  }
+
+  /**
+   * @brief Fills the store with the specified value. No chunk is touched on
+   * disk, every chunk is lazily recreated from the fill value instead.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_ThreadPins.clear();
+    m_Cache.clear();
+    m_Lru.clear();
+    m_ChunkOnDisk.assign(m_ChunkOnDisk.size(), false);
+    m_FillValue = value;
+  }
+
+  /**
+   * @brief Writes every modified chunk in the cache to the backing file.
+   */
+  void flush() const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(auto& [chunkIndex, chunk] : m_Cache)
+    {
+      if(chunk.dirty)
+      {
+        storeChunk(chunkIndex, chunk.data.get());
+        chunk.dirty = false;
+      }
+    }
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the buffer
+   * one chunk at a time.
+   * @param startIndex
+   * @param buffer
+   */
+  void copyIntoBuffer(usize startIndex, nonstd::span<value_type> buffer) const override
+  {
+    this->checkBulkRange(startIndex, buffer.size());
+    copyRangeOut(startIndex, buffer);
+  }
+
+  /**
+   * @brief Copies the values in the buffer into the store starting at
+   * startIndex one chunk at a time.
+   * @param startIndex
+   * @param buffer
+   */
+  void copyFromBuffer(usize startIndex, nonstd::span<const value_type> buffer) override
+  {
+    this->checkBulkRange(startIndex, buffer.size());
+    copyRangeIn(startIndex, buffer);
+  }
+
+  /**
+   * @brief Returns a deep copy of the data store and all its data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    return std::make_unique<OutOfCoreDataStore<T>>(*this);
+  }
+
+  /**
+   * @brief Returns a data store of the same type as this but with default initialized data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    return std::make_unique<OutOfCoreDataStore<T>>(this->getTupleShape(), this->getComponentShape(), static_cast<T>(0), m_ChunkSize * sizeof(T), m_MaxCachedChunks * m_ChunkSize * sizeof(T));
+  }
+
+  /**
+   * @brief Writes the data store to HDF5 one block of the slowest dimension at
+   * a time so the whole array never has to be in memory. Returns the HDF5
+   * error code should one be encountered. Otherwise, returns 0.
+   * @param datasetWriter
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeHdf5(H5::DatasetWriter& datasetWriter) const override
+  {
+    if(!datasetWriter.isValid())
+    {
+      return -1;
+    }
+
+    std::vector<hsize_t> h5dims;
+    for(const auto& value : m_TupleShape)
+    {
+      h5dims.push_back(static_cast<hsize_t>(value));
+    }
+    for(const auto& value : m_ComponentShape)
+    {
+      h5dims.push_back(static_cast<hsize_t>(value));
+    }
+
+    herr_t err = datasetWriter.createEmptyDataset<T>(h5dims);
+    if(err < 0)
+    {
+      return err;
+    }
+
+    const usize numSlices = h5dims.empty() ? 0 : static_cast<usize>(h5dims[0]);
+    if(numSlices > 0 && this->getSize() > 0)
+    {
+      const usize sliceSize = this->getSize() / numSlices;
+      const usize slicesPerBlock = std::max<usize>(1, m_ChunkSize / sliceSize);
+      std::unique_ptr<value_type[]> buffer(new value_type[slicesPerBlock * sliceSize]);
+
+      std::vector<hsize_t> start(h5dims.size(), 0);
+      std::vector<hsize_t> count = h5dims;
+      for(usize slice = 0; slice < numSlices; slice += slicesPerBlock)
+      {
+        const usize blockSlices = std::min(slicesPerBlock, numSlices - slice);
+        const usize blockSize = blockSlices * sliceSize;
+        copyRangeOut(slice * sliceSize, nonstd::span<value_type>(buffer.get(), blockSize));
+
+        start[0] = slice;
+        count[0] = blockSlices;
+        err = datasetWriter.writeSpanHyperslab<T>(start, count, nonstd::span<const value_type>(buffer.get(), blockSize));
+        if(err < 0)
+        {
+          return err;
+        }
+      }
+    }
+
+    // Write shape attributes to the dataset
+    auto tupleAttribute = datasetWriter.createAttribute(complex::H5::k_TupleShapeTag);
+    err = tupleAttribute.writeVector({m_TupleShape.size()}, m_TupleShape);
+    if(err < 0)
+    {
+      return err;
+    }
+
+    auto componentAttribute = datasetWriter.createAttribute(complex::H5::k_ComponentShapeTag);
+    err = componentAttribute.writeVector({m_ComponentShape.size()}, m_ComponentShape);
+
+    return err;
+  }
+
+  /**
+   * @brief Creates an OutOfCoreDataStore from the given HDF5 dataset. The data
+   * is read one block of the slowest dimension at a time.
+   * @param datasetReader
+   * @return std::unique_ptr<OutOfCoreDataStore>
+   */
+  static std::unique_ptr<OutOfCoreDataStore> ReadHdf5(const H5::DatasetReader& datasetReader)
+  {
+    auto tupleShape = IDataStore::ReadTupleShape(datasetReader);
+    auto componentShape = IDataStore::ReadComponentShape(datasetReader);
+
+    auto dataStore = std::make_unique<OutOfCoreDataStore<T>>(tupleShape, componentShape, static_cast<T>(0));
+
+    std::vector<hsize_t> h5dims = datasetReader.getDimensions();
+    const usize totalSize = dataStore->getSize();
+    const hsize_t numElements = std::accumulate(h5dims.cbegin(), h5dims.cend(), static_cast<hsize_t>(1), std::multiplies<>());
+    if(h5dims.empty() || numElements != totalSize)
+    {
+      throw std::runtime_error(fmt::format("Error reading data array from DataStore from HDF5 at {}/{}", H5::Support::GetObjectPath(datasetReader.getParentId()), datasetReader.getName()));
+    }
+
+    const usize numSlices = static_cast<usize>(h5dims[0]);
+    if(numSlices == 0 || totalSize == 0)
+    {
+      return dataStore;
+    }
+
+    const usize sliceSize = totalSize / numSlices;
+    const usize slicesPerBlock = std::max<usize>(1, dataStore->getChunkSize() / sliceSize);
+    std::unique_ptr<value_type[]> buffer(new value_type[slicesPerBlock * sliceSize]);
+
+    std::vector<hsize_t> start(h5dims.size(), 0);
+    std::vector<hsize_t> count = h5dims;
+    for(usize slice = 0; slice < numSlices; slice += slicesPerBlock)
+    {
+      const usize blockSlices = std::min(slicesPerBlock, numSlices - slice);
+      const usize blockSize = blockSlices * sliceSize;
+      start[0] = slice;
+      count[0] = blockSlices;
+      nonstd::span<value_type> block(buffer.get(), blockSize);
+      if(!datasetReader.readIntoSpanHyperslab(block, start, count))
+      {
+        throw std::runtime_error(fmt::format("Error reading data array from DataStore from HDF5 at {}/{}", H5::Support::GetObjectPath(datasetReader.getParentId()), datasetReader.getName()));
+      }
+      dataStore->copyRangeIn(slice * sliceSize, nonstd::span<const value_type>(buffer.get(), blockSize));
+    }
+
+    return dataStore;
+  }
+
+  std::pair<int32, std::string> writeBinaryFile(const std::string& absoluteFilePath) const override
+  {
+    FILE* file = fopen(absoluteFilePath.c_str(), "wb");
+    if(nullptr == file)
+    {
+      return {-10170, fmt::format("File could not be opened for writing:\n  '{}'", absoluteFilePath)};
+    }
+
+    const usize totalElements = this->getSize();
+    usize elementsWritten = 0;
+    std::unique_ptr<value_type[]> buffer(new value_type[m_ChunkSize]);
+    for(usize offset = 0; offset < totalElements; offset += m_ChunkSize)
+    {
+      const usize blockSize = std::min(m_ChunkSize, totalElements - offset);
+      copyRangeOut(offset, nonstd::span<value_type>(buffer.get(), blockSize));
+      elementsWritten += fwrite(buffer.get(), sizeof(T), blockSize, file);
+    }
+    fclose(file);
+    if(totalElements != elementsWritten)
+    {
+      return {-10175, fmt::format("Error writing binary file:\n  Total Elements:'{}'\n  Elements Written:'{}'", absoluteFilePath, totalElements, elementsWritten)};
+    }
+
+    return {0, ""};
+  }
+
+private:
+  struct Chunk
+  {
+    std::unique_ptr<value_type[]> data;
+    bool dirty = false;
+    usize pinCount = 0;
+    typename std::list<usize>::iterator lruPosition;
+  };
+
+  /**
+   * @brief The chunks a thread accessed most recently, most recent first.
+   */
+  using PinnedChunks = std::vector<std::pair<usize, Chunk*>>;
+
+  /**
+   * @brief Returns the number of chunks needed to hold the current size.
+   * @return usize
+   */
+  usize getChunkCount() const
+  {
+    return (this->getSize() + m_ChunkSize - 1) / m_ChunkSize;
+  }
+
+  /**
+   * @brief Creates a uniquely named backing file in the configured temp directory.
+   */
+  void openBackingFile()
+  {
+    std::random_device randomDevice;
+    auto ticks = static_cast<uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+    m_FilePath = OutOfCoreSettings::TempDirectory() / fmt::format("complex_ooc_{:08x}{:08x}_{:x}.bin", randomDevice(), randomDevice(), ticks);
+    m_File.open(m_FilePath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!m_File.is_open())
+    {
+      throw std::runtime_error(fmt::format("OutOfCoreDataStore: Unable to create backing file '{}'", m_FilePath.string()));
+    }
+  }
+
+  /**
+   * @brief Reads the chunk from the backing file into the buffer. Chunks that
+   * were never written are filled with the fill value. Requires m_Mutex.
+   * @param chunkIndex
+   * @param buffer
+   */
+  void loadChunk(usize chunkIndex, value_type* buffer) const
+  {
+    if(!m_ChunkOnDisk[chunkIndex])
+    {
+      std::fill_n(buffer, m_ChunkSize, m_FillValue);
+      return;
+    }
+
+    m_File.clear();
+    m_File.seekg(static_cast<std::streamoff>(chunkIndex * m_ChunkSize * sizeof(T)));
+    m_File.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(m_ChunkSize * sizeof(T)));
+    if(!m_File)
+    {
+      throw std::runtime_error(fmt::format("OutOfCoreDataStore: Unable to read chunk {} from '{}'", chunkIndex, m_FilePath.string()));
+    }
+  }
+
+  /**
+   * @brief Writes the buffer to the chunk's location in the backing file. Requires m_Mutex.
+   * @param chunkIndex
+   * @param buffer
+   */
+  void storeChunk(usize chunkIndex, const value_type* buffer) const
+  {
+    m_File.clear();
+    m_File.seekp(static_cast<std::streamoff>(chunkIndex * m_ChunkSize * sizeof(T)));
+    m_File.write(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(m_ChunkSize * sizeof(T)));
+    if(!m_File)
+    {
+      throw std::runtime_error(fmt::format("OutOfCoreDataStore: Unable to write chunk {} to '{}'", chunkIndex, m_FilePath.string()));
+    }
+    m_ChunkOnDisk[chunkIndex] = true;
+  }
+
+  /**
+   * @brief Removes the least recently used chunk that no thread has pinned
+   * from the cache, writing it to the backing file first if it was modified.
+   * Nothing is evicted if every cached chunk is pinned. Requires m_Mutex.
+   */
+  void evictLeastRecentlyUsed() const
+  {
+    for(auto lruIter = m_Lru.rbegin(); lruIter != m_Lru.rend(); ++lruIter)
+    {
+      auto iter = m_Cache.find(*lruIter);
+      if(iter->second.pinCount > 0)
+      {
+        continue;
+      }
+      if(iter->second.dirty)
+      {
+        storeChunk(iter->first, iter->second.data.get());
+      }
+      m_Lru.erase(std::next(lruIter).base());
+      m_Cache.erase(iter);
+      return;
+    }
+  }
+
+  /**
+   * @brief Releases the thread's oldest pin if it holds k_MinCachedChunks
+   * pins, making room for a new one. Requires m_Mutex.
+   * @param pins
+   */
+  void releaseOldestPin(PinnedChunks& pins) const
+  {
+    if(pins.size() >= k_MinCachedChunks)
+    {
+      pins.back().second->pinCount--;
+      pins.pop_back();
+    }
+  }
+
+  /**
+   * @brief Makes the chunk the most recent of the thread's pinned chunks,
+   * releasing the thread's oldest pin if needed. Requires m_Mutex.
+   * @param pins
+   * @param chunkIndex
+   * @param chunk
+   */
+  void pinChunk(PinnedChunks& pins, usize chunkIndex, Chunk& chunk) const
+  {
+    auto pinIter = std::find_if(pins.begin(), pins.end(), [chunkIndex](const auto& pin) { return pin.first == chunkIndex; });
+    if(pinIter != pins.end())
+    {
+      std::rotate(pins.begin(), pinIter, pinIter + 1);
+      return;
+    }
+    releaseOldestPin(pins);
+    chunk.pinCount++;
+    pins.insert(pins.begin(), {chunkIndex, &chunk});
+  }
+
+  /**
+   * @brief Returns a pointer to the cached chunk, loading it and evicting the
+   * least recently used unpinned chunk if needed. The chunk is pinned for the
+   * calling thread. Requires m_Mutex.
+   * @param chunkIndex
+   * @param markDirty True if the caller may modify the chunk
+   * @return value_type*
+   */
+  value_type* getChunk(usize chunkIndex, bool markDirty) const
+  {
+    PinnedChunks& pins = m_ThreadPins[std::this_thread::get_id()];
+    if(!pins.empty() && pins.front().first == chunkIndex)
+    {
+      pins.front().second->dirty |= markDirty;
+      return pins.front().second->data.get();
+    }
+
+    auto iter = m_Cache.find(chunkIndex);
+    if(iter == m_Cache.end())
+    {
+      if(m_Cache.size() >= m_MaxCachedChunks)
+      {
+        // The new chunk takes the place of the thread's oldest pin, so that
+        // chunk can be evicted as well
+        releaseOldestPin(pins);
+        evictLeastRecentlyUsed();
+      }
+
+      Chunk chunk;
+      chunk.data.reset(new value_type[m_ChunkSize]);
+      loadChunk(chunkIndex, chunk.data.get());
+      m_Lru.push_front(chunkIndex);
+      chunk.lruPosition = m_Lru.begin();
+      iter = m_Cache.emplace(chunkIndex, std::move(chunk)).first;
+    }
+    else
+    {
+      m_Lru.splice(m_Lru.begin(), m_Lru, iter->second.lruPosition);
+    }
+
+    iter->second.dirty |= markDirty;
+    pinChunk(pins, chunkIndex, iter->second);
+    return iter->second.data.get();
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at the given element index into the buffer.
+   * @param start
+   * @param buffer
+   */
+  void copyRangeOut(usize start, nonstd::span<value_type> buffer) const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    usize copied = 0;
+    while(copied < buffer.size())
+    {
+      const usize index = start + copied;
+      const usize offset = index % m_ChunkSize;
+      const usize count = std::min(m_ChunkSize - offset, buffer.size() - copied);
+      const value_type* chunk = getChunk(index / m_ChunkSize, false);
+      std::copy_n(chunk + offset, count, buffer.data() + copied);
+      copied += count;
+    }
+  }
+
+  /**
+   * @brief Copies the values in the buffer into the store starting at the given element index.
+   * @param start
+   * @param buffer
+   */
+  void copyRangeIn(usize start, nonstd::span<const value_type> buffer)
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    usize copied = 0;
+    while(copied < buffer.size())
+    {
+      const usize index = start + copied;
+      const usize offset = index % m_ChunkSize;
+      const usize count = std::min(m_ChunkSize - offset, buffer.size() - copied);
+      value_type* chunk = getChunk(index / m_ChunkSize, true);
+      std::copy_n(buffer.data() + copied, count, chunk + offset);
+      copied += count;
+    }
+  }
+
+  ShapeType m_ComponentShape;
+  ShapeType m_TupleShape;
+  usize m_NumComponents = 0;
+  usize m_NumTuples = 0;
+  usize m_ChunkSize = 1;
+  usize m_MaxCachedChunks = k_MinCachedChunks;
+  value_type m_FillValue = {};
+
+  std::filesystem::path m_FilePath;
+  mutable std::fstream m_File;
+  mutable std::vector<bool> m_ChunkOnDisk;
+  mutable std::unordered_map<usize, Chunk> m_Cache;
+  mutable std::list<usize> m_Lru;
+  mutable std::unordered_map<std::thread::id, PinnedChunks> m_ThreadPins;
+  mutable std::mutex m_Mutex;
+};
+
+// Declare aliases
+using UInt8OutOfCoreDataStore = OutOfCoreDataStore<uint8>;
+using UInt16OutOfCoreDataStore = OutOfCoreDataStore<uint16>;
+using UInt32OutOfCoreDataStore = OutOfCoreDataStore<uint32>;
+using UInt64OutOfCoreDataStore = OutOfCoreDataStore<uint64>;
+
+using Int8OutOfCoreDataStore = OutOfCoreDataStore<int8>;
+using Int16OutOfCoreDataStore = OutOfCoreDataStore<int16>;
+using Int32OutOfCoreDataStore = OutOfCoreDataStore<int32>;
+using Int64OutOfCoreDataStore = OutOfCoreDataStore<int64>;
+
+using USizeOutOfCoreDataStore = OutOfCoreDataStore<usize>;
+using BoolOutOfCoreDataStore = OutOfCoreDataStore<bool>;
+
+using Float32OutOfCoreDataStore = OutOfCoreDataStore<float32>;
+using Float64OutOfCoreDataStore = OutOfCoreDataStore<float64>;
+} // namespace complex
@@ -0,0 +1,68 @@
+#include "OutOfCoreSettings.hpp"
+
+#include <atomic>
+#include <mutex>
+
+using namespace complex;
+
+namespace
+{
+std::atomic<usize> s_SizeThreshold = 0;
+std::atomic<usize> s_ChunkSize = OutOfCoreSettings::k_DefaultChunkSize;
+std::atomic<usize> s_MemoryBudget = OutOfCoreSettings::k_DefaultMemoryBudget;
+
+std::mutex s_TempDirectoryMutex;
+std::filesystem::path s_TempDirectory;
+} // namespace
+
+usize OutOfCoreSettings::SizeThreshold()
+{
+  return s_SizeThreshold;
+}
+
+void OutOfCoreSettings::SetSizeThreshold(usize numBytes)
+{
+  s_SizeThreshold = numBytes;
+}
+
+usize OutOfCoreSettings::ChunkSize()
+{
+  return s_ChunkSize;
+}
+
+void OutOfCoreSettings::SetChunkSize(usize numBytes)
+{
+  s_ChunkSize = numBytes;
+}
+
+usize OutOfCoreSettings::MemoryBudget()
+{
+  return s_MemoryBudget;
+}
+
+void OutOfCoreSettings::SetMemoryBudget(usize numBytes)
+{
+  s_MemoryBudget = numBytes;
+}
+
+std::filesystem::path OutOfCoreSettings::TempDirectory()
+{
+  std::lock_guard<std::mutex> lock(s_TempDirectoryMutex);
+  if(s_TempDirectory.empty())
+  {
+    return std::filesystem::temp_directory_path();
+  }
+  return s_TempDirectory;
+}
+
+void OutOfCoreSettings::SetTempDirectory(const std::filesystem::path& directory)
+{
+  std::lock_guard<std::mutex> lock(s_TempDirectoryMutex);
+  s_TempDirectory = directory;
+}
+
+bool OutOfCoreSettings::ShouldUseOutOfCore(usize numBytes)
+{
+  usize threshold = SizeThreshold();
+  return threshold != 0 && numBytes > threshold;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <filesystem>
+
+namespace complex
+{
+/**
+ * @class OutOfCoreSettings
+ * @brief The OutOfCoreSettings class holds the process wide settings used when
+ * deciding whether a data store is created in memory or out of core and how
+ * out-of-core data stores page their data in and out of their backing files.
+ *
+ * Out-of-core storage is disabled by default. Setting a non-zero size threshold
+ * causes any array larger than the threshold (in bytes) created through
+ * CreateDataStore or imported through the DataArrayFactory to be backed by an
+ * OutOfCoreDataStore.
+ */
+class COMPLEX_EXPORT OutOfCoreSettings
+{
+public:
+  static constexpr usize k_DefaultChunkSize = 8 * 1024 * 1024;
+  static constexpr usize k_DefaultMemoryBudget = 256 * 1024 * 1024;
+
+  OutOfCoreSettings() = delete;
+
+  /**
+   * @brief Returns the array size in bytes above which new data stores are
+   * created out of core. A value of 0 disables out-of-core storage.
+   * @return usize
+   */
+  static usize SizeThreshold();
+
+  /**
+   * @brief Sets the array size in bytes above which new data stores are
+   * created out of core. A value of 0 disables out-of-core storage.
+   * @param numBytes
+   */
+  static void SetSizeThreshold(usize numBytes);
+
+  /**
+   * @brief Returns the target size in bytes of each chunk paged in and out of
+   * an out-of-core data store's backing file.
+   * @return usize
+   */
+  static usize ChunkSize();
+
+  /**
+   * @brief Sets the target size in bytes of each chunk paged in and out of an
+   * out-of-core data store's backing file.
+   * @param numBytes
+   */
+  static void SetChunkSize(usize numBytes);
+
+  /**
+   * @brief Returns the number of bytes each out-of-core data store may keep
+   * cached in memory.
+   * @return usize
+   */
+  static usize MemoryBudget();
+
+  /**
+   * @brief Sets the number of bytes each out-of-core data store may keep
+   * cached in memory.
+   * @param numBytes
+   */
+  static void SetMemoryBudget(usize numBytes);
+
+  /**
+   * @brief Returns the directory in which out-of-core backing files are
+   * created. Defaults to the system temporary directory.
+   * @return std::filesystem::path
+   */
+  static std::filesystem::path TempDirectory();
+
+  /**
+   * @brief Sets the directory in which out-of-core backing files are created.
+   * @param directory
+   */
+  static void SetTempDirectory(const std::filesystem::path& directory);
+
+  /**
+   * @brief Returns true if an array of the given size in bytes should be
+   * created out of core with the current settings.
+   * @param numBytes
+   * @return bool
+   */
+  static bool ShouldUseOutOfCore(usize numBytes);
+};
+} // namespace complex
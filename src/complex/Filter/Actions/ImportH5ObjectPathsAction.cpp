@@ -7,7 +7,6 @@
 #include "complex/DataStructure/BaseGroup.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStore.hpp"
-#include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 
 using namespace complex;
 
@@ -30,10 +29,12 @@ std::vector<DataPath> getImportPaths(const DataStructure& importStructure, const
 
 namespace complex
 {
-ImportH5ObjectPathsAction::ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths)
+ImportH5ObjectPathsAction::ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths, bool lazyLoad, const std::optional<DREAM3D::VoxelBounds>& cropBounds)
 : IDataCreationAction({})
 , m_H5FilePath(importFile)
 , m_Paths(paths)
+, m_LazyLoad(lazyLoad)
+, m_CropBounds(cropBounds)
 {
   if(m_Paths.has_value())
   {
@@ -47,15 +48,29 @@ Result<> ImportH5ObjectPathsAction::apply(DataStructure& dataStructure, Mode mod
 {
   bool preflighting = (mode == Mode::Preflight);
 
+  // Arrays are imported lazily when cropping so that cell arrays read only their cropped block
   H5::FileReader fileReader(m_H5FilePath);
-  Result<DataStructure> dataStructureResult = DREAM3D::ImportDataStructureFromFile(fileReader, preflighting);
+  Result<DataStructure> dataStructureResult = DREAM3D::ImportDataStructureFromFile(fileReader, preflighting, m_LazyLoad || m_CropBounds.has_value());
   if(dataStructureResult.invalid())
   {
     return ConvertResult(std::move(dataStructureResult));
   }
+  DataStructure importStructure = std::move(dataStructureResult.value());
+
+  if(m_CropBounds.has_value())
+  {
+    Result<> cropResult = DREAM3D::CropImageGeometries(importStructure, *m_CropBounds, preflighting);
+    if(cropResult.invalid())
+    {
+      return cropResult;
+    }
+    if(!m_LazyLoad && !preflighting)
+    {
+      DREAM3D::LoadLazyDataStores(importStructure, m_H5FilePath);
+    }
+  }
 
   // Ensure there are no conflicting DataObject ID values
-  DataStructure importStructure = std::move(dataStructureResult.value());
   importStructure.resetIds(dataStructure.getNextId());
 
   auto importPaths = getImportPaths(importStructure, m_Paths);
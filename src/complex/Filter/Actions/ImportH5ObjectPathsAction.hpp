@@ -5,6 +5,7 @@
 
 #include "complex/DataStructure/DataPath.hpp"
 #include "complex/Filter/Output.hpp"
+#include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
 
 namespace complex
@@ -19,7 +20,18 @@ public:
 
   ImportH5ObjectPathsAction() = delete;
 
-  ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths);
+  /**
+   * @brief Constructs an action importing the given paths from the HDF5 file.
+   * When lazyLoad is true, imported data arrays read their values from the
+   * file on first access instead of when the action is applied. When
+   * cropBounds is set, every imported image geometry is cropped to it and
+   * only the cropped block of each cell array is read.
+   * @param importFile
+   * @param paths
+   * @param lazyLoad
+   * @param cropBounds
+   */
+  ImportH5ObjectPathsAction(const std::filesystem::path& importFile, const PathsType& paths, bool lazyLoad = false, const std::optional<DREAM3D::VoxelBounds>& cropBounds = {});
 
   ~ImportH5ObjectPathsAction() noexcept override;
 
@@ -46,5 +58,7 @@ public:
 private:
   std::filesystem::path m_H5FilePath;
   PathsType m_Paths;
+  bool m_LazyLoad = false;
+  std::optional<DREAM3D::VoxelBounds> m_CropBounds;
 };
 } // namespace complex
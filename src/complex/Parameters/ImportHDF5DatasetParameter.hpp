@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <list>
 #include <memory>
 
@@ -51,10 +52,41 @@ public:
     std::string dataSetPath;
     std::string componentDimensions;
     std::string tupleDimensions;
+    // Optional hyperslab of the dataset to import, one value per dataset dimension.
+    // An empty count imports the whole dataset; an empty offset/stride means zeros/ones.
+    std::vector<usize> hyperslabOffset;
+    std::vector<usize> hyperslabCount;
+    std::vector<usize> hyperslabStride;
 
     static inline constexpr StringLiteral k_DatasetPath_Key = "dataset_path";
     static inline constexpr StringLiteral k_ComponentDimensions_Key = "component_dimensions";
     static inline constexpr StringLiteral k_TupleDimensions_Key = "tuple_dimensions";
+    static inline constexpr StringLiteral k_HyperslabOffset_Key = "hyperslab_offset";
+    static inline constexpr StringLiteral k_HyperslabCount_Key = "hyperslab_count";
+    static inline constexpr StringLiteral k_HyperslabStride_Key = "hyperslab_stride";
+
+    /**
+     * @brief Returns true if only a block of the dataset should be imported.
+     * @return bool
+     */
+    bool hasHyperslab() const
+    {
+      return !hyperslabCount.empty();
+    }
+
+    static Result<std::vector<usize>> ReadHyperslabJson(const nlohmann::json& json, StringLiteral key)
+    {
+      if(!json.contains(key.view()))
+      {
+        return {std::vector<usize>{}};
+      }
+      const auto& values = json[key.str()];
+      if(!values.is_array() || !std::all_of(values.begin(), values.end(), [](const nlohmann::json& value) { return value.is_number_unsigned(); }))
+      {
+        return MakeErrorResult<std::vector<usize>>(-504, fmt::format("ImportHDF5DatasetParameter ValueType: '{}' value is not an array of unsigned integers.", key));
+      }
+      return {values.get<std::vector<usize>>()};
+    }
 
     static Result<DatasetImportInfo> ReadJson(const nlohmann::json& json)
     {
@@ -92,6 +124,17 @@ public:
       }
       data.tupleDimensions = json[k_TupleDimensions_Key.str()];
 
+      for(auto [key, values] : {std::make_pair(k_HyperslabOffset_Key, &data.hyperslabOffset), std::make_pair(k_HyperslabCount_Key, &data.hyperslabCount),
+                                std::make_pair(k_HyperslabStride_Key, &data.hyperslabStride)})
+      {
+        auto hyperslabResult = ReadHyperslabJson(json, key);
+        if(hyperslabResult.invalid())
+        {
+          return {nonstd::make_unexpected(std::move(hyperslabResult.errors()))};
+        }
+        *values = std::move(hyperslabResult.value());
+      }
+
       return {data};
     }
 
@@ -101,6 +144,12 @@ public:
       json[k_DatasetPath_Key.str()] = dataSetPath;
       json[k_ComponentDimensions_Key.str()] = componentDimensions;
       json[k_TupleDimensions_Key.str()] = tupleDimensions;
+      if(hasHyperslab())
+      {
+        json[k_HyperslabOffset_Key.str()] = hyperslabOffset;
+        json[k_HyperslabCount_Key.str()] = hyperslabCount;
+        json[k_HyperslabStride_Key.str()] = hyperslabStride;
+      }
       return json;
     }
   };
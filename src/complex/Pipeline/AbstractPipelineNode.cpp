@@ -94,9 +94,26 @@ bool AbstractPipelineNode::isPreflighted() const
   return m_IsPreflighted;
 }
 
+bool AbstractPipelineNode::retainsDataStructure() const
+{
+  return m_RetainDataStructure;
+}
+
+void AbstractPipelineNode::setRetainDataStructure(bool retain)
+{
+  m_RetainDataStructure = retain;
+  if(!m_RetainDataStructure)
+  {
+    clearDataStructure();
+  }
+}
+
 void AbstractPipelineNode::endExecution(DataStructure& dataStructure)
 {
-  setDataStructure(dataStructure);
+  if(m_RetainDataStructure)
+  {
+    setDataStructure(dataStructure);
+  }
 }
 
 void AbstractPipelineNode::notify(const std::shared_ptr<AbstractPipelineMessage>& msg)
@@ -228,6 +228,23 @@ public:
    */
   bool isPreflighted() const;
 
+  /**
+   * @brief Returns true if the node keeps a snapshot of the DataStructure
+   * after executing. Returns false otherwise.
+   * @return bool
+   */
+  bool retainsDataStructure() const;
+
+  /**
+   * @brief Sets whether the node keeps a snapshot of the DataStructure after
+   * executing. Disabling this clears any snapshot the node currently holds.
+   * Snapshots share DataArray stores copy-on-write with the live
+   * DataStructure, so a retained snapshot costs memory only for the arrays
+   * later filters modify.
+   * @param retain
+   */
+  void setRetainDataStructure(bool retain);
+
   /**
    * @brief Returns a reference to the signal used for messaging.
    * @return SignalType&
@@ -293,7 +310,7 @@ protected:
 
   /**
    * @brief Called when ending pipeline node execution.
-   * Sets the DataStructure and clears the Executing flag.
+   * Sets the DataStructure if the node retains it and clears the Executing flag.
    * If there is a parent node, sets the Executed flag.
    */
   virtual void endExecution(DataStructure& dataStructure);
@@ -327,6 +344,7 @@ private:
   DataStructure m_DataStructure;
   DataStructure m_PreflightStructure;
   bool m_IsPreflighted = false;
+  bool m_RetainDataStructure = true;
   SignalType m_Signal;
   FaultState m_FaultState = FaultState::None;
   bool m_IsDisabled = false;
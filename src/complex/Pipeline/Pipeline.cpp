@@ -10,6 +10,7 @@
 #include "complex/Pipeline/PipelineFilter.hpp"
 
 #include <algorithm>
+#include <deque>
 #include <fstream>
 #include <stdexcept>
 
@@ -35,6 +36,8 @@ Pipeline::Pipeline(const Pipeline& other)
 , m_Name(other.m_Name)
 , m_Collection(other.m_Collection)
 , m_FilterList(other.m_FilterList)
+, m_SnapshotPolicy(other.m_SnapshotPolicy)
+, m_SnapshotCount(other.m_SnapshotCount)
 {
   resetCollectionParent();
 }
@@ -44,6 +47,8 @@ Pipeline::Pipeline(Pipeline&& other) noexcept
 , m_Name(std::move(other.m_Name))
 , m_Collection(std::move(other.m_Collection))
 , m_FilterList(std::move(other.m_FilterList))
+, m_SnapshotPolicy(other.m_SnapshotPolicy)
+, m_SnapshotCount(other.m_SnapshotCount)
 {
   resetCollectionParent();
 }
@@ -61,6 +66,8 @@ Pipeline& Pipeline::operator=(const Pipeline& rhs) noexcept
   m_Name = rhs.m_Name;
   m_Collection = rhs.m_Collection;
   m_FilterList = rhs.m_FilterList;
+  m_SnapshotPolicy = rhs.m_SnapshotPolicy;
+  m_SnapshotCount = rhs.m_SnapshotCount;
   resetCollectionParent();
   return *this;
 }
@@ -70,6 +77,8 @@ Pipeline& Pipeline::operator=(Pipeline&& rhs) noexcept
   m_Name = std::move(rhs.m_Name);
   m_Collection = std::move(rhs.m_Collection);
   m_FilterList = std::move(rhs.m_FilterList);
+  m_SnapshotPolicy = rhs.m_SnapshotPolicy;
+  m_SnapshotCount = rhs.m_SnapshotCount;
   resetCollectionParent();
   return *this;
 }
@@ -286,6 +295,25 @@ bool Pipeline::executeFrom(index_type index, DataStructure& ds, const std::atomi
   }
 
   clearFaultState();
+  for(auto iter = begin() + index; iter != end(); iter++)
+  {
+    (*iter)->setRetainDataStructure(m_SnapshotPolicy != SnapshotPolicy::KeepNone);
+  }
+  // Snapshots kept from an earlier run are older than any made by this one
+  std::deque<AbstractPipelineNode*> retainedNodes;
+  if(m_SnapshotPolicy == SnapshotPolicy::KeepLast)
+  {
+    for(auto iter = begin(); iter != begin() + index; iter++)
+    {
+      retainedNodes.push_back(iter->get());
+    }
+    while(retainedNodes.size() > m_SnapshotCount)
+    {
+      retainedNodes.front()->clearDataStructure();
+      retainedNodes.pop_front();
+    }
+  }
+
   // Loop over each filter and execute the filter.
   for(auto iter = begin() + index; iter != end(); iter++)
   {
@@ -296,6 +324,15 @@ bool Pipeline::executeFrom(index_type index, DataStructure& ds, const std::atomi
     }
 
     bool success = filter->execute(ds, shouldCancel);
+    if(m_SnapshotPolicy == SnapshotPolicy::KeepLast)
+    {
+      retainedNodes.push_back(filter);
+      if(retainedNodes.size() > m_SnapshotCount)
+      {
+        retainedNodes.front()->clearDataStructure();
+        retainedNodes.pop_front();
+      }
+    }
     // Check if the filter was cancelled, and send out signal if it was.
     if(shouldCancel)
     {
@@ -312,7 +349,14 @@ bool Pipeline::executeFrom(index_type index, DataStructure& ds, const std::atomi
     }
   }
 
-  setDataStructure(ds);
+  if(m_SnapshotPolicy != SnapshotPolicy::KeepNone && retainsDataStructure())
+  {
+    setDataStructure(ds);
+  }
+  else
+  {
+    clearDataStructure();
+  }
 
   sendPipelineFaultMessage(m_FaultState);
   sendPipelineRunStateMessage(RunState::Idle);
@@ -336,6 +380,22 @@ bool Pipeline::executeFrom(index_type index, const std::atomic_bool& shouldCance
   return executeFrom(index, ds, shouldCancel);
 }
 
+Pipeline::SnapshotPolicy Pipeline::getSnapshotPolicy() const
+{
+  return m_SnapshotPolicy;
+}
+
+usize Pipeline::getSnapshotCount() const
+{
+  return m_SnapshotCount;
+}
+
+void Pipeline::setSnapshotPolicy(SnapshotPolicy policy, usize count)
+{
+  m_SnapshotPolicy = policy;
+  m_SnapshotCount = count;
+}
+
 bool Pipeline::hasWarningsBeforeIndex(index_type index) const
 {
   for(usize i = 0; i < index; i++)
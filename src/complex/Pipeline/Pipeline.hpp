@@ -32,6 +32,17 @@ public:
   using iterator = collection_type::iterator;
   using const_iterator = collection_type::const_iterator;
 
+  /**
+   * @brief Controls which nodes keep a snapshot of the DataStructure after the
+   * pipeline executes them.
+   */
+  enum class SnapshotPolicy : uint8
+  {
+    KeepAll = 0, ///< Every executed node keeps its snapshot.
+    KeepLast,    ///< Only the most recently executed nodes keep their snapshots.
+    KeepNone     ///< No node keeps a snapshot, including the pipeline itself.
+  };
+
   /**
    * @brief Constructs a Pipeline from json.
    * @param json
@@ -251,6 +262,29 @@ public:
    */
   bool executeFrom(index_type index, const std::atomic_bool& shouldCancel = false);
 
+  /**
+   * @brief Returns the policy used to decide which nodes keep a DataStructure
+   * snapshot after execution.
+   * @return SnapshotPolicy
+   */
+  SnapshotPolicy getSnapshotPolicy() const;
+
+  /**
+   * @brief Returns the number of snapshots kept by SnapshotPolicy::KeepLast.
+   * @return usize
+   */
+  usize getSnapshotCount() const;
+
+  /**
+   * @brief Sets the policy used to decide which nodes keep a DataStructure
+   * snapshot after execution. Batch runs that never read intermediate results
+   * should use SnapshotPolicy::KeepNone. Nodes whose snapshot was dropped
+   * cannot be used as the starting point of executeFrom(index).
+   * @param policy
+   * @param count = 1 Number of snapshots kept by SnapshotPolicy::KeepLast
+   */
+  void setSnapshotPolicy(SnapshotPolicy policy, usize count = 1);
+
   /**
    * @brief Returns the getSize of the pipeline segment.
    * @return usize
@@ -603,5 +637,7 @@ private:
   std::string m_Name;
   collection_type m_Collection;
   FilterList* m_FilterList = nullptr;
+  SnapshotPolicy m_SnapshotPolicy = SnapshotPolicy::KeepAll;
+  usize m_SnapshotCount = 1;
 };
 } // namespace complex
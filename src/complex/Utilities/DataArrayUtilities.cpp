@@ -2,7 +2,9 @@
 
 #include "complex/Common/Types.hpp"
 #include "complex/Common/TypesUtility.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <cstring>
 #include <set>
 
 using namespace complex;
@@ -17,6 +19,77 @@ Result<> ReplaceArray(DataStructure& dataStructure, const DataPath& dataPath, co
   dataStructure.removeData(dataPath);
   return CreateArray<T>(dataStructure, tupleShape, componentShape, dataPath, mode);
 }
+
+/**
+ * @brief Returns a byte with bit i set when byte i of the eight bytes is non-zero.
+ */
+inline uint64 PackEightBytes(const void* bytes)
+{
+  uint64 value = 0;
+  std::memcpy(&value, bytes, sizeof(value));
+  // Fold every byte onto its lowest bit, then gather the lowest bits into the top byte
+  value |= value >> 4;
+  value |= value >> 2;
+  value |= value >> 1;
+  value &= 0x0101010101010101ull;
+  return (value * 0x0102040810204080ull) >> 56;
+}
+
+/**
+ * @brief Packs the mask values of a range of words into the bitset words.
+ */
+template <typename T>
+class PackMaskWordsImpl
+{
+public:
+  PackMaskWordsImpl(const AbstractDataStore<T>& maskStore, usize size, std::vector<uint64>& words)
+  : m_MaskStore(maskStore)
+  , m_Size(size)
+  , m_Words(words)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    const nonstd::span<const T> values = m_MaskStore.contiguousSpan();
+    for(usize wordIndex = range.min(); wordIndex < range.max(); wordIndex++)
+    {
+      const usize begin = wordIndex * MaskBitset::k_BitsPerWord;
+      const usize end = std::min(begin + MaskBitset::k_BitsPerWord, m_Size);
+      uint64 word = 0;
+      if(!values.empty())
+      {
+        const T* wordValues = values.data() + begin;
+        usize i = 0;
+        if constexpr(endian::native == endian::little)
+        {
+          for(; i + 8 <= end - begin; i += 8)
+          {
+            word |= PackEightBytes(wordValues + i) << i;
+          }
+        }
+        for(; i < end - begin; i++)
+        {
+          word |= static_cast<uint64>(wordValues[i] != 0) << i;
+        }
+      }
+      else
+      {
+        for(usize i = begin; i < end; i++)
+        {
+          word |= static_cast<uint64>(m_MaskStore.getValue(i) != 0) << (i - begin);
+        }
+      }
+      m_Words[wordIndex] = word;
+    }
+  }
+
+private:
+  const AbstractDataStore<T>& m_MaskStore;
+  usize m_Size = 0;
+  std::vector<uint64>& m_Words;
+};
+
 } // namespace
 
 namespace complex
@@ -320,4 +393,77 @@ std::unique_ptr<MaskCompare> InstantiateMaskCompare(IDataArray& maskArray)
   }
 }
 
+//-----------------------------------------------------------------------------
+MaskBitset::MaskBitset(usize size)
+: m_Size(size)
+, m_Words((size + k_BitsPerWord - 1) / k_BitsPerWord, 0)
+{
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+MaskBitset MaskBitset::Pack(const AbstractDataStore<T>& maskStore)
+{
+  MaskBitset bitset(maskStore.getSize());
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, bitset.m_Words.size());
+  // Stores that are not held in memory are only read from the calling thread
+  dataAlg.setParallelizationEnabled(maskStore.isContiguous());
+  dataAlg.execute(PackMaskWordsImpl<T>(maskStore, bitset.m_Size, bitset.m_Words));
+  return bitset;
+}
+
+//-----------------------------------------------------------------------------
+MaskBitset MaskBitset::Create(const IDataArray& maskArray)
+{
+  switch(maskArray.getDataType())
+  {
+  case DataType::boolean: {
+    return Pack(dynamic_cast<const BoolArray&>(maskArray).getDataStoreRef());
+  }
+  case DataType::uint8: {
+    return Pack(dynamic_cast<const UInt8Array&>(maskArray).getDataStoreRef());
+  }
+  default:
+    throw std::runtime_error("MaskBitset: The Mask Array being used is NOT of type bool or uint8.");
+  }
+}
+
+//-----------------------------------------------------------------------------
+MaskBitset MaskBitset::Create(const DataStructure& dataStructure, const DataPath& maskArrayPath)
+{
+  return Create(dataStructure.getDataRefAs<IDataArray>(maskArrayPath));
+}
+
+//-----------------------------------------------------------------------------
+usize MaskBitset::count() const
+{
+  usize total = 0;
+  for(const uint64 word : m_Words)
+  {
+    total += static_cast<usize>(popcount(word));
+  }
+  return total;
+}
+
+//-----------------------------------------------------------------------------
+usize MaskBitset::findNext(usize begin) const
+{
+  if(begin >= m_Size)
+  {
+    return m_Size;
+  }
+  usize wordIndex = begin / k_BitsPerWord;
+  uint64 word = m_Words[wordIndex] & (~uint64(0) << (begin % k_BitsPerWord));
+  while(word == 0)
+  {
+    wordIndex++;
+    if(wordIndex == m_Words.size())
+    {
+      return m_Size;
+    }
+    word = m_Words[wordIndex];
+  }
+  return wordIndex * k_BitsPerWord + static_cast<usize>(countr_zero(word));
+}
 } // namespace complex
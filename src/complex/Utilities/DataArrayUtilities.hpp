@@ -1,5 +1,6 @@
 #pragma once
 
+#include "complex/Common/Bit.hpp"
 #include "complex/Common/Result.hpp"
 #include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataArray.hpp"
@@ -7,13 +8,16 @@
 #include "complex/DataStructure/EmptyDataStore.hpp"
 #include "complex/DataStructure/IDataStore.hpp"
 #include "complex/DataStructure/NeighborList.hpp"
+#include "complex/DataStructure/OutOfCoreDataStore.hpp"
 #include "complex/Filter/Output.hpp"
 #include "complex/Utilities/TemplateHelpers.hpp"
 #include "complex/complex_export.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -288,6 +292,9 @@ COMPLEX_EXPORT Result<> ConditionalReplaceValueInArray(const std::string& valueA
 
 /**
  * @brief Creates a DataStore with the given properties
+ *
+ * In EXECUTE mode an OutOfCoreDataStore is created instead of an in memory
+ * DataStore if the size of the array exceeds OutOfCoreSettings::SizeThreshold().
  * @tparam T Primitive Type (int, float, ...)
  * @param tupleShape The Tuple Dimensions
  * @param componentShape The component dimensions
@@ -303,6 +310,12 @@ std::unique_ptr<AbstractDataStore<T>> CreateDataStore(const typename IDataStore:
     return std::make_unique<EmptyDataStore<T>>(tupleShape, componentShape);
   }
   case IDataAction::Mode::Execute: {
+    usize numTuples = std::accumulate(tupleShape.cbegin(), tupleShape.cend(), static_cast<usize>(1), std::multiplies<>());
+    usize numComponents = std::accumulate(componentShape.cbegin(), componentShape.cend(), static_cast<usize>(1), std::multiplies<>());
+    if(OutOfCoreSettings::ShouldUseOutOfCore(numTuples * numComponents * sizeof(T)))
+    {
+      return std::make_unique<OutOfCoreDataStore<T>>(tupleShape, componentShape, static_cast<T>(0));
+    }
     return std::make_unique<DataStore<T>>(tupleShape, componentShape, static_cast<T>(0));
   }
   default: {
@@ -620,7 +633,8 @@ COMPLEX_EXPORT Result<> ValidateNumFeaturesInArray(const DataStructure& dataStru
 
 /**
  * @brief These structs and functions are meant to make using a "mask array" or "Good Voxels Array" easier
- * for the developer. There is virtual function call overhead with using these structs and functions.
+ * for the developer. There is virtual function call overhead with using these structs and functions. Loops
+ * over every tuple should use TypedMaskCompare through ExecuteMaskFunction or a MaskBitset instead.
  *
  * An example use of these functions would be the following:
  * @code
@@ -662,7 +676,7 @@ struct MaskCompare
   virtual void setValue(size_t index, bool val) = 0;
 };
 
-struct BoolMaskCompare : public MaskCompare
+struct BoolMaskCompare final : public MaskCompare
 {
   BoolMaskCompare(BoolArray& array)
   : m_Array(array)
@@ -688,7 +702,7 @@ struct BoolMaskCompare : public MaskCompare
   }
 };
 
-struct UInt8MaskCompare : public MaskCompare
+struct UInt8MaskCompare final : public MaskCompare
 {
   UInt8MaskCompare(UInt8Array& array)
   : m_Array(array)
@@ -739,4 +753,249 @@ COMPLEX_EXPORT std::unique_ptr<MaskCompare> InstantiateMaskCompare(DataStructure
  */
 COMPLEX_EXPORT std::unique_ptr<MaskCompare> InstantiateMaskCompare(IDataArray& maskArrayPtr);
 
+/**
+ * @brief Non-virtual mask access for a `bool` or `uint8` mask array. The element type is a template
+ * parameter so every check is an inlined load from the array's memory. Stores that are not held in
+ * memory fall back to getValue()/setValue(). Instances are normally created by ExecuteMaskFunction().
+ */
+template <typename T>
+class TypedMaskCompare
+{
+public:
+  static_assert(std::is_same_v<T, bool> || std::is_same_v<T, uint8>, "TypedMaskCompare: The mask type must be bool or uint8");
+
+  explicit TypedMaskCompare(AbstractDataStore<T>& dataStore)
+  : m_DataStore(dataStore)
+  , m_Values(dataStore.contiguousSpan())
+  {
+  }
+
+  bool bothTrue(usize indexA, usize indexB) const
+  {
+    return isTrue(indexA) && isTrue(indexB);
+  }
+
+  bool bothFalse(usize indexA, usize indexB) const
+  {
+    return !isTrue(indexA) && !isTrue(indexB);
+  }
+
+  bool isTrue(usize index) const
+  {
+    if(!m_Values.empty())
+    {
+      return static_cast<bool>(m_Values[index]);
+    }
+    return static_cast<bool>(m_DataStore.getValue(index));
+  }
+
+  void setValue(usize index, bool value)
+  {
+    if(!m_Values.empty())
+    {
+      m_Values[index] = static_cast<T>(value);
+      return;
+    }
+    m_DataStore.setValue(index, static_cast<T>(value));
+  }
+
+  usize size() const
+  {
+    return m_DataStore.getSize();
+  }
+
+private:
+  AbstractDataStore<T>& m_DataStore;
+  nonstd::span<T> m_Values;
+};
+
+/**
+ * @brief Calls func(mask, args...) with a TypedMaskCompare<bool> or TypedMaskCompare<uint8> that matches
+ * the type of the mask array, so the body of func is compiled once per mask type.
+ *
+ * An example use of this function would be the following:
+ * @code
+ *  ExecuteMaskFunction([&](auto& mask) {
+ *    for(usize i = 0; i < numTuples; i++)
+ *    {
+ *      if(mask.isTrue(i)) { ... }
+ *    }
+ *  }, maskArray);
+ * @endcode
+ *
+ * @param func The callable receiving the typed mask as its first argument
+ * @param maskArray The mask array which can be of either `bool` or `uint8` type
+ * @param args Additional arguments passed to func
+ * @return The value returned by func
+ */
+template <class FuncT, class... ArgsT>
+auto ExecuteMaskFunction(FuncT&& func, IDataArray& maskArray, ArgsT&&... args)
+{
+  switch(maskArray.getDataType())
+  {
+  case DataType::boolean: {
+    TypedMaskCompare<bool> mask(dynamic_cast<BoolArray&>(maskArray).getDataStoreRef());
+    return func(mask, std::forward<ArgsT>(args)...);
+  }
+  case DataType::uint8: {
+    TypedMaskCompare<uint8> mask(dynamic_cast<UInt8Array&>(maskArray).getDataStoreRef());
+    return func(mask, std::forward<ArgsT>(args)...);
+  }
+  default:
+    throw std::runtime_error("ExecuteMaskFunction: The Mask Array being used is NOT of type bool or uint8.");
+  }
+}
+
+/**
+ * @class MaskBitset
+ * @brief A read-only copy of a mask array packed into 64 bit words. Besides testing single tuples it can
+ * visit only the set bits of a range, skipping 64 masked-out tuples per word test, which makes loops over
+ * sparse masks (e.g. a small sample inside a large image) proportional to the number of selected tuples.
+ * The bitset is a snapshot: later changes to the mask array are not reflected.
+ *
+ * An example use of this class would be the following:
+ * @code
+ *  MaskBitset mask = MaskBitset::Create(m_DataStructure, m_InputValues->MaskArrayPath);
+ *  mask.forEachSetBit(begin, end, [&](usize index) {
+ *    // Only called for tuples where the mask is true...
+ *  });
+ * @endcode
+ */
+class COMPLEX_EXPORT MaskBitset
+{
+public:
+  static inline constexpr usize k_BitsPerWord = 64;
+
+  MaskBitset() = default;
+
+  /**
+   * @brief Creates a bitset of the given size with every bit cleared.
+   * @param size The number of bits
+   */
+  explicit MaskBitset(usize size);
+
+  /**
+   * @brief Packs a `bool` or `uint8` mask array. Throws std::runtime_error for any other type.
+   * @param maskArray
+   * @return MaskBitset
+   */
+  static MaskBitset Create(const IDataArray& maskArray);
+
+  /**
+   * @brief Packs the `bool` or `uint8` mask array at the given path. Throws std::out_of_range if the
+   * path does not exist and std::runtime_error if the array is not of a mask type.
+   * @param dataStructure The DataStructure object to pull the DataArray from
+   * @param maskArrayPath The DataPath of the mask array.
+   * @return MaskBitset
+   */
+  static MaskBitset Create(const DataStructure& dataStructure, const DataPath& maskArrayPath);
+
+  /**
+   * @brief Returns the number of bits, i.e. the number of values in the mask array.
+   * @return usize
+   */
+  usize size() const
+  {
+    return m_Size;
+  }
+
+  /**
+   * @brief Returns the number of set bits.
+   * @return usize
+   */
+  usize count() const;
+
+  bool isTrue(usize index) const
+  {
+    return (m_Words[index / k_BitsPerWord] >> (index % k_BitsPerWord)) & 1u;
+  }
+
+  bool bothTrue(usize indexA, usize indexB) const
+  {
+    return isTrue(indexA) && isTrue(indexB);
+  }
+
+  bool bothFalse(usize indexA, usize indexB) const
+  {
+    return !isTrue(indexA) && !isTrue(indexB);
+  }
+
+  void setValue(usize index, bool value)
+  {
+    const uint64 bit = uint64(1) << (index % k_BitsPerWord);
+    uint64& word = m_Words[index / k_BitsPerWord];
+    word = value ? (word | bit) : (word & ~bit);
+  }
+
+  /**
+   * @brief Returns the index of the first set bit at or after begin, or size() if there is none.
+   * @param begin
+   * @return usize
+   */
+  usize findNext(usize begin) const;
+
+  /**
+   * @brief Calls func(index) in increasing order for every set bit in [begin, end).
+   * Words without a set bit are skipped with a single test.
+   * @param begin
+   * @param end
+   * @param func
+   */
+  template <class FuncT>
+  void forEachSetBit(usize begin, usize end, FuncT&& func) const
+  {
+    end = std::min(end, m_Size);
+    if(begin >= end)
+    {
+      return;
+    }
+    const usize firstWord = begin / k_BitsPerWord;
+    const usize lastWord = (end - 1) / k_BitsPerWord;
+    for(usize wordIndex = firstWord; wordIndex <= lastWord; wordIndex++)
+    {
+      uint64 word = m_Words[wordIndex];
+      if(wordIndex == firstWord)
+      {
+        word &= ~uint64(0) << (begin % k_BitsPerWord);
+      }
+      if(wordIndex == lastWord && end % k_BitsPerWord != 0)
+      {
+        word &= ~uint64(0) >> (k_BitsPerWord - end % k_BitsPerWord);
+      }
+      const usize wordStart = wordIndex * k_BitsPerWord;
+      while(word != 0)
+      {
+        func(wordStart + static_cast<usize>(countr_zero(word)));
+        word &= word - 1;
+      }
+    }
+  }
+
+  /**
+   * @brief Calls func(index) in increasing order for every set bit.
+   * @param func
+   */
+  template <class FuncT>
+  void forEachSetBit(FuncT&& func) const
+  {
+    forEachSetBit(0, m_Size, std::forward<FuncT>(func));
+  }
+
+  /**
+   * @brief Returns the packed words. Bit i is bit (i % 64) of word (i / 64); unused bits of the last word are zero.
+   * @return const std::vector<uint64>&
+   */
+  const std::vector<uint64>& words() const
+  {
+    return m_Words;
+  }
+
+private:
+  template <typename T>
+  static MaskBitset Pack(const AbstractDataStore<T>& maskStore);
+
+  usize m_Size = 0;
+  std::vector<uint64> m_Words;
+};
+
 } // namespace complex
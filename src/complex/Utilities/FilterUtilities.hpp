@@ -1,96 +1,123 @@
 #pragma once
 
 #include <stdexcept>
+#include <type_traits>
 
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+
+#include "complex/Common/Result.hpp"
 #include "complex/Common/Types.hpp"
 
 namespace complex
 {
-template <class FuncT, class... ArgsT>
-auto ExecuteDataFunction(FuncT&& func, DataType dataType, ArgsT&&... args)
+/**
+ * @brief Every type a DataArray can hold, listed in the order of the DataType enumeration.
+ */
+using AllDataTypes = boost::mp11::mp_list<int8, uint8, int16, uint16, int32, uint32, int64, uint64, float32, float64, bool>;
+
+/**
+ * @brief Every type a DataArray can hold except bool.
+ */
+using NumericDataTypes = boost::mp11::mp_list<int8, uint8, int16, uint16, int32, uint32, int64, uint64, float32, float64>;
+
+/**
+ * @brief Returns the position of dataType in TypeListT or the size of the list if the type is not part of it.
+ * @tparam TypeListT A boost::mp11::mp_list of types taken from AllDataTypes
+ * @param dataType
+ * @return usize
+ */
+template <class TypeListT>
+usize FindDataTypeIndex(DataType dataType)
+{
+  using namespace boost::mp11;
+  usize index = mp_size<TypeListT>::value;
+  mp_for_each<mp_iota<mp_size<TypeListT>>>([&](auto typeIndex) {
+    if(mp_find<AllDataTypes, mp_at_c<TypeListT, typeIndex>>::value == static_cast<usize>(dataType))
+    {
+      index = typeIndex;
+    }
+  });
+  return index;
+}
+
+/**
+ * @brief Returns true if dataType is one of the types in TypeListT.
+ * @tparam TypeListT A boost::mp11::mp_list of types taken from AllDataTypes
+ * @param dataType
+ * @return bool
+ */
+template <class TypeListT>
+bool IsDataTypeInList(DataType dataType)
+{
+  return FindDataTypeIndex<TypeListT>(dataType) < boost::mp11::mp_size<TypeListT>::value;
+}
+
+/**
+ * @brief Calls func.template operator()<T>(args...) with the type T of TypeListT that matches dataType.
+ * Only the types of the list are instantiated, so filters that support a subset of the types can pass
+ * a shorter list. Throws std::runtime_error if dataType is not part of the list.
+ * @tparam TypeListT A boost::mp11::mp_list of types taken from AllDataTypes
+ * @param func
+ * @param dataType
+ * @param args
+ * @return The value returned by func
+ */
+template <class TypeListT, class FuncT, class... ArgsT>
+auto ExecuteDataFunctionFor(FuncT&& func, DataType dataType, ArgsT&&... args)
 {
-  switch(dataType)
+  using namespace boost::mp11;
+  const usize index = FindDataTypeIndex<TypeListT>(dataType);
+  if(index >= mp_size<TypeListT>::value)
   {
-  case DataType::boolean: {
-    return func.template operator()<bool>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::int8: {
-    return func.template operator()<int8>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::int16: {
-    return func.template operator()<int16>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::int32: {
-    return func.template operator()<int32>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::int64: {
-    return func.template operator()<int64>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::uint8: {
-    return func.template operator()<uint8>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::uint16: {
-    return func.template operator()<uint16>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::uint32: {
-    return func.template operator()<uint32>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::uint64: {
-    return func.template operator()<uint64>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::float32: {
-    return func.template operator()<float32>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::float64: {
-    return func.template operator()<float64>(std::forward<ArgsT>(args)...);
-  }
-  default: {
-    throw std::runtime_error("complex::ExecuteDataFunction<...>(FuncT&& func, DataType dataType, ArgsT&&... args). Error: Invalid DataType");
+    throw std::runtime_error("complex::ExecuteDataFunctionFor<...>(FuncT&& func, DataType dataType, ArgsT&&... args). Error: Invalid DataType");
   }
+  return mp_with_index<mp_size<TypeListT>::value>(index, [&](auto typeIndex) { return func.template operator()<mp_at_c<TypeListT, typeIndex>>(std::forward<ArgsT>(args)...); });
+}
+
+/**
+ * @brief Calls func.template operator()<T, U>(args...) with the type T of TypeListA that matches dataTypeA and
+ * the type U of TypeListB that matches dataTypeB. Every combination of the two lists is instantiated, so the
+ * lists should be kept as short as the filter allows. Throws std::runtime_error if either type is not part
+ * of its list.
+ * @tparam TypeListA A boost::mp11::mp_list of types taken from AllDataTypes
+ * @tparam TypeListB A boost::mp11::mp_list of types taken from AllDataTypes
+ * @param func
+ * @param dataTypeA
+ * @param dataTypeB
+ * @param args
+ * @return The value returned by func
+ */
+template <class TypeListA, class TypeListB, class FuncT, class... ArgsT>
+auto ExecuteDataFunctionPair(FuncT&& func, DataType dataTypeA, DataType dataTypeB, ArgsT&&... args)
+{
+  using namespace boost::mp11;
+  const usize indexA = FindDataTypeIndex<TypeListA>(dataTypeA);
+  const usize indexB = FindDataTypeIndex<TypeListB>(dataTypeB);
+  if(indexA >= mp_size<TypeListA>::value || indexB >= mp_size<TypeListB>::value)
+  {
+    throw std::runtime_error("complex::ExecuteDataFunctionPair<...>(FuncT&& func, DataType dataTypeA, DataType dataTypeB, ArgsT&&... args). Error: Invalid DataType");
   }
+  return mp_with_index<mp_size<TypeListA>::value>(indexA, [&](auto typeIndexA) {
+    return mp_with_index<mp_size<TypeListB>::value>(indexB, [&](auto typeIndexB) {
+      return func.template operator()<mp_at_c<TypeListA, typeIndexA>, mp_at_c<TypeListB, typeIndexB>>(std::forward<ArgsT>(args)...);
+    });
+  });
+}
+
+template <class FuncT, class... ArgsT>
+auto ExecuteDataFunction(FuncT&& func, DataType dataType, ArgsT&&... args)
+{
+  return ExecuteDataFunctionFor<AllDataTypes>(std::forward<FuncT>(func), dataType, std::forward<ArgsT>(args)...);
 }
 
 template <class FuncT, class... ArgsT>
 auto ExecuteNeighborFunction(FuncT&& func, DataType dataType, ArgsT&&... args)
 {
-  switch(dataType)
+  if(dataType == DataType::boolean)
   {
-  case DataType::int8: {
-    return func.template operator()<int8>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::int16: {
-    return func.template operator()<int16>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::int32: {
-    return func.template operator()<int32>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::int64: {
-    return func.template operator()<int64>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::uint8: {
-    return func.template operator()<uint8>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::uint16: {
-    return func.template operator()<uint16>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::uint32: {
-    return func.template operator()<uint32>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::uint64: {
-    return func.template operator()<uint64>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::float32: {
-    return func.template operator()<float32>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::float64: {
-    return func.template operator()<float64>(std::forward<ArgsT>(args)...);
-  }
-  case DataType::boolean: {
     return MakeErrorResult(-89850, "Cannot create a NeighborList of booleans.");
   }
-  default: {
-    throw std::runtime_error("complex::ExecuteDataFunction<...>(FuncT&& func, DataType dataType, ArgsT&&... args). Error: Invalid DataType");
-  }
-  }
+  return ExecuteDataFunctionFor<NumericDataTypes>(std::forward<FuncT>(func), dataType, std::forward<ArgsT>(args)...);
 }
 } // namespace complex
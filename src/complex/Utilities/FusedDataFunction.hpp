@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "complex/Common/Types.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+namespace complex
+{
+namespace detail
+{
+template <class MakeKernelT>
+struct FusedKernelFactory
+{
+  MakeKernelT& makeKernel;
+
+  template <typename T>
+  std::function<void(const Range&)> operator()(usize arrayIndex)
+  {
+    return makeKernel.template operator()<T>(arrayIndex);
+  }
+};
+} // namespace detail
+
+/**
+ * @brief Runs the typed kernels of several arrays together in one parallel pass over [0, numTuples), instead
+ * of one pass per array. makeKernel.template operator()<T>(arrayIndex) is called once per array on the calling
+ * thread, with T the type of dataTypes[arrayIndex], and returns the callable that processes a Range of tuples
+ * of that array. Each chunk of tuples is then handed to the kernels of all arrays in turn.
+ *
+ * Anything that must not happen concurrently, such as fetching a writable DataStore, belongs in makeKernel.
+ * @tparam TypeListT A boost::mp11::mp_list of the types the arrays may hold
+ * @param makeKernel
+ * @param dataTypes The type of every array
+ * @param numTuples
+ * @param parallel Whether the chunks may run on several threads
+ */
+template <class TypeListT = AllDataTypes, class MakeKernelT>
+void ExecuteFusedDataFunction(MakeKernelT&& makeKernel, const std::vector<DataType>& dataTypes, usize numTuples, bool parallel)
+{
+  using KernelType = std::function<void(const Range&)>;
+  detail::FusedKernelFactory<std::remove_reference_t<MakeKernelT>> factory{makeKernel};
+  std::vector<KernelType> kernels;
+  kernels.reserve(dataTypes.size());
+  for(usize arrayIndex = 0; arrayIndex < dataTypes.size(); arrayIndex++)
+  {
+    kernels.push_back(ExecuteDataFunctionFor<TypeListT>(factory, dataTypes[arrayIndex], arrayIndex));
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTuples);
+  dataAlg.setParallelizationEnabled(parallel);
+  dataAlg.execute([&kernels](const Range& range) {
+    for(const KernelType& kernel : kernels)
+    {
+      kernel(range);
+    }
+  });
+}
+} // namespace complex
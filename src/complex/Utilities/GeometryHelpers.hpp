@@ -7,6 +7,17 @@
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/IGeometry.hpp"
 #include "complex/Utilities/Math/GeometryMath.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+#include <tbb/parallel_sort.h>
+#endif
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
 
 namespace complex
 {
@@ -202,113 +213,190 @@ ErrorCode FindElementNeighbors(const DataArray<K>* elemList, const DynamicListAr
   return err;
 }
 
+namespace detail
+{
 /**
- * @brief
+ * @brief Builds one key per sub-element (edge or face) of every element. Each
+ * key holds the sub-element's vertex ids in ascending order so that shared
+ * sub-elements compare equal. Keys are generated in parallel over elements into
+ * one flat buffer and then sorted, so duplicates end up next to each other and
+ * the result is in the same lexicographic order a std::set would produce.
  * @tparam T
- * @param tetList
- * @param edgeList
+ * @tparam N Number of vertices per sub-element
+ * @param elemList
+ * @param localVertices Element-local vertex indices of each sub-element
+ * @return std::vector<std::array<T, N>>
  */
-template <typename T>
-void FindTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
+template <typename T, usize N>
+std::vector<std::array<T, N>> GenerateSortedKeys(const DataArray<T>& elemList, const std::vector<std::array<usize, N>>& localVertices)
 {
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-  auto& tets = *tetList;
+  const ConstDataView<T> elemsView(elemList.getDataStoreRef());
+  const usize numElems = elemList.getNumberOfTuples();
+  const usize numVertsPerElem = elemList.getNumberOfComponents();
+  const usize keysPerElem = localVertices.size();
+
+  std::vector<std::array<T, N>> keys(numElems * keysPerElem);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numElems);
+  dataAlg.execute([&](const Range& range) {
+    // Each range reads through its own view
+    const ConstDataView<T> elems = elemsView;
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      const usize offset = i * numVertsPerElem;
+      for(usize k = 0; k < keysPerElem; k++)
+      {
+        std::array<T, N>& key = keys[i * keysPerElem + k];
+        for(usize v = 0; v < N; v++)
+        {
+          key[v] = elems[offset + localVertices[k][v]];
+        }
+        std::sort(key.begin(), key.end());
+      }
+    }
+  });
 
-  std::set<std::pair<T, T>> edgeSet;
+#ifdef COMPLEX_ENABLE_MULTICORE
+  ParallelScheduler::Execute([&keys]() { tbb::parallel_sort(keys.begin(), keys.end()); });
+#else
+  std::sort(keys.begin(), keys.end());
+#endif
+  return keys;
+}
 
-  for(usize i = 0; i < numElems; i++)
+/**
+ * @brief Removes every key that appears more than once from a sorted key list.
+ * @tparam T
+ * @tparam N
+ * @param keys
+ */
+template <typename T, usize N>
+void RemoveSharedKeys(std::vector<std::array<T, N>>& keys)
+{
+  usize numUnshared = 0;
+  usize current = 0;
+  while(current < keys.size())
   {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> edge0 = {tets[offset + 0], tets[offset + 1]};
-    std::vector<T> edge1 = {tets[offset + 0], tets[offset + 2]};
-    std::vector<T> edge2 = {tets[offset + 1], tets[offset + 2]};
-    std::vector<T> edge3 = {tets[offset + 0], tets[offset + 3]};
-    std::vector<T> edge4 = {tets[offset + 1], tets[offset + 3]};
-    std::vector<T> edge5 = {tets[offset + 2], tets[offset + 3]};
-    std::list<std::vector<T>> edgeVecList = {edge0, edge1, edge2, edge3, edge4, edge5};
-
-    for(auto&& uEdge : edgeVecList)
+    usize next = current + 1;
+    while(next < keys.size() && keys[next] == keys[current])
     {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeSet.insert(edge);
+      next++;
     }
+    if(next - current == 1)
+    {
+      keys[numUnshared] = keys[current];
+      numUnshared++;
+    }
+    current = next;
   }
+  keys.resize(numUnshared);
+}
 
-  edgeList->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edgeList;
-  T index = 0;
+/**
+ * @brief Resizes the output array to one tuple per key and copies the keys into
+ * it in a single bulk write.
+ * @tparam T
+ * @tparam N
+ * @param keys
+ * @param output
+ */
+template <typename T, usize N>
+void CopyKeysToArray(const std::vector<std::array<T, N>>& keys, DataArray<T>& output)
+{
+  static_assert(sizeof(std::array<T, N>) == N * sizeof(T), "Keys must be tightly packed to be copied as one buffer");
 
-  for(auto& edge : edgeSet)
+  output.getDataStore()->reshapeTuples({keys.size()});
+  if(keys.empty())
   {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
+    return;
   }
+  output.getDataStoreRef().copyFromBuffer(0, nonstd::span<const T>(keys.front().data(), keys.size() * N));
 }
 
 /**
- * @brief
+ * @brief Writes every distinct sub-element of the elements to the output array.
  * @tparam T
- * @param hexList
- * @param edge_List
+ * @tparam N
+ * @param elemList
+ * @param localVertices
+ * @param output
  */
-template <typename T>
-void FindHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
+template <typename T, usize N>
+void FindUniqueKeys(const DataArray<T>& elemList, const std::vector<std::array<usize, N>>& localVertices, DataArray<T>& output)
 {
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
+  std::vector<std::array<T, N>> keys = GenerateSortedKeys<T, N>(elemList, localVertices);
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  CopyKeysToArray<T, N>(keys, output);
+}
 
-  auto& hexas = *hexList;
+/**
+ * @brief Writes the sub-elements that belong to exactly one element to the
+ * output array.
+ * @tparam T
+ * @tparam N
+ * @param elemList
+ * @param localVertices
+ * @param output
+ */
+template <typename T, usize N>
+void FindUnsharedKeys(const DataArray<T>& elemList, const std::vector<std::array<usize, N>>& localVertices, DataArray<T>& output)
+{
+  std::vector<std::array<T, N>> keys = GenerateSortedKeys<T, N>(elemList, localVertices);
+  RemoveSharedKeys<T, N>(keys);
+  CopyKeysToArray<T, N>(keys, output);
+}
 
-  std::set<std::pair<T, T>> edgeSet;
+inline const std::vector<std::array<usize, 2>> k_TetEdges = {{{0, 1}}, {{0, 2}}, {{1, 2}}, {{0, 3}}, {{1, 3}}, {{2, 3}}};
+inline const std::vector<std::array<usize, 2>> k_HexEdges = {{{0, 1}}, {{1, 2}}, {{2, 3}}, {{3, 0}}, {{0, 4}}, {{1, 5}}, {{2, 6}}, {{3, 7}}, {{4, 5}}, {{5, 6}}, {{6, 7}}, {{7, 4}}};
+inline const std::vector<std::array<usize, 3>> k_TetFaces = {{{0, 1, 2}}, {{1, 2, 3}}, {{0, 2, 3}}, {{0, 1, 3}}};
+inline const std::vector<std::array<usize, 4>> k_HexFaces = {{{0, 1, 5, 4}}, {{1, 2, 6, 5}}, {{2, 3, 7, 6}}, {{3, 0, 4, 7}}, {{0, 1, 2, 3}}, {{4, 5, 6, 7}}};
 
-  for(usize i = 0; i < numElems; i++)
+/**
+ * @brief Returns the edges of a 2D element with the given number of vertices.
+ * @param numVertsPerElem
+ * @return std::vector<std::array<usize, 2>>
+ */
+inline std::vector<std::array<usize, 2>> Get2DElementEdges(usize numVertsPerElem)
+{
+  std::vector<std::array<usize, 2>> edges(numVertsPerElem);
+  for(usize j = 0; j < numVertsPerElem; j++)
   {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> edge0 = {hexas[offset + 0], hexas[offset + 1]};
-    std::vector<T> edge1 = {hexas[offset + 1], hexas[offset + 2]};
-    std::vector<T> edge2 = {hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> edge3 = {hexas[offset + 3], hexas[offset + 0]};
-
-    std::vector<T> edge4 = {hexas[offset + 0], hexas[offset + 4]};
-    std::vector<T> edge5 = {hexas[offset + 1], hexas[offset + 5]};
-    std::vector<T> edge6 = {hexas[offset + 2], hexas[offset + 6]};
-    std::vector<T> edge7 = {hexas[offset + 3], hexas[offset + 7]};
-
-    std::vector<T> edge8 = {hexas[offset + 4], hexas[offset + 5]};
-    std::vector<T> edge9 = {hexas[offset + 5], hexas[offset + 6]};
-    std::vector<T> edge10 = {hexas[offset + 6], hexas[offset + 7]};
-    std::vector<T> edge11 = {hexas[offset + 7], hexas[offset + 4]};
-
-    std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5, edge6, edge7, edge8, edge9, edge10, edge11};
-
-    for(auto&& uEdge : edgeList)
-    {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeSet.insert(edge);
-    }
+    edges[j] = {j, (j + 1) % numVertsPerElem};
   }
+  return edges;
+}
+} // namespace detail
 
-  typename std::set<std::pair<T, T>>::iterator setIter;
-  edge_List->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edge_List;
-  T index = 0;
+/**
+ * @brief Finds the unique edges of a tetrahedral mesh. Each edge is stored
+ * with its lower vertex id first and edges are sorted.
+ * @tparam T
+ * @param tetList
+ * @param edgeList
+ */
+template <typename T>
+void FindTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
+{
+  detail::FindUniqueKeys<T, 2>(*tetList, detail::k_TetEdges, *edgeList);
+}
 
-  for(auto edge : edgeSet)
-  {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
-  }
+/**
+ * @brief Finds the unique edges of a hexahedral mesh. Each edge is stored
+ * with its lower vertex id first and edges are sorted.
+ * @tparam T
+ * @param hexList
+ * @param edge_List
+ */
+template <typename T>
+void FindHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
+{
+  detail::FindUniqueKeys<T, 2>(*hexList, detail::k_HexEdges, *edge_List);
 }
 
 /**
- * @brief
+ * @brief Finds the unique faces of a tetrahedral mesh. Face vertex ids are
+ * stored in ascending order and faces are sorted.
  * @tparam T
  * @param tetList
  * @param faceList
@@ -316,45 +404,12 @@ void FindHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 template <typename T>
 void FindTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 {
-  auto& tets = *tetList;
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-
-  std::set<std::tuple<T, T, T>> faceSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> tri0 = {tets[offset + 0], tets[offset + 1], tets[offset + 2]};
-    std::vector<T> tri1 = {tets[offset + 1], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri2 = {tets[offset + 0], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri3 = {tets[offset + 0], tets[offset + 1], tets[offset + 3]};
-    std::list<std::vector<T>> triList = {tri0, tri1, tri2, tri3};
-
-    for(auto&& tri : triList)
-    {
-      std::sort(tri.begin(), tri.end());
-      std::tuple<T, T, T> face = std::make_tuple(tri[0], tri[1], tri[2]);
-      faceSet.insert(face);
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceSet.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& face : faceSet)
-  {
-    uFaces[3 * index] = std::get<0>(face);
-    uFaces[3 * index + 1] = std::get<1>(face);
-    uFaces[3 * index + 2] = std::get<2>(face);
-    ++index;
-  }
+  detail::FindUniqueKeys<T, 3>(*tetList, detail::k_TetFaces, *faceList);
 }
 
 /**
- * @brief
+ * @brief Finds the unique faces of a hexahedral mesh. Face vertex ids are
+ * stored in ascending order and faces are sorted.
  * @tparam T
  * @param hexList
  * @param faceList
@@ -362,49 +417,12 @@ void FindTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 template <typename T>
 void FindHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 {
-  auto& hexas = *hexList;
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-
-  std::set<std::tuple<T, T, T, T>> faceSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> quad0 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 5], hexas[offset + 4]};
-    std::vector<T> quad1 = {hexas[offset + 1], hexas[offset + 2], hexas[offset + 6], hexas[offset + 5]};
-    std::vector<T> quad2 = {hexas[offset + 2], hexas[offset + 3], hexas[offset + 7], hexas[offset + 6]};
-    std::vector<T> quad3 = {hexas[offset + 3], hexas[offset + 0], hexas[offset + 4], hexas[offset + 7]};
-    std::vector<T> quad4 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> quad5 = {hexas[offset + 4], hexas[offset + 5], hexas[offset + 6], hexas[offset + 7]};
-
-    std::list<std::vector<T>> quadList = {quad0, quad1, quad2, quad3, quad4, quad5};
-
-    for(auto&& quad : quadList)
-    {
-      std::sort(quad.begin(), quad.end());
-      std::tuple<T, T, T, T> face = std::make_tuple(quad[0], quad[1], quad[2], quad[3]);
-      faceSet.insert(face);
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceSet.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& face : faceSet)
-  {
-    uFaces[4 * index] = std::get<0>(face);
-    uFaces[4 * index + 1] = std::get<1>(face);
-    uFaces[4 * index + 2] = std::get<2>(face);
-    uFaces[4 * index + 3] = std::get<3>(face);
-    ++index;
-  }
+  detail::FindUniqueKeys<T, 4>(*hexList, detail::k_HexFaces, *faceList);
 }
 
 /**
- * @brief
+ * @brief Finds the edges of a tetrahedral mesh that belong to a single
+ * tetrahedron.
  * @tparam T
  * @param tetList
  * @param edgeList
@@ -412,60 +430,12 @@ void FindHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 template <typename T>
 void FindUnsharedTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
 {
-  auto& tets = *tetList;
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> edge0 = {tets[offset + 0], tets[offset + 1]};
-    std::vector<T> edge1 = {tets[offset + 0], tets[offset + 2]};
-    std::vector<T> edge2 = {tets[offset + 1], tets[offset + 2]};
-    std::vector<T> edge3 = {tets[offset + 0], tets[offset + 3]};
-    std::vector<T> edge4 = {tets[offset + 1], tets[offset + 3]};
-    std::vector<T> edge5 = {tets[offset + 2], tets[offset + 3]};
-    std::list<std::vector<T>> edgeVecList = {edge0, edge1, edge2, edge3, edge4, edge5};
-
-    for(auto&& uEdge : edgeVecList)
-    {
-      std::sort(uEdge.begin(), uEdge.end());
-      std::pair<T, T> edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edgeList->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edgeList;
-  T index = 0;
-
-  for(auto& pair : edgeMap)
-  {
-    bEdges[2 * index] = pair.first.first;
-    bEdges[2 * index + 1] = pair.first.second;
-    ++index;
-  }
+  detail::FindUnsharedKeys<T, 2>(*tetList, detail::k_TetEdges, *edgeList);
 }
 
 /**
- * @brief
+ * @brief Finds the edges of a hexahedral mesh that belong to a single
+ * hexahedron.
  * @tparam T
  * @param hexList
  * @param edge_List
@@ -473,70 +443,12 @@ void FindUnsharedTetEdges(const DataArray<T>* tetList, DataArray<T>* edgeList)
 template <typename T>
 void FindUnsharedHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 {
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-  auto& hexas = *hexList;
-
-  std::pair<T, T> edge;
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> edge0 = {hexas[offset + 0], hexas[offset + 1]};
-    std::vector<T> edge1 = {hexas[offset + 1], hexas[offset + 2]};
-    std::vector<T> edge2 = {hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> edge3 = {hexas[offset + 3], hexas[offset + 0]};
-
-    std::vector<T> edge4 = {hexas[offset + 0], hexas[offset + 4]};
-    std::vector<T> edge5 = {hexas[offset + 1], hexas[offset + 5]};
-    std::vector<T> edge6 = {hexas[offset + 2], hexas[offset + 6]};
-    std::vector<T> edge7 = {hexas[offset + 3], hexas[offset + 7]};
-
-    std::vector<T> edge8 = {hexas[offset + 4], hexas[offset + 5]};
-    std::vector<T> edge9 = {hexas[offset + 5], hexas[offset + 6]};
-    std::vector<T> edge10 = {hexas[offset + 6], hexas[offset + 7]};
-    std::vector<T> edge11 = {hexas[offset + 7], hexas[offset + 4]};
-
-    std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5, edge6, edge7, edge8, edge9, edge10, edge11};
-
-    for(auto&& uEdge : edgeList)
-    {
-      std::sort(uEdge.begin(), uEdge.end());
-      edge = std::make_pair(uEdge[0], uEdge[1]);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edge_List->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edge_List;
-  T index = 0;
-
-  for(auto& pair : edgeMap)
-  {
-    bEdges[2 * index] = pair.first.first;
-    bEdges[2 * index + 1] = pair.first.second;
-    ++index;
-  }
+  detail::FindUnsharedKeys<T, 2>(*hexList, detail::k_HexEdges, *edge_List);
 }
 
 /**
- * @brief
+ * @brief Finds the faces of a tetrahedral mesh that belong to a single
+ * tetrahedron.
  * @tparam T
  * @param tetList
  * @param faceList
@@ -544,60 +456,12 @@ void FindUnsharedHexEdges(const DataArray<T>* hexList, DataArray<T>* edge_List)
 template <typename T>
 void FindUnsharedTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 {
-  const usize numElems = tetList->getNumberOfTuples();
-  const usize numVertsPerTet = tetList->getNumberOfComponents();
-  auto& tets = *tetList;
-
-  std::tuple<T, T, T> face;
-  std::map<std::tuple<T, T, T>, T> faceMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerTet;
-
-    std::vector<T> tri0 = {tets[offset + 0], tets[offset + 1], tets[offset + 2]};
-    std::vector<T> tri1 = {tets[offset + 1], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri2 = {tets[offset + 0], tets[offset + 2], tets[offset + 3]};
-    std::vector<T> tri3 = {tets[offset + 0], tets[offset + 1], tets[offset + 3]};
-    std::list<std::vector<T>> triList = {tri0, tri1, tri2, tri3};
-
-    for(auto&& tri : triList)
-    {
-      std::sort(tri.begin(), tri.end());
-      face = std::make_tuple(tri[0], tri[1], tri[2]);
-      faceMap[face]++;
-    }
-  }
-
-  typename std::map<std::tuple<T, T, T>, T>::iterator mapIter = faceMap.begin();
-
-  while(mapIter != faceMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      faceMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceMap.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& pair : faceMap)
-  {
-    uFaces[3 * index] = std::get<0>(pair.first);
-    uFaces[3 * index + 1] = std::get<1>(pair.first);
-    uFaces[3 * index + 2] = std::get<2>(pair.first);
-    ++index;
-  }
+  detail::FindUnsharedKeys<T, 3>(*tetList, detail::k_TetFaces, *faceList);
 }
 
 /**
- * @brief
+ * @brief Finds the faces of a hexahedral mesh that belong to a single
+ * hexahedron.
  * @tparam T
  * @param hexList
  * @param faceList
@@ -605,64 +469,12 @@ void FindUnsharedTetFaces(const DataArray<T>* tetList, DataArray<T>* faceList)
 template <typename T>
 void FindUnsharedHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 {
-  auto& hexas = *hexList;
-  const usize numElems = hexList->getNumberOfTuples();
-  const usize numVertsPerHex = hexList->getNumberOfComponents();
-
-  std::tuple<T, T, T, T> face;
-  std::map<std::tuple<T, T, T, T>, T> faceMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerHex;
-
-    std::vector<T> quad0 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 5], hexas[offset + 4]};
-    std::vector<T> quad1 = {hexas[offset + 1], hexas[offset + 2], hexas[offset + 6], hexas[offset + 5]};
-    std::vector<T> quad2 = {hexas[offset + 2], hexas[offset + 3], hexas[offset + 7], hexas[offset + 6]};
-    std::vector<T> quad3 = {hexas[offset + 3], hexas[offset + 0], hexas[offset + 4], hexas[offset + 7]};
-    std::vector<T> quad4 = {hexas[offset + 0], hexas[offset + 1], hexas[offset + 2], hexas[offset + 3]};
-    std::vector<T> quad5 = {hexas[offset + 4], hexas[offset + 5], hexas[offset + 6], hexas[offset + 7]};
-
-    std::list<std::vector<T>> quadList = {quad0, quad1, quad2, quad3, quad4, quad5};
-
-    for(auto&& quad : quadList)
-    {
-      std::sort(quad.begin(), quad.end());
-      face = std::make_tuple(quad[0], quad[1], quad[2], quad[3]);
-      faceMap[face]++;
-    }
-  }
-
-  typename std::map<std::tuple<T, T, T, T>, T>::iterator mapIter = faceMap.begin();
-
-  while(mapIter != faceMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      faceMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  faceList->getDataStore()->reshapeTuples({faceMap.size()});
-  auto& uFaces = *faceList;
-  T index = 0;
-
-  for(auto& pair : faceMap)
-  {
-    uFaces[4 * index] = std::get<0>(pair.first);
-    uFaces[4 * index + 1] = std::get<1>(pair.first);
-    uFaces[4 * index + 2] = std::get<2>(pair.first);
-    uFaces[4 * index + 3] = std::get<3>(pair.first);
-    ++index;
-  }
+  detail::FindUnsharedKeys<T, 4>(*hexList, detail::k_HexFaces, *faceList);
 }
 
 /**
- * @brief
+ * @brief Finds the unique edges of a triangle or quad mesh. Each edge is
+ * stored with its lower vertex id first and edges are sorted.
  * @tparam T
  * @param elemList
  * @param edgeList
@@ -670,66 +482,12 @@ void FindUnsharedHexFaces(const DataArray<T>* hexList, DataArray<T>* faceList)
 template <typename T>
 void Find2DElementEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 {
-  const usize numElems = elemList->getNumberOfTuples();
-  const usize numVertsPerElem = elemList->getNumberOfComponents();
-  auto& elems = *elemList;
-  T v0 = 0;
-  T v1 = 0;
-
-  std::set<std::pair<T, T>> edgeSet;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerElem;
-
-    for(usize j = 0; j < numVertsPerElem; j++)
-    {
-      if(j == (numVertsPerElem - 1))
-      {
-        if(elems[offset + j] > elems[offset + 0])
-        {
-          v0 = elems[offset + 0];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + 0];
-        }
-      }
-      else
-      {
-        if(elems[offset + j] > elems[offset + j + 1])
-        {
-          v0 = elems[offset + j + 1];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + j + 1];
-        }
-      }
-      std::pair<T, T> edge = std::make_pair(v0, v1);
-      edgeSet.insert(edge);
-    }
-  }
-
-  typename std::set<std::pair<T, T>>::iterator setIter;
-  edgeList->getDataStore()->reshapeTuples({edgeSet.size()});
-  auto& uEdges = *edgeList;
-  T index = 0;
-
-  for(auto& edge : edgeSet)
-  {
-    uEdges[2 * index] = edge.first;
-    uEdges[2 * index + 1] = edge.second;
-    ++index;
-  }
+  detail::FindUniqueKeys<T, 2>(*elemList, detail::Get2DElementEdges(elemList->getNumberOfComponents()), *edgeList);
 }
 
 /**
- * @brief
+ * @brief Finds the edges of a triangle or quad mesh that belong to a single
+ * element.
  * @tparam T
  * @param elemList
  * @param edgeList
@@ -737,75 +495,7 @@ void Find2DElementEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 template <typename T>
 void Find2DUnsharedEdges(const DataArray<T>* elemList, DataArray<T>* edgeList)
 {
-  auto& elems = *elemList;
-  const usize numElems = elemList->getNumberOfTuples();
-  const usize numVertsPerElem = elemList->getNumberOfComponents();
-  T v0 = 0;
-  T v1 = 0;
-
-  std::map<std::pair<T, T>, T> edgeMap;
-
-  for(usize i = 0; i < numElems; i++)
-  {
-    const usize offset = i * numVertsPerElem;
-
-    for(usize j = 0; j < numVertsPerElem; j++)
-    {
-      if(j == (numVertsPerElem - 1))
-      {
-        if(elems[offset + j] > elems[offset + 0])
-        {
-          v0 = elems[offset + 0];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + 0];
-        }
-      }
-      else
-      {
-        if(elems[offset + j] > elems[offset + j + 1])
-        {
-          v0 = elems[offset + j + 1];
-          v1 = elems[offset + j];
-        }
-        else
-        {
-          v0 = elems[offset + j];
-          v1 = elems[offset + j + 1];
-        }
-      }
-      std::pair<T, T> edge = std::make_pair(v0, v1);
-      edgeMap[edge]++;
-    }
-  }
-
-  typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-  while(mapIter != edgeMap.end())
-  {
-    if((*mapIter).second > 1)
-    {
-      edgeMap.erase(mapIter++);
-    }
-    else
-    {
-      ++mapIter;
-    }
-  }
-
-  edgeList->getDataStore()->reshapeTuples({edgeMap.size()});
-  auto& bEdges = *edgeList;
-  T index = 0;
-
-  for(auto& edge : edgeMap)
-  {
-    bEdges[2 * index] = edge.first.first;
-    bEdges[2 * index + 1] = edge.first.second;
-    ++index;
-  }
+  detail::FindUnsharedKeys<T, 2>(*elemList, detail::Get2DElementEdges(elemList->getNumberOfComponents()), *edgeList);
 }
 } // namespace Connectivity
 
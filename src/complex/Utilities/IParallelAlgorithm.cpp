@@ -0,0 +1,47 @@
+#include "IParallelAlgorithm.hpp"
+
+#include "complex/DataStructure/IDataArray.hpp"
+
+#include <algorithm>
+
+using namespace complex;
+
+// -----------------------------------------------------------------------------
+IParallelAlgorithm::IParallelAlgorithm() = default;
+
+// -----------------------------------------------------------------------------
+IParallelAlgorithm::~IParallelAlgorithm() = default;
+
+// -----------------------------------------------------------------------------
+bool IParallelAlgorithm::CheckArraysInMemory(const AlgorithmArrays& arrays)
+{
+  return std::all_of(arrays.cbegin(), arrays.cend(), [](const IDataArray* array) {
+    if(array == nullptr)
+    {
+      return true;
+    }
+    const IDataStore* store = array->getIDataStore();
+    return store == nullptr || store->isContiguous();
+  });
+}
+
+// -----------------------------------------------------------------------------
+bool IParallelAlgorithm::getParallelizationEnabled() const
+{
+  return m_RunParallel;
+}
+
+// -----------------------------------------------------------------------------
+void IParallelAlgorithm::setParallelizationEnabled(bool doParallel)
+{
+  m_RunParallel = doParallel;
+}
+
+// -----------------------------------------------------------------------------
+void IParallelAlgorithm::requireArraysInMemory(const AlgorithmArrays& arrays)
+{
+  if(!CheckArraysInMemory(arrays))
+  {
+    m_RunParallel = false;
+  }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "complex/complex_export.hpp"
+
+#include <vector>
+
+namespace complex
+{
+class IDataArray;
+
+/**
+ * @brief The IParallelAlgorithm class holds the settings shared by the parallel algorithm classes:
+ * whether parallelization is enabled, and whether the arrays an algorithm touches allow it to run
+ * in parallel efficiently.
+ */
+class COMPLEX_EXPORT IParallelAlgorithm
+{
+public:
+  using AlgorithmArrays = std::vector<const IDataArray*>;
+
+  /**
+   * @brief Returns true if every array is held contiguously in memory. Null entries are ignored.
+   * @param arrays
+   * @return
+   */
+  static bool CheckArraysInMemory(const AlgorithmArrays& arrays);
+
+  /**
+   * @brief Returns true if parallelization is enabled.  Returns false otherwise.
+   * @return
+   */
+  bool getParallelizationEnabled() const;
+
+  /**
+   * @brief Sets whether parallelization is enabled.
+   * @param doParallel
+   */
+  void setParallelizationEnabled(bool doParallel);
+
+  /**
+   * @brief Disables parallelization if any of the arrays is not held contiguously in memory.
+   * Out-of-core stores may be accessed from several threads, but every element access takes the
+   * store's lock, so algorithms that index such arrays element by element run better serially.
+   * @param arrays The arrays the algorithm reads or writes
+   */
+  void requireArraysInMemory(const AlgorithmArrays& arrays);
+
+protected:
+  IParallelAlgorithm();
+  ~IParallelAlgorithm();
+
+  IParallelAlgorithm(const IParallelAlgorithm&) = default;
+  IParallelAlgorithm(IParallelAlgorithm&&) noexcept = default;
+  IParallelAlgorithm& operator=(const IParallelAlgorithm&) = default;
+  IParallelAlgorithm& operator=(IParallelAlgorithm&&) noexcept = default;
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+  bool m_RunParallel = true;
+#else
+  bool m_RunParallel = false;
+#endif
+};
+} // namespace complex
@@ -1,6 +1,12 @@
 #include "OStreamUtilities.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <fmt/compile.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
@@ -14,8 +20,143 @@ namespace // for nonmember functions
 {
 const std::array<std::string, 5> k_DelimiterStrings = {" ", ";", ",", ":", "\t"}; // Don't reorder
 
+constexpr usize k_BlocksPerThread = 4;
+constexpr usize k_ValuesPerBlock = 65536;
+constexpr usize k_MaxValueChars = 32;
+
+/**
+ * @brief Appends the text of a single value to the buffer. Integers are formatted with
+ * std::to_chars, 8 bit integers are printed as numbers rather than characters and floating
+ * point values use the shortest representation that round trips (the same text as fmt "{}").
+ * @param buffer The buffer to append to
+ * @param value The value to format
+ */
+template <typename ScalarType>
+void AppendValue(std::string& buffer, ScalarType value)
+{
+  if constexpr(std::is_same_v<ScalarType, bool>)
+  {
+    buffer.push_back(value ? '1' : '0');
+  }
+  else
+  {
+    std::array<char, k_MaxValueChars> chars = {};
+    char* last = chars.data();
+    if constexpr(std::is_floating_point_v<ScalarType>)
+    {
+      last = fmt::format_to(chars.data(), FMT_COMPILE("{}"), value);
+    }
+    else if constexpr(sizeof(ScalarType) == 1)
+    {
+      last = std::to_chars(chars.data(), chars.data() + chars.size(), static_cast<int32>(value)).ptr;
+    }
+    else
+    {
+      last = std::to_chars(chars.data(), chars.data() + chars.size(), value).ptr;
+    }
+    buffer.append(chars.data(), last);
+  }
+}
+
+/**
+ * @brief Reads values straight from the memory of contiguous data stores and falls back to
+ * the virtual accessor for every other store.
+ */
+template <typename ScalarType>
+class ValueReader
+{
+public:
+  explicit ValueReader(const AbstractDataStore<ScalarType>& dataStore)
+  : m_DataStore(dataStore)
+  , m_Values(dataStore.isContiguous() ? dataStore.contiguousSpan().data() : nullptr)
+  {
+  }
+
+  ScalarType operator[](usize index) const
+  {
+    return m_Values != nullptr ? m_Values[index] : m_DataStore.getValue(index);
+  }
+
+  /**
+   * @brief Only contiguous stores are read from several threads at once.
+   * @return bool
+   */
+  bool isContiguous() const
+  {
+    return m_Values != nullptr;
+  }
+
+private:
+  const AbstractDataStore<ScalarType>& m_DataStore;
+  const ScalarType* m_Values = nullptr;
+};
+
 /**
- * @brief implicit writing of **NeighborList**'s elements to outputStrm
+ * @brief Formats numRows rows in blocks and writes the blocks to the stream in order. Each batch
+ * of blocks is formatted in parallel, every block into its own buffer that is reused by the next
+ * batch, so the stream only receives one large write per block. Progress is reported and the
+ * cancel flag is checked between batches.
+ * @param outputStrm the ostream to write to
+ * @param numRows The number of rows to write
+ * @param rowsPerBlock The number of rows formatted into a single buffer
+ * @param parallel Whether the rows may be formatted by several threads
+ * @param progressLabel The text that prefixes the progress messages
+ * @param mesgHandler The message handler to dump progress updates to
+ * @param shouldCancel The atomic boolean that determines cancel
+ * @param formatRows Callable (std::string& buffer, usize firstRow, usize lastRow) that appends the text of the rows [firstRow, lastRow)
+ */
+template <class FormatRowsFunc>
+void WriteRowBlocks(std::ostream& outputStrm, usize numRows, usize rowsPerBlock, bool parallel, const std::string& progressLabel, const IFilter::MessageHandler& mesgHandler,
+                    const std::atomic_bool& shouldCancel, const FormatRowsFunc& formatRows)
+{
+  if(numRows == 0)
+  {
+    return;
+  }
+  rowsPerBlock = std::max(rowsPerBlock, usize{1});
+  const usize numBlocks = (numRows + rowsPerBlock - 1) / rowsPerBlock;
+  const usize numThreads = parallel ? static_cast<usize>(ParallelScheduler::GetCoreBudget()) : 1;
+  const usize blocksPerBatch = std::min(numThreads * k_BlocksPerThread, numBlocks);
+  std::vector<std::string> buffers(blocksPerBatch);
+
+  auto start = std::chrono::steady_clock::now();
+  for(usize firstBlock = 0; firstBlock < numBlocks; firstBlock += blocksPerBatch)
+  {
+    const usize batchSize = std::min(blocksPerBatch, numBlocks - firstBlock);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, batchSize);
+    dataAlg.setParallelizationEnabled(parallel);
+    dataAlg.execute([&](const Range& range) {
+      for(usize bufferIndex = range.min(); bufferIndex < range.max(); bufferIndex++)
+      {
+        std::string& buffer = buffers[bufferIndex];
+        buffer.clear();
+        const usize block = firstBlock + bufferIndex;
+        formatRows(buffer, block * rowsPerBlock, std::min(numRows, (block + 1) * rowsPerBlock));
+      }
+    });
+    for(usize bufferIndex = 0; bufferIndex < batchSize; bufferIndex++)
+    {
+      outputStrm.write(buffers[bufferIndex].data(), static_cast<std::streamsize>(buffers[bufferIndex].size()));
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
+    {
+      const usize rowsDone = std::min(numRows, (firstBlock + batchSize) * rowsPerBlock);
+      mesgHandler(IFilter::Message::Type::Info, fmt::format("{}: {}% completed", progressLabel, static_cast<int32>(100 * static_cast<float>(rowsDone) / static_cast<float>(numRows))));
+      start = now;
+    }
+    if(shouldCancel)
+    {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief implicit writing of **NeighborList**'s elements to outputStrm. Each list is written on
+ * its own line as its element count followed by its values.
  * @tparam ScalarType The primitive type attacthed to **NeighborList**
  * @param outputStrm the ostream to write to
  * @param inputNeighborList The **NeighborList** that will have its values translated into strings
@@ -31,9 +172,8 @@ struct PrintNeighborList
   Result<> operator()(std::ostream& outputStrm, INeighborList* inputNeighborList, const IFilter::MessageHandler& mesgHandler, const std::atomic_bool& shouldCancel, const std::string& delimiter = ",",
                       bool hasIndex = false, bool hasHeader = false)
   {
-    auto& neighborList = *dynamic_cast<NeighborList<ScalarType>*>(inputNeighborList);
-    auto start = std::chrono::steady_clock::now();
-    auto numLists = neighborList.getNumberOfLists();
+    const auto& neighborList = *dynamic_cast<NeighborList<ScalarType>*>(inputNeighborList);
+    const auto numLists = static_cast<usize>(neighborList.getNumberOfLists());
 
     if(hasHeader)
     {
@@ -43,97 +183,52 @@ struct PrintNeighborList
       }
       outputStrm << "Element Count" << delimiter << inputNeighborList->getName() << "\n";
     }
-    if(hasIndex)
-    {
-      for(size_t list = 0; list < numLists; list++)
-      {
-        auto now = std::chrono::steady_clock::now();
-        if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-        {
-          auto string = fmt::format("Processing {}: {}% completed", neighborList.getName(), static_cast<int32>(100 * static_cast<float>(list) / static_cast<float>(numLists)));
-          mesgHandler(IFilter::Message::Type::Info, string);
-          start = now;
-          if(shouldCancel)
-          {
-            return {};
-          }
-        }
-        const auto& grain = neighborList.getListReference(list);
-        outputStrm << list << delimiter << grain.size() << delimiter;
-        for(size_t index = 0; index < grain.size(); index++)
-        {
-          if constexpr(std::is_same_v<ScalarType, int8> || std::is_same_v<ScalarType, uint8>)
-          {
-            outputStrm << static_cast<int32>(grain[index]);
-          }
-          else if constexpr(std::is_same_v<ScalarType, float32> || std::is_same_v<ScalarType, float64>)
-          {
-            outputStrm << fmt::format("{}", grain[index]);
-          }
-          else
-          {
-            outputStrm << grain[index];
-          }
-          if(index != grain.size() - 1)
-          {
-            outputStrm << delimiter;
-          }
-        }
-        outputStrm << "\n";
-      }
-    }
-    else // no index
+
+    // getListSpan() never converts the lists so they can be read from several threads
+    usize numValues = 0;
+    for(usize list = 0; list < numLists; list++)
     {
-      for(size_t list = 0; list < neighborList.getNumberOfLists(); list++)
-      {
-        auto now = std::chrono::steady_clock::now();
-        if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-        {
-          auto string = fmt::format("Processing {}: {}% completed", neighborList.getName(), static_cast<int32>(static_cast<float>(list) / static_cast<float>(numLists)));
-          mesgHandler(IFilter::Message::Type::Info, string);
-          start = now;
-          if(shouldCancel)
-          {
-            return {};
-          }
-        }
-        const auto& grain = neighborList.getListReference(list);
-        outputStrm << grain.size() << delimiter;
-        for(size_t index = 0; index < grain.size(); index++)
-        {
-          if constexpr(std::is_same_v<ScalarType, int8> || std::is_same_v<ScalarType, uint8>)
-          {
-            outputStrm << static_cast<int32>(grain[index]);
-          }
-          else if constexpr(std::is_same_v<ScalarType, float32> || std::is_same_v<ScalarType, float64>)
-          {
-            outputStrm << fmt::format("{}", grain[index]);
-          }
-          else
-          {
-            outputStrm << grain[index];
-          }
-          if(index != grain.size() - 1)
-          {
-            outputStrm << delimiter;
-          }
-        }
-        outputStrm << "\n";
-      }
+      numValues += neighborList.getListSpan(static_cast<int32>(list)).size();
     }
+    const usize valuesPerList = std::max(numValues / std::max(numLists, usize{1}), usize{1}) + 1;
+
+    WriteRowBlocks(outputStrm, numLists, k_ValuesPerBlock / valuesPerList, true, fmt::format("Processing {}", neighborList.getName()), mesgHandler, shouldCancel,
+                   [&](std::string& buffer, usize firstList, usize lastList) {
+                     for(usize list = firstList; list < lastList; list++)
+                     {
+                       const auto grain = neighborList.getListSpan(static_cast<int32>(list));
+                       if(hasIndex)
+                       {
+                         AppendValue(buffer, list);
+                         buffer.append(delimiter);
+                       }
+                       AppendValue(buffer, grain.size());
+                       buffer.append(delimiter);
+                       for(usize index = 0; index < grain.size(); index++)
+                       {
+                         if(index != 0)
+                         {
+                           buffer.append(delimiter);
+                         }
+                         AppendValue(buffer, grain[index]);
+                       }
+                       buffer.push_back('\n');
+                     }
+                   });
     return {};
   }
 };
 
 /**
- * @brief implicit writing of **DataArray**'s elements to outputStrm
+ * @brief implicit writing of **DataArray**'s elements to outputStrm. The values are written in
+ * order with componentsPerLine values on each line.
  * @tparam ScalarType The primitive type attacthed to **DataArray**
  * @param outputStrm the ostream to write to
  * @param inputDataArray The **DataArray** that will have its values translated into strings
  * @param mesgHandler The message handler to dump progress updates to
  * // default parameters
  * @param delimiter The delimiter to insert between values
- * @param componentsPerLine The number of components per line
+ * @param componentsPerLine The number of values per line, 0 writes one tuple per line
  */
 struct PrintDataArray
 {
@@ -141,52 +236,29 @@ struct PrintDataArray
   Result<> operator()(std::ostream& outputStrm, IDataArray* inputDataArray, const IFilter::MessageHandler& mesgHandler, const std::atomic_bool& shouldCancel, const std::string& delimiter = ",",
                       int32 componentsPerLine = 0)
   {
-    auto& dataArray = *dynamic_cast<DataArray<ScalarType>*>(inputDataArray);
-    auto start = std::chrono::steady_clock::now();
-    auto numTuples = dataArray.getNumberOfTuples();
-    auto maxLine = static_cast<size_t>(componentsPerLine);
-    if(componentsPerLine == 0)
-    {
-      maxLine = static_cast<size_t>(dataArray.getNumberOfComponents());
-    }
-
-    for(size_t tuple = 0; tuple < numTuples; tuple++)
-    {
-      auto now = std::chrono::steady_clock::now();
-      if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-      {
-        auto string = fmt::format("Processing {}: {}% completed", dataArray.getName(), static_cast<int32>(100 * static_cast<float>(tuple) / static_cast<float>(numTuples)));
-        mesgHandler(IFilter::Message::Type::Info, string);
-        start = now;
-        if(shouldCancel)
-        {
-          return {};
-        }
-      }
-      for(size_t index = 0; index < dataArray.getNumberOfComponents(); index++)
-      {
-        if constexpr(std::is_same_v<ScalarType, int8> || std::is_same_v<ScalarType, uint8>)
-        {
-          outputStrm << static_cast<int32>(dataArray[index]);
-        }
-        else if constexpr(std::is_same_v<ScalarType, float32> || std::is_same_v<ScalarType, float64>)
-        {
-          outputStrm << fmt::format("{}", dataArray[index]);
-        }
-        else
-        {
-          outputStrm << dataArray[index];
-        }
-        if(index != maxLine - 1)
-        {
-          outputStrm << delimiter;
-        }
-        else
-        {
-          outputStrm << "\n";
-        }
-      }
-    }
+    const auto& dataArray = *dynamic_cast<DataArray<ScalarType>*>(inputDataArray);
+    const ValueReader<ScalarType> values(dataArray.getDataStoreRef());
+    const usize numValues = dataArray.getSize();
+    const usize maxLine = componentsPerLine <= 0 ? dataArray.getNumberOfComponents() : static_cast<usize>(componentsPerLine);
+    const usize numLines = (numValues + maxLine - 1) / maxLine;
+
+    WriteRowBlocks(outputStrm, numLines, k_ValuesPerBlock / maxLine, values.isContiguous(), fmt::format("Processing {}", dataArray.getName()), mesgHandler, shouldCancel,
+                   [&](std::string& buffer, usize firstLine, usize lastLine) {
+                     for(usize line = firstLine; line < lastLine; line++)
+                     {
+                       const usize lineStart = line * maxLine;
+                       const usize lineEnd = std::min(numValues, lineStart + maxLine);
+                       for(usize index = lineStart; index < lineEnd; index++)
+                       {
+                         if(index != lineStart)
+                         {
+                           buffer.append(delimiter);
+                         }
+                         AppendValue(buffer, values[index]);
+                       }
+                       buffer.push_back('\n');
+                     }
+                   });
     return {};
   }
 };
@@ -198,46 +270,32 @@ struct PrintDataArray
  * @param mesgHandler The message handler to dump progress updates to
  * // default parameters
  * @param delimiter The delimiter to insert between values
- * @param componentsPerLine The number of components per line
+ * @param componentsPerLine The number of values per line, 0 writes one tuple per line
  */
 Result<> PrintStringArray(std::ostream& outputStrm, const StringArray& inputStringArray, const IFilter::MessageHandler& mesgHandler, const std::atomic_bool& shouldCancel,
                           const std::string& delimiter = ",", int32 componentsPerLine = 0)
 {
-  auto start = std::chrono::steady_clock::now();
-  auto numTuples = inputStringArray.getNumberOfTuples();
-  auto maxLine = static_cast<size_t>(componentsPerLine);
-  if(componentsPerLine == 0)
-  {
-    maxLine = static_cast<size_t>(inputStringArray.getNumberOfComponents());
-  }
-
-  for(size_t tuple = 0; tuple < numTuples; tuple++)
-  {
-    auto now = std::chrono::steady_clock::now();
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      auto string = fmt::format("Processing {}: {}% completed", inputStringArray.getName(), static_cast<int32>(100 * static_cast<float>(tuple) / static_cast<float>(numTuples)));
-      mesgHandler(IFilter::Message::Type::Info, string);
-      start = now;
-      if(shouldCancel)
-      {
-        return {};
-      }
-    }
-
-    for(size_t index = 0; index < inputStringArray.getNumberOfComponents(); index++)
-    {
-      outputStrm << inputStringArray[index];
-      if(index != maxLine - 1)
-      {
-        outputStrm << delimiter;
-      }
-      else
-      {
-        outputStrm << "\n";
-      }
-    }
-  }
+  const usize numValues = inputStringArray.getSize();
+  const usize maxLine = componentsPerLine <= 0 ? inputStringArray.getNumberOfComponents() : static_cast<usize>(componentsPerLine);
+  const usize numLines = (numValues + maxLine - 1) / maxLine;
+
+  WriteRowBlocks(outputStrm, numLines, k_ValuesPerBlock / maxLine, true, fmt::format("Processing {}", inputStringArray.getName()), mesgHandler, shouldCancel,
+                 [&](std::string& buffer, usize firstLine, usize lastLine) {
+                   for(usize line = firstLine; line < lastLine; line++)
+                   {
+                     const usize lineStart = line * maxLine;
+                     const usize lineEnd = std::min(numValues, lineStart + maxLine);
+                     for(usize index = lineStart; index < lineEnd; index++)
+                     {
+                       if(index != lineStart)
+                       {
+                         buffer.append(delimiter);
+                       }
+                       buffer.append(inputStringArray[index]);
+                     }
+                     buffer.push_back('\n');
+                   }
+                 });
 
   return {};
 }
@@ -247,8 +305,10 @@ class ITupleWriter
 public:
   ITupleWriter() = default;
   virtual ~ITupleWriter() = default;
-  virtual void write(std::ostream& outputStrm, usize tupleIndex) const = 0;
+  virtual void write(std::string& buffer, usize tupleIndex) const = 0;
   virtual void writeHeader(std::ostream& outputStrm) const = 0;
+  virtual usize getNumberOfComponents() const = 0;
+  virtual bool isContiguous() const = 0;
 };
 
 template <typename ScalarType>
@@ -259,32 +319,23 @@ class TupleWriter : public ITupleWriter
 public:
   TupleWriter(const IDataArray& iDataArray, const std::string& delimiter)
   : m_DataArray(dynamic_cast<const DataArray<ScalarType>&>(iDataArray))
+  , m_Values(m_DataArray.getDataStoreRef())
   , m_Delimiter(delimiter)
   {
     m_NumComps = m_DataArray.getNumberOfComponents();
   }
   ~TupleWriter() override = default;
 
-  void write(std::ostream& outputStrm, usize tupleIndex) const override
+  void write(std::string& buffer, usize tupleIndex) const override
   {
+    const usize offset = tupleIndex * m_NumComps;
     for(usize comp = 0; comp < m_NumComps; comp++)
     {
-      if constexpr(std::is_same_v<ScalarType, int8> || std::is_same_v<ScalarType, uint8>)
-      {
-        outputStrm << static_cast<int32>(m_DataArray[tupleIndex * m_NumComps + comp]);
-      }
-      else if constexpr(std::is_same_v<ScalarType, float32> || std::is_same_v<ScalarType, float64>)
-      {
-        outputStrm << fmt::format("{}", m_DataArray[tupleIndex * m_NumComps + comp]);
-      }
-      else
-      {
-        outputStrm << m_DataArray[tupleIndex * m_NumComps + comp];
-      }
-      if(comp < m_NumComps - 1)
+      if(comp != 0)
       {
-        outputStrm << m_Delimiter;
+        buffer.append(m_Delimiter);
       }
+      AppendValue(buffer, m_Values[offset + comp]);
     }
   }
 
@@ -308,9 +359,20 @@ public:
     }
   }
 
+  usize getNumberOfComponents() const override
+  {
+    return m_NumComps;
+  }
+
+  bool isContiguous() const override
+  {
+    return m_Values.isContiguous();
+  }
+
 private:
   const DataArrayType& m_DataArray;
-  const std::string& m_Delimiter = ",";
+  ValueReader<ScalarType> m_Values;
+  const std::string& m_Delimiter;
   usize m_NumComps = 1;
 };
 
@@ -465,7 +527,6 @@ void PrintDataSetsToSingleFile(std::ostream& outputStrm, const std::vector<DataP
 {
   const auto& firstDataArray = dataStructure.getDataRefAs<IDataArray>(objectPaths[0]);
   usize numTuples = firstDataArray.getNumberOfTuples();
-  auto start = std::chrono::steady_clock::now();
 
   // Create our wrapper classes for each DataArray
   std::vector<std::shared_ptr<ITupleWriter>> writers;
@@ -518,33 +579,36 @@ void PrintDataSetsToSingleFile(std::ostream& outputStrm, const std::vector<DataP
     return;
   }
 
-  // Loop on ever tuple using our predefined writer for each data array
-  for(usize tupleIndex = 0; tupleIndex < numTuples; tupleIndex++)
+  // Format blocks of tuples in parallel using our predefined writer for each data array
+  bool parallel = true;
+  usize valuesPerTuple = 1;
+  for(const auto& writer : writers)
   {
-    auto now = std::chrono::steady_clock::now();
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
+    parallel = parallel && writer->isContiguous();
+    valuesPerTuple += writer->getNumberOfComponents();
+  }
+  WriteRowBlocks(outputStrm, numTuples, k_ValuesPerBlock / valuesPerTuple, parallel, "Printing tuples", mesgHandler, shouldCancel, [&](std::string& buffer, usize firstTuple, usize lastTuple) {
+    for(usize tupleIndex = firstTuple; tupleIndex < lastTuple; tupleIndex++)
     {
-      auto string = fmt::format("Printing tuples: {}% completed", static_cast<int32>(100 * static_cast<float>(tupleIndex) / static_cast<float>(numTuples)));
-      mesgHandler(IFilter::Message::Type::Info, string);
-      start = now;
-      if(shouldCancel)
+      if(includeIndex)
       {
-        return;
+        AppendValue(buffer, tupleIndex);
+        buffer.append(delimiter);
       }
-    }
-    if(includeIndex)
-    {
-      outputStrm << tupleIndex << delimiter;
-    }
-    for(size_t writerIndex = 0; writerIndex < writersCount; writerIndex++)
-    {
-      writers[writerIndex]->write(outputStrm, tupleIndex);
-      if(writerIndex != writersCount - 1)
+      for(size_t writerIndex = 0; writerIndex < writersCount; writerIndex++)
       {
-        outputStrm << delimiter;
+        writers[writerIndex]->write(buffer, tupleIndex);
+        if(writerIndex != writersCount - 1)
+        {
+          buffer.append(delimiter);
+        }
       }
+      buffer.push_back('\n');
     }
-    outputStrm << '\n';
+  });
+  if(shouldCancel)
+  {
+    return;
   }
 
   if(!neighborLists.empty())
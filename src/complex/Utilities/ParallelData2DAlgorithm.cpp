@@ -1,5 +1,7 @@
 #include "ParallelData2DAlgorithm.hpp"
 
+#include <algorithm>
+
 using namespace complex;
 
 // -----------------------------------------------------------------------------
@@ -9,31 +11,43 @@ ParallelData2DAlgorithm::ParallelData2DAlgorithm() = default;
 ParallelData2DAlgorithm::~ParallelData2DAlgorithm() = default;
 
 // -----------------------------------------------------------------------------
-bool ParallelData2DAlgorithm::getParallelizationEnabled() const
+Range2D ParallelData2DAlgorithm::getRange() const
 {
-  return m_RunParallel;
+  return m_Range;
 }
 
 // -----------------------------------------------------------------------------
-void ParallelData2DAlgorithm::setParallelizationEnabled(bool doParallel)
+void ParallelData2DAlgorithm::setRange(const Range2D& range)
 {
-  m_RunParallel = doParallel;
+  m_Range = range;
 }
 
 // -----------------------------------------------------------------------------
-Range2D ParallelData2DAlgorithm::getRange() const
+void ParallelData2DAlgorithm::setRange(size_t minCols, size_t maxCols, size_t minRows, size_t maxRows)
 {
-  return m_Range;
+  m_Range = {minCols, maxCols, minRows, maxRows};
 }
 
 // -----------------------------------------------------------------------------
-void ParallelData2DAlgorithm::setRange(const Range2D& range)
+size_t ParallelData2DAlgorithm::getGrainSize() const
 {
-  m_Range = range;
+  return m_GrainSize;
 }
 
 // -----------------------------------------------------------------------------
-void ParallelData2DAlgorithm::setRange(size_t minCols, size_t maxCols, size_t minRows, size_t maxRows)
+void ParallelData2DAlgorithm::setGrainSize(size_t grainSize)
 {
-  m_Range = {minCols, maxCols, minRows, maxRows};
+  m_GrainSize = std::max<size_t>(grainSize, 1);
+}
+
+// -----------------------------------------------------------------------------
+ParallelScheduler::Partitioner ParallelData2DAlgorithm::getPartitioner() const
+{
+  return m_Partitioner;
+}
+
+// -----------------------------------------------------------------------------
+void ParallelData2DAlgorithm::setPartitioner(ParallelScheduler::Partitioner partitioner)
+{
+  m_Partitioner = partitioner;
 }
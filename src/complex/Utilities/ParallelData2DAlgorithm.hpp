@@ -3,12 +3,12 @@
 #include <array>
 
 #include "complex/Common/Range2D.hpp"
+#include "complex/Utilities/IParallelAlgorithm.hpp"
+#include "complex/Utilities/ParallelScheduler.hpp"
 #include "complex/complex_export.hpp"
 
 #ifdef COMPLEX_ENABLE_MULTICORE
 #include <tbb/blocked_range2d.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
 #endif
 
 #include <array>
@@ -23,7 +23,7 @@ namespace complex
  * utilizes TBB for parallelization and will fallback to non-parallelization if it is not
  * available or the parallelization is disabled.
  */
-class COMPLEX_EXPORT ParallelData2DAlgorithm
+class COMPLEX_EXPORT ParallelData2DAlgorithm : public IParallelAlgorithm
 {
 public:
   using RangeType = Range2D;
@@ -36,18 +36,6 @@ public:
   ParallelData2DAlgorithm& operator=(const ParallelData2DAlgorithm&) = default;
   ParallelData2DAlgorithm& operator=(ParallelData2DAlgorithm&&) noexcept = default;
 
-  /**
-   * @brief Returns true if parallelization is enabled.  Returns false otherwise.
-   * @return
-   */
-  bool getParallelizationEnabled() const;
-
-  /**
-   * @brief Sets whether parallelization is enabled.
-   * @param doParallel
-   */
-  void setParallelizationEnabled(bool doParallel);
-
   /**
    * @brief Returns the range to operate over.
    * @return
@@ -69,6 +57,31 @@ public:
    */
   void setRange(size_t minCols, size_t maxCols, size_t minRows, size_t maxRows);
 
+  /**
+   * @brief Returns the grain size: chunks with at most this many rows and columns are not split further.
+   * @return
+   */
+  size_t getGrainSize() const;
+
+  /**
+   * @brief Sets the grain size: chunks with at most this many rows and columns are not split further.
+   * Larger grains reduce the scheduling overhead of cheap bodies. Values below 1 are treated as 1.
+   * @param grainSize
+   */
+  void setGrainSize(size_t grainSize);
+
+  /**
+   * @brief Returns how the range is split across threads.
+   * @return
+   */
+  ParallelScheduler::Partitioner getPartitioner() const;
+
+  /**
+   * @brief Sets how the range is split across threads. Defaults to ParallelScheduler::Partitioner::Auto.
+   * @param partitioner
+   */
+  void setPartitioner(ParallelScheduler::Partitioner partitioner);
+
   /**
    * @brief Runs the data algorithm.  Parallelization is used if appropriate.
    * @param body
@@ -79,9 +92,8 @@ public:
 #ifdef COMPLEX_ENABLE_MULTICORE
     if(m_RunParallel)
     {
-      tbb::auto_partitioner partitioner;
-      tbb::blocked_range2d<size_t, size_t> tbbRange(m_Range.minRow(), m_Range.maxRow(), m_Range.minCol(), m_Range.maxCol());
-      tbb::parallel_for(tbbRange, body, partitioner);
+      tbb::blocked_range2d<size_t, size_t> tbbRange(m_Range.minRow(), m_Range.maxRow(), m_GrainSize, m_Range.minCol(), m_Range.maxCol(), m_GrainSize);
+      ParallelScheduler::ParallelFor(tbbRange, body, m_Partitioner);
     }
     else
 #endif
@@ -93,11 +105,8 @@ public:
 
 private:
   RangeType m_Range;
-#ifdef COMPLEX_ENABLE_MULTICORE
-  bool m_RunParallel = true;
-#else
-  bool m_RunParallel = false;
-#endif
+  size_t m_GrainSize = 1;
+  ParallelScheduler::Partitioner m_Partitioner = ParallelScheduler::Partitioner::Auto;
 };
 
 } // namespace complex
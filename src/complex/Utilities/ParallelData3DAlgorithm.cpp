@@ -1,5 +1,7 @@
 #include "ParallelData3DAlgorithm.hpp"
 
+#include <algorithm>
+
 using namespace complex;
 
 // -----------------------------------------------------------------------------
@@ -9,31 +11,43 @@ ParallelData3DAlgorithm::ParallelData3DAlgorithm() = default;
 ParallelData3DAlgorithm::~ParallelData3DAlgorithm() = default;
 
 // -----------------------------------------------------------------------------
-bool ParallelData3DAlgorithm::getParallelizationEnabled() const
+ParallelData3DAlgorithm::RangeType ParallelData3DAlgorithm::getRange() const
 {
-  return m_RunParallel;
+  return m_Range;
 }
 
 // -----------------------------------------------------------------------------
-void ParallelData3DAlgorithm::setParallelizationEnabled(bool doParallel)
+void ParallelData3DAlgorithm::setRange(const RangeType& range)
 {
-  m_RunParallel = doParallel;
+  m_Range = range;
 }
 
 // -----------------------------------------------------------------------------
-ParallelData3DAlgorithm::RangeType ParallelData3DAlgorithm::getRange() const
+void ParallelData3DAlgorithm::setRange(size_t xMax, size_t yMax, size_t zMax)
 {
-  return m_Range;
+  m_Range = {0, xMax, 0, yMax, 0, zMax};
 }
 
 // -----------------------------------------------------------------------------
-void ParallelData3DAlgorithm::setRange(const RangeType& range)
+size_t ParallelData3DAlgorithm::getGrainSize() const
 {
-  m_Range = range;
+  return m_GrainSize;
 }
 
 // -----------------------------------------------------------------------------
-void ParallelData3DAlgorithm::setRange(size_t xMax, size_t yMax, size_t zMax)
+void ParallelData3DAlgorithm::setGrainSize(size_t grainSize)
 {
-  m_Range = {0, xMax, 0, yMax, 0, zMax};
+  m_GrainSize = std::max<size_t>(grainSize, 1);
+}
+
+// -----------------------------------------------------------------------------
+ParallelScheduler::Partitioner ParallelData3DAlgorithm::getPartitioner() const
+{
+  return m_Partitioner;
+}
+
+// -----------------------------------------------------------------------------
+void ParallelData3DAlgorithm::setPartitioner(ParallelScheduler::Partitioner partitioner)
+{
+  m_Partitioner = partitioner;
 }
@@ -1,12 +1,12 @@
 #pragma once
 
 #include "complex/Common/Range3D.hpp"
+#include "complex/Utilities/IParallelAlgorithm.hpp"
+#include "complex/Utilities/ParallelScheduler.hpp"
 #include "complex/complex_export.hpp"
 
 #ifdef COMPLEX_ENABLE_MULTICORE
 #include <tbb/blocked_range3d.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
 #endif
 
 #include <array>
@@ -20,7 +20,7 @@ namespace complex
  * utilizes TBB for parallelization and will fallback to non-parallelization if it is not
  * available or the parallelization is disabled.
  */
-class COMPLEX_EXPORT ParallelData3DAlgorithm
+class COMPLEX_EXPORT ParallelData3DAlgorithm : public IParallelAlgorithm
 {
 public:
   using RangeType = Range3D;
@@ -33,18 +33,6 @@ public:
   ParallelData3DAlgorithm& operator=(const ParallelData3DAlgorithm&) = default;
   ParallelData3DAlgorithm& operator=(ParallelData3DAlgorithm&&) noexcept = default;
 
-  /**
-   * @brief Returns true if parallelization is enabled.  Returns false otherwise.
-   * @return
-   */
-  bool getParallelizationEnabled() const;
-
-  /**
-   * @brief Sets whether parallelization is enabled.
-   * @param doParallel
-   */
-  void setParallelizationEnabled(bool doParallel);
-
   /**
    * @brief Returns the range to operate over.
    * @return
@@ -63,6 +51,31 @@ public:
    */
   void setRange(size_t xMax, size_t yMax, size_t zMax);
 
+  /**
+   * @brief Returns the grain size: chunks with at most this many values along each axis are not split further.
+   * @return
+   */
+  size_t getGrainSize() const;
+
+  /**
+   * @brief Sets the grain size: chunks with at most this many values along each axis are not split further.
+   * Larger grains reduce the scheduling overhead of cheap bodies. Values below 1 are treated as 1.
+   * @param grainSize
+   */
+  void setGrainSize(size_t grainSize);
+
+  /**
+   * @brief Returns how the range is split across threads.
+   * @return
+   */
+  ParallelScheduler::Partitioner getPartitioner() const;
+
+  /**
+   * @brief Sets how the range is split across threads. Defaults to ParallelScheduler::Partitioner::Auto.
+   * @param partitioner
+   */
+  void setPartitioner(ParallelScheduler::Partitioner partitioner);
+
   /**
    * @brief Runs the data algorithm.  Parallelization is used if appropriate.
    * @param body
@@ -73,9 +86,8 @@ public:
 #ifdef COMPLEX_ENABLE_MULTICORE
     if(m_RunParallel)
     {
-      tbb::auto_partitioner partitioner;
-      tbb::blocked_range3d<size_t, size_t, size_t> tbbRange(m_Range[4], m_Range[5], m_Range[2], m_Range[3], m_Range[0], m_Range[1]);
-      tbb::parallel_for(tbbRange, body, partitioner);
+      tbb::blocked_range3d<size_t, size_t, size_t> tbbRange(m_Range[4], m_Range[5], m_GrainSize, m_Range[2], m_Range[3], m_GrainSize, m_Range[0], m_Range[1], m_GrainSize);
+      ParallelScheduler::ParallelFor(tbbRange, body, m_Partitioner);
     }
     else
 #endif
@@ -87,10 +99,7 @@ public:
 
 private:
   RangeType m_Range;
-#ifdef COMPLEX_ENABLE_MULTICORE
-  bool m_RunParallel = true;
-#else
-  bool m_RunParallel = false;
-#endif
+  size_t m_GrainSize = 1;
+  ParallelScheduler::Partitioner m_Partitioner = ParallelScheduler::Partitioner::Auto;
 };
 } // namespace complex
@@ -1,5 +1,7 @@
 #include "ParallelDataAlgorithm.hpp"
 
+#include <algorithm>
+
 using namespace complex;
 
 // -----------------------------------------------------------------------------
@@ -9,31 +11,43 @@ ParallelDataAlgorithm::ParallelDataAlgorithm() = default;
 ParallelDataAlgorithm::~ParallelDataAlgorithm() = default;
 
 // -----------------------------------------------------------------------------
-bool ParallelDataAlgorithm::getParallelizationEnabled() const
+Range ParallelDataAlgorithm::getRange() const
 {
-  return m_RunParallel;
+  return m_Range;
 }
 
 // -----------------------------------------------------------------------------
-void ParallelDataAlgorithm::setParallelizationEnabled(bool doParallel)
+void ParallelDataAlgorithm::setRange(const Range& range)
 {
-  m_RunParallel = doParallel;
+  m_Range = range;
 }
 
 // -----------------------------------------------------------------------------
-Range ParallelDataAlgorithm::getRange() const
+void ParallelDataAlgorithm::setRange(size_t min, size_t max)
 {
-  return m_Range;
+  m_Range = {min, max};
 }
 
 // -----------------------------------------------------------------------------
-void ParallelDataAlgorithm::setRange(const Range& range)
+size_t ParallelDataAlgorithm::getGrainSize() const
 {
-  m_Range = range;
+  return m_GrainSize;
 }
 
 // -----------------------------------------------------------------------------
-void ParallelDataAlgorithm::setRange(size_t min, size_t max)
+void ParallelDataAlgorithm::setGrainSize(size_t grainSize)
 {
-  m_Range = {min, max};
+  m_GrainSize = std::max<size_t>(grainSize, 1);
+}
+
+// -----------------------------------------------------------------------------
+ParallelScheduler::Partitioner ParallelDataAlgorithm::getPartitioner() const
+{
+  return m_Partitioner;
+}
+
+// -----------------------------------------------------------------------------
+void ParallelDataAlgorithm::setPartitioner(ParallelScheduler::Partitioner partitioner)
+{
+  m_Partitioner = partitioner;
 }
@@ -1,12 +1,12 @@
 #pragma once
 
 #include "complex/Common/Range.hpp"
+#include "complex/Utilities/IParallelAlgorithm.hpp"
+#include "complex/Utilities/ParallelScheduler.hpp"
 #include "complex/complex_export.hpp"
 
 #ifdef COMPLEX_ENABLE_MULTICORE
 #include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
 #endif
 
 #include <array>
@@ -20,7 +20,7 @@ namespace complex
  * utilizes TBB for parallelization and will fallback to non-parallelization if it is not
  * available or the parallelization is disabled.
  */
-class COMPLEX_EXPORT ParallelDataAlgorithm
+class COMPLEX_EXPORT ParallelDataAlgorithm : public IParallelAlgorithm
 {
 public:
   using RangeType = Range;
@@ -33,18 +33,6 @@ public:
   ParallelDataAlgorithm& operator=(const ParallelDataAlgorithm&) = default;
   ParallelDataAlgorithm& operator=(ParallelDataAlgorithm&&) noexcept = default;
 
-  /**
-   * @brief Returns true if parallelization is enabled.  Returns false otherwise.
-   * @return
-   */
-  bool getParallelizationEnabled() const;
-
-  /**
-   * @brief Sets whether parallelization is enabled.
-   * @param doParallel
-   */
-  void setParallelizationEnabled(bool doParallel);
-
   /**
    * @brief Returns the range to operate over.
    * @return
@@ -64,6 +52,31 @@ public:
    */
   void setRange(size_t min, size_t max);
 
+  /**
+   * @brief Returns the grain size: chunks with at most this many values are not split further.
+   * @return
+   */
+  size_t getGrainSize() const;
+
+  /**
+   * @brief Sets the grain size: chunks with at most this many values are not split further.
+   * Larger grains reduce the scheduling overhead of cheap bodies. Values below 1 are treated as 1.
+   * @param grainSize
+   */
+  void setGrainSize(size_t grainSize);
+
+  /**
+   * @brief Returns how the range is split across threads.
+   * @return
+   */
+  ParallelScheduler::Partitioner getPartitioner() const;
+
+  /**
+   * @brief Sets how the range is split across threads. Defaults to ParallelScheduler::Partitioner::Auto.
+   * @param partitioner
+   */
+  void setPartitioner(ParallelScheduler::Partitioner partitioner);
+
   /**
    * @brief Runs the data algorithm.  Parallelization is used if appropriate.
    * @param body
@@ -74,9 +87,8 @@ public:
 #ifdef COMPLEX_ENABLE_MULTICORE
     if(m_RunParallel)
     {
-      tbb::auto_partitioner partitioner;
-      tbb::blocked_range<size_t> tbbRange(m_Range[0], m_Range[1]);
-      tbb::parallel_for(tbbRange, body, partitioner);
+      tbb::blocked_range<size_t> tbbRange(m_Range[0], m_Range[1], m_GrainSize);
+      ParallelScheduler::ParallelFor(tbbRange, body, m_Partitioner);
     }
     else
 #endif
@@ -88,10 +100,7 @@ public:
 
 private:
   RangeType m_Range;
-#ifdef COMPLEX_ENABLE_MULTICORE
-  bool m_RunParallel = true;
-#else
-  bool m_RunParallel = false;
-#endif
+  size_t m_GrainSize = 1;
+  ParallelScheduler::Partitioner m_Partitioner = ParallelScheduler::Partitioner::Auto;
 };
 } // namespace complex
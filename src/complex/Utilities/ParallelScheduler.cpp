@@ -0,0 +1,103 @@
+#include "ParallelScheduler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace complex;
+
+namespace
+{
+constexpr const char k_CoreBudgetVariable[] = "COMPLEX_CORE_BUDGET";
+
+std::mutex& GetSchedulerMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+/**
+ * @brief Returns the budget requested through the environment or 0 if it is missing or invalid.
+ */
+uint32 ReadCoreBudgetVariable()
+{
+  const char* value = std::getenv(k_CoreBudgetVariable);
+  if(value == nullptr)
+  {
+    return 0;
+  }
+  try
+  {
+    const long cores = std::stol(value);
+    return cores > 0 ? static_cast<uint32>(cores) : 0;
+  } catch(const std::exception&)
+  {
+    return 0;
+  }
+}
+
+uint32 ClampCoreBudget(uint32 cores)
+{
+  const uint32 hardwareConcurrency = ParallelScheduler::GetHardwareConcurrency();
+  return cores == 0 ? hardwareConcurrency : std::min(cores, hardwareConcurrency);
+}
+
+uint32& GetCoreBudgetValue()
+{
+  static uint32 coreBudget = ClampCoreBudget(ReadCoreBudgetVariable());
+  return coreBudget;
+}
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+std::unique_ptr<tbb::task_arena>& GetArenaPointer()
+{
+  static std::unique_ptr<tbb::task_arena> arena;
+  return arena;
+}
+#endif
+} // namespace
+
+// -----------------------------------------------------------------------------
+uint32 ParallelScheduler::GetHardwareConcurrency()
+{
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+// -----------------------------------------------------------------------------
+uint32 ParallelScheduler::GetCoreBudget()
+{
+#ifdef COMPLEX_ENABLE_MULTICORE
+  std::lock_guard<std::mutex> lock(GetSchedulerMutex());
+  return GetCoreBudgetValue();
+#else
+  return 1;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void ParallelScheduler::SetCoreBudget(uint32 cores)
+{
+  std::lock_guard<std::mutex> lock(GetSchedulerMutex());
+  GetCoreBudgetValue() = ClampCoreBudget(cores);
+#ifdef COMPLEX_ENABLE_MULTICORE
+  // The next call to GetArena() creates an arena with the new concurrency
+  GetArenaPointer().reset();
+#endif
+}
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+// -----------------------------------------------------------------------------
+tbb::task_arena& ParallelScheduler::GetArena()
+{
+  std::lock_guard<std::mutex> lock(GetSchedulerMutex());
+  auto& arena = GetArenaPointer();
+  if(arena == nullptr)
+  {
+    arena = std::make_unique<tbb::task_arena>(static_cast<int>(GetCoreBudgetValue()));
+  }
+  return *arena;
+}
+#endif
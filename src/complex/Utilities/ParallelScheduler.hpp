@@ -0,0 +1,110 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+#endif
+
+#include <utility>
+
+namespace complex
+{
+/**
+ * @brief The ParallelScheduler class owns the task arena that every parallel algorithm in complex
+ * runs in. The arena is sized by the core budget, so several pipelines running in the same process,
+ * or several processes on the same node, can each be limited to their share of the cores.
+ *
+ * The initial budget is read from the COMPLEX_CORE_BUDGET environment variable. If it is not set,
+ * every hardware thread is used.
+ */
+class COMPLEX_EXPORT ParallelScheduler
+{
+public:
+  /**
+   * @brief How a data range is split into the chunks handed to the threads.
+   */
+  enum class Partitioner : uint8
+  {
+    Auto = 0,  // Splits adaptively as threads run out of work. Chunks are at least the grain size.
+    Simple = 1, // Splits until every chunk is no larger than the grain size.
+    Static = 2  // Splits evenly into one chunk per thread with no work stealing. Best for uniform work.
+  };
+
+  ParallelScheduler() = delete;
+
+  /**
+   * @brief Returns the number of hardware threads, at least 1.
+   * @return uint32
+   */
+  static uint32 GetHardwareConcurrency();
+
+  /**
+   * @brief Returns the maximum number of threads parallel algorithms run on, at least 1.
+   * Algorithms that split their work into one chunk per thread should use this value.
+   * @return uint32
+   */
+  static uint32 GetCoreBudget();
+
+  /**
+   * @brief Sets the maximum number of threads parallel algorithms run on. 0 selects every hardware
+   * thread and larger values are reduced to the hardware concurrency. The arena is rebuilt, so this
+   * must not be called while a parallel algorithm is running.
+   * @param cores
+   */
+  static void SetCoreBudget(uint32 cores);
+
+  /**
+   * @brief Runs func on the calling thread inside the shared arena, so that any parallel work it
+   * starts is limited to the core budget. Calls from a thread already in the arena run directly.
+   * @param func
+   */
+  template <class FuncT>
+  static void Execute(FuncT&& func)
+  {
+#ifdef COMPLEX_ENABLE_MULTICORE
+    GetArena().execute(std::forward<FuncT>(func));
+#else
+    func();
+#endif
+  }
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+  /**
+   * @brief Returns the shared arena, creating it on first use.
+   * @return tbb::task_arena&
+   */
+  static tbb::task_arena& GetArena();
+
+  /**
+   * @brief Runs tbb::parallel_for over range with the given partitioner inside the shared arena.
+   * The grain size is taken from the range.
+   * @param range
+   * @param body
+   * @param partitioner
+   */
+  template <class TbbRangeT, class BodyT>
+  static void ParallelFor(const TbbRangeT& range, const BodyT& body, Partitioner partitioner)
+  {
+    Execute([&]() {
+      switch(partitioner)
+      {
+      case Partitioner::Simple:
+        tbb::parallel_for(range, body, tbb::simple_partitioner());
+        break;
+      case Partitioner::Static:
+        tbb::parallel_for(range, body, tbb::static_partitioner());
+        break;
+      case Partitioner::Auto:
+      default:
+        tbb::parallel_for(range, body, tbb::auto_partitioner());
+        break;
+      }
+    });
+  }
+#endif
+};
+} // namespace complex
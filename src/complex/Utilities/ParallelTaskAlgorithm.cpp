@@ -11,21 +11,7 @@ ParallelTaskAlgorithm::ParallelTaskAlgorithm() = default;
 // -----------------------------------------------------------------------------
 ParallelTaskAlgorithm::~ParallelTaskAlgorithm()
 {
-#ifdef COMPLEX_ENABLE_MULTICORE
-  m_TaskGroup.wait();
-#endif
-}
-
-// -----------------------------------------------------------------------------
-bool ParallelTaskAlgorithm::getParallelizationEnabled() const
-{
-  return m_RunParallel;
-}
-
-// -----------------------------------------------------------------------------
-void ParallelTaskAlgorithm::setParallelizationEnabled(bool doParallel)
-{
-  m_RunParallel = doParallel;
+  wait();
 }
 
 // -----------------------------------------------------------------------------
@@ -41,15 +27,32 @@ uint32_t ParallelTaskAlgorithm::getMaxThreads() const
 // -----------------------------------------------------------------------------
 void ParallelTaskAlgorithm::setMaxThreads(uint32_t threads)
 {
-  m_MaxThreads = std::min(threads, std::thread::hardware_concurrency());
+#ifdef COMPLEX_ENABLE_MULTICORE
+  m_MaxThreads = std::max(std::min(threads, ParallelScheduler::GetCoreBudget()), 1u);
+  m_Arena.reset();
+#endif
 }
 
 // -----------------------------------------------------------------------------
 void ParallelTaskAlgorithm::wait()
 {
 #ifdef COMPLEX_ENABLE_MULTICORE
-  // This will spill over if the number of files to process does not divide evenly by the number of threads.
-  m_TaskGroup.wait();
-  m_CurThreads = 0;
+  getArena().execute([this]() { m_TaskGroup.wait(); });
 #endif
 }
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+// -----------------------------------------------------------------------------
+tbb::task_arena& ParallelTaskAlgorithm::getArena()
+{
+  if(m_MaxThreads >= ParallelScheduler::GetCoreBudget())
+  {
+    return ParallelScheduler::GetArena();
+  }
+  if(m_Arena == nullptr)
+  {
+    m_Arena = std::make_unique<tbb::task_arena>(static_cast<int>(m_MaxThreads));
+  }
+  return *m_Arena;
+}
+#endif
@@ -1,13 +1,17 @@
 #pragma once
 
+#include "complex/Utilities/IParallelAlgorithm.hpp"
+#include "complex/Utilities/ParallelScheduler.hpp"
 #include "complex/complex_export.hpp"
 
 #ifdef COMPLEX_ENABLE_MULTICORE
+#include <tbb/task_arena.h>
 #include <tbb/task_group.h>
 #endif
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 namespace complex
@@ -18,25 +22,17 @@ namespace complex
  * An object with a function operator is required to operate the task.  This class utilizes
  * TBB for parallelization and will fallback to non-parallelization if it is not available
  * or the parallelization is disabled.
+ *
+ * Tasks are submitted without blocking and idle threads steal them as they finish their current
+ * task, so one long task does not hold back the others. The tasks run in the arena of the
+ * ParallelScheduler, or in a smaller arena of their own if setMaxThreads() asks for fewer threads.
  */
-class COMPLEX_EXPORT ParallelTaskAlgorithm
+class COMPLEX_EXPORT ParallelTaskAlgorithm : public IParallelAlgorithm
 {
 public:
   ParallelTaskAlgorithm();
   virtual ~ParallelTaskAlgorithm();
 
-  /**
-   * @brief Returns true if parallelization is enabled.  Returns false otherwise.
-   * @return
-   */
-  bool getParallelizationEnabled() const;
-
-  /**
-   * @brief Sets whether parallelization is enabled.
-   * @param doParallel
-   */
-  void setParallelizationEnabled(bool doParallel);
-
   /**
    * @brief Return maximum threads to use for parallelization.  If Parallel Algorithms
    * is not enabled, the maximum hardware concurrency is returned instead.
@@ -45,16 +41,17 @@ public:
   uint32_t getMaxThreads() const;
 
   /**
-   * @brief Sets the maximum number of threads to use.  This amount is automatically
-   * reduced to the max hardware concurrency.
+   * @brief Sets the maximum number of threads the tasks run on at once.  This amount is
+   * automatically reduced to the core budget of the ParallelScheduler.  Must not be called
+   * while tasks are running.
    * @param threads
    */
   void setMaxThreads(uint32_t threads);
 
   /**
    * @brief Executes the given object's function operator.  If parallel algorithms
-   * is enabled, this process is multi-threaded.  Otherwise, this process is done
-   * in a single thread.
+   * is enabled, the task is queued and this call returns immediately.  Otherwise, the
+   * task is run on the calling thread before returning.
    * @param body
    */
   template <typename Body>
@@ -63,12 +60,7 @@ public:
 #ifdef COMPLEX_ENABLE_MULTICORE
     if(m_RunParallel)
     {
-      m_TaskGroup.run(body);
-      m_CurThreads++;
-      if(m_CurThreads >= m_MaxThreads)
-      {
-        wait();
-      }
+      getArena().execute([this, &body]() { m_TaskGroup.run(body); });
     }
     else
 #endif
@@ -78,19 +70,23 @@ public:
   }
 
   /**
-   * @brief Waits for the threads to finish and resets the current thread count.
+   * @brief Waits for every queued task to finish.  The calling thread helps to run them.
    */
   void wait();
 
 private:
 #ifdef COMPLEX_ENABLE_MULTICORE
-  uint32_t m_MaxThreads = std::thread::hardware_concurrency();
-  bool m_RunParallel = true;
+  /**
+   * @brief Returns the arena the tasks run in.
+   * @return
+   */
+  tbb::task_arena& getArena();
+
+  uint32_t m_MaxThreads = ParallelScheduler::GetCoreBudget();
   tbb::task_group m_TaskGroup;
-  uint32_t m_CurThreads = 0;
+  std::unique_ptr<tbb::task_arena> m_Arena;
 #else
   uint32_t m_MaxThreads = 1;
-  bool m_RunParallel = false;
 #endif
 };
 } // namespace complex
@@ -16,14 +16,19 @@
 #include "complex/DataStructure/Geometry/TetrahedralGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
+#include "complex/DataStructure/LazyDataStore.hpp"
 #include "complex/DataStructure/NeighborList.hpp"
 #include "complex/DataStructure/StringArray.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
+#include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DataStructureReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5DataStructureWriter.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileWriter.hpp"
 
+#include <H5Fpublic.h>
+
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -740,10 +745,11 @@ complex::DREAM3D::PipelineVersionType complex::DREAM3D::GetPipelineVersion(const
   return pipelineVersionAttribute.readAsValue<PipelineVersionType>();
 }
 
-Result<DataStructure> ImportDataStructureV8(const H5::FileReader& fileReader, bool preflight)
+Result<DataStructure> ImportDataStructureV8(const H5::FileReader& fileReader, bool preflight, bool lazyLoad)
 {
   H5::ErrorType errorCode = 0;
   H5::DataStructureReader dataStructureReader;
+  dataStructureReader.setLazyLoading(lazyLoad);
   auto dataStructure = dataStructureReader.readH5Group(fileReader, errorCode, preflight);
   if(errorCode < 0)
   {
@@ -909,11 +915,12 @@ template <typename T>
 void createLegacyNeighborList(DataStructure& ds, DataObject ::IdType parentId, const H5::GroupReader& parentReader, const H5::DatasetReader& datasetReader, const std::vector<usize>& tupleDims)
 {
   auto numTuples = std::accumulate(tupleDims.cbegin(), tupleDims.cend(), static_cast<usize>(1), std::multiplies<>());
-  auto data = NeighborList<T>::ReadHdf5Data(parentReader, datasetReader);
+  auto lists = NeighborList<T>::ReadHdf5CompressedData(parentReader, datasetReader);
   auto* neighborList = NeighborList<T>::Create(ds, datasetReader.getName(), numTuples, parentId);
-  for(usize i = 0; i < data.size(); ++i)
+  neighborList->setCompressedLists(std::move(lists.offsets), std::move(lists.values));
+  if(neighborList->getNumberOfTuples() < numTuples)
   {
-    neighborList->setList(i, data[i]);
+    neighborList->resizeTuples(numTuples);
   }
 }
 
@@ -1293,12 +1300,12 @@ Result<DataStructure> ImportLegacyDataStructure(const H5::FileReader& fileReader
   return {std::move(ds)};
 }
 
-Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight)
+Result<complex::DataStructure> complex::DREAM3D::ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight, bool lazyLoad)
 {
   const auto fileVersion = GetFileVersion(fileReader);
   if(fileVersion == k_CurrentFileVersion)
   {
-    return ImportDataStructureV8(fileReader, preflight);
+    return ImportDataStructureV8(fileReader, preflight, lazyLoad);
   }
   else if(fileVersion == Legacy::FileVersion)
   {
@@ -1413,9 +1420,166 @@ H5::ErrorType WritePipeline(H5::FileWriter& fileWriter, const Pipeline& pipeline
   return pipelineDatasetWriter.writeString(pipelineString);
 }
 
-H5::ErrorType WriteDataStructure(H5::FileWriter& fileWriter, const DataStructure& dataStructure)
+H5::ErrorType WriteDataStructure(H5::FileWriter& fileWriter, const DataStructure& dataStructure, H5::DataStructureWriter& dataStructureWriter)
 {
-  return dataStructure.writeHdf5(fileWriter);
+  return dataStructure.writeHdf5(fileWriter, dataStructureWriter);
+}
+
+struct LoadLazyDataStoreFunctor
+{
+  template <typename T>
+  void operator()(const IDataArray& dataArray, const std::filesystem::path& filePath)
+  {
+    const auto* lazyStore = dynamic_cast<const LazyDataStore<T>*>(dataArray.getIDataStore());
+    if(lazyStore == nullptr || lazyStore->isLoaded())
+    {
+      return;
+    }
+    std::error_code errorCode;
+    if(std::filesystem::equivalent(lazyStore->getFilePath(), filePath, errorCode))
+    {
+      lazyStore->load();
+    }
+  }
+};
+
+struct CropCellArrayFunctor
+{
+  template <typename T>
+  Result<> operator()(IDataArray& iDataArray, const SizeVec3& dims, const DREAM3D::VoxelBounds& bounds, bool preflight)
+  {
+    auto& dataArray = dynamic_cast<DataArray<T>&>(iDataArray);
+    const usize numX = bounds.maxVoxel[0] - bounds.minVoxel[0] + 1;
+    const usize numY = bounds.maxVoxel[1] - bounds.minVoxel[1] + 1;
+    const usize numZ = bounds.maxVoxel[2] - bounds.minVoxel[2] + 1;
+    const std::vector<usize> tupleShape = {numZ, numY, numX};
+    const std::vector<usize> componentShape = dataArray.getComponentShape();
+    if(preflight)
+    {
+      dataArray.setDataStore(std::make_shared<EmptyDataStore<T>>(tupleShape, componentShape));
+      return {};
+    }
+
+    std::shared_ptr<AbstractDataStore<T>> croppedStore = CreateDataStore<T>(tupleShape, componentShape, IDataAction::Mode::Execute);
+    const usize numComponents = dataArray.getNumberOfComponents();
+    const auto* lazyStore = dynamic_cast<const LazyDataStore<T>*>(std::as_const(dataArray).getIDataStore());
+    if(lazyStore != nullptr && !lazyStore->isLoaded())
+    {
+      // Only the cropped block is read from the file, one plane at a time
+      std::lock_guard<std::mutex> readLock(GetLazyDataStoreReadMutex());
+      if(!lazyStore->isSourceFileUnchanged())
+      {
+        return MakeErrorResult(DREAM3D::k_CropReadError, fmt::format("'{}' was modified or replaced after array '{}' was imported from it", lazyStore->getFilePath().string(), dataArray.getName()));
+      }
+      H5::FileReader fileReader(lazyStore->getFilePath());
+      H5::DatasetReader datasetReader(fileReader.getId(), lazyStore->getDatasetPath());
+      if(!fileReader.isValid() || !datasetReader.isValid())
+      {
+        return MakeErrorResult(DREAM3D::k_CropReadError, fmt::format("Unable to open dataset '{}' in '{}' to crop array '{}'", lazyStore->getDatasetPath(), lazyStore->getFilePath().string(), dataArray.getName()));
+      }
+      std::vector<hsize_t> start = {bounds.minVoxel[2], bounds.minVoxel[1], bounds.minVoxel[0]};
+      std::vector<hsize_t> count = {1, numY, numX};
+      for(usize component : componentShape)
+      {
+        start.push_back(0);
+        count.push_back(component);
+      }
+      const usize planeSize = numY * numX * numComponents;
+      auto buffer = std::make_unique<T[]>(planeSize);
+      for(usize z = 0; z < numZ; z++)
+      {
+        start[0] = bounds.minVoxel[2] + z;
+        if(!datasetReader.readIntoSpanHyperslab<T>(nonstd::span<T>(buffer.get(), planeSize), start, count))
+        {
+          return MakeErrorResult(DREAM3D::k_CropReadError, fmt::format("Unable to read plane {} of dataset '{}' in '{}' to crop array '{}'", start[0], lazyStore->getDatasetPath(), lazyStore->getFilePath().string(),
+                                                   dataArray.getName()));
+        }
+        croppedStore->copyFromBuffer(z * planeSize, nonstd::span<const T>(buffer.get(), planeSize));
+      }
+    }
+    else
+    {
+      // Values already in memory are copied one row at a time
+      const auto& sourceStore = std::as_const(dataArray).getDataStoreRef();
+      const usize rowSize = numX * numComponents;
+      auto buffer = std::make_unique<T[]>(rowSize);
+      for(usize z = 0; z < numZ; z++)
+      {
+        for(usize y = 0; y < numY; y++)
+        {
+          const usize sourceTuple = ((bounds.minVoxel[2] + z) * dims[1] + bounds.minVoxel[1] + y) * dims[0] + bounds.minVoxel[0];
+          sourceStore.copyIntoBuffer(sourceTuple * numComponents, nonstd::span<T>(buffer.get(), rowSize));
+          croppedStore->copyFromBuffer((z * numY + y) * rowSize, nonstd::span<const T>(buffer.get(), rowSize));
+        }
+      }
+    }
+    dataArray.setDataStore(std::move(croppedStore));
+    return {};
+  }
+};
+
+Result<> complex::DREAM3D::CropImageGeometries(DataStructure& dataStructure, const VoxelBounds& bounds, bool preflight)
+{
+  for(DataObject::IdType objectId : dataStructure.getAllDataObjectIds())
+  {
+    auto* imageGeom = dynamic_cast<ImageGeom*>(dataStructure.getData(objectId));
+    if(imageGeom == nullptr)
+    {
+      continue;
+    }
+    const SizeVec3 dims = imageGeom->getDimensions();
+    for(usize i = 0; i < 3; i++)
+    {
+      if(bounds.minVoxel[i] > bounds.maxVoxel[i] || bounds.maxVoxel[i] >= dims[i])
+      {
+        return MakeErrorResult(k_InvalidCropBounds, fmt::format("The crop bounds [{}, {}] along axis {} do not fit inside the {} voxels of image geometry '{}'", bounds.minVoxel[i], bounds.maxVoxel[i], i, dims[i],
+                                                 imageGeom->getName()));
+      }
+    }
+
+    if(AttributeMatrix* cellData = imageGeom->getCellData(); cellData != nullptr)
+    {
+      const usize numVoxels = dims[0] * dims[1] * dims[2];
+      for(auto& [childId, child] : *cellData)
+      {
+        auto* dataArray = dynamic_cast<IDataArray*>(child.get());
+        if(dataArray == nullptr || dataArray->getNumberOfTuples() != numVoxels)
+        {
+          return MakeErrorResult(k_UncroppableCellData, fmt::format("Cell data '{}' of image geometry '{}' is not a data array with one tuple per voxel and cannot be cropped", child->getName(), imageGeom->getName()));
+        }
+        Result<> cropResult = ExecuteDataFunction(CropCellArrayFunctor{}, dataArray->getDataType(), *dataArray, dims, bounds, preflight);
+        if(cropResult.invalid())
+        {
+          return cropResult;
+        }
+      }
+      cellData->setShape({bounds.maxVoxel[2] - bounds.minVoxel[2] + 1, bounds.maxVoxel[1] - bounds.minVoxel[1] + 1, bounds.maxVoxel[0] - bounds.minVoxel[0] + 1});
+    }
+
+    const FloatVec3 spacing = imageGeom->getSpacing();
+    const FloatVec3 origin = imageGeom->getOrigin();
+    imageGeom->setOrigin(origin[0] + static_cast<float32>(bounds.minVoxel[0]) * spacing[0], origin[1] + static_cast<float32>(bounds.minVoxel[1]) * spacing[1],
+                         origin[2] + static_cast<float32>(bounds.minVoxel[2]) * spacing[2]);
+    imageGeom->setDimensions(
+        {bounds.maxVoxel[0] - bounds.minVoxel[0] + 1, bounds.maxVoxel[1] - bounds.minVoxel[1] + 1, bounds.maxVoxel[2] - bounds.minVoxel[2] + 1});
+  }
+  return {};
+}
+
+void complex::DREAM3D::LoadLazyDataStores(const DataStructure& dataStructure, const std::filesystem::path& filePath)
+{
+  if(!std::filesystem::exists(filePath))
+  {
+    return;
+  }
+  for(DataObject::IdType objectId : dataStructure.getAllDataObjectIds())
+  {
+    const auto* dataArray = dynamic_cast<const IDataArray*>(dataStructure.getData(objectId));
+    if(dataArray != nullptr && dataArray->getIDataStore() != nullptr)
+    {
+      ExecuteDataFunction(LoadLazyDataStoreFunctor{}, dataArray->getDataType(), *dataArray, filePath);
+    }
+  }
 }
 
 H5::ErrorType WriteFileVersion(H5::FileWriter& fileWriter)
@@ -1431,6 +1595,15 @@ H5::ErrorType complex::DREAM3D::WriteFile(H5::FileWriter& fileWriter, const File
 
 H5::ErrorType complex::DREAM3D::WriteFile(H5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure)
 {
+  return WriteFile(fileWriter, pipeline, dataStructure, H5::DatasetCreationOptions{});
+}
+
+H5::ErrorType complex::DREAM3D::WriteFile(H5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure, const H5::DatasetCreationOptions& options,
+                                          WriteStatistics* statistics)
+{
+  // Writing into the file lazily loaded arrays are read from replaces their datasets, so they must be read first
+  DREAM3D::LoadLazyDataStores(dataStructure, fileWriter.getName());
+
   auto errorCode = WriteFileVersion(fileWriter);
   if(errorCode < 0)
   {
@@ -1442,24 +1615,53 @@ H5::ErrorType complex::DREAM3D::WriteFile(H5::FileWriter& fileWriter, const Pipe
   {
     return errorCode;
   }
-  errorCode = WriteDataStructure(fileWriter, dataStructure);
+
+  H5::DataStructureWriter dataStructureWriter;
+  dataStructureWriter.setDatasetCreationOptions(options);
+  errorCode = WriteDataStructure(fileWriter, dataStructure, dataStructureWriter);
+  if(errorCode < 0)
+  {
+    return errorCode;
+  }
+
+  if(statistics != nullptr)
+  {
+    statistics->dataBytes = dataStructureWriter.getDataBytes();
+    statistics->storedBytes = dataStructureWriter.getStoredBytes();
+    hsize_t fileSize = 0;
+    H5Fflush(fileWriter.getId(), H5F_SCOPE_LOCAL);
+    if(H5Fget_filesize(fileWriter.getId(), &fileSize) >= 0)
+    {
+      statistics->fileBytes = fileSize;
+    }
+  }
   return errorCode;
 }
 
 Result<> complex::DREAM3D::WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline, bool writeXdmf)
 {
+  return ConvertResult(WriteFile(path, dataStructure, pipeline, writeXdmf, H5::DatasetCreationOptions{}));
+}
+
+Result<DREAM3D::WriteStatistics> complex::DREAM3D::WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline, bool writeXdmf,
+                                                             const H5::DatasetCreationOptions& options)
+{
+  // Creating the file truncates it, so arrays still waiting to be read from it must be read first
+  DREAM3D::LoadLazyDataStores(dataStructure, path);
+
   Result<H5::FileWriter> fileWriterResult = H5::FileWriter::CreateFile(path);
   if(fileWriterResult.invalid())
   {
-    return ConvertResult(std::move(fileWriterResult));
+    return {{nonstd::make_unexpected(std::move(fileWriterResult.errors()))}, std::move(fileWriterResult.warnings())};
   }
 
   H5::FileWriter fileWriter = std::move(fileWriterResult.value());
 
-  H5::ErrorType error = WriteFile(fileWriter, Pipeline(), dataStructure);
+  WriteStatistics statistics;
+  H5::ErrorType error = WriteFile(fileWriter, Pipeline(), dataStructure, options, &statistics);
   if(error < 0)
   {
-    return MakeErrorResult(-2, fmt::format("complex::DREAM3D::WriteFile: Unable to write DREAM3D file with HDF5 error {}", error));
+    return MakeErrorResult<WriteStatistics>(-2, fmt::format("complex::DREAM3D::WriteFile: Unable to write DREAM3D file with HDF5 error {}", error));
   }
 
   if(writeXdmf)
@@ -1468,5 +1670,5 @@ Result<> complex::DREAM3D::WriteFile(const std::filesystem::path& path, const Da
     WriteXdmf(xdmfFilePath, dataStructure, path.filename().string());
   }
 
-  return {};
+  return {statistics};
 }
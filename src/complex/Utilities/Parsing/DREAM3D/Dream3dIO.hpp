@@ -5,8 +5,10 @@
 #include <string>
 #include <utility>
 
+#include "complex/Common/Array.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetWriter.hpp"
 #include "complex/complex_export.hpp"
 
 namespace complex
@@ -28,6 +30,43 @@ using PipelineVersionType = int32;
 inline constexpr int32 k_InvalidPipelineVersion = -404;
 inline constexpr int32 k_InvalidDataStructureVersion = -405;
 inline constexpr int32 k_PipelineGroupUnavailable = -406;
+inline constexpr int32 k_InvalidCropBounds = -407;
+inline constexpr int32 k_UncroppableCellData = -408;
+inline constexpr int32 k_CropReadError = -409;
+
+/**
+ * @brief Size information gathered while writing a .dream3d file.
+ */
+struct COMPLEX_EXPORT WriteStatistics
+{
+  uint64 dataBytes = 0;   // Array values before compression
+  uint64 storedBytes = 0; // Array values as stored in the file
+  uint64 fileBytes = 0;   // Size of the entire file
+
+  /**
+   * @brief Returns how many times smaller the stored array values are than the
+   * uncompressed values. Returns 1.0 if no array values were written.
+   * @return float64
+   */
+  float64 compressionRatio() const
+  {
+    if(storedBytes == 0)
+    {
+      return 1.0;
+    }
+    return static_cast<float64>(dataBytes) / static_cast<float64>(storedBytes);
+  }
+};
+
+/**
+ * @brief Inclusive voxel bounds of the sub-volume kept when image geometries
+ * are cropped during an import. Indices are in X, Y, Z order.
+ */
+struct COMPLEX_EXPORT VoxelBounds
+{
+  SizeVec3 minVoxel;
+  SizeVec3 maxVoxel;
+};
 
 /**
  * @brief Returns the DREAM3D file version.
@@ -82,6 +121,20 @@ COMPLEX_EXPORT H5::ErrorType WriteFile(H5::FileWriter& fileWriter, const FileDat
  */
 COMPLEX_EXPORT H5::ErrorType WriteFile(H5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure);
 
+/**
+ * @brief Writes a .dream3d file with the specified data. Array datasets are
+ * created using the given creation options so they can be chunked and
+ * compressed. If statistics is not null, it receives the number of bytes written.
+ * @param fileWriter
+ * @param pipeline
+ * @param dataStructure
+ * @param options
+ * @param statistics
+ * @return H5::ErrorType
+ */
+COMPLEX_EXPORT H5::ErrorType WriteFile(H5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure, const H5::DatasetCreationOptions& options,
+                                       WriteStatistics* statistics = nullptr);
+
 /**
  * @brief Writes a .dream3d file with the specified data.
  * @param path
@@ -91,15 +144,52 @@ COMPLEX_EXPORT H5::ErrorType WriteFile(H5::FileWriter& fileWriter, const Pipelin
  */
 COMPLEX_EXPORT Result<> WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline = {}, bool writeXdmf = false);
 
+/**
+ * @brief Writes a .dream3d file with the specified data using the given
+ * dataset creation options and returns the number of bytes written.
+ * @param path
+ * @param dataStructure
+ * @param pipeline
+ * @param writeXdmf
+ * @param options
+ * @return Result<WriteStatistics>
+ */
+COMPLEX_EXPORT Result<WriteStatistics> WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline, bool writeXdmf,
+                                                 const H5::DatasetCreationOptions& options);
+
 /**
  * @brief Imports and returns the DataStructure from the target .dream3d file.
  *
- * This method imports both current and legacy DataStructures.
+ * This method imports both current and legacy DataStructures. When lazyLoad
+ * is true, the data arrays of current files read their values from the file
+ * the first time they are accessed instead of during the import.
  * @param fileReader
  * @param preflight = false
+ * @param lazyLoad = false
  * @return complex::DataStructure
  */
-COMPLEX_EXPORT Result<complex::DataStructure> ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight = false);
+COMPLEX_EXPORT Result<complex::DataStructure> ImportDataStructureFromFile(const H5::FileReader& fileReader, bool preflight = false, bool lazyLoad = false);
+
+/**
+ * @brief Crops every image geometry of an imported DataStructure to the given
+ * bounds. The geometry dimensions and origin, the shape of its cell
+ * AttributeMatrix and every cell array are updated. Cell arrays that have not
+ * been read from their file yet read only the cropped block. When
+ * preflighting, only the shapes are changed.
+ * @param dataStructure
+ * @param bounds
+ * @param preflight
+ * @return Result<>
+ */
+COMPLEX_EXPORT Result<> CropImageGeometries(DataStructure& dataStructure, const VoxelBounds& bounds, bool preflight);
+
+/**
+ * @brief Reads the values of every lazily loaded array backed by the given
+ * file.
+ * @param dataStructure
+ * @param filePath
+ */
+COMPLEX_EXPORT void LoadLazyDataStores(const DataStructure& dataStructure, const std::filesystem::path& filePath);
 
 /**
  * @brief Imports and returns the DataStructure from the target .dream3d file.
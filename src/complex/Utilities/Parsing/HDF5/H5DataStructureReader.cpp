@@ -133,3 +133,13 @@ H5::IDataFactory* H5::DataStructureReader::getDataFactory(const std::string& typ
 {
   return getDataReader()->getFactory(typeName);
 }
+
+bool H5::DataStructureReader::isLazyLoading() const
+{
+  return m_LazyLoading;
+}
+
+void H5::DataStructureReader::setLazyLoading(bool lazyLoading)
+{
+  m_LazyLoading = lazyLoading;
+}
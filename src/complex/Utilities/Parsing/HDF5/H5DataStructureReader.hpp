@@ -71,6 +71,21 @@ public:
    */
   void clearDataStructure();
 
+  /**
+   * @brief Returns true if imported data arrays read their values from the
+   * file when first accessed instead of during the import.
+   * @return bool
+   */
+  bool isLazyLoading() const;
+
+  /**
+   * @brief Sets whether imported data arrays read their values from the file
+   * when first accessed instead of during the import. Has no effect when
+   * preflighting.
+   * @param lazyLoading
+   */
+  void setLazyLoading(bool lazyLoading);
+
 protected:
   /**
    * @brief Returns a pointer to the H5::DataFactoryManager used for finding the
@@ -90,6 +105,7 @@ protected:
 private:
   H5::DataFactoryManager* m_FactoryManager = nullptr;
   DataStructure m_CurrentStructure;
+  bool m_LazyLoading = false;
 };
 } // namespace H5
 } // namespace complex
@@ -47,6 +47,32 @@ H5::ErrorType H5::DataStructureWriter::writeDataObjectLink(const DataObject* dat
   return err;
 }
 
+const H5::DatasetCreationOptions& H5::DataStructureWriter::getDatasetCreationOptions() const
+{
+  return m_DatasetCreationOptions;
+}
+
+void H5::DataStructureWriter::setDatasetCreationOptions(const DatasetCreationOptions& options)
+{
+  m_DatasetCreationOptions = options;
+}
+
+void H5::DataStructureWriter::recordDatasetSize(const DatasetWriter& datasetWriter)
+{
+  m_DataBytes += datasetWriter.getDataSize();
+  m_StoredBytes += datasetWriter.getStorageSize();
+}
+
+uint64 H5::DataStructureWriter::getDataBytes() const
+{
+  return m_DataBytes;
+}
+
+uint64 H5::DataStructureWriter::getStoredBytes() const
+{
+  return m_StoredBytes;
+}
+
 bool H5::DataStructureWriter::hasDataBeenWritten(const DataObject* targetObject) const
 {
   if(targetObject == nullptr)
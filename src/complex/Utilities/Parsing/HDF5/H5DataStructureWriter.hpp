@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/Parsing/HDF5/H5DatasetWriter.hpp"
 
 namespace complex
 {
@@ -41,6 +42,41 @@ public:
    */
   H5::ErrorType writeDataObject(const DataObject* dataObject, GroupWriter& parentGroup);
 
+  /**
+   * @brief Returns the creation options applied to the datasets of written
+   * data arrays.
+   * @return const DatasetCreationOptions&
+   */
+  const DatasetCreationOptions& getDatasetCreationOptions() const;
+
+  /**
+   * @brief Sets the creation options applied to the datasets of data arrays
+   * written afterwards. Use these to request chunked or compressed output.
+   * @param options
+   */
+  void setDatasetCreationOptions(const DatasetCreationOptions& options);
+
+  /**
+   * @brief Adds the size of the given written dataset to the running totals
+   * reported by getDataBytes() and getStoredBytes().
+   * @param datasetWriter
+   */
+  void recordDatasetSize(const DatasetWriter& datasetWriter);
+
+  /**
+   * @brief Returns the total number of bytes of array values written so far
+   * before any compression.
+   * @return uint64
+   */
+  uint64 getDataBytes() const;
+
+  /**
+   * @brief Returns the total number of bytes allocated in the file for the
+   * array values written so far.
+   * @return uint64
+   */
+  uint64 getStoredBytes() const;
+
 protected:
   /**
    * @brief Writes a DataObject link under the given GroupWriter.
@@ -113,6 +149,9 @@ private:
   H5::IdType m_ParentId = 0;
   DataStructure m_DataStructure;
   DataMapType m_IdMap;
+  DatasetCreationOptions m_DatasetCreationOptions;
+  uint64 m_DataBytes = 0;
+  uint64 m_StoredBytes = 0;
 };
 } // namespace H5
 } // namespace complex
@@ -281,6 +281,70 @@ bool H5::DatasetReader::readIntoSpan(nonstd::span<T> data) const
   return true;
 }
 
+template <class T>
+bool H5::DatasetReader::readIntoSpanHyperslab(nonstd::span<T> data, const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const std::vector<hsize_t>& stride) const
+{
+  if(!isValid())
+  {
+    return false;
+  }
+
+  hid_t dataType = H5::Support::HdfTypeForPrimitive<T>();
+  if(dataType == -1)
+  {
+    return false;
+  }
+
+  hsize_t numElements = std::accumulate(count.cbegin(), count.cend(), static_cast<hsize_t>(1), std::multiplies<>());
+  if(numElements != data.size())
+  {
+    return false;
+  }
+
+  auto fileSpaceId = getDataspaceId();
+  if(fileSpaceId < 0)
+  {
+    std::cout << "Error Opening SpaceID" << std::endl;
+    return false;
+  }
+
+  int32_t rank = H5Sget_simple_extent_ndims(fileSpaceId);
+  if(rank != static_cast<int32_t>(start.size()) || rank != static_cast<int32_t>(count.size()) || (!stride.empty() && rank != static_cast<int32_t>(stride.size())))
+  {
+    std::cout << "Hyperslab rank does not match the rank of dataset '" << getName() << "'" << std::endl;
+    H5Sclose(fileSpaceId);
+    return false;
+  }
+
+  std::vector<hsize_t> dims(rank, 0);
+  H5Sget_simple_extent_dims(fileSpaceId, dims.data(), nullptr);
+  for(int32_t i = 0; i < rank; i++)
+  {
+    hsize_t step = stride.empty() ? 1 : stride[i];
+    if(step == 0 || (count[i] > 0 && start[i] + (count[i] - 1) * step >= dims[i]))
+    {
+      std::cout << "Hyperslab extends outside of dataset '" << getName() << "'" << std::endl;
+      H5Sclose(fileSpaceId);
+      return false;
+    }
+  }
+
+  herr_t error = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, start.data(), stride.empty() ? nullptr : stride.data(), count.data(), nullptr);
+  if(error >= 0)
+  {
+    hid_t memorySpaceId = H5Screate_simple(rank, count.data(), nullptr);
+    error = H5Dread(getId(), dataType, memorySpaceId, fileSpaceId, H5P_DEFAULT, data.data());
+    if(error < 0)
+    {
+      std::cout << "Error Reading Hyperslab.'" << getName() << "'" << std::endl;
+    }
+    H5Sclose(memorySpaceId);
+  }
+  H5Sclose(fileSpaceId);
+
+  return error >= 0;
+}
+
 std::vector<hsize_t> H5::DatasetReader::getDimensions() const
 {
   std::vector<hsize_t> dims;
@@ -342,3 +406,18 @@ template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<usize>(nonstd::span
 #endif
 template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<float32>(nonstd::span<float32>) const;
 template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpan<float64>(nonstd::span<float64>) const;
+
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<int8>(nonstd::span<int8>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<int16>(nonstd::span<int16>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<int32>(nonstd::span<int32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<int64>(nonstd::span<int64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<uint8>(nonstd::span<uint8>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<uint16>(nonstd::span<uint16>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<uint32>(nonstd::span<uint32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<uint64>(nonstd::span<uint64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<bool>(nonstd::span<bool>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+#ifdef __APPLE__
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<usize>(nonstd::span<usize>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+#endif
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<float32>(nonstd::span<float32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+template COMPLEX_EXPORT bool H5::DatasetReader::readIntoSpanHyperslab<float64>(nonstd::span<float64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
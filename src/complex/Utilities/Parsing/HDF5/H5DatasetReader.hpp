@@ -112,6 +112,20 @@ public:
   template <class T>
   bool readIntoSpan(nonstd::span<T> data) const;
 
+  /**
+   * @brief Reads the block of the dataset described by start, count and stride
+   * into the given span without reading the rest of the dataset. Requires the
+   * span to hold exactly the number of values in the block and the block to lie
+   * inside the dataset. Returns false if unable to read.
+   * @tparam T
+   * @param data
+   * @param start Offset of the block in each dimension
+   * @param count Number of values to read in each dimension
+   * @param stride Step between values in each dimension. Empty reads contiguous values.
+   */
+  template <class T>
+  bool readIntoSpanHyperslab(nonstd::span<T> data, const std::vector<hsize_t>& start, const std::vector<hsize_t>& count, const std::vector<hsize_t>& stride = {}) const;
+
   /**
    * @brief Returns a vector of the sizes of the dimensions for the dataset
    * Returns empty vector if unable to read.
@@ -135,5 +149,16 @@ extern template bool DatasetReader::readIntoSpan<uint32>(nonstd::span<uint32>) c
 extern template bool DatasetReader::readIntoSpan<uint64>(nonstd::span<uint64>) const;
 extern template bool DatasetReader::readIntoSpan<float32>(nonstd::span<float32>) const;
 extern template bool DatasetReader::readIntoSpan<float64>(nonstd::span<float64>) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<bool>(nonstd::span<bool>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<int8>(nonstd::span<int8>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<int16>(nonstd::span<int16>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<int32>(nonstd::span<int32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<int64>(nonstd::span<int64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<uint8>(nonstd::span<uint8>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<uint16>(nonstd::span<uint16>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<uint32>(nonstd::span<uint32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<uint64>(nonstd::span<uint64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<float32>(nonstd::span<float32>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
+extern template bool DatasetReader::readIntoSpanHyperslab<float64>(nonstd::span<float64>, const std::vector<hsize_t>&, const std::vector<hsize_t>&, const std::vector<hsize_t>&) const;
 } // namespace H5
 } // namespace complex
@@ -1,13 +1,85 @@
 #include "H5DatasetWriter.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 
 #include <H5Apublic.h>
+#include <H5Ppublic.h>
+#include <H5Zpublic.h>
 
+#include <zlib.h>
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+#include <tbb/parallel_pipeline.h>
+#endif
+
+#include "complex/Utilities/ParallelScheduler.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
 
 using namespace complex;
 
+namespace
+{
+/**
+ * @brief A chunk that has been run through the dataset's filters and is ready
+ * to be written with H5Dwrite_chunk.
+ */
+struct PreparedChunk
+{
+  usize index = 0;
+  std::vector<uint8> buffer;
+  bool valid = true;
+};
+
+/**
+ * @brief Byte shuffle matching the HDF5 shuffle filter. The first bytes of all
+ * elements are stored together, followed by the second bytes and so on.
+ * @param input
+ * @param elementSize
+ * @return std::vector<uint8>
+ */
+std::vector<uint8> ShuffleBytes(const std::vector<uint8>& input, usize elementSize)
+{
+  if(elementSize <= 1)
+  {
+    return input;
+  }
+  const usize numElements = input.size() / elementSize;
+  std::vector<uint8> output(input.size());
+  for(usize byte = 0; byte < elementSize; byte++)
+  {
+    uint8* dest = output.data() + byte * numElements;
+    for(usize i = 0; i < numElements; i++)
+    {
+      dest[i] = input[i * elementSize + byte];
+    }
+  }
+  // Trailing bytes that do not make up a whole element are not shuffled
+  std::copy(input.begin() + numElements * elementSize, input.end(), output.begin() + numElements * elementSize);
+  return output;
+}
+
+/**
+ * @brief Compresses the bytes into a zlib stream identical in format to the
+ * output of the HDF5 deflate filter. Returns an empty vector on failure.
+ * @param input
+ * @param level
+ * @return std::vector<uint8>
+ */
+std::vector<uint8> DeflateBytes(const std::vector<uint8>& input, uint32 level)
+{
+  uLongf compressedSize = compressBound(static_cast<uLong>(input.size()));
+  std::vector<uint8> output(compressedSize);
+  if(compress2(output.data(), &compressedSize, input.data(), static_cast<uLong>(input.size()), static_cast<int>(level)) != Z_OK)
+  {
+    return {};
+  }
+  output.resize(compressedSize);
+  return output;
+}
+} // namespace
+
 H5::DatasetWriter::DatasetWriter()
 : ObjectWriter()
 {
@@ -119,10 +191,203 @@ void H5::DatasetWriter::createOrOpenDataset(H5::IdType typeId, H5::IdType datasp
   HDF_ERROR_HANDLER_OFF
   setId(H5Dopen(getParentId(), getName().c_str(), H5P_DEFAULT));
   HDF_ERROR_HANDLER_ON
-  if(getId() < 0) // dataset does not exist so create it
+  if(getId() >= 0)
+  {
+    return;
+  }
+
+  // dataset does not exist so create it
+  hid_t propertyListId = H5P_DEFAULT;
+  DimsType createdChunkDims;
+  bool shuffleApplied = false;
+  uint32 deflateLevel = 0;
+  if(m_CreationOptions.usesChunking() && H5Sget_simple_extent_type(dataspaceId) == H5S_SIMPLE)
+  {
+    const int32_t rank = H5Sget_simple_extent_ndims(dataspaceId);
+    DimsType dims(static_cast<usize>(std::max(rank, 0)), 0);
+    H5Sget_simple_extent_dims(dataspaceId, dims.data(), nullptr);
+    // HDF5 cannot chunk zero sized dimensions
+    const bool hasValues = rank > 0 && std::find(dims.cbegin(), dims.cend(), 0) == dims.cend();
+    if(hasValues)
+    {
+      DimsType chunkDims = m_CreationOptions.computeChunkDims(dims, H5Tget_size(typeId));
+      propertyListId = H5Pcreate(H5P_DATASET_CREATE);
+      H5Pset_chunk(propertyListId, rank, chunkDims.data());
+      // Filters run in the order they are added. writeChunksDirectly relies on shuffle before deflate.
+      if(m_CreationOptions.shuffle)
+      {
+        H5Pset_shuffle(propertyListId);
+        shuffleApplied = true;
+      }
+      if(m_CreationOptions.compressionLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+      {
+        deflateLevel = std::min(m_CreationOptions.compressionLevel, 9u);
+        H5Pset_deflate(propertyListId, deflateLevel);
+      }
+      createdChunkDims = std::move(chunkDims);
+    }
+  }
+
+  setId(H5Dcreate(getParentId(), getName().c_str(), typeId, dataspaceId, H5P_DEFAULT, propertyListId, H5P_DEFAULT));
+  if(propertyListId != H5P_DEFAULT)
+  {
+    H5Pclose(propertyListId);
+  }
+  if(getId() >= 0)
+  {
+    m_ChunkDims = std::move(createdChunkDims);
+    m_ShuffleApplied = shuffleApplied;
+    m_DeflateLevel = deflateLevel;
+  }
+}
+
+bool H5::DatasetWriter::canWriteChunksDirectly(const DimsType& dims) const
+{
+  if(!m_CreationOptions.parallelCompression || getId() <= 0 || (!m_ShuffleApplied && m_DeflateLevel == 0))
+  {
+    return false;
+  }
+  if(m_ChunkDims.empty() || m_ChunkDims.size() != dims.size())
+  {
+    return false;
+  }
+  // Chunks may only split the slowest dimension to be contiguous in memory
+  for(usize i = 1; i < dims.size(); i++)
+  {
+    if(m_ChunkDims[i] != dims[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+H5::ErrorType H5::DatasetWriter::writeChunksDirectly(const DimsType& dims, const void* data, usize elementSize)
+{
+  const usize rowBytes = std::accumulate(dims.cbegin() + 1, dims.cend(), elementSize, std::multiplies<>());
+  const usize chunkRows = m_ChunkDims[0];
+  const usize numChunks = (dims[0] + chunkRows - 1) / chunkRows;
+  const usize chunkBytes = chunkRows * rowBytes;
+  const auto* bytes = static_cast<const uint8*>(data);
+
+  auto prepareChunk = [&](usize chunkIndex) -> PreparedChunk {
+    PreparedChunk chunk;
+    chunk.index = chunkIndex;
+    // Edge chunks are padded to the full chunk size like the HDF5 filter pipeline does
+    std::vector<uint8> rawChunk(chunkBytes, 0);
+    const usize firstRow = chunkIndex * chunkRows;
+    const usize numRows = std::min<usize>(chunkRows, dims[0] - firstRow);
+    std::copy_n(bytes + firstRow * rowBytes, numRows * rowBytes, rawChunk.data());
+    if(m_ShuffleApplied)
+    {
+      rawChunk = ShuffleBytes(rawChunk, elementSize);
+    }
+    if(m_DeflateLevel > 0)
+    {
+      chunk.buffer = DeflateBytes(rawChunk, m_DeflateLevel);
+      chunk.valid = !chunk.buffer.empty();
+    }
+    else
+    {
+      chunk.buffer = std::move(rawChunk);
+    }
+    return chunk;
+  };
+
+  // Checked by the input stage while the output stage runs on another thread
+  std::atomic<herr_t> returnError = 0;
+  auto writeChunk = [&](const PreparedChunk& chunk) {
+    if(returnError < 0)
+    {
+      return;
+    }
+    if(!chunk.valid)
+    {
+      std::cout << "Error Compressing Chunk" << std::endl;
+      returnError = -1;
+      return;
+    }
+    DimsType offset(dims.size(), 0);
+    offset[0] = chunk.index * chunkRows;
+    herr_t error = H5Dwrite_chunk(getId(), H5P_DEFAULT, 0, offset.data(), chunk.buffer.size(), chunk.buffer.data());
+    if(error < 0)
+    {
+      std::cout << "Error Writing Chunk" << std::endl;
+      returnError = error;
+    }
+  };
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+  // Bounding the number of chunks in flight bounds the memory held by prepared chunks
+  const usize maxChunksInFlight = std::max(2u, ParallelScheduler::GetCoreBudget()) * 2;
+  usize nextChunk = 0;
+  ParallelScheduler::Execute([&]() {
+    tbb::parallel_pipeline(maxChunksInFlight,
+                           tbb::make_filter<void, usize>(tbb::filter_mode::serial_in_order,
+                                                         [&](tbb::flow_control& control) -> usize {
+                                                           if(nextChunk >= numChunks || returnError < 0)
+                                                           {
+                                                             control.stop();
+                                                             return 0;
+                                                           }
+                                                           return nextChunk++;
+                                                         }) &
+                               tbb::make_filter<usize, PreparedChunk>(tbb::filter_mode::parallel, prepareChunk) &
+                               tbb::make_filter<PreparedChunk, void>(tbb::filter_mode::serial_in_order, writeChunk));
+  });
+#else
+  for(usize chunkIndex = 0; chunkIndex < numChunks && returnError >= 0; chunkIndex++)
+  {
+    writeChunk(prepareChunk(chunkIndex));
+  }
+#endif
+  return returnError.load();
+}
+
+const H5::DatasetCreationOptions& H5::DatasetWriter::getCreationOptions() const
+{
+  return m_CreationOptions;
+}
+
+void H5::DatasetWriter::setCreationOptions(const DatasetCreationOptions& options)
+{
+  m_CreationOptions = options;
+}
+
+H5::SizeType H5::DatasetWriter::getDataSize() const
+{
+  if(getId() <= 0)
+  {
+    return 0;
+  }
+  hid_t dataspaceId = H5Dget_space(getId());
+  hid_t typeId = H5Dget_type(getId());
+  H5::SizeType dataSize = 0;
+  if(dataspaceId >= 0 && typeId >= 0)
+  {
+    hssize_t numPoints = H5Sget_simple_extent_npoints(dataspaceId);
+    dataSize = static_cast<H5::SizeType>(std::max<hssize_t>(numPoints, 0)) * H5Tget_size(typeId);
+  }
+  if(typeId >= 0)
+  {
+    H5Tclose(typeId);
+  }
+  if(dataspaceId >= 0)
+  {
+    H5Sclose(dataspaceId);
+  }
+  return dataSize;
+}
+
+H5::SizeType H5::DatasetWriter::getStorageSize() const
+{
+  if(getId() <= 0)
   {
-    setId(H5Dcreate(getParentId(), getName().c_str(), typeId, dataspaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+    return 0;
   }
+  // Filtered chunks are only compressed once they leave the chunk cache
+  H5Dflush(getId());
+  return H5Dget_storage_size(getId());
 }
 
 bool H5::DatasetWriter::isValid() const
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "complex/Utilities/Parsing/HDF5/H5ObjectWriter.hpp"
@@ -11,6 +13,92 @@ namespace complex
 {
 namespace H5
 {
+/**
+ * @brief Dataset creation properties used when a DatasetWriter creates a new
+ * dataset. The default values create a contiguous, uncompressed dataset.
+ *
+ * HDF5 filters can only be applied to chunked datasets, so requesting deflate
+ * compression or the shuffle filter always produces a chunked layout.
+ */
+struct DatasetCreationOptions
+{
+  /**
+   * @brief Preferred number of bytes in a chunk when no chunk shape is given.
+   */
+  static inline constexpr usize k_DefaultChunkBytes = 1024 * 1024;
+
+  /**
+   * @brief Stores the dataset in chunks instead of a single contiguous block.
+   */
+  bool chunked = false;
+
+  /**
+   * @brief Chunk extent starting from the slowest changing dimension. Missing
+   * trailing entries and entries of 0 span the full extent of that dimension,
+   * so {1} stores one slice (e.g. one Z slice of an image geometry) per chunk.
+   * An empty shape stacks slowest dimension slices up to k_DefaultChunkBytes.
+   */
+  std::vector<H5::SizeType> chunkShape;
+
+  /**
+   * @brief Deflate (gzip) level from 0 (off) to 9 (smallest output).
+   */
+  uint32 compressionLevel = 0;
+
+  /**
+   * @brief Applies the byte shuffle filter ahead of compression.
+   */
+  bool shuffle = false;
+
+  /**
+   * @brief Shuffles and compresses chunks on worker threads and writes them with
+   * HDF5 direct chunk writes while a single stage writes to the file. Only
+   * applies when filters are enabled and each chunk is contiguous in memory.
+   */
+  bool parallelCompression = false;
+
+  /**
+   * @brief Returns true if datasets created with these options are chunked.
+   * @return bool
+   */
+  bool usesChunking() const
+  {
+    return chunked || compressionLevel > 0 || shuffle;
+  }
+
+  /**
+   * @brief Returns the chunk dimensions for a dataset with the given
+   * dimensions and element size. Every returned extent is at least 1 and no
+   * larger than the dataset extent.
+   * @param dims
+   * @param elementSize
+   * @return std::vector<H5::SizeType>
+   */
+  std::vector<H5::SizeType> computeChunkDims(const std::vector<H5::SizeType>& dims, usize elementSize) const
+  {
+    std::vector<H5::SizeType> chunkDims(dims.size(), 1);
+    if(dims.empty())
+    {
+      return chunkDims;
+    }
+    for(usize i = 0; i < dims.size(); i++)
+    {
+      H5::SizeType extent = (i < chunkShape.size() && chunkShape[i] > 0) ? chunkShape[i] : dims[i];
+      chunkDims[i] = std::max<H5::SizeType>(1, std::min(extent, dims[i]));
+    }
+    if(chunkShape.empty())
+    {
+      H5::SizeType sliceBytes = std::max<H5::SizeType>(1, elementSize);
+      for(usize i = 1; i < dims.size(); i++)
+      {
+        sliceBytes *= chunkDims[i];
+      }
+      chunkDims[0] = std::max<H5::SizeType>(1, std::min<H5::SizeType>(dims[0], k_DefaultChunkBytes / sliceBytes));
+    }
+    return chunkDims;
+  }
+};
+
 class COMPLEX_EXPORT DatasetWriter : public ObjectWriter
 {
 public:
@@ -49,6 +137,34 @@ public:
    */
   std::string getName() const override;
 
+  /**
+   * @brief Returns the creation options used for datasets this writer creates.
+   * @return const DatasetCreationOptions&
+   */
+  const DatasetCreationOptions& getCreationOptions() const;
+
+  /**
+   * @brief Sets the creation options used when this writer creates a dataset.
+   * Existing datasets that are reopened keep their original layout.
+   * @param options
+   */
+  void setCreationOptions(const DatasetCreationOptions& options);
+
+  /**
+   * @brief Returns the number of bytes the dataset's values require in memory.
+   * Returns 0 if the dataset has not been written.
+   * @return H5::SizeType
+   */
+  H5::SizeType getDataSize() const;
+
+  /**
+   * @brief Returns the number of bytes allocated in the file for the dataset's
+   * values after any filters were applied. Pending chunks are flushed first.
+   * Returns 0 if the dataset has not been written.
+   * @return H5::SizeType
+   */
+  H5::SizeType getStorageSize() const;
+
   /**
    * @brief Writes a given string to the dataset. Returns the HDF5 error,
    * should one occur.
@@ -127,7 +243,14 @@ public:
         {
           /* Write the attribute data. */
           const void* data = static_cast<const void*>(values.data());
-          error = H5Dwrite(getId(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+          if(canWriteChunksDirectly(dims))
+          {
+            error = writeChunksDirectly(dims, data, sizeof(T));
+          }
+          else
+          {
+            error = H5Dwrite(getId(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+          }
           if(error < 0)
           {
             std::cout << "Error Writing Attribute" << std::endl;
@@ -162,6 +285,123 @@ public:
     return returnError;
   }
 
+  /**
+   * @brief Creates the dataset with the given dimensions without writing any
+   * values to it. Values can then be written in pieces using writeSpanHyperslab.
+   * Returns the HDF5 error, should one occur.
+   * @tparam T
+   * @param dims
+   * @return H5::ErrorType
+   */
+  template <typename T>
+  H5::ErrorType createEmptyDataset(const DimsType& dims)
+  {
+    hid_t dataType = H5::Support::HdfTypeForPrimitive<T>();
+    if(dataType == -1)
+    {
+      std::cout << "dataType was unknown" << std::endl;
+      return -1;
+    }
+
+    hid_t dataspaceId = H5Screate_simple(static_cast<int32_t>(dims.size()), dims.data(), nullptr);
+    if(dataspaceId < 0)
+    {
+      return static_cast<herr_t>(dataspaceId);
+    }
+
+    herr_t returnError = findAndDeleteAttribute();
+    if(returnError >= 0)
+    {
+      createOrOpenDataset(dataType, dataspaceId);
+      if(getId() < 0)
+      {
+        std::cout << "Error Creating Dataset" << std::endl;
+        returnError = static_cast<herr_t>(getId());
+      }
+    }
+
+    herr_t error = H5Sclose(dataspaceId);
+    if(error < 0)
+    {
+      std::cout << "Error Closing Dataspace" << std::endl;
+      returnError = error;
+    }
+    return returnError;
+  }
+
+  /**
+   * @brief Writes a span of values into the block of an existing dataset
+   * described by start, count and stride. The dataset must have been created by
+   * createEmptyDataset or one of the other write* methods. The span must hold
+   * exactly the number of values described by count and the block must lie
+   * inside the dataset. Returns the HDF5 error, should one occur.
+   * @tparam T
+   * @param start Offset of the block in each dimension
+   * @param count Number of values to write in each dimension
+   * @param values
+   * @param stride Step between values in each dimension. Empty writes contiguous values.
+   * @return H5::ErrorType
+   */
+  template <typename T>
+  H5::ErrorType writeSpanHyperslab(const DimsType& start, const DimsType& count, nonstd::span<const T> values, const DimsType& stride = {})
+  {
+    if(getId() <= 0)
+    {
+      std::cout << "Dataset must be created before writing a hyperslab" << std::endl;
+      return -1;
+    }
+    hid_t dataType = H5::Support::HdfTypeForPrimitive<T>();
+    if(dataType == -1)
+    {
+      std::cout << "dataType was unknown" << std::endl;
+      return -1;
+    }
+
+    hsize_t numValues = std::accumulate(count.cbegin(), count.cend(), static_cast<hsize_t>(1), std::multiplies<>());
+    if(start.size() != count.size() || (!stride.empty() && stride.size() != count.size()) || numValues != values.size())
+    {
+      std::cout << "Hyperslab selection does not match the number of values" << std::endl;
+      return -1;
+    }
+
+    hid_t fileSpaceId = H5Dget_space(getId());
+    if(fileSpaceId < 0)
+    {
+      return static_cast<herr_t>(fileSpaceId);
+    }
+    const int32_t rank = H5Sget_simple_extent_ndims(fileSpaceId);
+    DimsType dims(count.size(), 0);
+    if(rank != static_cast<int32_t>(count.size()) || H5Sget_simple_extent_dims(fileSpaceId, dims.data(), nullptr) < 0)
+    {
+      std::cout << "Hyperslab rank does not match the rank of the dataset" << std::endl;
+      H5Sclose(fileSpaceId);
+      return -1;
+    }
+    for(usize i = 0; i < dims.size(); i++)
+    {
+      hsize_t step = stride.empty() ? 1 : stride[i];
+      if(step == 0 || (count[i] > 0 && start[i] + (count[i] - 1) * step >= dims[i]))
+      {
+        std::cout << "Hyperslab extends outside of the dataset" << std::endl;
+        H5Sclose(fileSpaceId);
+        return -1;
+      }
+    }
+    herr_t returnError = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, start.data(), stride.empty() ? nullptr : stride.data(), count.data(), nullptr);
+    if(returnError >= 0)
+    {
+      hid_t memorySpaceId = H5Screate_simple(static_cast<int32_t>(count.size()), count.data(), nullptr);
+      returnError = H5Dwrite(getId(), dataType, memorySpaceId, fileSpaceId, H5P_DEFAULT, static_cast<const void*>(values.data()));
+      if(returnError < 0)
+      {
+        std::cout << "Error Writing Hyperslab" << std::endl;
+      }
+      H5Sclose(memorySpaceId);
+    }
+    H5Sclose(fileSpaceId);
+    return returnError;
+  }
+
 protected:
   /**
    * @brief Finds and deletes any existing attribute with the current name.
@@ -172,7 +412,7 @@ protected:
 
   /**
    * @brief Opens the target HDF5 dataset or creates a new one using the given
-   * datatype and dataspace IDs.
+   * datatype and dataspace IDs. New datasets use the current creation options.
    * @param typeId
    * @param dataspaceId
    */
@@ -183,6 +423,27 @@ protected:
    */
   void closeHdf5() override;
 
+  /**
+   * @brief Returns true if the dataset was created by this writer with filters
+   * and parallel compression enabled and every chunk of a dataset with the
+   * given dimensions is a contiguous block of values in memory.
+   * @param dims
+   * @return bool
+   */
+  bool canWriteChunksDirectly(const DimsType& dims) const;
+
+  /**
+   * @brief Writes the values chunk by chunk, bypassing the HDF5 filter
+   * pipeline. Worker threads copy, shuffle and deflate the chunks in parallel
+   * while a serial stage writes the finished chunks to the file in order.
+   * Returns the HDF5 error, should one occur.
+   * @param dims
+   * @param data
+   * @param elementSize
+   * @return H5::ErrorType
+   */
+  H5::ErrorType writeChunksDirectly(const DimsType& dims, const void* data, usize elementSize);
+
 private:
 #if 0
   bool tryOpeningDataset(const std::string& datasetName, H5::Type dataType);
@@ -190,6 +451,10 @@ private:
 #endif
 
   const std::string m_DatasetName;
+  DatasetCreationOptions m_CreationOptions;
+  DimsType m_ChunkDims;
+  bool m_ShuffleApplied = false;
+  uint32 m_DeflateLevel = 0;
 };
 } // namespace H5
 } // namespace complex
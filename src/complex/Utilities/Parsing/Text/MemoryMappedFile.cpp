@@ -0,0 +1,181 @@
+#include "MemoryMappedFile.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace complex
+{
+// -----------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path)
+{
+  open(path);
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+: m_Data(std::exchange(other.m_Data, nullptr))
+, m_Size(std::exchange(other.m_Size, 0))
+, m_IsOpen(std::exchange(other.m_IsOpen, false))
+#ifdef _WIN32
+, m_FileHandle(std::exchange(other.m_FileHandle, nullptr))
+, m_MappingHandle(std::exchange(other.m_MappingHandle, nullptr))
+#endif
+{
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+{
+  if(this != &other)
+  {
+    close();
+    m_Data = std::exchange(other.m_Data, nullptr);
+    m_Size = std::exchange(other.m_Size, 0);
+    m_IsOpen = std::exchange(other.m_IsOpen, false);
+#ifdef _WIN32
+    m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+    m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+#endif
+  }
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile() noexcept
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::open(const std::filesystem::path& path)
+{
+  close();
+
+#ifdef _WIN32
+  HANDLE fileHandle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if(GetFileSizeEx(fileHandle, &fileSize) == 0)
+  {
+    CloseHandle(fileHandle);
+    return false;
+  }
+  m_FileHandle = fileHandle;
+  m_Size = static_cast<usize>(fileSize.QuadPart);
+  m_IsOpen = true;
+  if(m_Size == 0)
+  {
+    return true;
+  }
+
+  HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if(mappingHandle == nullptr)
+  {
+    close();
+    return false;
+  }
+  m_MappingHandle = mappingHandle;
+  m_Data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+  if(m_Data == nullptr)
+  {
+    close();
+    return false;
+  }
+#else
+  int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+  if(fileDescriptor < 0)
+  {
+    return false;
+  }
+  struct stat fileStatus = {};
+  if(fstat(fileDescriptor, &fileStatus) != 0)
+  {
+    ::close(fileDescriptor);
+    return false;
+  }
+  m_Size = static_cast<usize>(fileStatus.st_size);
+  m_IsOpen = true;
+  if(m_Size == 0)
+  {
+    ::close(fileDescriptor);
+    return true;
+  }
+
+  void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  // The mapping keeps its own reference to the file
+  ::close(fileDescriptor);
+  if(data == MAP_FAILED)
+  {
+    m_Size = 0;
+    m_IsOpen = false;
+    return false;
+  }
+  m_Data = static_cast<const char*>(data);
+  madvise(data, m_Size, MADV_SEQUENTIAL);
+#endif
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::close()
+{
+#ifdef _WIN32
+  if(m_Data != nullptr)
+  {
+    UnmapViewOfFile(m_Data);
+  }
+  if(m_MappingHandle != nullptr)
+  {
+    CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+  }
+  if(m_FileHandle != nullptr)
+  {
+    CloseHandle(static_cast<HANDLE>(m_FileHandle));
+  }
+  m_MappingHandle = nullptr;
+  m_FileHandle = nullptr;
+#else
+  if(m_Data != nullptr)
+  {
+    munmap(const_cast<char*>(m_Data), m_Size);
+  }
+#endif
+  m_Data = nullptr;
+  m_Size = 0;
+  m_IsOpen = false;
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::isOpen() const
+{
+  return m_IsOpen;
+}
+
+// -----------------------------------------------------------------------------
+std::string_view MemoryMappedFile::view() const
+{
+  if(m_Data == nullptr)
+  {
+    return {};
+  }
+  return {m_Data, m_Size};
+}
+
+// -----------------------------------------------------------------------------
+usize MemoryMappedFile::size() const
+{
+  return m_Size;
+}
+} // namespace complex
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <filesystem>
+#include <string_view>
+
+namespace complex
+{
+/**
+ * @class MemoryMappedFile
+ * @brief The MemoryMappedFile class maps an entire file read-only into the address
+ * space of the process. The operating system pages the contents in on demand, so
+ * files much larger than the available memory can be scanned without copying them
+ * into buffers first. The mapping is released when the object is destroyed.
+ */
+class COMPLEX_EXPORT MemoryMappedFile
+{
+public:
+  MemoryMappedFile() = default;
+
+  /**
+   * @brief Maps the file at the given path. Check isOpen() for success.
+   * @param path
+   */
+  explicit MemoryMappedFile(const std::filesystem::path& path);
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+  ~MemoryMappedFile() noexcept;
+
+  /**
+   * @brief Maps the file at the given path, closing any previously mapped file.
+   * Empty files are considered open and have an empty view.
+   * @param path
+   * @return bool True if the file was mapped
+   */
+  bool open(const std::filesystem::path& path);
+
+  /**
+   * @brief Releases the mapping.
+   */
+  void close();
+
+  /**
+   * @brief Returns true if a file is currently mapped.
+   * @return bool
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Returns the contents of the mapped file. The view is only valid while
+   * the file remains open.
+   * @return std::string_view
+   */
+  std::string_view view() const;
+
+  /**
+   * @brief Returns the size of the mapped file in bytes.
+   * @return usize
+   */
+  usize size() const;
+
+private:
+  const char* m_Data = nullptr;
+  usize m_Size = 0;
+  bool m_IsOpen = false;
+#ifdef _WIN32
+  void* m_FileHandle = nullptr;
+  void* m_MappingHandle = nullptr;
+#endif
+};
+} // namespace complex
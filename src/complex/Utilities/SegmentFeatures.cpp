@@ -1,6 +1,9 @@
 #include "SegmentFeatures.hpp"
 
 #include "complex/DataStructure/Geometry/IGridGeometry.hpp"
+#include "complex/Utilities/ParallelScheduler.hpp"
+
+#include <limits>
 
 using namespace complex;
 
@@ -126,6 +129,65 @@ Result<> SegmentFeatures::execute(IGridGeometry* gridGeom)
   return {};
 }
 
+// -----------------------------------------------------------------------------
+SegmentFeatures::SlabLayout SegmentFeatures::createSlabLayout(const IGridGeometry& gridGeom) const
+{
+  // A few slabs per thread keeps the threads busy when some slabs hold more valid voxels than others
+  constexpr usize k_SlabsPerThread = 4;
+
+  SizeVec3 udims = gridGeom.getDimensions();
+
+  SlabLayout layout;
+  layout.dims = {udims[0], udims[1], udims[2]};
+  layout.numVoxels = udims[0] * udims[1] * udims[2];
+  layout.numRows = udims[1] * udims[2];
+  layout.rowStride = static_cast<int64>(udims[0]);
+  layout.planeStride = static_cast<int64>(udims[0] * udims[1]);
+  const usize numThreads = static_cast<usize>(ParallelScheduler::GetCoreBudget());
+  layout.numSlabs = std::max<usize>(std::min(layout.numRows, numThreads * k_SlabsPerThread), 1);
+  return layout;
+}
+
+// -----------------------------------------------------------------------------
+Result<usize> SegmentFeatures::assignFeatureIds(std::vector<int64>& parents, AbstractDataStore<int32>& featureIds) const
+{
+  constexpr usize k_BlockSize = 16384;
+
+  // Every parent has a lower index than its child, so by the time a voxel is
+  // reached its parent already holds the feature id, stored as ~featureId.
+  const usize numVoxels = parents.size();
+  usize numFeatures = 0;
+  std::vector<int32> block(std::min(numVoxels, k_BlockSize));
+  for(usize offset = 0; offset < numVoxels; offset += k_BlockSize)
+  {
+    const usize count = std::min(k_BlockSize, numVoxels - offset);
+    for(usize i = 0; i < count; i++)
+    {
+      const usize point = offset + i;
+      const int64 parent = parents[point];
+      int32 featureId = 0;
+      if(parent == static_cast<int64>(point))
+      {
+        if(numFeatures >= static_cast<usize>(std::numeric_limits<int32>::max()))
+        {
+          return MakeErrorResult<usize>(-87001, fmt::format("More than {} features were found which cannot be stored in the Feature Ids array", std::numeric_limits<int32>::max()));
+        }
+        featureId = static_cast<int32>(++numFeatures);
+      }
+      else if(parent >= 0)
+      {
+        featureId = static_cast<int32>(~parents[parent]);
+      }
+      parents[point] = ~static_cast<int64>(featureId);
+      block[i] = featureId;
+    }
+    featureIds.copyFromBuffer(offset, nonstd::span<const int32>(block.data(), count));
+  }
+
+  return {numFeatures};
+}
+
+// -----------------------------------------------------------------------------
 int64 SegmentFeatures::getSeed(int32 gnum, int64 nextSeed) const
 {
   return -1;
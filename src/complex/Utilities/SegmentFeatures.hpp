@@ -7,8 +7,12 @@
 #include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/IFilter.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <algorithm>
+#include <array>
 #include <random>
+#include <type_traits>
 #include <vector>
 
 namespace complex
@@ -39,6 +43,112 @@ public:
    */
   Result<> execute(IGridGeometry* gridGeom);
 
+  /**
+   * @brief Labels the features of the grid using several threads and writes
+   * them to featureIds.
+   *
+   * The rows of the grid are split into slabs that are labeled at the same
+   * time with a union-find structure. The unions across slab boundaries are
+   * then merged and every valid voxel receives the id of its feature. Features
+   * are numbered from 1 in order of their lowest voxel index, which is the same
+   * numbering execute() produces. Invalid voxels are set to 0.
+   *
+   * isValid(point) returns true for voxels that can be part of a feature and
+   * isSimilar(referencePoint, neighborPoint) returns true when two valid
+   * neighboring voxels belong to the same feature. isValid is called from several
+   * threads at once, so it must not modify any state. isSimilar is copied for
+   * every range of slabs, so each copy is only used by one thread at a time.
+   * isSimilar must also give the same result when its arguments are swapped.
+   *
+   * An int64 parent index is kept for every voxel while labeling.
+   * @param gridGeom
+   * @param featureIds
+   * @param isValid
+   * @param isSimilar
+   * @return Result<usize> The number of features found
+   */
+  template <class IsValidFuncT, class IsSimilarFuncT>
+  Result<usize> executeParallel(const IGridGeometry& gridGeom, AbstractDataStore<int32>& featureIds, IsValidFuncT&& isValid, IsSimilarFuncT&& isSimilar)
+  {
+    const SlabLayout layout = createSlabLayout(gridGeom);
+    std::vector<int64> parents(layout.numVoxels, -1);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, layout.numSlabs);
+    dataAlg.execute([&](const Range& range) {
+      std::decay_t<IsSimilarFuncT> rangeIsSimilar = isSimilar;
+      for(usize slab = range.min(); slab < range.max(); slab++)
+      {
+        const usize firstRow = layout.slabFirstRow(slab);
+        const usize lastRow = layout.slabFirstRow(slab + 1);
+        for(usize row = firstRow; row < lastRow; row++)
+        {
+          if(m_ShouldCancel)
+          {
+            return;
+          }
+          const bool hasYNeighbor = row % layout.dims[1] != 0 && row - 1 >= firstRow;
+          const bool hasZNeighbor = row >= layout.dims[1] && row - layout.dims[1] >= firstRow;
+          for(usize col = 0; col < layout.dims[0]; col++)
+          {
+            const int64 point = static_cast<int64>(row * layout.dims[0] + col);
+            if(!isValid(point))
+            {
+              continue;
+            }
+            parents[point] = point;
+            if(col != 0)
+            {
+              UnionIfSimilar(parents, point, point - 1, rangeIsSimilar);
+            }
+            if(hasYNeighbor)
+            {
+              UnionIfSimilar(parents, point, point - layout.rowStride, rangeIsSimilar);
+            }
+            if(hasZNeighbor)
+            {
+              UnionIfSimilar(parents, point, point - layout.planeStride, rangeIsSimilar);
+            }
+          }
+        }
+      }
+    });
+    if(m_ShouldCancel)
+    {
+      return {};
+    }
+
+    // Merge the unions whose neighbor lies in the previous slab
+    for(usize slab = 1; slab < layout.numSlabs; slab++)
+    {
+      const usize firstRow = layout.slabFirstRow(slab);
+      const usize lastRow = std::min(firstRow + layout.dims[1], layout.slabFirstRow(slab + 1));
+      for(usize row = firstRow; row < lastRow; row++)
+      {
+        const bool hasYNeighbor = row % layout.dims[1] != 0 && row == firstRow;
+        const bool hasZNeighbor = row >= layout.dims[1];
+        for(usize col = 0; col < layout.dims[0]; col++)
+        {
+          const int64 point = static_cast<int64>(row * layout.dims[0] + col);
+          if(parents[point] < 0)
+          {
+            continue;
+          }
+          if(hasYNeighbor)
+          {
+            UnionIfSimilar(parents, point, point - layout.rowStride, isSimilar);
+          }
+          if(hasZNeighbor)
+          {
+            UnionIfSimilar(parents, point, point - layout.planeStride, isSimilar);
+          }
+        }
+      }
+    }
+
+    return assignFeatureIds(parents, featureIds);
+  }
+
   /**
    * @brief Returns the seed for the specified values.
    * @param data
@@ -78,23 +188,103 @@ public:
    */
   virtual SeedGenerator initializeVoxelSeedGenerator(Int64Distribution& distribution, const int64 rangeMin, const int64 rangeMax) const;
 
-  /* from http://www.newty.de/fpt/functor.html */
   /**
-   * @brief The CompareFunctor class serves as a functor superclass for specific implementations
-   * of performing scalar comparisons
+   * @brief The CompareFunctor class serves as a superclass for specific implementations
+   * of performing scalar comparisons. Implementations provide
+   * isSimilar(referencePoint, neighborPoint) for executeParallel().
    */
   class CompareFunctor
   {
   public:
     virtual ~CompareFunctor() = default;
+  };
 
-    virtual bool operator()(int64 index, int64 neighIndex, int32 gnum) // call using () operator
+protected:
+  /**
+   * @brief Describes how the rows of a grid are split into slabs for executeParallel().
+   * A row is a line of voxels along X and rows are numbered by Y and then Z.
+   */
+  struct SlabLayout
+  {
+    std::array<usize, 3> dims = {0, 0, 0};
+    usize numVoxels = 0;
+    usize numRows = 0;
+    usize numSlabs = 0;
+    int64 rowStride = 0;
+    int64 planeStride = 0;
+
+    /**
+     * @brief Returns the first row of the slab. Passing numSlabs returns numRows.
+     * @param slab
+     * @return usize
+     */
+    usize slabFirstRow(usize slab) const
     {
-      return false;
+      return slab * numRows / numSlabs;
     }
   };
 
-protected:
+  /**
+   * @brief Computes the slab layout used by executeParallel().
+   * @param gridGeom
+   * @return SlabLayout
+   */
+  SlabLayout createSlabLayout(const IGridGeometry& gridGeom) const;
+
+  /**
+   * @brief Numbers the union-find roots in order of their voxel index and
+   * writes the feature id of every voxel to featureIds. Voxels with a negative
+   * parent are set to 0. The parents are overwritten.
+   * @param parents
+   * @param featureIds
+   * @return Result<usize> The number of features
+   */
+  Result<usize> assignFeatureIds(std::vector<int64>& parents, AbstractDataStore<int32>& featureIds) const;
+
+  /**
+   * @brief Returns the root of the point, halving the path along the way.
+   * Roots are always the lowest voxel index of their set.
+   * @param parents
+   * @param point
+   * @return int64
+   */
+  static int64 FindRoot(std::vector<int64>& parents, int64 point)
+  {
+    while(parents[point] != point)
+    {
+      parents[point] = parents[parents[point]];
+      point = parents[point];
+    }
+    return point;
+  }
+
+  /**
+   * @brief Joins the sets of the two points if the neighbor is valid and
+   * isSimilar(point, neighbor) returns true.
+   * @param parents
+   * @param point
+   * @param neighbor
+   * @param isSimilar
+   */
+  template <class IsSimilarFuncT>
+  static void UnionIfSimilar(std::vector<int64>& parents, int64 point, int64 neighbor, IsSimilarFuncT& isSimilar)
+  {
+    if(parents[neighbor] < 0 || !isSimilar(point, neighbor))
+    {
+      return;
+    }
+    const int64 pointRoot = FindRoot(parents, point);
+    const int64 neighborRoot = FindRoot(parents, neighbor);
+    if(pointRoot < neighborRoot)
+    {
+      parents[neighborRoot] = pointRoot;
+    }
+    else if(neighborRoot < pointRoot)
+    {
+      parents[pointRoot] = neighborRoot;
+    }
+  }
+
   DataStructure& m_DataStructure;
   const std::atomic_bool& m_ShouldCancel;
   const IFilter::MessageHandler& m_MessageHandler;
@@ -0,0 +1,402 @@
+#include "TupleGatherMap.hpp"
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/FusedDataFunction.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+using namespace complex;
+
+namespace
+{
+constexpr int32 k_InvalidSourceIndexError = -7460;
+constexpr int32 k_ArrayCountMismatchError = -7461;
+constexpr int32 k_SourceIsDestinationError = -7462;
+constexpr int32 k_ArrayTypeMismatchError = -7463;
+constexpr int32 k_DestinationTupleCountError = -7464;
+constexpr int32 k_SourceTupleCountError = -7465;
+
+/**
+ * @brief Copies tuple sources[k] into tuple destinations[k] for every k in the range. Used when
+ * no source tuple is also a destination, so the copies can run in any order.
+ */
+template <typename T>
+class GatherTuplesImpl
+{
+public:
+  GatherTuplesImpl(const AbstractDataStore<T>& source, AbstractDataStore<T>& destination, const std::vector<usize>& destinations, const std::vector<int64>& sources, usize numComponents)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_Destinations(destinations)
+  , m_Sources(sources)
+  , m_NumComponents(numComponents)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    const nonstd::span<const T> sourceValues = m_Source.contiguousSpan();
+    const nonstd::span<T> destinationValues = m_Destination.contiguousSpan();
+    if(!sourceValues.empty() && !destinationValues.empty())
+    {
+      for(usize k = range.min(); k < range.max(); k++)
+      {
+        T* destinationTuple = destinationValues.data() + m_Destinations[k] * m_NumComponents;
+        if(m_Sources[k] == TupleGatherMap::k_ZeroTuple)
+        {
+          std::fill_n(destinationTuple, m_NumComponents, static_cast<T>(0));
+          continue;
+        }
+        const T* sourceTuple = sourceValues.data() + static_cast<usize>(m_Sources[k]) * m_NumComponents;
+        if(sourceTuple != destinationTuple)
+        {
+          std::copy_n(sourceTuple, m_NumComponents, destinationTuple);
+        }
+      }
+      return;
+    }
+
+    for(usize k = range.min(); k < range.max(); k++)
+    {
+      const usize destinationStart = m_Destinations[k] * m_NumComponents;
+      const bool zeroTuple = m_Sources[k] == TupleGatherMap::k_ZeroTuple;
+      const usize sourceStart = zeroTuple ? 0 : static_cast<usize>(m_Sources[k]) * m_NumComponents;
+      for(usize c = 0; c < m_NumComponents; c++)
+      {
+        m_Destination.setValue(destinationStart + c, zeroTuple ? static_cast<T>(0) : m_Source.getValue(sourceStart + c));
+      }
+    }
+  }
+
+private:
+  const AbstractDataStore<T>& m_Source;
+  AbstractDataStore<T>& m_Destination;
+  const std::vector<usize>& m_Destinations;
+  const std::vector<int64>& m_Sources;
+  usize m_NumComponents = 0;
+};
+
+/**
+ * @brief Reads the source tuples of the range into a buffer that is ordered like the destination list.
+ */
+template <typename T>
+class ReadSourceTuplesImpl
+{
+public:
+  ReadSourceTuplesImpl(const AbstractDataStore<T>& source, const std::vector<int64>& sources, usize numComponents, T* buffer)
+  : m_Source(source)
+  , m_Sources(sources)
+  , m_NumComponents(numComponents)
+  , m_Buffer(buffer)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    for(usize k = range.min(); k < range.max(); k++)
+    {
+      T* bufferTuple = m_Buffer + k * m_NumComponents;
+      if(m_Sources[k] == TupleGatherMap::k_ZeroTuple)
+      {
+        std::fill_n(bufferTuple, m_NumComponents, static_cast<T>(0));
+        continue;
+      }
+      const usize sourceStart = static_cast<usize>(m_Sources[k]) * m_NumComponents;
+      for(usize c = 0; c < m_NumComponents; c++)
+      {
+        bufferTuple[c] = m_Source.getValue(sourceStart + c);
+      }
+    }
+  }
+
+private:
+  const AbstractDataStore<T>& m_Source;
+  const std::vector<int64>& m_Sources;
+  usize m_NumComponents = 0;
+  T* m_Buffer = nullptr;
+};
+
+/**
+ * @brief Writes the buffered tuples of the range into their destination tuples.
+ */
+template <typename T>
+class WriteDestinationTuplesImpl
+{
+public:
+  WriteDestinationTuplesImpl(AbstractDataStore<T>& destination, const std::vector<usize>& destinations, usize numComponents, const T* buffer)
+  : m_Destination(destination)
+  , m_Destinations(destinations)
+  , m_NumComponents(numComponents)
+  , m_Buffer(buffer)
+  {
+  }
+
+  void operator()(const Range& range) const
+  {
+    const nonstd::span<T> destinationValues = m_Destination.contiguousSpan();
+    for(usize k = range.min(); k < range.max(); k++)
+    {
+      const T* bufferTuple = m_Buffer + k * m_NumComponents;
+      const usize destinationStart = m_Destinations[k] * m_NumComponents;
+      if(!destinationValues.empty())
+      {
+        std::copy_n(bufferTuple, m_NumComponents, destinationValues.data() + destinationStart);
+        continue;
+      }
+      for(usize c = 0; c < m_NumComponents; c++)
+      {
+        m_Destination.setValue(destinationStart + c, bufferTuple[c]);
+      }
+    }
+  }
+
+private:
+  AbstractDataStore<T>& m_Destination;
+  const std::vector<usize>& m_Destinations;
+  usize m_NumComponents = 0;
+  const T* m_Buffer = nullptr;
+};
+
+struct GatherTuplesFunctor
+{
+  template <typename T>
+  void operator()(const IDataArray& sourceArray, IDataArray& destinationArray, const std::vector<usize>& destinations, const std::vector<int64>& sources, bool bufferSources)
+  {
+    // The destination is fetched first since a shared store is detached on write access
+    auto& destination = dynamic_cast<DataArray<T>&>(destinationArray).getDataStoreRef();
+    const auto& source = dynamic_cast<const DataArray<T>&>(sourceArray).getDataStoreRef();
+    const usize numComponents = destinationArray.getNumberOfComponents();
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, destinations.size());
+    // Stores that are not held in memory are only accessed from the calling thread
+    dataAlg.setParallelizationEnabled(source.isContiguous() && destination.isContiguous());
+
+    if(!bufferSources)
+    {
+      dataAlg.execute(GatherTuplesImpl<T>(source, destination, destinations, sources, numComponents));
+      return;
+    }
+
+    auto buffer = std::make_unique<T[]>(destinations.size() * numComponents);
+    dataAlg.execute(ReadSourceTuplesImpl<T>(source, sources, numComponents, buffer.get()));
+    dataAlg.execute(WriteDestinationTuplesImpl<T>(destination, destinations, numComponents, buffer.get()));
+  }
+};
+
+/**
+ * @brief Creates the gather kernel of one array pair for ExecuteFusedDataFunction(). The stores are
+ * fetched here, on the calling thread, since a shared store is detached on write access.
+ */
+struct MakeGatherKernel
+{
+  const std::vector<const IDataArray*>& sources;
+  const std::vector<IDataArray*>& destinations;
+  const std::vector<usize>& destinationTuples;
+  const std::vector<int64>& sourceTuples;
+
+  template <typename T>
+  std::function<void(const Range&)> operator()(usize arrayIndex)
+  {
+    auto& destination = dynamic_cast<DataArray<T>&>(*destinations[arrayIndex]).getDataStoreRef();
+    const auto& source = dynamic_cast<const DataArray<T>&>(*sources[arrayIndex]).getDataStoreRef();
+    return GatherTuplesImpl<T>(source, destination, destinationTuples, sourceTuples, destinations[arrayIndex]->getNumberOfComponents());
+  }
+};
+
+bool IsInMemory(const IDataArray& array)
+{
+  return array.getIDataStoreRef().getStoreType() == IDataStore::StoreType::InMemory;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+Result<TupleGatherMap> TupleGatherMap::Create(nonstd::span<const int64> sourceIndices)
+{
+  TupleGatherMap gatherMap;
+  gatherMap.m_NumTuples = sourceIndices.size();
+  std::vector<bool> isDestination(gatherMap.m_NumTuples, false);
+  for(usize i = 0; i < gatherMap.m_NumTuples; i++)
+  {
+    const int64 sourceIndex = sourceIndices[i];
+    if(sourceIndex == k_KeepTuple)
+    {
+      continue;
+    }
+    if(sourceIndex < 0 && sourceIndex != k_ZeroTuple)
+    {
+      return MakeErrorResult<TupleGatherMap>(k_InvalidSourceIndexError, fmt::format("TupleGatherMap: Invalid source index {} for tuple {}", sourceIndex, i));
+    }
+    gatherMap.m_Destinations.push_back(i);
+    gatherMap.m_Sources.push_back(sourceIndex);
+    if(sourceIndex >= 0)
+    {
+      gatherMap.m_NumSourceTuples = std::max(gatherMap.m_NumSourceTuples, static_cast<usize>(sourceIndex) + 1);
+    }
+    // A tuple that maps onto itself keeps its value, so other tuples may still read it directly
+    isDestination[i] = sourceIndex != static_cast<int64>(i);
+  }
+
+  for(const int64 sourceIndex : gatherMap.m_Sources)
+  {
+    if(sourceIndex >= 0 && static_cast<usize>(sourceIndex) < gatherMap.m_NumTuples && isDestination[sourceIndex])
+    {
+      gatherMap.m_SourcesOverlapDestinations = true;
+      break;
+    }
+  }
+  return {std::move(gatherMap)};
+}
+
+// -----------------------------------------------------------------------------
+TupleGatherMap::~TupleGatherMap() noexcept = default;
+
+// -----------------------------------------------------------------------------
+usize TupleGatherMap::getNumberOfTuples() const
+{
+  return m_NumTuples;
+}
+
+// -----------------------------------------------------------------------------
+usize TupleGatherMap::getNumberOfChangedTuples() const
+{
+  return m_Destinations.size();
+}
+
+// -----------------------------------------------------------------------------
+Result<> TupleGatherMap::apply(const IDataArray& source, IDataArray& destination) const
+{
+  if(&source == &destination)
+  {
+    return applyInPlace(destination);
+  }
+  Result<> checkResult = checkArrays(source, destination);
+  if(checkResult.invalid())
+  {
+    return checkResult;
+  }
+  ExecuteDataFunction(GatherTuplesFunctor{}, destination.getDataType(), source, destination, m_Destinations, m_Sources, false);
+  return {};
+}
+
+// -----------------------------------------------------------------------------
+Result<> TupleGatherMap::apply(const std::vector<const IDataArray*>& sources, const std::vector<IDataArray*>& destinations) const
+{
+  if(sources.size() != destinations.size())
+  {
+    return MakeErrorResult(k_ArrayCountMismatchError, fmt::format("TupleGatherMap: {} source arrays were given for {} destination arrays", sources.size(), destinations.size()));
+  }
+  for(usize i = 0; i < sources.size(); i++)
+  {
+    if(std::find(sources.begin(), sources.end(), destinations[i]) != sources.end())
+    {
+      return MakeErrorResult(k_SourceIsDestinationError, fmt::format("TupleGatherMap: '{}' is both a source and a destination array", destinations[i]->getName()));
+    }
+    Result<> checkResult = checkArrays(*sources[i], *destinations[i]);
+    if(checkResult.invalid())
+    {
+      return checkResult;
+    }
+  }
+  gatherTogether(sources, destinations);
+  return {};
+}
+
+// -----------------------------------------------------------------------------
+Result<> TupleGatherMap::checkArrays(const IDataArray& source, const IDataArray& destination) const
+{
+  if(source.getDataType() != destination.getDataType() || source.getNumberOfComponents() != destination.getNumberOfComponents())
+  {
+    return MakeErrorResult(k_ArrayTypeMismatchError, fmt::format("TupleGatherMap: '{}' and '{}' do not hold the same type and number of components", source.getName(), destination.getName()));
+  }
+  if(destination.getNumberOfTuples() != m_NumTuples)
+  {
+    return MakeErrorResult(k_DestinationTupleCountError,
+                           fmt::format("TupleGatherMap: '{}' has {} tuples but the map has {} tuples", destination.getName(), destination.getNumberOfTuples(), m_NumTuples));
+  }
+  if(source.getNumberOfTuples() < m_NumSourceTuples)
+  {
+    return MakeErrorResult(k_SourceTupleCountError,
+                           fmt::format("TupleGatherMap: '{}' has {} tuples but the map reads tuple {}", source.getName(), source.getNumberOfTuples(), m_NumSourceTuples - 1));
+  }
+  return {};
+}
+
+// -----------------------------------------------------------------------------
+void TupleGatherMap::gatherTogether(const std::vector<const IDataArray*>& sources, const std::vector<IDataArray*>& destinations) const
+{
+  std::vector<DataType> dataTypes;
+  bool allInMemory = true;
+  for(usize i = 0; i < destinations.size(); i++)
+  {
+    dataTypes.push_back(destinations[i]->getDataType());
+    // Stores that are not held in memory are only accessed from the calling thread
+    allInMemory = allInMemory && IsInMemory(*sources[i]) && IsInMemory(*destinations[i]);
+  }
+  ExecuteFusedDataFunction(MakeGatherKernel{sources, destinations, m_Destinations, m_Sources}, dataTypes, m_Destinations.size(), allInMemory);
+}
+
+// -----------------------------------------------------------------------------
+Result<> TupleGatherMap::applyInPlace(IDataArray& array) const
+{
+  if(array.getNumberOfTuples() != m_NumTuples)
+  {
+    return MakeErrorResult(k_DestinationTupleCountError, fmt::format("TupleGatherMap: '{}' has {} tuples but the map has {} tuples", array.getName(), array.getNumberOfTuples(), m_NumTuples));
+  }
+  if(m_NumSourceTuples > m_NumTuples)
+  {
+    return MakeErrorResult(k_SourceTupleCountError, fmt::format("TupleGatherMap: '{}' has {} tuples but the map reads tuple {}", array.getName(), array.getNumberOfTuples(), m_NumSourceTuples - 1));
+  }
+  ExecuteDataFunction(GatherTuplesFunctor{}, array.getDataType(), array, array, m_Destinations, m_Sources, m_SourcesOverlapDestinations);
+  return {};
+}
+
+// -----------------------------------------------------------------------------
+Result<> TupleGatherMap::applyInPlace(DataStructure& dataStructure, const std::vector<DataPath>& arrayPaths, const std::atomic_bool& shouldCancel) const
+{
+  if(m_Destinations.empty())
+  {
+    return {};
+  }
+  if(m_SourcesOverlapDestinations)
+  {
+    // Every array needs its own buffered copy of the source tuples
+    for(const auto& arrayPath : arrayPaths)
+    {
+      if(shouldCancel)
+      {
+        return {};
+      }
+      Result<> result = applyInPlace(dataStructure.getDataRefAs<IDataArray>(arrayPath));
+      if(result.invalid())
+      {
+        return result;
+      }
+    }
+    return {};
+  }
+
+  std::vector<const IDataArray*> sources;
+  std::vector<IDataArray*> destinations;
+  for(const auto& arrayPath : arrayPaths)
+  {
+    auto& array = dataStructure.getDataRefAs<IDataArray>(arrayPath);
+    Result<> checkResult = checkArrays(array, array);
+    if(checkResult.invalid())
+    {
+      return checkResult;
+    }
+    sources.push_back(&array);
+    destinations.push_back(&array);
+  }
+  if(shouldCancel)
+  {
+    return {};
+  }
+  gatherTogether(sources, destinations);
+  return {};
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "complex/Common/Result.hpp"
+#include "complex/DataStructure/DataPath.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/IDataArray.hpp"
+#include "complex/complex_export.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class TupleGatherMap
+ * @brief Maps every destination tuple to the source tuple it takes its values from. The map is built
+ * once and can then be applied to every array of an attribute matrix. Each array is processed with a
+ * typed kernel over the changed tuples only, split across threads, and several arrays can share one pass.
+ */
+class COMPLEX_EXPORT TupleGatherMap
+{
+public:
+  /**
+   * @brief The destination tuple keeps its current values.
+   */
+  static inline constexpr int64 k_KeepTuple = -1;
+
+  /**
+   * @brief Every component of the destination tuple is set to zero.
+   */
+  static inline constexpr int64 k_ZeroTuple = -2;
+
+  /**
+   * @brief Builds the map from the source tuple index of every destination tuple.
+   * @param sourceIndices One entry per destination tuple: either the source tuple index, k_KeepTuple or k_ZeroTuple
+   * @return Result<TupleGatherMap> Holds an error if any entry is neither a tuple index nor one of the markers
+   */
+  static Result<TupleGatherMap> Create(nonstd::span<const int64> sourceIndices);
+
+  ~TupleGatherMap() noexcept;
+
+  TupleGatherMap(const TupleGatherMap&) = default;
+  TupleGatherMap(TupleGatherMap&&) noexcept = default;
+  TupleGatherMap& operator=(const TupleGatherMap&) = default;
+  TupleGatherMap& operator=(TupleGatherMap&&) noexcept = default;
+
+  /**
+   * @brief Returns the number of tuples of the arrays the map applies to.
+   * @return usize
+   */
+  usize getNumberOfTuples() const;
+
+  /**
+   * @brief Returns the number of destination tuples that are written, i.e. every tuple not marked k_KeepTuple.
+   * @return usize
+   */
+  usize getNumberOfChangedTuples() const;
+
+  /**
+   * @brief Copies the mapped tuples of the source array into the destination array. Both arrays must
+   * hold the same type and number of components; the destination must have getNumberOfTuples() tuples.
+   * @param source The array to read from
+   * @param destination The array to write to. Must not be the source array.
+   * @return Result<>
+   */
+  Result<> apply(const IDataArray& source, IDataArray& destination) const;
+
+  /**
+   * @brief Copies the mapped tuples of sources[i] into destinations[i] for every i. All of the arrays are
+   * processed together in one parallel pass over the destination tuples instead of one pass per array.
+   * @param sources The arrays to read from
+   * @param destinations The arrays to write to. Must have the same size as sources and not contain any of them.
+   * @return Result<>
+   */
+  Result<> apply(const std::vector<const IDataArray*>& sources, const std::vector<IDataArray*>& destinations) const;
+
+  /**
+   * @brief Applies the map within a single array. Every destination tuple receives the values its
+   * source tuple had before the call, even if that source tuple is itself overwritten.
+   * @param array The array to update
+   * @return Result<>
+   */
+  Result<> applyInPlace(IDataArray& array) const;
+
+  /**
+   * @brief Applies the map within each of the given arrays. When no source tuple is also a destination
+   * tuple, the arrays are processed together in one parallel pass.
+   * @param dataStructure The DataStructure holding the arrays
+   * @param arrayPaths The arrays to update
+   * @param shouldCancel Checked between arrays
+   * @return Result<>
+   */
+  Result<> applyInPlace(DataStructure& dataStructure, const std::vector<DataPath>& arrayPaths, const std::atomic_bool& shouldCancel) const;
+
+private:
+  TupleGatherMap() = default;
+
+  /**
+   * @brief Returns an error if the map cannot copy the tuples of source into destination.
+   * @param source
+   * @param destination
+   * @return Result<>
+   */
+  Result<> checkArrays(const IDataArray& source, const IDataArray& destination) const;
+
+  /**
+   * @brief Copies the tuples of all array pairs in one pass without buffering the sources.
+   * @param sources
+   * @param destinations
+   */
+  void gatherTogether(const std::vector<const IDataArray*>& sources, const std::vector<IDataArray*>& destinations) const;
+
+  usize m_NumTuples = 0;
+  usize m_NumSourceTuples = 0;
+  std::vector<usize> m_Destinations;
+  std::vector<int64> m_Sources;
+  bool m_SourcesOverlapDestinations = false;
+};
+} // namespace complex
@@ -63,3 +63,16 @@ TEST_CASE("BitTest")
     REQUIRE(swapped == expected);
   }
 }
+
+TEST_CASE("BitTest: Bit Counting")
+{
+  REQUIRE(countr_zero(0ull) == 64);
+  REQUIRE(countr_zero(1ull) == 0);
+  REQUIRE(countr_zero(0x8000000000000000ull) == 63);
+  REQUIRE(countr_zero(0x0000000000F00000ull) == 20);
+
+  REQUIRE(popcount(0ull) == 0);
+  REQUIRE(popcount(~0ull) == 64);
+  REQUIRE(popcount(0x8000000000000001ull) == 2);
+  REQUIRE(popcount(0x0F0F0F0F0F0F0F0Full) == 32);
+}
@@ -1,15 +1,24 @@
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "complex/Core/Application.hpp"
+#include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/DataStructure/LazyDataStore.hpp"
+#include "complex/DataStructure/OutOfCoreSettings.hpp"
+#include "complex/Filter/Actions/ImportH5ObjectPathsAction.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/FilterHandle.hpp"
 #include "complex/Parameters/Dream3dImportParameter.hpp"
@@ -17,11 +26,16 @@
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/Utilities/Parsing/DREAM3D/Dream3dIO.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileReader.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5FileWriter.hpp"
 #include "complex/unit_test/complex_test_dirs.hpp"
 
+#include <H5Dpublic.h>
+#include <H5Fpublic.h>
+#include <H5Ppublic.h>
+
 using namespace complex;
 namespace fs = std::filesystem;
 
@@ -36,6 +50,9 @@ const fs::path k_ExportFilename2 = "export2.dream3d";
 const fs::path k_MultiExportFilename1 = "multi_export1.dream3d";
 const fs::path k_MultiExportFilename2 = "multi_export2.dream3d";
 const fs::path k_MultiExportFilename3 = "multi_export3.dream3d";
+const fs::path k_ContiguousFilename = "contiguous.dream3d";
+const fs::path k_CompressedFilename = "compressed.dream3d";
+const fs::path k_ParallelCompressedFilename = "parallel_compressed.dream3d";
 } // namespace Constants
 
 std::mutex m_DataMutex;
@@ -48,6 +65,7 @@ constexpr StringLiteral k_Group3Name = "Third-Level";
 constexpr StringLiteral k_AttributeMatrixName = "AttributeMatrix";
 constexpr StringLiteral k_ArrayName = "Test-Array";
 constexpr StringLiteral k_Array2Name = "Test-Array2";
+constexpr StringLiteral k_ImageArrayName = "Image-Array";
 
 constexpr StringLiteral k_CreateDataFilterName = "Create Data Group";
 constexpr StringLiteral k_ExportD3DFilterName = "Write DREAM3D NX File (V8)";
@@ -168,6 +186,10 @@ Pipeline CreateExportPipeline()
     Arguments args;
     args.insert("export_file_path", GetExportDataPath());
     args.insert("write_xdmf_file", true);
+    args.insert("chunk_layout", std::make_any<uint64>(0));
+    args.insert("compression_level", std::make_any<int32>(0));
+    args.insert("use_shuffle", false);
+    args.insert("parallel_compression", true);
     pipeline.push_back(k_ExportD3DHandle, args);
   }
   return pipeline;
@@ -256,6 +278,72 @@ Pipeline CreateMultiImportPipeline()
   return pipeline;
 }
 
+fs::path GetContiguousDataPath()
+{
+  auto app = Application::Instance();
+  if(app == nullptr)
+  {
+    throw std::runtime_error("complex::Application instance not found");
+  }
+
+  return GetDataDir(*app) / Constants::k_ContiguousFilename;
+}
+
+fs::path GetCompressedDataPath()
+{
+  auto app = Application::Instance();
+  if(app == nullptr)
+  {
+    throw std::runtime_error("complex::Application instance not found");
+  }
+
+  return GetDataDir(*app) / Constants::k_CompressedFilename;
+}
+
+fs::path GetParallelCompressedDataPath()
+{
+  auto app = Application::Instance();
+  if(app == nullptr)
+  {
+    throw std::runtime_error("complex::Application instance not found");
+  }
+
+  return GetDataDir(*app) / Constants::k_ParallelCompressedFilename;
+}
+
+DataStructure CreateImageDataStructure()
+{
+  DataStructure dataStructure;
+  auto* dataArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, DataNames::k_ImageArrayName, {20, 32, 32}, {1});
+  auto& dataStore = dataArray->getDataStoreRef();
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    dataStore[i] = static_cast<float32>(i % 17);
+  }
+  return dataStructure;
+}
+
+DataStructure CreateMultiArrayDataStructure(const std::vector<usize>& tupleShape, usize numArrays)
+{
+  DataStructure dataStructure;
+  for(usize arrayIndex = 0; arrayIndex < numArrays; arrayIndex++)
+  {
+    auto* floatArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, fmt::format("Float-Array-{}", arrayIndex), tupleShape, {1});
+    auto* intArray = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, fmt::format("Int-Array-{}", arrayIndex), tupleShape, {3});
+    auto* maskArray = UInt8Array::CreateWithStore<UInt8DataStore>(dataStructure, fmt::format("Mask-Array-{}", arrayIndex), tupleShape, {1});
+    for(usize i = 0; i < floatArray->getSize(); i++)
+    {
+      (*floatArray)[i] = static_cast<float32>((i + arrayIndex) % 251) * 0.5f;
+      (*maskArray)[i] = static_cast<uint8>((i / 7) % 2);
+    }
+    for(usize i = 0; i < intArray->getSize(); i++)
+    {
+      (*intArray)[i] = static_cast<int32>(i / 3 % 1000);
+    }
+  }
+  return dataStructure;
+}
+
 DREAM3D::FileData CreateFileData()
 {
   return {CreateExportPipeline(), CreateTestDataStructure()};
@@ -324,7 +412,11 @@ TEST_CASE("Import/Export DREAM3D Filter Test")
     REQUIRE(importDataStructure.getData(DataPath({DataNames::k_Group1Name})) != nullptr);
     auto* dataArray = importDataStructure.getDataAs<DataArray<int8>>(DataPath({DataNames::k_ArrayName}));
     REQUIRE(dataArray != nullptr);
-    REQUIRE(dataArray->getIDataStoreAs<DataStore<int8>>() != nullptr);
+    // Arrays are imported lazily by default and read when first accessed
+    const auto* lazyStore = dataArray->getIDataStoreAs<LazyDataStore<int8>>();
+    REQUIRE(lazyStore != nullptr);
+    REQUIRE(std::as_const(*dataArray)[0] == 7);
+    REQUIRE(lazyStore->isLoaded());
   }
   {
     auto importPipeline = CreateImportPipeline();
@@ -357,3 +449,363 @@ TEST_CASE("Import/Export Multi-DREAM3D Filter Test")
   REQUIRE(importDataStructure.getData(DataPath({DataNames::k_Group1Name})) != nullptr);
   REQUIRE(importDataStructure.getData(DataPath({DataNames::k_Group2Name})) != nullptr);
 }
+
+TEST_CASE("DREAM3D Compressed File IO Test")
+{
+  Application app;
+  std::lock_guard<std::mutex> lock(m_DataMutex);
+
+  const fs::path contiguousPath = GetContiguousDataPath();
+  const fs::path compressedPath = GetCompressedDataPath();
+  DataStructure dataStructure = CreateImageDataStructure();
+
+  auto contiguousResult = DREAM3D::WriteFile(contiguousPath, dataStructure, {}, false, H5::DatasetCreationOptions{});
+  COMPLEX_RESULT_REQUIRE_VALID(contiguousResult);
+  const DREAM3D::WriteStatistics contiguousStatistics = contiguousResult.value();
+  REQUIRE(contiguousStatistics.dataBytes == 20 * 32 * 32 * sizeof(float32));
+  REQUIRE(contiguousStatistics.storedBytes == contiguousStatistics.dataBytes);
+  REQUIRE(contiguousStatistics.fileBytes > contiguousStatistics.dataBytes);
+
+  H5::DatasetCreationOptions options;
+  options.chunked = true;
+  options.chunkShape = {1};
+  options.compressionLevel = 6;
+  options.shuffle = true;
+  auto compressedResult = DREAM3D::WriteFile(compressedPath, dataStructure, {}, false, options);
+  COMPLEX_RESULT_REQUIRE_VALID(compressedResult);
+  const DREAM3D::WriteStatistics compressedStatistics = compressedResult.value();
+  REQUIRE(compressedStatistics.dataBytes == contiguousStatistics.dataBytes);
+  REQUIRE(compressedStatistics.storedBytes < compressedStatistics.dataBytes);
+  REQUIRE(compressedStatistics.compressionRatio() > 1.0);
+  REQUIRE(fs::file_size(compressedPath) < fs::file_size(contiguousPath));
+
+  // One Z slice per chunk
+  {
+    hid_t fileId = H5Fopen(compressedPath.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    REQUIRE(fileId > 0);
+    hid_t datasetId = H5Dopen(fileId, fmt::format("/DataStructure/{}", DataNames::k_ImageArrayName).c_str(), H5P_DEFAULT);
+    REQUIRE(datasetId > 0);
+    hid_t propertyListId = H5Dget_create_plist(datasetId);
+    REQUIRE(H5Pget_layout(propertyListId) == H5D_CHUNKED);
+    std::vector<hsize_t> chunkDims(4, 0);
+    REQUIRE(H5Pget_chunk(propertyListId, 4, chunkDims.data()) == 4);
+    REQUIRE(chunkDims == std::vector<hsize_t>{1, 32, 32, 1});
+    H5Pclose(propertyListId);
+    H5Dclose(datasetId);
+    H5Fclose(fileId);
+  }
+
+  auto importResult = DREAM3D::ImportDataStructureFromFile(compressedPath);
+  COMPLEX_RESULT_REQUIRE_VALID(importResult);
+  const auto& importedArray = importResult.value().getDataRefAs<Float32Array>(DataPath({DataNames::k_ImageArrayName}));
+  const auto& originalArray = dataStructure.getDataRefAs<Float32Array>(DataPath({DataNames::k_ImageArrayName}));
+  REQUIRE(importedArray.getNumberOfTuples() == originalArray.getNumberOfTuples());
+  REQUIRE(std::equal(importedArray.begin(), importedArray.end(), originalArray.begin()));
+}
+
+TEST_CASE("DREAM3D Parallel Compressed File IO Test")
+{
+  Application app;
+  std::lock_guard<std::mutex> lock(m_DataMutex);
+
+  // 3 rows per chunk leaves a partial chunk at the end of each array
+  DataStructure dataStructure = CreateMultiArrayDataStructure({10, 16, 16}, 3);
+  H5::DatasetCreationOptions options;
+  options.chunked = true;
+  options.chunkShape = {3};
+  options.compressionLevel = 4;
+  options.shuffle = true;
+
+  auto serialResult = DREAM3D::WriteFile(GetCompressedDataPath(), dataStructure, {}, false, options);
+  COMPLEX_RESULT_REQUIRE_VALID(serialResult);
+
+  options.parallelCompression = true;
+  auto parallelResult = DREAM3D::WriteFile(GetParallelCompressedDataPath(), dataStructure, {}, false, options);
+  COMPLEX_RESULT_REQUIRE_VALID(parallelResult);
+  REQUIRE(parallelResult.value().dataBytes == serialResult.value().dataBytes);
+  REQUIRE(parallelResult.value().storedBytes < parallelResult.value().dataBytes);
+
+  auto importResult = DREAM3D::ImportDataStructureFromFile(GetParallelCompressedDataPath());
+  COMPLEX_RESULT_REQUIRE_VALID(importResult);
+  const DataStructure& importedStructure = importResult.value();
+  for(usize arrayIndex = 0; arrayIndex < 3; arrayIndex++)
+  {
+    const DataPath floatPath({fmt::format("Float-Array-{}", arrayIndex)});
+    const DataPath intPath({fmt::format("Int-Array-{}", arrayIndex)});
+    const DataPath maskPath({fmt::format("Mask-Array-{}", arrayIndex)});
+    const auto& importedFloats = importedStructure.getDataRefAs<Float32Array>(floatPath);
+    const auto& importedInts = importedStructure.getDataRefAs<Int32Array>(intPath);
+    const auto& importedMask = importedStructure.getDataRefAs<UInt8Array>(maskPath);
+    REQUIRE(std::equal(importedFloats.begin(), importedFloats.end(), dataStructure.getDataRefAs<Float32Array>(floatPath).begin()));
+    REQUIRE(std::equal(importedInts.begin(), importedInts.end(), dataStructure.getDataRefAs<Int32Array>(intPath).begin()));
+    REQUIRE(std::equal(importedMask.begin(), importedMask.end(), dataStructure.getDataRefAs<UInt8Array>(maskPath).begin()));
+  }
+}
+
+TEST_CASE("DREAM3D Parallel Compressed Write Benchmark", "[.][benchmark]")
+{
+  Application app;
+  std::lock_guard<std::mutex> lock(m_DataMutex);
+
+  DataStructure dataStructure = CreateMultiArrayDataStructure({64, 128, 128}, 8);
+  H5::DatasetCreationOptions options;
+  options.chunked = true;
+  options.chunkShape = {1};
+  options.compressionLevel = 6;
+  options.shuffle = true;
+
+  auto timeWrite = [&](const fs::path& filePath) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = DREAM3D::WriteFile(filePath, dataStructure, {}, false, options);
+    auto end = std::chrono::steady_clock::now();
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+    return std::chrono::duration<float64>(end - start).count();
+  };
+
+  const float64 serialSeconds = timeWrite(GetCompressedDataPath());
+  options.parallelCompression = true;
+  const float64 parallelSeconds = timeWrite(GetParallelCompressedDataPath());
+  WARN(fmt::format("Serial filter pipeline: {:.3f} s, parallel chunk compression: {:.3f} s, speedup {:.2f}x", serialSeconds, parallelSeconds, serialSeconds / parallelSeconds));
+}
+
+TEST_CASE("DREAM3D Lazy Import Test")
+{
+  Application app;
+  std::lock_guard<std::mutex> lock(m_DataMutex);
+
+  const fs::path filePath = GetContiguousDataPath();
+  DataStructure originalStructure = CreateMultiArrayDataStructure({4, 5, 6}, 2);
+  COMPLEX_RESULT_REQUIRE_VALID(DREAM3D::WriteFile(filePath, originalStructure));
+
+  const DataPath floatPath({"Float-Array-0"});
+  const DataPath intPath({"Int-Array-1"});
+  const DataPath maskPath({"Mask-Array-0"});
+
+  DataStructure importedStructure;
+  {
+    H5::FileReader fileReader(filePath);
+    auto importResult = DREAM3D::ImportDataStructureFromFile(fileReader, false, true);
+    COMPLEX_RESULT_REQUIRE_VALID(importResult);
+    importedStructure = std::move(importResult.value());
+  }
+
+  auto& floatArray = importedStructure.getDataRefAs<Float32Array>(floatPath);
+  auto& intArray = importedStructure.getDataRefAs<Int32Array>(intPath);
+  auto& maskArray = importedStructure.getDataRefAs<UInt8Array>(maskPath);
+  const auto* floatStore = floatArray.getIDataStoreAs<LazyDataStore<float32>>();
+  const auto* intStore = intArray.getIDataStoreAs<LazyDataStore<int32>>();
+  auto* maskStore = maskArray.getIDataStoreAs<LazyDataStore<uint8>>();
+  REQUIRE(floatStore != nullptr);
+  REQUIRE(intStore != nullptr);
+  REQUIRE(maskStore != nullptr);
+
+  // Shapes are known without reading any values
+  REQUIRE(intArray.getTupleShape() == std::vector<usize>{4, 5, 6});
+  REQUIRE(intArray.getNumberOfComponents() == 3);
+  REQUIRE_FALSE(floatStore->isLoaded());
+  REQUIRE_FALSE(intStore->isLoaded());
+
+  // Copies of unread stores stay unread
+  auto copiedStore = intStore->deepCopy();
+  REQUIRE_FALSE(dynamic_cast<LazyDataStore<int32>*>(copiedStore.get())->isLoaded());
+
+  // Unread stores are read through hyperslabs without loading them. The range starts inside a row and crosses a plane.
+  const auto& originalInts = originalStructure.getDataRefAs<Int32Array>(intPath);
+  REQUIRE_FALSE(intStore->isContiguous());
+  std::vector<int32> intValues(50);
+  intStore->copyIntoBuffer(7, nonstd::span<int32>(intValues.data(), intValues.size()));
+  for(usize i = 0; i < intValues.size(); i++)
+  {
+    REQUIRE(intValues[i] == originalInts[7 + i]);
+  }
+  REQUIRE_FALSE(intStore->isLoaded());
+
+  // Accessing one array reads only that array
+  const auto& originalFloats = originalStructure.getDataRefAs<Float32Array>(floatPath);
+  REQUIRE(std::equal(std::as_const(floatArray).begin(), std::as_const(floatArray).end(), originalFloats.begin()));
+  REQUIRE(floatStore->isLoaded());
+  REQUIRE(floatStore->isContiguous());
+  REQUIRE_FALSE(intStore->isLoaded());
+
+  // Filling an unread array never reads it
+  maskStore->fill(3);
+  REQUIRE(maskStore->isLoaded());
+  REQUIRE(maskStore->getValue(maskStore->getSize() - 1) == 3);
+
+  // Overwriting the source file reads the remaining arrays first
+  COMPLEX_RESULT_REQUIRE_VALID(DREAM3D::WriteFile(filePath, importedStructure));
+  REQUIRE(intStore->isLoaded());
+  REQUIRE(std::equal(std::as_const(intArray).begin(), std::as_const(intArray).end(), originalInts.begin()));
+}
+
+TEST_CASE("DREAM3D Lazy Import Source File Test")
+{
+  Application app;
+  std::lock_guard<std::mutex> lock(m_DataMutex);
+
+  const fs::path filePath = GetContiguousDataPath();
+  DataStructure originalStructure = CreateMultiArrayDataStructure({4, 5, 6}, 2);
+  COMPLEX_RESULT_REQUIRE_VALID(DREAM3D::WriteFile(filePath, originalStructure));
+
+  DataStructure importedStructure;
+  {
+    H5::FileReader fileReader(filePath);
+    auto importResult = DREAM3D::ImportDataStructureFromFile(fileReader, false, true);
+    COMPLEX_RESULT_REQUIRE_VALID(importResult);
+    importedStructure = std::move(importResult.value());
+  }
+  const DataPath floatPath({"Float-Array-0"});
+  const DataPath intPath({"Int-Array-1"});
+
+  SECTION("Arrays over the out-of-core threshold are loaded out of core")
+  {
+    const auto& floatStore = std::as_const(importedStructure).getDataRefAs<Float32Array>(floatPath).getDataStoreRef();
+    const auto& originalFloats = originalStructure.getDataRefAs<Float32Array>(floatPath);
+    OutOfCoreSettings::SetSizeThreshold(1);
+    bool allEqual = true;
+    for(usize i = 0; i < floatStore.getSize(); i++)
+    {
+      allEqual = allEqual && floatStore.getValue(i) == originalFloats[i];
+    }
+    OutOfCoreSettings::SetSizeThreshold(0);
+    REQUIRE(allEqual);
+    REQUIRE(dynamic_cast<const LazyDataStore<float32>&>(floatStore).isLoaded());
+    REQUIRE_FALSE(floatStore.isContiguous());
+  }
+
+  SECTION("Reading from a modified source file fails")
+  {
+    auto writeResult = DREAM3D::WriteFile(filePath, CreateMultiArrayDataStructure({2, 3, 4}, 1));
+    COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+    const auto* intStore = importedStructure.getDataRefAs<Int32Array>(intPath).getIDataStoreAs<LazyDataStore<int32>>();
+    REQUIRE(intStore != nullptr);
+    REQUIRE_FALSE(intStore->isSourceFileUnchanged());
+    std::vector<int32> intValues(3);
+    REQUIRE_THROWS_AS(intStore->copyIntoBuffer(0, nonstd::span<int32>(intValues.data(), intValues.size())), std::runtime_error);
+    REQUIRE_THROWS_AS(intStore->load(), std::runtime_error);
+  }
+}
+
+TEST_CASE("DREAM3D Parallel Lazy Import Test")
+{
+  Application app;
+  std::lock_guard<std::mutex> lock(m_DataMutex);
+
+  constexpr usize k_NumArrays = 8;
+  const fs::path filePath = GetContiguousDataPath();
+  DataStructure originalStructure = CreateMultiArrayDataStructure({6, 7, 8}, k_NumArrays);
+  COMPLEX_RESULT_REQUIRE_VALID(DREAM3D::WriteFile(filePath, originalStructure));
+
+  DataStructure importedStructure;
+  {
+    H5::FileReader fileReader(filePath);
+    auto importResult = DREAM3D::ImportDataStructureFromFile(fileReader, false, true);
+    COMPLEX_RESULT_REQUIRE_VALID(importResult);
+    importedStructure = std::move(importResult.value());
+  }
+
+  // Workers that touch different unread arrays at the same time each read their own array
+  std::vector<std::atomic_bool> matches(k_NumArrays);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, k_NumArrays);
+  dataAlg.setGrainSize(1);
+  dataAlg.execute([&](const Range& range) {
+    for(usize arrayIndex = range.min(); arrayIndex < range.max(); arrayIndex++)
+    {
+      const DataPath floatPath({fmt::format("Float-Array-{}", arrayIndex)});
+      const auto& floatStore = std::as_const(importedStructure).getDataRefAs<Float32Array>(floatPath).getDataStoreRef();
+      const auto& originalStore = std::as_const(originalStructure).getDataRefAs<Float32Array>(floatPath).getDataStoreRef();
+      const auto values = floatStore.contiguousSpan();
+      const auto originalValues = originalStore.contiguousSpan();
+      matches[arrayIndex] = std::equal(values.begin(), values.end(), originalValues.begin(), originalValues.end());
+    }
+  });
+  REQUIRE(std::all_of(matches.begin(), matches.end(), [](const auto& match) { return match.load(); }));
+}
+
+TEST_CASE("DREAM3D Cropped Import Test")
+{
+  Application app;
+  std::lock_guard<std::mutex> lock(m_DataMutex);
+
+  const SizeVec3 dims(8, 6, 4);
+  const fs::path filePath = GetContiguousDataPath();
+  {
+    DataStructure originalStructure;
+    auto* imageGeom = ImageGeom::Create(originalStructure, "Image");
+    imageGeom->setDimensions(dims);
+    imageGeom->setSpacing(0.5f, 1.0f, 2.0f);
+    imageGeom->setOrigin(1.0f, 2.0f, 3.0f);
+    auto* cellData = AttributeMatrix::Create(originalStructure, "Cell Data", imageGeom->getId());
+    cellData->setShape({dims[2], dims[1], dims[0]});
+    imageGeom->setCellData(*cellData);
+    auto* cellArray = Int32Array::CreateWithStore<Int32DataStore>(originalStructure, "Values", {dims[2], dims[1], dims[0]}, {2}, cellData->getId());
+    for(usize i = 0; i < cellArray->getSize(); i++)
+    {
+      (*cellArray)[i] = static_cast<int32>(i);
+    }
+    Float32Array::CreateWithStore<Float32DataStore>(originalStructure, "Other", {3}, {1});
+    auto writeResult = DREAM3D::WriteFile(filePath, originalStructure);
+    COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+  }
+
+  const DataPath geomPath({"Image"});
+  const DataPath valuesPath({"Image", "Cell Data", "Values"});
+  const DREAM3D::VoxelBounds bounds{SizeVec3(2, 1, 1), SizeVec3(5, 3, 2)};
+  auto checkCroppedShape = [&](const DataStructure& dataStructure) {
+    const auto& imageGeom = dataStructure.getDataRefAs<ImageGeom>(geomPath);
+    REQUIRE(imageGeom.getDimensions() == SizeVec3(4, 3, 2));
+    REQUIRE(imageGeom.getOrigin() == FloatVec3(2.0f, 3.0f, 5.0f));
+    REQUIRE(imageGeom.getCellDataRef().getShape() == std::vector<usize>{2, 3, 4});
+    REQUIRE(dataStructure.getDataRefAs<Int32Array>(valuesPath).getTupleShape() == std::vector<usize>{2, 3, 4});
+  };
+
+  SECTION("Execute")
+  {
+    for(bool lazyLoad : {true, false})
+    {
+      DataStructure dataStructure;
+      ImportH5ObjectPathsAction action(filePath, std::nullopt, lazyLoad, bounds);
+      auto result = action.apply(dataStructure, IDataAction::Mode::Execute);
+      COMPLEX_RESULT_REQUIRE_VALID(result);
+      checkCroppedShape(dataStructure);
+
+      // Only the cropped block is read and the cropped array no longer refers to the file
+      const auto& values = dataStructure.getDataRefAs<Int32Array>(valuesPath);
+      REQUIRE(values.getIDataStoreAs<LazyDataStore<int32>>() == nullptr);
+      for(usize z = 0; z < 2; z++)
+      {
+        for(usize y = 0; y < 3; y++)
+        {
+          for(usize x = 0; x < 4; x++)
+          {
+            const usize sourceTuple = ((z + 1) * dims[1] + y + 1) * dims[0] + x + 2;
+            const usize tuple = (z * 3 + y) * 4 + x;
+            REQUIRE(values.getDataStoreRef().getValue(tuple * 2) == static_cast<int32>(sourceTuple * 2));
+            REQUIRE(values.getDataStoreRef().getValue(tuple * 2 + 1) == static_cast<int32>(sourceTuple * 2 + 1));
+          }
+        }
+      }
+
+      const auto* otherStore = dataStructure.getDataRefAs<Float32Array>(DataPath({"Other"})).getIDataStoreAs<LazyDataStore<float32>>();
+      REQUIRE(otherStore != nullptr);
+      REQUIRE(otherStore->isLoaded() == !lazyLoad);
+    }
+  }
+  SECTION("Preflight")
+  {
+    DataStructure dataStructure;
+    ImportH5ObjectPathsAction action(filePath, std::nullopt, true, bounds);
+    auto result = action.apply(dataStructure, IDataAction::Mode::Preflight);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+    checkCroppedShape(dataStructure);
+  }
+  SECTION("Invalid Bounds")
+  {
+    DataStructure dataStructure;
+    ImportH5ObjectPathsAction action(filePath, std::nullopt, true, DREAM3D::VoxelBounds{SizeVec3(0, 0, 0), SizeVec3(8, 5, 3)});
+    auto result = action.apply(dataStructure, IDataAction::Mode::Execute);
+    REQUIRE(result.invalid());
+    REQUIRE(result.errors()[0].code == DREAM3D::k_InvalidCropBounds);
+  }
+}
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -8,8 +13,11 @@
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/OutOfCoreDataStore.hpp"
+#include "complex/DataStructure/OutOfCoreSettings.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
 using namespace complex;
 
@@ -97,3 +105,264 @@ TEST_CASE("DataStore Test")
   REQUIRE(dataStore[8] == 99);
   REQUIRE(dataStore.getComponentValue(2, 2) == 99);
 }
+
+TEST_CASE("OutOfCoreDataStore Test", "[complex][DataStore]")
+{
+  IDataStore::ShapeType tupleShape{100, 10};
+  IDataStore::ShapeType componentShape{3};
+  // 16 values per chunk and at most 4 chunks in memory
+  OutOfCoreDataStore<int32> dataStore(tupleShape, componentShape, 7, 16 * sizeof(int32), 4 * 16 * sizeof(int32));
+
+  REQUIRE(dataStore.getStoreType() == IDataStore::StoreType::OutOfCore);
+  REQUIRE(dataStore.getSize() == 3000);
+  REQUIRE(dataStore.getChunkSize() == 16);
+  REQUIRE(fs::exists(dataStore.getBackingFilePath()));
+
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    REQUIRE(dataStore[i] == 7);
+  }
+
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    dataStore[i] = static_cast<int32>(i);
+  }
+  REQUIRE(dataStore.getCachedChunkCount() <= dataStore.getMaxCachedChunks());
+
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    REQUIRE(dataStore.getValue(i) == static_cast<int32>(i));
+  }
+
+  auto copy = dataStore.deepCopy();
+  auto& copyStore = dynamic_cast<OutOfCoreDataStore<int32>&>(*copy);
+  REQUIRE(copyStore.getBackingFilePath() != dataStore.getBackingFilePath());
+  dataStore.fill(-1);
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    REQUIRE(dataStore[i] == -1);
+    REQUIRE(copyStore[i] == static_cast<int32>(i));
+  }
+
+  copyStore.reshapeTuples({50, 10});
+  REQUIRE(copyStore.getSize() == 1500);
+  REQUIRE(copyStore[1499] == 1499);
+
+  fs::path backingFile = copyStore.getBackingFilePath();
+  copy.reset();
+  REQUIRE(!fs::exists(backingFile));
+}
+
+TEST_CASE("OutOfCoreDataStore Parallel Access", "[complex][DataStore]")
+{
+  constexpr usize k_ChunkSize = 16;
+  OutOfCoreDataStore<int32> dataStore({4096}, {1}, 0, k_ChunkSize * sizeof(int32), OutOfCoreDataStore<int32>::k_MinCachedChunks * k_ChunkSize * sizeof(int32));
+
+  // Each body holds a reference while it touches other chunks, which evicts chunks pinned by no thread
+  std::atomic_bool referencesValid = true;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, dataStore.getSize());
+  dataAlg.setGrainSize(k_ChunkSize);
+  dataAlg.execute([&dataStore, &referencesValid](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      int32& value = dataStore[i];
+      for(usize offset = 1; offset < OutOfCoreDataStore<int32>::k_MinCachedChunks; offset++)
+      {
+        const usize otherIndex = (i + offset * k_ChunkSize) % dataStore.getSize();
+        if(dataStore[otherIndex] != 0 && dataStore[otherIndex] != static_cast<int32>(otherIndex))
+        {
+          referencesValid = false;
+        }
+      }
+      value = static_cast<int32>(i);
+    }
+  });
+  REQUIRE(referencesValid);
+
+  for(usize i = 0; i < dataStore.getSize(); i++)
+  {
+    REQUIRE(dataStore.getValue(i) == static_cast<int32>(i));
+  }
+}
+
+TEST_CASE("ParallelDataAlgorithm Requires Arrays In Memory", "[complex][DataStore]")
+{
+  DataStructure dataStructure;
+  const auto* inMemoryArray = Int32Array::CreateWithStore<DataStore<int32>>(dataStructure, "InMemory", {100}, {1});
+  const auto* outOfCoreArray = Int32Array::Create(dataStructure, "OutOfCore", std::make_shared<OutOfCoreDataStore<int32>>(IDataStore::ShapeType{100}, IDataStore::ShapeType{1}, 0));
+  REQUIRE(inMemoryArray != nullptr);
+  REQUIRE(outOfCoreArray != nullptr);
+
+  REQUIRE(ParallelDataAlgorithm::CheckArraysInMemory({inMemoryArray}));
+  REQUIRE_FALSE(ParallelDataAlgorithm::CheckArraysInMemory({inMemoryArray, outOfCoreArray}));
+
+  // Only the algorithm whose arrays include the out-of-core one falls back to serial execution
+  ParallelDataAlgorithm inMemoryAlg;
+  const bool defaultParallel = inMemoryAlg.getParallelizationEnabled();
+  inMemoryAlg.requireArraysInMemory({inMemoryArray});
+  REQUIRE(inMemoryAlg.getParallelizationEnabled() == defaultParallel);
+
+  ParallelDataAlgorithm outOfCoreAlg;
+  outOfCoreAlg.requireArraysInMemory({inMemoryArray, outOfCoreArray});
+  REQUIRE_FALSE(outOfCoreAlg.getParallelizationEnabled());
+}
+
+TEST_CASE("DataStore Bulk Access Test", "[complex][DataStore]")
+{
+  IDataStore::ShapeType tupleShape{100, 10};
+  IDataStore::ShapeType componentShape{3};
+  DataStore<int32> dataStore(tupleShape, componentShape, 0);
+  OutOfCoreDataStore<int32> outOfCoreStore(tupleShape, componentShape, 0, 16 * sizeof(int32), 4 * 16 * sizeof(int32));
+
+  REQUIRE(dataStore.isContiguous());
+  REQUIRE(dataStore.contiguousSpan().size() == dataStore.getSize());
+  REQUIRE(dataStore.contiguousSpan().data() == dataStore.data());
+  REQUIRE(!outOfCoreStore.isContiguous());
+  REQUIRE(outOfCoreStore.contiguousSpan().empty());
+
+  std::vector<int32> values(dataStore.getSize());
+  std::iota(values.begin(), values.end(), 0);
+  dataStore.copyFromBuffer(0, values);
+  outOfCoreStore.copyFromBuffer(0, values);
+  for(usize i = 0; i < values.size(); i++)
+  {
+    REQUIRE(dataStore[i] == values[i]);
+    REQUIRE(outOfCoreStore[i] == values[i]);
+  }
+
+  // Ranges that start and end in the middle of out-of-core chunks
+  std::vector<int32> buffer(37, -1);
+  dataStore.copyIntoBuffer(5, buffer);
+  REQUIRE(std::equal(buffer.begin(), buffer.end(), values.begin() + 5));
+  std::fill(buffer.begin(), buffer.end(), -1);
+  outOfCoreStore.copyIntoBuffer(5, buffer);
+  REQUIRE(std::equal(buffer.begin(), buffer.end(), values.begin() + 5));
+
+  REQUIRE_THROWS_AS(dataStore.copyIntoBuffer(dataStore.getSize() - 10, buffer), std::out_of_range);
+  REQUIRE_THROWS_AS(outOfCoreStore.copyFromBuffer(outOfCoreStore.getSize(), buffer), std::out_of_range);
+
+  // copyFrom between contiguous and chunked stores
+  DataStore<int32> copyStore(tupleShape, componentShape, -1);
+  REQUIRE(copyStore.copyFrom(10, outOfCoreStore, 20, 30));
+  REQUIRE(outOfCoreStore.copyFrom(0, dataStore, 500, 100));
+  for(usize i = 0; i < 30 * 3; i++)
+  {
+    REQUIRE(copyStore[30 + i] == values[60 + i]);
+  }
+  REQUIRE(copyStore[29] == -1);
+  REQUIRE(copyStore[120] == -1);
+  for(usize i = 0; i < 100 * 3; i++)
+  {
+    REQUIRE(outOfCoreStore[i] == values[1500 + i]);
+  }
+
+  outOfCoreStore.fillTuple(2, 42);
+  REQUIRE(outOfCoreStore[6] == 42);
+  REQUIRE(outOfCoreStore[8] == 42);
+  REQUIRE(outOfCoreStore[9] == values[1509]);
+
+  ConstDataView<int32> inMemoryView(dataStore);
+  REQUIRE(inMemoryView.isContiguous());
+  ConstDataView<int32> outOfCoreView(outOfCoreStore);
+  REQUIRE(!outOfCoreView.isContiguous());
+  REQUIRE(outOfCoreView.size() == outOfCoreStore.getSize());
+  for(usize i = 0; i < outOfCoreView.size(); i++)
+  {
+    REQUIRE(inMemoryView[i] == dataStore[i]);
+    // Loading a chunk of the view can evict the chunk a reference into the store points to
+    const int32 storeValue = outOfCoreStore.getValue(i);
+    REQUIRE(outOfCoreView[i] == storeValue);
+  }
+}
+
+TEST_CASE("ConstDataView Chunked Access Test", "[complex][DataStore]")
+{
+  constexpr usize k_ChunkSize = ConstDataView<int32>::k_ChunkSize;
+  constexpr usize k_NumValues = k_ChunkSize * (ConstDataView<int32>::k_MaxChunks + 2) + 5;
+  OutOfCoreDataStore<int32> outOfCoreStore({k_NumValues}, {1}, 0, 1024 * sizeof(int32), 4 * 1024 * sizeof(int32));
+  std::vector<int32> values(k_NumValues);
+  std::iota(values.begin(), values.end(), 0);
+  outOfCoreStore.copyFromBuffer(0, values);
+
+  const ConstDataView<int32> view(outOfCoreStore);
+  REQUIRE(view.size() == k_NumValues);
+
+  // Forward and backward passes read every chunk more than once
+  for(usize i = 0; i < k_NumValues; i++)
+  {
+    REQUIRE(view[i] == values[i]);
+  }
+  for(usize i = k_NumValues; i > 0; i--)
+  {
+    REQUIRE(view[i - 1] == values[i - 1]);
+  }
+
+  // Alternating between values three chunks apart, as a stencil over planes does
+  for(usize i = k_ChunkSize; i < k_NumValues - k_ChunkSize; i += 7)
+  {
+    REQUIRE(view[i - k_ChunkSize] == values[i - k_ChunkSize]);
+    REQUIRE(view[i] == values[i]);
+    REQUIRE(view[i + k_ChunkSize] == values[i + k_ChunkSize]);
+  }
+
+  // A copy starts with its own empty cache
+  const ConstDataView<int32> copy = view;
+  REQUIRE(copy[k_NumValues - 1] == values[k_NumValues - 1]);
+  REQUIRE(copy[0] == values[0]);
+
+  REQUIRE_THROWS_AS(view[k_NumValues], std::out_of_range);
+}
+
+TEST_CASE("DataStore Bulk Access Benchmark", "[.][benchmark]")
+{
+  constexpr usize k_NumValues = 64 * 1024 * 1024;
+  DataStore<int32> dataStore({k_NumValues}, {1}, 0);
+  AbstractDataStore<int32>& abstractStore = dataStore;
+
+  auto timeMs = [](auto&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<float64, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  float64 virtualFillMs = timeMs([&]() { std::fill(abstractStore.begin(), abstractStore.end(), 1); });
+  float64 bulkFillMs = timeMs([&]() { abstractStore.fill(2); });
+
+  int64 virtualSum = 0;
+  float64 virtualSumMs = timeMs([&]() {
+    for(usize i = 0; i < k_NumValues; i++)
+    {
+      virtualSum += abstractStore[i];
+    }
+  });
+  int64 spanSum = 0;
+  float64 spanSumMs = timeMs([&]() {
+    ConstDataView<int32> view(abstractStore);
+    for(usize i = 0; i < k_NumValues; i++)
+    {
+      spanSum += view[i];
+    }
+  });
+  REQUIRE(virtualSum == spanSum);
+
+  WARN(fmt::format("fill: iterator {:.1f} ms, bulk {:.1f} ms ({:.1f}x)", virtualFillMs, bulkFillMs, virtualFillMs / bulkFillMs));
+  WARN(fmt::format("sum: operator[] {:.1f} ms, ConstDataView {:.1f} ms ({:.1f}x)", virtualSumMs, spanSumMs, virtualSumMs / spanSumMs));
+}
+
+TEST_CASE("CreateArray OutOfCore Threshold", "[complex][DataStore]")
+{
+  const DataPath k_SmallPath({"Small"});
+  const DataPath k_LargePath({"Large"});
+
+  DataStructure dataStructure;
+  OutOfCoreSettings::SetSizeThreshold(1000 * sizeof(float32));
+  Result<> result = CreateArray<float32>(dataStructure, {10}, {1}, k_SmallPath, IDataAction::Mode::Execute);
+  REQUIRE(result.valid());
+  result = CreateArray<float32>(dataStructure, {1000}, {3}, k_LargePath, IDataAction::Mode::Execute);
+  REQUIRE(result.valid());
+  OutOfCoreSettings::SetSizeThreshold(0);
+
+  REQUIRE(dataStructure.getDataRefAs<Float32Array>(k_SmallPath).getDataStoreRef().getStoreType() == IDataStore::StoreType::InMemory);
+  REQUIRE(dataStructure.getDataRefAs<Float32Array>(k_LargePath).getDataStoreRef().getStoreType() == IDataStore::StoreType::OutOfCore);
+}
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -17,6 +19,7 @@
 #include "complex/DataStructure/Geometry/RectGridGeom.hpp"
 #include "complex/DataStructure/Geometry/TetrahedralGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
 #include "complex/DataStructure/ScalarData.hpp"
 #include "complex/DataStructure/StringArray.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
@@ -689,6 +692,71 @@ TEST_CASE("DataStructureCopyTest")
   REQUIRE(dataStrCopy.getData(newId2));
 }
 
+TEST_CASE("DataStructureCopyOnWriteTest")
+{
+  DataStructure dataStr;
+  auto store = std::make_shared<DataStore<int32>>(std::vector<usize>{10}, std::vector<usize>{1}, 5);
+  auto* dataArr = DataArray<int32>::Create(dataStr, "array", store);
+  REQUIRE(dataArr != nullptr);
+  const auto arrayId = dataArr->getId();
+  REQUIRE_FALSE(dataArr->isDataStoreShared());
+
+  // Copying the DataStructure shares the DataStore until one side writes
+  DataStructure snapshot(dataStr);
+  const auto* snapshotArr = snapshot.getDataAs<DataArray<int32>>(arrayId);
+  REQUIRE(snapshotArr != nullptr);
+  REQUIRE(dataArr->isDataStoreShared());
+  REQUIRE(snapshotArr->getDataStore() == dataArr->getDataStorePtr().lock().get());
+
+  (*dataArr)[3] = 42;
+  REQUIRE_FALSE(dataArr->isDataStoreShared());
+  REQUIRE(snapshotArr->getDataStore() != dataArr->getDataStorePtr().lock().get());
+  REQUIRE((*dataArr)[3] == 42);
+  REQUIRE((*snapshotArr)[3] == 5);
+
+  // A second snapshot taken after the write sees the new value and is unaffected by later writes
+  {
+    DataStructure snapshot2(dataStr);
+    dataArr->fill(7);
+    const auto* snapshot2Arr = snapshot2.getDataAs<DataArray<int32>>(arrayId);
+    REQUIRE((*snapshot2Arr)[3] == 42);
+    REQUIRE((*snapshot2Arr)[0] == 5);
+    REQUIRE((*dataArr)[3] == 7);
+  }
+
+  // Once the other sharer is gone, writes no longer copy
+  {
+    DataStructure snapshot3(dataStr);
+  }
+  const auto* storeBefore = dataArr->getDataStorePtr().lock().get();
+  (*dataArr)[0] = 1;
+  REQUIRE(dataArr->getDataStorePtr().lock().get() == storeBefore);
+  REQUIRE((*snapshotArr)[0] == 5);
+}
+
+TEST_CASE("DataStructureCopyListsTest")
+{
+  DataStructure dataStr;
+  auto* neighborList = NeighborList<int32>::Create(dataStr, "neighbors", 2);
+  REQUIRE(neighborList != nullptr);
+  neighborList->addEntry(0, 1);
+  neighborList->addEntry(1, 2);
+  auto* stringArray = StringArray::CreateWithValues(dataStr, "strings", {"one", "two"});
+  REQUIRE(stringArray != nullptr);
+
+  // Lists and strings are mutated in place, so a snapshot must not share them with the original
+  DataStructure snapshot(dataStr);
+  neighborList->addEntry(0, 3);
+  (*neighborList)[1][0] = 4;
+  (*stringArray)[0] = "changed";
+
+  const auto& snapshotList = snapshot.getDataRefAs<NeighborList<int32>>(neighborList->getId());
+  REQUIRE(snapshotList.getListSize(0) == 1);
+  REQUIRE(snapshotList.getListSpan(1)[0] == 2);
+  REQUIRE(neighborList->getListSize(0) == 2);
+  REQUIRE(snapshot.getDataRefAs<StringArray>(stringArray->getId())[0] == "one");
+}
+
 TEST_CASE("DataStoreTest")
 {
   const size_t numComponents = 3;
@@ -1335,4 +1403,125 @@ TEST_CASE("DataObjectsDeepCopyTest")
     std::shared_ptr<DataObject> copyArrayToSelfGeo = nlArray->deepCopy(srcArrayPath);
     REQUIRE(copyArrayToSelfGeo == nullptr);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("NeighborList Compressed Lists Test", "[NeighborList]")
+{
+  DataStructure dataStruct;
+  auto* neighborList = NeighborList<int32>::Create(dataStruct, "NeighborList", 0);
+  REQUIRE(neighborList != nullptr);
+
+  // Lists: {}, {1, 2}, {3}, {}, {4, 5, 6}
+  neighborList->setCompressedLists({0, 0, 2, 3, 3, 6}, {1, 2, 3, 4, 5, 6});
+  REQUIRE(neighborList->isCompressed());
+  REQUIRE(neighborList->getNumberOfTuples() == 5);
+  REQUIRE(neighborList->getNumberOfLists() == 5);
+  REQUIRE(neighborList->getSize() == 6);
+  REQUIRE(neighborList->getListSize(1) == 2);
+  REQUIRE(neighborList->getListSize(3) == 0);
+  REQUIRE(neighborList->copyOfList(4) == std::vector<int32>{4, 5, 6});
+  bool ok = true;
+  REQUIRE(neighborList->getValue(2, 0, ok) == 3);
+  REQUIRE(ok);
+  neighborList->getValue(2, 1, ok);
+  REQUIRE_FALSE(ok);
+  REQUIRE(neighborList->getListSpan(1).size() == 2);
+  REQUIRE(neighborList->isCompressed());
+
+  SECTION("Invalid offsets")
+  {
+    REQUIRE_THROWS_AS(neighborList->setCompressedLists({1, 2}, {1, 2}), std::invalid_argument);
+    REQUIRE_THROWS_AS(neighborList->setCompressedLists({0, 2, 1, 3}, {1, 2, 3}), std::invalid_argument);
+    REQUIRE_THROWS_AS(neighborList->setCompressedLists({0, 2}, {1, 2, 3}), std::invalid_argument);
+  }
+
+  SECTION("Erase and resize")
+  {
+    REQUIRE(neighborList->eraseTuples({1, 3}) == 0);
+    REQUIRE(neighborList->isCompressed());
+    REQUIRE(neighborList->getNumberOfTuples() == 3);
+    REQUIRE(neighborList->copyOfList(0).empty());
+    REQUIRE(neighborList->copyOfList(1) == std::vector<int32>{3});
+    REQUIRE(neighborList->copyOfList(2) == std::vector<int32>{4, 5, 6});
+
+    neighborList->resizeTuples(4);
+    REQUIRE(neighborList->getListSize(3) == 0);
+    neighborList->resizeTuples(2);
+    REQUIRE(neighborList->getSize() == 1);
+  }
+
+  SECTION("Per-list access expands the lists")
+  {
+    (*neighborList)[1].push_back(7);
+    REQUIRE_FALSE(neighborList->isCompressed());
+    REQUIRE(neighborList->copyOfList(1) == std::vector<int32>{1, 2, 7});
+    REQUIRE(neighborList->copyOfList(4) == std::vector<int32>{4, 5, 6});
+    REQUIRE(neighborList->getSize() == 7);
+    REQUIRE(neighborList->getCompressedValues().empty());
+    REQUIRE(neighborList->getCompressedOffsets().empty());
+
+    // Later changes to the individual lists are never shadowed by the freed compressed lists
+    REQUIRE(neighborList->eraseTuples({0}) == 0);
+    neighborList->resizeTuples(3);
+    REQUIRE(neighborList->getListSpan(0).size() == 3);
+    REQUIRE(neighborList->copyOfList(1) == std::vector<int32>{3});
+    REQUIRE(neighborList->getListSpan(2).empty());
+  }
+
+  SECTION("Concurrent per-list reads")
+  {
+    const NeighborList<int32>& constList = *neighborList;
+    std::vector<std::thread> threads;
+    std::vector<usize> sums(4, 0);
+    for(usize t = 0; t < sums.size(); t++)
+    {
+      threads.emplace_back([&constList, &sums, t]() {
+        for(int32 i = 0; i < 5; i++)
+        {
+          for(int32 value : constList.copyOfList(i))
+          {
+            sums[t] += value;
+          }
+          for(int32 value : constList.getListSpan(i))
+          {
+            sums[t] += value;
+          }
+        }
+      });
+    }
+    for(auto& thread : threads)
+    {
+      thread.join();
+    }
+    REQUIRE(neighborList->isCompressed());
+    REQUIRE(std::all_of(sums.begin(), sums.end(), [](usize sum) { return sum == 42; }));
+  }
+
+  SECTION("Deep copy")
+  {
+    auto copy = std::dynamic_pointer_cast<NeighborList<int32>>(neighborList->deepCopy(DataPath({"NeighborListCopy"})));
+    REQUIRE(copy != nullptr);
+    REQUIRE(copy->isCompressed());
+    REQUIRE(copy->getNumberOfTuples() == 5);
+    for(int32 i = 0; i < 5; i++)
+    {
+      REQUIRE(copy->copyOfList(i) == neighborList->copyOfList(i));
+    }
+  }
+  SECTION("Shallow copies share the compressed lists")
+  {
+    std::unique_ptr<NeighborList<int32>> copy(dynamic_cast<NeighborList<int32>*>(neighborList->shallowCopy()));
+    REQUIRE(copy != nullptr);
+    REQUIRE(copy->getCompressedValues().data() == neighborList->getCompressedValues().data());
+
+    // The first change detaches the changed list only
+    REQUIRE(neighborList->eraseTuples({1}) == 0);
+    REQUIRE(copy->getCompressedValues().data() != neighborList->getCompressedValues().data());
+    REQUIRE(copy->getNumberOfTuples() == 5);
+    REQUIRE(copy->copyOfList(1) == std::vector<int32>{1, 2});
+    REQUIRE(neighborList->copyOfList(1) == std::vector<int32>{3});
+
+    copy->expandLists();
+    REQUIRE(neighborList->isCompressed());
+    REQUIRE(neighborList->copyOfList(3) == std::vector<int32>{4, 5, 6});
+  }
+}
@@ -0,0 +1,223 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/GeometryHelpers.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+using MeshIndexType = uint64;
+
+enum class MeshType
+{
+  Triangle,
+  Quad,
+  Tetrahedral,
+  Hexahedral
+};
+
+/**
+ * @brief Creates the connectivity of a structured mesh with the given number of
+ * cells along each axis. 2D meshes ignore the z dimension. Every hexahedron is
+ * split into six tetrahedra and every quad into two triangles.
+ */
+std::vector<MeshIndexType> CreateMeshConnectivity(MeshType meshType, usize dimX, usize dimY, usize dimZ)
+{
+  const usize vertsX = dimX + 1;
+  const usize vertsY = dimY + 1;
+  auto vertexId = [&](usize x, usize y, usize z) { return static_cast<MeshIndexType>(x + y * vertsX + z * vertsX * vertsY); };
+
+  std::vector<MeshIndexType> connectivity;
+  const usize numZ = (meshType == MeshType::Triangle || meshType == MeshType::Quad) ? 1 : dimZ;
+  for(usize z = 0; z < numZ; z++)
+  {
+    for(usize y = 0; y < dimY; y++)
+    {
+      for(usize x = 0; x < dimX; x++)
+      {
+        const std::array<MeshIndexType, 8> hex = {vertexId(x, y, z),     vertexId(x + 1, y, z),     vertexId(x + 1, y + 1, z),     vertexId(x, y + 1, z),
+                                                  vertexId(x, y, z + 1), vertexId(x + 1, y, z + 1), vertexId(x + 1, y + 1, z + 1), vertexId(x, y + 1, z + 1)};
+        switch(meshType)
+        {
+        case MeshType::Triangle:
+          connectivity.insert(connectivity.end(), {hex[0], hex[1], hex[2], hex[0], hex[2], hex[3]});
+          break;
+        case MeshType::Quad:
+          connectivity.insert(connectivity.end(), {hex[0], hex[1], hex[2], hex[3]});
+          break;
+        case MeshType::Tetrahedral:
+          for(const auto& tet : std::array<std::array<usize, 4>, 6>{{{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}}})
+          {
+            connectivity.insert(connectivity.end(), {hex[tet[0]], hex[tet[1]], hex[tet[2]], hex[tet[3]]});
+          }
+          break;
+        case MeshType::Hexahedral:
+          connectivity.insert(connectivity.end(), hex.begin(), hex.end());
+          break;
+        }
+      }
+    }
+  }
+  return connectivity;
+}
+
+usize VertsPerElement(MeshType meshType)
+{
+  switch(meshType)
+  {
+  case MeshType::Triangle:
+    return 3;
+  case MeshType::Quad:
+  case MeshType::Tetrahedral:
+    return 4;
+  case MeshType::Hexahedral:
+    return 8;
+  }
+  return 0;
+}
+
+/**
+ * @brief Tree based reference implementation matching the original
+ * GeometryHelpers algorithms: one std::map node per distinct sub-element.
+ */
+template <usize N>
+std::vector<MeshIndexType> FindKeysWithMap(const std::vector<MeshIndexType>& connectivity, usize vertsPerElem, const std::vector<std::array<usize, N>>& localVertices, bool unsharedOnly)
+{
+  std::map<std::array<MeshIndexType, N>, usize> keyCounts;
+  const usize numElems = connectivity.size() / vertsPerElem;
+  for(usize i = 0; i < numElems; i++)
+  {
+    for(const auto& local : localVertices)
+    {
+      std::array<MeshIndexType, N> key = {};
+      for(usize v = 0; v < N; v++)
+      {
+        key[v] = connectivity[i * vertsPerElem + local[v]];
+      }
+      std::sort(key.begin(), key.end());
+      keyCounts[key]++;
+    }
+  }
+
+  std::vector<MeshIndexType> result;
+  for(const auto& [key, count] : keyCounts)
+  {
+    if(!unsharedOnly || count == 1)
+    {
+      result.insert(result.end(), key.begin(), key.end());
+    }
+  }
+  return result;
+}
+
+using HelperFunction = void (*)(const DataArray<MeshIndexType>*, DataArray<MeshIndexType>*);
+
+std::vector<MeshIndexType> RunHelper(HelperFunction helper, const std::vector<MeshIndexType>& connectivity, usize vertsPerElem, usize outputComponents)
+{
+  DataStructure dataStructure;
+  auto* elements = DataArray<MeshIndexType>::CreateWithStore<DataStore<MeshIndexType>>(dataStructure, "Elements", {connectivity.size() / vertsPerElem}, {vertsPerElem});
+  auto* output = DataArray<MeshIndexType>::CreateWithStore<DataStore<MeshIndexType>>(dataStructure, "Output", {0}, {outputComponents});
+  elements->getDataStoreRef().copyFromBuffer(0, nonstd::span<const MeshIndexType>(connectivity.data(), connectivity.size()));
+
+  helper(elements, output);
+
+  std::vector<MeshIndexType> result(output->getSize());
+  std::as_const(*output).getDataStoreRef().copyIntoBuffer(0, nonstd::span<MeshIndexType>(result.data(), result.size()));
+  return result;
+}
+
+struct HelperCase
+{
+  std::string name;
+  MeshType meshType;
+  HelperFunction helper;
+  std::vector<MeshIndexType> (*reference)(const std::vector<MeshIndexType>&, usize);
+  usize outputComponents;
+};
+
+std::vector<HelperCase> GetHelperCases()
+{
+  namespace Connectivity = GeometryHelpers::Connectivity;
+  namespace Detail = GeometryHelpers::Connectivity::detail;
+  auto ref2DEdges = [](const std::vector<MeshIndexType>& connectivity, usize vertsPerElem) {
+    return FindKeysWithMap<2>(connectivity, vertsPerElem, Detail::Get2DElementEdges(vertsPerElem), false);
+  };
+  auto ref2DUnsharedEdges = [](const std::vector<MeshIndexType>& connectivity, usize vertsPerElem) {
+    return FindKeysWithMap<2>(connectivity, vertsPerElem, Detail::Get2DElementEdges(vertsPerElem), true);
+  };
+  auto refTetEdges = [](const std::vector<MeshIndexType>& c, usize n) { return FindKeysWithMap<2>(c, n, Detail::k_TetEdges, false); };
+  auto refUnsharedTetEdges = [](const std::vector<MeshIndexType>& c, usize n) { return FindKeysWithMap<2>(c, n, Detail::k_TetEdges, true); };
+  auto refTetFaces = [](const std::vector<MeshIndexType>& c, usize n) { return FindKeysWithMap<3>(c, n, Detail::k_TetFaces, false); };
+  auto refUnsharedTetFaces = [](const std::vector<MeshIndexType>& c, usize n) { return FindKeysWithMap<3>(c, n, Detail::k_TetFaces, true); };
+  auto refHexEdges = [](const std::vector<MeshIndexType>& c, usize n) { return FindKeysWithMap<2>(c, n, Detail::k_HexEdges, false); };
+  auto refUnsharedHexEdges = [](const std::vector<MeshIndexType>& c, usize n) { return FindKeysWithMap<2>(c, n, Detail::k_HexEdges, true); };
+  auto refHexFaces = [](const std::vector<MeshIndexType>& c, usize n) { return FindKeysWithMap<4>(c, n, Detail::k_HexFaces, false); };
+  auto refUnsharedHexFaces = [](const std::vector<MeshIndexType>& c, usize n) { return FindKeysWithMap<4>(c, n, Detail::k_HexFaces, true); };
+
+  return {
+      {"Find2DElementEdges (Triangle)", MeshType::Triangle, &Connectivity::Find2DElementEdges<MeshIndexType>, ref2DEdges, 2},
+      {"Find2DUnsharedEdges (Triangle)", MeshType::Triangle, &Connectivity::Find2DUnsharedEdges<MeshIndexType>, ref2DUnsharedEdges, 2},
+      {"Find2DElementEdges (Quad)", MeshType::Quad, &Connectivity::Find2DElementEdges<MeshIndexType>, ref2DEdges, 2},
+      {"Find2DUnsharedEdges (Quad)", MeshType::Quad, &Connectivity::Find2DUnsharedEdges<MeshIndexType>, ref2DUnsharedEdges, 2},
+      {"FindTetEdges", MeshType::Tetrahedral, &Connectivity::FindTetEdges<MeshIndexType>, refTetEdges, 2},
+      {"FindUnsharedTetEdges", MeshType::Tetrahedral, &Connectivity::FindUnsharedTetEdges<MeshIndexType>, refUnsharedTetEdges, 2},
+      {"FindTetFaces", MeshType::Tetrahedral, &Connectivity::FindTetFaces<MeshIndexType>, refTetFaces, 3},
+      {"FindUnsharedTetFaces", MeshType::Tetrahedral, &Connectivity::FindUnsharedTetFaces<MeshIndexType>, refUnsharedTetFaces, 3},
+      {"FindHexEdges", MeshType::Hexahedral, &Connectivity::FindHexEdges<MeshIndexType>, refHexEdges, 2},
+      {"FindUnsharedHexEdges", MeshType::Hexahedral, &Connectivity::FindUnsharedHexEdges<MeshIndexType>, refUnsharedHexEdges, 2},
+      {"FindHexFaces", MeshType::Hexahedral, &Connectivity::FindHexFaces<MeshIndexType>, refHexFaces, 4},
+      {"FindUnsharedHexFaces", MeshType::Hexahedral, &Connectivity::FindUnsharedHexFaces<MeshIndexType>, refUnsharedHexFaces, 4},
+  };
+}
+} // namespace
+
+TEST_CASE("GeometryHelpers Mesh Topology Test", "[complex][GeometryHelpers]")
+{
+  for(const auto& helperCase : GetHelperCases())
+  {
+    DYNAMIC_SECTION(helperCase.name)
+    {
+      const usize vertsPerElem = VertsPerElement(helperCase.meshType);
+      const std::vector<MeshIndexType> connectivity = CreateMeshConnectivity(helperCase.meshType, 7, 5, 3);
+      const std::vector<MeshIndexType> expected = helperCase.reference(connectivity, vertsPerElem);
+      const std::vector<MeshIndexType> computed = RunHelper(helperCase.helper, connectivity, vertsPerElem, helperCase.outputComponents);
+      REQUIRE(!expected.empty());
+      REQUIRE(computed == expected);
+    }
+  }
+}
+
+TEST_CASE("GeometryHelpers Mesh Topology Benchmark", "[complex][GeometryHelpers][.][benchmark]")
+{
+  using Clock = std::chrono::steady_clock;
+  for(const auto& helperCase : GetHelperCases())
+  {
+    const usize vertsPerElem = VertsPerElement(helperCase.meshType);
+    const bool is2D = helperCase.meshType == MeshType::Triangle || helperCase.meshType == MeshType::Quad;
+    const std::vector<MeshIndexType> connectivity = is2D ? CreateMeshConnectivity(helperCase.meshType, 1000, 1000, 1) : CreateMeshConnectivity(helperCase.meshType, 60, 60, 60);
+
+    auto start = Clock::now();
+    const std::vector<MeshIndexType> expected = helperCase.reference(connectivity, vertsPerElem);
+    const auto mapTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    const std::vector<MeshIndexType> computed = RunHelper(helperCase.helper, connectivity, vertsPerElem, helperCase.outputComponents);
+    const auto sortTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    REQUIRE(computed == expected);
+    WARN(fmt::format("{}: {} elements, std::map {:.1f} ms, sorted keys {:.1f} ms ({:.1f}x)", helperCase.name, connectivity.size() / vertsPerElem, mapTime, sortTime, mapTime / sortTime));
+  }
+}
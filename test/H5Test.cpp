@@ -13,6 +13,8 @@
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
 #include "complex/DataStructure/Montage/GridMontage.hpp"
+#include "complex/DataStructure/OutOfCoreDataStore.hpp"
+#include "complex/DataStructure/OutOfCoreSettings.hpp"
 #include "complex/DataStructure/ScalarData.hpp"
 #include "complex/DataStructure/StringArray.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
@@ -640,6 +642,9 @@ TEST_CASE("NeighborList IO")
   {
     DataStructure ds;
     CreateNeighborList(ds);
+    auto* neighborGroup = ds.getDataAs<DataGroup>(DataPath({k_NeighborGroupName}));
+    auto* compressedList = NeighborList<float32>::Create(ds, "CompressedNeighborList", 0, neighborGroup->getId());
+    compressedList->setCompressedLists({0, 2, 2, 5}, {0.5f, 1.5f, 2.5f, 3.5f, 4.5f});
     Result<H5::FileWriter> result = H5::FileWriter::CreateFile(filePathString);
     REQUIRE(result.valid());
 
@@ -664,9 +669,22 @@ TEST_CASE("NeighborList IO")
     auto ds = DataStructure::readFromHdf5(fileReader, err);
     REQUIRE(err >= 0);
 
-    // auto neighborList = ds.getDataAs<NeighborList<int64>>(DataPath({k_NeighborGroupName, "NeighborList"}));
-    auto neighborList = ds.getData(DataPath({k_NeighborGroupName, "NeighborList"}));
+    auto* neighborList = ds.getDataAs<NeighborList<int64>>(DataPath({k_NeighborGroupName, "NeighborList"}));
     REQUIRE(neighborList != nullptr);
+    // Lists are read straight into the compressed layout
+    REQUIRE(neighborList->isCompressed());
+    REQUIRE(neighborList->getNumberOfLists() == 50);
+    for(int32 i = 0; i < 50; i++)
+    {
+      REQUIRE(neighborList->copyOfList(i) == std::vector<int64>(50 - i, i));
+    }
+
+    auto* compressedList = ds.getDataAs<NeighborList<float32>>(DataPath({k_NeighborGroupName, "CompressedNeighborList"}));
+    REQUIRE(compressedList != nullptr);
+    REQUIRE(compressedList->getNumberOfTuples() == 3);
+    REQUIRE(compressedList->copyOfList(0) == std::vector<float32>{0.5f, 1.5f});
+    REQUIRE(compressedList->getListSize(1) == 0);
+    REQUIRE(compressedList->copyOfList(2) == std::vector<float32>{2.5f, 3.5f, 4.5f});
   } catch(const std::exception& e)
   {
     FAIL(e.what());
@@ -744,6 +762,79 @@ TEST_CASE("DataArray<bool> IO")
   }
 }
 
+TEST_CASE("OutOfCoreDataStore IO")
+{
+  Application app;
+
+  fs::path dataDir = GetDataDir();
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir() / "OutOfCoreDataStoreTest.dream3d";
+
+  const IDataStore::ShapeType tupleShape{20, 30, 40};
+  const IDataStore::ShapeType componentShape{3};
+
+  // Write HDF5 file
+  try
+  {
+    DataStructure ds;
+    // Chunks smaller than a single slice of the slowest dimension
+    auto dataStore = std::make_unique<OutOfCoreDataStore<float32>>(tupleShape, componentShape, 0.0f, 512 * sizeof(float32), 4 * 512 * sizeof(float32));
+    for(usize i = 0; i < dataStore->getSize(); i++)
+    {
+      (*dataStore)[i] = static_cast<float32>(i);
+    }
+    REQUIRE(Float32Array::Create(ds, "OutOfCore", std::move(dataStore)) != nullptr);
+
+    Result<H5::FileWriter> result = H5::FileWriter::CreateFile(filePath);
+    REQUIRE(result.valid());
+
+    H5::FileWriter fileWriter = std::move(result.value());
+    REQUIRE(fileWriter.isValid());
+
+    herr_t err = ds.writeHdf5(fileWriter);
+    REQUIRE(err >= 0);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+
+  // Read HDF5 file back in memory and out of core
+  for(usize threshold : {static_cast<usize>(0), static_cast<usize>(1024)})
+  {
+    try
+    {
+      OutOfCoreSettings::SetSizeThreshold(threshold);
+      H5::FileReader fileReader(filePath);
+      REQUIRE(fileReader.isValid());
+
+      herr_t err;
+      auto ds = DataStructure::readFromHdf5(fileReader, err);
+      OutOfCoreSettings::SetSizeThreshold(0);
+      REQUIRE(err >= 0);
+
+      auto* dataArray = ds.getDataAs<Float32Array>(DataPath({"OutOfCore"}));
+      REQUIRE(dataArray != nullptr);
+      const auto& dataStore = dataArray->getDataStoreRef();
+      REQUIRE(dataStore.getStoreType() == (threshold == 0 ? IDataStore::StoreType::InMemory : IDataStore::StoreType::OutOfCore));
+      REQUIRE(dataStore.getTupleShape() == tupleShape);
+      REQUIRE(dataStore.getComponentShape() == componentShape);
+      for(usize i = 0; i < dataStore.getSize(); i++)
+      {
+        REQUIRE(dataStore[i] == static_cast<float32>(i));
+      }
+    } catch(const std::exception& e)
+    {
+      OutOfCoreSettings::SetSizeThreshold(0);
+      FAIL(e.what());
+    }
+  }
+}
+
 TEST_CASE("xmdf")
 {
   DataStructure ds;
@@ -0,0 +1,219 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/Utilities/DataArrayUtilities.hpp"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+template <typename T>
+DataArray<T>* CreateMaskArray(DataStructure& dataStructure, const std::string& name, usize numTuples, float64 density, uint64 seed)
+{
+  auto* array = DataArray<T>::template CreateWithStore<DataStore<T>>(dataStructure, name, std::vector<usize>{numTuples}, std::vector<usize>{1});
+  std::mt19937_64 generator(seed);
+  std::bernoulli_distribution distribution(density);
+  for(usize i = 0; i < numTuples; i++)
+  {
+    (*array)[i] = static_cast<T>(distribution(generator));
+  }
+  return array;
+}
+} // namespace
+
+TEST_CASE("complex::MaskBitset: Matches Mask Arrays", "[complex][MaskBitset]")
+{
+  // Not a multiple of 64 so the last word is only partially used
+  constexpr usize k_NumTuples = 10007;
+  DataStructure dataStructure;
+  auto* boolMask = CreateMaskArray<bool>(dataStructure, "Bool", k_NumTuples, 0.3, 1);
+  auto* uint8Mask = CreateMaskArray<uint8>(dataStructure, "UInt8", k_NumTuples, 0.3, 2);
+  (*uint8Mask)[5] = 7;
+  auto* int32Array = CreateMaskArray<int32>(dataStructure, "Int32", k_NumTuples, 0.3, 3);
+
+  const MaskBitset boolBitset = MaskBitset::Create(*boolMask);
+  const MaskBitset uint8Bitset = MaskBitset::Create(dataStructure, DataPath({"UInt8"}));
+  REQUIRE(boolBitset.size() == k_NumTuples);
+  REQUIRE(uint8Bitset.size() == k_NumTuples);
+
+  usize boolCount = 0;
+  usize uint8Count = 0;
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    REQUIRE(boolBitset.isTrue(i) == (*boolMask)[i]);
+    REQUIRE(uint8Bitset.isTrue(i) == ((*uint8Mask)[i] != 0));
+    boolCount += (*boolMask)[i] ? 1 : 0;
+    uint8Count += (*uint8Mask)[i] != 0 ? 1 : 0;
+  }
+  REQUIRE(boolBitset.count() == boolCount);
+  REQUIRE(uint8Bitset.count() == uint8Count);
+  REQUIRE(boolBitset.words().back() >> (k_NumTuples % MaskBitset::k_BitsPerWord) == 0);
+
+  REQUIRE_THROWS_AS(MaskBitset::Create(*int32Array), std::runtime_error);
+  REQUIRE_THROWS_AS(MaskBitset::Create(dataStructure, DataPath({"Missing"})), std::out_of_range);
+}
+
+TEST_CASE("complex::MaskBitset: Set Bit Iteration", "[complex][MaskBitset]")
+{
+  constexpr usize k_NumBits = 300;
+  MaskBitset bitset(k_NumBits);
+  const std::vector<usize> setBits = {0, 1, 63, 64, 65, 127, 128, 200, 255, 256, 299};
+  for(usize index : setBits)
+  {
+    bitset.setValue(index, true);
+  }
+  bitset.setValue(150, true);
+  bitset.setValue(150, false);
+  REQUIRE(bitset.count() == setBits.size());
+  REQUIRE(bitset.bothTrue(63, 64));
+  REQUIRE(!bitset.bothTrue(62, 63));
+  REQUIRE(bitset.bothFalse(2, 150));
+
+  // Every sub range, including ranges inside a single word and ranges ending on a word boundary
+  for(usize begin = 0; begin <= k_NumBits; begin += 7)
+  {
+    for(usize end : {begin, begin + 1, begin + 63, begin + 64, begin + 129, k_NumBits, k_NumBits + 10})
+    {
+      std::vector<usize> expected;
+      for(usize index : setBits)
+      {
+        if(index >= begin && index < end)
+        {
+          expected.push_back(index);
+        }
+      }
+      std::vector<usize> visited;
+      bitset.forEachSetBit(begin, end, [&visited](usize index) { visited.push_back(index); });
+      REQUIRE(visited == expected);
+    }
+
+    usize next = begin;
+    while(next < k_NumBits && !bitset.isTrue(next))
+    {
+      next++;
+    }
+    REQUIRE(bitset.findNext(begin) == next);
+  }
+
+  std::vector<usize> visited;
+  bitset.forEachSetBit([&visited](usize index) { visited.push_back(index); });
+  REQUIRE(visited == setBits);
+  REQUIRE(MaskBitset(0).findNext(0) == 0);
+}
+
+TEST_CASE("complex::MaskBitset: Typed Mask Compare", "[complex][MaskBitset]")
+{
+  constexpr usize k_NumTuples = 1000;
+  DataStructure dataStructure;
+  auto* boolMask = CreateMaskArray<bool>(dataStructure, "Bool", k_NumTuples, 0.5, 4);
+  auto* uint8Mask = CreateMaskArray<uint8>(dataStructure, "UInt8", k_NumTuples, 0.5, 5);
+  auto* int32Array = CreateMaskArray<int32>(dataStructure, "Int32", k_NumTuples, 0.5, 6);
+
+  for(IDataArray* maskArray : {static_cast<IDataArray*>(boolMask), static_cast<IDataArray*>(uint8Mask)})
+  {
+    std::unique_ptr<MaskCompare> maskCompare = InstantiateMaskCompare(*maskArray);
+    const usize expectedCount = MaskBitset::Create(*maskArray).count();
+    const bool firstValue = maskCompare->isTrue(0);
+    const usize numTrue = ExecuteMaskFunction(
+        [&](auto& mask) {
+          REQUIRE(mask.size() == k_NumTuples);
+          usize count = 0;
+          for(usize i = 0; i < k_NumTuples; i++)
+          {
+            REQUIRE(mask.isTrue(i) == maskCompare->isTrue(i));
+            if(i + 1 < k_NumTuples)
+            {
+              REQUIRE(mask.bothTrue(i, i + 1) == maskCompare->bothTrue(i, i + 1));
+              REQUIRE(mask.bothFalse(i, i + 1) == maskCompare->bothFalse(i, i + 1));
+            }
+            count += mask.isTrue(i) ? 1 : 0;
+          }
+          mask.setValue(0, !firstValue);
+          return count;
+        },
+        *maskArray);
+    REQUIRE(numTrue == expectedCount);
+    REQUIRE(maskCompare->isTrue(0) != firstValue);
+  }
+
+  REQUIRE_THROWS_AS(ExecuteMaskFunction([](auto& mask) {}, *int32Array), std::runtime_error);
+}
+
+TEST_CASE("complex::MaskBitset: Sparse Mask Benchmark", "[.][benchmark]")
+{
+  // A sample covering 1% of a 256^3 image
+  constexpr usize k_NumTuples = 256 * 256 * 256;
+  DataStructure dataStructure;
+  auto* maskArray = CreateMaskArray<bool>(dataStructure, "Mask", k_NumTuples, 0.0, 7);
+  auto* values = DataArray<float32>::CreateWithStore<DataStore<float32>>(dataStructure, "Values", std::vector<usize>{k_NumTuples}, std::vector<usize>{1});
+  for(usize z = 120; z < 136; z++)
+  {
+    for(usize y = 0; y < 256; y++)
+    {
+      for(usize x = 64; x < 104; x++)
+      {
+        (*maskArray)[(z * 256 + y) * 256 + x] = true;
+      }
+    }
+  }
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    (*values)[i] = static_cast<float32>(i % 1000);
+  }
+  const auto& valuesStore = values->getDataStoreRef();
+
+  auto timeMs = [](auto&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<float64, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  float64 virtualSum = 0.0;
+  float64 virtualMs = timeMs([&]() {
+    std::unique_ptr<MaskCompare> maskCompare = InstantiateMaskCompare(*maskArray);
+    for(usize i = 0; i < k_NumTuples; i++)
+    {
+      if(maskCompare->isTrue(i))
+      {
+        virtualSum += valuesStore[i];
+      }
+    }
+  });
+
+  float64 typedSum = 0.0;
+  float64 typedMs = timeMs([&]() {
+    ExecuteMaskFunction(
+        [&](auto& mask) {
+          for(usize i = 0; i < k_NumTuples; i++)
+          {
+            if(mask.isTrue(i))
+            {
+              typedSum += valuesStore[i];
+            }
+          }
+        },
+        *maskArray);
+  });
+
+  float64 bitsetSum = 0.0;
+  float64 packMs = 0.0;
+  float64 bitsetMs = timeMs([&]() {
+    MaskBitset mask;
+    packMs = timeMs([&]() { mask = MaskBitset::Create(*maskArray); });
+    mask.forEachSetBit([&](usize i) { bitsetSum += valuesStore[i]; });
+  });
+
+  REQUIRE(virtualSum == typedSum);
+  REQUIRE(virtualSum == bitsetSum);
+  WARN(fmt::format("masked sum: MaskCompare {:.1f} ms, TypedMaskCompare {:.1f} ms ({:.1f}x), MaskBitset {:.1f} ms including {:.1f} ms packing ({:.1f}x)", virtualMs, typedMs, virtualMs / typedMs,
+                   bitsetMs, packMs, virtualMs / bitsetMs));
+}
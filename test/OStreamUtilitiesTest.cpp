@@ -0,0 +1,319 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/NeighborList.hpp"
+#include "complex/DataStructure/StringArray.hpp"
+#include "complex/Utilities/OStreamUtilities.hpp"
+
+#include "complex/unit_test/complex_test_dirs.hpp"
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace complex;
+
+namespace
+{
+const DataPath k_Int8Path({"Int8"});
+const DataPath k_Float32Path({"Float32"});
+const DataPath k_UInt64Path({"UInt64"});
+const DataPath k_NeighborListPath({"NeighborList"});
+const DataPath k_StringArrayPath({"Strings"});
+
+const IFilter::MessageHandler k_NullMessageHandler = IFilter::MessageHandler{[](const IFilter::Message&) {}};
+
+template <typename T>
+DataArray<T>* CreateArray(DataStructure& dataStructure, const DataPath& path, usize numTuples, usize numComps)
+{
+  return DataArray<T>::template CreateWithStore<DataStore<T>>(dataStructure, path.getTargetName(), std::vector<usize>{numTuples}, std::vector<usize>{numComps});
+}
+
+/**
+ * @brief Creates arrays of mixed types whose tuple count spans several formatting blocks.
+ */
+DataStructure CreateTestData(usize numTuples)
+{
+  DataStructure dataStructure;
+  std::mt19937_64 generator(numTuples);
+  std::uniform_real_distribution<float32> distribution(-1000.0f, 1000.0f);
+
+  auto& int8Store = CreateArray<int8>(dataStructure, k_Int8Path, numTuples, 3)->getDataStoreRef();
+  auto& float32Store = CreateArray<float32>(dataStructure, k_Float32Path, numTuples, 1)->getDataStoreRef();
+  auto& uint64Store = CreateArray<uint64>(dataStructure, k_UInt64Path, numTuples, 2)->getDataStoreRef();
+  for(usize i = 0; i < numTuples; i++)
+  {
+    for(usize comp = 0; comp < 3; comp++)
+    {
+      int8Store[i * 3 + comp] = static_cast<int8>((i + comp) % 256 - 128);
+    }
+    float32Store[i] = distribution(generator);
+    uint64Store[i * 2] = i * 1000003;
+    uint64Store[i * 2 + 1] = std::numeric_limits<uint64>::max() - i;
+  }
+
+  std::vector<usize> offsets = {0};
+  std::vector<int32> values;
+  for(usize list = 0; list < numTuples; list++)
+  {
+    for(usize index = 0; index < list % 5; index++)
+    {
+      values.push_back(static_cast<int32>(list * 10 + index) - 50);
+    }
+    offsets.push_back(values.size());
+  }
+  auto* neighborList = NeighborList<int32>::Create(dataStructure, k_NeighborListPath.getTargetName(), numTuples);
+  neighborList->setCompressedLists(std::move(offsets), std::move(values));
+
+  StringArray::CreateWithValues(dataStructure, k_StringArrayPath.getTargetName(), {"Foo", "Bar", "Bazz", "Qux", "Quux"});
+  return dataStructure;
+}
+
+/**
+ * @brief Formats a single value the way the original stream based writer did.
+ */
+template <typename T>
+std::string ReferenceValue(T value)
+{
+  if constexpr(std::is_same_v<T, int8> || std::is_same_v<T, uint8>)
+  {
+    return std::to_string(static_cast<int32>(value));
+  }
+  else
+  {
+    return fmt::format("{}", value);
+  }
+}
+
+template <typename T>
+std::string ReferenceTuple(const DataArray<T>& dataArray, usize tuple, const std::string& delimiter)
+{
+  const usize numComps = dataArray.getNumberOfComponents();
+  std::string text;
+  for(usize comp = 0; comp < numComps; comp++)
+  {
+    text += ReferenceValue(dataArray[tuple * numComps + comp]);
+    if(comp != numComps - 1)
+    {
+      text += delimiter;
+    }
+  }
+  return text;
+}
+
+std::string ReferenceNeighborList(const NeighborList<int32>& neighborList, const std::string& delimiter, bool includeIndex)
+{
+  std::string text;
+  for(int32 list = 0; list < neighborList.getNumberOfLists(); list++)
+  {
+    const auto values = neighborList.getListSpan(list);
+    if(includeIndex)
+    {
+      text += fmt::format("{}{}", list, delimiter);
+    }
+    text += fmt::format("{}{}", values.size(), delimiter);
+    for(usize index = 0; index < values.size(); index++)
+    {
+      text += ReferenceValue(values[index]);
+      if(index != values.size() - 1)
+      {
+        text += delimiter;
+      }
+    }
+    text += "\n";
+  }
+  return text;
+}
+
+std::string ReadFile(const fs::path& path)
+{
+  std::ifstream inputStrm(path, std::ios_base::binary);
+  std::stringstream contents;
+  contents << inputStrm.rdbuf();
+  return contents.str();
+}
+
+/**
+ * @brief Stream buffer that only counts the characters written to it so the benchmark
+ * measures formatting rather than the disk.
+ */
+class CountingStreamBuf : public std::streambuf
+{
+public:
+  usize count() const
+  {
+    return m_Count;
+  }
+
+protected:
+  int_type overflow(int_type character) override
+  {
+    m_Count++;
+    return traits_type::not_eof(character);
+  }
+
+  std::streamsize xsputn(const char_type*, std::streamsize count) override
+  {
+    m_Count += static_cast<usize>(count);
+    return count;
+  }
+
+private:
+  usize m_Count = 0;
+};
+} // namespace
+
+TEST_CASE("OStreamUtilities: Print Data Sets To Single File", "[OStreamUtilities]")
+{
+  const usize numTuples = 100003;
+  DataStructure dataStructure = CreateTestData(numTuples);
+  const auto& int8Array = dataStructure.getDataRefAs<Int8Array>(k_Int8Path);
+  const auto& float32Array = dataStructure.getDataRefAs<Float32Array>(k_Float32Path);
+  const auto& uint64Array = dataStructure.getDataRefAs<UInt64Array>(k_UInt64Path);
+  const auto& neighborList = dataStructure.getDataRefAs<NeighborList<int32>>(k_NeighborListPath);
+  const std::atomic_bool shouldCancel = false;
+  const std::string delimiter = ",";
+
+  for(bool includeIndex : {false, true})
+  {
+    DYNAMIC_SECTION("Include Index: " << includeIndex)
+    {
+      std::ostringstream outputStrm;
+      OStreamUtilities::PrintDataSetsToSingleFile(outputStrm, {k_Int8Path, k_Float32Path, k_UInt64Path}, dataStructure, k_NullMessageHandler, shouldCancel, delimiter, includeIndex, true,
+                                                  {k_NeighborListPath}, true);
+
+      std::string expected = includeIndex ? "7\nFeature_IDs," : "7\n";
+      expected += "Int8_0,Int8_1,Int8_2,Float32,UInt64_0,UInt64_1\n";
+      for(usize tuple = 0; tuple < numTuples; tuple++)
+      {
+        if(includeIndex)
+        {
+          expected += fmt::format("{},", tuple);
+        }
+        expected += fmt::format("{},{},{}\n", ReferenceTuple(int8Array, tuple, delimiter), ReferenceTuple(float32Array, tuple, delimiter), ReferenceTuple(uint64Array, tuple, delimiter));
+      }
+      expected += includeIndex ? "Feature_IDs,Element Count,NeighborList\n" : "Element Count,NeighborList\n";
+      expected += ReferenceNeighborList(neighborList, delimiter, includeIndex);
+
+      const std::string output = outputStrm.str();
+      REQUIRE(output.size() == expected.size());
+      REQUIRE(output == expected);
+    }
+  }
+}
+
+TEST_CASE("OStreamUtilities: Print Single Data Object", "[OStreamUtilities]")
+{
+  const usize numTuples = 70001;
+  DataStructure dataStructure = CreateTestData(numTuples);
+  const auto& int8Array = dataStructure.getDataRefAs<Int8Array>(k_Int8Path);
+  const std::atomic_bool shouldCancel = false;
+
+  SECTION("One Tuple Per Line")
+  {
+    std::ostringstream outputStrm;
+    OStreamUtilities::PrintSingleDataObject(outputStrm, k_Int8Path, dataStructure, k_NullMessageHandler, shouldCancel, " ");
+
+    std::string expected;
+    for(usize tuple = 0; tuple < numTuples; tuple++)
+    {
+      expected += ReferenceTuple(int8Array, tuple, " ") + "\n";
+    }
+    REQUIRE(outputStrm.str() == expected);
+  }
+  SECTION("Components Per Line")
+  {
+    // 4 values per line does not line up with the 3 component tuples
+    std::ostringstream outputStrm;
+    OStreamUtilities::PrintSingleDataObject(outputStrm, k_Int8Path, dataStructure, k_NullMessageHandler, shouldCancel, ";", false, false, 4);
+
+    std::string expected;
+    for(usize index = 0; index < int8Array.getSize(); index++)
+    {
+      expected += ReferenceValue(int8Array[index]);
+      expected += (index % 4 == 3 || index == int8Array.getSize() - 1) ? "\n" : ";";
+    }
+    REQUIRE(outputStrm.str() == expected);
+  }
+  SECTION("String Array")
+  {
+    std::ostringstream outputStrm;
+    OStreamUtilities::PrintSingleDataObject(outputStrm, k_StringArrayPath, dataStructure, k_NullMessageHandler, shouldCancel, ",", false, false, 2);
+    REQUIRE(outputStrm.str() == "Foo,Bar\nBazz,Qux\nQuux\n");
+  }
+}
+
+TEST_CASE("OStreamUtilities: Print Data Sets To Multiple Files", "[OStreamUtilities]")
+{
+  const usize numTuples = 1000;
+  DataStructure dataStructure = CreateTestData(numTuples);
+  const auto& float32Array = dataStructure.getDataRefAs<Float32Array>(k_Float32Path);
+  const auto& neighborList = dataStructure.getDataRefAs<NeighborList<int32>>(k_NeighborListPath);
+  const std::atomic_bool shouldCancel = false;
+
+  const fs::path outputDir = fs::path(unit_test::k_BinaryDir.view()) / "OStreamUtilitiesTest";
+  fs::create_directories(outputDir);
+
+  OStreamUtilities::PrintDataSetsToMultipleFiles({k_Float32Path, k_NeighborListPath}, dataStructure, outputDir.string(), k_NullMessageHandler, shouldCancel, ".csv", false, "\t", false, true);
+
+  std::string expectedFloat32;
+  for(usize tuple = 0; tuple < numTuples; tuple++)
+  {
+    expectedFloat32 += ReferenceTuple(float32Array, tuple, "\t") + "\n";
+  }
+  REQUIRE(ReadFile(outputDir / "Float32.csv") == expectedFloat32);
+  REQUIRE(ReadFile(outputDir / "NeighborList.csv") == "Element Count\tNeighborList\n" + ReferenceNeighborList(neighborList, "\t", false));
+
+  fs::remove_all(outputDir);
+}
+
+TEST_CASE("OStreamUtilities: Text Export Benchmark", "[.][benchmark]")
+{
+  const usize numValues = 100000000;
+  DataStructure dataStructure;
+  auto* dataArray = CreateArray<float32>(dataStructure, k_Float32Path, numValues, 1);
+  auto& store = dataArray->getDataStoreRef();
+  std::mt19937_64 generator(numValues);
+  std::uniform_real_distribution<float32> distribution(-1000.0f, 1000.0f);
+  for(usize i = 0; i < numValues; i++)
+  {
+    store[i] = distribution(generator);
+  }
+  const std::atomic_bool shouldCancel = false;
+
+  auto timeMs = [](auto&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<float64, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  // The original writer streamed every value through a temporary string
+  CountingStreamBuf streamPathBuffer;
+  std::ostream streamPathStrm(&streamPathBuffer);
+  const float64 streamMs = timeMs([&]() {
+    for(usize i = 0; i < numValues; i++)
+    {
+      streamPathStrm << fmt::format("{}", store[i]) << "\n";
+    }
+  });
+
+  CountingStreamBuf bufferedPathBuffer;
+  std::ostream bufferedPathStrm(&bufferedPathBuffer);
+  const float64 bufferedMs = timeMs([&]() { OStreamUtilities::PrintSingleDataObject(bufferedPathStrm, k_Float32Path, dataStructure, k_NullMessageHandler, shouldCancel, ","); });
+
+  REQUIRE(streamPathBuffer.count() == bufferedPathBuffer.count());
+  const float64 megabytes = static_cast<float64>(bufferedPathBuffer.count()) / (1024.0 * 1024.0);
+  WARN(fmt::format("{} float32 values ({:.1f} MB of text): stream path {:.0f} ms ({:.1f} MB/s), buffered path {:.0f} ms ({:.1f} MB/s), speedup {:.2f}x", numValues, megabytes, streamMs,
+                   megabytes / (streamMs / 1000.0), bufferedMs, megabytes / (bufferedMs / 1000.0), streamMs / bufferedMs));
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+
+#include "complex/Utilities/ParallelData2DAlgorithm.hpp"
+#include "complex/Utilities/ParallelData3DAlgorithm.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/Utilities/ParallelScheduler.hpp"
+#include "complex/Utilities/ParallelTaskAlgorithm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+constexpr std::array<ParallelScheduler::Partitioner, 3> k_Partitioners = {ParallelScheduler::Partitioner::Auto, ParallelScheduler::Partitioner::Simple, ParallelScheduler::Partitioner::Static};
+
+/**
+ * @brief Restores the default core budget when a test leaves its scope.
+ */
+struct CoreBudgetGuard
+{
+  ~CoreBudgetGuard()
+  {
+    ParallelScheduler::SetCoreBudget(0);
+  }
+};
+} // namespace
+
+TEST_CASE("complex::ParallelScheduler: Core Budget", "[complex][ParallelScheduler]")
+{
+  CoreBudgetGuard guard;
+  const uint32 hardwareConcurrency = ParallelScheduler::GetHardwareConcurrency();
+  REQUIRE(hardwareConcurrency >= 1);
+
+  ParallelScheduler::SetCoreBudget(0);
+  REQUIRE(ParallelScheduler::GetCoreBudget() == hardwareConcurrency);
+  ParallelScheduler::SetCoreBudget(hardwareConcurrency + 16);
+  REQUIRE(ParallelScheduler::GetCoreBudget() == hardwareConcurrency);
+  ParallelScheduler::SetCoreBudget(1);
+  REQUIRE(ParallelScheduler::GetCoreBudget() == 1);
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+  REQUIRE(ParallelScheduler::GetArena().max_concurrency() == 1);
+  ParallelScheduler::SetCoreBudget(0);
+  REQUIRE(ParallelScheduler::GetArena().max_concurrency() == static_cast<int>(hardwareConcurrency));
+#endif
+}
+
+TEST_CASE("complex::ParallelScheduler: Data Algorithm Options", "[complex][ParallelScheduler]")
+{
+  constexpr usize k_Size = 100003;
+  constexpr usize k_GrainSize = 1000;
+  for(const auto partitioner : k_Partitioners)
+  {
+    std::vector<std::atomic<int32>> visits(k_Size);
+    std::atomic<usize> smallestChunk = k_Size;
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, k_Size);
+    dataAlg.setGrainSize(k_GrainSize);
+    dataAlg.setPartitioner(partitioner);
+    REQUIRE(dataAlg.getGrainSize() == k_GrainSize);
+    REQUIRE(dataAlg.getPartitioner() == partitioner);
+    dataAlg.execute([&](const Range& range) {
+      usize current = smallestChunk.load();
+      while(range.size() < current && !smallestChunk.compare_exchange_weak(current, range.size()))
+      {
+      }
+      for(usize i = range.min(); i < range.max(); i++)
+      {
+        visits[i]++;
+      }
+    });
+    REQUIRE(std::all_of(visits.begin(), visits.end(), [](const auto& count) { return count == 1; }));
+    // Ranges no larger than the grain size are never split, so no chunk is smaller than half of it
+    REQUIRE(smallestChunk >= k_GrainSize / 2);
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setGrainSize(0);
+  REQUIRE(dataAlg.getGrainSize() == 1);
+}
+
+TEST_CASE("complex::ParallelScheduler: 2D and 3D Data Algorithms", "[complex][ParallelScheduler]")
+{
+  constexpr usize k_NumCols = 301;
+  constexpr usize k_NumRows = 157;
+  constexpr usize k_NumPages = 13;
+  for(const auto partitioner : k_Partitioners)
+  {
+    std::vector<std::atomic<int32>> visits2D(k_NumCols * k_NumRows);
+    ParallelData2DAlgorithm dataAlg2D;
+    dataAlg2D.setRange(0, k_NumCols, 0, k_NumRows);
+    dataAlg2D.setGrainSize(16);
+    dataAlg2D.setPartitioner(partitioner);
+    dataAlg2D.execute([&](const Range2D& range) {
+      for(usize row = range.minRow(); row < range.maxRow(); row++)
+      {
+        for(usize col = range.minCol(); col < range.maxCol(); col++)
+        {
+          visits2D[row * k_NumCols + col]++;
+        }
+      }
+    });
+    REQUIRE(std::all_of(visits2D.begin(), visits2D.end(), [](const auto& count) { return count == 1; }));
+
+    std::vector<std::atomic<int32>> visits3D(k_NumCols * k_NumRows * k_NumPages);
+    ParallelData3DAlgorithm dataAlg3D;
+    dataAlg3D.setRange(k_NumCols, k_NumRows, k_NumPages);
+    dataAlg3D.setGrainSize(8);
+    dataAlg3D.setPartitioner(partitioner);
+    dataAlg3D.execute([&](const Range3D& range) {
+      for(usize z = range[4]; z < range[5]; z++)
+      {
+        for(usize y = range[2]; y < range[3]; y++)
+        {
+          for(usize x = range[0]; x < range[1]; x++)
+          {
+            visits3D[(z * k_NumRows + y) * k_NumCols + x]++;
+          }
+        }
+      }
+    });
+    REQUIRE(std::all_of(visits3D.begin(), visits3D.end(), [](const auto& count) { return count == 1; }));
+  }
+}
+
+TEST_CASE("complex::ParallelScheduler: Task Algorithm", "[complex][ParallelScheduler]")
+{
+  constexpr int32 k_NumTasks = 64;
+  const uint32 maxThreads = std::max(ParallelScheduler::GetCoreBudget() / 2, 1u);
+
+  std::atomic<int32> running = 0;
+  std::atomic<int32> mostRunning = 0;
+  std::atomic<int32> finished = 0;
+  {
+    ParallelTaskAlgorithm taskAlg;
+    taskAlg.setMaxThreads(maxThreads);
+    REQUIRE(taskAlg.getMaxThreads() == maxThreads);
+    for(int32 i = 0; i < k_NumTasks; i++)
+    {
+      taskAlg.execute([&]() {
+        const int32 nowRunning = ++running;
+        int32 current = mostRunning.load();
+        while(nowRunning > current && !mostRunning.compare_exchange_weak(current, nowRunning))
+        {
+        }
+        volatile float64 sum = 0.0;
+        for(int32 k = 0; k < 20000; k++)
+        {
+          sum = sum + static_cast<float64>(k);
+        }
+        --running;
+        ++finished;
+      });
+    }
+    taskAlg.wait();
+    REQUIRE(finished == k_NumTasks);
+  }
+  REQUIRE(mostRunning <= static_cast<int32>(maxThreads));
+
+  // Tasks still queued when the algorithm goes out of scope are finished by its destructor
+  {
+    ParallelTaskAlgorithm taskAlg;
+    for(int32 i = 0; i < k_NumTasks; i++)
+    {
+      taskAlg.execute([&]() { ++finished; });
+    }
+  }
+  REQUIRE(finished == 2 * k_NumTasks);
+}
@@ -1,6 +1,7 @@
 #include "catch2/catch.hpp"
 
 #include "complex/Core/Application.hpp"
+#include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Filter/Actions/DeleteDataAction.hpp"
 #include "complex/Filter/Arguments.hpp"
@@ -368,3 +369,60 @@ TEST_CASE("PipelineDeferredActionTest")
   DataObject* executeObject = dataStructure.getData(k_DeferredActionPath);
   REQUIRE(executeObject == nullptr);
 }
+
+TEST_CASE("PipelineSnapshotPolicy")
+{
+  Pipeline pipeline;
+  REQUIRE(pipeline.getSnapshotPolicy() == Pipeline::SnapshotPolicy::KeepAll);
+  constexpr usize k_NodeCount = 3;
+  for(usize i = 0; i < k_NodeCount; i++)
+  {
+    REQUIRE(pipeline.push_back(std::make_unique<DeferredActionTestFilter>()));
+  }
+
+  auto executePipeline = [&pipeline]() {
+    DataStructure dataStructure;
+    REQUIRE(DataGroup::Create(dataStructure, "Group") != nullptr);
+    REQUIRE(pipeline.execute(dataStructure, false));
+  };
+
+  SECTION("Keep All")
+  {
+    executePipeline();
+    for(usize i = 0; i < k_NodeCount; i++)
+    {
+      REQUIRE(pipeline.at(i)->getDataStructure().getSize() != 0);
+    }
+    REQUIRE(pipeline.getDataStructure().getSize() != 0);
+  }
+  SECTION("Keep Last")
+  {
+    pipeline.setSnapshotPolicy(Pipeline::SnapshotPolicy::KeepLast, 1);
+    executePipeline();
+    REQUIRE(pipeline.at(0)->getDataStructure().getSize() == 0);
+    REQUIRE(pipeline.at(1)->getDataStructure().getSize() == 0);
+    REQUIRE(pipeline.at(2)->getDataStructure().getSize() != 0);
+    REQUIRE(pipeline.getDataStructure().getSize() != 0);
+
+    // Restarting drops the snapshots of the nodes before the restart index
+    pipeline.setSnapshotPolicy(Pipeline::SnapshotPolicy::KeepAll);
+    executePipeline();
+    pipeline.setSnapshotPolicy(Pipeline::SnapshotPolicy::KeepLast, 1);
+    REQUIRE(pipeline.executeFrom(2, false));
+    REQUIRE(pipeline.at(0)->getDataStructure().getSize() == 0);
+    REQUIRE(pipeline.at(1)->getDataStructure().getSize() == 0);
+    REQUIRE(pipeline.at(2)->getDataStructure().getSize() != 0);
+  }
+  SECTION("Keep None")
+  {
+    executePipeline();
+    pipeline.setSnapshotPolicy(Pipeline::SnapshotPolicy::KeepNone);
+    executePipeline();
+    for(usize i = 0; i < k_NodeCount; i++)
+    {
+      REQUIRE_FALSE(pipeline.at(i)->retainsDataStructure());
+      REQUIRE(pipeline.at(i)->getDataStructure().getSize() == 0);
+    }
+    REQUIRE(pipeline.getDataStructure().getSize() == 0);
+  }
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/Utilities/SegmentFeatures.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+using namespace complex;
+
+namespace
+{
+/**
+ * @brief Segments a uint8 array into features of neighboring voxels whose
+ * values differ by at most one, skipping masked voxels. getSeed() and
+ * determineGrouping() follow the same rules as isValid() and isSimilar() so
+ * the serial and parallel labeling can be compared.
+ */
+class TestSegmentFeatures : public SegmentFeatures
+{
+public:
+  TestSegmentFeatures(DataStructure& dataStructure, const std::atomic_bool& shouldCancel, const IFilter::MessageHandler& messageHandler, const DataStore<uint8>& values,
+                      const DataStore<bool>& mask, DataStore<int32>& featureIds)
+  : SegmentFeatures(dataStructure, shouldCancel, messageHandler)
+  , m_Values(values)
+  , m_Mask(mask)
+  , m_FeatureIds(featureIds)
+  {
+  }
+
+  bool isValid(int64 point) const
+  {
+    return m_Mask[point];
+  }
+
+  bool isSimilar(int64 referencePoint, int64 neighborPoint) const
+  {
+    return std::abs(static_cast<int32>(m_Values[referencePoint]) - static_cast<int32>(m_Values[neighborPoint])) <= 1;
+  }
+
+  int64 getSeed(int32 gnum, int64 nextSeed) const override
+  {
+    for(usize point = static_cast<usize>(nextSeed); point < m_FeatureIds.getSize(); point++)
+    {
+      if(m_FeatureIds[point] == 0 && isValid(static_cast<int64>(point)))
+      {
+        m_FeatureIds[point] = gnum;
+        return static_cast<int64>(point);
+      }
+    }
+    return -1;
+  }
+
+  bool determineGrouping(int64 referencePoint, int64 neighborPoint, int32 gnum) const override
+  {
+    if(m_FeatureIds[neighborPoint] == 0 && isValid(neighborPoint) && isSimilar(referencePoint, neighborPoint))
+    {
+      m_FeatureIds[neighborPoint] = gnum;
+      return true;
+    }
+    return false;
+  }
+
+private:
+  const DataStore<uint8>& m_Values;
+  const DataStore<bool>& m_Mask;
+  DataStore<int32>& m_FeatureIds;
+};
+
+void CompareSerialAndParallelLabels(const SizeVec3& dims)
+{
+  DataStructure dataStructure;
+  ImageGeom* imageGeom = ImageGeom::Create(dataStructure, "ImageGeom");
+  imageGeom->setDimensions(dims);
+  const usize numVoxels = imageGeom->getNumberOfCells();
+
+  std::mt19937 generator(5489u);
+  std::uniform_int_distribution<int32> valueDistribution(0, 7);
+  std::bernoulli_distribution maskDistribution(0.9);
+  DataStore<uint8> values(numVoxels, 0);
+  DataStore<bool> mask(numVoxels, true);
+  for(usize i = 0; i < numVoxels; i++)
+  {
+    values[i] = static_cast<uint8>(valueDistribution(generator));
+    mask[i] = maskDistribution(generator);
+  }
+
+  std::atomic_bool shouldCancel = false;
+  IFilter::MessageHandler messageHandler{[](const IFilter::Message&) {}};
+  DataStore<int32> serialFeatureIds(numVoxels, 0);
+  TestSegmentFeatures serialSegmenter(dataStructure, shouldCancel, messageHandler, values, mask, serialFeatureIds);
+  REQUIRE(serialSegmenter.execute(imageGeom).valid());
+
+  DataStore<int32> parallelFeatureIds(numVoxels, -1);
+  TestSegmentFeatures parallelSegmenter(dataStructure, shouldCancel, messageHandler, values, mask, parallelFeatureIds);
+  Result<usize> result = parallelSegmenter.executeParallel(
+      *imageGeom, parallelFeatureIds, [&](int64 point) { return parallelSegmenter.isValid(point); },
+      [&](int64 referencePoint, int64 neighborPoint) { return parallelSegmenter.isSimilar(referencePoint, neighborPoint); });
+  REQUIRE(result.valid());
+
+  int32 maxFeatureId = 0;
+  for(usize i = 0; i < numVoxels; i++)
+  {
+    REQUIRE(parallelFeatureIds[i] == serialFeatureIds[i]);
+    maxFeatureId = std::max(maxFeatureId, serialFeatureIds[i]);
+  }
+  REQUIRE(result.value() == static_cast<usize>(maxFeatureId));
+  REQUIRE(maxFeatureId > 1);
+}
+} // namespace
+
+TEST_CASE("SegmentFeatures Parallel Labeling Test", "[complex][SegmentFeatures]")
+{
+  SECTION("3D")
+  {
+    CompareSerialAndParallelLabels({23, 17, 11});
+  }
+  SECTION("2D")
+  {
+    CompareSerialAndParallelLabels({64, 48, 1});
+  }
+  SECTION("Single row")
+  {
+    CompareSerialAndParallelLabels({100, 1, 1});
+  }
+}
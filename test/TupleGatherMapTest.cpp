@@ -0,0 +1,247 @@
+#include <catch2/catch.hpp>
+
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+#include "complex/UnitTest/UnitTestCommon.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/TupleGatherMap.hpp"
+
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+template <typename T>
+DataArray<T>* CreateArray(DataStructure& dataStructure, const std::string& name, usize numTuples, usize numComps)
+{
+  auto* array = DataArray<T>::template CreateWithStore<DataStore<T>>(dataStructure, name, std::vector<usize>{numTuples}, std::vector<usize>{numComps});
+  for(usize i = 0; i < array->getSize(); i++)
+  {
+    (*array)[i] = static_cast<T>(i % 251);
+  }
+  return array;
+}
+
+/**
+ * @brief Applies the map one tuple at a time against a copy of the original values.
+ */
+template <typename T>
+std::vector<T> ReferenceGather(const DataArray<T>& source, const std::vector<int64>& sourceIndices)
+{
+  const usize numComps = source.getNumberOfComponents();
+  std::vector<T> original(source.begin(), source.end());
+  std::vector<T> result = original;
+  if(sourceIndices.size() * numComps != result.size())
+  {
+    result.resize(sourceIndices.size() * numComps);
+  }
+  for(usize i = 0; i < sourceIndices.size(); i++)
+  {
+    for(usize c = 0; c < numComps; c++)
+    {
+      if(sourceIndices[i] == TupleGatherMap::k_ZeroTuple)
+      {
+        result[i * numComps + c] = static_cast<T>(0);
+      }
+      else if(sourceIndices[i] >= 0)
+      {
+        result[i * numComps + c] = original[sourceIndices[i] * numComps + c];
+      }
+    }
+  }
+  return result;
+}
+
+struct TypeSizeFunctor
+{
+  template <typename T>
+  usize operator()(usize multiplier)
+  {
+    return sizeof(T) * multiplier;
+  }
+};
+
+struct TypeSizePairFunctor
+{
+  template <typename T, typename U>
+  usize operator()()
+  {
+    return sizeof(T) * 100 + sizeof(U);
+  }
+};
+
+template <typename T>
+void RequireEqual(const DataArray<T>& array, const std::vector<T>& expected)
+{
+  REQUIRE(array.getSize() == expected.size());
+  for(usize i = 0; i < expected.size(); i++)
+  {
+    REQUIRE(array[i] == expected[i]);
+  }
+}
+} // namespace
+
+TEST_CASE("complex::TupleGatherMap: Disjoint In Place Gather", "[complex][TupleGatherMap]")
+{
+  constexpr usize k_NumTuples = 50000;
+  DataStructure dataStructure;
+  auto* int32Array = CreateArray<int32>(dataStructure, "Int32", k_NumTuples, 1);
+  auto* float32Array = CreateArray<float32>(dataStructure, "Float32", k_NumTuples, 3);
+  auto* boolArray = CreateArray<bool>(dataStructure, "Bool", k_NumTuples, 1);
+
+  // Odd tuples read from even tuples, so no tuple is both read and written
+  std::mt19937_64 generator(42);
+  std::uniform_int_distribution<usize> distribution(0, k_NumTuples / 2 - 1);
+  std::vector<int64> sourceIndices(k_NumTuples, TupleGatherMap::k_KeepTuple);
+  for(usize i = 1; i < k_NumTuples; i += 2)
+  {
+    if(i % 3 != 0)
+    {
+      sourceIndices[i] = static_cast<int64>(2 * distribution(generator));
+    }
+  }
+
+  const auto expectedInt32 = ReferenceGather(*int32Array, sourceIndices);
+  const auto expectedFloat32 = ReferenceGather(*float32Array, sourceIndices);
+  const auto expectedBool = ReferenceGather(*boolArray, sourceIndices);
+
+  Result<TupleGatherMap> gatherMapResult = TupleGatherMap::Create(sourceIndices);
+  COMPLEX_RESULT_REQUIRE_VALID(gatherMapResult);
+  const TupleGatherMap& gatherMap = gatherMapResult.value();
+  REQUIRE(gatherMap.getNumberOfTuples() == k_NumTuples);
+  Result<> gatherResult = gatherMap.applyInPlace(dataStructure, {DataPath({"Int32"}), DataPath({"Float32"}), DataPath({"Bool"})}, std::atomic_bool(false));
+  COMPLEX_RESULT_REQUIRE_VALID(gatherResult);
+
+  RequireEqual(*int32Array, expectedInt32);
+  RequireEqual(*float32Array, expectedFloat32);
+  RequireEqual(*boolArray, expectedBool);
+}
+
+TEST_CASE("complex::TupleGatherMap: Overlapping In Place Gather", "[complex][TupleGatherMap]")
+{
+  constexpr usize k_DimX = 37;
+  constexpr usize k_DimY = 23;
+  DataStructure dataStructure;
+  auto* uint16Array = CreateArray<uint16>(dataStructure, "UInt16", k_DimX * k_DimY, 2);
+
+  // Shift a 2D slice by (+3, -2); cells shifted in from outside are zeroed
+  std::vector<int64> sourceIndices(k_DimX * k_DimY, TupleGatherMap::k_KeepTuple);
+  for(int64 y = 0; y < static_cast<int64>(k_DimY); y++)
+  {
+    for(int64 x = 0; x < static_cast<int64>(k_DimX); x++)
+    {
+      const int64 xSource = x + 3;
+      const int64 ySource = y - 2;
+      const bool inside = xSource < static_cast<int64>(k_DimX) && ySource >= 0;
+      sourceIndices[y * k_DimX + x] = inside ? ySource * static_cast<int64>(k_DimX) + xSource : TupleGatherMap::k_ZeroTuple;
+    }
+  }
+
+  const auto expected = ReferenceGather(*uint16Array, sourceIndices);
+  Result<TupleGatherMap> gatherMapResult = TupleGatherMap::Create(sourceIndices);
+  COMPLEX_RESULT_REQUIRE_VALID(gatherMapResult);
+  Result<> gatherResult = gatherMapResult.value().applyInPlace(*uint16Array);
+  COMPLEX_RESULT_REQUIRE_VALID(gatherResult);
+  RequireEqual(*uint16Array, expected);
+}
+
+TEST_CASE("complex::TupleGatherMap: Gather Into Another Array", "[complex][TupleGatherMap]")
+{
+  DataStructure dataStructure;
+  auto* source = CreateArray<float64>(dataStructure, "Source", 1000, 2);
+  auto* destination = CreateArray<float64>(dataStructure, "Destination", 100, 2);
+  auto* wrongType = CreateArray<int8>(dataStructure, "WrongType", 100, 2);
+
+  // Includes tuples that map onto the same index, which must still be copied
+  std::vector<int64> sourceIndices(100);
+  for(usize i = 0; i < sourceIndices.size(); i++)
+  {
+    sourceIndices[i] = static_cast<int64>(i * 9 + (i % 2 == 0 ? 0 : 5));
+  }
+  sourceIndices[0] = 0;
+
+  Result<TupleGatherMap> gatherMapResult = TupleGatherMap::Create(sourceIndices);
+  COMPLEX_RESULT_REQUIRE_VALID(gatherMapResult);
+  const TupleGatherMap& gatherMap = gatherMapResult.value();
+  Result<> gatherResult = gatherMap.apply(*source, *destination);
+  COMPLEX_RESULT_REQUIRE_VALID(gatherResult);
+  for(usize i = 0; i < sourceIndices.size(); i++)
+  {
+    REQUIRE((*destination)[i * 2] == (*source)[sourceIndices[i] * 2]);
+    REQUIRE((*destination)[i * 2 + 1] == (*source)[sourceIndices[i] * 2 + 1]);
+  }
+
+  REQUIRE(gatherMap.apply(*source, *wrongType).invalid());
+  REQUIRE(gatherMap.applyInPlace(*destination).invalid());
+  REQUIRE(TupleGatherMap::Create(std::vector<int64>{0, -7}).invalid());
+}
+
+TEST_CASE("complex::TupleGatherMap: Gather Several Arrays Together", "[complex][TupleGatherMap]")
+{
+  constexpr usize k_NumSourceTuples = 4000;
+  constexpr usize k_NumTuples = 1500;
+  DataStructure dataStructure;
+  auto* int8Source = CreateArray<int8>(dataStructure, "Int8 Source", k_NumSourceTuples, 1);
+  auto* uint64Source = CreateArray<uint64>(dataStructure, "UInt64 Source", k_NumSourceTuples, 2);
+  auto* float64Source = CreateArray<float64>(dataStructure, "Float64 Source", k_NumSourceTuples, 3);
+  auto* boolSource = CreateArray<bool>(dataStructure, "Bool Source", k_NumSourceTuples, 1);
+  auto* int8Destination = CreateArray<int8>(dataStructure, "Int8 Destination", k_NumTuples, 1);
+  auto* uint64Destination = CreateArray<uint64>(dataStructure, "UInt64 Destination", k_NumTuples, 2);
+  auto* float64Destination = CreateArray<float64>(dataStructure, "Float64 Destination", k_NumTuples, 3);
+  auto* boolDestination = CreateArray<bool>(dataStructure, "Bool Destination", k_NumTuples, 1);
+
+  std::vector<int64> sourceIndices(k_NumTuples);
+  for(usize i = 0; i < k_NumTuples; i++)
+  {
+    sourceIndices[i] = i % 7 == 0 ? TupleGatherMap::k_ZeroTuple : static_cast<int64>((i * 13) % k_NumSourceTuples);
+  }
+
+  Result<TupleGatherMap> gatherMapResult = TupleGatherMap::Create(sourceIndices);
+  COMPLEX_RESULT_REQUIRE_VALID(gatherMapResult);
+  const TupleGatherMap& gatherMap = gatherMapResult.value();
+  Result<> gatherResult = gatherMap.apply({int8Source, uint64Source, float64Source, boolSource}, {int8Destination, uint64Destination, float64Destination, boolDestination});
+  COMPLEX_RESULT_REQUIRE_VALID(gatherResult);
+
+  auto requireGathered = [&sourceIndices](const auto& source, const auto& destination) {
+    const usize numComps = source.getNumberOfComponents();
+    for(usize i = 0; i < sourceIndices.size(); i++)
+    {
+      for(usize c = 0; c < numComps; c++)
+      {
+        const auto expected = sourceIndices[i] == TupleGatherMap::k_ZeroTuple ? 0 : source[sourceIndices[i] * numComps + c];
+        REQUIRE(destination[i * numComps + c] == expected);
+      }
+    }
+  };
+  requireGathered(*int8Source, *int8Destination);
+  requireGathered(*uint64Source, *uint64Destination);
+  requireGathered(*float64Source, *float64Destination);
+  requireGathered(*boolSource, *boolDestination);
+
+  REQUIRE(gatherMap.apply({int8Source, uint64Source}, {int8Destination}).invalid());
+  REQUIRE(gatherMap.apply({int8Source}, {uint64Destination}).invalid());
+  REQUIRE(gatherMap.apply({int8Source, int8Destination}, {int8Destination, int8Source}).invalid());
+}
+
+TEST_CASE("complex::FilterUtilities: Typed Dispatch", "[complex][FilterUtilities]")
+{
+  REQUIRE(ExecuteDataFunction(TypeSizeFunctor{}, DataType::int16, 3) == 6);
+  REQUIRE(ExecuteDataFunction(TypeSizeFunctor{}, DataType::boolean, 1) == sizeof(bool));
+  REQUIRE(ExecuteDataFunctionFor<NumericDataTypes>(TypeSizeFunctor{}, DataType::float64, 2) == 16);
+  REQUIRE_THROWS_AS(ExecuteDataFunctionFor<NumericDataTypes>(TypeSizeFunctor{}, DataType::boolean, 1), std::runtime_error);
+
+  using FloatTypes = boost::mp11::mp_list<float32, float64>;
+  REQUIRE(IsDataTypeInList<FloatTypes>(DataType::float32));
+  REQUIRE_FALSE(IsDataTypeInList<FloatTypes>(DataType::uint32));
+  REQUIRE(FindDataTypeIndex<FloatTypes>(DataType::float64) == 1);
+  REQUIRE(FindDataTypeIndex<AllDataTypes>(DataType::uint64) == static_cast<usize>(DataType::uint64));
+
+  REQUIRE(ExecuteDataFunctionPair<AllDataTypes, FloatTypes>(TypeSizePairFunctor{}, DataType::uint32, DataType::float64) == 408);
+  REQUIRE_THROWS_AS((ExecuteDataFunctionPair<AllDataTypes, FloatTypes>(TypeSizePairFunctor{}, DataType::uint32, DataType::int8)), std::runtime_error);
+}
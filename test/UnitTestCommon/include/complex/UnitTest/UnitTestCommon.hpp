@@ -241,27 +241,24 @@ void CompareNeighborLists(const DataStructure& dataStructure, const DataPath& ex
 
   for(usize i = 0; i < exemplaryList.getNumberOfTuples(); i++)
   {
-    const auto exemplary = exemplaryList.getList(i);
-    const auto computed = computedNeighborList.getList(i);
-    if(exemplary.get() != nullptr && computed.get() != nullptr)
+    std::vector<T> exemplary = exemplaryList.copyOfList(i);
+    std::vector<T> computed = computedNeighborList.copyOfList(i);
+    REQUIRE(exemplary.size() == computed.size());
+    std::sort(exemplary.begin(), exemplary.end());
+    std::sort(computed.begin(), computed.end());
+    for(usize j = 0; j < exemplary.size(); ++j)
     {
-      REQUIRE(exemplary->size() == computed->size());
-      std::sort(exemplary->begin(), exemplary->end());
-      std::sort(computed->begin(), computed->end());
-      for(usize j = 0; j < exemplary->size(); ++j)
+      auto exemplaryVal = exemplary[j];
+      auto computedVal = computed[j];
+      if(exemplaryVal != computedVal)
       {
-        auto exemplaryVal = exemplary->at(j);
-        auto computedVal = computed->at(j);
-        if(exemplaryVal != computedVal)
-        {
-          float diff = std::fabs(static_cast<float>(exemplaryVal - computedVal));
-          INFO(fmt::format("Bad Neighborlist Comparison\n  Exemplary NeighborList:'{}'  size:{}\n  Computed NeighborList: '{}' size:{} ", exemplaryDataPath.toString(), exemplary->size(),
-                           computedPath.toString(), computed->size()));
-          INFO(fmt::format("  NeighborList {}, Index {} Exemplary Value: {} Computed Value: {}", i, j, exemplaryVal, computedVal))
+        float diff = std::fabs(static_cast<float>(exemplaryVal - computedVal));
+        INFO(fmt::format("Bad Neighborlist Comparison\n  Exemplary NeighborList:'{}'  size:{}\n  Computed NeighborList: '{}' size:{} ", exemplaryDataPath.toString(), exemplary.size(),
+                         computedPath.toString(), computed.size()));
+        INFO(fmt::format("  NeighborList {}, Index {} Exemplary Value: {} Computed Value: {}", i, j, exemplaryVal, computedVal))
 
-          REQUIRE(diff < EPSILON);
-          break;
-        }
+        REQUIRE(diff < EPSILON);
+        break;
       }
     }
   }